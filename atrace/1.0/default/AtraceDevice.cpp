@@ -50,15 +50,7 @@ const std::map<std::string, TracingConfig> kTracingMap = {
 
 // Methods from ::android::hardware::atrace::V1_0::IAtraceDevice follow.
 Return<void> AtraceDevice::listCategories(listCategories_cb _hidl_cb) {
-    hidl_vec<TracingCategory> categories;
-    categories.resize(kTracingMap.size());
-    std::size_t i = 0;
-    for (auto& c : kTracingMap) {
-        categories[i].name = c.first;
-        categories[i].description = c.second.description;
-        i++;
-    }
-    _hidl_cb(categories);
+    _hidl_cb(categories_);
     return Void();
 }
 
@@ -72,6 +64,22 @@ AtraceDevice::AtraceDevice() {
                                                               "/sys/kernel/tracing or "
                                                               "/sys/kernel/debug/tracing";
     }
+
+    // The category map and tracefs root are fixed from here on; snapshot the
+    // category list and the per-category enable node paths once.
+    categories_.resize(kTracingMap.size());
+    std::size_t i = 0;
+    for (auto& c : kTracingMap) {
+        categories_[i].name = c.first;
+        categories_[i].description = c.second.description;
+        i++;
+        auto& paths = category_enable_paths_[c.first];
+        for (auto& p : c.second.paths) {
+            paths.emplace_back(android::base::StringPrintf("%s%s/enable", tracefs_event_root_.c_str(),
+                                                           p.first.c_str()),
+                               p.second);
+        }
+    }
 }
 
 Return<::android::hardware::atrace::V1_0::Status> AtraceDevice::enableCategories(
@@ -81,12 +89,11 @@ Return<::android::hardware::atrace::V1_0::Status> AtraceDevice::enableCategories
     }
 
     for (auto& c : categories) {
-        if (kTracingMap.count(c)) {
-            for (auto& p : kTracingMap.at(c).paths) {
-                std::string tracefs_event_enable_path = android::base::StringPrintf(
-                        "%s%s/enable", tracefs_event_root_.c_str(), p.first.c_str());
-                if (!android::base::WriteStringToFile("1", tracefs_event_enable_path)) {
-                    LOG(ERROR) << "Failed to enable tracing on: " << tracefs_event_enable_path;
+        auto paths = category_enable_paths_.find(c);
+        if (paths != category_enable_paths_.end()) {
+            for (auto& p : paths->second) {
+                if (!android::base::WriteStringToFile("1", p.first)) {
+                    LOG(ERROR) << "Failed to enable tracing on: " << p.first;
                     if (p.second) {
                         // disable before return
                         disableAllCategories();
@@ -104,12 +111,10 @@ Return<::android::hardware::atrace::V1_0::Status> AtraceDevice::enableCategories
 Return<::android::hardware::atrace::V1_0::Status> AtraceDevice::disableAllCategories() {
     auto ret = Status::SUCCESS;
 
-    for (auto& c : kTracingMap) {
-        for (auto& p : c.second.paths) {
-            std::string tracefs_event_enable_path = android::base::StringPrintf(
-                    "%s%s/enable", tracefs_event_root_.c_str(), p.first.c_str());
-            if (!android::base::WriteStringToFile("0", tracefs_event_enable_path)) {
-                LOG(ERROR) << "Failed to disable tracing on: " << tracefs_event_enable_path;
+    for (auto& c : category_enable_paths_) {
+        for (auto& p : c.second) {
+            if (!android::base::WriteStringToFile("0", p.first)) {
+                LOG(ERROR) << "Failed to disable tracing on: " << p.first;
                 if (p.second) {
                     ret = Status::ERROR_TRACING_POINT;
                 }
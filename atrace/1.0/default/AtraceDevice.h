@@ -17,6 +17,11 @@
 #ifndef ANDROID_HARDWARE_ATRACE_V1_0_ATRACEDEVICE_H
 #define ANDROID_HARDWARE_ATRACE_V1_0_ATRACEDEVICE_H
 
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <android/hardware/atrace/1.0/IAtraceDevice.h>
 #include <hidl/MQDescriptor.h>
 #include <hidl/Status.h>
@@ -45,6 +50,12 @@ struct AtraceDevice : public IAtraceDevice {
 
   private:
     std::string tracefs_event_root_;
+    // Snapshots built once at construction, since the category map and the
+    // tracefs root never change afterwards: the category list returned by
+    // listCategories, and the resolved enable-node path (plus error-on-failure
+    // flag) per category, so queries don't re-derive them per call.
+    hidl_vec<TracingCategory> categories_;
+    std::map<std::string, std::vector<std::pair<std::string, bool>>> category_enable_paths_;
 
     // Methods from ::android::hidl::base::V1_0::IBase follow.
 };
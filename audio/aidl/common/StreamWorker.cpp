@@ -15,7 +15,6 @@
  */
 
 #include <pthread.h>
-#include <sched.h>
 #include <sys/resource.h>
 
 #include "include/StreamWorker.h"
@@ -49,6 +48,8 @@ void ThreadController::stop() {
             mWorkerStateChangeRequest = true;
         }
     }
+    // Wake the worker in case it is blocked in the paused state.
+    mWorkerCv.notify_all();
     join();
 }
 
@@ -76,6 +77,8 @@ void ThreadController::switchWorkerStateSync(WorkerState oldState, WorkerState n
     }
     mWorkerState = newState;
     mWorkerStateChangeRequest = true;
+    // Wake the worker in case it is blocked in the paused state.
+    mWorkerCv.notify_all();
     mWorkerCv.wait(lock, [&]() {
         android::base::ScopedLockAssertion lock_assertion(mWorkerLock);
         return mWorkerState != newState;
@@ -115,8 +118,19 @@ void ThreadController::workerThread() {
 
     for (WorkerState state = WorkerState::RUNNING; state != WorkerState::STOPPED;) {
         bool needToNotify = false;
-        if (Status status = state != WorkerState::PAUSED ? mLogic->cycle()
-                                                         : (sched_yield(), Status::CONTINUE);
+        if (state == WorkerState::PAUSED) {
+            // Block until the client requests a state change instead of burning
+            // CPU on a `sched_yield` loop. Since the worker is not processing
+            // audio while paused, taking the lock here can not cause a priority
+            // inversion on the I/O path.
+            std::unique_lock<std::mutex> lock(mWorkerLock);
+            android::base::ScopedLockAssertion lock_assertion(mWorkerLock);
+            mWorkerCv.wait(lock, [&]() {
+                android::base::ScopedLockAssertion lock_assertion(mWorkerLock);
+                return mWorkerStateChangeRequest.load(std::memory_order_relaxed);
+            });
+        }
+        if (Status status = state != WorkerState::PAUSED ? mLogic->cycle() : Status::CONTINUE;
             status == Status::CONTINUE) {
             {
                 // See https://developer.android.com/training/articles/smp#nonracing
@@ -133,7 +147,7 @@ void ThreadController::workerThread() {
             // last workerCycle gets executed, state := mWorkerState := PAUSED by us
             //   (or the workers enters the 'error' state if workerCycle fails)
             // client gets notified about state change in any case
-            // thread is doing a busy wait while 'state == PAUSED'
+            // thread blocks on 'mWorkerCv' while 'state == PAUSED'
             // client sets mWorkerState := RESUME_REQUESTED
             // state := mWorkerState (RESUME_REQUESTED)
             // mWorkerState := RUNNING, but we don't notify the client yet
@@ -167,7 +181,7 @@ void ThreadController::workerThread() {
                 std::lock_guard<std::mutex> lock(mWorkerLock);
                 mWorkerStateChangeRequest = false;
             }
-            mWorkerCv.notify_one();
+            mWorkerCv.notify_all();
         }
     }
 }
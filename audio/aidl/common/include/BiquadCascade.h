@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace android::hardware::audio::common {
+
+// Coefficients of one biquad section, normalized so that a0 == 1.
+struct BiquadCoefficients {
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+};
+
+// RBJ cookbook peaking EQ section.
+inline BiquadCoefficients makePeakingCoefficients(float sampleRateHz, float frequencyHz,
+                                                  float qFactor, float gainDb) {
+    const float A = std::pow(10.0f, gainDb / 40.0f);
+    const float w0 = 2.0f * static_cast<float>(M_PI) * frequencyHz / sampleRateHz;
+    const float alpha = std::sin(w0) / (2.0f * qFactor);
+    const float a0 = 1.0f + alpha / A;
+    return {.b0 = (1.0f + alpha * A) / a0,
+            .b1 = (-2.0f * std::cos(w0)) / a0,
+            .b2 = (1.0f - alpha * A) / a0,
+            .a1 = (-2.0f * std::cos(w0)) / a0,
+            .a2 = (1.0f - alpha / A) / a0};
+}
+
+// RBJ cookbook low shelf section.
+inline BiquadCoefficients makeLowShelfCoefficients(float sampleRateHz, float frequencyHz,
+                                                   float slope, float gainDb) {
+    const float A = std::pow(10.0f, gainDb / 40.0f);
+    const float w0 = 2.0f * static_cast<float>(M_PI) * frequencyHz / sampleRateHz;
+    const float cosW0 = std::cos(w0);
+    const float alpha =
+            std::sin(w0) / 2.0f * std::sqrt((A + 1.0f / A) * (1.0f / slope - 1.0f) + 2.0f);
+    const float twoSqrtAAlpha = 2.0f * std::sqrt(A) * alpha;
+    const float a0 = (A + 1.0f) + (A - 1.0f) * cosW0 + twoSqrtAAlpha;
+    return {.b0 = A * ((A + 1.0f) - (A - 1.0f) * cosW0 + twoSqrtAAlpha) / a0,
+            .b1 = 2.0f * A * ((A - 1.0f) - (A + 1.0f) * cosW0) / a0,
+            .b2 = A * ((A + 1.0f) - (A - 1.0f) * cosW0 - twoSqrtAAlpha) / a0,
+            .a1 = -2.0f * ((A - 1.0f) + (A + 1.0f) * cosW0) / a0,
+            .a2 = ((A + 1.0f) + (A - 1.0f) * cosW0 - twoSqrtAAlpha) / a0};
+}
+
+// Processes interleaved multi-channel float audio through a cascade of biquad
+// sections. The filter state is kept in transposed direct-form-II, one state
+// pair per channel per section, stored contiguously so that the inner loop
+// iterates over channels of one frame and can be auto-vectorized (NEON / SSE)
+// by the compiler. This is intended to be shared by effect implementations
+// instead of each effect carrying its own scalar per-sample filter.
+class BiquadCascade {
+  public:
+    BiquadCascade(size_t channelCount, const std::vector<BiquadCoefficients>& coefficients)
+        : mChannelCount(channelCount) {
+        mSections.reserve(coefficients.size());
+        for (const auto& coefs : coefficients) {
+            mSections.push_back(Section{.coefs = coefs,
+                                        .s1 = std::vector<float>(channelCount, 0.0f),
+                                        .s2 = std::vector<float>(channelCount, 0.0f)});
+        }
+    }
+
+    size_t getChannelCount() const { return mChannelCount; }
+    size_t getSectionCount() const { return mSections.size(); }
+
+    // Clears the filter state, e.g. when the stream restarts after standby.
+    void reset() {
+        for (auto& section : mSections) {
+            std::fill(section.s1.begin(), section.s1.end(), 0.0f);
+            std::fill(section.s2.begin(), section.s2.end(), 0.0f);
+        }
+    }
+
+    // 'in' and 'out' are interleaved buffers of 'frameCount' frames and may alias.
+    void process(float* out, const float* in, size_t frameCount) {
+        for (auto& section : mSections) {
+            const BiquadCoefficients coefs = section.coefs;
+            float* const s1 = section.s1.data();
+            float* const s2 = section.s2.data();
+            const float* src = in;
+            float* dst = out;
+            for (size_t frame = 0; frame < frameCount; ++frame) {
+                // The channel loop has no cross-iteration dependency and gets
+                // vectorized; the recurrence only exists across frames.
+                for (size_t ch = 0; ch < mChannelCount; ++ch) {
+                    const float x = src[ch];
+                    const float y = coefs.b0 * x + s1[ch];
+                    s1[ch] = coefs.b1 * x - coefs.a1 * y + s2[ch];
+                    s2[ch] = coefs.b2 * x - coefs.a2 * y;
+                    dst[ch] = y;
+                }
+                src += mChannelCount;
+                dst += mChannelCount;
+            }
+            // Subsequent sections process the output of the previous one in place.
+            in = out;
+        }
+    }
+
+  private:
+    struct Section {
+        BiquadCoefficients coefs;
+        std::vector<float> s1;
+        std::vector<float> s2;
+    };
+
+    const size_t mChannelCount;
+    std::vector<Section> mSections;
+};
+
+}  // namespace android::hardware::audio::common
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <BiquadCascade.h>
+
+#include <gtest/gtest.h>
+#define LOG_TAG "BiquadCascade_Test"
+#include <log/log.h>
+
+using android::hardware::audio::common::BiquadCascade;
+using android::hardware::audio::common::BiquadCoefficients;
+using android::hardware::audio::common::makeLowShelfCoefficients;
+using android::hardware::audio::common::makePeakingCoefficients;
+
+static constexpr float kSampleRateHz = 48000.0f;
+static constexpr size_t kFrameCount = 256;
+
+// A unity section must pass any signal through unchanged.
+static constexpr BiquadCoefficients kUnity = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+
+TEST(BiquadCascadeTest, UnityPassThrough) {
+    constexpr size_t channelCount = 2;
+    BiquadCascade cascade(channelCount, {kUnity, kUnity});
+    std::vector<float> in(kFrameCount * channelCount);
+    for (size_t i = 0; i < in.size(); ++i) {
+        in[i] = std::sin(2.0f * static_cast<float>(M_PI) * 440.0f * i / kSampleRateHz);
+    }
+    std::vector<float> out(in.size());
+    cascade.process(out.data(), in.data(), kFrameCount);
+    for (size_t i = 0; i < in.size(); ++i) {
+        EXPECT_NEAR(in[i], out[i], 1e-6f) << "at sample " << i;
+    }
+}
+
+TEST(BiquadCascadeTest, InPlaceProcessing) {
+    constexpr size_t channelCount = 4;
+    BiquadCascade cascade(channelCount,
+                          {makePeakingCoefficients(kSampleRateHz, 1000.0f, 1.0f, 6.0f)});
+    BiquadCascade reference(channelCount,
+                            {makePeakingCoefficients(kSampleRateHz, 1000.0f, 1.0f, 6.0f)});
+    std::vector<float> buffer(kFrameCount * channelCount);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = std::sin(0.01f * i);
+    }
+    std::vector<float> expected(buffer.size());
+    reference.process(expected.data(), buffer.data(), kFrameCount);
+    cascade.process(buffer.data(), buffer.data(), kFrameCount);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        EXPECT_NEAR(expected[i], buffer[i], 1e-6f) << "at sample " << i;
+    }
+}
+
+TEST(BiquadCascadeTest, ResetClearsState) {
+    constexpr size_t channelCount = 1;
+    BiquadCascade cascade(channelCount,
+                          {makeLowShelfCoefficients(kSampleRateHz, 200.0f, 1.0f, 9.0f)});
+    std::vector<float> in(kFrameCount, 0.5f);
+    std::vector<float> first(kFrameCount), second(kFrameCount);
+    cascade.process(first.data(), in.data(), kFrameCount);
+    cascade.reset();
+    cascade.process(second.data(), in.data(), kFrameCount);
+    for (size_t i = 0; i < kFrameCount; ++i) {
+        EXPECT_NEAR(first[i], second[i], 1e-6f) << "at sample " << i;
+    }
+}
+
+TEST(BiquadCascadeTest, LowShelfBoostsDcRejectsUnity) {
+    constexpr size_t channelCount = 1;
+    constexpr float gainDb = 6.0f;
+    BiquadCascade cascade(channelCount,
+                          {makeLowShelfCoefficients(kSampleRateHz, 500.0f, 1.0f, gainDb)});
+    // Feed DC and let the filter settle; the steady-state output must approach
+    // the shelf gain.
+    std::vector<float> in(kFrameCount * 16, 1.0f);
+    std::vector<float> out(in.size());
+    cascade.process(out.data(), in.data(), in.size());
+    const float expectedGain = std::pow(10.0f, gainDb / 20.0f);
+    EXPECT_NEAR(expectedGain, out.back(), 1e-3f);
+}
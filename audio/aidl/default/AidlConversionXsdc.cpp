@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <string>
+#include <unordered_map>
+
 #define LOG_TAG "AHAL_AidlXsdc"
 #include <android-base/logging.h>
 #include <error/expected_utils.h>
@@ -32,24 +35,50 @@ ConversionResult<AudioFormatDescription> xsdc2aidl_AudioFormatDescription(const
     return legacy2aidl_audio_format_t_AudioFormatDescription(::android::formatFromString(xsdc));
 }
 
+namespace {
+
+// Format names can repeat between the per-family subformat lists, and every
+// lookup via 'formatFromString' is a linear scan over the format name table.
+// The cache makes sure each distinct name is only resolved once per converted
+// document.
+using AudioFormatDescriptionCache = std::unordered_map<std::string, AudioFormatDescription>;
+
+ConversionResult<AudioFormatDescription> xsdc2aidl_AudioFormatDescription_cached(
+        const std::string& xsdc, AudioFormatDescriptionCache& cache) {
+    if (auto it = cache.find(xsdc); it != cache.end()) {
+        return it->second;
+    }
+    AudioFormatDescription aidl = VALUE_OR_RETURN(xsdc2aidl_AudioFormatDescription(xsdc));
+    cache.emplace(xsdc, aidl);
+    return aidl;
+}
+
 ConversionResult<SurroundSoundConfig::SurroundFormatFamily> xsdc2aidl_SurroundFormatFamily(
-        const ::xsd::SurroundFormats::Format& xsdc) {
+        const ::xsd::SurroundFormats::Format& xsdc, AudioFormatDescriptionCache& cache) {
     SurroundSoundConfig::SurroundFormatFamily aidl;
-    aidl.primaryFormat = VALUE_OR_RETURN(xsdc2aidl_AudioFormatDescription(xsdc.getName()));
+    aidl.primaryFormat = VALUE_OR_RETURN(xsdc2aidl_AudioFormatDescription_cached(xsdc.getName(), cache));
     if (xsdc.hasSubformats()) {
         aidl.subFormats = VALUE_OR_RETURN(convertContainer<std::vector<AudioFormatDescription>>(
-                xsdc.getSubformats(), xsdc2aidl_AudioFormatDescription));
+                xsdc.getSubformats(), [&cache](const std::string& name) {
+                    return xsdc2aidl_AudioFormatDescription_cached(name, cache);
+                }));
     }
     return aidl;
 }
 
+}  // namespace
+
 ConversionResult<SurroundSoundConfig> xsdc2aidl_SurroundSoundConfig(
         const ::xsd::SurroundSound& xsdc) {
     SurroundSoundConfig aidl;
     if (!xsdc.hasFormats() || !xsdc.getFirstFormats()->hasFormat()) return aidl;
+    AudioFormatDescriptionCache formatCache;
     aidl.formatFamilies = VALUE_OR_RETURN(
             convertContainer<std::vector<SurroundSoundConfig::SurroundFormatFamily>>(
-                    xsdc.getFirstFormats()->getFormat(), xsdc2aidl_SurroundFormatFamily));
+                    xsdc.getFirstFormats()->getFormat(),
+                    [&formatCache](const ::xsd::SurroundFormats::Format& format) {
+                        return xsdc2aidl_SurroundFormatFamily(format, formatCache);
+                    }));
     return aidl;
 }
 
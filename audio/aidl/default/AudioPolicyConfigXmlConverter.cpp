@@ -169,7 +169,7 @@ void AudioPolicyConfigXmlConverter::mapStreamsToVolumeCurves() {
 }
 
 void AudioPolicyConfigXmlConverter::addVolumeGroupstoEngineConfig() {
-    for (const auto& [xsdcStream, volumeCurves] : mStreamToVolumeCurvesMap) {
+    for (auto& [xsdcStream, volumeCurves] : mStreamToVolumeCurvesMap) {
         AudioHalVolumeGroup volumeGroup;
         volumeGroup.name = xsd::toString(xsdcStream);
         if (static_cast<int>(xsdcStream) >= AUDIO_STREAM_PUBLIC_CNT) {
@@ -179,7 +179,9 @@ void AudioPolicyConfigXmlConverter::addVolumeGroupstoEngineConfig() {
             volumeGroup.minIndex = KVolumeIndexDeferredToAudioService;
             volumeGroup.maxIndex = KVolumeIndexDeferredToAudioService;
         }
-        volumeGroup.volumeCurves = volumeCurves;
+        // The map is only used to build the engine config, so the curves can
+        // be moved out instead of copied.
+        volumeGroup.volumeCurves = std::move(volumeCurves);
         mAidlEngineConfig.volumeGroups.push_back(std::move(volumeGroup));
     }
 }
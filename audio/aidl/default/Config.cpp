@@ -14,8 +14,17 @@
  * limitations under the License.
  */
 
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <vector>
+
 #define LOG_TAG "AHAL_Config"
+#include <android-base/file.h>
 #include <android-base/logging.h>
+#include <android/binder_parcel.h>
 
 #include <system/audio_config.h>
 
@@ -26,12 +35,131 @@
 using aidl::android::media::audio::common::AudioHalEngineConfig;
 
 namespace aidl::android::hardware::audio::core {
+
+namespace {
+
+// Binary cache of the engine config converted from XML. Parsing the policy and
+// engine XML files dominates the cost of the first 'getEngineConfig' call; on
+// subsequent service starts the already converted AudioHalEngineConfig is read
+// back from the cache instead. The cache is invalidated when the source XML
+// file changes (mtime / size) or when the cache layout version is bumped.
+constexpr uint32_t kEngineConfigCacheMagic = 0x43474e45;  // 'ENGC'
+constexpr uint32_t kEngineConfigCacheVersion = 1;
+constexpr char kEngineConfigCachePath[] = "/data/vendor/audio/engine_config.cache";
+
+struct EngineConfigCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    int64_t sourceMtime;
+    int64_t sourceSize;
+    uint64_t payloadSize;
+};
+
+// Returns the stat of the XML file that the engine config would be converted
+// from: the dedicated engine config file when present, the audio policy config
+// file otherwise.
+std::optional<struct stat> statEngineConfigSource() {
+    for (const auto& path :
+         {::android::audio_find_readable_configuration_file(kEngineConfigFileName.c_str()),
+          ::android::audio_get_audio_policy_config_file()}) {
+        struct stat st{};
+        if (!path.empty() && ::stat(path.c_str(), &st) == 0) {
+            return st;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<AudioHalEngineConfig> readEngineConfigFromCache(const struct stat& sourceStat) {
+    std::string contents;
+    if (!::android::base::ReadFileToString(kEngineConfigCachePath, &contents)) {
+        return std::nullopt;
+    }
+    if (contents.size() < sizeof(EngineConfigCacheHeader)) {
+        LOG(WARNING) << __func__ << ": cache file is truncated";
+        return std::nullopt;
+    }
+    EngineConfigCacheHeader header;
+    memcpy(&header, contents.data(), sizeof(header));
+    if (header.magic != kEngineConfigCacheMagic || header.version != kEngineConfigCacheVersion) {
+        LOG(INFO) << __func__ << ": cache layout mismatch, ignoring";
+        return std::nullopt;
+    }
+    if (header.sourceMtime != static_cast<int64_t>(sourceStat.st_mtime) ||
+        header.sourceSize != static_cast<int64_t>(sourceStat.st_size)) {
+        LOG(INFO) << __func__ << ": the XML config has changed, ignoring the cache";
+        return std::nullopt;
+    }
+    if (contents.size() - sizeof(header) != header.payloadSize) {
+        LOG(WARNING) << __func__ << ": cache payload size mismatch";
+        return std::nullopt;
+    }
+    AParcel* parcel = AParcel_create();
+    if (parcel == nullptr) return std::nullopt;
+    std::optional<AudioHalEngineConfig> result;
+    if (AParcel_unmarshal(parcel,
+                          reinterpret_cast<const uint8_t*>(contents.data() + sizeof(header)),
+                          header.payloadSize) == STATUS_OK &&
+        AParcel_setDataPosition(parcel, 0) == STATUS_OK) {
+        AudioHalEngineConfig config;
+        if (config.readFromParcel(parcel) == STATUS_OK) {
+            result = std::move(config);
+        } else {
+            LOG(WARNING) << __func__ << ": failed to deserialize the cached engine config";
+        }
+    }
+    AParcel_delete(parcel);
+    return result;
+}
+
+void writeEngineConfigToCache(const struct stat& sourceStat, const AudioHalEngineConfig& config) {
+    AParcel* parcel = AParcel_create();
+    if (parcel == nullptr) return;
+    std::string contents;
+    if (config.writeToParcel(parcel) == STATUS_OK) {
+        const int32_t payloadSize = AParcel_getDataSize(parcel);
+        std::vector<uint8_t> payload(payloadSize);
+        if (AParcel_marshal(parcel, payload.data(), 0, payloadSize) == STATUS_OK) {
+            EngineConfigCacheHeader header{.magic = kEngineConfigCacheMagic,
+                                           .version = kEngineConfigCacheVersion,
+                                           .sourceMtime = static_cast<int64_t>(sourceStat.st_mtime),
+                                           .sourceSize = static_cast<int64_t>(sourceStat.st_size),
+                                           .payloadSize = payload.size()};
+            contents.append(reinterpret_cast<const char*>(&header), sizeof(header));
+            contents.append(reinterpret_cast<const char*>(payload.data()), payload.size());
+        }
+    }
+    AParcel_delete(parcel);
+    if (contents.empty()) return;
+    // Write via a temporary file so that a partially written cache is never picked up.
+    const std::string tempPath = std::string(kEngineConfigCachePath) + ".tmp";
+    if (!::android::base::WriteStringToFile(contents, tempPath) ||
+        ::rename(tempPath.c_str(), kEngineConfigCachePath) != 0) {
+        PLOG(WARNING) << __func__ << ": failed to write the engine config cache";
+        (void)::unlink(tempPath.c_str());
+    }
+}
+
+}  // namespace
+
+internal::AudioPolicyConfigXmlConverter& Config::getAudioPolicyConverter() {
+    static internal::AudioPolicyConfigXmlConverter converter{
+            ::android::audio_get_audio_policy_config_file()};
+    return converter;
+}
+
+internal::EngineConfigXmlConverter& Config::getEngConfigConverter() {
+    static internal::EngineConfigXmlConverter converter{
+            ::android::audio_find_readable_configuration_file(kEngineConfigFileName.c_str())};
+    return converter;
+}
+
 ndk::ScopedAStatus Config::getSurroundSoundConfig(SurroundSoundConfig* _aidl_return) {
     static const auto& func = __func__;
-    static const SurroundSoundConfig surroundSoundConfig = [this]() {
-        SurroundSoundConfig surroundCfg = mAudioPolicyConverter.getSurroundSoundConfig();
-        if (mAudioPolicyConverter.getStatus() != ::android::OK) {
-            LOG(WARNING) << func << ": " << mAudioPolicyConverter.getError();
+    static const SurroundSoundConfig surroundSoundConfig = []() {
+        SurroundSoundConfig surroundCfg = getAudioPolicyConverter().getSurroundSoundConfig();
+        if (getAudioPolicyConverter().getStatus() != ::android::OK) {
+            LOG(WARNING) << func << ": " << getAudioPolicyConverter().getError();
         }
         return surroundCfg;
     }();
@@ -42,18 +170,28 @@ ndk::ScopedAStatus Config::getSurroundSoundConfig(SurroundSoundConfig* _aidl_ret
 
 ndk::ScopedAStatus Config::getEngineConfig(AudioHalEngineConfig* _aidl_return) {
     static const auto& func = __func__;
-    static const AudioHalEngineConfig returnEngCfg = [this]() {
+    static const AudioHalEngineConfig returnEngCfg = []() {
+        const std::optional<struct stat> sourceStat = statEngineConfigSource();
+        if (sourceStat.has_value()) {
+            if (auto cached = readEngineConfigFromCache(*sourceStat); cached.has_value()) {
+                LOG(DEBUG) << func << ": engine config loaded from the binary cache";
+                return *cached;
+            }
+        }
         AudioHalEngineConfig engConfig;
-        if (mEngConfigConverter.getStatus() == ::android::OK) {
-            engConfig = mEngConfigConverter.getAidlEngineConfig();
+        if (getEngConfigConverter().getStatus() == ::android::OK) {
+            engConfig = getEngConfigConverter().getAidlEngineConfig();
         } else {
-            LOG(INFO) << func << ": " << mEngConfigConverter.getError();
-            if (mAudioPolicyConverter.getStatus() == ::android::OK) {
-                engConfig = mAudioPolicyConverter.getAidlEngineConfig();
+            LOG(INFO) << func << ": " << getEngConfigConverter().getError();
+            if (getAudioPolicyConverter().getStatus() == ::android::OK) {
+                engConfig = getAudioPolicyConverter().getAidlEngineConfig();
             } else {
-                LOG(WARNING) << func << ": " << mAudioPolicyConverter.getError();
+                LOG(WARNING) << func << ": " << getAudioPolicyConverter().getError();
             }
         }
+        if (sourceStat.has_value()) {
+            writeEngineConfigToCache(*sourceStat, engConfig);
+        }
         // Logging full contents of the config is an overkill, just provide statistics.
         LOG(DEBUG) << func
                    << ": number of strategies parsed: " << engConfig.productStrategies.size()
@@ -112,7 +112,9 @@ ndk::ScopedAStatus EffectImpl::getParameter(const Parameter::Id& id, Parameter*
         default: {
             Parameter::Specific specific;
             RETURN_IF_ASTATUS_NOT_OK(getParameterSpecific(id, &specific), "SpecParamNotSupported");
-            param->set<Parameter::specific>(specific);
+            // Specific unions can carry KBs (dynamicsProcessing channel/band
+            // configs, visualizer captures); move instead of copying again.
+            param->set<Parameter::specific>(std::move(specific));
             break;
         }
     }
@@ -19,7 +19,11 @@
 
 #define LOG_TAG "AHAL_EffectThread"
 #include <android-base/logging.h>
+#include <android-base/parseint.h>
+#include <android-base/properties.h>
+#include <android-base/strings.h>
 #include <pthread.h>
+#include <sched.h>
 #include <sys/resource.h>
 
 #include "effect-impl/EffectThread.h"
@@ -29,6 +33,40 @@ using ::android::hardware::EventFlag;
 
 namespace aidl::android::hardware::audio::effect {
 
+namespace {
+
+// Integrators can tune the scheduling of an effect's worker thread without
+// code changes through per-effect properties, keyed by the effect name passed
+// to 'createThread':
+//   vendor.audio.effect.<name>.priority - nice number overriding the default
+//       ANDROID_PRIORITY_URGENT_AUDIO, e.g. for colocating light effects;
+//   vendor.audio.effect.<name>.affinity - comma-separated list of CPUs to pin
+//       the worker to, e.g. "6,7" to keep a heavy effect on big cores.
+constexpr char kEffectPropertyPrefix[] = "vendor.audio.effect.";
+
+void applyThreadAffinity(const std::string& name) {
+    const std::string value =
+            ::android::base::GetProperty(kEffectPropertyPrefix + name + ".affinity", "");
+    if (value.empty()) return;
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (const auto& field : ::android::base::Split(value, ",")) {
+        int cpu = 0;
+        if (!::android::base::ParseInt(::android::base::Trim(field), &cpu, 0, CPU_SETSIZE - 1)) {
+            LOG(ERROR) << name << __func__ << " invalid CPU list \"" << value << "\", ignoring";
+            return;
+        }
+        CPU_SET(cpu, &cpuSet);
+    }
+    if (sched_setaffinity(0 /* calling thread */, sizeof(cpuSet), &cpuSet) != 0) {
+        PLOG(ERROR) << name << __func__ << " failed to apply CPU list \"" << value << "\"";
+    } else {
+        LOG(DEBUG) << name << __func__ << " pinned to CPUs " << value;
+    }
+}
+
+}  // namespace
+
 EffectThread::EffectThread() {
     LOG(DEBUG) << __func__;
 }
@@ -45,7 +83,9 @@ RetCode EffectThread::createThread(std::shared_ptr<EffectContext> context, const
         return RetCode::SUCCESS;
     }
     mName = name;
-    mPriority = priority;
+    mPriority = ::android::base::GetIntProperty(kEffectPropertyPrefix + name + ".priority",
+                                                priority, ANDROID_PRIORITY_HIGHEST,
+                                                ANDROID_PRIORITY_LOWEST);
     {
         std::lock_guard lg(mThreadMutex);
         mStop = true;
@@ -116,6 +156,7 @@ RetCode EffectThread::stopThread() {
 void EffectThread::threadLoop() {
     pthread_setname_np(pthread_self(), mName.substr(0, kMaxTaskNameLen - 1).c_str());
     setpriority(PRIO_PROCESS, 0, mPriority);
+    applyThreadAffinity(mName);
     while (true) {
         /**
          * wait for the EventFlag without lock, it's ok because the mEfGroup pointer will not change
@@ -147,6 +188,7 @@ void EffectThread::process_l() {
 
     auto processSamples = inputMQ->availableToRead();
     if (processSamples) {
+        mThreadContext->resetScratchBuffers();
         inputMQ->read(buffer, processSamples);
         IEffect::Status status = effectProcessImpl(buffer, buffer, processSamples);
         outputMQ->write(buffer, status.fmqProduced);
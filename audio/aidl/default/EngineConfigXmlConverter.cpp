@@ -299,6 +299,39 @@ void EngineConfigXmlConverter::init() {
                 std::bind(&EngineConfigXmlConverter::convertCapCriterionTypeToAidl, this,
                           std::placeholders::_1));
         mAidlEngineConfig.capSpecificConfig = capSpecificConfig;
+        compileCapCriterionTable();
+    }
+}
+
+void EngineConfigXmlConverter::compileCapCriterionTable() {
+    const auto& capSpecificConfig = mAidlEngineConfig.capSpecificConfig.value();
+    std::unordered_map<std::string, size_t> typeIndexByName;
+    for (size_t i = 0; i < capSpecificConfig.criterionTypes.size(); ++i) {
+        typeIndexByName.emplace(capSpecificConfig.criterionTypes[i].name, i);
+    }
+    mCapCriterionTable.criteria.reserve(capSpecificConfig.criteria.size());
+    for (size_t i = 0; i < capSpecificConfig.criteria.size(); ++i) {
+        const AudioHalCapCriterion& criterion = capSpecificConfig.criteria[i];
+        CapCriterionTable::Criterion entry;
+        if (auto typeIt = typeIndexByName.find(criterion.criterionTypeName);
+            typeIt != typeIndexByName.end()) {
+            const AudioHalCapCriterionType& criterionType =
+                    capSpecificConfig.criterionTypes[typeIt->second];
+            entry.typeIndex = static_cast<int>(typeIt->second);
+            entry.isInclusive = criterionType.isInclusive;
+            int valueIndex = 0;
+            for (const std::string& literal : criterionType.values) {
+                entry.valueIndex.emplace(literal, valueIndex++);
+            }
+            if (auto defaultIt = entry.valueIndex.find(criterion.defaultLiteralValue);
+                defaultIt != entry.valueIndex.end()) {
+                entry.defaultValueIndex = defaultIt->second;
+            }
+        }
+        // A criterion referencing an unknown type stays unindexed
+        // (typeIndex == -1); consumers fall back to literal evaluation.
+        mCapCriterionTable.criterionIndex.emplace(criterion.name, i);
+        mCapCriterionTable.criteria.push_back(std::move(entry));
     }
 }
 }  // namespace aidl::android::hardware::audio::core::internal
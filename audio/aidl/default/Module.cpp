@@ -15,6 +15,7 @@
  */
 
 #include <algorithm>
+#include <cstdio>
 #include <set>
 
 #define LOG_TAG "AHAL_Module"
@@ -198,6 +199,21 @@ ndk::ScopedAStatus Module::createStreamContext(
                 std::make_unique<StreamContext::DataMQ>(frameSize * in_bufferSizeFrames),
                 asyncCallback, outEventCallback, params);
         if (temp.isValid()) {
+            if (flags.getTag() == AudioIoFlags::Tag::output &&
+                (isBitPositionFlagSet(flags.get<AudioIoFlags::Tag::output>(),
+                                      AudioOutputFlags::DEEP_BUFFER) ||
+                 isBitPositionFlagSet(flags.get<AudioIoFlags::Tag::output>(),
+                                      AudioOutputFlags::COMPRESS_OFFLOAD))) {
+                // These streams can tolerate increased latency, let their workers
+                // batch several bursts per wake up to reduce the wake up rate.
+                temp.setBatchBursts(kBatchBurstsForHighLatencyStreams);
+            }
+            if (flags.getTag() == AudioIoFlags::Tag::output) {
+                if (!mSoundDose) {
+                    mSoundDose = ndk::SharedRefBase::make<sounddose::SoundDose>();
+                }
+                temp.setStreamDataProcessor(mSoundDose.getInstance());
+            }
             *out_context = std::move(temp);
         } else {
             return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_STATE);
@@ -321,6 +337,19 @@ internal::Configuration& Module::getConfig() {
     return *mConfig;
 }
 
+const Module::SourceRouteIndex& Module::getSourceRouteIndex() {
+    if (mSourceRouteIndexDirty) {
+        mSourceRouteIndex.clear();
+        for (const auto& r : getConfig().routes) {
+            for (const auto srcPortId : r.sourcePortIds) {
+                mSourceRouteIndex[srcPortId].emplace_back(r.sinkPortId, !r.isExclusive);
+            }
+        }
+        mSourceRouteIndexDirty = false;
+    }
+    return mSourceRouteIndex;
+}
+
 void Module::registerPatch(const AudioPatch& patch) {
     auto& configs = getConfig().portConfigs;
     auto do_insert = [&](const std::vector<int32_t>& portConfigIds) {
@@ -395,6 +424,12 @@ ndk::ScopedAStatus Module::updateStreamsConnectedState(const AudioPatch& oldPatc
     return ndk::ScopedAStatus::ok();
 }
 
+binder_status_t Module::dump(int fd, const char** /*args*/, uint32_t /*numArgs*/) {
+    dprintf(fd, "Stream worker timing histograms (bucket label is the lower bound in us):\n%s",
+            mStreams.dumpWorkerStats().c_str());
+    return STATUS_OK;
+}
+
 ndk::ScopedAStatus Module::setModuleDebug(
         const ::aidl::android::hardware::audio::core::ModuleDebug& in_debug) {
     LOG(DEBUG) << __func__ << ": " << mType << ": old flags:" << mDebug.toString()
@@ -412,6 +447,11 @@ ndk::ScopedAStatus Module::setModuleDebug(
         return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
     }
     mDebug = in_debug;
+    // Deliver the update to the workers of active streams via their lock-free
+    // command rings, the data path must not be blocked by a control call.
+    mStreams.postDebugParameters(StreamContext::DebugParameters{
+            mDebug.streamTransientStateDelayMs, mVendorDebug.forceTransientBurst,
+            mVendorDebug.forceSynchronousDrain});
     return ndk::ScopedAStatus::ok();
 }
 
@@ -544,6 +584,7 @@ ndk::ScopedAStatus Module::connectExternalDevice(const AudioPort& in_templateIdA
         }
     }
     routes.insert(routes.end(), newRoutes.begin(), newRoutes.end());
+    mSourceRouteIndexDirty = true;
 
     // Note: this is a simplistic approach assuming that a mix port can only be populated
     // from a single device port. Implementing support for stuffing dynamic profiles with a superset
@@ -606,6 +647,7 @@ ndk::ScopedAStatus Module::disconnectExternalDevice(int32_t in_portId) {
             ++routesIt;
         }
     }
+    mSourceRouteIndexDirty = true;
 
     for (const auto mixPortId : connectedPortsIt->second) {
         auto mixPortIt = findById<AudioPort>(ports, mixPortId);
@@ -792,13 +834,12 @@ ndk::ScopedAStatus Module::setAudioPatch(const AudioPatch& in_requested, AudioPa
     // If only an exclusive route is available, that means the patch can not be
     // established if there is any other patch which currently uses the sink port.
     std::map<int32_t, bool> allowedSinkPorts;
-    auto& routes = getConfig().routes;
+    const auto& routeIndex = getSourceRouteIndex();
     for (auto src : sources) {
-        for (const auto& r : routes) {
-            const auto& srcs = r.sourcePortIds;
-            if (std::find(srcs.begin(), srcs.end(), src->portId) != srcs.end()) {
-                if (!allowedSinkPorts[r.sinkPortId]) {  // prefer non-exclusive
-                    allowedSinkPorts[r.sinkPortId] = !r.isExclusive;
+        if (auto routesIt = routeIndex.find(src->portId); routesIt != routeIndex.end()) {
+            for (const auto& [sinkPortId, nonExclusive] : routesIt->second) {
+                if (!allowedSinkPorts[sinkPortId]) {  // prefer non-exclusive
+                    allowedSinkPorts[sinkPortId] = nonExclusive;
                 }
             }
         }
@@ -1213,7 +1254,12 @@ ndk::ScopedAStatus Module::setVendorParameters(const std::vector<VendorParameter
             LOG(ERROR) << __func__ << ": unrecognized parameter \"" << p.id << "\"";
         }
     }
-    if (allParametersKnown) return ndk::ScopedAStatus::ok();
+    if (allParametersKnown) {
+        mStreams.postDebugParameters(StreamContext::DebugParameters{
+                mDebug.streamTransientStateDelayMs, mVendorDebug.forceTransientBurst,
+                mVendorDebug.forceSynchronousDrain});
+        return ndk::ScopedAStatus::ok();
+    }
     return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
 }
 
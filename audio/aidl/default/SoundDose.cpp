@@ -14,11 +14,18 @@
  * limitations under the License.
  */
 
+#include <cmath>
+
 #define LOG_TAG "AHAL_SoundDose"
 
 #include "core-impl/SoundDose.h"
 
 #include <android-base/logging.h>
+#include <utils/SystemClock.h>
+
+using aidl::android::media::audio::common::AudioFormatDescription;
+using aidl::android::media::audio::common::AudioFormatType;
+using aidl::android::media::audio::common::PcmType;
 
 namespace aidl::android::hardware::audio::core::sounddose {
 
@@ -44,6 +51,7 @@ ndk::ScopedAStatus SoundDose::registerSoundDoseCallback(
         LOG(ERROR) << __func__ << ": Callback is nullptr";
         return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
     }
+    std::lock_guard guard(mMutex);
     if (mCallback != nullptr) {
         LOG(ERROR) << __func__ << ": Sound dose callback was already registered";
         return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_STATE);
@@ -54,4 +62,49 @@ ndk::ScopedAStatus SoundDose::registerSoundDoseCallback(
     return ndk::ScopedAStatus::ok();
 }
 
+void SoundDose::process(const void* buffer, size_t frameCount, size_t frameSize,
+                        const AudioFormatDescription& format) {
+    if (format.type != AudioFormatType::PCM ||
+        (format.pcm != PcmType::INT_16_BIT && format.pcm != PcmType::FLOAT_32_BIT)) {
+        return;
+    }
+    // Interleaved samples are decimated without regard to the channel layout:
+    // for an energy estimate it only matters that the sideband is sampled evenly.
+    float sumOfSquares = 0.0f;
+    size_t count = 0;
+    if (format.pcm == PcmType::INT_16_BIT) {
+        const int16_t* data = static_cast<const int16_t*>(buffer);
+        const size_t sampleCount = frameCount * frameSize / sizeof(int16_t);
+        for (size_t i = 0; i < sampleCount; i += kEnergyDecimationFactor, ++count) {
+            const float sample = data[i] / 32768.0f;
+            sumOfSquares += sample * sample;
+        }
+    } else {
+        const float* data = static_cast<const float*>(buffer);
+        const size_t sampleCount = frameCount * frameSize / sizeof(float);
+        for (size_t i = 0; i < sampleCount; i += kEnergyDecimationFactor, ++count) {
+            sumOfSquares += data[i] * data[i];
+        }
+    }
+    if (count == 0) return;
+    const float meanSquare = sumOfSquares / count;
+    if (meanSquare <= 0.0f) return;
+    const float momentaryDbA = kFullScaleDbSpl + 10.0f * std::log10(meanSquare);
+    if (momentaryDbA < mRs2Value.load(std::memory_order_relaxed)) return;
+    // Rate limit the warnings; several workers may race here, losing a warning
+    // from one of them during the same interval is acceptable.
+    const int64_t nowNs = ::android::elapsedRealtimeNano();
+    if (nowNs - mLastWarningNs.load(std::memory_order_relaxed) < kWarningIntervalNs) return;
+    mLastWarningNs.store(nowNs, std::memory_order_relaxed);
+    std::lock_guard guard(mMutex);
+    if (mCallback != nullptr) {
+        ndk::ScopedAStatus status =
+                mCallback->onMomentaryExposureWarning(momentaryDbA, AudioDevice{});
+        if (!status.isOk()) {
+            LOG(WARNING) << __func__
+                         << ": error while sending the exposure warning: " << status.getDescription();
+        }
+    }
+}
+
 }  // namespace aidl::android::hardware::audio::core::sounddose
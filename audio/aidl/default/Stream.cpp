@@ -45,6 +45,26 @@ using aidl::android::media::audio::common::MicrophoneInfo;
 
 namespace aidl::android::hardware::audio::core {
 
+std::string WorkerStats::toString() const {
+    static constexpr const char* kMetricNames[METRIC_COUNT] = {"fmq wait", "transfer", "cycle"};
+    std::string result;
+    for (size_t metric = 0; metric < METRIC_COUNT; ++metric) {
+        result.append("  ").append(kMetricNames[metric]).append(" (us):");
+        uint64_t total = 0;
+        for (size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+            const uint32_t count = mBuckets[metric][bucket].load(std::memory_order_relaxed);
+            if (count == 0) continue;
+            total += count;
+            result.append(" [")
+                    .append(std::to_string(1L << bucket))
+                    .append("]: ")
+                    .append(std::to_string(count));
+        }
+        result.append(", total: ").append(std::to_string(total)).append("\n");
+    }
+    return result;
+}
+
 void StreamContext::fillDescriptor(StreamDescriptor* desc) {
     if (mCommandMQ) {
         desc->command = mCommandMQ->dupeDesc();
@@ -149,6 +169,7 @@ void StreamWorkerCommonLogic::populateReplyWrongState(
 const std::string StreamInWorkerLogic::kThreadName = "reader";
 
 StreamInWorkerLogic::Status StreamInWorkerLogic::cycle() {
+    applyControlCommands();
     // Note: for input streams, draining is driven by the client, thus
     // "empty buffer" condition can only happen while handling the 'burst'
     // command. Thus, unlike for output streams, it does not make sense to
@@ -156,11 +177,14 @@ StreamInWorkerLogic::Status StreamInWorkerLogic::cycle() {
     // TODO: Add a delay for transitions of async operations when/if they added.
 
     StreamDescriptor::Command command{};
+    const auto commandWaitStart = std::chrono::steady_clock::now();
     if (!mContext->getCommandMQ()->readBlocking(&command, 1)) {
         LOG(ERROR) << __func__ << ": reading of command from MQ failed";
         mState = StreamDescriptor::State::ERROR;
         return Status::ABORT;
     }
+    const auto commandReceived = std::chrono::steady_clock::now();
+    mContext->getWorkerStats().record(WorkerStats::FMQ_WAIT, commandReceived - commandWaitStart);
     using Tag = StreamDescriptor::Command::Tag;
     using LogSeverity = ::android::base::LogSeverity;
     const LogSeverity severity =
@@ -297,42 +321,61 @@ StreamInWorkerLogic::Status StreamInWorkerLogic::cycle() {
         mState = StreamDescriptor::State::ERROR;
         return Status::ABORT;
     }
+    mContext->getWorkerStats().record(WorkerStats::CYCLE,
+                                      std::chrono::steady_clock::now() - commandReceived);
     return Status::CONTINUE;
 }
 
 bool StreamInWorkerLogic::read(size_t clientSize, StreamDescriptor::Reply* reply) {
     StreamContext::DataMQ* const dataMQ = mContext->getDataMQ();
-    const size_t byteCount = std::min({clientSize, dataMQ->availableToWrite(), mDataBufferSize});
     const bool isConnected = mIsConnected;
     const size_t frameSize = mContext->getFrameSize();
-    size_t actualFrameCount = 0;
+    const int batchBursts = mContext->getBatchBursts();
+    size_t remainingByteCount = clientSize;
     bool fatal = false;
     int32_t latency = Module::kLatencyMs;
-    if (isConnected) {
-        if (::android::status_t status = mDriver->transfer(mDataBuffer.get(), byteCount / frameSize,
-                                                           &actualFrameCount, &latency);
-            status != ::android::OK) {
-            fatal = true;
-            LOG(ERROR) << __func__ << ": read failed: " << status;
+    // When batching is enabled ('batchBursts' > 1), fill several bursts into the data MQ
+    // during one wake up, so that the worker can sleep proportionally longer between cycles.
+    for (int burst = 0; burst < batchBursts; ++burst) {
+        const size_t byteCount =
+                std::min({remainingByteCount, dataMQ->availableToWrite(), mDataBufferSize});
+        size_t actualFrameCount = 0;
+        if (isConnected) {
+            const auto transferStart = std::chrono::steady_clock::now();
+            if (::android::status_t status = mDriver->transfer(
+                        mDataBuffer.get(), byteCount / frameSize, &actualFrameCount, &latency);
+                status != ::android::OK) {
+                fatal = true;
+                LOG(ERROR) << __func__ << ": read failed: " << status;
+            }
+            mContext->getWorkerStats().record(WorkerStats::TRANSFER,
+                                              std::chrono::steady_clock::now() - transferStart);
+        } else {
+            usleep(3000);  // Simulate blocking transfer delay.
+            for (size_t i = 0; i < byteCount; ++i) mDataBuffer[i] = 0;
+            actualFrameCount = byteCount / frameSize;
+        }
+        const size_t actualByteCount = actualFrameCount * frameSize;
+        if (bool success =
+                    actualByteCount > 0 ? dataMQ->write(&mDataBuffer[0], actualByteCount) : true;
+            success) {
+            LOG(VERBOSE) << __func__ << ": writing of " << actualByteCount << " bytes into data MQ"
+                         << " succeeded; connected? " << isConnected;
+            // Frames are provided and counted regardless of connection status.
+            reply->fmqByteCount += actualByteCount;
+            mContext->advanceFrameCount(actualFrameCount);
+            populateReply(reply, isConnected);
+        } else {
+            LOG(WARNING) << __func__ << ": writing of " << actualByteCount
+                         << " bytes of data to MQ failed";
+            reply->status = STATUS_NOT_ENOUGH_DATA;
+            break;
+        }
+        remainingByteCount -= actualByteCount;
+        if (fatal || actualByteCount < byteCount || remainingByteCount < frameSize ||
+            dataMQ->availableToWrite() < frameSize) {
+            break;
         }
-    } else {
-        usleep(3000);  // Simulate blocking transfer delay.
-        for (size_t i = 0; i < byteCount; ++i) mDataBuffer[i] = 0;
-        actualFrameCount = byteCount / frameSize;
-    }
-    const size_t actualByteCount = actualFrameCount * frameSize;
-    if (bool success = actualByteCount > 0 ? dataMQ->write(&mDataBuffer[0], actualByteCount) : true;
-        success) {
-        LOG(VERBOSE) << __func__ << ": writing of " << actualByteCount << " bytes into data MQ"
-                     << " succeeded; connected? " << isConnected;
-        // Frames are provided and counted regardless of connection status.
-        reply->fmqByteCount += actualByteCount;
-        mContext->advanceFrameCount(actualFrameCount);
-        populateReply(reply, isConnected);
-    } else {
-        LOG(WARNING) << __func__ << ": writing of " << actualByteCount
-                     << " bytes of data to MQ failed";
-        reply->status = STATUS_NOT_ENOUGH_DATA;
     }
     reply->latencyMs = latency;
     return !fatal;
@@ -341,6 +384,7 @@ bool StreamInWorkerLogic::read(size_t clientSize, StreamDescriptor::Reply* reply
 const std::string StreamOutWorkerLogic::kThreadName = "writer";
 
 StreamOutWorkerLogic::Status StreamOutWorkerLogic::cycle() {
+    applyControlCommands();
     if (mState == StreamDescriptor::State::DRAINING ||
         mState == StreamDescriptor::State::TRANSFERRING) {
         if (auto stateDurationMs = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -375,11 +419,14 @@ StreamOutWorkerLogic::Status StreamOutWorkerLogic::cycle() {
     }
 
     StreamDescriptor::Command command{};
+    const auto commandWaitStart = std::chrono::steady_clock::now();
     if (!mContext->getCommandMQ()->readBlocking(&command, 1)) {
         LOG(ERROR) << __func__ << ": reading of command from MQ failed";
         mState = StreamDescriptor::State::ERROR;
         return Status::ABORT;
     }
+    const auto commandReceived = std::chrono::steady_clock::now();
+    mContext->getWorkerStats().record(WorkerStats::FMQ_WAIT, commandReceived - commandWaitStart);
     using Tag = StreamDescriptor::Command::Tag;
     using LogSeverity = ::android::base::LogSeverity;
     const LogSeverity severity =
@@ -565,49 +612,75 @@ StreamOutWorkerLogic::Status StreamOutWorkerLogic::cycle() {
         mState = StreamDescriptor::State::ERROR;
         return Status::ABORT;
     }
+    mContext->getWorkerStats().record(WorkerStats::CYCLE,
+                                      std::chrono::steady_clock::now() - commandReceived);
     return Status::CONTINUE;
 }
 
 bool StreamOutWorkerLogic::write(size_t clientSize, StreamDescriptor::Reply* reply) {
     StreamContext::DataMQ* const dataMQ = mContext->getDataMQ();
-    const size_t readByteCount = dataMQ->availableToRead();
     const size_t frameSize = mContext->getFrameSize();
+    const int batchBursts = mContext->getBatchBursts();
+    size_t remainingByteCount = clientSize;
     bool fatal = false;
     int32_t latency = Module::kLatencyMs;
-    if (bool success = readByteCount > 0 ? dataMQ->read(&mDataBuffer[0], readByteCount) : true) {
-        const bool isConnected = mIsConnected;
-        LOG(VERBOSE) << __func__ << ": reading of " << readByteCount << " bytes from data MQ"
-                     << " succeeded; connected? " << isConnected;
-        // Amount of data that the HAL module is going to actually use.
-        size_t byteCount = std::min({clientSize, readByteCount, mDataBufferSize});
-        if (byteCount >= frameSize && mContext->getForceTransientBurst()) {
-            // In order to prevent the state machine from going to ACTIVE state,
-            // simulate partial write.
-            byteCount -= frameSize;
-        }
-        size_t actualFrameCount = 0;
-        if (isConnected) {
-            if (::android::status_t status = mDriver->transfer(
-                        mDataBuffer.get(), byteCount / frameSize, &actualFrameCount, &latency);
-                status != ::android::OK) {
-                fatal = true;
-                LOG(ERROR) << __func__ << ": write failed: " << status;
+    // When batching is enabled ('batchBursts' > 1), drain several bursts from the data MQ
+    // during one wake up, so that the worker can sleep proportionally longer between cycles.
+    for (int burst = 0; burst < batchBursts; ++burst) {
+        const size_t readByteCount =
+                std::min({remainingByteCount, dataMQ->availableToRead(), mDataBufferSize});
+        if (bool success = readByteCount > 0 ? dataMQ->read(&mDataBuffer[0], readByteCount)
+                                             : true) {
+            const bool isConnected = mIsConnected;
+            LOG(VERBOSE) << __func__ << ": reading of " << readByteCount << " bytes from data MQ"
+                         << " succeeded; connected? " << isConnected;
+            // Amount of data that the HAL module is going to actually use.
+            size_t byteCount = readByteCount;
+            if (byteCount >= frameSize && mContext->getForceTransientBurst()) {
+                // In order to prevent the state machine from going to ACTIVE state,
+                // simulate partial write.
+                byteCount -= frameSize;
             }
-        } else {
-            if (mContext->getAsyncCallback() == nullptr) {
-                usleep(3000);  // Simulate blocking transfer delay.
+            if (byteCount >= frameSize) {
+                if (auto processor = mContext->getStreamDataProcessor().lock();
+                    processor != nullptr) {
+                    processor->process(mDataBuffer.get(), byteCount / frameSize, frameSize,
+                                       mContext->getFormat());
+                }
             }
-            actualFrameCount = byteCount / frameSize;
+            size_t actualFrameCount = 0;
+            if (isConnected) {
+                const auto transferStart = std::chrono::steady_clock::now();
+                if (::android::status_t status = mDriver->transfer(
+                            mDataBuffer.get(), byteCount / frameSize, &actualFrameCount, &latency);
+                    status != ::android::OK) {
+                    fatal = true;
+                    LOG(ERROR) << __func__ << ": write failed: " << status;
+                }
+                mContext->getWorkerStats().record(WorkerStats::TRANSFER,
+                                                  std::chrono::steady_clock::now() - transferStart);
+            } else {
+                if (mContext->getAsyncCallback() == nullptr) {
+                    usleep(3000);  // Simulate blocking transfer delay.
+                }
+                actualFrameCount = byteCount / frameSize;
+            }
+            const size_t actualByteCount = actualFrameCount * frameSize;
+            // Frames are consumed and counted regardless of the connection status.
+            reply->fmqByteCount += actualByteCount;
+            mContext->advanceFrameCount(actualFrameCount);
+            populateReply(reply, isConnected);
+            remainingByteCount -= readByteCount;
+            if (fatal || actualByteCount < byteCount || remainingByteCount < frameSize ||
+                dataMQ->availableToRead() < frameSize) {
+                break;
+            }
+        } else {
+            LOG(WARNING) << __func__ << ": reading of " << readByteCount
+                         << " bytes of data from MQ failed";
+            reply->status = STATUS_NOT_ENOUGH_DATA;
+            break;
         }
-        const size_t actualByteCount = actualFrameCount * frameSize;
-        // Frames are consumed and counted regardless of the connection status.
-        reply->fmqByteCount += actualByteCount;
-        mContext->advanceFrameCount(actualFrameCount);
-        populateReply(reply, isConnected);
-    } else {
-        LOG(WARNING) << __func__ << ": reading of " << readByteCount
-                     << " bytes of data from MQ failed";
-        reply->status = STATUS_NOT_ENOUGH_DATA;
     }
     reply->latencyMs = latency;
     return !fatal;
@@ -15,6 +15,7 @@
  */
 
 #include <limits>
+#include <thread>
 
 #define LOG_TAG "AHAL_StreamSwitcher"
 
@@ -188,16 +189,24 @@ ndk::ScopedAStatus StreamSwitcher::setConnectedDevices(const std::vector<AudioDe
         mIsStubStream = false;
     } else {
         LOG(DEBUG) << __func__ << ": connected devices changed, switching stream";
-        // Two streams can't be opened for the same context, thus we always need to close
-        // the current one before creating a new one.
-        RETURN_STATUS_IF_ERROR(closeCurrentStream(true /*validateStreamState*/));
+        // Two streams can't be opened for the same context because its FMQs are shared
+        // with the client and are fixed at the stream open time. Thus the new stream may
+        // only start its worker after the current one has been closed. However, creation
+        // of the new stream object does not touch the FMQs, so it runs concurrently with
+        // the teardown of the current worker to shorten the switch gap.
+        ndk::ScopedAStatus closeStatus;
+        std::thread closeThread(
+                [&]() { closeStatus = closeCurrentStream(true /*validateStreamState*/); });
+        std::unique_ptr<StreamCommonInterfaceEx> newStream;
         if (behavior == CREATE_NEW_STREAM) {
-            mStream = createNewStream(devices, mContext, mMetadata);
-            mIsStubStream = false;
+            newStream = createNewStream(devices, mContext, mMetadata);
         } else {  // SWITCH_TO_STUB_STREAM
-            mStream.reset(new InnerStreamWrapper<StreamStub>(mContext, mMetadata));
-            mIsStubStream = true;
+            newStream.reset(new InnerStreamWrapper<StreamStub>(mContext, mMetadata));
         }
+        closeThread.join();
+        RETURN_STATUS_IF_ERROR(std::move(closeStatus));
+        mStream = std::move(newStream);
+        mIsStubStream = behavior != CREATE_NEW_STREAM;
         // The delegate is null because StreamSwitcher handles IStreamCommon methods by itself.
         if (ndk::ScopedAStatus status = mStream->initInstance(nullptr); !status.isOk()) {
             if (mIsStubStream) {
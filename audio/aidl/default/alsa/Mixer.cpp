@@ -40,20 +40,45 @@ const std::map<Mixer::Control, std::vector<Mixer::ControlNamesAndExpectedCtlType
 // static
 Mixer::Controls Mixer::initializeMixerControls(struct mixer* mixer) {
     if (mixer == nullptr) return {};
+    // Cards can expose a hundred or more controls, and 'mixer_get_ctl_by_name'
+    // scans all of them on every call. Walk the control list once instead and
+    // match each name against the candidates.
+    std::map<std::string, std::pair<Control, enum mixer_ctl_type>> candidates;
+    std::map<std::string, size_t> candidatePriorities;
+    for (const auto& [control, possibleCtls] : kPossibleControls) {
+        for (size_t priority = 0; priority < possibleCtls.size(); ++priority) {
+            const auto& [ctlName, expectedCtlType] = possibleCtls[priority];
+            candidates.emplace(ctlName, std::make_pair(control, expectedCtlType));
+            candidatePriorities.emplace(ctlName, priority);
+        }
+    }
     Controls mixerControls;
+    std::map<Control, size_t> chosenPriorities;
+    const unsigned int numCtls = mixer_get_num_ctls(mixer);
+    for (unsigned int i = 0; i < numCtls; ++i) {
+        struct mixer_ctl* ctl = mixer_get_ctl(mixer, i);
+        if (ctl == nullptr) continue;
+        const char* ctlName = mixer_ctl_get_name(ctl);
+        if (ctlName == nullptr) continue;
+        auto candidateIt = candidates.find(ctlName);
+        if (candidateIt == candidates.end() ||
+            mixer_ctl_get_type(ctl) != candidateIt->second.second) {
+            continue;
+        }
+        const Control control = candidateIt->second.first;
+        const size_t priority = candidatePriorities[candidateIt->first];
+        auto chosenIt = chosenPriorities.find(control);
+        if (chosenIt == chosenPriorities.end() || priority < chosenIt->second) {
+            mixerControls[control] = ctl;
+            chosenPriorities[control] = priority;
+        }
+    }
     std::string mixerCtlNames;
-    for (const auto& [control, possibleCtls] : kPossibleControls) {
-        for (const auto& [ctlName, expectedCtlType] : possibleCtls) {
-            struct mixer_ctl* ctl = mixer_get_ctl_by_name(mixer, ctlName.c_str());
-            if (ctl != nullptr && mixer_ctl_get_type(ctl) == expectedCtlType) {
-                mixerControls.emplace(control, ctl);
-                if (!mixerCtlNames.empty()) {
-                    mixerCtlNames += ",";
-                }
-                mixerCtlNames += ctlName;
-                break;
-            }
+    for (const auto& [control, ctl] : mixerControls) {
+        if (!mixerCtlNames.empty()) {
+            mixerCtlNames += ",";
         }
+        mixerCtlNames += mixer_ctl_get_name(ctl);
     }
     LOG(DEBUG) << __func__ << ": available mixer control names=[" << mixerCtlNames << "]";
     return mixerControls;
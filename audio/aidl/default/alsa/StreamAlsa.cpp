@@ -19,6 +19,7 @@
 
 #define LOG_TAG "AHAL_StreamAlsa"
 #include <android-base/logging.h>
+#include <android-base/properties.h>
 
 #include <Utils.h>
 #include <audio_utils/clock.h>
@@ -28,6 +29,16 @@
 
 namespace aidl::android::hardware::audio::core {
 
+namespace {
+
+// When set, transfers bypass 'proxy_read' / 'proxy_write' and use the mmap'ed
+// ALSA ring buffer instead, saving one buffer copy per burst. Not all ALSA
+// devices support mmap transfers, thus this is opt-in; the stream falls back
+// to the proxy based path if the device can not be opened with 'PCM_MMAP'.
+constexpr char kUseMmapDataPathProperty[] = "ro.boot.audio.tinyalsa.use_mmap";
+
+}  // namespace
+
 StreamAlsa::StreamAlsa(StreamContext* context, const Metadata& metadata, int readWriteRetries)
     : StreamCommonImpl(context, metadata),
       mBufferSizeFrames(getContext().getBufferSizeInFrames()),
@@ -35,7 +46,8 @@ StreamAlsa::StreamAlsa(StreamContext* context, const Metadata& metadata, int rea
       mSampleRate(getContext().getSampleRate()),
       mIsInput(isInput(metadata)),
       mConfig(alsa::getPcmConfig(getContext(), mIsInput)),
-      mReadWriteRetries(readWriteRetries) {}
+      mReadWriteRetries(readWriteRetries),
+      mMmapDataPath(::android::base::GetBoolProperty(kUseMmapDataPathProperty, false)) {}
 
 ::android::status_t StreamAlsa::init() {
     return mConfig.has_value() ? ::android::OK : ::android::NO_INIT;
@@ -61,14 +73,23 @@ StreamAlsa::StreamAlsa(StreamContext* context, const Metadata& metadata, int rea
 
 ::android::status_t StreamAlsa::standby() {
     mAlsaDeviceProxies.clear();
+    mMmapPcm.reset();
     return ::android::OK;
 }
 
 ::android::status_t StreamAlsa::start() {
-    if (!mAlsaDeviceProxies.empty()) {
+    if (!mAlsaDeviceProxies.empty() || mMmapPcm != nullptr) {
         // This is a resume after a pause.
         return ::android::OK;
     }
+    if (const auto deviceProfiles = getDeviceProfiles();
+        mMmapDataPath && deviceProfiles.size() == 1 && !deviceProfiles[0].isExternal) {
+        if (mmapStart(deviceProfiles[0]) == ::android::OK) {
+            return ::android::OK;
+        }
+        LOG(WARNING) << __func__ << ": mmap data path is not available for "
+                     << deviceProfiles[0] << ", falling back to proxy transfers";
+    }
     decltype(mAlsaDeviceProxies) alsaDeviceProxies;
     for (const auto& device : getDeviceProfiles()) {
         alsa::DeviceProxy proxy;
@@ -92,8 +113,44 @@ StreamAlsa::StreamAlsa(StreamContext* context, const Metadata& metadata, int rea
     return ::android::OK;
 }
 
+::android::status_t StreamAlsa::mmapStart(const alsa::DeviceProfile& device) {
+    struct pcm_config config = mConfig.value();
+    struct pcm* pcm = pcm_open(device.card, device.device,
+                               (mIsInput ? PCM_IN : PCM_OUT) | PCM_MMAP | PCM_MONOTONIC, &config);
+    if (pcm == nullptr) {
+        return ::android::NO_INIT;
+    }
+    if (!pcm_is_ready(pcm)) {
+        LOG(DEBUG) << __func__ << ": pcm is not ready: " << pcm_get_error(pcm);
+        pcm_close(pcm);
+        return ::android::NO_INIT;
+    }
+    mMmapPcm = MmapPcm(pcm, pcm_close);
+    LOG(DEBUG) << __func__ << ": using mmap data path for " << device;
+    return ::android::OK;
+}
+
+::android::status_t StreamAlsa::mmapTransfer(void* buffer, size_t frameCount,
+                                             size_t* actualFrameCount, int32_t* latencyMs) {
+    const size_t bytesToTransfer = frameCount * mFrameSizeBytes;
+    // The transfer happens directly between the caller's buffer and the mmap'ed
+    // ALSA ring, there is no intermediate copy into a driver-owned buffer.
+    if (int err = mIsInput ? pcm_mmap_read(mMmapPcm.get(), buffer, bytesToTransfer)
+                           : pcm_mmap_write(mMmapPcm.get(), buffer, bytesToTransfer);
+        err != 0) {
+        LOG(ERROR) << __func__ << ": mmap transfer failed: " << err;
+        return ::android::INVALID_OPERATION;
+    }
+    *actualFrameCount = frameCount;
+    *latencyMs = pcm_get_buffer_size(mMmapPcm.get()) * MILLIS_PER_SECOND / mSampleRate;
+    return ::android::OK;
+}
+
 ::android::status_t StreamAlsa::transfer(void* buffer, size_t frameCount, size_t* actualFrameCount,
                                          int32_t* latencyMs) {
+    if (mMmapPcm != nullptr) {
+        return mmapTransfer(buffer, frameCount, actualFrameCount, latencyMs);
+    }
     if (mAlsaDeviceProxies.empty()) {
         LOG(FATAL) << __func__ << ": no opened devices";
         return ::android::NO_INIT;
@@ -118,6 +175,17 @@ StreamAlsa::StreamAlsa(StreamContext* context, const Metadata& metadata, int rea
 }
 
 ::android::status_t StreamAlsa::refinePosition(StreamDescriptor::Position* position) {
+    if (mMmapPcm != nullptr) {
+        unsigned int availableFrames;
+        struct timespec timestamp;
+        if (int ret = pcm_get_htimestamp(mMmapPcm.get(), &availableFrames, &timestamp); ret == 0) {
+            position->timeNs = audio_utils_ns_from_timespec(&timestamp);
+        } else {
+            LOG(WARNING) << __func__ << ": failed to retrieve mmap timestamp: " << ret;
+            return ::android::INVALID_OPERATION;
+        }
+        return ::android::OK;
+    }
     if (mAlsaDeviceProxies.empty()) {
         LOG(FATAL) << __func__ << ": no opened devices";
         return ::android::NO_INIT;
@@ -153,6 +221,7 @@ StreamAlsa::StreamAlsa(StreamContext* context, const Metadata& metadata, int rea
 
 void StreamAlsa::shutdown() {
     mAlsaDeviceProxies.clear();
+    mMmapPcm.reset();
 }
 
 }  // namespace aidl::android::hardware::audio::core
@@ -164,17 +164,36 @@ RetCode BassBoostSw::releaseContext() {
 
 // Processing method running in EffectWorker thread.
 IEffect::Status BassBoostSw::effectProcessImpl(float* in, float* out, int samples) {
-    // TODO: get data buffer and process.
-    LOG(DEBUG) << __func__ << " in " << in << " out " << out << " samples " << samples;
-    for (int i = 0; i < samples; i++) {
-        *out++ = *in++;
-    }
+    LOG(VERBOSE) << __func__ << " in " << in << " out " << out << " samples " << samples;
+    mContext->process(out, in, samples);
     return {STATUS_OK, samples, samples};
 }
 
 RetCode BassBoostSwContext::setBbStrengthPm(int strength) {
     mStrength = strength;
+    if (strength > 0) {
+        // Map the per-mille strength onto the shelf gain and rebuild the filter.
+        // The state restarts from silence which is acceptable on a strength change.
+        const float gainDb = kMaxBoostDb * strength / 1000.0f;
+        mFilter.emplace(
+                ::aidl::android::hardware::audio::common::getChannelCount(
+                        mCommon.input.base.channelMask),
+                std::vector<::android::hardware::audio::common::BiquadCoefficients>{
+                        ::android::hardware::audio::common::makeLowShelfCoefficients(
+                                mCommon.input.base.sampleRate, kShelfFrequencyHz,
+                                1.0f /* slope */, gainDb)});
+    } else {
+        mFilter.reset();
+    }
     return RetCode::SUCCESS;
 }
 
+void BassBoostSwContext::process(float* out, const float* in, int samples) {
+    if (mFilter.has_value()) {
+        mFilter->process(out, in, samples / mFilter->getChannelCount());
+    } else {
+        std::copy(in, in + samples, out);
+    }
+}
+
 }  // namespace aidl::android::hardware::audio::effect
@@ -17,9 +17,11 @@
 #pragma once
 
 #include <aidl/android/hardware/audio/effect/BnEffect.h>
+#include <BiquadCascade.h>
 #include <fmq/AidlMessageQueue.h>
 #include <cstdlib>
 #include <memory>
+#include <optional>
 
 #include "effect-impl/EffectImpl.h"
 
@@ -34,9 +36,17 @@ class BassBoostSwContext final : public EffectContext {
 
     RetCode setBbStrengthPm(int strength);
     int getBbStrengthPm() const { return mStrength; }
+    // Applies the low shelf boost corresponding to the current strength.
+    void process(float* out, const float* in, int samples);
 
   private:
+    // The shelf corner frequency and the boost applied at maximum strength.
+    static constexpr float kShelfFrequencyHz = 200.0f;
+    static constexpr float kMaxBoostDb = 12.0f;
+
     int mStrength = 0;
+    // Shared vectorized filter kernel, only engaged while the strength is non-zero.
+    std::optional<::android::hardware::audio::common::BiquadCascade> mFilter;
 };
 
 class BassBoostSw final : public EffectImpl {
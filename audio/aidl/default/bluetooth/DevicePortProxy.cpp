@@ -482,11 +482,13 @@ size_t BluetoothAudioPortAidlOut::writeData(const void* buffer, size_t bytes) co
     const size_t write_frames = bytes >> 2;
     if (write_frames == 0) return 0;
     auto src = static_cast<const int16_t*>(buffer);
-    std::unique_ptr<int16_t[]> dst{new int16_t[write_frames]};
-    downmix_to_mono_i16_from_stereo_i16(dst.get(), src, write_frames);
+    if (mDownmixBuffer.size() < write_frames) {
+        mDownmixBuffer.resize(write_frames);
+    }
+    downmix_to_mono_i16_from_stereo_i16(mDownmixBuffer.data(), src, write_frames);
     // a frame is 16 bits, and the size of a mono frame is equal to half a stereo.
-    auto totalWrite = BluetoothAudioSessionControl::OutWritePcmData(mSessionType, dst.get(),
-                                                                    write_frames * 2);
+    auto totalWrite = BluetoothAudioSessionControl::OutWritePcmData(
+            mSessionType, mDownmixBuffer.data(), write_frames * 2);
     return totalWrite * 2;
 }
 
@@ -245,8 +245,8 @@ ndk::ScopedAStatus DynamicsProcessingSw::getParameterDynamicsProcessing(
         }
     }
 
-    specific->set<Parameter::Specific::dynamicsProcessing>(dpParam);
-    LOG(INFO) << __func__ << specific->toString();
+    specific->set<Parameter::Specific::dynamicsProcessing>(std::move(dpParam));
+    LOG(VERBOSE) << __func__ << specific->toString();
     return ndk::ScopedAStatus::ok();
 }
 
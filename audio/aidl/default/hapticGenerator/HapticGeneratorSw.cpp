@@ -15,8 +15,11 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 
+#include <Utils.h>
+
 #define LOG_TAG "AHAL_HapticGeneratorSw"
 #include <android-base/logging.h>
 #include <fmq/AidlMessageQueue.h>
@@ -171,11 +174,8 @@ RetCode HapticGeneratorSw::releaseContext() {
 
 // Processing method running in EffectWorker thread.
 IEffect::Status HapticGeneratorSw::effectProcessImpl(float* in, float* out, int samples) {
-    // TODO: get data buffer and process.
-    LOG(DEBUG) << __func__ << " in " << in << " out " << out << " samples " << samples;
-    for (int i = 0; i < samples; i++) {
-        *out++ = *in++;
-    }
+    LOG(VERBOSE) << __func__ << " in " << in << " out " << out << " samples " << samples;
+    mContext->process(out, in, samples);
     return {STATUS_OK, samples, samples};
 }
 
@@ -195,4 +195,79 @@ std::vector<HapticGenerator::HapticScale> HapticGeneratorSwContext::getHgHapticS
     return result;
 }
 
+void HapticGeneratorSwContext::process(float* out, const float* in, int samples) {
+    std::copy(in, in + samples, out);
+    using ::aidl::android::hardware::audio::common::getChannelCount;
+    using ::aidl::android::media::audio::common::AudioChannelLayout;
+    const auto layout = mCommon.output.base.channelMask;
+    const size_t channelCount = getChannelCount(layout);
+    const size_t hapticChannelCount = getChannelCount(
+            layout,
+            AudioChannelLayout::CHANNEL_HAPTIC_A | AudioChannelLayout::CHANNEL_HAPTIC_B);
+    if (channelCount == 0 || hapticChannelCount == 0 || mHapticScales.empty()) return;
+    auto strongest = HapticGenerator::VibratorScale::MUTE;
+    for (const auto& [id, hapticScale] : mHapticScales) {
+        strongest = std::max(strongest, hapticScale.scale);
+    }
+    if (strongest == HapticGenerator::VibratorScale::MUTE) return;
+    const std::vector<float>& waveform = getWaveform(strongest);
+    if (waveform.empty()) return;
+    // By convention, the haptic channels are the last ones in an interleaved frame.
+    const size_t frameCount = samples / channelCount;
+    const size_t audioChannelCount = channelCount - hapticChannelCount;
+    for (size_t frame = 0; frame < frameCount; ++frame) {
+        const float value = waveform[mWaveformPos];
+        if (++mWaveformPos == waveform.size()) mWaveformPos = 0;
+        float* haptic = out + frame * channelCount + audioChannelCount;
+        for (size_t channel = 0; channel < hapticChannelCount; ++channel) {
+            haptic[channel] = value;
+        }
+    }
+}
+
+const std::vector<float>& HapticGeneratorSwContext::getWaveform(
+        HapticGenerator::VibratorScale scale) {
+    if (auto it = mWaveformCache.find(scale); it != mWaveformCache.end()) {
+        return it->second;
+    }
+    const int sampleRate = mCommon.input.base.sampleRate;
+    const float frequencyHz = mVibratorInformation.resonantFrequencyHz > 0.0f
+                                      ? mVibratorInformation.resonantFrequencyHz
+                                      : DEFAULT_RESONANT_FREQUENCY;
+    const size_t length =
+            sampleRate > 0 ? static_cast<size_t>(sampleRate * kWaveformDurationMs / 1000.0f) : 0;
+    std::vector<float> waveform(length);
+    const float gain = scaleToGain(scale);
+    constexpr float twoPi = 2.0f * static_cast<float>(M_PI);
+    const float phasePerSample = sampleRate > 0 ? twoPi * frequencyHz / sampleRate : 0.0f;
+    // The tone and the raised cosine envelope are applied in separate passes over
+    // contiguous data so that the compiler can vectorize both loops.
+    for (size_t i = 0; i < length; ++i) {
+        waveform[i] = std::sin(phasePerSample * i);
+    }
+    const float envelopePhase = twoPi / (length > 1 ? length - 1 : 1);
+    for (size_t i = 0; i < length; ++i) {
+        waveform[i] *= gain * 0.5f * (1.0f - std::cos(envelopePhase * i));
+    }
+    return mWaveformCache.emplace(scale, std::move(waveform)).first->second;
+}
+
+float HapticGeneratorSwContext::scaleToGain(HapticGenerator::VibratorScale scale) {
+    switch (scale) {
+        case HapticGenerator::VibratorScale::MUTE:
+            return 0.0f;
+        case HapticGenerator::VibratorScale::VERY_LOW:
+            return 0.25f;
+        case HapticGenerator::VibratorScale::LOW:
+            return 0.5f;
+        case HapticGenerator::VibratorScale::NONE:
+            return 1.0f;
+        case HapticGenerator::VibratorScale::HIGH:
+            return 1.5f;
+        case HapticGenerator::VibratorScale::VERY_HIGH:
+            return 2.0f;
+    }
+    return 1.0f;
+}
+
 }  // namespace aidl::android::hardware::audio::effect
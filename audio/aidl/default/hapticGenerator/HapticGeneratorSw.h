@@ -19,6 +19,7 @@
 #include <cstdlib>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <aidl/android/hardware/audio/effect/BnEffect.h>
 #include <fmq/AidlMessageQueue.h>
@@ -40,6 +41,8 @@ class HapticGeneratorSwContext final : public EffectContext {
     RetCode setHgVibratorInformation(const HapticGenerator::VibratorInformation& vibratorInfo) {
         // All float values are valid for resonantFrequencyHz, qFactor, maxAmplitude
         mVibratorInformation = vibratorInfo;
+        // The cached waveforms were synthesized for the previous resonant frequency.
+        mWaveformCache.clear();
         return RetCode::SUCCESS;
     }
 
@@ -47,13 +50,29 @@ class HapticGeneratorSwContext final : public EffectContext {
         return mVibratorInformation;
     }
 
+    // Passes the audio channels through and fills the haptic channels, if there are
+    // any in the output layout, with a synthesized waveform for the strongest
+    // configured scale. Waveform segments are cached, so repeated haptic events
+    // with the same parameters do not pay the synthesis cost again.
+    void process(float* out, const float* in, int samples);
+
   private:
     static constexpr float DEFAULT_RESONANT_FREQUENCY = 150.0f;
     static constexpr float DEFAULT_Q_FACTOR = 1.0f;
     static constexpr float DEFAULT_MAX_AMPLITUDE = 0.0f;
+    // The length of a synthesized haptic "click", chosen to cover several periods
+    // of a typical vibrator resonant frequency.
+    static constexpr float kWaveformDurationMs = 24.0f;
+
+    const std::vector<float>& getWaveform(HapticGenerator::VibratorScale scale);
+    static float scaleToGain(HapticGenerator::VibratorScale scale);
+
     std::map<int /* trackID */, HapticGenerator::HapticScale> mHapticScales;
     HapticGenerator::VibratorInformation mVibratorInformation = {
             DEFAULT_RESONANT_FREQUENCY, DEFAULT_Q_FACTOR, DEFAULT_MAX_AMPLITUDE};
+    // Keyed by the scale; a change of the resonant frequency empties the cache.
+    std::map<HapticGenerator::VibratorScale, std::vector<float>> mWaveformCache;
+    size_t mWaveformPos = 0;  // Only used on the effect worker thread.
 };
 
 class HapticGeneratorSw final : public EffectImpl {
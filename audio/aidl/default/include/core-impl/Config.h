@@ -29,10 +29,10 @@ class Config : public BnConfig {
     ndk::ScopedAStatus getSurroundSoundConfig(SurroundSoundConfig* _aidl_return) override;
     ndk::ScopedAStatus getEngineConfig(
             aidl::android::media::audio::common::AudioHalEngineConfig* _aidl_return) override;
-    internal::AudioPolicyConfigXmlConverter mAudioPolicyConverter{
-            ::android::audio_get_audio_policy_config_file()};
-    internal::EngineConfigXmlConverter mEngConfigConverter{
-            ::android::audio_find_readable_configuration_file(kEngineConfigFileName.c_str())};
+    // The converters are created lazily so that 'getEngineConfig' can be served
+    // from the binary cache without parsing the XML files, see Config.cpp.
+    static internal::AudioPolicyConfigXmlConverter& getAudioPolicyConverter();
+    static internal::EngineConfigXmlConverter& getEngConfigConverter();
 };
 
 }  // namespace aidl::android::hardware::audio::core
@@ -18,6 +18,7 @@
 
 #include <condition_variable>
 #include <mutex>
+#include <vector>
 
 #include <android-base/thread_annotations.h>
 
@@ -231,6 +232,12 @@ class BluetoothAudioPortAidlOut : public BluetoothAudioPortAidl {
   public:
     // The audio data path to the Bluetooth stack (Software encoding)
     size_t writeData(const void* buffer, size_t bytes) const override;
+
+  private:
+    // Scratch buffer for the stereo to mono downmix, kept across writes so the
+    // data path does not allocate once it reaches its steady-state burst size.
+    // Only touched by the stream worker thread which performs the transfers.
+    mutable std::vector<int16_t> mDownmixBuffer;
 };
 
 class BluetoothAudioPortAidlIn : public BluetoothAudioPortAidl {
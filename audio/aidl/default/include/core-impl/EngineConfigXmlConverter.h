@@ -18,6 +18,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <utils/Errors.h>
 
@@ -42,6 +43,31 @@ class EngineConfigXmlConverter {
 
     ::aidl::android::media::audio::common::AudioHalEngineConfig& getAidlEngineConfig();
 
+    /**
+     * Criterion rules compiled post-conversion into a dense decision table.
+     * Criterion names and value literals are resolved to integer indices once,
+     * so per-routing-decision evaluation works by index (bit position for
+     * inclusive criteria) instead of string-keyed map walks.
+     */
+    struct CapCriterionTable {
+        struct Criterion {
+            // Index into capSpecificConfig.criterionTypes, or -1 when the
+            // criterion references an unknown type.
+            int typeIndex = -1;
+            bool isInclusive = false;
+            // Dense value index per value literal of the criterion type.
+            std::unordered_map<std::string, int> valueIndex;
+            // Index of defaultLiteralValue, or -1 when not a listed value.
+            int defaultValueIndex = -1;
+        };
+        // Parallel to capSpecificConfig.criteria.
+        std::vector<Criterion> criteria;
+        // Criterion name -> index into criteria.
+        std::unordered_map<std::string, size_t> criterionIndex;
+    };
+
+    const CapCriterionTable& getCapCriterionTable() const { return mCapCriterionTable; }
+
   private:
     const std::optional<::android::audio::policy::engine::configuration::Configuration>&
     getXsdcConfig() {
@@ -49,6 +75,7 @@ class EngineConfigXmlConverter {
     }
     void init();
     void initProductStrategyMap();
+    void compileCapCriterionTable();
     ::aidl::android::media::audio::common::AudioAttributes convertAudioAttributesToAidl(
             const ::android::audio::policy::engine::configuration::AttributesType&
                     xsdcAudioAttributes);
@@ -86,6 +113,7 @@ class EngineConfigXmlConverter {
     int mNextVendorStrategy = ::aidl::android::media::audio::common::AudioHalProductStrategy::
             VENDOR_STRATEGY_ID_START;
     std::optional<int> mDefaultProductStrategyId;
+    CapCriterionTable mCapCriterionTable;
 };
 
 }  // namespace aidl::android::hardware::audio::core::internal
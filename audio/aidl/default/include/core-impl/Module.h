@@ -25,6 +25,7 @@
 
 #include "core-impl/ChildInterface.h"
 #include "core-impl/Configuration.h"
+#include "core-impl/SoundDose.h"
 #include "core-impl/Stream.h"
 
 namespace aidl::android::hardware::audio::core {
@@ -33,6 +34,9 @@ class Module : public BnModule {
   public:
     // This value is used for all AudioPatches and reported by all streams.
     static constexpr int32_t kLatencyMs = 10;
+    // The number of data MQ bursts that workers of deep buffer and compressed offload
+    // streams may process during one wake up, see 'StreamContext::getBatchBursts'.
+    static constexpr int32_t kBatchBurstsForHighLatencyStreams = 4;
     enum Type : int { DEFAULT, R_SUBMIX, STUB, USB, BLUETOOTH };
     enum BtInterface : int { BTCONF, BTA2DP, BTLE };
 
@@ -44,6 +48,9 @@ class Module : public BnModule {
                        std::weak_ptr<IBluetoothLe>>
             BtProfileHandles;
 
+    // Prints the worker timing histograms of the streams, see 'WorkerStats'.
+    binder_status_t dump(int fd, const char** args, uint32_t numArgs) override;
+
   protected:
     // The vendor extension done via inheritance can override interface methods and augment
     // a call to the base implementation.
@@ -146,6 +153,9 @@ class Module : public BnModule {
     // Maps port ids and port config ids to patch ids.
     // Multimap because both ports and configs can be used by multiple patches.
     using Patches = std::multimap<int32_t, int32_t>;
+    // Maps a source port id to the sink ports routable from it. The boolean is 'true'
+    // when a non-exclusive route to that sink exists.
+    using SourceRouteIndex = std::map<int32_t, std::vector<std::pair<int32_t, bool>>>;
 
     const Type mType;
     std::unique_ptr<internal::Configuration> mConfig;
@@ -154,10 +164,16 @@ class Module : public BnModule {
     ConnectedDevicePorts mConnectedDevicePorts;
     Streams mStreams;
     Patches mPatches;
+    // Rebuilt lazily after the routes change (external device connection / disconnection),
+    // so patch feasibility checks do not rescan the routes list on every setAudioPatch.
+    SourceRouteIndex mSourceRouteIndex;
+    bool mSourceRouteIndexDirty = true;
     bool mMicMute = false;
     bool mMasterMute = false;
     float mMasterVolume = 1.0f;
-    ChildInterface<sounddose::ISoundDose> mSoundDose;
+    // The concrete class is used because the instance is shared with output streams
+    // as their data processor, see 'createStreamContext'.
+    ChildInterface<sounddose::SoundDose> mSoundDose;
     std::optional<bool> mIsMmapSupported;
 
   protected:
@@ -209,6 +225,7 @@ class Module : public BnModule {
     bool getMasterVolume() const { return mMasterVolume; }
     bool getMicMute() const { return mMicMute; }
     const Patches& getPatches() const { return mPatches; }
+    const SourceRouteIndex& getSourceRouteIndex();
     const Streams& getStreams() const { return mStreams; }
     Type getType() const { return mType; }
     bool isMmapSupported();
@@ -16,16 +16,19 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 
 #include <aidl/android/hardware/audio/core/sounddose/BnSoundDose.h>
 #include <aidl/android/media/audio/common/AudioDevice.h>
 
+#include "core-impl/Stream.h"
+
 using aidl::android::media::audio::common::AudioDevice;
 
 namespace aidl::android::hardware::audio::core::sounddose {
 
-class SoundDose : public BnSoundDose {
+class SoundDose : public BnSoundDose, public StreamDataProcessorInterface {
   public:
     SoundDose() : mRs2Value(DEFAULT_MAX_RS2){};
 
@@ -34,9 +37,28 @@ class SoundDose : public BnSoundDose {
     ndk::ScopedAStatus registerSoundDoseCallback(
             const std::shared_ptr<ISoundDose::IHalSoundDoseCallback>& in_callback) override;
 
+    // Called by output stream workers. Instead of analyzing the full-rate signal,
+    // a 'kEnergyDecimationFactor' times downsampled energy sideband is summed, which
+    // is sufficient for momentary exposure estimation and keeps the per-burst cost
+    // of the dose accounting negligible.
+    void process(const void* buffer, size_t frameCount, size_t frameSize,
+                 const ::aidl::android::media::audio::common::AudioFormatDescription& format)
+            override;
+
   private:
-    std::shared_ptr<ISoundDose::IHalSoundDoseCallback> mCallback;
-    float mRs2Value;
+    // Only every 4th sample contributes to the energy estimate.
+    static constexpr size_t kEnergyDecimationFactor = 4;
+    // The SPL produced by a full-scale sine wave. The reference implementation has
+    // no calibration data, this nominal value corresponds to a typical headphone
+    // output at maximum volume.
+    static constexpr float kFullScaleDbSpl = 100.0f;
+    // Momentary exposure warnings are rate limited to one per this interval.
+    static constexpr int64_t kWarningIntervalNs = 1000000000;
+
+    std::mutex mMutex;
+    std::shared_ptr<ISoundDose::IHalSoundDoseCallback> mCallback;  // Guarded by 'mMutex'
+    std::atomic<float> mRs2Value;
+    std::atomic<int64_t> mLastWarningNs = 0;
 };
 
 }  // namespace aidl::android::hardware::audio::core::sounddose
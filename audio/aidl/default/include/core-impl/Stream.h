@@ -16,12 +16,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstdlib>
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <variant>
 
 #include <StreamWorker.h>
@@ -48,6 +51,86 @@
 
 namespace aidl::android::hardware::audio::core {
 
+// A lock-free, wait-free single-producer single-consumer ring used for delivering
+// control-plane commands to the stream worker without taking a mutex on the data
+// path. The producer side must be externally serialized (Binder calls into the
+// module / stream are), the consumer is the worker thread.
+template <typename T, size_t N>
+class SpscCommandRing {
+    static_assert((N & (N - 1)) == 0, "ring depth must be a power of two");
+
+  public:
+    // Called on the producer thread. Returns 'false' if the ring is full,
+    // in which case the command is dropped.
+    bool push(const T& value) {
+        const size_t head = mHead.load(std::memory_order_relaxed);
+        const size_t tail = mTail.load(std::memory_order_acquire);
+        if (head - tail == N) return false;
+        mItems[head & (N - 1)] = value;
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    // Called on the consumer thread. Returns 'false' if the ring is empty.
+    bool pop(T* value) {
+        const size_t tail = mTail.load(std::memory_order_relaxed);
+        const size_t head = mHead.load(std::memory_order_acquire);
+        if (head == tail) return false;
+        *value = mItems[tail & (N - 1)];
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+  private:
+    std::array<T, N> mItems{};
+    std::atomic<size_t> mHead = 0;
+    std::atomic<size_t> mTail = 0;
+};
+
+// An interface for consumers of a copy of the stream data, for example, for sound
+// dose computation. The processor is shared between streams and must be cheap
+// enough to call from the worker thread on every burst.
+struct StreamDataProcessorInterface {
+    virtual ~StreamDataProcessorInterface() = default;
+    // Called on the worker thread of an output stream with the data about to be rendered.
+    virtual void process(
+            const void* buffer, size_t frameCount, size_t frameSize,
+            const ::aidl::android::media::audio::common::AudioFormatDescription& format) = 0;
+};
+
+// Always-on histograms of the stream worker timings, bucketed by log2 of the
+// duration in microseconds. Written by the worker thread only, using relaxed
+// atomic increments, which makes the per-cycle cost a clock read plus an
+// increment. Read by Binder threads serving 'Module::dump'; since the reader
+// only produces diagnostic output, no synchronization beyond the atomicity of
+// individual counters is needed.
+class WorkerStats {
+  public:
+    enum Metric : size_t {
+        FMQ_WAIT = 0,  // Blocked on the command MQ waiting for the client.
+        TRANSFER,      // Inside 'DriverInterface::transfer' (e.g. an ALSA read / write).
+        CYCLE,         // Command processing, from reception until the reply is written.
+        METRIC_COUNT
+    };
+    // The top bucket accumulates all durations of ~0.5 s and above.
+    static constexpr size_t kBucketCount = 20;
+
+    void record(Metric metric, std::chrono::steady_clock::duration duration) {
+        const int64_t micros =
+                std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        size_t bucket = 0;
+        for (uint64_t v = micros > 0 ? static_cast<uint64_t>(micros) : 0;
+             v > 1 && bucket < kBucketCount - 1; v >>= 1) {
+            ++bucket;
+        }
+        mBuckets[metric][bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+    // Produces a per-metric listing of the non-empty buckets.
+    std::string toString() const;
+
+  private:
+    std::array<std::array<std::atomic<uint32_t>, kBucketCount>, METRIC_COUNT> mBuckets{};
+};
+
 // This class is similar to StreamDescriptor, but unlike
 // the descriptor, it actually owns the objects implementing
 // data exchange: FMQs etc, whereas StreamDescriptor only
@@ -115,6 +198,8 @@ class StreamContext {
           mAsyncCallback(std::move(other.mAsyncCallback)),
           mOutEventCallback(std::move(other.mOutEventCallback)),
           mDebugParameters(std::move(other.mDebugParameters)),
+          mBatchBursts(other.mBatchBursts),
+          mStreamDataProcessor(std::move(other.mStreamDataProcessor)),
           mFrameCount(other.mFrameCount) {}
     StreamContext& operator=(StreamContext&& other) {
         mCommandMQ = std::move(other.mCommandMQ);
@@ -130,6 +215,8 @@ class StreamContext {
         mAsyncCallback = std::move(other.mAsyncCallback);
         mOutEventCallback = std::move(other.mOutEventCallback);
         mDebugParameters = std::move(other.mDebugParameters);
+        mBatchBursts = other.mBatchBursts;
+        mStreamDataProcessor = std::move(other.mStreamDataProcessor);
         mFrameCount = other.mFrameCount;
         return *this;
     }
@@ -158,6 +245,39 @@ class StreamContext {
     ReplyMQ* getReplyMQ() const { return mReplyMQ.get(); }
     int getTransientStateDelayMs() const { return mDebugParameters.transientStateDelayMs; }
     int getSampleRate() const { return mSampleRate; }
+    // The number of data MQ bursts the worker may drain / fill during one wake up.
+    // Values above 1 trade latency for fewer scheduler wake ups, which is only
+    // acceptable for streams like deep buffer and compressed offload.
+    int getBatchBursts() const { return mBatchBursts; }
+    // Must only be called before the worker is started.
+    void setBatchBursts(int bursts) { mBatchBursts = std::max(bursts, 1); }
+    // Posts updated debug parameters for the worker thread; called on a Binder thread.
+    // The ring is a communication channel towards the worker and is not a part of
+    // the context state, thus posting is allowed on a const context.
+    bool postDebugParameters(const DebugParameters& params) const {
+        return mControlRing.push(params);
+    }
+    // Applies control commands pending in the ring. Called on the worker thread only,
+    // which is also the only user of the affected fields. Returns whether at least
+    // one update was applied.
+    bool pollControlCommands() {
+        bool updated = false;
+        for (DebugParameters params; mControlRing.pop(&params); updated = true) {
+            mDebugParameters = params;
+        }
+        return updated;
+    }
+    std::weak_ptr<StreamDataProcessorInterface> getStreamDataProcessor() const {
+        return mStreamDataProcessor;
+    }
+    // Must only be called before the worker is started.
+    void setStreamDataProcessor(std::weak_ptr<StreamDataProcessorInterface> processor) {
+        mStreamDataProcessor = processor;
+    }
+    // The stats are written by the worker thread and read by Binder threads
+    // serving 'Module::dump', thus, like the control ring, they are not a part
+    // of the context state and are accessible on a const context.
+    WorkerStats& getWorkerStats() const { return mWorkerStats; }
     bool isValid() const;
     // 'reset' is called on a Binder thread when closing the stream. Does not use
     // locking because it only cleans MQ pointers which were also set on the Binder thread.
@@ -180,6 +300,15 @@ class StreamContext {
     std::shared_ptr<IStreamCallback> mAsyncCallback;
     std::shared_ptr<IStreamOutEventCallback> mOutEventCallback;  // Only used by output streams
     DebugParameters mDebugParameters;
+    int mBatchBursts = 1;
+    std::weak_ptr<StreamDataProcessorInterface> mStreamDataProcessor;  // Only used by output
+                                                                       // streams
+    // Not moved together with the rest of the context: moves only happen before
+    // the worker is started, when the ring can not have pending commands yet.
+    mutable SpscCommandRing<DebugParameters, 8> mControlRing;
+    // Like the control ring, not moved: moves only happen before the worker is
+    // started, when no timings have been recorded yet.
+    mutable WorkerStats mWorkerStats;
     long mFrameCount = 0;
 };
 
@@ -232,6 +361,14 @@ class StreamWorkerCommonLogic : public ::android::hardware::audio::common::Strea
         mState = state;
         mTransientStateStart = std::chrono::steady_clock::now();
     }
+    // Called at the beginning of each worker cycle to pick up control-plane
+    // updates posted via the lock-free ring of the context.
+    void applyControlCommands() {
+        if (mContext->pollControlCommands()) {
+            mTransientStateDelayMs =
+                    std::chrono::milliseconds(mContext->getTransientStateDelayMs());
+        }
+    }
 
     // The context is only used for reading, except for updating the frame count,
     // which happens on the worker thread only.
@@ -245,7 +382,7 @@ class StreamWorkerCommonLogic : public ::android::hardware::audio::common::Strea
     static_assert(std::atomic<StreamDescriptor::State>::is_always_lock_free);
     std::atomic<StreamDescriptor::State> mState = StreamDescriptor::State::STANDBY;
     // All fields below are used on the worker thread only.
-    const std::chrono::duration<int, std::milli> mTransientStateDelayMs;
+    std::chrono::duration<int, std::milli> mTransientStateDelayMs;
     std::chrono::time_point<std::chrono::steady_clock> mTransientStateStart;
     // We use an array and the "size" field instead of a vector to be able to detect
     // memory allocation issues.
@@ -617,6 +754,17 @@ class StreamWrapper {
         if (s) return s->bluetoothParametersUpdated();
         return ndk::ScopedAStatus::ok();
     }
+    void postDebugParameters(const StreamContext::DebugParameters& params) {
+        if (auto s = mStream.lock(); s) {
+            s->getContext().postDebugParameters(params);
+        }
+    }
+    std::string dumpWorkerStats() const {
+        if (auto s = mStream.lock(); s) {
+            return s->getContext().getWorkerStats().toString();
+        }
+        return "";
+    }
 
   private:
     std::weak_ptr<StreamCommonInterface> mStream;
@@ -653,6 +801,27 @@ class Streams {
         return isOk ? ndk::ScopedAStatus::ok()
                     : ndk::ScopedAStatus::fromExceptionCode(EX_UNSUPPORTED_OPERATION);
     }
+    void postDebugParameters(const StreamContext::DebugParameters& params) {
+        // Each stream is in the map twice (by port id and by port config id),
+        // posting the same parameters twice is benign as the last update wins.
+        for (auto& it : mStreams) {
+            it.second.postDebugParameters(params);
+        }
+    }
+    std::string dumpWorkerStats() const {
+        std::string result;
+        // Each stream is in the map twice (by port id and by port config id),
+        // use the binder to report each stream only once.
+        std::set<AIBinder*> seen;
+        for (const auto& it : mStreams) {
+            if (!seen.insert(it.second.getBinder().get()).second) continue;
+            result.append("stream with id ")
+                    .append(std::to_string(it.first))
+                    .append(":\n")
+                    .append(it.second.dumpWorkerStats());
+        }
+        return result;
+    }
 
   private:
     // Maps port ids and port config ids to streams. Multimap because a port
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -56,6 +57,22 @@ class StreamAlsa : public StreamCommonImpl {
     const int mReadWriteRetries;
     // All fields below are only used on the worker thread.
     std::vector<alsa::DeviceProxy> mAlsaDeviceProxies;
+
+  private:
+    using MmapPcm = std::unique_ptr<struct pcm, int (*)(struct pcm*)>;
+
+    ::android::status_t mmapStart(const alsa::DeviceProfile& device);
+    ::android::status_t mmapTransfer(void* buffer, size_t frameCount, size_t* actualFrameCount,
+                                     int32_t* latencyMs);
+
+    // Whether the mmap data path should be tried on 'start'. Even when requested,
+    // the stream silently falls back to the proxy based path if the device can not
+    // be opened with 'PCM_MMAP', or if there are multiple devices.
+    const bool mMmapDataPath;
+    // All fields below are only used on the worker thread.
+    // Non-null when the mmap data path is engaged; in this case 'mAlsaDeviceProxies'
+    // remains empty because the device is owned by this handle.
+    MmapPcm mMmapPcm = MmapPcm(nullptr, pcm_close);
 };
 
 }  // namespace aidl::android::hardware::audio::core
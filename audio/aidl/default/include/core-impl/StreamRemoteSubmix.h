@@ -50,11 +50,15 @@ class StreamRemoteSubmix : public StreamCommonImpl {
     size_t getStreamPipeSizeInFrames();
     ::android::status_t outWrite(void* buffer, size_t frameCount, size_t* actualFrameCount);
     ::android::status_t inRead(void* buffer, size_t frameCount, size_t* actualFrameCount);
+    void convertFromPipe(const void* in, void* out, size_t frameCount) const;
 
     const ::aidl::android::media::audio::common::AudioDeviceAddress mDeviceAddress;
     const bool mIsInput;
     r_submix::AudioConfig mStreamConfig;
     std::shared_ptr<r_submix::SubmixRoute> mCurrentRoute = nullptr;
+    // Only used on the worker thread: scratch buffer for reading pipe frames
+    // when they need conversion into the stream configuration.
+    std::vector<int8_t> mConversionScratch;
 
     // Mutex lock to protect vector of submix routes, each of these submix routes have their mutex
     // locks and none of the mutex locks should be taken together.
@@ -62,7 +62,10 @@ class EffectContext {
         if (!mStatusMQ->isValid() || !mInputMQ->isValid() || !mOutputMQ->isValid()) {
             LOG(ERROR) << __func__ << " created invalid FMQ";
         }
-        mWorkBuffer.reserve(std::max(inBufferSizeInFloat, outBufferSizeInFloat));
+        mWorkBuffer.resize(std::max(inBufferSizeInFloat, outBufferSizeInFloat));
+        // The scratch arena is sized from the common config as well, so that the
+        // steady-state processing path never has to allocate from the heap.
+        mScratchArena.resize(kScratchArenaBursts * mWorkBuffer.size());
         mCommon = common;
     }
     virtual ~EffectContext() {}
@@ -73,6 +76,26 @@ class EffectContext {
 
     float* getWorkBuffer() { return static_cast<float*>(mWorkBuffer.data()); }
 
+    // Returns a scratch buffer of 'sizeInFloats' from the preallocated arena, or
+    // nullptr if the arena is exhausted. Effects must use this instead of heap
+    // allocations on the processing path. The returned buffers stay valid until
+    // the arena is reset at the beginning of the next processing cycle, thus this
+    // must only be used on the processing thread.
+    float* acquireScratchBuffer(size_t sizeInFloats) {
+        if (mScratchOffset + sizeInFloats > mScratchArena.size()) {
+            LOG(ERROR) << __func__ << ": arena exhausted, requested " << sizeInFloats
+                       << " floats, available " << mScratchArena.size() - mScratchOffset;
+            return nullptr;
+        }
+        float* const buffer = mScratchArena.data() + mScratchOffset;
+        mScratchOffset += sizeInFloats;
+        return buffer;
+    }
+
+    // Invalidates all buffers handed out by 'acquireScratchBuffer'. Called by
+    // EffectThread at the beginning of each processing cycle.
+    void resetScratchBuffers() { mScratchOffset = 0; }
+
     // reset buffer status by abandon input data in FMQ
     void resetBuffer() {
         auto buffer = static_cast<float*>(mWorkBuffer.data());
@@ -150,5 +173,10 @@ class EffectContext {
     // TODO handle effect process input and output
     // work buffer set by effect instances, the access and update are in same thread
     std::vector<float> mWorkBuffer;
+    // The number of processing bursts worth of scratch held by the arena.
+    static constexpr size_t kScratchArenaBursts = 4;
+    // Scratch arena for the processing path, only used on the processing thread.
+    std::vector<float> mScratchArena;
+    size_t mScratchOffset = 0;
 };
 }  // namespace aidl::android::hardware::audio::effect
@@ -16,7 +16,9 @@
 
 #include <cstdlib>
 #include <ctime>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -32,6 +34,15 @@
 using aidl::android::hardware::audio::core::Config;
 using aidl::android::hardware::audio::core::Module;
 
+namespace {
+
+// When set, the modules are constructed and registered concurrently. This helps
+// when probing of the hardware during construction (e.g. of USB ALSA cards)
+// takes a noticeable time.
+const char kParallelModuleInitProperty[] = "ro.boot.audio.hal.parallel_module_init";
+
+}  // namespace
+
 int main() {
     // Random values are used in the implementation.
     std::srand(std::time(nullptr));
@@ -64,9 +75,31 @@ int main() {
         CHECK_EQ(STATUS_OK, status);
         return std::make_pair(module, moduleBinder);
     };
-    auto modules = {createModule(Module::Type::DEFAULT), createModule(Module::Type::R_SUBMIX),
-                    createModule(Module::Type::USB), createModule(Module::Type::STUB),
-                    createModule(Module::Type::BLUETOOTH)};
+    const std::vector<Module::Type> moduleTypes = {Module::Type::DEFAULT, Module::Type::R_SUBMIX,
+                                                   Module::Type::USB, Module::Type::STUB,
+                                                   Module::Type::BLUETOOTH};
+    // Modules (and their binders) must stay alive while the service is running.
+    std::vector<std::pair<std::shared_ptr<Module>, ndk::SpAIBinder>> modules;
+    if (android::base::GetBoolProperty(kParallelModuleInitProperty, false)) {
+        // Each module is registered by its thread as soon as it is ready, so a module
+        // with a long bring-up does not delay the availability of the others.
+        std::mutex modulesLock;
+        std::vector<std::thread> threads;
+        for (const auto type : moduleTypes) {
+            threads.emplace_back([&, type]() {
+                auto moduleAndBinder = createModule(type);
+                std::lock_guard guard(modulesLock);
+                modules.push_back(std::move(moduleAndBinder));
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    } else {
+        for (const auto type : moduleTypes) {
+            modules.push_back(createModule(type));
+        }
+    }
     (void)modules;
 
     ABinderProcess_joinThreadPool();
@@ -16,11 +16,13 @@
 
 #define LOG_TAG "AHAL_StreamRemoteSubmix"
 #include <android-base/logging.h>
+#include <audio_utils/primitives.h>
 
 #include <cmath>
 
 #include "core-impl/StreamRemoteSubmix.h"
 
+using aidl::android::hardware::audio::common::getChannelCount;
 using aidl::android::hardware::audio::common::SinkMetadata;
 using aidl::android::hardware::audio::common::SourceMetadata;
 using aidl::android::hardware::audio::core::r_submix::SubmixRoute;
@@ -28,6 +30,7 @@ using aidl::android::media::audio::common::AudioDeviceAddress;
 using aidl::android::media::audio::common::AudioOffloadInfo;
 using aidl::android::media::audio::common::MicrophoneDynamicInfo;
 using aidl::android::media::audio::common::MicrophoneInfo;
+using aidl::android::media::audio::common::PcmType;
 
 namespace aidl::android::hardware::audio::core {
 
@@ -273,6 +276,72 @@ size_t StreamRemoteSubmix::getStreamPipeSizeInFrames() {
     return ::android::OK;
 }
 
+// Converts 'frameCount' frames read from the pipe into the stream configuration.
+// Only convertible configurations may differ, see 'SubmixRoute::isStreamConfigConvertible'.
+// The conversion kernels from 'audio_utils/primitives.h' are used because they have
+// vectorized (NEON / SSE) implementations processing several samples per instruction.
+void StreamRemoteSubmix::convertFromPipe(const void* in, void* out, size_t frameCount) const {
+    const auto& pipeConfig = mCurrentRoute->mPipeConfig;
+    const size_t inChannels = getChannelCount(pipeConfig.channelLayout);
+    const size_t outChannels = getChannelCount(mStreamConfig.channelLayout);
+    const bool inIsFloat = pipeConfig.format.pcm == PcmType::FLOAT_32_BIT;
+    const bool outIsFloat = mStreamConfig.format.pcm == PcmType::FLOAT_32_BIT;
+    if (inChannels == outChannels) {
+        const size_t sampleCount = frameCount * inChannels;
+        if (outIsFloat) {
+            memcpy_to_float_from_i16(static_cast<float*>(out), static_cast<const int16_t*>(in),
+                                     sampleCount);
+        } else {
+            memcpy_to_i16_from_float(static_cast<int16_t*>(out), static_cast<const float*>(in),
+                                     sampleCount);
+        }
+    } else if (inIsFloat == outIsFloat) {
+        if (outIsFloat) {
+            outChannels == 2 ? upmix_to_stereo_float_from_mono_float(static_cast<float*>(out),
+                                                                     static_cast<const float*>(in),
+                                                                     frameCount)
+                             : downmix_to_mono_float_from_stereo_float(
+                                       static_cast<float*>(out), static_cast<const float*>(in),
+                                       frameCount);
+        } else {
+            outChannels == 2 ? upmix_to_stereo_i16_from_mono_i16(static_cast<int16_t*>(out),
+                                                                 static_cast<const int16_t*>(in),
+                                                                 frameCount)
+                             : downmix_to_mono_i16_from_stereo_i16(static_cast<int16_t*>(out),
+                                                                   static_cast<const int16_t*>(in),
+                                                                   frameCount);
+        }
+    } else {
+        // Both the format and the channel layout differ: pass through an intermediate
+        // float buffer, processing in chunks to keep the intermediate data on the stack.
+        static constexpr size_t kChunkFrames = 256;
+        float tmp[kChunkFrames * 2];
+        const int8_t* src = static_cast<const int8_t*>(in);
+        int8_t* dst = static_cast<int8_t*>(out);
+        while (frameCount > 0) {
+            const size_t chunk = std::min(frameCount, kChunkFrames);
+            if (outIsFloat) {
+                memcpy_to_float_from_i16(tmp, reinterpret_cast<const int16_t*>(src),
+                                         chunk * inChannels);
+                outChannels == 2 ? upmix_to_stereo_float_from_mono_float(
+                                           reinterpret_cast<float*>(dst), tmp, chunk)
+                                 : downmix_to_mono_float_from_stereo_float(
+                                           reinterpret_cast<float*>(dst), tmp, chunk);
+            } else {
+                inChannels == 1 ? upmix_to_stereo_float_from_mono_float(
+                                          tmp, reinterpret_cast<const float*>(src), chunk)
+                                : downmix_to_mono_float_from_stereo_float(
+                                          tmp, reinterpret_cast<const float*>(src), chunk);
+                memcpy_to_i16_from_float(reinterpret_cast<int16_t*>(dst), tmp,
+                                         chunk * outChannels);
+            }
+            src += chunk * pipeConfig.frameSize;
+            dst += chunk * mStreamConfig.frameSize;
+            frameCount -= chunk;
+        }
+    }
+}
+
 ::android::status_t StreamRemoteSubmix::inRead(void* buffer, size_t frameCount,
                                                size_t* actualFrameCount) {
     // about to read from audio source
@@ -301,10 +370,26 @@ size_t StreamRemoteSubmix::getStreamPipeSizeInFrames() {
     size_t remainingFrames = frameCount;
     int availableToRead = source->availableToRead();
 
+    const auto& pipeConfig = mCurrentRoute->mPipeConfig;
+    const bool needsConversion = pipeConfig.format != mStreamConfig.format ||
+                                 pipeConfig.channelLayout != mStreamConfig.channelLayout;
+    if (needsConversion) {
+        // No-op in the steady state since the burst size does not change.
+        mConversionScratch.resize(frameCount * pipeConfig.frameSize);
+    }
+
     while ((remainingFrames > 0) && (availableToRead > 0) && (attempts < kMaxReadFailureAttempts)) {
         LOG(VERBOSE) << __func__ << ": frames available to read " << availableToRead;
 
-        ssize_t framesRead = source->read(buff, remainingFrames);
+        ssize_t framesRead;
+        if (needsConversion) {
+            framesRead = source->read(mConversionScratch.data(), remainingFrames);
+            if (framesRead > 0) {
+                convertFromPipe(mConversionScratch.data(), buff, framesRead);
+            }
+        } else {
+            framesRead = source->read(buff, remainingFrames);
+        }
 
         LOG(VERBOSE) << __func__ << ": frames read " << framesRead;
 
@@ -35,7 +35,7 @@ bool SubmixRoute::isStreamConfigValid(bool isInput, const AudioConfig& streamCon
         return false;
     }
     // If either stream is open, verify the existing pipe config matches the stream config.
-    if (hasAtleastOneStreamOpen() && !isStreamConfigCompatible(streamConfig)) {
+    if (hasAtleastOneStreamOpen() && !isStreamConfigCompatible(isInput, streamConfig)) {
         return false;
     }
     return true;
@@ -43,28 +43,46 @@ bool SubmixRoute::isStreamConfigValid(bool isInput, const AudioConfig& streamCon
 
 // Compare this stream config with existing pipe config, returning false if they do *not*
 // match, true otherwise.
-bool SubmixRoute::isStreamConfigCompatible(const AudioConfig& streamConfig) {
-    if (streamConfig.channelLayout != mPipeConfig.channelLayout) {
-        LOG(ERROR) << __func__ << ": channel count mismatch, stream channels = "
-                   << streamConfig.channelLayout.toString()
-                   << " pipe config channels = " << mPipeConfig.channelLayout.toString();
-        return false;
-    }
+bool SubmixRoute::isStreamConfigCompatible(bool isInput, const AudioConfig& streamConfig) {
     if (streamConfig.sampleRate != mPipeConfig.sampleRate) {
         LOG(ERROR) << __func__
                    << ": sample rate mismatch, stream sample rate = " << streamConfig.sampleRate
                    << " pipe config sample rate = " << mPipeConfig.sampleRate;
         return false;
     }
-    if (streamConfig.format != mPipeConfig.format) {
-        LOG(ERROR) << __func__
-                   << ": format mismatch, stream format = " << streamConfig.format.toString()
-                   << " pipe config format = " << mPipeConfig.format.toString();
+    if (streamConfig.channelLayout != mPipeConfig.channelLayout ||
+        streamConfig.format != mPipeConfig.format) {
+        // Input streams can convert between the pipe format / channel layout and
+        // their own on the read path, see 'StreamRemoteSubmix::inRead'.
+        if (isInput && isStreamConfigConvertible(mPipeConfig, streamConfig)) {
+            return true;
+        }
+        LOG(ERROR) << __func__ << ": config mismatch, stream format = "
+                   << streamConfig.format.toString()
+                   << ", channels = " << streamConfig.channelLayout.toString()
+                   << "; pipe config format = " << mPipeConfig.format.toString()
+                   << ", channels = " << mPipeConfig.channelLayout.toString();
         return false;
     }
     return true;
 }
 
+// Whether samples can be converted between the 'source' and 'sink' configs,
+// see 'StreamRemoteSubmix::inRead'. Sample rates must match, only conversion
+// between 16-bit integer and float PCM with mono or stereo layouts is supported.
+bool SubmixRoute::isStreamConfigConvertible(const AudioConfig& source, const AudioConfig& sink) {
+    auto isConvertiblePcmConfig = [](const AudioConfig& config) {
+        const auto& format = config.format;
+        if (format.type != AudioFormatType::PCM ||
+            (format.pcm != PcmType::INT_16_BIT && format.pcm != PcmType::FLOAT_32_BIT)) {
+            return false;
+        }
+        const auto channelCount = getChannelCount(config.channelLayout);
+        return channelCount == 1 || channelCount == 2;
+    };
+    return isConvertiblePcmConfig(source) && isConvertiblePcmConfig(sink);
+}
+
 bool SubmixRoute::hasAtleastOneStreamOpen() {
     std::lock_guard guard(mLock);
     return (mStreamInOpen || mStreamOutOpen);
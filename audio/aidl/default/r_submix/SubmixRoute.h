@@ -107,7 +107,8 @@ class SubmixRoute {
     long updateReadCounterFrames(size_t frameCount);
 
   private:
-    bool isStreamConfigCompatible(const AudioConfig& streamConfig);
+    bool isStreamConfigCompatible(bool isInput, const AudioConfig& streamConfig);
+    static bool isStreamConfigConvertible(const AudioConfig& source, const AudioConfig& sink);
 
     std::mutex mLock;
 
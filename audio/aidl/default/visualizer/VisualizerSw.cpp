@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+
 #define LOG_TAG "AHAL_VisualizerSw"
 
+#include <Utils.h>
 #include <android-base/logging.h>
 #include <system/audio_effects/effect_uuid.h>
 
@@ -176,7 +179,7 @@ ndk::ScopedAStatus VisualizerSw::getParameterVisualizer(const Visualizer::Tag& t
                                                                     "VisualizerTagNotSupported");
         }
     }
-    specific->set<Parameter::Specific::visualizer>(vsParam);
+    specific->set<Parameter::Specific::visualizer>(std::move(vsParam));
     return ndk::ScopedAStatus::ok();
 }
 
@@ -203,11 +206,9 @@ RetCode VisualizerSw::releaseContext() {
 
 // Processing method running in EffectWorker thread.
 IEffect::Status VisualizerSw::effectProcessImpl(float* in, float* out, int samples) {
-    // TODO: get data buffer and process.
-    LOG(DEBUG) << __func__ << " in " << in << " out " << out << " samples " << samples;
-    for (int i = 0; i < samples; i++) {
-        *out++ = *in++;
-    }
+    LOG(VERBOSE) << __func__ << " in " << in << " out " << out << " samples " << samples;
+    mContext->captureSamples(in, samples);
+    std::copy(in, in + samples, out);
     return {STATUS_OK, samples, samples};
 }
 
@@ -231,4 +232,34 @@ RetCode VisualizerSwContext::setVsLatency(int latency) {
     return RetCode::SUCCESS;
 }
 
+void VisualizerSwContext::captureSamples(const float* samples, int sampleCount) {
+    const size_t channelCount = ::aidl::android::hardware::audio::common::getChannelCount(
+            mCommon.input.base.channelMask);
+    if (channelCount == 0) return;
+    const size_t frameCount = sampleCount / channelCount;
+    for (size_t frame = 0; frame < frameCount; ++frame) {
+        float accumulator = 0.0f;
+        for (size_t channel = 0; channel < channelCount; ++channel) {
+            accumulator += samples[frame * channelCount + channel];
+        }
+        // 8-bit unsigned samples, silence is 0x80.
+        const int value = static_cast<int>(accumulator / channelCount * 128.0f) + 0x80;
+        mCaptureSampleBuffer[mCaptureWritePos] = std::clamp(value, 0, 255);
+        if (++mCaptureWritePos == mCaptureSampleBuffer.size()) mCaptureWritePos = 0;
+    }
+}
+
+std::vector<uint8_t> VisualizerSwContext::getVsCaptureSampleBuffer() const {
+    // Only the latest 'mCaptureSize' window is sent to the client. Clients poll
+    // frequently, and copying the entire ring on each poll is a waste.
+    std::vector<uint8_t> result(mCaptureSize);
+    const size_t bufferSize = mCaptureSampleBuffer.size();
+    const size_t start = (mCaptureWritePos + bufferSize - result.size()) % bufferSize;
+    const size_t tailCount = std::min(result.size(), bufferSize - start);
+    std::copy_n(mCaptureSampleBuffer.begin() + start, tailCount, result.begin());
+    std::copy_n(mCaptureSampleBuffer.begin(), result.size() - tailCount,
+                result.begin() + tailCount);
+    return result;
+}
+
 }  // namespace aidl::android::hardware::audio::effect
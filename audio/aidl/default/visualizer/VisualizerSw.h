@@ -49,7 +49,14 @@ class VisualizerSwContext final : public EffectContext {
     int getVsLatency() const { return mLatency; }
 
     Visualizer::Measurement getVsMeasurement() const { return mMeasurement; }
-    std::vector<uint8_t> getVsCaptureSampleBuffer() const { return mCaptureSampleBuffer; }
+    // Returns the latest 'mCaptureSize' window of the capture ring, not the whole ring.
+    std::vector<uint8_t> getVsCaptureSampleBuffer() const;
+
+    // Called from the effect worker thread, downmixes the samples to mono 8-bit
+    // and appends them to the capture ring. The ring is read without locking by
+    // the Binder thread serving 'getParameter'; an occasional torn window is
+    // acceptable for visualization purposes.
+    void captureSamples(const float* samples, int sampleCount);
 
   private:
     int mCaptureSize = kMaxCaptureSize;
@@ -57,7 +64,8 @@ class VisualizerSwContext final : public EffectContext {
     Visualizer::MeasurementMode mMeasurementMode = Visualizer::MeasurementMode::NONE;
     int mLatency = 0;
     const Visualizer::Measurement mMeasurement = {0, 0};
-    std::vector<uint8_t> mCaptureSampleBuffer;
+    std::vector<uint8_t> mCaptureSampleBuffer;  // Used as a ring buffer.
+    size_t mCaptureWritePos = 0;  // Only advanced by the effect worker thread.
 };
 
 class VisualizerSw final : public EffectImpl {
@@ -17,6 +17,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <algorithm>
+#include <mutex>
+#include <unordered_map>
 
 #define LOG_TAG "HidlUtils"
 #include <log/log.h>
@@ -43,6 +45,58 @@ using namespace ::android::audio::policy::configuration::CPP_VERSION;
         result = status;                                \
     }
 
+namespace {
+
+// The underlying translations scan string tables in libaudio_system and in the
+// XSD-generated code on every call, and the same few device and format values
+// cross the legacy boundary over and over. Memoize completed translations in
+// both directions; only successes are cached, so error logging is unchanged.
+template <typename HalType>
+class TranslationCache {
+  public:
+    bool getFromHal(HalType halValue, std::string* value) const {
+        std::lock_guard l(mMutex);
+        if (auto it = mFromHal.find(halValue); it != mFromHal.end()) {
+            *value = it->second;
+            return true;
+        }
+        return false;
+    }
+    void putFromHal(HalType halValue, const std::string& value) {
+        std::lock_guard l(mMutex);
+        mFromHal.emplace(halValue, value);
+    }
+    bool getToHal(const std::string& value, HalType* halValue) const {
+        std::lock_guard l(mMutex);
+        if (auto it = mToHal.find(value); it != mToHal.end()) {
+            *halValue = it->second;
+            return true;
+        }
+        return false;
+    }
+    void putToHal(const std::string& value, HalType halValue) {
+        std::lock_guard l(mMutex);
+        mToHal.emplace(value, halValue);
+    }
+
+  private:
+    mutable std::mutex mMutex;
+    std::unordered_map<HalType, std::string> mFromHal;
+    std::unordered_map<std::string, HalType> mToHal;
+};
+
+TranslationCache<audio_devices_t>& deviceTranslations() {
+    static TranslationCache<audio_devices_t> cache;
+    return cache;
+}
+
+TranslationCache<audio_format_t>& formatTranslations() {
+    static TranslationCache<audio_format_t> cache;
+    return cache;
+}
+
+}  // namespace
+
 status_t HidlUtils::audioIndexChannelMaskFromHal(audio_channel_mask_t halChannelMask,
                                                  AudioChannelMask* channelMask) {
     *channelMask = audio_channel_index_mask_to_string(halChannelMask);
@@ -224,8 +278,13 @@ status_t HidlUtils::audioContentTypeToHal(const AudioContentType& contentType,
 }
 
 status_t HidlUtils::audioDeviceTypeFromHal(audio_devices_t halDevice, AudioDevice* device) {
+    if (std::string cached; deviceTranslations().getFromHal(halDevice, &cached)) {
+        *device = cached;
+        return NO_ERROR;
+    }
     *device = audio_device_to_string(halDevice);
     if (!device->empty() && !xsd::isUnknownAudioDevice(*device)) {
+        deviceTranslations().putFromHal(halDevice, device->c_str());
         return NO_ERROR;
     }
     ALOGE("Unknown audio device value 0x%X", halDevice);
@@ -234,7 +293,11 @@ status_t HidlUtils::audioDeviceTypeFromHal(audio_devices_t halDevice, AudioDevic
 }
 
 status_t HidlUtils::audioDeviceTypeToHal(const AudioDevice& device, audio_devices_t* halDevice) {
+    if (deviceTranslations().getToHal(device.c_str(), halDevice)) {
+        return NO_ERROR;
+    }
     if (!xsd::isUnknownAudioDevice(device) && audio_device_from_string(device.c_str(), halDevice)) {
+        deviceTranslations().putToHal(device.c_str(), *halDevice);
         return NO_ERROR;
     }
     ALOGE("Unknown audio device \"%s\"", device.c_str());
@@ -243,8 +306,13 @@ status_t HidlUtils::audioDeviceTypeToHal(const AudioDevice& device, audio_device
 }
 
 status_t HidlUtils::audioFormatFromHal(audio_format_t halFormat, AudioFormat* format) {
+    if (std::string cached; formatTranslations().getFromHal(halFormat, &cached)) {
+        *format = cached;
+        return NO_ERROR;
+    }
     *format = audio_format_to_string(halFormat);
     if (!format->empty() && !xsd::isUnknownAudioFormat(*format)) {
+        formatTranslations().putFromHal(halFormat, format->c_str());
         return NO_ERROR;
     }
     ALOGE("Unknown audio format value 0x%X", halFormat);
@@ -270,7 +338,11 @@ status_t HidlUtils::audioFormatsFromHal(const std::vector<std::string>& halForma
 }
 
 status_t HidlUtils::audioFormatToHal(const AudioFormat& format, audio_format_t* halFormat) {
+    if (formatTranslations().getToHal(format.c_str(), halFormat)) {
+        return NO_ERROR;
+    }
     if (!xsd::isUnknownAudioFormat(format) && audio_format_from_string(format.c_str(), halFormat)) {
+        formatTranslations().putToHal(format.c_str(), *halFormat);
         return NO_ERROR;
     }
     ALOGE("Unknown audio format \"%s\"", format.c_str());
@@ -305,22 +305,31 @@ void CanBus::onRead(const struct canfd_frame& frame, std::chrono::nanoseconds ti
         return;
     }
 
-    CanMessage message = {};
-    message.id = frame.can_id & CAN_EFF_MASK;  // mask out eff/rtr/err flags
-    message.payload = hidl_vec<uint8_t>(frame.data, frame.data + frame.len);
-    message.timestamp = timestamp.count();
-    message.isExtendedId = (frame.can_id & CAN_EFF_FLAG) != 0;
-    message.remoteTransmissionRequest = (frame.can_id & CAN_RTR_FLAG) != 0;
-
-    if (UNLIKELY(kSuperVerbose)) {
-        LOG(VERBOSE) << "Got message " << toString(message);
-    }
+    const CanMessageId id = frame.can_id & CAN_EFF_MASK;  // mask out eff/rtr/err flags
+    const bool isExtendedId = (frame.can_id & CAN_EFF_FLAG) != 0;
+    const bool isRtr = (frame.can_id & CAN_RTR_FLAG) != 0;
 
     std::lock_guard<std::mutex> lck(mMsgListenersGuard);
+
+    // Evaluate filters on the raw frame fields first: on a busy bus most
+    // frames match no listener, and building the message up front would
+    // heap-allocate the payload copy just to throw it away.
+    CanMessage message = {};
+    bool messageBuilt = false;
     for (auto& listener : mMsgListeners) {
-        if (!match(listener.filter, message.id, message.remoteTransmissionRequest,
-                   message.isExtendedId))
-            continue;
+        if (!match(listener.filter, id, isRtr, isExtendedId)) continue;
+        if (!messageBuilt) {
+            message.id = id;
+            message.payload = hidl_vec<uint8_t>(frame.data, frame.data + frame.len);
+            message.timestamp = timestamp.count();
+            message.isExtendedId = isExtendedId;
+            message.remoteTransmissionRequest = isRtr;
+
+            if (UNLIKELY(kSuperVerbose)) {
+                LOG(VERBOSE) << "Got message " << toString(message);
+            }
+            messageBuilt = true;
+        }
         if (!listener.callback->onReceive(message).isOk() && !listener.failedOnce) {
             listener.failedOnce = true;
             LOG(WARNING) << "Failed to notify listener about message";
@@ -31,6 +31,7 @@
 #include <android/hardware_buffer.h>
 #include <ui/GraphicBuffer.h>
 
+#include <condition_variable>
 #include <functional>
 #include <thread>
 
@@ -85,6 +86,28 @@ class EvsMockCamera : public evs::BnEvsCamera {
 
     const evs::CameraDesc& getDesc() { return mDescription; }
 
+    // How rendered frames are treated when the client has exhausted its frame credits
+    // (i.e. it holds every allowed buffer and has not yet called doneWithFrame).
+    enum class DropPolicy {
+        // Never discard a rendered frame; frame generation pauses until a credit is
+        // returned. Suitable for recording clients that must see every frame.
+        LOSSLESS,
+        // Reclaim the oldest frame that has not been handed to the client yet so the
+        // newest frame can take its credit. Suitable for display clients where a stale
+        // frame is worth less than a fresh one.
+        LATEST_WINS,
+    };
+
+    // Extended info identifiers understood by this implementation.
+    // Writable, one byte: 0 selects DropPolicy::LOSSLESS (the default), 1 selects
+    // DropPolicy::LATEST_WINS.
+    static constexpr int32_t kExtendedInfoDropPolicy = 0x64726F70;  // 'drop'
+    // Read-only, 8 bytes little-endian: frames discarded by DropPolicy::LATEST_WINS.
+    static constexpr int32_t kExtendedInfoDroppedFrameCount = 0x64726366;  // 'drcf'
+    // Read-only, 8 bytes little-endian: frames never rendered because the client held
+    // every credit under DropPolicy::LOSSLESS.
+    static constexpr int32_t kExtendedInfoSkippedFrameCount = 0x736B6366;  // 'skcf'
+
     // Constructors
     EvsMockCamera(Sigil sigil, const char* deviceName,
                   std::unique_ptr<ConfigManager::CameraInfo>& camInfo);
@@ -96,6 +119,7 @@ class EvsMockCamera : public evs::BnEvsCamera {
     unsigned decreaseAvailableFrames_Locked(unsigned numToRemove);
 
     void generateFrames();
+    void deliverFrames();
     void fillMockFrame(buffer_handle_t handle, const AHardwareBuffer_Desc* pDesc);
     void returnBufferLocked(const uint32_t bufferId);
     ndk::ScopedAStatus stopVideoStream_impl();
@@ -130,6 +154,19 @@ class EvsMockCamera : public evs::BnEvsCamera {
     unsigned mFramesAllowed;             // How many buffers are we currently using
     unsigned mFramesInUse;               // How many buffers are currently outstanding
 
+    // Frames that have been rendered but not yet handed to the stream callback.
+    // Guarded by mAccessLock and drained in batches by the delivery thread so
+    // frames that are ready together share one deliverFrame() call.
+    std::vector<evs::BufferDesc> mPendingFrames;
+    std::condition_variable mFramesReadySignal;
+
+    // Governs what happens when the client holds every frame credit; see DropPolicy.
+    DropPolicy mDropPolicy = DropPolicy::LOSSLESS;
+    // Frames discarded from mPendingFrames by DropPolicy::LATEST_WINS.
+    uint64_t mDroppedFrames = 0;
+    // Frames never rendered because no credit was available under DropPolicy::LOSSLESS.
+    uint64_t mSkippedFrames = 0;
+
     enum StreamStateValues {
         STOPPED,
         RUNNING,
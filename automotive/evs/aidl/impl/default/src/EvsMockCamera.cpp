@@ -50,6 +50,14 @@ constexpr uint32_t kColors[] = {
 };
 constexpr size_t kNumColors = sizeof(kColors) / sizeof(kColors[0]);
 
+std::vector<uint8_t> toLittleEndianBytes(uint64_t value) {
+    std::vector<uint8_t> bytes(sizeof(value));
+    for (size_t i = 0; i < sizeof(value); i++) {
+        bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+    return bytes;
+}
+
 }  // namespace
 
 namespace aidl::android::hardware::automotive::evs::implementation {
@@ -239,6 +247,26 @@ ScopedAStatus EvsMockCamera::stopVideoStream_impl() {
 
 ScopedAStatus EvsMockCamera::getExtendedInfo(int32_t opaqueIdentifier,
                                              std::vector<uint8_t>* opaqueValue) {
+    switch (opaqueIdentifier) {
+        case kExtendedInfoDropPolicy: {
+            std::lock_guard lock(mAccessLock);
+            *opaqueValue = {static_cast<uint8_t>(mDropPolicy)};
+            return ScopedAStatus::ok();
+        }
+        case kExtendedInfoDroppedFrameCount: {
+            std::lock_guard lock(mAccessLock);
+            *opaqueValue = toLittleEndianBytes(mDroppedFrames);
+            return ScopedAStatus::ok();
+        }
+        case kExtendedInfoSkippedFrameCount: {
+            std::lock_guard lock(mAccessLock);
+            *opaqueValue = toLittleEndianBytes(mSkippedFrames);
+            return ScopedAStatus::ok();
+        }
+        default:
+            break;
+    }
+
     const auto it = mExtInfo.find(opaqueIdentifier);
     if (it == mExtInfo.end()) {
         return ScopedAStatus::fromServiceSpecificError(static_cast<int>(EvsResult::INVALID_ARG));
@@ -251,6 +279,19 @@ ScopedAStatus EvsMockCamera::getExtendedInfo(int32_t opaqueIdentifier,
 
 ScopedAStatus EvsMockCamera::setExtendedInfo(int32_t opaqueIdentifier,
                                              const std::vector<uint8_t>& opaqueValue) {
+    if (opaqueIdentifier == kExtendedInfoDropPolicy) {
+        if (opaqueValue.size() != 1 ||
+            opaqueValue[0] > static_cast<uint8_t>(DropPolicy::LATEST_WINS)) {
+            LOG(ERROR) << "Invalid drop policy value.";
+            return ScopedAStatus::fromServiceSpecificError(
+                    static_cast<int>(EvsResult::INVALID_ARG));
+        }
+
+        std::lock_guard lock(mAccessLock);
+        mDropPolicy = static_cast<DropPolicy>(opaqueValue[0]);
+        return ScopedAStatus::ok();
+    }
+
     mExtInfo.insert_or_assign(opaqueIdentifier, opaqueValue);
     return ScopedAStatus::ok();
 }
@@ -527,6 +568,10 @@ unsigned EvsMockCamera::decreaseAvailableFrames_Locked(unsigned numToRemove) {
 void EvsMockCamera::generateFrames() {
     LOG(DEBUG) << "Frame generation loop started.";
 
+    // Transport runs on its own thread so rendering the next frame never waits on the
+    // client, and frames that are ready together share a single deliverFrame() call.
+    std::thread deliveryThread([this]() { deliverFrames(); });
+
     unsigned idx = 0;
     while (true) {
         bool timeForFrame = false;
@@ -542,8 +587,22 @@ void EvsMockCamera::generateFrames() {
             }
 
             // Are we allowed to issue another buffer?
+            if (mFramesInUse >= mFramesAllowed &&
+                mDropPolicy == DropPolicy::LATEST_WINS && !mPendingFrames.empty()) {
+                // The client has exhausted its credits but the oldest rendered frame has
+                // not been handed over yet; reclaim it so the fresher frame below can take
+                // its credit. Frames already delivered stay with the client until it calls
+                // doneWithFrame.
+                const auto& oldest = mPendingFrames.front();
+                mBuffers[oldest.bufferId].inUse = false;
+                mFramesInUse--;
+                mPendingFrames.erase(mPendingFrames.begin());
+                mDroppedFrames++;
+            }
+
             if (mFramesInUse >= mFramesAllowed) {
                 // Can't do anything right now -- skip this frame
+                mSkippedFrames++;
                 LOG(WARNING) << "Skipped a frame because too many are in flight.";
             } else {
                 // Identify an available buffer to fill
@@ -596,28 +655,12 @@ void EvsMockCamera::generateFrames() {
             fillMockFrame(memHandle, reinterpret_cast<const AHardwareBuffer_Desc*>(
                                              &newBuffer.buffer.description));
 
-            // Issue the (asynchronous) callback to the client -- can't be holding the lock
-            auto flag = false;
-            if (mStream) {
-                std::vector<BufferDesc> frames;
-                frames.push_back(std::move(newBuffer));
-                flag = mStream->deliverFrame(frames).isOk();
-            }
-
-            if (flag) {
-                LOG(DEBUG) << "Delivered " << memHandle << ", id = " << mBuffers[idx].handle;
-            } else {
-                // This can happen if the client dies and is likely unrecoverable.
-                // To avoid consuming resources generating failing calls, we stop sending
-                // frames.  Note, however, that the stream remains in the "STREAMING" state
-                // until cleaned up on the main thread.
-                LOG(ERROR) << "Frame delivery call failed in the transport layer.";
-
-                // Since we didn't actually deliver it, mark the frame as available
-                std::lock_guard<std::mutex> lock(mAccessLock);
-                mBuffers[idx].inUse = false;
-                mFramesInUse--;
+            // Queue the frame for the delivery thread
+            {
+                std::lock_guard lock(mAccessLock);
+                mPendingFrames.push_back(std::move(newBuffer));
             }
+            mFramesReadySignal.notify_all();
         }
 
         // We arbitrarily choose to generate frames at 15 fps to ensure we pass the 10fps test
@@ -632,6 +675,11 @@ void EvsMockCamera::generateFrames() {
         }
     }
 
+    // Wake the delivery thread so it drains anything still pending and exits; waiting
+    // for it keeps the end of stream event below ordered after the last frame
+    mFramesReadySignal.notify_all();
+    deliveryThread.join();
+
     // If we've been asked to stop, send an event to signal the actual end of stream
     EvsEventDesc event = {
             .aType = EvsEventType::STREAM_STOPPED,
@@ -643,6 +691,51 @@ void EvsMockCamera::generateFrames() {
     return;
 }
 
+// This is the frame delivery thread that runs alongside generateFrames().  It hands every
+// frame queued since its last pass to the client in one deliverFrame() call, so a client
+// that falls behind costs us batching rather than a binder round trip per frame.
+void EvsMockCamera::deliverFrames() {
+    while (true) {
+        std::vector<BufferDesc> frames;
+
+        // Lock scope for draining the pending frame queue
+        {
+            std::unique_lock lock(mAccessLock);
+            mFramesReadySignal.wait(lock, [this]() {
+                return !mPendingFrames.empty() || mStreamState != RUNNING;
+            });
+            if (mPendingFrames.empty()) {
+                // The stream is winding down and every pending frame has been delivered
+                break;
+            }
+            frames.swap(mPendingFrames);
+        }
+
+        // Issue the (asynchronous) callback to the client -- can't be holding the lock
+        auto flag = false;
+        if (mStream) {
+            flag = mStream->deliverFrame(frames).isOk();
+        }
+
+        if (flag) {
+            LOG(DEBUG) << "Delivered " << frames.size() << " frame(s) in one batch.";
+        } else {
+            // This can happen if the client dies and is likely unrecoverable.
+            // To avoid consuming resources generating failing calls, we stop sending
+            // frames.  Note, however, that the stream remains in the "STREAMING" state
+            // until cleaned up on the main thread.
+            LOG(ERROR) << "Frame delivery call failed in the transport layer.";
+
+            // Since we didn't actually deliver them, mark the frames as available
+            std::lock_guard lock(mAccessLock);
+            for (const auto& desc : frames) {
+                mBuffers[desc.bufferId].inUse = false;
+                mFramesInUse--;
+            }
+        }
+    }
+}
+
 void EvsMockCamera::fillMockFrame(buffer_handle_t handle, const AHardwareBuffer_Desc* pDesc) {
     // Lock our output buffer for writing
     uint32_t* pixels = nullptr;
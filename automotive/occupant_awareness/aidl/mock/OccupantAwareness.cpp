@@ -14,7 +14,7 @@
  * limitations under the License.
  */
 
-#include <utils/SystemClock.h>
+#include <chrono>
 
 #include "OccupantAwareness.h"
 
@@ -31,8 +31,6 @@ static const int32_t kAllCapabilities = OccupantAwareness::CAP_PRESENCE_DETECTIO
                                         OccupantAwareness::CAP_GAZE_DETECTION |
                                         OccupantAwareness::CAP_DRIVER_MONITORING_DETECTION;
 
-constexpr int64_t kNanoSecondsPerMilliSecond = 1000 * 1000;
-
 ScopedAStatus OccupantAwareness::startDetection(OccupantAwarenessStatus* status) {
     std::lock_guard<std::mutex> lock(mMutex);
     if (mStatus != OccupantAwarenessStatus::NOT_INITIALIZED) {
@@ -152,19 +150,20 @@ void OccupantAwareness::startWorkerThread(OccupantAwareness* occupantAwareness)
 }
 
 void OccupantAwareness::workerThreadFunction() {
-    bool isFirstDetection = true;
-    int64_t prevDetectionTimeMs;
     while (mStatus == OccupantAwarenessStatus::READY) {
-        int64_t currentTimeMs = android::elapsedRealtimeNano() / kNanoSecondsPerMilliSecond;
-        if ((isFirstDetection) || (currentTimeMs - prevDetectionTimeMs > mDetectionDurationMs)) {
+        OccupantDetections detections = mGenerator.GetNextDetections();
+        std::shared_ptr<IOccupantAwarenessClientCallback> callback;
+        {
             std::lock_guard<std::mutex> lock(mMutex);
-            mLatestDetections = mGenerator.GetNextDetections();
-            if (mCallback != nullptr) {
-                mCallback->onDetectionEvent(mLatestDetections);
-            }
-            isFirstDetection = false;
-            prevDetectionTimeMs = currentTimeMs;
+            mLatestDetections = detections;
+            callback = mCallback;
+        }
+        // Deliver outside the lock so getLatestDetection() never waits behind an
+        // outbound binder transaction.
+        if (callback != nullptr) {
+            callback->onDetectionEvent(detections);
         }
+        std::this_thread::sleep_for(std::chrono::milliseconds(mDetectionDurationMs));
     }
 }
 
@@ -99,7 +99,13 @@ class RemoteAccessService
     std::mutex mStartStopTaskLoopLock;
     bool mTaskLoopRunning GUARDED_BY(mStartStopTaskLoopLock) = false;
     bool mGrpcConnected GUARDED_BY(mLock) = false;
-    std::unordered_map<std::string, size_t> mClientIdToTaskCount GUARDED_BY(mLock);
+    // Per-client task delivery accounting, shown in the --status dump.
+    struct TaskStats {
+        size_t count = 0;
+        int64_t totalDeliveryMicros = 0;
+        int64_t maxDeliveryMicros = 0;
+    };
+    std::unordered_map<std::string, TaskStats> mClientIdToTaskStats GUARDED_BY(mLock);
 
     // Default wait time before retry connecting to remote access client is 10s.
     size_t mRetryWaitInMs = 10'000;
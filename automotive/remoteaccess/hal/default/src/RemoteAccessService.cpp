@@ -22,9 +22,11 @@
 #include <android-base/stringprintf.h>
 #include <android/binder_status.h>
 #include <grpc++/grpc++.h>
+#include <inttypes.h>
 #include <private/android_filesystem_config.h>
 #include <sys/stat.h>
 #include <utils/Log.h>
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <iostream>
@@ -186,14 +188,24 @@ Result<void> RemoteAccessService::deliverRemoteTaskThroughCallback(const std::st
     {
         std::lock_guard<std::mutex> lockGuard(mLock);
         callback = mRemoteTaskCallback;
-        mClientIdToTaskCount[clientId] += 1;
     }
     if (callback == nullptr) {
         return Error() << "No callback registered, task ignored";
     }
     ALOGD("Calling onRemoteTaskRequested callback for client ID: %s", clientId.c_str());
+    auto deliveryStart = std::chrono::steady_clock::now();
     ScopedAStatus callbackStatus =
             callback->onRemoteTaskRequested(clientId, stringToBytes(taskData));
+    int64_t deliveryMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::steady_clock::now() - deliveryStart)
+                                     .count();
+    {
+        std::lock_guard<std::mutex> lockGuard(mLock);
+        TaskStats& stats = mClientIdToTaskStats[clientId];
+        stats.count += 1;
+        stats.totalDeliveryMicros += deliveryMicros;
+        stats.maxDeliveryMicros = std::max(stats.maxDeliveryMicros, deliveryMicros);
+    }
     if (!callbackStatus.isOk()) {
         return Error() << "Failed to call onRemoteTaskRequested callback, status: "
                        << callbackStatus.getStatus()
@@ -476,9 +488,12 @@ void RemoteAccessService::debugInjectTaskNextReboot(int fd, std::string_view cli
 
 std::string RemoteAccessService::clientIdToTaskCountToStringLocked() {
     // Print the table header
-    std::string output = "| ClientId | Count |\n";
-    for (const auto& [clientId, taskCount] : mClientIdToTaskCount) {
-        output += StringPrintf("  %-9s  %-6zu\n", clientId.c_str(), taskCount);
+    std::string output = "| ClientId | Count | AvgDeliveryUs | MaxDeliveryUs |\n";
+    for (const auto& [clientId, stats] : mClientIdToTaskStats) {
+        int64_t avgDeliveryMicros =
+                stats.count == 0 ? 0 : stats.totalDeliveryMicros / static_cast<int64_t>(stats.count);
+        output += StringPrintf("  %-9s  %-6zu  %-14" PRId64 "  %-14" PRId64 "\n", clientId.c_str(),
+                               stats.count, avgDeliveryMicros, stats.maxDeliveryMicros);
     }
     return output;
 }
@@ -33,14 +33,16 @@ SurroundView2dSession::SurroundView2dSession() :
     mConfig.width = 640;
     mConfig.blending = SvQuality::HIGH;
 
-    framesRecord.frames.svBuffers.resize(1);
-    framesRecord.frames.svBuffers[0].viewId = 0;
-    framesRecord.frames.svBuffers[0].hardwareBuffer.nativeHandle =
-        new native_handle_t();
-    framesRecord.frames.svBuffers[0].hardwareBuffer.description[0] =
-        mConfig.width;
-    framesRecord.frames.svBuffers[0].hardwareBuffer.description[1] =
-        mConfig.width * 3 / 4;
+    for (auto& framesRecord : framesRecords) {
+        framesRecord.frames.svBuffers.resize(1);
+        framesRecord.frames.svBuffers[0].viewId = 0;
+        framesRecord.frames.svBuffers[0].hardwareBuffer.nativeHandle =
+            new native_handle_t();
+        framesRecord.frames.svBuffers[0].hardwareBuffer.description[0] =
+            mConfig.width;
+        framesRecord.frames.svBuffers[0].hardwareBuffer.description[1] =
+            mConfig.width * 3 / 4;
+    }
 }
 
 // Methods from ::android::hardware::automotive::sv::V1_0::ISurroundViewSession
@@ -96,9 +98,13 @@ Return<void> SurroundView2dSession::doneWithFrames(
     ALOGD("SurroundView2dSession::doneWithFrames");
     std::unique_lock <std::mutex> lock(mAccessLock);
 
-    framesRecord.inUse = false;
+    for (auto& framesRecord : framesRecords) {
+        if (framesRecord.inUse &&
+            framesRecord.frames.sequenceId == svFramesDesc.sequenceId) {
+            framesRecord.inUse = false;
+        }
+    }
 
-    (void)svFramesDesc;
     return android::hardware::Void();
 }
 
@@ -193,6 +199,7 @@ void SurroundView2dSession::generateFrames() {
     int sequenceId = 0;
 
     while(true) {
+        FramesRecord* framesRecord = nullptr;
         {
             std::lock_guard<std::mutex> lock(mAccessLock);
 
@@ -201,26 +208,28 @@ void SurroundView2dSession::generateFrames() {
                 break;
             }
 
-            framesRecord.frames.svBuffers[0].hardwareBuffer.description[0] =
+            framesRecord = &framesRecords[framesRecordIndex];
+            framesRecord->frames.svBuffers[0].hardwareBuffer.description[0] =
                 mConfig.width;
-            framesRecord.frames.svBuffers[0].hardwareBuffer.description[1] =
+            framesRecord->frames.svBuffers[0].hardwareBuffer.description[1] =
                 mConfig.width * 3 / 4;
         }
 
         usleep(100 * 1000);
 
-        framesRecord.frames.timestampNs = elapsedRealtimeNano();
-        framesRecord.frames.sequenceId = sequenceId++;
+        framesRecord->frames.timestampNs = elapsedRealtimeNano();
+        framesRecord->frames.sequenceId = sequenceId++;
 
         {
             std::lock_guard<std::mutex> lock(mAccessLock);
 
-            if (framesRecord.inUse) {
+            if (framesRecord->inUse) {
                 ALOGD("Notify SvEvent::FRAME_DROPPED");
                 mStream->notify(SvEvent::FRAME_DROPPED);
             } else {
-                framesRecord.inUse = true;
-                mStream->receiveFrames(framesRecord.frames);
+                framesRecord->inUse = true;
+                framesRecordIndex = (framesRecordIndex + 1) % kNumFrameRecords;
+                mStream->receiveFrames(framesRecord->frames);
             }
         }
     }
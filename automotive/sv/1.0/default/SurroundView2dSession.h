@@ -81,7 +81,12 @@ private:
         bool inUse = false;
     };
 
-    FramesRecord framesRecord;
+    // Output is double buffered so the next frame can be composed while the
+    // client still holds the previous one; frames are only dropped when the
+    // client falls more than one frame behind.
+    static constexpr int kNumFrameRecords = 2;
+    FramesRecord framesRecords[kNumFrameRecords];
+    int framesRecordIndex = 0;
 
     // Synchronization necessary to deconflict mCaptureThread from the main service thread
     std::mutex mAccessLock;
@@ -43,11 +43,13 @@ SurroundView3dSession::SurroundView3dSession() :
     mConfig.height = 480;
     mConfig.carDetails = SvQuality::HIGH;
 
-    framesRecord.frames.svBuffers.resize(1);
-    framesRecord.frames.svBuffers[0].viewId = 0;
-    framesRecord.frames.svBuffers[0].hardwareBuffer.nativeHandle = new native_handle_t();
-    framesRecord.frames.svBuffers[0].hardwareBuffer.description[0] = mConfig.width;
-    framesRecord.frames.svBuffers[0].hardwareBuffer.description[1] = mConfig.height;
+    for (auto& framesRecord : framesRecords) {
+        framesRecord.frames.svBuffers.resize(1);
+        framesRecord.frames.svBuffers[0].viewId = 0;
+        framesRecord.frames.svBuffers[0].hardwareBuffer.nativeHandle = new native_handle_t();
+        framesRecord.frames.svBuffers[0].hardwareBuffer.description[0] = mConfig.width;
+        framesRecord.frames.svBuffers[0].hardwareBuffer.description[1] = mConfig.height;
+    }
 }
 
 // Methods from ::android::hardware::automotive::sv::V1_0::ISurroundViewSession.
@@ -107,9 +109,13 @@ Return<void> SurroundView3dSession::doneWithFrames(
     ALOGD("SurroundView3dSession::doneWithFrames");
     std::unique_lock <std::mutex> lock(mAccessLock);
 
-    framesRecord.inUse = false;
+    for (auto& framesRecord : framesRecords) {
+        if (framesRecord.inUse &&
+            framesRecord.frames.sequenceId == svFramesDesc.sequenceId) {
+            framesRecord.inUse = false;
+        }
+    }
 
-    (void)svFramesDesc;
     return android::hardware::Void();
 }
 
@@ -261,6 +267,7 @@ void SurroundView3dSession::generateFrames() {
     int sequenceId = 0;
 
     while(true) {
+        FramesRecord* framesRecord = nullptr;
         {
             std::lock_guard<std::mutex> lock(mAccessLock);
 
@@ -268,30 +275,33 @@ void SurroundView3dSession::generateFrames() {
                 // Break out of our main thread loop
                 break;
             }
+
+            framesRecord = &framesRecords[framesRecordIndex];
         }
 
         usleep(100 * 1000);
 
-        framesRecord.frames.timestampNs = elapsedRealtimeNano();
-        framesRecord.frames.sequenceId = sequenceId++;
+        framesRecord->frames.timestampNs = elapsedRealtimeNano();
+        framesRecord->frames.sequenceId = sequenceId++;
 
-        framesRecord.frames.svBuffers.resize(mViews.size());
+        framesRecord->frames.svBuffers.resize(mViews.size());
         for (int i=0; i<mViews.size(); i++) {
-            framesRecord.frames.svBuffers[i].viewId = mViews[i].viewId;
-            framesRecord.frames.svBuffers[i].hardwareBuffer.nativeHandle = new native_handle_t();
-            framesRecord.frames.svBuffers[i].hardwareBuffer.description[0] = mConfig.width; // width
-            framesRecord.frames.svBuffers[i].hardwareBuffer.description[1] = mConfig.height; // height
+            framesRecord->frames.svBuffers[i].viewId = mViews[i].viewId;
+            framesRecord->frames.svBuffers[i].hardwareBuffer.nativeHandle = new native_handle_t();
+            framesRecord->frames.svBuffers[i].hardwareBuffer.description[0] = mConfig.width; // width
+            framesRecord->frames.svBuffers[i].hardwareBuffer.description[1] = mConfig.height; // height
         }
 
         {
             std::lock_guard<std::mutex> lock(mAccessLock);
 
-            if (framesRecord.inUse) {
+            if (framesRecord->inUse) {
                 ALOGD("Notify SvEvent::FRAME_DROPPED");
                 mStream->notify(SvEvent::FRAME_DROPPED);
             } else {
-                framesRecord.inUse = true;
-                mStream->receiveFrames(framesRecord.frames);
+                framesRecord->inUse = true;
+                framesRecordIndex = (framesRecordIndex + 1) % kNumFrameRecords;
+                mStream->receiveFrames(framesRecord->frames);
             }
         }
     }
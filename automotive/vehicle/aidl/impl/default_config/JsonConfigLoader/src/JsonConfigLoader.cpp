@@ -25,6 +25,12 @@
 #endif  // ENABLE_VEHICLE_HAL_TEST_PROPERTIES
 
 #include <android-base/strings.h>
+#include <android-base/unique_fd.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #include <fstream>
 
 namespace android {
@@ -314,7 +320,11 @@ Result<T> JsonValueParser::parseValue(const std::string& fieldName,
     if (!value.isString()) {
         return convertValueToType<T>(fieldName, value);
     }
-    auto maybeTypeAndValue = maybeGetTypeAndValueName(value.asString());
+    std::string stringValue = value.asString();
+    if (auto it = mParsedConstantsCache.find(stringValue); it != mParsedConstantsCache.end()) {
+        return static_cast<T>(it->second);
+    }
+    auto maybeTypeAndValue = maybeGetTypeAndValueName(stringValue);
     if (!maybeTypeAndValue.has_value()) {
         return Error() << "Invalid constant value: " << value << " for field: " << fieldName;
     }
@@ -323,6 +333,7 @@ Result<T> JsonValueParser::parseValue(const std::string& fieldName,
         return constantParseResult.error();
     }
     int constantValue = constantParseResult.value();
+    mParsedConstantsCache[std::move(stringValue)] = constantValue;
     return static_cast<T>(constantValue);
 }
 
@@ -580,18 +591,38 @@ Result<std::unordered_map<int32_t, ConfigDeclaration>> JsonConfigParser::parseJs
         std::istream& is) {
     Json::CharReaderBuilder builder;
     Json::Value root;
-    std::unordered_map<int32_t, ConfigDeclaration> configsByPropId;
     std::string errs;
     if (!Json::parseFromStream(builder, is, &root, &errs)) {
         return Error() << "Failed to parse property config file as JSON, error: " << errs;
     }
+    return parseRootNode(root);
+}
+
+Result<std::unordered_map<int32_t, ConfigDeclaration>> JsonConfigParser::parseJsonConfig(
+        const char* data, size_t length) {
+    Json::CharReaderBuilder builder;
+    // Comments are not collected into the DOM, saving allocations for commented configs.
+    builder["collectComments"] = false;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    Json::Value root;
+    std::string errs;
+    if (!reader->parse(data, data + length, &root, &errs)) {
+        return Error() << "Failed to parse property config file as JSON, error: " << errs;
+    }
+    return parseRootNode(root);
+}
+
+Result<std::unordered_map<int32_t, ConfigDeclaration>> JsonConfigParser::parseRootNode(
+        const Json::Value& root) {
+    std::unordered_map<int32_t, ConfigDeclaration> configsByPropId;
     if (!root.isObject()) {
         return Error() << "root element must be an object";
     }
     if (!root.isMember("properties") || !root["properties"].isArray()) {
         return Error() << "Missing 'properties' field in root or the field is not an array";
     }
-    Json::Value properties = root["properties"];
+    // Use a reference, copying the node would deep-copy the whole subtree.
+    const Json::Value& properties = root["properties"];
     std::vector<std::string> errors;
     for (unsigned int i = 0; i < properties.size(); i++) {
         if (auto maybeConfig = parseEachProperty(properties[i], &errors); maybeConfig.has_value()) {
@@ -617,6 +648,22 @@ JsonConfigLoader::loadPropConfig(std::istream& is) {
 
 android::base::Result<std::unordered_map<int32_t, ConfigDeclaration>>
 JsonConfigLoader::loadPropConfig(const std::string& configPath) {
+    android::base::unique_fd fd(open(configPath.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd.get() == -1) {
+        return android::base::Error() << "couldn't open " << configPath << " for parsing.";
+    }
+    struct stat statBuf = {};
+    if (fstat(fd.get(), &statBuf) == 0 && statBuf.st_size > 0) {
+        size_t length = static_cast<size_t>(statBuf.st_size);
+        void* addr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd.get(), 0);
+        if (addr != MAP_FAILED) {
+            auto result = mParser->parseJsonConfig(static_cast<const char*>(addr), length);
+            munmap(addr, length);
+            return result;
+        }
+    }
+
+    // Fall back to stream parsing, e.g. for files mmap does not support.
     std::ifstream ifs(configPath.c_str());
     if (!ifs) {
         return android::base::Error() << "couldn't open " << configPath << " for parsing.";
@@ -18,6 +18,7 @@
 
 #include <PropertyUtils.h>
 
+#include <android-base/file.h>
 #include <gtest/gtest.h>
 #include <sstream>
 
@@ -56,6 +57,31 @@ TEST_F(JsonConfigLoaderUnitTest, testBasic) {
     ASSERT_EQ(configs.begin()->second.config.prop, 291504388);
 }
 
+TEST_F(JsonConfigLoaderUnitTest, testLoadFromFile) {
+    std::string config = R"(
+    {
+        "properties": [{
+            "property": 291504388
+        }]
+    }
+    )";
+    android::base::TemporaryFile configFile;
+    ASSERT_TRUE(android::base::WriteStringToFile(config, configFile.path));
+
+    auto result = mLoader.loadPropConfig(std::string(configFile.path));
+
+    ASSERT_TRUE(result.ok()) << result.error().message();
+
+    auto configs = result.value();
+    ASSERT_EQ(configs.size(), 1u);
+    ASSERT_EQ(configs.begin()->second.config.prop, 291504388);
+}
+
+TEST_F(JsonConfigLoaderUnitTest, testLoadFromFileNotExist) {
+    ASSERT_FALSE(mLoader.loadPropConfig(std::string("/not/exist/config.json")).ok())
+            << "Non-existing config file must cause error";
+}
+
 TEST_F(JsonConfigLoaderUnitTest, testRootNotObject) {
     std::istringstream iss(R"(
     []
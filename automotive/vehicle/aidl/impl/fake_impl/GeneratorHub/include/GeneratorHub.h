@@ -40,13 +40,15 @@ namespace fake {
 // This is the scheduler for all VHAL event generators. It manages all generators and uses priority
 // queue to maintain generated events ordered by timestamp. The scheduler uses a single thread to
 // keep querying and updating the event queue to make sure events from all generators are produced
-// in order.
+// in order. Events that are due at the same wakeup are delivered to the callback as one batch so
+// that concurrent generators ticking together do not cause one downstream callback per generator.
 class GeneratorHub {
   public:
-    using OnHalEvent = std::function<void(
-            const aidl::android::hardware::automotive::vehicle::VehiclePropValue& event)>;
+    using OnHalEvents = std::function<void(
+            const std::vector<aidl::android::hardware::automotive::vehicle::VehiclePropValue>&
+                    events)>;
 
-    explicit GeneratorHub(OnHalEvent&& onHalEvent);
+    explicit GeneratorHub(OnHalEvents&& onHalEvents);
     ~GeneratorHub();
 
     // Register a new generator. The generator will be discarded if it could not produce next event.
@@ -74,7 +76,7 @@ class GeneratorHub {
     std::mutex mGeneratorsLock;
     std::unordered_map<int32_t, std::unique_ptr<FakeValueGenerator>> mGenerators
             GUARDED_BY(mGeneratorsLock);
-    OnHalEvent mOnHalEvent;
+    OnHalEvents mOnHalEvents;
     std::condition_variable mCond;
     std::thread mThread;
     std::atomic<bool> mShuttingDownFlag{false};
@@ -21,6 +21,7 @@
 
 #include <json/json.h>
 
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -49,7 +50,15 @@ class JsonFakeValueGenerator : public FakeValueGenerator {
     // used to differentiate this function with the one that takes path as input.
     explicit JsonFakeValueGenerator(bool unused, const std::string& content, int32_t iteration);
 
-    ~JsonFakeValueGenerator() = default;
+    ~JsonFakeValueGenerator();
+
+    // Compiles the JSON replay file at {@code jsonPath} into the binary format understood by
+    // this generator and writes it to {@code binaryPath}. The binary file starts with a magic
+    // number, so the path constructors accept either format transparently. Replaying a binary
+    // file does not parse or hold the whole log in memory: the file is mmapped read-only and
+    // events are decoded one at a time, so multi-gigabyte drive logs start in milliseconds.
+    // Returns false if the JSON file could not be parsed or the output could not be written.
+    static bool compileToBinary(const std::string& jsonPath, const std::string& binaryPath);
 
     std::optional<aidl::android::hardware::automotive::vehicle::VehiclePropValue> nextEvent()
             override;
@@ -59,15 +68,32 @@ class JsonFakeValueGenerator : public FakeValueGenerator {
     // Whether there are events left to replay for this generator.
     bool hasNext();
 
+    // Positions the generator at the first event whose recorded timestamp is greater than or
+    // equal to {@code timestamp}. For binary files this is a binary search over the timestamp
+    // index, so seeking into a large log does not decode the events before the seek point.
+    // Events must be in non-decreasing timestamp order for the result to be meaningful.
+    // Returns false if no event at or after {@code timestamp} exists.
+    bool seekToTimestamp(int64_t timestamp);
+
   private:
     size_t mEventIndex = 0;
     std::vector<aidl::android::hardware::automotive::vehicle::VehiclePropValue> mEvents;
     int64_t mLastEventTimestamp = 0;
     int32_t mNumOfIterations = 0;
+    // Set when replaying a compiled binary file: the file stays mapped read-only and events
+    // are decoded on demand instead of being materialized into mEvents.
+    const uint8_t* mMappedData = nullptr;
+    size_t mMappedSize = 0;
+    size_t mNumMappedEvents = 0;
+    size_t mIndexOffset = 0;
 
     void setBit(std::vector<uint8_t>& bytes, size_t idx);
     void initWithPath(const std::string& path, int32_t iteration);
     void initWithStream(std::istream& is, int32_t iteration);
+    void initWithBinaryFile(const std::string& path, int32_t iteration);
+    size_t numEvents() const;
+    int64_t timestampAt(size_t index) const;
+    aidl::android::hardware::automotive::vehicle::VehiclePropValue eventAt(size_t index) const;
 };
 
 }  // namespace fake
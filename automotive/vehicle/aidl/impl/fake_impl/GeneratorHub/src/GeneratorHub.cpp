@@ -27,9 +27,10 @@ namespace automotive {
 namespace vehicle {
 namespace fake {
 
+using ::aidl::android::hardware::automotive::vehicle::VehiclePropValue;
 using ::android::base::ScopedLockAssertion;
 
-GeneratorHub::GeneratorHub(OnHalEvent&& onHalEvent) : mOnHalEvent(onHalEvent) {
+GeneratorHub::GeneratorHub(OnHalEvents&& onHalEvents) : mOnHalEvents(onHalEvents) {
     mThread = std::thread(&GeneratorHub::run, this);
 }
 
@@ -107,21 +108,30 @@ void GeneratorHub::run() {
                 continue;
             }
         }
-        // Now it's time to handle current event.
-        mOnHalEvent(curEvent.val);
-        // Update queue by popping current event and producing next event from the same generator
-        int32_t id = curEvent.generatorId;
-        mEventQueue.pop();
-        if (mGenerators.find(id) != mGenerators.end()) {
-            auto maybeNextEvent = mGenerators[id]->nextEvent();
-            if (maybeNextEvent.has_value()) {
-                mEventQueue.push({id, maybeNextEvent.value()});
-                continue;
+        // Now it's time to handle current event. Drain every event that is already due into one
+        // batch so generators ticking at the same time produce a single callback invocation
+        // instead of one per generator.
+        std::vector<VehiclePropValue> curEvents;
+        while (!mEventQueue.empty() && mEventQueue.top().val.timestamp <= elapsedRealtimeNano()) {
+            curEvents.push_back(mEventQueue.top().val);
+            // Update queue by popping current event and producing next event from the same
+            // generator
+            int32_t id = mEventQueue.top().generatorId;
+            mEventQueue.pop();
+            if (mGenerators.find(id) != mGenerators.end()) {
+                auto maybeNextEvent = mGenerators[id]->nextEvent();
+                if (maybeNextEvent.has_value()) {
+                    mEventQueue.push({id, maybeNextEvent.value()});
+                    continue;
+                }
             }
-        }
 
-        ALOGI("%s: Generator ended, unregister it, id: %d", __func__, id);
-        mGenerators.erase(id);
+            ALOGI("%s: Generator ended, unregister it, id: %d", __func__, id);
+            mGenerators.erase(id);
+        }
+        if (!curEvents.empty()) {
+            mOnHalEvents(curEvents);
+        }
     }
 }
 
@@ -18,6 +18,13 @@
 
 #include "JsonFakeValueGenerator.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
 #include <fstream>
 #include <type_traits>
 #include <typeinfo>
@@ -171,6 +178,61 @@ std::vector<VehiclePropValue> parseFakeValueJson(std::istream& is) {
     return fakeVhalEvents;
 }
 
+// Compiled binary replay file layout, all fields in native byte order:
+//
+//   BinaryFileHeader
+//   numEvents variable-length records, each a BinaryRecordHeader followed by the int32,
+//       int64, float, byte and string payloads in that order
+//   numEvents BinaryIndexEntry, sorted by record position (and therefore by timestamp for
+//       logs recorded in timestamp order)
+//
+// Records and index entries are not aligned within the file, so all reads go through
+// memcpy. The index allows pacing and seeking without decoding record payloads.
+
+constexpr char kBinaryMagic[8] = {'V', 'H', 'A', 'L', 'F', 'A', 'K', 'E'};
+constexpr uint32_t kBinaryVersion = 1;
+
+struct BinaryFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t numEvents;
+    uint64_t indexOffset;
+};
+
+struct BinaryRecordHeader {
+    int64_t timestamp;
+    int32_t prop;
+    int32_t areaId;
+    uint32_t numInt32Values;
+    uint32_t numInt64Values;
+    uint32_t numFloatValues;
+    uint32_t numByteValues;
+    uint32_t stringLength;
+};
+
+struct BinaryIndexEntry {
+    int64_t timestamp;
+    uint64_t recordOffset;
+};
+
+template <typename T>
+void writeRaw(std::ostream& os, const T& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void writePayload(std::ostream& os, const std::vector<T>& values) {
+    os.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+template <typename T>
+size_t readPayload(const uint8_t* data, size_t count, std::vector<T>& dest) {
+    dest.resize(count);
+    std::memcpy(dest.data(), data, count * sizeof(T));
+    return count * sizeof(T);
+}
+
 }  // namespace
 
 JsonFakeValueGenerator::JsonFakeValueGenerator(const std::string& path)
@@ -194,30 +256,197 @@ JsonFakeValueGenerator::JsonFakeValueGenerator([[maybe_unused]] bool unused,
     initWithStream(iss, iteration);
 }
 
+JsonFakeValueGenerator::~JsonFakeValueGenerator() {
+    if (mMappedData != nullptr) {
+        munmap(const_cast<uint8_t*>(mMappedData), mMappedSize);
+    }
+}
+
+bool JsonFakeValueGenerator::compileToBinary(const std::string& jsonPath,
+                                             const std::string& binaryPath) {
+    std::ifstream ifs(jsonPath);
+    if (!ifs) {
+        ALOGE("%s: couldn't open %s for parsing.", __func__, jsonPath.c_str());
+        return false;
+    }
+    std::vector<VehiclePropValue> events = parseFakeValueJson(ifs);
+    if (events.empty()) {
+        ALOGE("%s: no valid events in %s, not writing %s", __func__, jsonPath.c_str(),
+              binaryPath.c_str());
+        return false;
+    }
+
+    std::ofstream ofs(binaryPath, std::ios::binary | std::ios::trunc);
+    if (!ofs) {
+        ALOGE("%s: couldn't open %s for writing.", __func__, binaryPath.c_str());
+        return false;
+    }
+
+    // The header is rewritten at the end once the index offset is known.
+    BinaryFileHeader header = {};
+    std::memcpy(header.magic, kBinaryMagic, sizeof(kBinaryMagic));
+    header.version = kBinaryVersion;
+    header.numEvents = events.size();
+    writeRaw(ofs, header);
+
+    std::vector<BinaryIndexEntry> index;
+    index.reserve(events.size());
+    for (const VehiclePropValue& event : events) {
+        index.push_back({
+                .timestamp = event.timestamp,
+                .recordOffset = static_cast<uint64_t>(ofs.tellp()),
+        });
+        BinaryRecordHeader record = {
+                .timestamp = event.timestamp,
+                .prop = event.prop,
+                .areaId = event.areaId,
+                .numInt32Values = static_cast<uint32_t>(event.value.int32Values.size()),
+                .numInt64Values = static_cast<uint32_t>(event.value.int64Values.size()),
+                .numFloatValues = static_cast<uint32_t>(event.value.floatValues.size()),
+                .numByteValues = static_cast<uint32_t>(event.value.byteValues.size()),
+                .stringLength = static_cast<uint32_t>(event.value.stringValue.size()),
+        };
+        writeRaw(ofs, record);
+        writePayload(ofs, event.value.int32Values);
+        writePayload(ofs, event.value.int64Values);
+        writePayload(ofs, event.value.floatValues);
+        writePayload(ofs, event.value.byteValues);
+        ofs.write(event.value.stringValue.data(), event.value.stringValue.size());
+    }
+
+    header.indexOffset = static_cast<uint64_t>(ofs.tellp());
+    writePayload(ofs, index);
+
+    ofs.seekp(0);
+    writeRaw(ofs, header);
+    ofs.flush();
+    if (!ofs) {
+        ALOGE("%s: failed to write %s", __func__, binaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
 void JsonFakeValueGenerator::initWithPath(const std::string& path, int32_t iteration) {
     std::ifstream ifs(path);
     if (!ifs) {
         ALOGE("%s: couldn't open %s for parsing.", __func__, path.c_str());
         return;
     }
+    char magic[sizeof(kBinaryMagic)] = {};
+    ifs.read(magic, sizeof(magic));
+    if (ifs.gcount() == sizeof(magic) && std::memcmp(magic, kBinaryMagic, sizeof(magic)) == 0) {
+        ifs.close();
+        initWithBinaryFile(path, iteration);
+        return;
+    }
+    ifs.clear();
+    ifs.seekg(0);
     initWithStream(ifs, iteration);
 }
 
+void JsonFakeValueGenerator::initWithBinaryFile(const std::string& path, int32_t iteration) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        ALOGE("%s: couldn't open %s: %s", __func__, path.c_str(), strerror(errno));
+        return;
+    }
+    struct stat statBuf;
+    if (fstat(fd, &statBuf) != 0 ||
+        statBuf.st_size < static_cast<off_t>(sizeof(BinaryFileHeader))) {
+        ALOGE("%s: %s is not a valid binary replay file", __func__, path.c_str());
+        close(fd);
+        return;
+    }
+    size_t fileSize = static_cast<size_t>(statBuf.st_size);
+    void* data = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file alive.
+    close(fd);
+    if (data == MAP_FAILED) {
+        ALOGE("%s: couldn't mmap %s: %s", __func__, path.c_str(), strerror(errno));
+        return;
+    }
+
+    BinaryFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.version != kBinaryVersion ||
+        header.indexOffset + header.numEvents * sizeof(BinaryIndexEntry) > fileSize) {
+        ALOGE("%s: %s has unsupported version %u or a corrupt index", __func__, path.c_str(),
+              header.version);
+        munmap(data, fileSize);
+        return;
+    }
+
+    mMappedData = static_cast<const uint8_t*>(data);
+    mMappedSize = fileSize;
+    mNumMappedEvents = header.numEvents;
+    mIndexOffset = header.indexOffset;
+    mNumOfIterations = iteration;
+}
+
 void JsonFakeValueGenerator::initWithStream(std::istream& is, int32_t iteration) {
     mEvents = parseFakeValueJson(is);
     mNumOfIterations = iteration;
 }
 
+size_t JsonFakeValueGenerator::numEvents() const {
+    return mMappedData != nullptr ? mNumMappedEvents : mEvents.size();
+}
+
+int64_t JsonFakeValueGenerator::timestampAt(size_t index) const {
+    if (mMappedData == nullptr) {
+        return mEvents[index].timestamp;
+    }
+    BinaryIndexEntry entry;
+    std::memcpy(&entry, mMappedData + mIndexOffset + index * sizeof(BinaryIndexEntry),
+                sizeof(entry));
+    return entry.timestamp;
+}
+
+VehiclePropValue JsonFakeValueGenerator::eventAt(size_t index) const {
+    if (mMappedData == nullptr) {
+        return mEvents[index];
+    }
+    BinaryIndexEntry entry;
+    std::memcpy(&entry, mMappedData + mIndexOffset + index * sizeof(BinaryIndexEntry),
+                sizeof(entry));
+    const uint8_t* record = mMappedData + entry.recordOffset;
+
+    BinaryRecordHeader header;
+    std::memcpy(&header, record, sizeof(header));
+    record += sizeof(header);
+
+    VehiclePropValue event = {
+            .timestamp = header.timestamp,
+            .areaId = header.areaId,
+            .prop = header.prop,
+    };
+    record += readPayload(record, header.numInt32Values, event.value.int32Values);
+    record += readPayload(record, header.numInt64Values, event.value.int64Values);
+    record += readPayload(record, header.numFloatValues, event.value.floatValues);
+    record += readPayload(record, header.numByteValues, event.value.byteValues);
+    event.value.stringValue.assign(reinterpret_cast<const char*>(record), header.stringLength);
+    return event;
+}
+
 const std::vector<VehiclePropValue>& JsonFakeValueGenerator::getAllEvents() {
+    // Materialize binary events on first use; callers of this accessor (event injection)
+    // want the whole log anyway, so the streaming benefit does not apply to them.
+    if (mMappedData != nullptr && mEvents.size() != mNumMappedEvents) {
+        mEvents.reserve(mNumMappedEvents);
+        for (size_t i = mEvents.size(); i < mNumMappedEvents; i++) {
+            mEvents.push_back(eventAt(i));
+        }
+    }
     return mEvents;
 }
 
 std::optional<VehiclePropValue> JsonFakeValueGenerator::nextEvent() {
-    if (mNumOfIterations == 0 || mEvents.size() == 0) {
+    if (mNumOfIterations == 0 || numEvents() == 0) {
         return std::nullopt;
     }
 
-    VehiclePropValue generatedValue = mEvents[mEventIndex];
+    VehiclePropValue generatedValue = eventAt(mEventIndex);
 
     if (mLastEventTimestamp == 0) {
         mLastEventTimestamp = elapsedRealtimeNano();
@@ -227,7 +456,7 @@ std::optional<VehiclePropValue> JsonFakeValueGenerator::nextEvent() {
             // All events (start from 2nd one) are supposed to happen in the future with a delay
             // equals to the duration between previous and current event.
             nextEventTime = mLastEventTimestamp +
-                            (mEvents[mEventIndex].timestamp - mEvents[mEventIndex - 1].timestamp);
+                            (timestampAt(mEventIndex) - timestampAt(mEventIndex - 1));
         } else {
             // We are starting another iteration, immediately send the next event after 1ms.
             nextEventTime = mLastEventTimestamp + 1000000;
@@ -238,7 +467,7 @@ std::optional<VehiclePropValue> JsonFakeValueGenerator::nextEvent() {
     }
 
     mEventIndex++;
-    if (mEventIndex == mEvents.size()) {
+    if (mEventIndex == numEvents()) {
         mEventIndex = 0;
         if (mNumOfIterations > 0) {
             mNumOfIterations--;
@@ -250,7 +479,28 @@ std::optional<VehiclePropValue> JsonFakeValueGenerator::nextEvent() {
 }
 
 bool JsonFakeValueGenerator::hasNext() {
-    return mNumOfIterations != 0 && mEvents.size() > 0;
+    return mNumOfIterations != 0 && numEvents() > 0;
+}
+
+bool JsonFakeValueGenerator::seekToTimestamp(int64_t timestamp) {
+    size_t count = numEvents();
+    // Binary search for the first event at or after the requested timestamp; timestampAt()
+    // only touches the index, so this faults in O(log n) pages of a cold mapped file.
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (timestampAt(mid) < timestamp) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == count) {
+        return false;
+    }
+    mEventIndex = low;
+    return true;
 }
 
 }  // namespace fake
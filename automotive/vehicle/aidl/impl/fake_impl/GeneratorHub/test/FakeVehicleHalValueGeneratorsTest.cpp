@@ -47,7 +47,7 @@ class FakeVehicleHalValueGeneratorsTest : public ::testing::Test {
   protected:
     void SetUp() override {
         mHub = std::make_unique<GeneratorHub>(
-                [this](const VehiclePropValue& event) { return onHalEvent(event); });
+                [this](const std::vector<VehiclePropValue>& events) { return onHalEvents(events); });
     }
 
     GeneratorHub* getHub() { return mHub.get(); }
@@ -83,11 +83,10 @@ class FakeVehicleHalValueGeneratorsTest : public ::testing::Test {
     }
 
   private:
-    void onHalEvent(const VehiclePropValue& event) {
-        VehiclePropValue eventCopy = event;
+    void onHalEvents(const std::vector<VehiclePropValue>& events) {
         {
             std::scoped_lock<std::mutex> lockGuard(mEventsLock);
-            mEvents.push_back(std::move(eventCopy));
+            mEvents.insert(mEvents.end(), events.begin(), events.end());
         }
         mCv.notify_all();
     }
@@ -476,6 +475,93 @@ TEST_F(FakeVehicleHalValueGeneratorsTest, testJsonFakeValueGeneratorDifferentTyp
     EXPECT_EQ(events, expectedValues);
 }
 
+TEST_F(FakeVehicleHalValueGeneratorsTest, testJsonFakeValueGeneratorCompiledBinaryMatchesJson) {
+    TemporaryDir tmpDir;
+    std::string binaryPath = std::string(tmpDir.path) + "/prop_different_types.bin";
+    ASSERT_TRUE(JsonFakeValueGenerator::compileToBinary(
+            getTestFilePath("prop_different_types.json"), binaryPath));
+
+    JsonFakeValueGenerator jsonGenerator(getTestFilePath("prop_different_types.json"), 1);
+    JsonFakeValueGenerator binaryGenerator(binaryPath, 1);
+
+    // The compiled file must decode to exactly the events the JSON parser produces,
+    // including timestamps and every payload type.
+    EXPECT_EQ(binaryGenerator.getAllEvents(), jsonGenerator.getAllEvents());
+}
+
+TEST_F(FakeVehicleHalValueGeneratorsTest, testJsonFakeValueGeneratorBinaryReplay) {
+    TemporaryDir tmpDir;
+    std::string binaryPath = std::string(tmpDir.path) + "/prop.bin";
+    ASSERT_TRUE(JsonFakeValueGenerator::compileToBinary(getTestFilePath("prop.json"), binaryPath));
+
+    int64_t currentTime = elapsedRealtimeNano();
+
+    std::unique_ptr<JsonFakeValueGenerator> generator =
+            std::make_unique<JsonFakeValueGenerator>(binaryPath, 2);
+    getHub()->registerGenerator(0, std::move(generator));
+
+    std::vector<VehiclePropValue> expectedValues = {
+            VehiclePropValue{
+                    .areaId = 0,
+                    .value.int32Values = {8},
+                    .prop = 289408000,
+            },
+            VehiclePropValue{
+                    .areaId = 0,
+                    .value.int32Values = {4},
+                    .prop = 289408000,
+            },
+            VehiclePropValue{
+                    .areaId = 0,
+                    .value.int32Values = {16},
+                    .prop = 289408000,
+            },
+            VehiclePropValue{
+                    .areaId = 0,
+                    .value.int32Values = {10},
+                    .prop = 289408000,
+            },
+    };
+
+    // We have two iterations.
+    for (size_t i = 0; i < 4; i++) {
+        expectedValues.push_back(expectedValues[i]);
+    }
+
+    waitForEvents(expectedValues.size());
+    auto events = getEvents();
+
+    int64_t lastEventTime = currentTime;
+    for (auto& event : events) {
+        EXPECT_GT(event.timestamp, lastEventTime);
+        lastEventTime = event.timestamp;
+        event.timestamp = 0;
+    }
+
+    EXPECT_EQ(events, expectedValues);
+}
+
+TEST_F(FakeVehicleHalValueGeneratorsTest, testJsonFakeValueGeneratorSeekToTimestamp) {
+    TemporaryDir tmpDir;
+    std::string binaryPath = std::string(tmpDir.path) + "/prop.bin";
+    ASSERT_TRUE(JsonFakeValueGenerator::compileToBinary(getTestFilePath("prop.json"), binaryPath));
+
+    JsonFakeValueGenerator jsonGenerator(getTestFilePath("prop.json"), 1);
+    auto allEvents = jsonGenerator.getAllEvents();
+    ASSERT_EQ(allEvents.size(), 4u);
+
+    JsonFakeValueGenerator binaryGenerator(binaryPath, 1);
+    ASSERT_TRUE(binaryGenerator.seekToTimestamp(allEvents[2].timestamp));
+
+    auto event = binaryGenerator.nextEvent();
+    ASSERT_TRUE(event.has_value());
+    EXPECT_EQ(event->prop, allEvents[2].prop);
+    EXPECT_EQ(event->value, allEvents[2].value);
+
+    // No event at or after a timestamp past the end of the log.
+    EXPECT_FALSE(binaryGenerator.seekToTimestamp(allEvents[3].timestamp + 1));
+}
+
 }  // namespace fake
 }  // namespace vehicle
 }  // namespace automotive
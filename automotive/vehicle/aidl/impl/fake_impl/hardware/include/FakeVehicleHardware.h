@@ -170,6 +170,10 @@ class FakeVehicleHardware : public IVehicleHardware {
     // The callback that would be called when a vehicle property value change happens.
     void onValueChangeCallback(
             const aidl::android::hardware::automotive::vehicle::VehiclePropValue& value);
+    // Delivers a batch of property change events as one callback invocation, keeping only
+    // the final value for each propId/areaId.
+    void onValuesChangeCallback(
+            std::vector<aidl::android::hardware::automotive::vehicle::VehiclePropValue> values);
     // Load the config files in format '*.json' from the directory and parse the config files
     // into a map from property ID to ConfigDeclarations.
     void loadPropConfigsFromDir(const std::string& dirPath,
@@ -178,6 +182,11 @@ class FakeVehicleHardware : public IVehicleHardware {
     // implementation, this function is only called during "--inject-event" dump command.
     void eventFromVehicleBus(
             const aidl::android::hardware::automotive::vehicle::VehiclePropValue& value);
+    // Handles a batch of value change events from vehicle bus, delivering the resulting
+    // property change events as one callback invocation. This is the GeneratorHub callback.
+    void eventsFromVehicleBus(
+            const std::vector<aidl::android::hardware::automotive::vehicle::VehiclePropValue>&
+                    values);
 
     int getHvacTempNumIncrements(int requestedTemp, int minTemp, int maxTemp, int increment);
     void updateHvacTemperatureValueSuggestionInput(
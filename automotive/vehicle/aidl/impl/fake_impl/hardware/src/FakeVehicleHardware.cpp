@@ -190,6 +190,13 @@ const std::unordered_map<int32_t, std::vector<int32_t>> mAdasEnabledPropToAdasPr
                 },
         },
 };
+
+// While a set request is being handled on this thread, property change events are appended
+// here instead of being dispatched one at a time, so the set and all of its
+// dependent-property side effects (e.g. HVAC power coupling, ADAS state propagation) are
+// delivered to the client as one consolidated batch.
+thread_local std::vector<VehiclePropValue>* tBatchedPropertyChanges = nullptr;
+
 }  // namespace
 
 void FakeVehicleHardware::storePropInitialValue(const ConfigDeclaration& config) {
@@ -243,8 +250,9 @@ FakeVehicleHardware::FakeVehicleHardware(std::string defaultConfigDir,
       mFakeObd2Frame(new obd2frame::FakeObd2Frame(mServerSidePropStore)),
       mFakeUserHal(new FakeUserHal(mValuePool)),
       mRecurrentTimer(new RecurrentTimer()),
-      mGeneratorHub(new GeneratorHub(
-              [this](const VehiclePropValue& value) { eventFromVehicleBus(value); })),
+      mGeneratorHub(new GeneratorHub([this](const std::vector<VehiclePropValue>& values) {
+          eventsFromVehicleBus(values);
+      })),
       mPendingGetValueRequests(this),
       mPendingSetValueRequests(this),
       mDefaultConfigDir(defaultConfigDir),
@@ -881,7 +889,14 @@ SetValueResult FakeVehicleHardware::handleSetValueRequest(const SetValueRequest&
     SetValueResult setValueResult;
     setValueResult.requestId = request.requestId;
 
-    if (auto result = setValue(request.value); !result.ok()) {
+    // Batch every property change event this request generates, including the side effects
+    // on dependent properties, into one callback invocation.
+    std::vector<VehiclePropValue> batchedChanges;
+    tBatchedPropertyChanges = &batchedChanges;
+    auto result = setValue(request.value);
+    tBatchedPropertyChanges = nullptr;
+
+    if (!result.ok()) {
         ALOGE("failed to set value, error: %s, code: %d", getErrorMsg(result).c_str(),
               getIntErrorCode(result));
         setValueResult.status = getErrorCode(result);
@@ -889,6 +904,10 @@ SetValueResult FakeVehicleHardware::handleSetValueRequest(const SetValueRequest&
         setValueResult.status = StatusCode::OK;
     }
 
+    // Even a failed set may have generated side-effect events before the failure; they
+    // reflect real store updates and must still be delivered.
+    onValuesChangeCallback(std::move(batchedChanges));
+
     return setValueResult;
 }
 
@@ -983,6 +1002,8 @@ DumpResult FakeVehicleHardware::dump(const std::vector<std::string>& options) {
         result.buffer = dumpRestoreProperty(options);
     } else if (EqualsIgnoreCase(option, "--inject-event")) {
         result.buffer = dumpInjectEvent(options);
+    } else if (EqualsIgnoreCase(option, "--poolstats")) {
+        result.buffer = mValuePool->dump();
     } else if (EqualsIgnoreCase(option, kUserHalDumpOption)) {
         result.buffer = mFakeUserHal->dump();
     } else if (EqualsIgnoreCase(option, "--genfakedata")) {
@@ -1396,6 +1417,19 @@ void FakeVehicleHardware::eventFromVehicleBus(const VehiclePropValue& value) {
     mServerSidePropStore->writeValue(mValuePool->obtain(value));
 }
 
+void FakeVehicleHardware::eventsFromVehicleBus(const std::vector<VehiclePropValue>& values) {
+    // Batch the property change events generated by the store writes into one callback
+    // invocation, same as handleSetValueRequest does.
+    std::vector<VehiclePropValue> batchedChanges;
+    tBatchedPropertyChanges = &batchedChanges;
+    for (const auto& value : values) {
+        eventFromVehicleBus(value);
+    }
+    tBatchedPropertyChanges = nullptr;
+
+    onValuesChangeCallback(std::move(batchedChanges));
+}
+
 std::string FakeVehicleHardware::dumpHelp() {
     return "Usage: \n\n"
            "[no args]: dumps (id and value) all supported properties \n"
@@ -1408,7 +1442,8 @@ std::string FakeVehicleHardware::dumpHelp() {
            "--save-prop <prop> [-a AREA_ID]: saves the current value for PROP, integration test"
            " that modifies prop value must call this before test and restore-prop after test. \n"
            "--restore-prop <prop> [-a AREA_ID]: restores a previously saved property value. \n"
-           "--inject-event <PROP> [ValueArguments]: inject a property update event from car\n\n"
+           "--inject-event <PROP> [ValueArguments]: inject a property update event from car\n"
+           "--poolstats: dumps the value pool's per-type hit/miss counters. \n\n"
            "ValueArguments are in the format of [-i INT_VALUE [INT_VALUE ...]] "
            "[-i64 INT64_VALUE [INT64_VALUE ...]] [-f FLOAT_VALUE [FLOAT_VALUE ...]] [-s STR_VALUE] "
            "[-b BYTES_VALUE] [-a AREA_ID].\n"
@@ -1858,6 +1893,13 @@ StatusCode FakeVehicleHardware::updateSampleRate(int32_t propId, int32_t areaId,
 }
 
 void FakeVehicleHardware::onValueChangeCallback(const VehiclePropValue& value) {
+    if (tBatchedPropertyChanges != nullptr) {
+        // A set request is being handled on this thread; the event is delivered together
+        // with everything else the request generates when the request finishes.
+        tBatchedPropertyChanges->push_back(value);
+        return;
+    }
+
     if (mOnPropertyChangeCallback == nullptr) {
         return;
     }
@@ -1867,6 +1909,38 @@ void FakeVehicleHardware::onValueChangeCallback(const VehiclePropValue& value) {
     (*mOnPropertyChangeCallback)(std::move(updatedValues));
 }
 
+void FakeVehicleHardware::onValuesChangeCallback(std::vector<VehiclePropValue> values) {
+    if (mOnPropertyChangeCallback == nullptr || values.empty()) {
+        return;
+    }
+
+    if (values.size() > 1) {
+        // Side effects may update the same property more than once within one request. Keep
+        // only the final value for each propId/areaId, in the order the properties first
+        // changed - which is the order the side effects were generated in, i.e. dependency
+        // order.
+        std::unordered_map<PropIdAreaId, size_t, PropIdAreaIdHash> indexByPropIdAreaId;
+        std::vector<VehiclePropValue> consolidated;
+        consolidated.reserve(values.size());
+        for (VehiclePropValue& value : values) {
+            PropIdAreaId propIdAreaId{
+                    .propId = value.prop,
+                    .areaId = value.areaId,
+            };
+            if (auto it = indexByPropIdAreaId.find(propIdAreaId);
+                it != indexByPropIdAreaId.end()) {
+                consolidated[it->second] = std::move(value);
+                continue;
+            }
+            indexByPropIdAreaId[propIdAreaId] = consolidated.size();
+            consolidated.push_back(std::move(value));
+        }
+        values = std::move(consolidated);
+    }
+
+    (*mOnPropertyChangeCallback)(std::move(values));
+}
+
 void FakeVehicleHardware::loadPropConfigsFromDir(
         const std::string& dirPath,
         std::unordered_map<int32_t, ConfigDeclaration>* configsByPropId) {
@@ -272,6 +272,7 @@ class FakeVehicleHardwareTest : public ::testing::Test {
 
     void onPropertyChangeEvent(std::vector<VehiclePropValue> values) {
         std::scoped_lock<std::mutex> lockGuard(mLock);
+        mEventBatchCount++;
         for (auto& value : values) {
             mChangedProperties.push_back(value);
             PropIdAreaId propIdAreaId{
@@ -313,6 +314,12 @@ class FakeVehicleHardwareTest : public ::testing::Test {
         std::scoped_lock<std::mutex> lockGuard(mLock);
         mEventCount.clear();
         mChangedProperties.clear();
+        mEventBatchCount = 0;
+    }
+
+    size_t getEventBatchCount() {
+        std::scoped_lock<std::mutex> lockGuard(mLock);
+        return mEventBatchCount;
     }
 
     size_t getEventCount(int32_t propId, int32_t areaId) {
@@ -395,6 +402,7 @@ class FakeVehicleHardwareTest : public ::testing::Test {
     std::vector<SetValueResult> mSetValueResults GUARDED_BY(mLock);
     std::vector<GetValueResult> mGetValueResults GUARDED_BY(mLock);
     std::vector<VehiclePropValue> mChangedProperties GUARDED_BY(mLock);
+    size_t mEventBatchCount GUARDED_BY(mLock) = 0;
     std::unordered_set<int64_t> mPendingSetValueRequests GUARDED_BY(mLock);
     std::unordered_set<int64_t> mPendingGetValueRequests GUARDED_BY(mLock);
 };
@@ -1747,6 +1755,24 @@ TEST_F(FakeVehicleHardwareTest, testHvacPowerOnSendCurrentHvacPropValues) {
     }
 }
 
+TEST_F(FakeVehicleHardwareTest, testHvacPowerOnEventsDeliveredInOneBatch) {
+    StatusCode status = setValue(VehiclePropValue{.prop = toInt(VehicleProperty::HVAC_POWER_ON),
+                                                  .areaId = SEAT_1_LEFT,
+                                                  .value.int32Values = {0}});
+
+    ASSERT_EQ(status, StatusCode::OK);
+
+    clearChangedProperties();
+    setValue(VehiclePropValue{.prop = toInt(VehicleProperty::HVAC_POWER_ON),
+                              .areaId = SEAT_1_LEFT,
+                              .value.int32Values = {1}});
+
+    // Turning HVAC power on generates events for HVAC_POWER_ON plus every dependent HVAC
+    // property, all of which must be delivered in a single callback invocation.
+    EXPECT_GT(getChangedProperties().size(), 1u);
+    EXPECT_EQ(getEventBatchCount(), 1u);
+}
+
 TEST_F(FakeVehicleHardwareTest, testGetAdasPropNotAvailable) {
     std::unordered_map<int32_t, std::vector<int32_t>> adasEnabledPropToDependentProps = {
             {
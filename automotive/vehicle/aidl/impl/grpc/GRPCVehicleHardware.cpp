@@ -21,9 +21,11 @@
 #include <android-base/logging.h>
 #include <grpc++/grpc++.h>
 
+#include <cstdint>
 #include <cstdlib>
 #include <mutex>
 #include <shared_mutex>
+#include <unordered_map>
 #include <utility>
 
 namespace android::hardware::automotive::vehicle::virtualization {
@@ -215,21 +217,10 @@ void GRPCVehicleHardware::ValuePollingLoop() {
             context.TryCancel();
         });
 
-        auto value_stream =
-                mGrpcStub->StartPropertyValuesStream(&context, ::google::protobuf::Empty());
-        LOG(INFO) << __func__ << ": GRPC Value Streaming Started";
-        proto::VehiclePropValues protoValues;
-        while (!mShuttingDownFlag.load() && value_stream->Read(&protoValues)) {
-            std::vector<aidlvhal::VehiclePropValue> values;
-            for (const auto protoValue : protoValues.values()) {
-                values.push_back(aidlvhal::VehiclePropValue());
-                proto_msg_converter::protoToAidl(protoValue, &values.back());
-            }
-            std::shared_lock lck(mCallbackMutex);
-            if (mOnPropChange) {
-                (*mOnPropChange)(values);
-            }
-        }
+        // Prefer the delta-encoded stream, fall back to full values for servers that do not
+        // implement it.
+        auto grpc_status = mDeltaStreamUnsupported ? PollValuesStream(&context)
+                                                   : PollValuesDeltaStream(&context);
 
         {
             std::lock_guard lck(mShutdownMutex);
@@ -238,7 +229,15 @@ void GRPCVehicleHardware::ValuePollingLoop() {
         mShutdownCV.notify_all();
         shuttingdown_watcher.join();
 
-        auto grpc_status = value_stream->Finish();
+        if (!mDeltaStreamUnsupported &&
+            grpc_status.error_code() == ::grpc::StatusCode::UNIMPLEMENTED) {
+            LOG(INFO) << __func__
+                      << ": Server does not support delta value streaming, falling back to "
+                         "full values";
+            mDeltaStreamUnsupported = true;
+            continue;
+        }
+
         // never reach here until connection lost
         LOG(ERROR) << __func__ << ": GRPC Value Streaming Failed: " << grpc_status.error_message();
 
@@ -246,4 +245,62 @@ void GRPCVehicleHardware::ValuePollingLoop() {
     }
 }
 
+::grpc::Status GRPCVehicleHardware::PollValuesStream(::grpc::ClientContext* context) {
+    auto value_stream = mGrpcStub->StartPropertyValuesStream(context, ::google::protobuf::Empty());
+    LOG(INFO) << __func__ << ": GRPC Value Streaming Started";
+    proto::VehiclePropValues protoValues;
+    while (!mShuttingDownFlag.load() && value_stream->Read(&protoValues)) {
+        std::vector<aidlvhal::VehiclePropValue> values;
+        for (const auto protoValue : protoValues.values()) {
+            values.push_back(aidlvhal::VehiclePropValue());
+            proto_msg_converter::protoToAidl(protoValue, &values.back());
+        }
+        DeliverPropertyChanges(std::move(values));
+    }
+    return value_stream->Finish();
+}
+
+::grpc::Status GRPCVehicleHardware::PollValuesDeltaStream(::grpc::ClientContext* context) {
+    auto value_stream =
+            mGrpcStub->StartPropertyValuesDeltaStream(context, ::google::protobuf::Empty());
+    LOG(INFO) << __func__ << ": GRPC Delta Value Streaming Started";
+    // The last full value for each [prop, areaId], used to reconstruct full values from the
+    // deltas. The cache only lives as long as the stream, the server starts over with full
+    // values on a new stream.
+    std::unordered_map<int64_t, proto::VehiclePropValue> lastValues;
+    proto::VehiclePropValuesDelta protoDeltas;
+    while (!mShuttingDownFlag.load() && value_stream->Read(&protoDeltas)) {
+        std::vector<aidlvhal::VehiclePropValue> values;
+        for (const auto& delta : protoDeltas.deltas()) {
+            int64_t key = (static_cast<int64_t>(delta.prop()) << 32) |
+                          static_cast<uint32_t>(delta.area_id());
+            bool firstUpdate = lastValues.find(key) == lastValues.end();
+            auto& cached = lastValues[key];
+            cached.set_prop(delta.prop());
+            cached.set_area_id(delta.area_id());
+            cached.set_status(delta.status());
+            cached.set_timestamp(firstUpdate ? delta.timestamp_delta()
+                                             : cached.timestamp() + delta.timestamp_delta());
+            if (delta.value_changed()) {
+                *cached.mutable_int32_values() = delta.int32_values();
+                *cached.mutable_float_values() = delta.float_values();
+                *cached.mutable_int64_values() = delta.int64_values();
+                cached.set_byte_values(delta.byte_values());
+                cached.set_string_value(delta.string_value());
+            }
+            values.push_back(aidlvhal::VehiclePropValue());
+            proto_msg_converter::protoToAidl(cached, &values.back());
+        }
+        DeliverPropertyChanges(std::move(values));
+    }
+    return value_stream->Finish();
+}
+
+void GRPCVehicleHardware::DeliverPropertyChanges(std::vector<aidlvhal::VehiclePropValue> values) {
+    std::shared_lock lck(mCallbackMutex);
+    if (mOnPropChange) {
+        (*mOnPropChange)(values);
+    }
+}
+
 }  // namespace android::hardware::automotive::vehicle::virtualization
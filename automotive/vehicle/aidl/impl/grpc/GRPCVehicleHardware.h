@@ -83,10 +83,21 @@ class GRPCVehicleHardware : public IVehicleHardware {
   private:
     void ValuePollingLoop();
 
+    // Reads the full value stream until disconnection, returns the final stream status.
+    ::grpc::Status PollValuesStream(::grpc::ClientContext* context);
+    // Reads the delta value stream until disconnection, reconstructing full values from a
+    // per-stream cache, returns the final stream status.
+    ::grpc::Status PollValuesDeltaStream(::grpc::ClientContext* context);
+
+    void DeliverPropertyChanges(std::vector<aidlvhal::VehiclePropValue> values);
+
     std::string mServiceAddr;
     std::shared_ptr<::grpc::Channel> mGrpcChannel;
     std::unique_ptr<proto::VehicleServer::Stub> mGrpcStub;
     std::thread mValuePollingThread;
+    // Only accessed on the value polling thread. Set once the server reports the delta value
+    // stream as unimplemented so we stop probing for it.
+    bool mDeltaStreamUnsupported{false};
 
     std::shared_mutex mCallbackMutex;
     std::unique_ptr<const PropertyChangeCallback> mOnPropChange;
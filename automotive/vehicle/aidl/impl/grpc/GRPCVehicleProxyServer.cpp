@@ -195,6 +195,19 @@ GrpcVehicleProxyServer::GrpcVehicleProxyServer(std::string serverAddr,
     return ::grpc::Status(::grpc::StatusCode::ABORTED, "Connection lost.");
 }
 
+::grpc::Status GrpcVehicleProxyServer::StartPropertyValuesDeltaStream(
+        ::grpc::ServerContext* context, const ::google::protobuf::Empty* request,
+        ::grpc::ServerWriter<proto::VehiclePropValuesDelta>* stream) {
+    auto conn = std::make_shared<ConnectionDescriptor>(stream);
+    {
+        std::lock_guard lck(mConnectionMutex);
+        mValueStreamingConnections.push_back(conn);
+    }
+    conn->Wait();
+    LOG(ERROR) << __func__ << ": Stream lost, ID : " << conn->ID();
+    return ::grpc::Status(::grpc::StatusCode::ABORTED, "Connection lost.");
+}
+
 void GrpcVehicleProxyServer::OnVehiclePropChange(
         const std::vector<aidlvhal::VehiclePropValue>& values) {
     std::unordered_set<uint64_t> brokenConn;
@@ -263,23 +276,71 @@ GrpcVehicleProxyServer::ConnectionDescriptor::~ConnectionDescriptor() {
 }
 
 bool GrpcVehicleProxyServer::ConnectionDescriptor::Write(const proto::VehiclePropValues& values) {
-    if (!mStream) {
+    if (!mStream && !mDeltaStream) {
         LOG(ERROR) << __func__ << ": Empty stream. ID: " << ID();
         Shutdown();
         return false;
     }
     {
         std::lock_guard lck(*mMtx);
-        if (!mShutdownFlag && mStream->Write(values)) {
-            return true;
-        } else {
-            LOG(ERROR) << __func__ << ": Server Write failed, connection lost. ID: " << ID();
+        if (!mShutdownFlag) {
+            if (mStream) {
+                if (mStream->Write(values)) {
+                    return true;
+                }
+            } else {
+                proto::VehiclePropValuesDelta deltas;
+                for (const auto& value : values.values()) {
+                    EncodeDeltaLocked(value, deltas.add_deltas());
+                }
+                if (mDeltaStream->Write(deltas)) {
+                    return true;
+                }
+            }
         }
+        LOG(ERROR) << __func__ << ": Server Write failed, connection lost. ID: " << ID();
     }
     Shutdown();
     return false;
 }
 
+void GrpcVehicleProxyServer::ConnectionDescriptor::EncodeDeltaLocked(
+        const proto::VehiclePropValue& value, proto::VehiclePropValueDelta* delta) {
+    delta->set_prop(value.prop());
+    delta->set_area_id(value.area_id());
+    delta->set_status(value.status());
+    int64_t key = (static_cast<int64_t>(value.prop()) << 32) |
+                  static_cast<uint32_t>(value.area_id());
+    auto it = mLastValueByPropIdAreaId.find(key);
+    if (it == mLastValueByPropIdAreaId.end()) {
+        // First update of this property on this stream, send the full payload and the absolute
+        // timestamp.
+        delta->set_timestamp_delta(value.timestamp());
+    } else {
+        const auto& lastValue = it->second;
+        delta->set_timestamp_delta(value.timestamp() - lastValue.timestamp());
+        if (std::equal(value.int32_values().begin(), value.int32_values().end(),
+                       lastValue.int32_values().begin(), lastValue.int32_values().end()) &&
+            std::equal(value.float_values().begin(), value.float_values().end(),
+                       lastValue.float_values().begin(), lastValue.float_values().end()) &&
+            std::equal(value.int64_values().begin(), value.int64_values().end(),
+                       lastValue.int64_values().begin(), lastValue.int64_values().end()) &&
+            value.byte_values() == lastValue.byte_values() &&
+            value.string_value() == lastValue.string_value()) {
+            // Payload unchanged, only prop, area ID, timestamp delta and status go on the wire.
+            mLastValueByPropIdAreaId[key] = value;
+            return;
+        }
+    }
+    delta->set_value_changed(true);
+    *delta->mutable_int32_values() = value.int32_values();
+    *delta->mutable_float_values() = value.float_values();
+    *delta->mutable_int64_values() = value.int64_values();
+    delta->set_byte_values(value.byte_values());
+    delta->set_string_value(value.string_value());
+    mLastValueByPropIdAreaId[key] = value;
+}
+
 void GrpcVehicleProxyServer::ConnectionDescriptor::Wait() {
     std::unique_lock lck(*mMtx);
     mCV->wait(lck, [this] { return mShutdownFlag; });
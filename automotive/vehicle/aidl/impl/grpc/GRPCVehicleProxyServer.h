@@ -30,6 +30,7 @@
 #include <memory>
 #include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 namespace android::hardware::automotive::vehicle::virtualization {
@@ -67,6 +68,10 @@ class GrpcVehicleProxyServer : public proto::VehicleServer::Service {
             ::grpc::ServerContext* context, const ::google::protobuf::Empty* request,
             ::grpc::ServerWriter<proto::VehiclePropValues>* stream) override;
 
+    ::grpc::Status StartPropertyValuesDeltaStream(
+            ::grpc::ServerContext* context, const ::google::protobuf::Empty* request,
+            ::grpc::ServerWriter<proto::VehiclePropValuesDelta>* stream) override;
+
     GrpcVehicleProxyServer& Start();
 
     GrpcVehicleProxyServer& Shutdown();
@@ -84,6 +89,12 @@ class GrpcVehicleProxyServer : public proto::VehicleServer::Service {
               mMtx(std::make_unique<std::mutex>()),
               mCV(std::make_unique<std::condition_variable>()) {}
 
+        explicit ConnectionDescriptor(::grpc::ServerWriter<proto::VehiclePropValuesDelta>* stream)
+            : mDeltaStream(stream),
+              mConnectionID(connection_id_counter_.fetch_add(1) + 1),
+              mMtx(std::make_unique<std::mutex>()),
+              mCV(std::make_unique<std::condition_variable>()) {}
+
         ConnectionDescriptor(const ConnectionDescriptor&) = delete;
         ConnectionDescriptor(ConnectionDescriptor&& cd) = default;
         ConnectionDescriptor& operator=(const ConnectionDescriptor&) = delete;
@@ -93,6 +104,8 @@ class GrpcVehicleProxyServer : public proto::VehicleServer::Service {
 
         uint64_t ID() const { return mConnectionID; }
 
+        // Writes the values to the underlying stream. On a delta stream, the values are
+        // delta-encoded against this connection's value cache first.
         bool Write(const proto::VehiclePropValues& values);
 
         void Wait();
@@ -100,11 +113,20 @@ class GrpcVehicleProxyServer : public proto::VehicleServer::Service {
         void Shutdown();
 
       private:
-        ::grpc::ServerWriter<proto::VehiclePropValues>* mStream;
+        ::grpc::ServerWriter<proto::VehiclePropValues>* mStream{nullptr};
+        ::grpc::ServerWriter<proto::VehiclePropValuesDelta>* mDeltaStream{nullptr};
         uint64_t mConnectionID{0};
         std::unique_ptr<std::mutex> mMtx;
         std::unique_ptr<std::condition_variable> mCV;
         bool mShutdownFlag{false};
+        // The last full value sent on this delta stream for each [prop, areaId], guarded by
+        // mMtx. The key is (prop << 32) | areaId.
+        std::unordered_map<int64_t, proto::VehiclePropValue> mLastValueByPropIdAreaId;
+
+        // Delta-encodes value against the cached last value and updates the cache. Must be
+        // called with mMtx held.
+        void EncodeDeltaLocked(const proto::VehiclePropValue& value,
+                               proto::VehiclePropValueDelta* delta);
 
         static std::atomic<uint64_t> connection_id_counter_;
     };
@@ -24,9 +24,11 @@
 
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace android::hardware::automotive::vehicle::virtualization {
 
@@ -144,4 +146,63 @@ TEST(GRPCVehicleProxyServerUnitTest, ClientConnectDisconnect) {
     vehicleServer->Shutdown().Wait();
 }
 
+TEST(GRPCVehicleProxyServerUnitTest, DeltaStreamDeliversFullValues) {
+    auto testHardware = std::make_unique<VehicleHardwareForTest>();
+    // HACK: manipulate the underlying hardware via raw pointer for testing.
+    auto* testHardwareRaw = testHardware.get();
+    auto vehicleServer =
+            std::make_unique<GrpcVehicleProxyServer>(kFakeServerAddr, std::move(testHardware));
+    vehicleServer->Start();
+
+    constexpr auto kWaitForConnectionMaxTime = std::chrono::seconds(5);
+    constexpr auto kWaitForStreamStartTime = std::chrono::seconds(1);
+    constexpr auto kWaitForUpdateDeliveryTime = std::chrono::milliseconds(100);
+
+    auto receivedMtx = std::make_shared<std::mutex>();
+    auto receivedValues = std::make_shared<
+            std::vector<aidl::android::hardware::automotive::vehicle::VehiclePropValue>>();
+    auto vehicleHardware = std::make_unique<GRPCVehicleHardware>(kFakeServerAddr);
+    vehicleHardware->registerOnPropertyChangeEvent(
+            std::make_unique<const IVehicleHardware::PropertyChangeCallback>(
+                    [receivedMtx, receivedValues](const auto& values) {
+                        std::lock_guard lck(*receivedMtx);
+                        for (const auto& value : values) {
+                            receivedValues->push_back(value);
+                        }
+                    }));
+    EXPECT_TRUE(vehicleHardware->waitForConnected(kWaitForConnectionMaxTime));
+    std::this_thread::sleep_for(kWaitForStreamStartTime);
+
+    aidl::android::hardware::automotive::vehicle::VehiclePropValue value1{
+            .timestamp = 1000,
+            .areaId = 1,
+            .prop = 1234,
+            .value = {.int32Values = {1, 2}},
+    };
+    // Same payload, only the timestamp advanced, the update is delta-encoded on the wire.
+    aidl::android::hardware::automotive::vehicle::VehiclePropValue value2 = value1;
+    value2.timestamp = 2000;
+    // Changed payload.
+    aidl::android::hardware::automotive::vehicle::VehiclePropValue value3 = value2;
+    value3.timestamp = 3000;
+    value3.value.int32Values = {3, 4};
+
+    testHardwareRaw->onPropertyEvent({value1});
+    testHardwareRaw->onPropertyEvent({value2});
+    testHardwareRaw->onPropertyEvent({value3});
+    // Wait for the update delivery.
+    std::this_thread::sleep_for(kWaitForUpdateDeliveryTime);
+
+    {
+        std::lock_guard lck(*receivedMtx);
+        ASSERT_EQ(receivedValues->size(), 3u);
+        EXPECT_EQ((*receivedValues)[0], value1);
+        EXPECT_EQ((*receivedValues)[1], value2);
+        EXPECT_EQ((*receivedValues)[2], value3);
+    }
+
+    vehicleHardware.reset();
+    vehicleServer->Shutdown().Wait();
+}
+
 }  // namespace android::hardware::automotive::vehicle::virtualization
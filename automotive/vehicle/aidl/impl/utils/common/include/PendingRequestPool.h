@@ -21,6 +21,7 @@
 #include <android-base/result.h>
 #include <android-base/thread_annotations.h>
 
+#include <atomic>
 #include <list>
 #include <mutex>
 #include <thread>
@@ -68,6 +69,10 @@ class PendingRequestPool final {
 
     size_t countPendingRequests() const;
 
+    // Returns the largest number of requests that have been pending at the same time since the
+    // pool was created, for dumping pool occupancy stats.
+    size_t peakPendingRequests() const;
+
   private:
     // The maximum number of pending requests allowed per client. If exceeds this number, adding
     // more requests would fail. This is to prevent spamming from client.
@@ -79,10 +84,23 @@ class PendingRequestPool final {
         std::shared_ptr<const TimeoutCallbackFunc> callback;
     };
 
+    struct ClientRequests {
+        // All requests share the same timeout, so this list is always sorted by timeout
+        // timestamp and expiry only ever pops from the front.
+        std::list<PendingRequest> requests;
+        // Maps each pending request ID to the batch that contains it, so duplicate checks,
+        // isRequestPending and tryFinishRequests are O(1) per ID instead of scanning every
+        // batch.
+        std::unordered_map<int64_t, std::list<PendingRequest>::iterator> batchByRequestId;
+    };
+
     int64_t mTimeoutInNano;
     mutable std::mutex mLock;
-    std::unordered_map<const void*, std::list<PendingRequest>> mPendingRequestsByClient
-            GUARDED_BY(mLock);
+    std::unordered_map<const void*, ClientRequests> mPendingRequestsByClient GUARDED_BY(mLock);
+    // Pool occupancy, maintained outside mLock so stats reads do not contend with the
+    // request path.
+    std::atomic<size_t> mPendingRequestCount{0};
+    std::atomic<size_t> mPeakPendingRequestCount{0};
     std::thread mThread;
     bool mThreadStop = false;
     std::condition_variable mCv;
@@ -19,9 +19,11 @@
 
 #include <android-base/thread_annotations.h>
 
+#include <array>
+#include <condition_variable>
+#include <list>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -32,6 +34,10 @@ namespace automotive {
 namespace vehicle {
 
 // A thread-safe recurrent timer.
+//
+// Callbacks are kept in a hierarchical timing wheel: registering and unregistering a callback
+// is O(1) regardless of how many callbacks are scheduled, and all the callbacks due at the
+// same tick are dispatched in a single wakeup of the timer thread.
 class RecurrentTimer final {
   public:
     // The class for the function that would be called recurrently.
@@ -52,40 +58,56 @@ class RecurrentTimer final {
     // friend class for unit testing.
     friend class RecurrentTimerTest;
 
+    // The tick resolution of the wheel: 1ms. Deadlines are rounded up to a tick when
+    // scheduled, so a callback fires within one tick after its aligned deadline.
+    static constexpr int64_t TICK_IN_NANO = 1'000'000;
+    static constexpr size_t WHEEL_BITS = 6;
+    // Each level has 64 slots. Level 0 slots are one tick apart, so level 0 spans 64ms,
+    // level 1 spans ~4s, level 2 spans ~4.4min and level 3 spans ~4.7h.
+    static constexpr size_t WHEEL_SLOTS = (size_t)1 << WHEEL_BITS;
+    static constexpr size_t WHEEL_LEVELS = 4;
+    static constexpr size_t SLOT_MASK = WHEEL_SLOTS - 1;
+
     struct CallbackInfo {
         std::shared_ptr<Callback> callback;
         int64_t interval;
         int64_t nextTime;
-        // A flag to indicate whether this CallbackInfo is already outdated and should be ignored.
-        // The reason we need this flag is because we cannot easily remove an element from a heap.
-        bool outdated = false;
-
-        static bool cmp(const std::unique_ptr<CallbackInfo>& lhs,
-                        const std::unique_ptr<CallbackInfo>& rhs);
+        // The wheel level and slot currently holding this entry, required for O(1) removal.
+        size_t level;
+        size_t slot;
     };
+    using SlotList = std::list<std::unique_ptr<CallbackInfo>>;
 
     std::mutex mLock;
     std::thread mThread;
     std::condition_variable mCond;
     bool mStopRequested GUARDED_BY(mLock) = false;
-    // A map to map each callback to its current active CallbackInfo in the mCallbackQueue.
-    std::unordered_map<std::shared_ptr<Callback>, CallbackInfo*> mCallbacks GUARDED_BY(mLock);
-    // A min-heap sorted by nextTime. Note that because we cannot remove arbitrary element from the
-    // heap, a single Callback can have multiple entries in this queue, all but one should be valid.
-    // The rest should be mark as outdated. The valid one is one stored in mCallbacks.
-    std::vector<std::unique_ptr<CallbackInfo>> mCallbackQueue GUARDED_BY(mLock);
+    // Set when a registration changed the wheel while the timer thread is sleeping, so that
+    // the thread recomputes its deadline instead of sleeping past a nearer callback.
+    bool mWheelChanged GUARDED_BY(mLock) = false;
+    // The tick the wheel cursor has advanced to.
+    int64_t mCurrentTick GUARDED_BY(mLock) = 0;
+    // The hierarchical timing wheel. As the cursor wraps around a level, the matching slot of
+    // the next level cascades its entries down.
+    std::array<std::array<SlotList, WHEEL_SLOTS>, WHEEL_LEVELS> mWheel GUARDED_BY(mLock);
+    // Maps each callback to its single entry in the wheel. std::list iterators stay valid
+    // across splice, so an entry keeps its iterator while it cascades between slots.
+    std::unordered_map<std::shared_ptr<Callback>, SlotList::iterator> mEntries GUARDED_BY(mLock);
 
     void loop();
 
-    // Mark the callbackInfo as outdated and should be ignored when popped from the heap.
-    void markOutdatedLocked(CallbackInfo* callback) REQUIRES(mLock);
-    // Remove all outdated callbackInfos from the top of the heap. This function must be called
-    // each time we might introduce outdated elements to the top. We must make sure the heap is
-    // always valid from the top.
-    void removeInvalidCallbackLocked() REQUIRES(mLock);
-    // Gets the next calblack to run (must be valid) from the heap, update its nextTime and put
-    // it back to the heap.
-    std::shared_ptr<Callback> getNextCallbackLocked(int64_t now) REQUIRES(mLock);
+    // Moves the entry at 'it' in 'from' into the wheel slot matching its nextTime, but no
+    // earlier than 'minTick'.
+    void insertLocked(SlotList& from, SlotList::iterator it, int64_t minTick) REQUIRES(mLock);
+    // Re-distributes the entries of the given level's current slot into the lower levels.
+    void cascadeLocked(size_t level) REQUIRES(mLock);
+    // Advances the cursor to 'targetTick', collecting every due callback and re-arming its
+    // entry for the next interval.
+    void advanceLocked(int64_t targetTick, int64_t nowInNano,
+                       std::vector<std::shared_ptr<Callback>>* callbacksToRun) REQUIRES(mLock);
+    // Returns the next tick the timer thread has to wake up at, either to run a due callback
+    // or to cascade a higher wheel level.
+    int64_t nextWakeTickLocked() REQUIRES(mLock);
 };
 
 }  // namespace vehicle
@@ -17,10 +17,14 @@
 #ifndef android_hardware_automotive_vehicle_utils_include_VehicleObjectPool_H_
 #define android_hardware_automotive_vehicle_utils_include_VehicleObjectPool_H_
 
+#include <algorithm>
 #include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include <VehicleHalTypes.h>
 
@@ -75,6 +79,15 @@ class ObjectPool {
   public:
     using GetSizeFunc = std::function<size_t(const T&)>;
 
+    // A snapshot of this pool's counters since creation. Unlike the global {@code PoolStats},
+    // these are tracked per pool instance so hit rates can be reported per type and size.
+    struct Stats {
+        uint32_t obtained = 0;
+        uint32_t created = 0;
+        uint32_t recycled = 0;
+        uint32_t deleted = 0;
+    };
+
     ObjectPool(size_t maxPoolObjectsSize, GetSizeFunc getSizeFunc)
         : mMaxPoolObjectsSize(maxPoolObjectsSize), mGetSizeFunc(getSizeFunc){};
     virtual ~ObjectPool() = default;
@@ -82,8 +95,10 @@ class ObjectPool {
     virtual recyclable_ptr<T> obtain() {
         std::scoped_lock<std::mutex> lock(mLock);
         INC_METRIC_IF_DEBUG(Obtained)
+        mStats.obtained++;
         if (mObjects.empty()) {
             INC_METRIC_IF_DEBUG(Created)
+            mStats.created++;
             return wrap(createObject());
         }
 
@@ -93,6 +108,11 @@ class ObjectPool {
         return o;
     }
 
+    Stats getStats() const {
+        std::scoped_lock<std::mutex> lock(mLock);
+        return mStats;
+    }
+
     ObjectPool& operator=(const ObjectPool&) = delete;
     ObjectPool(const ObjectPool&) = delete;
 
@@ -106,6 +126,7 @@ class ObjectPool {
         if (objectSize > mMaxPoolObjectsSize ||
             mPoolObjectsSize > mMaxPoolObjectsSize - objectSize) {
             INC_METRIC_IF_DEBUG(Deleted)
+            mStats.deleted++;
 
             // We have no space left in the pool.
             delete o;
@@ -113,6 +134,7 @@ class ObjectPool {
         }
 
         INC_METRIC_IF_DEBUG(Recycled)
+        mStats.recycled++;
 
         mObjects.push_back(std::unique_ptr<T>{o});
         mPoolObjectsSize += objectSize;
@@ -137,6 +159,7 @@ class ObjectPool {
     std::unique_ptr<Deleter<T>> mDeleter;
     size_t mPoolObjectsSize GUARDED_BY(mLock);
     GetSizeFunc mGetSizeFunc;
+    Stats mStats GUARDED_BY(mLock);
 };
 
 #undef INC_METRIC_IF_DEBUG
@@ -151,9 +174,14 @@ class ObjectPool {
 // the object pool.
 //
 // Some objects are not recyclable: strings and vector data types with vector
-// length > maxRecyclableVectorSize (provided in the constructor). These objects will be deleted
-// immediately once the go out of scope. There's no synchronization penalty for these objects since
-// we do not store them in the pool.
+// length > maxRecyclableVectorSize (provided in the constructor) that do not fit any of the
+// configured size classes. These objects will be deleted immediately once the go out of scope.
+// There's no synchronization penalty for these objects since we do not store them in the pool.
+//
+// Vector values larger than maxRecyclableVectorSize may still be pooled through size classes.
+// A value whose vector size fits a size class is allocated with the class's capacity and resized
+// down to the requested size, so a vendor hardware that sends e.g. 64-byte BYTES payloads at a
+// high rate can pool them instead of allocating on every event.
 //
 // This class is thread-safe. Users can obtain an object in one thread and pass it to another.
 //
@@ -180,9 +208,17 @@ class VehiclePropValuePool {
     // @param maxPoolObjectsSize - The approximate upper bound of memory each internal recycling
     // pool could take. We have 4 different type pools, each with 4 different vector size, so
     // approximately this pool would at-most take 4 * 4 * 10240 = 160k memory.
-    VehiclePropValuePool(size_t maxRecyclableVectorSize = 4, size_t maxPoolObjectsSize = 10240)
+    // @param vectorSizeClasses - Optional vector size classes for pooling vector values larger
+    // than maxRecyclableVectorSize. A value whose vector size is larger than
+    // maxRecyclableVectorSize is pooled under the smallest size class that fits it, or deleted
+    // when it goes out of scope if no class fits. Classes not larger than maxRecyclableVectorSize
+    // are ignored since those sizes already have exact pools.
+    VehiclePropValuePool(size_t maxRecyclableVectorSize = 4, size_t maxPoolObjectsSize = 10240,
+                         std::vector<size_t> vectorSizeClasses = {})
         : mMaxRecyclableVectorSize(maxRecyclableVectorSize),
-          mMaxPoolObjectsSize(maxPoolObjectsSize){};
+          mMaxPoolObjectsSize(maxPoolObjectsSize),
+          mVectorSizeClasses(filterSizeClasses(std::move(vectorSizeClasses),
+                                               maxRecyclableVectorSize)){};
 
     // Obtain a recyclable VehiclePropertyValue object from the pool for the given type. If the
     // given type is not MIXED or STRING, the internal value vector size would be set to 1.
@@ -215,6 +251,9 @@ class VehiclePropValuePool {
     // Obtain a recyclable mixed object.
     RecyclableType obtainComplex();
 
+    // Dumps the per-pool obtain/recycle counters and hit rates in text format for debugging.
+    std::string dump() const;
+
     VehiclePropValuePool(VehiclePropValuePool&) = delete;
     VehiclePropValuePool& operator=(VehiclePropValuePool&) = delete;
 
@@ -235,7 +274,29 @@ class VehiclePropValuePool {
 
     bool isDisposable(aidl::android::hardware::automotive::vehicle::VehiclePropertyType type,
                       size_t vectorSize) const {
-        return vectorSize > mMaxRecyclableVectorSize || isComplexType(type);
+        return (vectorSize > mMaxRecyclableVectorSize && !sizeClassFor(vectorSize).has_value()) ||
+               isComplexType(type);
+    }
+
+    // Returns the smallest configured size class that fits vectorSize, or std::nullopt if none
+    // does.
+    std::optional<size_t> sizeClassFor(size_t vectorSize) const {
+        auto it = std::lower_bound(mVectorSizeClasses.begin(), mVectorSizeClasses.end(),
+                                   vectorSize);
+        if (it == mVectorSizeClasses.end()) {
+            return std::nullopt;
+        }
+        return *it;
+    }
+
+    static std::vector<size_t> filterSizeClasses(std::vector<size_t> sizeClasses,
+                                                 size_t maxRecyclableVectorSize) {
+        std::sort(sizeClasses.begin(), sizeClasses.end());
+        sizeClasses.erase(sizeClasses.begin(),
+                          std::upper_bound(sizeClasses.begin(), sizeClasses.end(),
+                                           maxRecyclableVectorSize));
+        sizeClasses.erase(std::unique(sizeClasses.begin(), sizeClasses.end()), sizeClasses.end());
+        return sizeClasses;
     }
 
     RecyclableType obtainDisposable(
@@ -243,17 +304,23 @@ class VehiclePropValuePool {
             size_t vectorSize) const;
     RecyclableType obtainRecyclable(
             aidl::android::hardware::automotive::vehicle::VehiclePropertyType type,
-            size_t vectorSize);
+            size_t vectorSize, bool isSizeClassPool);
 
     class InternalPool
         : public ObjectPool<aidl::android::hardware::automotive::vehicle::VehiclePropValue> {
       public:
         InternalPool(aidl::android::hardware::automotive::vehicle::VehiclePropertyType type,
                      size_t vectorSize, size_t maxPoolObjectsSize,
-                     ObjectPool::GetSizeFunc getSizeFunc)
+                     ObjectPool::GetSizeFunc getSizeFunc, bool isSizeClassPool)
             : ObjectPool(maxPoolObjectsSize, getSizeFunc),
               mPropType(type),
-              mVectorSize(vectorSize) {}
+              mVectorSize(vectorSize),
+              mIsSizeClassPool(isSizeClassPool) {}
+
+        aidl::android::hardware::automotive::vehicle::VehiclePropertyType getPropType() const {
+            return mPropType;
+        }
+        size_t getVectorSize() const { return mVectorSize; }
 
       protected:
         aidl::android::hardware::automotive::vehicle::VehiclePropValue* createObject() override;
@@ -270,6 +337,9 @@ class VehiclePropValuePool {
       private:
         aidl::android::hardware::automotive::vehicle::VehiclePropertyType mPropType;
         size_t mVectorSize;
+        // A size-class pool hands out values resized below mVectorSize, so recycle restores the
+        // vector to mVectorSize instead of requiring an exact size match.
+        bool mIsSizeClassPool;
     };
     const Deleter<aidl::android::hardware::automotive::vehicle::VehiclePropValue>
             mDisposableDeleter{
@@ -280,6 +350,9 @@ class VehiclePropValuePool {
     mutable std::mutex mLock;
     const size_t mMaxRecyclableVectorSize;
     const size_t mMaxPoolObjectsSize;
+    // Sorted ascending, only contains classes larger than mMaxRecyclableVectorSize. Const after
+    // construction so sizeClassFor does not need mLock.
+    const std::vector<size_t> mVectorSizeClasses;
     // A map with 'property_type' | 'value_vector_size' as key and a recyclable object pool as
     // value. We would create a recyclable pool for each property type and vector size combination.
     std::map<int32_t, std::unique_ptr<InternalPool>> mValueTypePools GUARDED_BY(mLock);
@@ -22,6 +22,8 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <VehicleHalTypes.h>
 #include <VehicleObjectPool.h>
@@ -45,6 +47,8 @@ class VehiclePropertyStore final {
   public:
     using ValueResultType = VhalResult<VehiclePropValuePool::RecyclableType>;
     using ValuesResultType = VhalResult<std::vector<VehiclePropValuePool::RecyclableType>>;
+    using PropertySnapshotType = std::shared_ptr<
+            const std::vector<aidl::android::hardware::automotive::vehicle::VehiclePropValue>>;
 
     enum class EventMode : uint8_t {
         /**
@@ -118,6 +122,15 @@ class VehiclePropertyStore final {
     // Read all the values for the property.
     ValuesResultType readValuesForProperty(int32_t propId) const;
 
+    // Read all the values for the property as an immutable shared snapshot.
+    //
+    // The first read after a write rebuilds and publishes the snapshot; until the next write,
+    // repeated reads return the same published snapshot without taking the store lock or
+    // copying any value, so a high-frequency poller does not serialize against writers. The
+    // returned vector never changes after it is published, the caller may keep it for as long
+    // as needed.
+    VhalResult<PropertySnapshotType> readValuesForPropertySnapshot(int32_t propId) const;
+
     // Read the value for the requested property. Returns {@code StatusCode::NOT_AVAILABLE} if the
     // value has not been set yet. Returns {@code StatusCode::INVALID_ARG} if the property is
     // not configured.
@@ -168,6 +181,17 @@ class VehiclePropertyStore final {
     mutable std::mutex mLock;
     std::unordered_map<int32_t, Record> mRecordsByPropId GUARDED_BY(mLock);
     OnValueChangeCallback mOnValueChangeCallback GUARDED_BY(mLock);
+    // Monotonically increasing count of store mutations, used to detect a write racing with a
+    // snapshot rebuild.
+    int64_t mModCount GUARDED_BY(mLock) = 0;
+    // Guards the published per-property snapshots. Acquired after mLock when both are needed.
+    // The snapshot fast path only takes this lock, so reading an up-to-date snapshot never
+    // contends with a writer holding mLock.
+    mutable std::mutex mSnapshotLock;
+    // Maps property ID to {the mModCount the snapshot was built at, the snapshot}. A nullptr
+    // snapshot is a tombstone left by a writer to invalidate the previous version.
+    mutable std::unordered_map<int32_t, std::pair<int64_t, PropertySnapshotType>>
+            mSnapshotByPropId GUARDED_BY(mSnapshotLock);
 
     const Record* getRecordLocked(int32_t propId) const;
 
@@ -178,6 +202,8 @@ class VehiclePropertyStore final {
             const Record& record) const;
 
     ValueResultType readValueLocked(const RecordId& recId, const Record& record) const;
+
+    void invalidateSnapshotLocked(int32_t propId);
 };
 
 }  // namespace vehicle
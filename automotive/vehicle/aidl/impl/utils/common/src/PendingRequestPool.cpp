@@ -22,6 +22,7 @@
 #include <utils/Log.h>
 #include <utils/SystemClock.h>
 
+#include <iterator>
 #include <vector>
 
 namespace android {
@@ -69,12 +70,13 @@ PendingRequestPool::~PendingRequestPool() {
     {
         std::scoped_lock<std::mutex> lockGuard(mLock);
 
-        for (auto& [_, pendingRequests] : mPendingRequestsByClient) {
-            for (const auto& request : pendingRequests) {
+        for (auto& [_, clientRequests] : mPendingRequestsByClient) {
+            for (const auto& request : clientRequests.requests) {
                 (*request.callback)(request.requestIds);
             }
         }
         mPendingRequestsByClient.clear();
+        mPendingRequestCount.store(0, std::memory_order_relaxed);
     }
 }
 
@@ -82,37 +84,38 @@ VhalResult<void> PendingRequestPool::addRequests(
         const void* clientId, const std::unordered_set<int64_t>& requestIds,
         std::shared_ptr<const TimeoutCallbackFunc> callback) {
     std::scoped_lock<std::mutex> lockGuard(mLock);
-    std::list<PendingRequest>* pendingRequests;
-    size_t pendingRequestCount = 0;
-    if (mPendingRequestsByClient.find(clientId) != mPendingRequestsByClient.end()) {
-        pendingRequests = &mPendingRequestsByClient[clientId];
-        for (const auto& pendingRequest : *pendingRequests) {
-            const auto& pendingRequestIds = pendingRequest.requestIds;
-            for (int64_t requestId : requestIds) {
-                if (pendingRequestIds.find(requestId) != pendingRequestIds.end()) {
-                    return StatusError(StatusCode::INVALID_ARG)
-                           << "duplicate request ID: " << requestId;
-                }
-            }
-            pendingRequestCount += pendingRequestIds.size();
+    ClientRequests& clientRequests = mPendingRequestsByClient[clientId];
+    for (int64_t requestId : requestIds) {
+        if (clientRequests.batchByRequestId.find(requestId) !=
+            clientRequests.batchByRequestId.end()) {
+            return StatusError(StatusCode::INVALID_ARG) << "duplicate request ID: " << requestId;
         }
-    } else {
-        // Create a new empty list for this client.
-        pendingRequests = &mPendingRequestsByClient[clientId];
     }
 
-    if (requestIds.size() > MAX_PENDING_REQUEST_PER_CLIENT - pendingRequestCount) {
+    if (requestIds.size() >
+        MAX_PENDING_REQUEST_PER_CLIENT - clientRequests.batchByRequestId.size()) {
         return StatusError(StatusCode::TRY_AGAIN) << "too many pending requests";
     }
 
     int64_t currentTime = elapsedRealtimeNano();
     int64_t timeoutTimestamp = currentTime + mTimeoutInNano;
 
-    pendingRequests->push_back({
+    clientRequests.requests.push_back({
             .requestIds = std::unordered_set<int64_t>(requestIds.begin(), requestIds.end()),
             .timeoutTimestamp = timeoutTimestamp,
             .callback = callback,
     });
+    auto batchIt = std::prev(clientRequests.requests.end());
+    for (int64_t requestId : requestIds) {
+        clientRequests.batchByRequestId.emplace(requestId, batchIt);
+    }
+
+    size_t count = mPendingRequestCount.fetch_add(requestIds.size(), std::memory_order_relaxed) +
+                   requestIds.size();
+    size_t peak = mPeakPendingRequestCount.load(std::memory_order_relaxed);
+    while (count > peak && !mPeakPendingRequestCount.compare_exchange_weak(
+                                   peak, count, std::memory_order_relaxed)) {
+    }
 
     return {};
 }
@@ -124,15 +127,7 @@ bool PendingRequestPool::isRequestPending(const void* clientId, int64_t requestI
 }
 
 size_t PendingRequestPool::countPendingRequests() const {
-    std::scoped_lock<std::mutex> lockGuard(mLock);
-
-    size_t count = 0;
-    for (const auto& [clientId, requests] : mPendingRequestsByClient) {
-        for (const auto& request : requests) {
-            count += request.requestIds.size();
-        }
-    }
-    return count;
+    return mPendingRequestCount.load(std::memory_order_relaxed);
 }
 
 size_t PendingRequestPool::countPendingRequests(const void* clientId) const {
@@ -143,12 +138,11 @@ size_t PendingRequestPool::countPendingRequests(const void* clientId) const {
         return 0;
     }
 
-    size_t count = 0;
-    for (const auto& pendingRequest : it->second) {
-        count += pendingRequest.requestIds.size();
-    }
+    return it->second.batchByRequestId.size();
+}
 
-    return count;
+size_t PendingRequestPool::peakPendingRequests() const {
+    return mPeakPendingRequestCount.load(std::memory_order_relaxed);
 }
 
 bool PendingRequestPool::isRequestPendingLocked(const void* clientId, int64_t requestId) const {
@@ -156,13 +150,8 @@ bool PendingRequestPool::isRequestPendingLocked(const void* clientId, int64_t re
     if (it == mPendingRequestsByClient.end()) {
         return false;
     }
-    for (const auto& pendingRequest : it->second) {
-        const auto& requestIds = pendingRequest.requestIds;
-        if (requestIds.find(requestId) != requestIds.end()) {
-            return true;
-        }
-    }
-    return false;
+    const auto& batchByRequestId = it->second.batchByRequestId;
+    return batchByRequestId.find(requestId) != batchByRequestId.end();
 }
 
 void PendingRequestPool::checkTimeout() {
@@ -172,19 +161,26 @@ void PendingRequestPool::checkTimeout() {
 
         int64_t currentTime = elapsedRealtimeNano();
 
+        size_t timeoutCount = 0;
         std::vector<const void*> clientsWithEmptyRequests;
 
-        for (auto& [clientId, pendingRequests] : mPendingRequestsByClient) {
-            auto it = pendingRequests.begin();
-            while (it != pendingRequests.end()) {
+        for (auto& [clientId, clientRequests] : mPendingRequestsByClient) {
+            // The per-client list is in timeout order, so expiry stops at the first batch
+            // that has not timed out yet.
+            auto it = clientRequests.requests.begin();
+            while (it != clientRequests.requests.end()) {
                 if (it->timeoutTimestamp >= currentTime) {
                     break;
                 }
+                for (int64_t requestId : it->requestIds) {
+                    clientRequests.batchByRequestId.erase(requestId);
+                }
+                timeoutCount += it->requestIds.size();
                 timeoutRequests.push_back(std::move(*it));
-                it = pendingRequests.erase(it);
+                it = clientRequests.requests.erase(it);
             }
 
-            if (pendingRequests.empty()) {
+            if (clientRequests.requests.empty()) {
                 clientsWithEmptyRequests.push_back(clientId);
             }
         }
@@ -192,6 +188,10 @@ void PendingRequestPool::checkTimeout() {
         for (const void* clientId : clientsWithEmptyRequests) {
             mPendingRequestsByClient.erase(clientId);
         }
+
+        if (timeoutCount != 0) {
+            mPendingRequestCount.fetch_sub(timeoutCount, std::memory_order_relaxed);
+        }
     }
 
     // Call the callback outside the lock.
@@ -206,27 +206,28 @@ std::unordered_set<int64_t> PendingRequestPool::tryFinishRequests(
 
     std::unordered_set<int64_t> foundIds;
 
-    if (mPendingRequestsByClient.find(clientId) == mPendingRequestsByClient.end()) {
+    auto clientIt = mPendingRequestsByClient.find(clientId);
+    if (clientIt == mPendingRequestsByClient.end()) {
         return foundIds;
     }
 
-    auto& pendingRequests = mPendingRequestsByClient[clientId];
-    auto it = pendingRequests.begin();
-    while (it != pendingRequests.end()) {
-        auto& pendingRequestIds = it->requestIds;
-        for (int64_t requestId : requestIds) {
-            auto idIt = pendingRequestIds.find(requestId);
-            if (idIt == pendingRequestIds.end()) {
-                continue;
-            }
-            pendingRequestIds.erase(idIt);
-            foundIds.insert(requestId);
-        }
-        if (pendingRequestIds.empty()) {
-            it = pendingRequests.erase(it);
+    auto& clientRequests = clientIt->second;
+    for (int64_t requestId : requestIds) {
+        auto idIt = clientRequests.batchByRequestId.find(requestId);
+        if (idIt == clientRequests.batchByRequestId.end()) {
             continue;
         }
-        it++;
+        auto batchIt = idIt->second;
+        batchIt->requestIds.erase(requestId);
+        if (batchIt->requestIds.empty()) {
+            clientRequests.requests.erase(batchIt);
+        }
+        clientRequests.batchByRequestId.erase(idIt);
+        foundIds.insert(requestId);
+    }
+
+    if (!foundIds.empty()) {
+        mPendingRequestCount.fetch_sub(foundIds.size(), std::memory_order_relaxed);
     }
 
     return foundIds;
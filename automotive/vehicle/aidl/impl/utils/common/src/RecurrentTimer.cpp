@@ -30,6 +30,10 @@ namespace vehicle {
 using ::android::base::ScopedLockAssertion;
 
 RecurrentTimer::RecurrentTimer() {
+    {
+        std::scoped_lock<std::mutex> lockGuard(mLock);
+        mCurrentTick = uptimeNanos() / TICK_IN_NANO;
+    }
     mThread = std::thread(&RecurrentTimer::loop, this);
 }
 
@@ -52,22 +56,29 @@ void RecurrentTimer::registerTimerCallback(int64_t intervalInNano,
         // Aligns the nextTime to multiply of interval.
         int64_t nextTime = ceil(uptimeNanos() / intervalInNano) * intervalInNano;
 
+        if (auto it = mEntries.find(callback); it != mEntries.end()) {
+            auto entryIt = it->second;
+            ALOGI("Replacing an existing timer callback with a new interval, current: %" PRId64
+                  " ns, new: %" PRId64 " ns",
+                  (*entryIt)->interval, intervalInNano);
+            mWheel[(*entryIt)->level][(*entryIt)->slot].erase(entryIt);
+            mEntries.erase(it);
+        }
+
         std::unique_ptr<CallbackInfo> info = std::make_unique<CallbackInfo>();
         info->callback = callback;
         info->interval = intervalInNano;
         info->nextTime = nextTime;
 
-        auto it = mCallbacks.find(callback);
-        if (it != mCallbacks.end()) {
-            ALOGI("Replacing an existing timer callback with a new interval, current: %" PRId64
-                  " ns, new: %" PRId64 " ns",
-                  it->second->interval, intervalInNano);
-            markOutdatedLocked(it->second);
-        }
-        mCallbacks[callback] = info.get();
-        mCallbackQueue.push_back(std::move(info));
-        // Insert the last element into the heap.
-        std::push_heap(mCallbackQueue.begin(), mCallbackQueue.end(), CallbackInfo::cmp);
+        // Stage the entry in a temporary list so insertLocked can splice it into its slot.
+        SlotList staging;
+        staging.push_back(std::move(info));
+        auto entryIt = staging.begin();
+        // The cursor already passed the current tick's slot, schedule for the next tick at the
+        // earliest.
+        insertLocked(staging, entryIt, mCurrentTick + 1);
+        mEntries[callback] = entryIt;
+        mWheelChanged = true;
     }
     mCond.notify_one();
 }
@@ -76,46 +87,101 @@ void RecurrentTimer::unregisterTimerCallback(std::shared_ptr<RecurrentTimer::Cal
     {
         std::scoped_lock<std::mutex> lockGuard(mLock);
 
-        auto it = mCallbacks.find(callback);
-        if (it == mCallbacks.end()) {
+        auto it = mEntries.find(callback);
+        if (it == mEntries.end()) {
             ALOGE("No event found to unregister");
             return;
         }
 
-        markOutdatedLocked(it->second);
-        mCallbacks.erase(it);
+        auto entryIt = it->second;
+        mWheel[(*entryIt)->level][(*entryIt)->slot].erase(entryIt);
+        mEntries.erase(it);
     }
 
     mCond.notify_one();
 }
 
-void RecurrentTimer::markOutdatedLocked(RecurrentTimer::CallbackInfo* info) {
-    info->outdated = true;
-    info->callback = nullptr;
-    // Make sure the first element is always valid.
-    removeInvalidCallbackLocked();
+void RecurrentTimer::insertLocked(SlotList& from, SlotList::iterator it, int64_t minTick)
+        REQUIRES(mLock) {
+    CallbackInfo* info = it->get();
+    // Rounds up so the callback never fires before its deadline, otherwise it could not be
+    // re-armed past now.
+    int64_t expiryTick = (info->nextTime + TICK_IN_NANO - 1) / TICK_IN_NANO;
+    if (expiryTick < minTick) {
+        expiryTick = minTick;
+    }
+    int64_t delta = expiryTick - mCurrentTick;
+
+    size_t level = 0;
+    int64_t span = WHEEL_SLOTS;
+    while (level < WHEEL_LEVELS - 1 && delta >= span) {
+        level++;
+        span <<= WHEEL_BITS;
+    }
+    size_t slot = (expiryTick >> (WHEEL_BITS * level)) & SLOT_MASK;
+
+    info->level = level;
+    info->slot = slot;
+    SlotList& target = mWheel[level][slot];
+    target.splice(target.end(), from, it);
 }
 
-void RecurrentTimer::removeInvalidCallbackLocked() {
-    while (mCallbackQueue.size() != 0 && mCallbackQueue[0]->outdated) {
-        std::pop_heap(mCallbackQueue.begin(), mCallbackQueue.end(), CallbackInfo::cmp);
-        mCallbackQueue.pop_back();
+void RecurrentTimer::cascadeLocked(size_t level) REQUIRES(mLock) {
+    if (level >= WHEEL_LEVELS) {
+        return;
+    }
+    size_t slot = (mCurrentTick >> (WHEEL_BITS * level)) & SLOT_MASK;
+    if (slot == 0) {
+        // This level wrapped around as well, cascade the next level first.
+        cascadeLocked(level + 1);
+    }
+    // Move the slot aside first: an entry scheduled for a later round of this level would be
+    // spliced right back into the same slot.
+    SlotList pending;
+    pending.splice(pending.begin(), mWheel[level][slot]);
+    while (!pending.empty()) {
+        insertLocked(pending, pending.begin(), mCurrentTick);
     }
 }
 
-std::shared_ptr<RecurrentTimer::Callback> RecurrentTimer::getNextCallbackLocked(int64_t now) {
-    std::pop_heap(mCallbackQueue.begin(), mCallbackQueue.end(), CallbackInfo::cmp);
-    auto& callbackInfo = mCallbackQueue[mCallbackQueue.size() - 1];
-    auto nextCallback = callbackInfo->callback;
-    // intervalCount is the number of interval we have to advance until we pass now.
-    size_t intervalCount = (now - callbackInfo->nextTime) / callbackInfo->interval + 1;
-    callbackInfo->nextTime += intervalCount * callbackInfo->interval;
-    std::push_heap(mCallbackQueue.begin(), mCallbackQueue.end(), CallbackInfo::cmp);
+void RecurrentTimer::advanceLocked(int64_t targetTick, int64_t nowInNano,
+                                   std::vector<std::shared_ptr<Callback>>* callbacksToRun)
+        REQUIRES(mLock) {
+    while (mCurrentTick < targetTick) {
+        mCurrentTick++;
+        size_t slot = mCurrentTick & SLOT_MASK;
+        if (slot == 0) {
+            cascadeLocked(1);
+        }
 
-    // Make sure the first element is always valid.
-    removeInvalidCallbackLocked();
+        // Every entry in a level 0 slot is due when the cursor reaches the slot.
+        SlotList expired;
+        expired.splice(expired.begin(), mWheel[0][slot]);
+        while (!expired.empty()) {
+            auto it = expired.begin();
+            CallbackInfo* info = it->get();
+            callbacksToRun->push_back(info->callback);
+
+            // intervalCount is the number of interval we have to advance until we pass now.
+            if (info->nextTime <= nowInNano) {
+                int64_t intervalCount = (nowInNano - info->nextTime) / info->interval + 1;
+                info->nextTime += intervalCount * info->interval;
+            }
+            insertLocked(expired, it, mCurrentTick + 1);
+        }
+    }
+}
 
-    return nextCallback;
+int64_t RecurrentTimer::nextWakeTickLocked() REQUIRES(mLock) {
+    for (int64_t i = 1; i < static_cast<int64_t>(WHEEL_SLOTS); i++) {
+        if (!mWheel[0][(mCurrentTick + i) & SLOT_MASK].empty()) {
+            return mCurrentTick + i;
+        }
+    }
+    // Nothing is due within the level 0 window, so the nearest interesting point is the next
+    // wrap-around, where the higher levels cascade down. Waking up at a boundary with nothing
+    // to cascade is harmless, the loop simply computes the next deadline again.
+    return ((mCurrentTick >> WHEEL_BITS) + 1) << WHEEL_BITS;
 }
 
 void RecurrentTimer::loop() {
@@ -127,41 +193,35 @@ void RecurrentTimer::loop() {
             // Wait until the timer exits or we have at least one recurrent callback.
             mCond.wait(uniqueLock, [this] {
                 ScopedLockAssertion lockAssertion(mLock);
-                return mStopRequested || mCallbackQueue.size() != 0;
+                return mStopRequested || !mEntries.empty();
             });
 
-            int64_t interval;
             if (mStopRequested) {
                 return;
             }
-            // The first element is the nearest next event.
-            int64_t nextTime = mCallbackQueue[0]->nextTime;
-            int64_t now = uptimeNanos();
 
-            if (nextTime > now) {
-                interval = nextTime - now;
-            } else {
-                interval = 0;
-            }
+            mWheelChanged = false;
+            int64_t wakeTime = nextWakeTickLocked() * TICK_IN_NANO;
+            int64_t now = uptimeNanos();
 
-            // Wait for the next event or the timer exits.
-            if (mCond.wait_for(uniqueLock, std::chrono::nanoseconds(interval), [this] {
-                    ScopedLockAssertion lockAssertion(mLock);
-                    return mStopRequested;
-                })) {
-                return;
+            if (wakeTime > now) {
+                // Wait for the next tick with a due callback, the timer exiting, or a
+                // registration that might publish a nearer deadline.
+                if (mCond.wait_for(uniqueLock, std::chrono::nanoseconds(wakeTime - now), [this] {
+                        ScopedLockAssertion lockAssertion(mLock);
+                        return mStopRequested || mWheelChanged;
+                    })) {
+                    if (mStopRequested) {
+                        return;
+                    }
+                    // The wheel changed, compute the next deadline again.
+                    continue;
+                }
             }
 
             now = uptimeNanos();
             callbacksToRun.clear();
-            while (mCallbackQueue.size() > 0) {
-                int64_t nextTime = mCallbackQueue[0]->nextTime;
-                if (nextTime > now) {
-                    break;
-                }
-
-                callbacksToRun.push_back(getNextCallbackLocked(now));
-            }
+            advanceLocked(now / TICK_IN_NANO, now, &callbacksToRun);
         }
 
         // Do not execute the callback while holding the lock.
@@ -171,11 +231,6 @@ void RecurrentTimer::loop() {
     }
 }
 
-bool RecurrentTimer::CallbackInfo::cmp(const std::unique_ptr<RecurrentTimer::CallbackInfo>& lhs,
-                                       const std::unique_ptr<RecurrentTimer::CallbackInfo>& rhs) {
-    return lhs->nextTime > rhs->nextTime;
-}
-
 }  // namespace vehicle
 }  // namespace automotive
 }  // namespace hardware
@@ -20,6 +20,8 @@
 
 #include <VehicleUtils.h>
 
+#include <android-base/stringprintf.h>
+
 #include <assert.h>
 #include <utils/Log.h>
 
@@ -32,6 +34,38 @@ using ::aidl::android::hardware::automotive::vehicle::RawPropValues;
 using ::aidl::android::hardware::automotive::vehicle::VehicleProperty;
 using ::aidl::android::hardware::automotive::vehicle::VehiclePropertyType;
 using ::aidl::android::hardware::automotive::vehicle::VehiclePropValue;
+using ::android::base::StringPrintf;
+
+namespace {
+
+// Resizes the value vector for the given type. Shrinking a vector or growing it back within its
+// original capacity does not allocate, which is what makes handing out size-class values with a
+// smaller requested size cheap.
+void resizeRawValueVector(RawPropValues* v, VehiclePropertyType type, size_t vectorSize) {
+    switch (type) {
+        case VehiclePropertyType::BOOLEAN:
+        case VehiclePropertyType::INT32:
+        case VehiclePropertyType::INT32_VEC:
+            v->int32Values.resize(vectorSize);
+            break;
+        case VehiclePropertyType::FLOAT:
+        case VehiclePropertyType::FLOAT_VEC:
+            v->floatValues.resize(vectorSize);
+            break;
+        case VehiclePropertyType::INT64:
+        case VehiclePropertyType::INT64_VEC:
+            v->int64Values.resize(vectorSize);
+            break;
+        case VehiclePropertyType::BYTES:
+            v->byteValues.resize(vectorSize);
+            break;
+        default:
+            ALOGE("resizeRawValueVector: unknown type: %d", toInt(type));
+            break;
+    }
+}
+
+}  // namespace
 
 VehiclePropValuePool::RecyclableType VehiclePropValuePool::obtain(VehiclePropertyType type) {
     if (isComplexType(type)) {
@@ -47,8 +81,16 @@ VehiclePropValuePool::RecyclableType VehiclePropValuePool::obtain(VehiclePropert
     } else if (isComplexType(type)) {
         vectorSize = 0;
     }
-    return isDisposable(type, vectorSize) ? obtainDisposable(type, vectorSize)
-                                          : obtainRecyclable(type, vectorSize);
+    if (isDisposable(type, vectorSize)) {
+        return obtainDisposable(type, vectorSize);
+    }
+    if (vectorSize > mMaxRecyclableVectorSize) {
+        // Pool the value under its size class and shrink the vector to the requested size.
+        auto value = obtainRecyclable(type, *sizeClassFor(vectorSize), /*isSizeClassPool=*/true);
+        resizeRawValueVector(&value->value, type, vectorSize);
+        return value;
+    }
+    return obtainRecyclable(type, vectorSize, /*isSizeClassPool=*/false);
 }
 
 VehiclePropValuePool::RecyclableType VehiclePropValuePool::obtain(const VehiclePropValue& src) {
@@ -102,7 +144,7 @@ VehiclePropValuePool::RecyclableType VehiclePropValuePool::obtainComplex() {
 }
 
 VehiclePropValuePool::RecyclableType VehiclePropValuePool::obtainRecyclable(
-        VehiclePropertyType type, size_t vectorSize) {
+        VehiclePropertyType type, size_t vectorSize, bool isSizeClassPool) {
     std::scoped_lock<std::mutex> lock(mLock);
     assert(vectorSize > 0);
 
@@ -112,12 +154,31 @@ VehiclePropValuePool::RecyclableType VehiclePropValuePool::obtainRecyclable(
 
     if (it == mValueTypePools.end()) {
         auto newPool(std::make_unique<InternalPool>(type, vectorSize, mMaxPoolObjectsSize,
-                                                    getVehiclePropValueSize));
+                                                    getVehiclePropValueSize, isSizeClassPool));
         it = mValueTypePools.emplace(key, std::move(newPool)).first;
     }
     return it->second->obtain();
 }
 
+std::string VehiclePropValuePool::dump() const {
+    std::scoped_lock<std::mutex> lock(mLock);
+    std::string result = StringPrintf(
+            "Vehicle Property Value Pool: maxRecyclableVectorSize: %zu, maxPoolObjectsSize: %zu\n",
+            mMaxRecyclableVectorSize, mMaxPoolObjectsSize);
+    for (const auto& [_, pool] : mValueTypePools) {
+        auto stats = pool->getStats();
+        // An obtain that did not create a new object was served from the pool.
+        uint32_t hits = stats.obtained - stats.created;
+        float hitRate = stats.obtained == 0 ? 0.f : 100.f * hits / stats.obtained;
+        result += StringPrintf(
+                "type: 0x%x, vectorSize: %zu, obtained: %u, created: %u, hitRate: %.1f%%, "
+                "recycled: %u, deleted: %u\n",
+                toInt(pool->getPropType()), pool->getVectorSize(), stats.obtained, stats.created,
+                hitRate, stats.recycled, stats.deleted);
+    }
+    return result;
+}
+
 VehiclePropValuePool::RecyclableType VehiclePropValuePool::obtainBoolean(bool value) {
     return obtainInt32(value);
 }
@@ -134,6 +195,12 @@ void VehiclePropValuePool::InternalPool::recycle(VehiclePropValue* o) {
         return;
     }
 
+    if (mIsSizeClassPool) {
+        // The value was handed out resized below the size class, restore the class size so the
+        // consistency check below can stay an exact size match.
+        resizeRawValueVector(&o->value, mPropType, mVectorSize);
+    }
+
     if (!check(&o->value)) {
         ALOGE("Discarding value for prop 0x%x because it contains "
               "data that is not consistent with this pool. "
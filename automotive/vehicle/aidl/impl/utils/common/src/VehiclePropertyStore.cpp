@@ -95,6 +95,14 @@ VhalResult<VehiclePropValuePool::RecyclableType> VehiclePropertyStore::readValue
            << "Record ID: " << recId.toString() << " is not found";
 }
 
+void VehiclePropertyStore::invalidateSnapshotLocked(int32_t propId) REQUIRES(mLock) {
+    mModCount++;
+    std::scoped_lock<std::mutex> g(mSnapshotLock);
+    // Leave a tombstone carrying the new version so that a reader that copied the store before
+    // this mutation would not publish its now stale snapshot.
+    mSnapshotByPropId[propId] = {mModCount, nullptr};
+}
+
 void VehiclePropertyStore::registerProperty(const VehiclePropConfig& config,
                                             VehiclePropertyStore::TokenFunction tokenFunc) {
     std::scoped_lock<std::mutex> g(mLock);
@@ -103,6 +111,7 @@ void VehiclePropertyStore::registerProperty(const VehiclePropConfig& config,
             .propConfig = config,
             .tokenFunction = tokenFunc,
     };
+    invalidateSnapshotLocked(config.prop);
 }
 
 VhalResult<void> VehiclePropertyStore::writeValue(VehiclePropValuePool::RecyclableType propValue,
@@ -146,6 +155,7 @@ VhalResult<void> VehiclePropertyStore::writeValue(VehiclePropValuePool::Recyclab
     }
 
     record->values[recId] = std::move(propValue);
+    invalidateSnapshotLocked(propId);
 
     if (eventMode == EventMode::NEVER) {
         return {};
@@ -168,6 +178,7 @@ void VehiclePropertyStore::removeValue(const VehiclePropValue& propValue) {
     VehiclePropertyStore::RecordId recId = getRecordIdLocked(propValue, *record);
     if (auto it = record->values.find(recId); it != record->values.end()) {
         record->values.erase(it);
+        invalidateSnapshotLocked(propValue.prop);
     }
 }
 
@@ -180,6 +191,7 @@ void VehiclePropertyStore::removeValuesForProperty(int32_t propId) {
     }
 
     record->values.clear();
+    invalidateSnapshotLocked(propId);
 }
 
 std::vector<VehiclePropValuePool::RecyclableType> VehiclePropertyStore::readAllValues() const {
@@ -213,6 +225,48 @@ VehiclePropertyStore::ValuesResultType VehiclePropertyStore::readValuesForProper
     return values;
 }
 
+VhalResult<VehiclePropertyStore::PropertySnapshotType>
+VehiclePropertyStore::readValuesForPropertySnapshot(int32_t propId) const {
+    {
+        std::scoped_lock<std::mutex> g(mSnapshotLock);
+        if (auto it = mSnapshotByPropId.find(propId);
+            it != mSnapshotByPropId.end() && it->second.second != nullptr) {
+            return it->second.second;
+        }
+    }
+
+    // No up-to-date snapshot is published, rebuild one from the store.
+    auto snapshot = std::make_shared<std::vector<VehiclePropValue>>();
+    int64_t version;
+    {
+        std::scoped_lock<std::mutex> g(mLock);
+
+        const VehiclePropertyStore::Record* record = getRecordLocked(propId);
+        if (record == nullptr) {
+            return StatusError(StatusCode::INVALID_ARG)
+                   << "property: " << propId << " not registered";
+        }
+
+        version = mModCount;
+        snapshot->reserve(record->values.size());
+        for (auto const& [_, value] : record->values) {
+            snapshot->push_back(*value);
+        }
+    }
+
+    PropertySnapshotType result = std::move(snapshot);
+    {
+        std::scoped_lock<std::mutex> g(mSnapshotLock);
+        auto& entry = mSnapshotByPropId[propId];
+        // Publish only if no writer invalidated the store after the copy above was taken and
+        // no concurrent reader already published the same version.
+        if (entry.second == nullptr && entry.first <= version) {
+            entry = {version, result};
+        }
+    }
+    return result;
+}
+
 VehiclePropertyStore::ValueResultType VehiclePropertyStore::readValue(
         const VehiclePropValue& propValue) const {
     std::scoped_lock<std::mutex> g(mLock);
@@ -268,6 +268,30 @@ TEST_F(PendingRequestPoolTest, testPendingRequestCountLimit) {
     getPool()->tryFinishRequests(reinterpret_cast<const void*>(0), requests);
 }
 
+TEST_F(PendingRequestPoolTest, testOccupancyStats) {
+    auto callback = std::make_shared<PendingRequestPool::TimeoutCallbackFunc>(
+            [](std::unordered_set<int64_t>) {});
+
+    ASSERT_EQ(getPool()->countPendingRequests(), static_cast<size_t>(0));
+    ASSERT_EQ(getPool()->peakPendingRequests(), static_cast<size_t>(0));
+
+    ASSERT_RESULT_OK(getPool()->addRequests(getTestClientId(), {0, 1, 2, 3}, callback));
+    ASSERT_RESULT_OK(getPool()->addRequests(reinterpret_cast<const void*>(1), {0, 1}, callback));
+
+    ASSERT_EQ(getPool()->countPendingRequests(), static_cast<size_t>(6));
+    ASSERT_EQ(getPool()->peakPendingRequests(), static_cast<size_t>(6));
+
+    ASSERT_THAT(getPool()->tryFinishRequests(getTestClientId(), {0, 1, 2, 3}),
+                UnorderedElementsAre(0, 1, 2, 3));
+    ASSERT_THAT(getPool()->tryFinishRequests(reinterpret_cast<const void*>(1), {0, 1}),
+                UnorderedElementsAre(0, 1));
+
+    ASSERT_EQ(getPool()->countPendingRequests(), static_cast<size_t>(0));
+
+    // The peak must not drop when requests finish.
+    ASSERT_EQ(getPool()->peakPendingRequests(), static_cast<size_t>(6));
+}
+
 }  // namespace vehicle
 }  // namespace automotive
 }  // namespace hardware
@@ -50,7 +50,13 @@ class RecurrentTimerTest : public testing::Test {
 
     size_t countTimerCallbackQueue(RecurrentTimer* timer) {
         std::scoped_lock<std::mutex> lockGuard(timer->mLock);
-        return timer->mCallbackQueue.size();
+        size_t count = 0;
+        for (const auto& level : timer->mWheel) {
+            for (const auto& slot : level) {
+                count += slot.size();
+            }
+        }
+        return count;
     }
 
   private:
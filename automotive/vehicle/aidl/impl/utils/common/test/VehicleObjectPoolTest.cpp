@@ -16,6 +16,7 @@
 
 #include <thread>
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <utils/SystemClock.h>
@@ -361,6 +362,64 @@ TEST_F(VehicleObjectPoolTest, testMultithreaded) {
     ASSERT_LE(mStats->Created, static_cast<uint32_t>(T * O));
 }
 
+TEST_F(VehicleObjectPoolTest, testSizeClassRecycle) {
+    mValuePool.reset(new VehiclePropValuePool(/*maxRecyclableVectorSize=*/4,
+                                              /*maxPoolObjectsSize=*/10240,
+                                              /*vectorSizeClasses=*/{16, 64}));
+
+    auto value = mValuePool->obtain(VehiclePropertyType::BYTES, 33);
+    void* raw = value.get();
+
+    ASSERT_EQ(value->value.byteValues.size(), 33u);
+
+    value.reset();
+    // The value fits size class 64 and should be recycled, even for another size in the same
+    // class.
+    auto newValue = mValuePool->obtain(VehiclePropertyType::BYTES, 40);
+
+    ASSERT_EQ(newValue.get(), raw);
+    ASSERT_EQ(newValue->value.byteValues.size(), 40u);
+    ASSERT_EQ(mStats->Obtained, 2u);
+    ASSERT_EQ(mStats->Created, 1u);
+}
+
+TEST_F(VehicleObjectPoolTest, testSizeClassSmallestClassChosen) {
+    mValuePool.reset(new VehiclePropValuePool(/*maxRecyclableVectorSize=*/4,
+                                              /*maxPoolObjectsSize=*/10240,
+                                              /*vectorSizeClasses=*/{16, 64}));
+
+    auto value = mValuePool->obtain(VehiclePropertyType::INT32_VEC, 10);
+    void* raw = value.get();
+    value.reset();
+    // Size 60 belongs to class 64 while size 10 belongs to class 16, so the value must not be
+    // shared between them.
+    ASSERT_NE(mValuePool->obtain(VehiclePropertyType::INT32_VEC, 60).get(), raw);
+    ASSERT_EQ(mValuePool->obtain(VehiclePropertyType::INT32_VEC, 12).get(), raw);
+}
+
+TEST_F(VehicleObjectPoolTest, testSizeClassNoFitNotRecyclable) {
+    mValuePool.reset(new VehiclePropValuePool(/*maxRecyclableVectorSize=*/4,
+                                              /*maxPoolObjectsSize=*/10240,
+                                              /*vectorSizeClasses=*/{16}));
+
+    auto value = mValuePool->obtain(VehiclePropertyType::BYTES, 17);
+
+    ASSERT_EQ(value->value.byteValues.size(), 17u);
+    ASSERT_EQ(mStats->Obtained, 0u)
+            << "Value larger than all size classes should not be obtained from the pool";
+}
+
+TEST_F(VehicleObjectPoolTest, testDump) {
+    mValuePool->obtain(VehiclePropertyType::INT32).reset();
+    mValuePool->obtain(VehiclePropertyType::INT32).reset();
+
+    std::string dump = mValuePool->dump();
+
+    ASSERT_THAT(dump, ::testing::HasSubstr("obtained: 2"));
+    ASSERT_THAT(dump, ::testing::HasSubstr("created: 1"));
+    ASSERT_THAT(dump, ::testing::HasSubstr("hitRate: 50.0%"));
+}
+
 TEST_F(VehicleObjectPoolTest, testMemoryLimitation) {
     std::vector<recyclable_ptr<VehiclePropValue>> vec;
     for (size_t i = 0; i < 10000; i++) {
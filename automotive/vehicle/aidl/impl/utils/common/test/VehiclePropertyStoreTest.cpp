@@ -186,6 +186,63 @@ TEST_F(VehiclePropertyStoreTest, testReadValuesForPropertyError) {
     EXPECT_EQ(result.error().code(), StatusCode::INVALID_ARG);
 }
 
+TEST_F(VehiclePropertyStoreTest, testReadValuesForPropertySnapshot) {
+    auto values = getTestPropValues();
+    for (const auto& value : values) {
+        ASSERT_RESULT_OK(mStore->writeValue(mValuePool->obtain(value)));
+    }
+
+    auto result = mStore->readValuesForPropertySnapshot(toInt(VehicleProperty::TIRE_PRESSURE));
+
+    ASSERT_RESULT_OK(result);
+    ASSERT_THAT(*result.value(), WhenSortedBy(propValueCmp, ElementsAre(values[1], values[2])));
+}
+
+TEST_F(VehiclePropertyStoreTest, testReadValuesForPropertySnapshotCachedBetweenWrites) {
+    auto values = getTestPropValues();
+    for (const auto& value : values) {
+        ASSERT_RESULT_OK(mStore->writeValue(mValuePool->obtain(value)));
+    }
+
+    auto result1 = mStore->readValuesForPropertySnapshot(toInt(VehicleProperty::TIRE_PRESSURE));
+    auto result2 = mStore->readValuesForPropertySnapshot(toInt(VehicleProperty::TIRE_PRESSURE));
+
+    ASSERT_RESULT_OK(result1);
+    ASSERT_RESULT_OK(result2);
+    ASSERT_EQ(result1.value(), result2.value())
+            << "expect reads between writes to return the same published snapshot";
+}
+
+TEST_F(VehiclePropertyStoreTest, testReadValuesForPropertySnapshotImmutableAfterWrite) {
+    auto values = getTestPropValues();
+    for (const auto& value : values) {
+        ASSERT_RESULT_OK(mStore->writeValue(mValuePool->obtain(value)));
+    }
+    auto oldResult = mStore->readValuesForPropertySnapshot(toInt(VehicleProperty::TIRE_PRESSURE));
+    ASSERT_RESULT_OK(oldResult);
+
+    VehiclePropValue updatedLeftTirePressure = values[1];
+    updatedLeftTirePressure.value.floatValues[0] = 175.0;
+    ASSERT_RESULT_OK(mStore->writeValue(mValuePool->obtain(updatedLeftTirePressure)));
+    auto newResult = mStore->readValuesForPropertySnapshot(toInt(VehicleProperty::TIRE_PRESSURE));
+
+    ASSERT_RESULT_OK(newResult);
+    ASSERT_NE(oldResult.value(), newResult.value())
+            << "expect a write to invalidate the published snapshot";
+    ASSERT_THAT(*newResult.value(),
+                WhenSortedBy(propValueCmp, ElementsAre(updatedLeftTirePressure, values[2])));
+    // The snapshot handed out before the write must not have changed.
+    ASSERT_THAT(*oldResult.value(),
+                WhenSortedBy(propValueCmp, ElementsAre(values[1], values[2])));
+}
+
+TEST_F(VehiclePropertyStoreTest, testReadValuesForPropertySnapshotError) {
+    auto result = mStore->readValuesForPropertySnapshot(INVALID_PROP_ID);
+
+    EXPECT_FALSE(result.ok()) << "expect error when reading a snapshot for an invalid property";
+    EXPECT_EQ(result.error().code(), StatusCode::INVALID_ARG);
+}
+
 TEST_F(VehiclePropertyStoreTest, testReadValueOk) {
     auto values = getTestPropValues();
     for (const auto& value : values) {
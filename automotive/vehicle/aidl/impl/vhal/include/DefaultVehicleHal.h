@@ -18,6 +18,7 @@
 #define android_hardware_automotive_vehicle_aidl_impl_vhal_include_DefaultVehicleHal_H_
 
 #include <ConnectedClient.h>
+#include <GetValuesCoalescer.h>
 #include <ParcelableUtils.h>
 #include <PendingRequestPool.h>
 #include <RecurrentTimer.h>
@@ -164,8 +165,14 @@ class DefaultVehicleHal final : public aidl::android::hardware::automotive::vehi
     static constexpr int64_t TIMEOUT_IN_NANO = 30'000'000'000;
     // heart beat event interval: 3s
     static constexpr int64_t HEART_BEAT_INTERVAL_IN_NANO = 3'000'000'000;
+    // The window within which overlapping getValues batches from concurrent clients are
+    // coalesced into one hardware call: 1ms.
+    static constexpr int64_t GET_VALUES_COALESCE_WINDOW_IN_NANO = 1'000'000;
     bool mShouldRefreshPropertyConfigs;
     std::unique_ptr<IVehicleHardware> mVehicleHardware;
+    // Coalesces concurrent getValues batches into fewer hardware calls. Uses pointer to
+    // mVehicleHardware, so it must be destroyed before mVehicleHardware.
+    std::unique_ptr<GetValuesCoalescer> mGetValuesCoalescer;
 
     // mConfigsByPropId and mConfigFile are only modified during initialization, so no need to
     // lock guard them.
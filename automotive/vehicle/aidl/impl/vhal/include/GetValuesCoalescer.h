@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef android_hardware_automotive_vehicle_aidl_impl_vhal_include_GetValuesCoalescer_H_
+#define android_hardware_automotive_vehicle_aidl_impl_vhal_include_GetValuesCoalescer_H_
+
+#include <IVehicleHardware.h>
+#include <VehicleHalTypes.h>
+
+#include <android-base/thread_annotations.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace android {
+namespace hardware {
+namespace automotive {
+namespace vehicle {
+
+// A thread-safe scheduler that merges get value requests issued by concurrent clients into
+// batched {@code IVehicleHardware::getValues} calls.
+//
+// A batch arriving when nothing was dispatched within the coalesce window is sent to the
+// hardware immediately on the caller's thread with the client's own request IDs and callback,
+// exactly as if the hardware had been called directly, so an isolated request pays no extra
+// latency. Batches arriving within the window after a dispatch are parked and flushed
+// together by a background thread when the window lapses, so a burst of small overlapping
+// batches crosses the hardware boundary once per window instead of once per client call.
+//
+// Clients pick their own request IDs, so parked requests from different clients may collide.
+// Each parked request is re-keyed with a unique internal ID before it is handed to the
+// hardware and the results are de-multiplexed back to the issuing client's callback with the
+// original ID. Hardware errors for a coalesced batch are delivered as per-request error
+// results through the same callback, since the issuing calls have already returned.
+class GetValuesCoalescer final {
+  public:
+    using GetValuesCallback = IVehicleHardware::GetValuesCallback;
+
+    GetValuesCoalescer(IVehicleHardware* hardware, int64_t coalesceWindowInNano,
+                       int64_t timeoutInNano);
+
+    ~GetValuesCoalescer();
+
+    // Sends the requests to hardware, either inline on this thread or as part of a coalesced
+    // batch once the current window lapses. Returns the hardware status for an inline
+    // dispatch, in which case the callback would never be called on error, matching
+    // {@code IVehicleHardware::getValues}. Returns {@code StatusCode::OK} for a parked batch;
+    // any later hardware error is delivered through {@code callback}.
+    aidl::android::hardware::automotive::vehicle::StatusCode getValues(
+            std::shared_ptr<const GetValuesCallback> callback,
+            const std::vector<aidl::android::hardware::automotive::vehicle::GetValueRequest>&
+                    requests);
+
+    // Returns the number of batches sent to hardware and the number of client calls served,
+    // for debug dump and testing.
+    size_t countDispatchedBatches() const;
+    size_t countClientCalls() const;
+
+  private:
+    // Maps an internal request ID back to the issuing client.
+    struct ClientRequest {
+        std::shared_ptr<const GetValuesCallback> callback;
+        int64_t requestId;
+        int64_t enqueueTimestamp;
+    };
+
+    // The de-multiplexing state is shared with the hardware callback so that a late hardware
+    // response after this coalescer is destroyed remains safe.
+    struct DemuxState {
+        std::mutex lock;
+        std::unordered_map<int64_t, ClientRequest> clientRequestsById GUARDED_BY(lock);
+        int64_t nextInternalId GUARDED_BY(lock) = 0;
+    };
+
+    // If the hardware never answers a request, its de-multiplexing entry would leak. Entries
+    // older than the request timeout are pruned once the map grows beyond this size; the
+    // client-visible timeout error is PendingRequestPool's job.
+    static constexpr size_t PRUNE_THRESHOLD = 1000;
+
+    IVehicleHardware* mHardware;
+    const int64_t mCoalesceWindowInNano;
+    const int64_t mTimeoutInNano;
+    std::shared_ptr<DemuxState> mDemuxState;
+    std::shared_ptr<const GetValuesCallback> mHardwareCallback;
+
+    mutable std::mutex mLock;
+    std::condition_variable mFlushCv;
+    std::vector<aidl::android::hardware::automotive::vehicle::GetValueRequest> mPendingRequests
+            GUARDED_BY(mLock);
+    int64_t mLastDispatchTimeInNano GUARDED_BY(mLock) = 0;
+    bool mFlushScheduled GUARDED_BY(mLock) = false;
+    bool mShutdown GUARDED_BY(mLock) = false;
+    size_t mDispatchedBatches GUARDED_BY(mLock) = 0;
+    size_t mClientCalls GUARDED_BY(mLock) = 0;
+    std::thread mFlushThread;
+
+    void flushThreadLoop();
+
+    void dispatchToHardware(
+            std::vector<aidl::android::hardware::automotive::vehicle::GetValueRequest>&& requests);
+
+    static void demuxResults(
+            const std::shared_ptr<DemuxState>& state,
+            std::vector<aidl::android::hardware::automotive::vehicle::GetValueResult>&& results);
+};
+
+}  // namespace vehicle
+}  // namespace automotive
+}  // namespace hardware
+}  // namespace android
+
+#endif  // android_hardware_automotive_vehicle_aidl_impl_vhal_include_GetValuesCoalescer_H_
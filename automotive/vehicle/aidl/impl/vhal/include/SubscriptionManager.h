@@ -17,6 +17,7 @@
 #ifndef android_hardware_automotive_vehicle_aidl_impl_vhal_include_SubscriptionManager_H_
 #define android_hardware_automotive_vehicle_aidl_impl_vhal_include_SubscriptionManager_H_
 
+#include <ConcurrentQueue.h>
 #include <IVehicleHardware.h>
 #include <VehicleHalTypes.h>
 #include <VehicleUtils.h>
@@ -25,8 +26,11 @@
 #include <android-base/result.h>
 #include <android-base/thread_annotations.h>
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -44,6 +48,7 @@ class ContSubConfigs final {
     void addClient(const ClientIdType& clientId, float sampleRateHz);
     void removeClient(const ClientIdType& clientId);
     float getMaxSampleRateHz() const;
+    float getSampleRateHzForClient(const ClientIdType& clientId) const;
 
   private:
     float mMaxSampleRateHz = 0.;
@@ -89,6 +94,18 @@ class SubscriptionManager final {
     // Returns ok if all the properties for the client are unsubscribed.
     VhalResult<void> unsubscribe(ClientIdType client);
 
+    // Fans the updated values out to the delivery queue of every subscribed client.
+    //
+    // This is the hot path for property change events from hardware: it reads an immutable
+    // routing snapshot published by subscribe/unsubscribe and never takes the manager lock.
+    // Each client's events are delivered on that client's own delivery thread, so a client
+    // slow to process its onPropertyEvent callback only delays its own events. A continuous
+    // subscription whose sample rate is below the rate the hardware refreshes at is decimated
+    // to the client's requested rate when the event is enqueued.
+    void onPropertyChangeEvent(
+            const std::vector<aidl::android::hardware::automotive::vehicle::VehiclePropValue>&
+                    updatedValues);
+
     // For a list of updated properties, returns a map that maps clients subscribing to
     // the updated properties to a list of updated values. This would only return on-change property
     // clients that should be informed for the given updated values.
@@ -108,13 +125,96 @@ class SubscriptionManager final {
     // Checks whether the sample rate is valid.
     static bool checkSampleRateHz(float sampleRateHz);
 
+    // Returns the number of property events delivered to clients, the number of
+    // onPropertyEvent calls they took and the number of calls that were delayed by the
+    // per-client call budget, for debug dump and testing.
+    size_t countDeliveredEvents() const;
+    size_t countPropertyEventCalls() const;
+    size_t countThrottledPropertyEventCalls() const;
+
   private:
     // Friend class for testing.
     friend class DefaultVehicleHalTest;
 
+    // Delivery accounting aggregated across all clients' delivery queues. Updated with
+    // relaxed atomics by the delivery threads.
+    struct DeliveryStats {
+        std::atomic<uint64_t> deliveredEvents{0};
+        std::atomic<uint64_t> propertyEventCalls{0};
+        std::atomic<uint64_t> throttledCalls{0};
+    };
+
+    // A per-client event queue drained by a dedicated delivery thread. Batches that queued up
+    // since the last delivery are merged and re-split into batches of at most
+    // maxEventsPerCall, and consecutive onPropertyEvent calls are spaced minCallIntervalNanos
+    // apart, so an event storm reaches the client as few large transactions instead of one
+    // binder call per hardware batch.
+    class DeliveryQueue final {
+      public:
+        // The default cap on events marshalled into one onPropertyEvent call.
+        static constexpr size_t DEFAULT_MAX_EVENTS_PER_CALL = 1000;
+        // The default minimum interval between two onPropertyEvent calls, budgeting each
+        // client to at most 100 binder transactions per second.
+        static constexpr int64_t DEFAULT_MIN_CALL_INTERVAL_NANOS = 10'000'000;
+
+        DeliveryQueue(CallbackType callback, std::shared_ptr<DeliveryStats> stats,
+                      size_t maxEventsPerCall = DEFAULT_MAX_EVENTS_PER_CALL,
+                      int64_t minCallIntervalNanos = DEFAULT_MIN_CALL_INTERVAL_NANOS);
+        ~DeliveryQueue();
+
+        // Enqueues one batch of values for delivery.
+        void enqueue(
+                std::vector<aidl::android::hardware::automotive::vehicle::VehiclePropValue>&&
+                        values);
+
+        // Deactivates the queue and joins the delivery thread. Events not delivered yet are
+        // dropped.
+        void stop();
+
+      private:
+        CallbackType mCallback;
+        std::shared_ptr<DeliveryStats> mStats;
+        const size_t mMaxEventsPerCall;
+        const int64_t mMinCallIntervalNanos;
+        // When the last onPropertyEvent call was made. Only accessed by the delivery thread.
+        int64_t mLastCallNanos = 0;
+        ConcurrentQueue<std::vector<aidl::android::hardware::automotive::vehicle::VehiclePropValue>>
+                mQueue;
+        std::thread mThread;
+
+        void deliveryLoop();
+    };
+
+    // One {client, propId, areaId} subscription in the published fan-out snapshot.
+    struct FanOutRoute {
+        std::shared_ptr<DeliveryQueue> queue;
+        // Minimum nanos between two delivered events, 0 when the subscription is not
+        // decimated.
+        int64_t intervalNanos;
+        // When the last event for this route was enqueued. Shared across snapshot rebuilds so
+        // a re-subscription does not reset the decimation.
+        std::shared_ptr<std::atomic<int64_t>> lastEventNanos;
+    };
+
+    // An immutable routing table mapping each [propId, areaId] to the subscribed clients'
+    // delivery queues. Rebuilt by subscribe/unsubscribe and swapped atomically, so the event
+    // fan-out reads it without taking mLock.
+    struct FanOutSnapshot {
+        std::unordered_map<PropIdAreaId, std::vector<FanOutRoute>, PropIdAreaIdHash>
+                routesByPropIdArea;
+    };
+
     IVehicleHardware* mVehicleHardware;
 
+    // Accessed only through std::atomic_load/std::atomic_store, no lock needed.
+    std::shared_ptr<const FanOutSnapshot> mFanOutSnapshot;
+
+    // Shared with every delivery queue; the pointer itself is never re-assigned.
+    const std::shared_ptr<DeliveryStats> mDeliveryStats;
+
     mutable std::mutex mLock;
+    std::unordered_map<ClientIdType, std::shared_ptr<DeliveryQueue>> mDeliveryQueuesByClient
+            GUARDED_BY(mLock);
     std::unordered_map<PropIdAreaId, std::unordered_map<ClientIdType, CallbackType>,
                        PropIdAreaIdHash>
             mClientsByPropIdArea GUARDED_BY(mLock);
@@ -133,6 +233,23 @@ class SubscriptionManager final {
     VhalResult<void> updateContSubConfigs(const PropIdAreaId& PropIdAreaId,
                                           const ContSubConfigs& newConfig) REQUIRES(mLock);
 
+    VhalResult<void> subscribeLocked(
+            const CallbackType& callback,
+            const std::vector<aidl::android::hardware::automotive::vehicle::SubscribeOptions>&
+                    options,
+            bool isContinuousProperty) REQUIRES(mLock);
+    VhalResult<void> unsubscribeLocked(ClientIdType client, const std::vector<int32_t>& propIds)
+            REQUIRES(mLock);
+    VhalResult<void> unsubscribeLocked(ClientIdType client) REQUIRES(mLock);
+
+    // Rebuilds and publishes the fan-out snapshot from the current subscription state.
+    void updateFanOutSnapshotLocked() REQUIRES(mLock);
+
+    // Removes the delivery queue for a client with no subscription left. The returned queue
+    // must be stopped after mLock is released since stopping joins the delivery thread.
+    std::shared_ptr<DeliveryQueue> removeDeliveryQueueIfUnusedLocked(ClientIdType clientId)
+            REQUIRES(mLock);
+
     // Checks whether the manager is empty. For testing purpose.
     bool isEmpty();
 
@@ -136,6 +136,8 @@ DefaultVehicleHal::DefaultVehicleHal(std::unique_ptr<IVehicleHardware> vehicleHa
 
     auto subscribeIdByClient = std::make_shared<SubscribeIdByClient>();
     IVehicleHardware* vehicleHardwarePtr = mVehicleHardware.get();
+    mGetValuesCoalescer = std::make_unique<GetValuesCoalescer>(
+            vehicleHardwarePtr, GET_VALUES_COALESCE_WINDOW_IN_NANO, TIMEOUT_IN_NANO);
     mSubscriptionManager = std::make_shared<SubscriptionManager>(vehicleHardwarePtr);
 
     std::weak_ptr<SubscriptionManager> subscriptionManagerCopy = mSubscriptionManager;
@@ -178,6 +180,9 @@ DefaultVehicleHal::~DefaultVehicleHal() {
     // mSubscriptionManager uses pointer to mVehicleHardware, so it has to be destroyed before
     // mVehicleHardware.
     mSubscriptionManager.reset();
+    // mGetValuesCoalescer uses pointer to mVehicleHardware, so it has to be destroyed before
+    // mVehicleHardware.
+    mGetValuesCoalescer.reset();
     mVehicleHardware.reset();
 }
 
@@ -189,14 +194,9 @@ void DefaultVehicleHal::onPropertyChangeEvent(
         ALOGW("the SubscriptionManager is destroyed, DefaultVehicleHal is ending");
         return;
     }
-    auto updatedValuesByClients = manager->getSubscribedClients(updatedValues);
-    for (const auto& [callback, valuePtrs] : updatedValuesByClients) {
-        std::vector<VehiclePropValue> values;
-        for (const VehiclePropValue* valuePtr : valuePtrs) {
-            values.push_back(*valuePtr);
-        }
-        SubscriptionClient::sendUpdatedValues(callback, std::move(values));
-    }
+    // The manager fans the values out to per-client delivery queues, each drained by its own
+    // thread, so this callback never blocks on a slow client.
+    manager->onPropertyChangeEvent(updatedValues);
 }
 
 void DefaultVehicleHal::onPropertySetErrorEvent(
@@ -450,8 +450,12 @@ ScopedAStatus DefaultVehicleHal::getValues(const CallbackType& callback,
         return ScopedAStatus::ok();
     }
 
+    // The coalescer may merge this batch with other clients' concurrent requests into one
+    // hardware call. A non-OK status is only returned for an inline dispatch where the
+    // callback would never be called; errors for a coalesced batch are delivered as error
+    // results through the client's result callback.
     if (StatusCode status =
-                mVehicleHardware->getValues(client->getResultCallback(), hardwareRequests);
+                mGetValuesCoalescer->getValues(client->getResultCallback(), hardwareRequests);
         status != StatusCode::OK) {
         // If the hardware returns error, finish all the pending requests for this request because
         // we never expect hardware to call callback for these requests.
@@ -845,6 +849,14 @@ binder_status_t DefaultVehicleHal::dump(int fd, const char** args, uint32_t numA
         dprintf(fd, "Currently have %zu subscription clients\n",
                 mSubscriptionClients->countClients());
     }
+    dprintf(fd, "Dispatched %zu getValues batches to hardware for %zu client calls\n",
+            mGetValuesCoalescer->countDispatchedBatches(), mGetValuesCoalescer->countClientCalls());
+    dprintf(fd,
+            "Delivered %zu property events over %zu onPropertyEvent calls, %zu calls delayed "
+            "by the per-client call budget\n",
+            mSubscriptionManager->countDeliveredEvents(),
+            mSubscriptionManager->countPropertyEventCalls(),
+            mSubscriptionManager->countThrottledPropertyEventCalls());
     return STATUS_OK;
 }
 
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "GetValuesCoalescer"
+
+#include <GetValuesCoalescer.h>
+
+#include <VehicleUtils.h>
+
+#include <android-base/thread_annotations.h>
+#include <utils/Log.h>
+#include <utils/SystemClock.h>
+
+#include <inttypes.h>
+#include <chrono>
+#include <utility>
+
+namespace android {
+namespace hardware {
+namespace automotive {
+namespace vehicle {
+
+namespace {
+
+using ::aidl::android::hardware::automotive::vehicle::GetValueRequest;
+using ::aidl::android::hardware::automotive::vehicle::GetValueResult;
+using ::aidl::android::hardware::automotive::vehicle::StatusCode;
+using ::android::base::ScopedLockAssertion;
+
+}  // namespace
+
+GetValuesCoalescer::GetValuesCoalescer(IVehicleHardware* hardware, int64_t coalesceWindowInNano,
+                                       int64_t timeoutInNano)
+    : mHardware(hardware),
+      mCoalesceWindowInNano(coalesceWindowInNano),
+      mTimeoutInNano(timeoutInNano),
+      mDemuxState(std::make_shared<DemuxState>()) {
+    mHardwareCallback = std::make_shared<const GetValuesCallback>(
+            [state = mDemuxState](std::vector<GetValueResult> results) {
+                demuxResults(state, std::move(results));
+            });
+    mFlushThread = std::thread([this] { flushThreadLoop(); });
+}
+
+GetValuesCoalescer::~GetValuesCoalescer() {
+    std::vector<GetValueRequest> leftover;
+    {
+        std::scoped_lock<std::mutex> lockGuard(mLock);
+        mShutdown = true;
+        mFlushCv.notify_all();
+    }
+    mFlushThread.join();
+    {
+        std::scoped_lock<std::mutex> lockGuard(mLock);
+        leftover = std::move(mPendingRequests);
+        mPendingRequests.clear();
+    }
+    if (!leftover.empty()) {
+        // Dispatch whatever is still parked so no client request has to wait for its timeout.
+        dispatchToHardware(std::move(leftover));
+    }
+}
+
+StatusCode GetValuesCoalescer::getValues(std::shared_ptr<const GetValuesCallback> callback,
+                                         const std::vector<GetValueRequest>& requests) {
+    int64_t now = elapsedRealtimeNano();
+    {
+        std::unique_lock<std::mutex> lockGuard(mLock);
+        mClientCalls++;
+        if (!mShutdown && mPendingRequests.empty() && !mFlushScheduled &&
+            now - mLastDispatchTimeInNano >= mCoalesceWindowInNano) {
+            // Nothing was dispatched recently, send this batch down right away with the
+            // client's own request IDs and callback, no re-keying needed.
+            mLastDispatchTimeInNano = now;
+            mDispatchedBatches++;
+            lockGuard.unlock();
+            return mHardware->getValues(callback, requests);
+        }
+    }
+
+    // A batch was just dispatched (or a flush is pending), park the requests until the window
+    // lapses so overlapping client calls merge into one hardware call. Parked requests are
+    // re-keyed with unique internal IDs since IDs from different clients may collide.
+    std::vector<GetValueRequest> remappedRequests;
+    remappedRequests.reserve(requests.size());
+    {
+        std::scoped_lock<std::mutex> lockGuard(mDemuxState->lock);
+        if (mDemuxState->clientRequestsById.size() > PRUNE_THRESHOLD) {
+            for (auto it = mDemuxState->clientRequestsById.begin();
+                 it != mDemuxState->clientRequestsById.end();) {
+                if (now - it->second.enqueueTimestamp >= mTimeoutInNano) {
+                    it = mDemuxState->clientRequestsById.erase(it);
+                } else {
+                    it++;
+                }
+            }
+        }
+        for (const GetValueRequest& request : requests) {
+            int64_t internalId = mDemuxState->nextInternalId++;
+            mDemuxState->clientRequestsById[internalId] = ClientRequest{
+                    .callback = callback,
+                    .requestId = request.requestId,
+                    .enqueueTimestamp = now,
+            };
+            GetValueRequest remapped = request;
+            remapped.requestId = internalId;
+            remappedRequests.push_back(std::move(remapped));
+        }
+    }
+
+    {
+        std::scoped_lock<std::mutex> lockGuard(mLock);
+        mPendingRequests.insert(mPendingRequests.end(),
+                                std::make_move_iterator(remappedRequests.begin()),
+                                std::make_move_iterator(remappedRequests.end()));
+        if (!mFlushScheduled) {
+            mFlushScheduled = true;
+            mFlushCv.notify_all();
+        }
+    }
+    return StatusCode::OK;
+}
+
+void GetValuesCoalescer::flushThreadLoop() {
+    std::unique_lock<std::mutex> lockGuard(mLock);
+    ScopedLockAssertion lockAssertion(mLock);
+    while (!mShutdown) {
+        if (!mFlushScheduled) {
+            // Wait until a flush is scheduled or the coalescer exits.
+            mFlushCv.wait(lockGuard, [this] {
+                ScopedLockAssertion lockAssertion(mLock);
+                return mFlushScheduled || mShutdown;
+            });
+            continue;
+        }
+
+        int64_t now = elapsedRealtimeNano();
+        int64_t deadline = mLastDispatchTimeInNano + mCoalesceWindowInNano;
+        if (now < deadline && !mShutdown) {
+            mFlushCv.wait_for(lockGuard, std::chrono::nanoseconds(deadline - now));
+            continue;
+        }
+
+        std::vector<GetValueRequest> batch = std::move(mPendingRequests);
+        mPendingRequests.clear();
+        mFlushScheduled = false;
+        if (batch.empty()) {
+            continue;
+        }
+        mLastDispatchTimeInNano = now;
+        mDispatchedBatches++;
+
+        lockGuard.unlock();
+        dispatchToHardware(std::move(batch));
+        lockGuard.lock();
+    }
+}
+
+void GetValuesCoalescer::dispatchToHardware(std::vector<GetValueRequest>&& requests) {
+    StatusCode status = mHardware->getValues(mHardwareCallback, requests);
+    if (status == StatusCode::OK) {
+        return;
+    }
+
+    // We never expect hardware to call the callback for a failed getValues call, finish the
+    // requests with per-request errors instead.
+    ALOGE("failed to get value from VehicleHardware, status: %d", toInt(status));
+    std::vector<GetValueResult> errorResults;
+    errorResults.reserve(requests.size());
+    for (const GetValueRequest& request : requests) {
+        errorResults.push_back(GetValueResult{
+                .requestId = request.requestId,
+                .status = status,
+                .prop = {},
+        });
+    }
+    demuxResults(mDemuxState, std::move(errorResults));
+}
+
+void GetValuesCoalescer::demuxResults(const std::shared_ptr<DemuxState>& state,
+                                      std::vector<GetValueResult>&& results) {
+    // Group the results by issuing client, restoring the client's request IDs.
+    std::unordered_map<const GetValuesCallback*,
+                       std::pair<std::shared_ptr<const GetValuesCallback>,
+                                 std::vector<GetValueResult>>>
+            resultsByClient;
+    {
+        std::scoped_lock<std::mutex> lockGuard(state->lock);
+        for (GetValueResult& result : results) {
+            auto it = state->clientRequestsById.find(result.requestId);
+            if (it == state->clientRequestsById.end()) {
+                ALOGE("no pending client request for coalesced request ID: %" PRId64
+                      ", ignoring the result",
+                      result.requestId);
+                continue;
+            }
+            result.requestId = it->second.requestId;
+            auto& clientResults = resultsByClient[it->second.callback.get()];
+            clientResults.first = it->second.callback;
+            clientResults.second.push_back(std::move(result));
+            state->clientRequestsById.erase(it);
+        }
+    }
+
+    for (auto& [_, clientResults] : resultsByClient) {
+        (*clientResults.first)(std::move(clientResults.second));
+    }
+}
+
+size_t GetValuesCoalescer::countDispatchedBatches() const {
+    std::scoped_lock<std::mutex> lockGuard(mLock);
+    return mDispatchedBatches;
+}
+
+size_t GetValuesCoalescer::countClientCalls() const {
+    std::scoped_lock<std::mutex> lockGuard(mLock);
+    return mClientCalls;
+}
+
+}  // namespace vehicle
+}  // namespace automotive
+}  // namespace hardware
+}  // namespace android
@@ -15,12 +15,18 @@
  */
 
 #include "SubscriptionManager.h"
+#include "ConnectedClient.h"
 
 #include <android-base/stringprintf.h>
 #include <utils/Log.h>
 #include <utils/SystemClock.h>
 
 #include <inttypes.h>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <thread>
+#include <utility>
 
 namespace android {
 namespace hardware {
@@ -44,13 +50,103 @@ using ::android::base::StringPrintf;
 using ::ndk::ScopedAStatus;
 
 SubscriptionManager::SubscriptionManager(IVehicleHardware* vehicleHardware)
-    : mVehicleHardware(vehicleHardware) {}
+    : mVehicleHardware(vehicleHardware), mDeliveryStats(std::make_shared<DeliveryStats>()) {}
 
 SubscriptionManager::~SubscriptionManager() {
-    std::scoped_lock<std::mutex> lockGuard(mLock);
+    std::vector<std::shared_ptr<DeliveryQueue>> deliveryQueues;
+    {
+        std::scoped_lock<std::mutex> lockGuard(mLock);
+
+        mClientsByPropIdArea.clear();
+        mSubscribedPropsByClient.clear();
+        for (auto& [_, queue] : mDeliveryQueuesByClient) {
+            deliveryQueues.push_back(std::move(queue));
+        }
+        mDeliveryQueuesByClient.clear();
+        std::atomic_store_explicit(&mFanOutSnapshot, std::shared_ptr<const FanOutSnapshot>(),
+                                   std::memory_order_release);
+    }
+    // Stopping a queue joins its delivery thread, do not hold mLock while doing so.
+    for (auto& queue : deliveryQueues) {
+        queue->stop();
+    }
+}
+
+SubscriptionManager::DeliveryQueue::DeliveryQueue(CallbackType callback,
+                                                  std::shared_ptr<DeliveryStats> stats,
+                                                  size_t maxEventsPerCall,
+                                                  int64_t minCallIntervalNanos)
+    : mCallback(callback),
+      mStats(stats),
+      mMaxEventsPerCall(maxEventsPerCall),
+      mMinCallIntervalNanos(minCallIntervalNanos) {
+    mThread = std::thread([this] { deliveryLoop(); });
+}
+
+SubscriptionManager::DeliveryQueue::~DeliveryQueue() {
+    stop();
+}
+
+void SubscriptionManager::DeliveryQueue::enqueue(std::vector<VehiclePropValue>&& values) {
+    mQueue.push(std::move(values));
+}
+
+void SubscriptionManager::DeliveryQueue::stop() {
+    mQueue.deactivate();
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+}
+
+void SubscriptionManager::DeliveryQueue::deliveryLoop() {
+    while (mQueue.waitForItems()) {
+        // Merge every batch that queued up since the last delivery, so a storm of small
+        // hardware batches crosses the binder boundary as few large ones.
+        std::vector<VehiclePropValue> merged;
+        for (std::vector<VehiclePropValue>& values : mQueue.flush()) {
+            if (merged.empty()) {
+                merged = std::move(values);
+            } else {
+                merged.insert(merged.end(), std::make_move_iterator(values.begin()),
+                              std::make_move_iterator(values.end()));
+            }
+        }
+        size_t mergedSize = merged.size();
+        for (size_t begin = 0; begin < mergedSize; begin += mMaxEventsPerCall) {
+            // Stay within the per-client call budget. Events arriving while we wait pile up
+            // in the queue and are merged into the next delivery instead of causing binder
+            // calls of their own.
+            int64_t waitNanos = mLastCallNanos + mMinCallIntervalNanos - elapsedRealtimeNano();
+            if (waitNanos > 0) {
+                mStats->throttledCalls.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::sleep_for(std::chrono::nanoseconds(waitNanos));
+            }
+            std::vector<VehiclePropValue> batch;
+            if (begin == 0 && mergedSize <= mMaxEventsPerCall) {
+                batch = std::move(merged);
+            } else {
+                size_t end = std::min(begin + mMaxEventsPerCall, mergedSize);
+                batch.assign(std::make_move_iterator(merged.begin() + begin),
+                             std::make_move_iterator(merged.begin() + end));
+            }
+            mStats->deliveredEvents.fetch_add(batch.size(), std::memory_order_relaxed);
+            mStats->propertyEventCalls.fetch_add(1, std::memory_order_relaxed);
+            mLastCallNanos = elapsedRealtimeNano();
+            SubscriptionClient::sendUpdatedValues(mCallback, std::move(batch));
+        }
+    }
+}
+
+size_t SubscriptionManager::countDeliveredEvents() const {
+    return static_cast<size_t>(mDeliveryStats->deliveredEvents.load(std::memory_order_relaxed));
+}
 
-    mClientsByPropIdArea.clear();
-    mSubscribedPropsByClient.clear();
+size_t SubscriptionManager::countPropertyEventCalls() const {
+    return static_cast<size_t>(mDeliveryStats->propertyEventCalls.load(std::memory_order_relaxed));
+}
+
+size_t SubscriptionManager::countThrottledPropertyEventCalls() const {
+    return static_cast<size_t>(mDeliveryStats->throttledCalls.load(std::memory_order_relaxed));
 }
 
 bool SubscriptionManager::checkSampleRateHz(float sampleRateHz) {
@@ -95,6 +191,13 @@ float ContSubConfigs::getMaxSampleRateHz() const {
     return mMaxSampleRateHz;
 }
 
+float ContSubConfigs::getSampleRateHzForClient(const ClientIdType& clientId) const {
+    if (auto it = mSampleRateHzByClient.find(clientId); it != mSampleRateHzByClient.end()) {
+        return it->second;
+    }
+    return 0.;
+}
+
 VhalResult<void> SubscriptionManager::addContinuousSubscriberLocked(
         const ClientIdType& clientId, const PropIdAreaId& propIdAreaId, float sampleRateHz) {
     // Make a copy so that we don't modify 'mContSubConfigsByPropIdArea' on failure cases.
@@ -135,8 +238,30 @@ VhalResult<void> SubscriptionManager::updateContSubConfigs(const PropIdAreaId& p
 VhalResult<void> SubscriptionManager::subscribe(const std::shared_ptr<IVehicleCallback>& callback,
                                                 const std::vector<SubscribeOptions>& options,
                                                 bool isContinuousProperty) {
-    std::scoped_lock<std::mutex> lockGuard(mLock);
+    VhalResult<void> result;
+    std::shared_ptr<DeliveryQueue> unusedQueue;
+    {
+        std::scoped_lock<std::mutex> lockGuard(mLock);
+
+        result = subscribeLocked(callback, options, isContinuousProperty);
+        if (!result.ok()) {
+            // A delivery queue might have been created for a client that ended up with no
+            // subscription.
+            unusedQueue = removeDeliveryQueueIfUnusedLocked(callback->asBinder().get());
+        }
+        // The subscription state might have been partially modified even on failure, always
+        // publish a snapshot matching the current state.
+        updateFanOutSnapshotLocked();
+    }
+    if (unusedQueue != nullptr) {
+        unusedQueue->stop();
+    }
+    return result;
+}
 
+VhalResult<void> SubscriptionManager::subscribeLocked(const CallbackType& callback,
+                                                      const std::vector<SubscribeOptions>& options,
+                                                      bool isContinuousProperty) {
     for (const auto& option : options) {
         float sampleRateHz = option.sampleRate;
 
@@ -155,6 +280,10 @@ VhalResult<void> SubscriptionManager::subscribe(const std::shared_ptr<IVehicleCa
 
     ClientIdType clientId = callback->asBinder().get();
 
+    if (mDeliveryQueuesByClient[clientId] == nullptr) {
+        mDeliveryQueuesByClient[clientId] = std::make_shared<DeliveryQueue>(callback, mDeliveryStats);
+    }
+
     for (const auto& option : options) {
         int32_t propId = option.propId;
         const std::vector<int32_t>& areaIds = option.areaIds;
@@ -180,8 +309,23 @@ VhalResult<void> SubscriptionManager::subscribe(const std::shared_ptr<IVehicleCa
 
 VhalResult<void> SubscriptionManager::unsubscribe(SubscriptionManager::ClientIdType clientId,
                                                   const std::vector<int32_t>& propIds) {
-    std::scoped_lock<std::mutex> lockGuard(mLock);
+    VhalResult<void> result;
+    std::shared_ptr<DeliveryQueue> unusedQueue;
+    {
+        std::scoped_lock<std::mutex> lockGuard(mLock);
+
+        result = unsubscribeLocked(clientId, propIds);
+        unusedQueue = removeDeliveryQueueIfUnusedLocked(clientId);
+        updateFanOutSnapshotLocked();
+    }
+    if (unusedQueue != nullptr) {
+        unusedQueue->stop();
+    }
+    return result;
+}
 
+VhalResult<void> SubscriptionManager::unsubscribeLocked(SubscriptionManager::ClientIdType clientId,
+                                                        const std::vector<int32_t>& propIds) {
     if (mSubscribedPropsByClient.find(clientId) == mSubscribedPropsByClient.end()) {
         return StatusError(StatusCode::INVALID_ARG)
                << "No property was subscribed for the callback";
@@ -225,8 +369,22 @@ VhalResult<void> SubscriptionManager::unsubscribe(SubscriptionManager::ClientIdT
 }
 
 VhalResult<void> SubscriptionManager::unsubscribe(SubscriptionManager::ClientIdType clientId) {
-    std::scoped_lock<std::mutex> lockGuard(mLock);
+    VhalResult<void> result;
+    std::shared_ptr<DeliveryQueue> unusedQueue;
+    {
+        std::scoped_lock<std::mutex> lockGuard(mLock);
+
+        result = unsubscribeLocked(clientId);
+        unusedQueue = removeDeliveryQueueIfUnusedLocked(clientId);
+        updateFanOutSnapshotLocked();
+    }
+    if (unusedQueue != nullptr) {
+        unusedQueue->stop();
+    }
+    return result;
+}
 
+VhalResult<void> SubscriptionManager::unsubscribeLocked(SubscriptionManager::ClientIdType clientId) {
     if (mSubscribedPropsByClient.find(clientId) == mSubscribedPropsByClient.end()) {
         return StatusError(StatusCode::INVALID_ARG) << "No property was subscribed for this client";
     }
@@ -248,6 +406,121 @@ VhalResult<void> SubscriptionManager::unsubscribe(SubscriptionManager::ClientIdT
     return {};
 }
 
+std::shared_ptr<SubscriptionManager::DeliveryQueue>
+SubscriptionManager::removeDeliveryQueueIfUnusedLocked(SubscriptionManager::ClientIdType clientId) {
+    if (mSubscribedPropsByClient.find(clientId) != mSubscribedPropsByClient.end()) {
+        return nullptr;
+    }
+    auto it = mDeliveryQueuesByClient.find(clientId);
+    if (it == mDeliveryQueuesByClient.end()) {
+        return nullptr;
+    }
+    auto queue = std::move(it->second);
+    mDeliveryQueuesByClient.erase(it);
+    return queue;
+}
+
+void SubscriptionManager::updateFanOutSnapshotLocked() {
+    auto oldSnapshot =
+            std::atomic_load_explicit(&mFanOutSnapshot, std::memory_order_acquire);
+    auto newSnapshot = std::make_shared<FanOutSnapshot>();
+
+    for (const auto& [propIdAreaId, clients] : mClientsByPropIdArea) {
+        const ContSubConfigs* contSubConfigs = nullptr;
+        if (auto it = mContSubConfigsByPropIdArea.find(propIdAreaId);
+            it != mContSubConfigsByPropIdArea.end()) {
+            contSubConfigs = &it->second;
+        }
+
+        std::vector<FanOutRoute>& routes = newSnapshot->routesByPropIdArea[propIdAreaId];
+        const std::vector<FanOutRoute>* oldRoutes = nullptr;
+        if (oldSnapshot != nullptr) {
+            if (auto it = oldSnapshot->routesByPropIdArea.find(propIdAreaId);
+                it != oldSnapshot->routesByPropIdArea.end()) {
+                oldRoutes = &it->second;
+            }
+        }
+
+        for (const auto& [clientId, _] : clients) {
+            FanOutRoute route = {
+                    .queue = mDeliveryQueuesByClient[clientId],
+                    .intervalNanos = 0,
+            };
+            if (contSubConfigs != nullptr) {
+                float sampleRateHz = contSubConfigs->getSampleRateHzForClient(clientId);
+                // Only decimate a client subscribed below the rate the hardware refreshes
+                // this property at, so that a single subscriber is never decimated.
+                if (sampleRateHz > 0 && sampleRateHz < contSubConfigs->getMaxSampleRateHz()) {
+                    if (auto result = getIntervalNanos(sampleRateHz); result.ok()) {
+                        route.intervalNanos = result.value();
+                    }
+                }
+            }
+            // Carry the decimation state over from the previous snapshot for this client.
+            if (oldRoutes != nullptr) {
+                for (const auto& oldRoute : *oldRoutes) {
+                    if (oldRoute.queue == route.queue) {
+                        route.lastEventNanos = oldRoute.lastEventNanos;
+                        break;
+                    }
+                }
+            }
+            if (route.lastEventNanos == nullptr) {
+                route.lastEventNanos = std::make_shared<std::atomic<int64_t>>(0);
+            }
+            routes.push_back(std::move(route));
+        }
+    }
+
+    std::atomic_store_explicit(&mFanOutSnapshot,
+                               std::shared_ptr<const FanOutSnapshot>(std::move(newSnapshot)),
+                               std::memory_order_release);
+}
+
+void SubscriptionManager::onPropertyChangeEvent(const std::vector<VehiclePropValue>& updatedValues) {
+    auto snapshot = std::atomic_load_explicit(&mFanOutSnapshot, std::memory_order_acquire);
+    if (snapshot == nullptr) {
+        return;
+    }
+
+    // Group the values by client first so one batch from hardware stays one batch per client.
+    std::unordered_map<DeliveryQueue*,
+                       std::pair<std::shared_ptr<DeliveryQueue>, std::vector<VehiclePropValue>>>
+            valuesByQueue;
+    int64_t nowNanos = elapsedRealtimeNano();
+    for (const auto& value : updatedValues) {
+        PropIdAreaId propIdAreaId{
+                .propId = value.prop,
+                .areaId = value.areaId,
+        };
+        auto it = snapshot->routesByPropIdArea.find(propIdAreaId);
+        if (it == snapshot->routesByPropIdArea.end()) {
+            continue;
+        }
+
+        for (const auto& route : it->second) {
+            if (route.intervalNanos > 0) {
+                int64_t lastEventNanos =
+                        route.lastEventNanos->load(std::memory_order_relaxed);
+                // Allow 10% jitter so an event arriving marginally early for the client's
+                // rate is not dropped.
+                if (nowNanos - lastEventNanos <
+                    route.intervalNanos - route.intervalNanos / 10) {
+                    continue;
+                }
+                route.lastEventNanos->store(nowNanos, std::memory_order_relaxed);
+            }
+            auto& queueValues = valuesByQueue[route.queue.get()];
+            queueValues.first = route.queue;
+            queueValues.second.push_back(value);
+        }
+    }
+
+    for (auto& [_, queueValues] : valuesByQueue) {
+        queueValues.first->enqueue(std::move(queueValues.second));
+    }
+}
+
 std::unordered_map<std::shared_ptr<IVehicleCallback>, std::vector<const VehiclePropValue*>>
 SubscriptionManager::getSubscribedClients(const std::vector<VehiclePropValue>& updatedValues) {
     std::scoped_lock<std::mutex> lockGuard(mLock);
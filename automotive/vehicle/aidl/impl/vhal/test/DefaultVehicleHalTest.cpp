@@ -1147,6 +1147,10 @@ TEST_F(DefaultVehicleHalTest, testSubscribeGlobalOnChangeNormal) {
 
     ASSERT_TRUE(status.isOk()) << "setValues failed: " << status.getMessage();
 
+    // Events are delivered on the client's delivery thread, wait for the event to arrive.
+    ASSERT_TRUE(getCallback()->waitForOnPropertyEventResults(/*size=*/1,
+                                                             /*timeoutInNano=*/1000000000))
+            << "no results in callback";
     auto maybeResults = getCallback()->nextOnPropertyEventResults();
     ASSERT_TRUE(maybeResults.has_value()) << "no results in callback";
     ASSERT_THAT(maybeResults.value().payloads, UnorderedElementsAre(testValue))
@@ -1192,7 +1196,8 @@ TEST_F(DefaultVehicleHalTest, testSubscribeGlobalOnchangeUnrelatedEventIgnored)
 
     ASSERT_TRUE(status.isOk()) << "setValues failed: " << status.getMessage();
 
-    ASSERT_FALSE(getCallback()->nextOnPropertyEventResults().has_value())
+    ASSERT_FALSE(getCallback()->waitForOnPropertyEventResults(/*size=*/1,
+                                                              /*timeoutInNano=*/100000000))
             << "must receive no property update event if the property is not subscribed";
 }
 
@@ -1233,6 +1238,10 @@ TEST_F(DefaultVehicleHalTest, testSubscribeAreaOnChange) {
 
     ASSERT_TRUE(status.isOk()) << "setValues failed: " << status.getMessage();
 
+    // Events are delivered on the client's delivery thread, wait for the event to arrive.
+    ASSERT_TRUE(getCallback()->waitForOnPropertyEventResults(/*size=*/1,
+                                                             /*timeoutInNano=*/1000000000))
+            << "no results in callback";
     auto maybeResults = getCallback()->nextOnPropertyEventResults();
     ASSERT_TRUE(maybeResults.has_value()) << "no results in callback";
     ASSERT_THAT(maybeResults.value().payloads, UnorderedElementsAre(testValue))
@@ -1291,6 +1300,10 @@ TEST_F(DefaultVehicleHalTest, testSubscribeAreaOnChangeAllAreas) {
 
     ASSERT_TRUE(status.isOk()) << "setValues failed: " << status.getMessage();
 
+    // Events are delivered on the client's delivery thread, wait for the event to arrive.
+    ASSERT_TRUE(getCallback()->waitForOnPropertyEventResults(/*size=*/1,
+                                                             /*timeoutInNano=*/1000000000))
+            << "no results in callback";
     auto maybeResults = getCallback()->nextOnPropertyEventResults();
     ASSERT_TRUE(maybeResults.has_value()) << "no results in callback";
     ASSERT_THAT(maybeResults.value().payloads, UnorderedElementsAre(testValue1, testValue2))
@@ -1442,7 +1455,8 @@ TEST_F(DefaultVehicleHalTest, testUnsubscribeOnChange) {
 
     ASSERT_TRUE(status.isOk()) << "setValues failed: " << status.getMessage();
 
-    ASSERT_FALSE(getCallback()->nextOnPropertyEventResults().has_value())
+    ASSERT_FALSE(getCallback()->waitForOnPropertyEventResults(/*size=*/1,
+                                                              /*timeoutInNano=*/100000000))
             << "No property event should be generated after unsubscription";
 }
 
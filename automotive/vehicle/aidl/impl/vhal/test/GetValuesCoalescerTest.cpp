@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MockVehicleHardware.h"
+
+#include <GetValuesCoalescer.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace android {
+namespace hardware {
+namespace automotive {
+namespace vehicle {
+
+using ::aidl::android::hardware::automotive::vehicle::GetValueRequest;
+using ::aidl::android::hardware::automotive::vehicle::GetValueResult;
+using ::aidl::android::hardware::automotive::vehicle::StatusCode;
+using ::aidl::android::hardware::automotive::vehicle::VehiclePropValue;
+
+using GetValuesCallback = IVehicleHardware::GetValuesCallback;
+
+namespace {
+
+// Use a generous window in test so calls issued back-to-back reliably land inside it.
+constexpr int64_t COALESCE_WINDOW_IN_NANO = 50'000'000;
+constexpr int64_t TIMEOUT_IN_NANO = 30'000'000'000;
+constexpr auto WAIT_TIMEOUT = std::chrono::seconds(1);
+
+// Collects the results delivered to one client's callback.
+class ResultCollector {
+  public:
+    std::shared_ptr<const GetValuesCallback> getCallback() {
+        return std::make_shared<const GetValuesCallback>(
+                [this](std::vector<GetValueResult> results) {
+                    std::scoped_lock<std::mutex> lockGuard(mLock);
+                    for (auto& result : results) {
+                        mResults.push_back(std::move(result));
+                    }
+                    mCv.notify_all();
+                });
+    }
+
+    // Waits until at least {@code count} results arrive, returns all received results.
+    std::vector<GetValueResult> waitForResults(size_t count) {
+        std::unique_lock<std::mutex> lk(mLock);
+        mCv.wait_for(lk, WAIT_TIMEOUT, [this, count] { return mResults.size() >= count; });
+        return mResults;
+    }
+
+  private:
+    std::mutex mLock;
+    std::condition_variable mCv;
+    std::vector<GetValueResult> mResults;
+};
+
+GetValueRequest createRequest(int64_t requestId, int32_t propId) {
+    GetValueRequest request;
+    request.requestId = requestId;
+    request.prop.prop = propId;
+    return request;
+}
+
+}  // namespace
+
+class GetValuesCoalescerTest : public ::testing::Test {
+  public:
+    void SetUp() override {
+        mHardware = std::make_shared<MockVehicleHardware>();
+        mCoalescer = std::make_unique<GetValuesCoalescer>(mHardware.get(),
+                                                          COALESCE_WINDOW_IN_NANO,
+                                                          TIMEOUT_IN_NANO);
+    }
+
+    MockVehicleHardware* getHardware() { return mHardware.get(); }
+
+    GetValuesCoalescer* getCoalescer() { return mCoalescer.get(); }
+
+    // Makes the mock hardware answer each request with an OK result echoing the request's
+    // property, and records every request batch it receives.
+    void setEchoResponder(std::vector<std::vector<GetValueRequest>>* receivedBatches,
+                          std::mutex* lock) {
+        mHardware->setGetValueResponder(
+                [receivedBatches, lock](std::shared_ptr<const GetValuesCallback> callback,
+                                        const std::vector<GetValueRequest>& requests) {
+                    {
+                        std::scoped_lock<std::mutex> lockGuard(*lock);
+                        receivedBatches->push_back(requests);
+                    }
+                    std::vector<GetValueResult> results;
+                    for (const auto& request : requests) {
+                        results.push_back(GetValueResult{
+                                .requestId = request.requestId,
+                                .status = StatusCode::OK,
+                                .prop = request.prop,
+                        });
+                    }
+                    (*callback)(std::move(results));
+                    return StatusCode::OK;
+                });
+    }
+
+  private:
+    std::shared_ptr<MockVehicleHardware> mHardware;
+    std::unique_ptr<GetValuesCoalescer> mCoalescer;
+};
+
+TEST_F(GetValuesCoalescerTest, testIsolatedBatchDispatchedInline) {
+    std::vector<std::vector<GetValueRequest>> receivedBatches;
+    std::mutex lock;
+    setEchoResponder(&receivedBatches, &lock);
+
+    ResultCollector client;
+    std::vector<GetValueRequest> requests = {createRequest(0, 1), createRequest(1, 2)};
+
+    auto status = getCoalescer()->getValues(client.getCallback(), requests);
+
+    ASSERT_EQ(status, StatusCode::OK);
+    {
+        std::scoped_lock<std::mutex> lockGuard(lock);
+        // An isolated batch must reach hardware synchronously with the client's own request IDs.
+        ASSERT_EQ(receivedBatches.size(), static_cast<size_t>(1));
+        ASSERT_EQ(receivedBatches[0], requests);
+    }
+
+    auto results = client.waitForResults(2);
+    ASSERT_EQ(results.size(), static_cast<size_t>(2));
+    ASSERT_EQ(results[0].requestId, 0);
+    ASSERT_EQ(results[1].requestId, 1);
+}
+
+TEST_F(GetValuesCoalescerTest, testInlineDispatchReturnsHardwareError) {
+    getHardware()->setStatus("getValues", StatusCode::INTERNAL_ERROR);
+
+    ResultCollector client;
+    std::vector<GetValueRequest> requests = {createRequest(0, 1)};
+
+    auto status = getCoalescer()->getValues(client.getCallback(), requests);
+
+    // An inline dispatch surfaces the hardware status to the caller directly.
+    ASSERT_EQ(status, StatusCode::INTERNAL_ERROR);
+}
+
+TEST_F(GetValuesCoalescerTest, testOverlappingBatchesCoalescedIntoOneHardwareCall) {
+    std::vector<std::vector<GetValueRequest>> receivedBatches;
+    std::mutex lock;
+    setEchoResponder(&receivedBatches, &lock);
+
+    ResultCollector client1;
+    ResultCollector client2;
+    ResultCollector client3;
+    // Client-chosen request IDs deliberately collide across clients.
+    std::vector<GetValueRequest> requests1 = {createRequest(0, 1)};
+    std::vector<GetValueRequest> requests2 = {createRequest(0, 2), createRequest(1, 3)};
+    std::vector<GetValueRequest> requests3 = {createRequest(0, 4)};
+
+    // The first batch goes down inline and opens the coalesce window; the next two overlap
+    // with the window and must merge into a single hardware call.
+    ASSERT_EQ(getCoalescer()->getValues(client1.getCallback(), requests1), StatusCode::OK);
+    ASSERT_EQ(getCoalescer()->getValues(client2.getCallback(), requests2), StatusCode::OK);
+    ASSERT_EQ(getCoalescer()->getValues(client3.getCallback(), requests3), StatusCode::OK);
+
+    auto results2 = client2.waitForResults(2);
+    auto results3 = client3.waitForResults(1);
+
+    // Each client gets its results back under its original request IDs.
+    ASSERT_EQ(results2.size(), static_cast<size_t>(2));
+    EXPECT_EQ(results2[0].requestId, 0);
+    EXPECT_EQ(results2[0].prop->prop, 2);
+    EXPECT_EQ(results2[1].requestId, 1);
+    EXPECT_EQ(results2[1].prop->prop, 3);
+    ASSERT_EQ(results3.size(), static_cast<size_t>(1));
+    EXPECT_EQ(results3[0].requestId, 0);
+    EXPECT_EQ(results3[0].prop->prop, 4);
+
+    {
+        std::scoped_lock<std::mutex> lockGuard(lock);
+        // One inline batch plus one coalesced batch for the two overlapping calls.
+        ASSERT_EQ(receivedBatches.size(), static_cast<size_t>(2));
+        ASSERT_EQ(receivedBatches[1].size(), static_cast<size_t>(3));
+    }
+    EXPECT_EQ(getCoalescer()->countClientCalls(), static_cast<size_t>(3));
+    EXPECT_EQ(getCoalescer()->countDispatchedBatches(), static_cast<size_t>(2));
+}
+
+TEST_F(GetValuesCoalescerTest, testCoalescedBatchHardwareErrorDeliveredThroughCallback) {
+    std::vector<std::vector<GetValueRequest>> receivedBatches;
+    std::mutex lock;
+    setEchoResponder(&receivedBatches, &lock);
+
+    ResultCollector client1;
+    ResultCollector client2;
+
+    // Open the window with an inline dispatch, then fail the coalesced dispatch.
+    ASSERT_EQ(getCoalescer()->getValues(client1.getCallback(), {createRequest(0, 1)}),
+              StatusCode::OK);
+    getHardware()->setGetValueResponder(
+            [](std::shared_ptr<const GetValuesCallback>, const std::vector<GetValueRequest>&) {
+                return StatusCode::TRY_AGAIN;
+            });
+    ASSERT_EQ(getCoalescer()->getValues(client2.getCallback(), {createRequest(42, 2)}),
+              StatusCode::OK);
+
+    // The issuing call has already returned OK, so the hardware error must arrive as a
+    // per-request error result under the client's original ID.
+    auto results = client2.waitForResults(1);
+    ASSERT_EQ(results.size(), static_cast<size_t>(1));
+    EXPECT_EQ(results[0].requestId, 42);
+    EXPECT_EQ(results[0].status, StatusCode::TRY_AGAIN);
+}
+
+}  // namespace vehicle
+}  // namespace automotive
+}  // namespace hardware
+}  // namespace android
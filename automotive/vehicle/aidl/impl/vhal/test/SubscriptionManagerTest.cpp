@@ -485,6 +485,130 @@ TEST_F(SubscriptionManagerTest, testUnsubscribeOnchange) {
     ASSERT_THAT(clients[getCallbackClient()], ElementsAre(&updatedValues[1]));
 }
 
+TEST_F(SubscriptionManagerTest, testOnPropertyChangeEventDeliversToSubscribedClients) {
+    std::shared_ptr<PropertyCallback> callback1 = ndk::SharedRefBase::make<PropertyCallback>();
+    SpAIBinder binder1 = callback1->asBinder();
+    std::shared_ptr<IVehicleCallback> client1 = IVehicleCallback::fromBinder(binder1);
+    std::shared_ptr<PropertyCallback> callback2 = ndk::SharedRefBase::make<PropertyCallback>();
+    SpAIBinder binder2 = callback2->asBinder();
+    std::shared_ptr<IVehicleCallback> client2 = IVehicleCallback::fromBinder(binder2);
+
+    std::vector<SubscribeOptions> options1 = {{
+            .propId = 0,
+            .areaIds = {0},
+    }};
+    std::vector<SubscribeOptions> options2 = {{
+            .propId = 1,
+            .areaIds = {0},
+    }};
+
+    auto result = getManager()->subscribe(client1, options1, false);
+    ASSERT_TRUE(result.ok()) << "failed to subscribe: " << result.error().message();
+    result = getManager()->subscribe(client2, options2, false);
+    ASSERT_TRUE(result.ok()) << "failed to subscribe: " << result.error().message();
+
+    getManager()->onPropertyChangeEvent({
+            {
+                    .prop = 0,
+                    .areaId = 0,
+            },
+            {
+                    .prop = 1,
+                    .areaId = 0,
+            },
+            {
+                    .prop = 2,
+                    .areaId = 0,
+            },
+    });
+
+    // Events are delivered on each client's own delivery thread.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    auto events1 = callback1->getEvents();
+    ASSERT_EQ(events1.size(), static_cast<size_t>(1));
+    EXPECT_EQ(events1.front().prop, 0);
+    auto events2 = callback2->getEvents();
+    ASSERT_EQ(events2.size(), static_cast<size_t>(1));
+    EXPECT_EQ(events2.front().prop, 1);
+}
+
+TEST_F(SubscriptionManagerTest, testOnPropertyChangeEventDecimatesSlowerClient) {
+    std::shared_ptr<PropertyCallback> fastCallback = ndk::SharedRefBase::make<PropertyCallback>();
+    SpAIBinder fastBinder = fastCallback->asBinder();
+    std::shared_ptr<IVehicleCallback> fastClient = IVehicleCallback::fromBinder(fastBinder);
+    std::shared_ptr<PropertyCallback> slowCallback = ndk::SharedRefBase::make<PropertyCallback>();
+    SpAIBinder slowBinder = slowCallback->asBinder();
+    std::shared_ptr<IVehicleCallback> slowClient = IVehicleCallback::fromBinder(slowBinder);
+
+    std::vector<SubscribeOptions> fastOptions = {{
+            .propId = 0,
+            .areaIds = {0},
+            .sampleRate = 100.0,
+    }};
+    std::vector<SubscribeOptions> slowOptions = {{
+            .propId = 0,
+            .areaIds = {0},
+            .sampleRate = 10.0,
+    }};
+
+    auto result = getManager()->subscribe(fastClient, fastOptions, true);
+    ASSERT_TRUE(result.ok()) << "failed to subscribe: " << result.error().message();
+    result = getManager()->subscribe(slowClient, slowOptions, true);
+    ASSERT_TRUE(result.ok()) << "failed to subscribe: " << result.error().message();
+
+    // Simulate the hardware refreshing the property at the max subscribed rate: 100Hz for
+    // 300ms.
+    for (int i = 0; i < 30; i++) {
+        getManager()->onPropertyChangeEvent({{
+                .prop = 0,
+                .areaId = 0,
+        }});
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // The client subscribed at the hardware rate must get every event, check for at least 20
+    // of the 30 to be stable.
+    EXPECT_GE(fastCallback->getEvents().size(), static_cast<size_t>(20));
+    // The 10Hz client must be decimated to roughly 3 events over 300ms.
+    EXPECT_GE(slowCallback->getEvents().size(), static_cast<size_t>(1));
+    EXPECT_LE(slowCallback->getEvents().size(), static_cast<size_t>(8));
+}
+
+TEST_F(SubscriptionManagerTest, testOnPropertyChangeEventCoalescesEventStorm) {
+    std::shared_ptr<PropertyCallback> callback = ndk::SharedRefBase::make<PropertyCallback>();
+    SpAIBinder binder = callback->asBinder();
+    std::shared_ptr<IVehicleCallback> client = IVehicleCallback::fromBinder(binder);
+
+    std::vector<SubscribeOptions> options = {{
+            .propId = 0,
+            .areaIds = {0},
+    }};
+
+    auto result = getManager()->subscribe(client, options, false);
+    ASSERT_TRUE(result.ok()) << "failed to subscribe: " << result.error().message();
+
+    // Fire a storm of one-event batches, much faster than the per-client call budget allows
+    // delivering them individually.
+    constexpr size_t eventCount = 200;
+    for (size_t i = 0; i < eventCount; i++) {
+        getManager()->onPropertyChangeEvent({{
+                .prop = 0,
+                .areaId = 0,
+                .value.int32Values = {static_cast<int32_t>(i)},
+        }});
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    // Every event must still arrive, but merged into far fewer binder transactions than
+    // batches were enqueued.
+    EXPECT_EQ(callback->getEvents().size(), eventCount);
+    EXPECT_EQ(getManager()->countDeliveredEvents(), eventCount);
+    EXPECT_LT(getManager()->countPropertyEventCalls(), eventCount);
+}
+
 TEST_F(SubscriptionManagerTest, testCheckSampleRateHzValid) {
     ASSERT_TRUE(SubscriptionManager::checkSampleRateHz(1.0));
 }
@@ -89,6 +89,8 @@ void FakeFingerprintEngine::detectInteractionImpl(ISessionCallback* cb,
 void FakeFingerprintEngine::updateContext(WorkMode mode, ISessionCallback* cb,
                                           std::future<void>& cancel, int64_t operationId,
                                           const keymaster::HardwareAuthToken& hat) {
+    recordStateTransition("mode " + std::to_string((int)mWorkMode) + "->" +
+                          std::to_string((int)mode));
     mCancel = std::move(cancel);
     mWorkMode = mode;
     mCb = cb;
@@ -115,10 +117,19 @@ void FakeFingerprintEngine::fingerDownAction() {
     }
 
     if (isTerminal) {
+        recordStateTransition("mode " + std::to_string((int)mWorkMode) + "->" +
+                              std::to_string((int)WorkMode::kIdle));
         mWorkMode = WorkMode::kIdle;
     }
 }
 
+void FakeFingerprintEngine::recordStateTransition(const std::string& event) {
+    if (mStateTrace.size() >= MAX_STATE_TRACE_ENTRIES) {
+        mStateTrace.pop_front();
+    }
+    mStateTrace.push_back(std::to_string(Util::getSystemNanoTime() / 1000000) + "ms: " + event);
+}
+
 bool FakeFingerprintEngine::onEnrollFingerDown(ISessionCallback* cb,
                                                const keymaster::HardwareAuthToken&,
                                                const std::future<void>& cancel) {
@@ -548,6 +559,13 @@ int32_t FakeFingerprintEngine::getLatency(
         const std::vector<std::optional<std::int32_t>>& latencyIn) {
     int32_t res = DEFAULT_LATENCY;
 
+    // Reseed on seed change so ranged latencies replay the same sequence.
+    auto seed = FingerprintHalProperties::operation_latency_seed();
+    if (seed.has_value() && seed != mLatencySeed) {
+        mRandom.seed((std::mt19937::result_type)*seed);
+        mLatencySeed = seed;
+    }
+
     std::vector<int32_t> latency;
     for (auto x : latencyIn)
         if (x.has_value()) latency.push_back(*x);
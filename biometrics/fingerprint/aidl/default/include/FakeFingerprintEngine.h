@@ -26,6 +26,7 @@
 #include <random>
 
 #include <aidl/android/hardware/biometrics/fingerprint/SensorLocation.h>
+#include <deque>
 #include <future>
 #include <vector>
 
@@ -87,6 +88,8 @@ class FakeFingerprintEngine {
         os << "acquiredVendorInfoBase:" << FINGERPRINT_ACQUIRED_VENDOR_BASE;
         os << ", errorVendorBase:" << FINGERPRINT_ERROR_VENDOR_BASE << std::endl;
         os << mLockoutTracker.toString();
+        os << "----- state transitions -----" << std::endl;
+        for (const auto& entry : mStateTrace) os << entry << std::endl;
         return os.str();
     }
 
@@ -99,6 +102,10 @@ class FakeFingerprintEngine {
     bool onAuthenticateFingerDown(ISessionCallback* cb, int64_t, const std::future<void>& cancel);
     bool onDetectInteractFingerDown(ISessionCallback* cb, const std::future<void>& cancel);
 
+    // Append a timestamped entry to the state-transition trace shown in
+    // dumpsys; the oldest entry is dropped once the buffer is full.
+    void recordStateTransition(const std::string& event);
+
     WorkMode mWorkMode;
     ISessionCallback* mCb;
     keymaster::HardwareAuthToken mHat;
@@ -116,6 +123,11 @@ class FakeFingerprintEngine {
     bool checkSensorLockout(ISessionCallback*);
     void clearLockout(ISessionCallback* cb);
 
+    static constexpr size_t MAX_STATE_TRACE_ENTRIES = 256;
+    std::deque<std::string> mStateTrace;
+    // seed last applied to mRandom via operation_latency_seed
+    std::optional<int64_t> mLatencySeed;
+
     FakeLockoutTracker mLockoutTracker;
 
   protected:
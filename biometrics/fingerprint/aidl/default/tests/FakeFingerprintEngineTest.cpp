@@ -505,6 +505,38 @@ TEST_F(FakeFingerprintEngineTest, randomLatency) {
     ASSERT_TRUE(latencySet.size() > 95);
 }
 
+TEST_F(FakeFingerprintEngineTest, deterministicLatency) {
+    FingerprintHalProperties::operation_detect_interaction_latency({1, 1000});
+    FingerprintHalProperties::operation_latency_seed(42);
+    std::vector<int32_t> latencies;
+    for (int i = 0; i < 10; i++) {
+        latencies.push_back(mEngine.getLatency(
+                FingerprintHalProperties::operation_detect_interaction_latency()));
+    }
+    // a different seed draws a different sequence; re-applying the original
+    // seed replays the original one
+    FingerprintHalProperties::operation_latency_seed(1);
+    mEngine.getLatency(FingerprintHalProperties::operation_detect_interaction_latency());
+    FingerprintHalProperties::operation_latency_seed(42);
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(latencies[i],
+                  mEngine.getLatency(
+                          FingerprintHalProperties::operation_detect_interaction_latency()));
+    }
+    FingerprintHalProperties::operation_latency_seed({});
+}
+
+TEST_F(FakeFingerprintEngineTest, stateTransitionTrace) {
+    FingerprintHalProperties::enrollments({1});
+    FingerprintHalProperties::enrollment_hit(1);
+    mEngine.authenticateImpl(mCallback.get(), 0, mCancel.get_future());
+    mEngine.fingerDownAction();
+    auto dump = mEngine.toString();
+    ASSERT_NE(dump.find("state transitions"), std::string::npos);
+    ASSERT_NE(dump.find("mode 0->1"), std::string::npos);
+    ASSERT_NE(dump.find("mode 1->0"), std::string::npos);
+}
+
 TEST_F(FakeFingerprintEngineTest, lockoutTimer) {
     mEngine.startLockoutTimer(200, mCallback.get());
     ASSERT_TRUE(mEngine.getLockoutTimerStarted());
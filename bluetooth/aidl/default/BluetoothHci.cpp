@@ -255,6 +255,8 @@ ndk::ScopedAStatus BluetoothHci::initialize(
   mFdWatcher.WatchFdForNonBlockingReads(mFd,
                                         [this](int) { mH4->OnDataReady(); });
 
+  startDataWriter();
+
   {
     std::lock_guard<std::mutex> guard(mStateMutex);
     mState = HalState::ONE_CLIENT;
@@ -284,6 +286,7 @@ ndk::ScopedAStatus BluetoothHci::close() {
     mState = HalState::CLOSING;
   }
 
+  stopDataWriter();
   mFdWatcher.StopWatchingFileDescriptors();
 
   if (management_) {
@@ -307,7 +310,7 @@ ndk::ScopedAStatus BluetoothHci::sendHciCommand(
 
 ndk::ScopedAStatus BluetoothHci::sendAclData(
     const std::vector<uint8_t>& packet) {
-  send(PacketType::ACL_DATA, packet);
+  queueData(PacketType::ACL_DATA, packet);
   return ndk::ScopedAStatus::ok();
 }
 
@@ -319,7 +322,7 @@ ndk::ScopedAStatus BluetoothHci::sendScoData(
 
 ndk::ScopedAStatus BluetoothHci::sendIsoData(
     const std::vector<uint8_t>& packet) {
-  send(PacketType::ISO_DATA, packet);
+  queueData(PacketType::ISO_DATA, packet);
   return ndk::ScopedAStatus::ok();
 }
 
@@ -327,4 +330,70 @@ void BluetoothHci::send(PacketType type, const std::vector<uint8_t>& v) {
   mH4->Send(type, v);
 }
 
+void BluetoothHci::queueData(PacketType type,
+                             const std::vector<uint8_t>& packet) {
+  {
+    std::unique_lock<std::mutex> lock(mDataLock);
+    if (mDataWriterStop) {
+      // Closing; the controller is about to go away.
+      return;
+    }
+    if (!mDataWriter.joinable()) {
+      // No writer running (not initialized); send inline.
+      lock.unlock();
+      send(type, packet);
+      return;
+    }
+    // Credit-based flow control: block the binder caller instead of letting
+    // the queue grow without bound when the controller falls behind.
+    mDataCreditCv.wait(lock, [this] {
+      return mDataQueue.size() < kDataCredits || mDataWriterStop;
+    });
+    if (mDataWriterStop) {
+      return;
+    }
+    mDataQueue.emplace_back(type, packet);
+  }
+  mDataCv.notify_one();
+}
+
+void BluetoothHci::dataWriterLoop() {
+  std::vector<std::pair<PacketType, std::vector<uint8_t>>> burst;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mDataLock);
+      mDataCv.wait(lock,
+                   [this] { return !mDataQueue.empty() || mDataWriterStop; });
+      if (mDataQueue.empty()) {
+        return;
+      }
+      burst.swap(mDataQueue);
+    }
+    mDataCreditCv.notify_all();
+    mH4->Send(burst);
+    burst.clear();
+  }
+}
+
+void BluetoothHci::startDataWriter() {
+  std::lock_guard<std::mutex> guard(mDataLock);
+  mDataWriterStop = false;
+  mDataQueue.clear();
+  mDataWriter = std::thread([this] { dataWriterLoop(); });
+}
+
+void BluetoothHci::stopDataWriter() {
+  {
+    std::lock_guard<std::mutex> guard(mDataLock);
+    if (!mDataWriter.joinable()) {
+      return;
+    }
+    mDataWriterStop = true;
+  }
+  mDataCv.notify_all();
+  mDataCreditCv.notify_all();
+  mDataWriter.join();
+  mDataWriter = std::thread();
+}
+
 }  // namespace aidl::android::hardware::bluetooth::impl
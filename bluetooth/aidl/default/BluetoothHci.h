@@ -19,8 +19,13 @@
 #include <aidl/android/hardware/bluetooth/BnBluetoothHci.h>
 #include <aidl/android/hardware/bluetooth/IBluetoothHciCallbacks.h>
 
+#include <condition_variable>
 #include <future>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "async_fd_watcher.h"
 #include "h4_protocol.h"
@@ -73,6 +78,26 @@ class BluetoothHci : public BnBluetoothHci {
   // Send a reset command and discard all packets until a reset is received.
   void reset();
 
+  // Outbound ACL/ISO data is queued under credit-based flow control and
+  // drained by a dedicated writer thread as one writev burst per wakeup, so
+  // back-to-back data packets from binder threads collapse into a single
+  // syscall. Commands and SCO stay on the direct send path for ordering.
+  void queueData(::android::hardware::bluetooth::hci::PacketType type,
+                 const std::vector<uint8_t>& packet);
+  void dataWriterLoop();
+  void startDataWriter();
+  void stopDataWriter();
+
+  static constexpr size_t kDataCredits = 16;
+  std::thread mDataWriter;
+  std::mutex mDataLock;
+  std::condition_variable mDataCv;
+  std::condition_variable mDataCreditCv;
+  std::vector<std::pair<::android::hardware::bluetooth::hci::PacketType,
+                        std::vector<uint8_t>>>
+      mDataQueue;
+  bool mDataWriterStop{false};
+
   // Don't close twice or open before close is complete
   std::mutex mStateMutex;
   enum class HalState {
@@ -22,6 +22,10 @@
 #include <BluetoothAudioSessionReport.h>
 #include <android-base/logging.h>
 
+#include <algorithm>
+
+#include "BluetoothAudioProviderFactory.h"
+
 namespace aidl {
 namespace android {
 namespace hardware {
@@ -87,6 +91,26 @@ ndk::ScopedAStatus A2dpSoftwareAudioProvider::startSession(
     return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
   }
 
+  // A stack that can drive the low latency mode gets a single buffer queue
+  // instead of the double buffered default, halving the worst case amount of
+  // audio queued between the audio HAL and the stack.
+  bool low_latency = std::find(latency_modes.begin(), latency_modes.end(),
+                               LatencyMode::LOW_LATENCY) != latency_modes.end();
+  uint32_t data_mq_size = kBufferSize * (low_latency ? 1 : kBufferCount);
+  if (data_mq_ == nullptr || data_mq_->getQuantumCount() != data_mq_size) {
+    std::unique_ptr<DataMQ> data_mq(
+        new DataMQ(data_mq_size, /* EventFlag */ true));
+    if (data_mq == nullptr || !data_mq->isValid()) {
+      ALOGE_IF(!data_mq, "failed to allocate data MQ");
+      ALOGE_IF(data_mq && !data_mq->isValid(), "data MQ is invalid");
+      *_aidl_return = DataMQDesc();
+      return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
+    }
+    data_mq_ = std::move(data_mq);
+  }
+  BluetoothAudioProviderFactory::RecordSessionDataMqSize(
+      session_type_, data_mq_size, low_latency);
+
   return BluetoothAudioProvider::startSession(
       host_if, audio_config, latency_modes, _aidl_return);
 }
@@ -21,6 +21,9 @@
 #include <BluetoothAudioCodecs.h>
 #include <android-base/logging.h>
 
+#include <map>
+#include <mutex>
+
 #include "A2dpOffloadAudioProvider.h"
 #include "A2dpSoftwareAudioProvider.h"
 #include "BluetoothAudioProvider.h"
@@ -34,8 +37,45 @@ namespace hardware {
 namespace bluetooth {
 namespace audio {
 
+namespace {
+
+// Per session type record of the last data MQ sizing decision. The records
+// outlive the providers so the debug dump covers closed sessions as well.
+struct DataMqSizingRecord {
+  uint32_t last_data_mq_size = 0;
+  bool last_low_latency = false;
+  uint32_t session_count = 0;
+};
+
+std::mutex g_sizing_records_lock;
+std::map<SessionType, DataMqSizingRecord> g_sizing_records;
+
+}  // namespace
+
 BluetoothAudioProviderFactory::BluetoothAudioProviderFactory() {}
 
+void BluetoothAudioProviderFactory::RecordSessionDataMqSize(
+    SessionType session_type, uint32_t data_mq_size, bool low_latency) {
+  std::lock_guard<std::mutex> guard(g_sizing_records_lock);
+  DataMqSizingRecord& record = g_sizing_records[session_type];
+  record.last_data_mq_size = data_mq_size;
+  record.last_low_latency = low_latency;
+  record.session_count++;
+}
+
+binder_status_t BluetoothAudioProviderFactory::dump(int fd,
+                                                    const char** /* args */,
+                                                    uint32_t /* numArgs */) {
+  std::lock_guard<std::mutex> guard(g_sizing_records_lock);
+  dprintf(fd, "Software session data MQ sizing:\n");
+  for (const auto& [session_type, record] : g_sizing_records) {
+    dprintf(fd, "  %s: last size %u byte(s), low latency %d, sessions %u\n",
+            toString(session_type).c_str(), record.last_data_mq_size,
+            record.last_low_latency, record.session_count);
+  }
+  return STATUS_OK;
+}
+
 ndk::ScopedAStatus BluetoothAudioProviderFactory::openProvider(
     const SessionType session_type,
     std::shared_ptr<IBluetoothAudioProvider>* _aidl_return) {
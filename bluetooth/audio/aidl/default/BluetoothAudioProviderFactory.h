@@ -35,6 +35,13 @@ class BluetoothAudioProviderFactory : public BnBluetoothAudioProviderFactory {
   ndk::ScopedAStatus getProviderCapabilities(
       const SessionType session_type,
       std::vector<AudioCapabilities>* _aidl_return) override;
+
+  binder_status_t dump(int fd, const char** args, uint32_t numArgs) override;
+
+  // Records the data MQ sizing decision of a software session so it shows up
+  // in the factory's debug dump.
+  static void RecordSessionDataMqSize(SessionType session_type,
+                                      uint32_t data_mq_size, bool low_latency);
 };
 
 }  // namespace audio
@@ -20,6 +20,7 @@
 
 #include <BluetoothAudioCodecs.h>
 #include <BluetoothAudioSessionReport.h>
+#include <BluetoothLeAudioCodecsProvider.h>
 #include <android-base/logging.h>
 
 namespace aidl {
@@ -28,6 +29,14 @@ namespace hardware {
 namespace bluetooth {
 namespace audio {
 
+static inline uint64_t capabilityKey(const CodecType& codec_type,
+                                     int32_t sampling_frequency_hz,
+                                     int32_t frame_duration_us) {
+  return (static_cast<uint64_t>(codec_type) << 48) |
+         (static_cast<uint64_t>(sampling_frequency_hz & 0xFFFFFF) << 24) |
+         static_cast<uint64_t>(frame_duration_us & 0xFFFFFF);
+}
+
 LeAudioOffloadOutputAudioProvider::LeAudioOffloadOutputAudioProvider()
     : LeAudioOffloadAudioProvider() {
   session_type_ = SessionType::LE_AUDIO_HARDWARE_OFFLOAD_ENCODING_DATAPATH;
@@ -45,7 +54,101 @@ LeAudioOffloadBroadcastAudioProvider::LeAudioOffloadBroadcastAudioProvider()
 }
 
 LeAudioOffloadAudioProvider::LeAudioOffloadAudioProvider()
-    : BluetoothAudioProvider() {}
+    : BluetoothAudioProvider() {
+  buildCapabilityIndex();
+}
+
+void LeAudioOffloadAudioProvider::buildCapabilityIndex() {
+  auto le_audio_offload_setting =
+      BluetoothLeAudioCodecsProvider::ParseFromLeAudioOffloadSettingFile();
+  auto capabilities = BluetoothLeAudioCodecsProvider::GetLeAudioCodecCapabilities(
+      le_audio_offload_setting);
+  for (const auto& capability : capabilities) {
+    indexUnicastCapability(capability.unicastEncodeCapability);
+    indexUnicastCapability(capability.unicastDecodeCapability);
+    indexBroadcastCapability(capability.broadcastCapability);
+  }
+}
+
+void LeAudioOffloadAudioProvider::indexUnicastCapability(
+    const UnicastCapability& capability) {
+  if (capability.codecType != CodecType::LC3 ||
+      capability.leAudioCodecCapabilities.getTag() !=
+          UnicastCapability::LeAudioCodecCapabilities::lc3Capabilities) {
+    return;
+  }
+  indexLc3Capability(capability.codecType,
+                     capability.leAudioCodecCapabilities.get<
+                         UnicastCapability::LeAudioCodecCapabilities::
+                             lc3Capabilities>());
+}
+
+void LeAudioOffloadAudioProvider::indexBroadcastCapability(
+    const BroadcastCapability& capability) {
+  if (capability.codecType != CodecType::LC3 ||
+      capability.leAudioCodecCapabilities.getTag() !=
+          BroadcastCapability::LeAudioCodecCapabilities::lc3Capabilities) {
+    return;
+  }
+  auto& lc3_capabilities =
+      capability.leAudioCodecCapabilities.get<
+          BroadcastCapability::LeAudioCodecCapabilities::lc3Capabilities>();
+  if (!lc3_capabilities.has_value()) {
+    return;
+  }
+  for (const auto& lc3_capability : *lc3_capabilities) {
+    if (lc3_capability.has_value()) {
+      indexLc3Capability(capability.codecType, *lc3_capability);
+    }
+  }
+}
+
+void LeAudioOffloadAudioProvider::indexLc3Capability(
+    const CodecType& codec_type, const Lc3Capabilities& lc3_capability) {
+  for (int32_t sampling_frequency_hz : lc3_capability.samplingFrequencyHz) {
+    for (int32_t frame_duration_us : lc3_capability.frameDurationUs) {
+      capability_index_.insert(
+          capabilityKey(codec_type, sampling_frequency_hz, frame_duration_us));
+    }
+  }
+}
+
+bool LeAudioOffloadAudioProvider::isSupportedCodecConfiguration(
+    const AudioConfiguration& audio_config) {
+  if (capability_index_.empty()) {
+    // No offload capabilities parsed; nothing to match against.
+    return true;
+  }
+  if (audio_config.getTag() == AudioConfiguration::leAudioConfig) {
+    auto& le_config = audio_config.get<AudioConfiguration::leAudioConfig>();
+    if (le_config.leAudioCodecConfig.getTag() !=
+        LeAudioCodecConfiguration::lc3Config) {
+      // Only LC3 configurations are indexed.
+      return true;
+    }
+    auto& lc3_config =
+        le_config.leAudioCodecConfig.get<LeAudioCodecConfiguration::lc3Config>();
+    return capability_index_.count(
+               capabilityKey(le_config.codecType, lc3_config.samplingFrequencyHz,
+                             lc3_config.frameDurationUs)) != 0;
+  }
+  auto& broadcast_config =
+      audio_config.get<AudioConfiguration::leAudioBroadcastConfig>();
+  for (const auto& stream : broadcast_config.streamMap) {
+    if (stream.leAudioCodecConfig.getTag() !=
+        LeAudioCodecConfiguration::lc3Config) {
+      continue;
+    }
+    auto& lc3_config =
+        stream.leAudioCodecConfig.get<LeAudioCodecConfiguration::lc3Config>();
+    if (capability_index_.count(capabilityKey(
+            broadcast_config.codecType, lc3_config.samplingFrequencyHz,
+            lc3_config.frameDurationUs)) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
 
 bool LeAudioOffloadAudioProvider::isValid(const SessionType& sessionType) {
   return (sessionType == session_type_);
@@ -70,6 +173,13 @@ ndk::ScopedAStatus LeAudioOffloadAudioProvider::startSession(
     return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
   }
 
+  if (!isSupportedCodecConfiguration(audio_config)) {
+    LOG(WARNING) << __func__ << " - Unsupported Codec Configuration="
+                 << audio_config.toString();
+    *_aidl_return = DataMQDesc();
+    return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
+  }
+
   return BluetoothAudioProvider::startSession(
       host_if, audio_config, latency_modes, _aidl_return);
 }
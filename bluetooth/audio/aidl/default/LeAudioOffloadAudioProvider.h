@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <unordered_set>
+
 #include "BluetoothAudioProvider.h"
 
 namespace aidl {
@@ -38,6 +41,20 @@ class LeAudioOffloadAudioProvider : public BluetoothAudioProvider {
 
  private:
   ndk::ScopedAStatus onSessionReady(DataMQDesc* _aidl_return) override;
+
+  // Capability index keyed on (codecType, samplingFrequencyHz,
+  // frameDurationUs), built once at provider construction from the parsed
+  // offload capabilities, so startSession() validates the requested codec
+  // configuration with a single hash lookup instead of scanning the
+  // capability lists.
+  void buildCapabilityIndex();
+  void indexUnicastCapability(const UnicastCapability& capability);
+  void indexBroadcastCapability(const BroadcastCapability& capability);
+  void indexLc3Capability(const CodecType& codec_type,
+                          const Lc3Capabilities& lc3_capability);
+  bool isSupportedCodecConfiguration(const AudioConfiguration& audio_config);
+
+  std::unordered_set<uint64_t> capability_index_;
 };
 
 class LeAudioOffloadOutputAudioProvider : public LeAudioOffloadAudioProvider {
@@ -22,8 +22,11 @@
 #include <BluetoothAudioSessionReport.h>
 #include <android-base/logging.h>
 
+#include <algorithm>
 #include <cstdint>
 
+#include "BluetoothAudioProviderFactory.h"
+
 namespace aidl {
 namespace android {
 namespace hardware {
@@ -91,6 +94,15 @@ ndk::ScopedAStatus LeAudioSoftwareAudioProvider::startSession(
   else if (session_type_ == SessionType::LE_AUDIO_SOFTWARE_DECODING_DATAPATH)
     buffer_modifier = kBufferInCount;
 
+  // A stack that can drive the low latency mode keeps the queue at a single
+  // data interval instead of double buffering, so a burst of queued audio
+  // cannot grow beyond one interval of end-to-end delay.
+  bool low_latency = std::find(latency_modes.begin(), latency_modes.end(),
+                               LatencyMode::LOW_LATENCY) != latency_modes.end();
+  if (low_latency && buffer_modifier > 1) {
+    buffer_modifier = 1;
+  }
+
   // 24 bit audio stream is sent as unpacked
   int bytes_per_sample =
       (pcm_config.bitsPerSample == 24) ? 4 : (pcm_config.bitsPerSample / 8);
@@ -123,6 +135,8 @@ ndk::ScopedAStatus LeAudioSoftwareAudioProvider::startSession(
     return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
   }
   data_mq_ = std::move(temp_data_mq);
+  BluetoothAudioProviderFactory::RecordSessionDataMqSize(
+      session_type_, data_mq_size, low_latency);
 
   return BluetoothAudioProvider::startSession(
       host_if, audio_config, latency_modes, _aidl_return);
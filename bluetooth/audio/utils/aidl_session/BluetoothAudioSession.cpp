@@ -691,23 +691,38 @@ bool BluetoothAudioSession::IsAidlAvailable() {
  *
  ***/
 std::mutex BluetoothAudioSessionInstance::mutex_;
-std::unordered_map<SessionType, std::shared_ptr<BluetoothAudioSession>>
-    BluetoothAudioSessionInstance::sessions_map_;
+std::array<std::shared_ptr<BluetoothAudioSession>,
+           BluetoothAudioSessionInstance::kMaxSessionTypes>
+    BluetoothAudioSessionInstance::sessions_table_;
 
 std::shared_ptr<BluetoothAudioSession>
 BluetoothAudioSessionInstance::GetSessionInstance(
     const SessionType& session_type) {
-  std::lock_guard<std::mutex> guard(mutex_);
-
-  if (!sessions_map_.empty()) {
-    auto entry = sessions_map_.find(session_type);
-    if (entry != sessions_map_.end()) {
-      return entry->second;
-    }
+  size_t index = static_cast<size_t>(session_type);
+  if (index >= kMaxSessionTypes) {
+    LOG(ERROR) << __func__
+               << " - invalid SessionType=" << toString(session_type);
+    return nullptr;
   }
+
+  // Lookups on the audio data path read the published slot without taking
+  // mutex_, so they cannot block behind a session being created or a slow
+  // control operation.
   std::shared_ptr<BluetoothAudioSession> session_ptr =
-      std::make_shared<BluetoothAudioSession>(session_type);
-  sessions_map_[session_type] = session_ptr;
+      std::atomic_load_explicit(&sessions_table_[index],
+                                std::memory_order_acquire);
+  if (session_ptr != nullptr) {
+    return session_ptr;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  session_ptr = std::atomic_load_explicit(&sessions_table_[index],
+                                          std::memory_order_relaxed);
+  if (session_ptr == nullptr) {
+    session_ptr = std::make_shared<BluetoothAudioSession>(session_type);
+    std::atomic_store_explicit(&sessions_table_[index], session_ptr,
+                               std::memory_order_release);
+  }
   return session_ptr;
 }
 
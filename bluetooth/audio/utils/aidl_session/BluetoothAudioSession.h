@@ -24,6 +24,7 @@
 #include <aidl/android/hardware/bluetooth/audio/SessionType.h>
 #include <fmq/AidlMessageQueue.h>
 
+#include <array>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -253,9 +254,17 @@ class BluetoothAudioSessionInstance {
       const SessionType& session_type);
 
  private:
+  // One slot per SessionType value. A session is created once and never
+  // destroyed, and its slot is republished with an atomic store, so the
+  // lookup on the audio data path is a plain pointer load that never blocks
+  // on mutex_; the lock is only taken to create a session the first time.
+  static constexpr size_t kMaxSessionTypes =
+      static_cast<size_t>(
+          SessionType::A2DP_HARDWARE_OFFLOAD_DECODING_DATAPATH) +
+      1;
   static std::mutex mutex_;
-  static std::unordered_map<SessionType, std::shared_ptr<BluetoothAudioSession>>
-      sessions_map_;
+  static std::array<std::shared_ptr<BluetoothAudioSession>, kMaxSessionTypes>
+      sessions_table_;
 };
 
 }  // namespace audio
@@ -70,6 +70,34 @@ size_t H4Protocol::Send(PacketType type, const uint8_t* data, size_t length) {
   return ret;
 }
 
+size_t H4Protocol::Send(
+    const std::vector<std::pair<PacketType, std::vector<uint8_t>>>& packets) {
+  /* Coalesce the whole burst into one writev so queued ACL/ISO data costs a
+   * single syscall, with each packet's type byte interleaved in place.
+   */
+  std::vector<struct iovec> iov(2 * packets.size());
+  for (size_t i = 0; i < packets.size(); i++) {
+    iov[2 * i].iov_base = (void*)&packets[i].first;
+    iov[2 * i].iov_len = sizeof(packets[i].first);
+    iov[2 * i + 1].iov_base = (void*)packets[i].second.data();
+    iov[2 * i + 1].iov_len = packets[i].second.size();
+  }
+  ssize_t ret = 0;
+  while (1) {
+    ret = TEMP_FAILURE_RETRY(writev(uart_fd_, iov.data(), iov.size()));
+    if (ret == -1) {
+      LOG_ALWAYS_FATAL("%s error writing to UART (%s)", __func__,
+                       strerror(errno));
+    } else if (ret == 0) {
+      // Nothing written :(
+      ALOGE("%s zero bytes written - something went wrong...", __func__);
+      break;
+    }
+    break;
+  }
+  return ret;
+}
+
 size_t H4Protocol::OnPacketReady(const std::vector<uint8_t>& packet) {
   switch (hci_packet_type_) {
     case PacketType::COMMAND:
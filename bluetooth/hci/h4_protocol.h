@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "hci_internals.h"
@@ -35,6 +36,9 @@ class H4Protocol {
 
   size_t Send(PacketType type, const uint8_t* data, size_t length);
   size_t Send(PacketType type, const std::vector<uint8_t>& data);
+  // Sends a burst of packets with one writev, interleaving the type byte
+  // of each packet with its payload.
+  size_t Send(const std::vector<std::pair<PacketType, std::vector<uint8_t>>>& packets);
 
   void OnDataReady();
 
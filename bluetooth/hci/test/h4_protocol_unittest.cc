@@ -119,6 +119,44 @@ class H4ProtocolTest : public ::testing::Test {
     EXPECT_EQ(i, uart_length);
   }
 
+  void SendBurstAndReadUartOutbound(
+      const std::vector<std::pair<PacketType, char*>>& burst) {
+    ALOGD("%s sending", __func__);
+    std::vector<std::pair<PacketType, std::vector<uint8_t>>> packets;
+    int uart_length = 0;
+    for (const auto& entry : burst) {
+      int data_length = strlen(entry.second);
+      packets.emplace_back(entry.first,
+                           std::vector<uint8_t>(entry.second,
+                                                entry.second + data_length));
+      uart_length += data_length + 1;  // + 1 for data type code
+    }
+    h4_hci_->Send(packets);
+
+    ALOGD("%s reading", __func__);
+    std::vector<uint8_t> uart_data(uart_length);
+    int bytes_read = 0;
+    while (bytes_read < uart_length) {
+      fd_set read_fds;
+      FD_ZERO(&read_fds);
+      FD_SET(chip_uart_fd_, &read_fds);
+      TEMP_FAILURE_RETRY(
+          select(chip_uart_fd_ + 1, &read_fds, nullptr, nullptr, nullptr));
+
+      bytes_read += TEMP_FAILURE_RETRY(read(
+          chip_uart_fd_, uart_data.data() + bytes_read, uart_length - bytes_read));
+    }
+
+    size_t offset = 0;
+    for (const auto& entry : burst) {
+      EXPECT_EQ(static_cast<uint8_t>(entry.first), uart_data[offset]);
+      EXPECT_EQ(memcmp(entry.second, uart_data.data() + offset + 1,
+                       strlen(entry.second)),
+                0);
+      offset += strlen(entry.second) + 1;
+    }
+  }
+
   void ExpectInboundAclData(char* payload, std::promise<void>* promise) {
     // h4 type[1] + handle[2] + size[2]
     header_[0] = static_cast<uint8_t>(PacketType::ACL_DATA);
@@ -246,6 +284,13 @@ TEST_F(H4ProtocolTest, TestSends) {
   SendAndReadUartOutbound(PacketType::ISO_DATA, sample_data4);
 }
 
+// Test that a burst send interleaves each type byte with its payload
+TEST_F(H4ProtocolTest, TestBurstSend) {
+  SendBurstAndReadUartOutbound({{PacketType::ACL_DATA, sample_data1},
+                                {PacketType::ACL_DATA, sample_data2},
+                                {PacketType::ISO_DATA, sample_data3}});
+}
+
 // Ensure we properly parse data coming from the UART
 TEST_F(H4ProtocolTest, TestReads) {
   std::promise<void> acl_promise;
@@ -17,6 +17,10 @@
 #include "BootControl.h"
 #include <cstdint>
 
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
 #include <android-base/logging.h>
 
 using HIDLMergeStatus = ::android::bootable::BootControl::MergeStatus;
@@ -75,10 +79,21 @@ static constexpr HIDLMergeStatus ToHIDLMergeStatus(MergeStatus status) {
     }
 }
 
+static int64_t NowUs() {
+    timespec ts;
+    clock_gettime(CLOCK_BOOTTIME, &ts);
+    return ts.tv_sec * INT64_C(1000000) + ts.tv_nsec / 1000;
+}
+
 }
 
 ScopedAStatus BootControl::getSnapshotMergeStatus(MergeStatus* _aidl_return) {
-    *_aidl_return = ToAIDLMergeStatus(impl_.GetSnapshotMergeStatus());
+    std::lock_guard<std::mutex> lock(merge_status_lock_);
+    if (!cached_merge_status_.has_value()) {
+        cached_merge_status_ = ToAIDLMergeStatus(impl_.GetSnapshotMergeStatus());
+        merge_status_since_us_ = NowUs();
+    }
+    *_aidl_return = *cached_merge_status_;
     return ScopedAStatus::ok();
 }
 
@@ -144,11 +159,30 @@ ScopedAStatus BootControl::setSlotAsUnbootable(int32_t in_slot) {
 }
 
 ScopedAStatus BootControl::setSnapshotMergeStatus(MergeStatus in_status) {
+    std::lock_guard<std::mutex> lock(merge_status_lock_);
     if (!impl_.SetSnapshotMergeStatus(ToHIDLMergeStatus(in_status))) {
+        // The storage write failed, so the cached value may no longer match it.
+        cached_merge_status_.reset();
         return ScopedAStatus::fromServiceSpecificErrorWithMessage(COMMAND_FAILED,
                                                                   "Operation failed");
     }
+    if (cached_merge_status_ != in_status) {
+        cached_merge_status_ = in_status;
+        merge_status_since_us_ = NowUs();
+    }
     return ScopedAStatus::ok();
 }
 
+binder_status_t BootControl::dump(int fd, const char** /* args */, uint32_t /* numArgs */) {
+    std::lock_guard<std::mutex> lock(merge_status_lock_);
+    if (!cached_merge_status_.has_value()) {
+        dprintf(fd, "Snapshot merge status: not read yet\n");
+        return STATUS_OK;
+    }
+    dprintf(fd, "Snapshot merge status: %s for %" PRId64 " seconds\n",
+            toString(*cached_merge_status_).c_str(),
+            (NowUs() - merge_status_since_us_) / 1000000);
+    return STATUS_OK;
+}
+
 }  // namespace aidl::android::hardware::boot
@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <optional>
+
 #include <aidl/android/hardware/boot/BnBootControl.h>
 #include <libboot_control/libboot_control.h>
 
@@ -37,9 +40,19 @@ class BootControl final : public BnBootControl {
     ::ndk::ScopedAStatus setSlotAsUnbootable(int32_t in_slot) override;
     ::ndk::ScopedAStatus setSnapshotMergeStatus(
             ::aidl::android::hardware::boot::MergeStatus in_status) override;
+    // Dumps the cached merge status and how long it has been current, e.g. via
+    // dumpsys, so merge monitoring does not need to poll the misc partition.
+    binder_status_t dump(int fd, const char** args, uint32_t numArgs) override;
 
   private:
     ::android::bootable::BootControl impl_;
+    // This service is the only writer of the merge status word in misc, so the
+    // value read at first use stays valid until our own setSnapshotMergeStatus
+    // updates it. Caching it here keeps update_engine's polling during the
+    // hours-long background merge from re-reading storage on every call.
+    std::mutex merge_status_lock_;
+    std::optional<::aidl::android::hardware::boot::MergeStatus> cached_merge_status_;
+    int64_t merge_status_since_us_ = 0;
 };
 
 }  // namespace aidl::android::hardware::boot
@@ -200,6 +200,10 @@ ScopedAStatus BroadcastRadio::unsetTunerCallback() {
 
     lock_guard<mutex> lk(mMutex);
     mCallback = nullptr;
+    // A new callback starts with an empty cache, so diffing against the list
+    // delivered to the previous one would be wrong.
+    mLastListFilter.reset();
+    mLastProgramList.clear();
 
     return ScopedAStatus::ok();
 }
@@ -389,10 +393,42 @@ ScopedAStatus BroadcastRadio::startProgramListUpdates(const ProgramFilter& filte
     lock_guard<mutex> lk(mMutex);
 
     const auto& list = mVirtualRadio.getProgramList();
-    vector<VirtualProgram> filteredList;
-    std::copy_if(list.begin(), list.end(), std::back_inserter(filteredList), filterCb);
+    vector<VirtualProgram> virtualList;
+    std::copy_if(list.begin(), list.end(), std::back_inserter(virtualList), filterCb);
+    vector<ProgramInfo> filteredList(virtualList.begin(), virtualList.end());
+
+    ProgramListChunk chunk = {};
+    chunk.complete = true;
+    if (mLastListFilter.has_value() && *mLastListFilter == filter) {
+        // The client's cache is intact from the previous update with the same
+        // filter, so stream only the difference instead of purging.
+        for (const auto& program : filteredList) {
+            if (std::find(mLastProgramList.begin(), mLastProgramList.end(), program) ==
+                mLastProgramList.end()) {
+                chunk.modified.push_back(program);
+            }
+        }
+        vector<ProgramIdentifier> removed;
+        for (const auto& old : mLastProgramList) {
+            auto sameId = [&old](const ProgramInfo& program) {
+                return program.selector.primaryId == old.selector.primaryId;
+            };
+            if (std::find_if(filteredList.begin(), filteredList.end(), sameId) ==
+                filteredList.end()) {
+                removed.push_back(old.selector.primaryId);
+            }
+        }
+        if (!removed.empty()) {
+            chunk.removed = std::move(removed);
+        }
+    } else {
+        chunk.purge = true;
+        chunk.modified = filteredList;
+    }
+    mLastListFilter = filter;
+    mLastProgramList = std::move(filteredList);
 
-    auto task = [this, filteredList]() {
+    auto task = [this, chunk]() {
         std::shared_ptr<ITunerCallback> callback;
         {
             lock_guard<mutex> lk(mMutex);
@@ -403,11 +439,6 @@ ScopedAStatus BroadcastRadio::startProgramListUpdates(const ProgramFilter& filte
             callback = mCallback;
         }
 
-        ProgramListChunk chunk = {};
-        chunk.purge = true;
-        chunk.complete = true;
-        chunk.modified = vector<ProgramInfo>(filteredList.begin(), filteredList.end());
-
         callback->onProgramListUpdated(chunk);
     };
     mThread->schedule(task, kListDelayTimeS);
@@ -417,7 +448,13 @@ ScopedAStatus BroadcastRadio::startProgramListUpdates(const ProgramFilter& filte
 
 ScopedAStatus BroadcastRadio::stopProgramListUpdates() {
     LOG(DEBUG) << __func__ << ": requested program list updates to stop...";
-    // TODO(b/243681584) Implement stop program list updates method
+
+    // Drop the diff baseline; the next startProgramListUpdates call delivers
+    // a full purge-and-replace chunk again.
+    lock_guard<mutex> lk(mMutex);
+    mLastListFilter.reset();
+    mLastProgramList.clear();
+
     return ScopedAStatus::ok();
 }
 
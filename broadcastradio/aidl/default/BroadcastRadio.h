@@ -75,6 +75,12 @@ class BroadcastRadio final : public BnBroadcastRadio {
     ProgramSelector mCurrentProgram GUARDED_BY(mMutex) = {};
     std::shared_ptr<ITunerCallback> mCallback GUARDED_BY(mMutex);
 
+    // Baseline of the last program list delivered to the current callback.
+    // Subsequent updates matching the same filter are streamed as diff
+    // chunks instead of full purge-and-replace lists.
+    std::optional<ProgramFilter> mLastListFilter GUARDED_BY(mMutex);
+    std::vector<ProgramInfo> mLastProgramList GUARDED_BY(mMutex);
+
     std::optional<AmFmBandRange> getAmFmRangeLocked() const;
     void cancelLocked();
     ProgramInfo tuneInternalLocked(const ProgramSelector& sel);
@@ -21,8 +21,15 @@
 #include "ExternalCameraDevice.h"
 
 #include <aidl/android/hardware/camera/common/Status.h>
+#include <android-base/file.h>
+#include <android-base/strings.h>
 #include <convert.h>
 #include <linux/videodev2.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
 #include <regex>
 #include <set>
 
@@ -46,6 +53,45 @@ constexpr int MAX_RETRY = 5;                  // Allow retry v4l2 open failures
 constexpr int OPEN_RETRY_SLEEP_US = 100'000;  // 100ms * MAX_RETRY = 0.5 seconds
 
 const std::regex kDevicePathRE("/dev/video([0-9]+)");
+
+// On-disk characteristics cache. Enumerating the formats and frame intervals
+// via VIDIOC_ENUM_* ioctls takes hundreds of milliseconds on many webcams,
+// while the result only depends on the camera model and the external camera
+// config, so it is keyed by the USB VID:PID and a hash of the config inputs.
+constexpr uint32_t kCharsCacheMagic = 0x43434345;  // 'ECCC'
+constexpr uint32_t kCharsCacheVersion = 1;
+const char* kCharsCacheDir = "/data/vendor/camera/";
+
+struct CharsCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t configHash;
+    uint32_t croppingType;
+    uint32_t formatCount;
+    uint32_t metadataSize;
+};
+
+// Followed by 'frameRateCount' SupportedV4L2Format::FrameRate entries
+struct CharsCacheFormatEntry {
+    int32_t width;
+    int32_t height;
+    uint32_t fourcc;
+    uint32_t frameRateCount;
+};
+
+std::string readUsbIdAttribute(const std::string& devicePath, const char* attr) {
+    std::smatch sm;
+    if (!std::regex_match(devicePath, sm, kDevicePathRE)) {
+        return "";
+    }
+    std::string sysfsPath =
+            "/sys/class/video4linux/video" + sm[1].str() + "/device/../" + attr;
+    std::string value;
+    if (!::android::base::ReadFileToString(sysfsPath, &value)) {
+        return "";
+    }
+    return ::android::base::Trim(value);
+}
 }  // namespace
 
 std::string ExternalCameraDevice::kDeviceVersion = "1.1";
@@ -263,12 +309,163 @@ void ExternalCameraDevice::initSupportedFormatsLocked(int fd) {
     }
 }
 
+std::string ExternalCameraDevice::getCharacteristicsCachePath() {
+    std::string vid = readUsbIdAttribute(mDevicePath, "idVendor");
+    std::string pid = readUsbIdAttribute(mDevicePath, "idProduct");
+    if (vid.empty() || pid.empty()) {
+        return "";
+    }
+    return std::string(kCharsCacheDir) + "ext_camera_chars_" + vid + "_" + pid + ".cache";
+}
+
+uint32_t ExternalCameraDevice::getConfigHash() const {
+    // FNV-1a over the config fields that shape the characteristics
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 16777619u;
+        }
+    };
+    mix(&mCfg.maxVideoSize.width, sizeof(mCfg.maxVideoSize.width));
+    mix(&mCfg.maxVideoSize.height, sizeof(mCfg.maxVideoSize.height));
+    mix(&mCfg.minStreamSize.width, sizeof(mCfg.minStreamSize.width));
+    mix(&mCfg.minStreamSize.height, sizeof(mCfg.minStreamSize.height));
+    mix(&mCfg.depthEnabled, sizeof(mCfg.depthEnabled));
+    mix(&mCfg.orientation, sizeof(mCfg.orientation));
+    for (const auto& limit : mCfg.fpsLimits) {
+        mix(&limit.size.width, sizeof(limit.size.width));
+        mix(&limit.size.height, sizeof(limit.size.height));
+        mix(&limit.fpsUpperBound, sizeof(limit.fpsUpperBound));
+    }
+    for (const auto& limit : mCfg.depthFpsLimits) {
+        mix(&limit.size.width, sizeof(limit.size.width));
+        mix(&limit.size.height, sizeof(limit.size.height));
+        mix(&limit.fpsUpperBound, sizeof(limit.fpsUpperBound));
+    }
+    return hash;
+}
+
+bool ExternalCameraDevice::loadCameraCharacteristicsFromCache() {
+    std::string path = getCharacteristicsCachePath();
+    if (path.empty()) {
+        return false;
+    }
+    std::string contents;
+    if (!::android::base::ReadFileToString(path, &contents)) {
+        return false;
+    }
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(contents.data());
+    const size_t size = contents.size();
+    if (size < sizeof(CharsCacheHeader)) {
+        return false;
+    }
+    CharsCacheHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != kCharsCacheMagic || header.version != kCharsCacheVersion ||
+        header.configHash != getConfigHash() ||
+        (header.croppingType != HORIZONTAL && header.croppingType != VERTICAL)) {
+        return false;
+    }
+
+    size_t offset = sizeof(header);
+    std::vector<SupportedV4L2Format> formats;
+    formats.reserve(header.formatCount);
+    for (uint32_t i = 0; i < header.formatCount; i++) {
+        if (offset + sizeof(CharsCacheFormatEntry) > size) {
+            return false;
+        }
+        CharsCacheFormatEntry entry;
+        std::memcpy(&entry, data + offset, sizeof(entry));
+        offset += sizeof(entry);
+
+        const size_t ratesSize =
+                entry.frameRateCount * sizeof(SupportedV4L2Format::FrameRate);
+        if (offset + ratesSize > size) {
+            return false;
+        }
+        SupportedV4L2Format fmt{
+                .width = entry.width, .height = entry.height, .fourcc = entry.fourcc};
+        fmt.frameRates.resize(entry.frameRateCount);
+        std::memcpy(fmt.frameRates.data(), data + offset, ratesSize);
+        offset += ratesSize;
+        formats.push_back(std::move(fmt));
+    }
+
+    if (offset + header.metadataSize != size) {
+        return false;
+    }
+    // Copy the metadata blob to naturally aligned storage before validation
+    std::vector<uint8_t> blob(header.metadataSize);
+    std::memcpy(blob.data(), data + offset, header.metadataSize);
+    camera_metadata_t* metadata = allocate_copy_camera_metadata_checked(
+            reinterpret_cast<camera_metadata_t*>(blob.data()), header.metadataSize);
+    if (metadata == nullptr) {
+        ALOGW("%s: cached metadata in %s failed validation", __FUNCTION__, path.c_str());
+        return false;
+    }
+
+    mCameraCharacteristics.clear();
+    mCameraCharacteristics.acquire(metadata);
+    mSupportedFormats = std::move(formats);
+    mCroppingType = static_cast<CroppingType>(header.croppingType);
+    return true;
+}
+
+void ExternalCameraDevice::writeCameraCharacteristicsToCache() {
+    std::string path = getCharacteristicsCachePath();
+    if (path.empty()) {
+        return;
+    }
+
+    const camera_metadata_t* metadata = mCameraCharacteristics.getAndLock();
+    const size_t metadataSize = get_camera_metadata_size(metadata);
+    const CharsCacheHeader header = {
+            kCharsCacheMagic,
+            kCharsCacheVersion,
+            getConfigHash(),
+            static_cast<uint32_t>(mCroppingType),
+            static_cast<uint32_t>(mSupportedFormats.size()),
+            static_cast<uint32_t>(metadataSize)};
+    std::string contents;
+    contents.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const auto& fmt : mSupportedFormats) {
+        const CharsCacheFormatEntry entry = {fmt.width, fmt.height, fmt.fourcc,
+                                             static_cast<uint32_t>(fmt.frameRates.size())};
+        contents.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        contents.append(reinterpret_cast<const char*>(fmt.frameRates.data()),
+                        fmt.frameRates.size() * sizeof(SupportedV4L2Format::FrameRate));
+    }
+    contents.append(reinterpret_cast<const char*>(metadata), metadataSize);
+    mCameraCharacteristics.unlock(metadata);
+
+    // Write to a temporary file first so a partial write never gets picked up
+    ::mkdir(kCharsCacheDir, 0700);
+    std::string tempPath = path + ".tmp";
+    if (!::android::base::WriteStringToFile(contents, tempPath)) {
+        ALOGW("%s: failed to write characteristics cache %s", __FUNCTION__, tempPath.c_str());
+        ::unlink(tempPath.c_str());
+        return;
+    }
+    if (::rename(tempPath.c_str(), path.c_str()) != 0) {
+        ALOGW("%s: failed to move characteristics cache into place: %s (%d)", __FUNCTION__,
+              strerror(errno), errno);
+        ::unlink(tempPath.c_str());
+    }
+}
+
 status_t ExternalCameraDevice::initCameraCharacteristics() {
     if (!mCameraCharacteristics.isEmpty()) {
         // Camera Characteristics previously initialized. Skip.
         return OK;
     }
 
+    if (loadCameraCharacteristicsFromCache()) {
+        ALOGV("%s: restored characteristics of %s from cache", __FUNCTION__, mDevicePath.c_str());
+        mCameraCharacteristics.sort();
+        return OK;
+    }
+
     // init camera characteristics
     unique_fd fd(::open(mDevicePath.c_str(), O_RDWR));
     if (fd.get() < 0) {
@@ -305,6 +502,12 @@ status_t ExternalCameraDevice::initCameraCharacteristics() {
         return ret;
     }
 
+    // Sort the blob once so that the repeated characteristic lookups in the
+    // session's request path use binary search instead of a linear scan.
+    // The session and its output thread copy the sorted buffer as-is.
+    mCameraCharacteristics.sort();
+
+    writeCameraCharacteristicsToCache();
     return OK;
 }
 
@@ -84,6 +84,14 @@ class ExternalCameraDevice : public BnCameraDevice {
 
     // Calls into virtual member function. Do not use it in constructor
     status_t initCameraCharacteristics();
+
+    // On-disk characteristics cache keyed by the camera's USB VID:PID.
+    // Reopening a known webcam restores the metadata and the sorted format
+    // table from disk instead of re-running the V4L2 enumeration ioctls.
+    std::string getCharacteristicsCachePath();
+    uint32_t getConfigHash() const;
+    bool loadCameraCharacteristicsFromCache();
+    void writeCameraCharacteristicsToCache();
     // Init available capabilities keys
     virtual status_t initAvailableCapabilities(
             ::android::hardware::camera::common::V1_0::helper::CameraMetadata*);
@@ -36,6 +36,7 @@
 #include <convert.h>
 #include <linux/videodev2.h>
 #include <sync/sync.h>
+#include <sys/mman.h>
 #include <utils/Trace.h>
 #include <deque>
 
@@ -250,6 +251,71 @@ ExternalCameraDeviceSession::~ExternalCameraDeviceSession() {
         ALOGE("ExternalCameraDeviceSession deleted before close!");
         close(/*callerIsDtor*/ true);
     }
+    std::lock_guard<std::mutex> lk(mResultMetadataPoolLock);
+    for (camera_metadata_t* buffer : mResultMetadataPool) {
+        free_camera_metadata(buffer);
+    }
+    mResultMetadataPool.clear();
+}
+
+common::V1_0::helper::CameraMetadata ExternalCameraDeviceSession::acquireResultMetadata() {
+    const camera_metadata_t* latest = mLatestReqSetting.getAndLock();
+    const size_t entryCount = get_camera_metadata_entry_count(latest);
+    const size_t dataCount = get_camera_metadata_data_count(latest);
+
+    camera_metadata_t* buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(mResultMetadataPoolLock);
+        while (!mResultMetadataPool.empty()) {
+            camera_metadata_t* candidate = mResultMetadataPool.back();
+            mResultMetadataPool.pop_back();
+            if (get_camera_metadata_entry_capacity(candidate) >=
+                        entryCount + kResultEntryHeadroom &&
+                get_camera_metadata_data_capacity(candidate) >= dataCount + kResultDataHeadroom) {
+                buffer = candidate;
+                break;
+            }
+            // Settings grew past this buffer's capacity; let it go
+            free_camera_metadata(candidate);
+        }
+    }
+    if (buffer != nullptr) {
+        // Reinitialize the recycled buffer in place to an empty structure
+        buffer = place_camera_metadata(buffer, get_camera_metadata_size(buffer),
+                                       get_camera_metadata_entry_capacity(buffer),
+                                       get_camera_metadata_data_capacity(buffer));
+    } else {
+        buffer = allocate_camera_metadata(entryCount + kResultEntryHeadroom,
+                                          dataCount + kResultDataHeadroom);
+    }
+
+    common::V1_0::helper::CameraMetadata result;
+    if (buffer == nullptr || append_camera_metadata(buffer, latest) != OK) {
+        // Fall back to a plain clone of the settings
+        if (buffer != nullptr) {
+            free_camera_metadata(buffer);
+        }
+        mLatestReqSetting.unlock(latest);
+        result = mLatestReqSetting;
+        return result;
+    }
+    mLatestReqSetting.unlock(latest);
+    result.acquire(buffer);
+    return result;
+}
+
+void ExternalCameraDeviceSession::recycleResultMetadata(
+        common::V1_0::helper::CameraMetadata& md) {
+    camera_metadata_t* buffer = md.release();
+    if (buffer == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lk(mResultMetadataPoolLock);
+    if (mResultMetadataPool.size() < kResultMetadataPoolDepth) {
+        mResultMetadataPool.push_back(buffer);
+    } else {
+        free_camera_metadata(buffer);
+    }
 }
 
 ScopedAStatus ExternalCameraDeviceSession::constructDefaultRequestSettings(
@@ -557,6 +623,10 @@ Status ExternalCameraDeviceSession::processOneCaptureRequest(const CaptureReques
 
     if (converted && rawSettings != nullptr) {
         mLatestReqSetting = rawSettings;
+        // Repeating requests reuse this blob for every frame, so sort it once
+        // here to make the per-frame lookups (fps range, AF trigger, JPEG
+        // quality, ...) binary searches.
+        mLatestReqSetting.sort();
     }
 
     if (!converted) {
@@ -640,7 +710,7 @@ Status ExternalCameraDeviceSession::processOneCaptureRequest(const CaptureReques
 
     std::shared_ptr<HalRequest> halReq = std::make_shared<HalRequest>();
     halReq->frameNumber = request.frameNumber;
-    halReq->setting = mLatestReqSetting;
+    halReq->setting = acquireResultMetadata();
     halReq->frameIn = std::move(frameIn);
     halReq->shutterTs = shutterTs;
     halReq->buffers.resize(numOutputBufs);
@@ -1146,6 +1216,11 @@ int ExternalCameraDeviceSession::configureV4l2StreamLocked(const SupportedV4L2Fo
     // VIDIOC_QUERYBUF:  get buffer offset in the V4L2 fd
     // VIDIOC_QBUF: send buffer to driver
     mV4L2BufferCount = req_buffers.count;
+    // Release mappings left over from a configuration attempt that failed mid-way.
+    for (const auto& mapping : mV4l2Mappings) {
+        munmap(mapping.first, mapping.second);
+    }
+    mV4l2Mappings.clear();
     for (uint32_t i = 0; i < req_buffers.count; i++) {
         v4l2_buffer buffer = {
                 .index = i, .type = V4L2_BUF_TYPE_VIDEO_CAPTURE, .memory = V4L2_MEMORY_MMAP};
@@ -1155,6 +1230,16 @@ int ExternalCameraDeviceSession::configureV4l2StreamLocked(const SupportedV4L2Fo
             return -errno;
         }
 
+        // Map the buffer once for the lifetime of the stream. Dequeued frames reuse
+        // these mappings, avoiding an mmap/munmap syscall pair per captured frame.
+        void* addr = mmap(nullptr, buffer.length, PROT_READ, MAP_SHARED, mV4l2Fd.get(),
+                          buffer.m.offset);
+        if (addr == MAP_FAILED) {
+            ALOGE("%s: mmap of buffer %d failed: %s", __FUNCTION__, i, strerror(errno));
+            return -errno;
+        }
+        mV4l2Mappings.emplace_back(static_cast<uint8_t*>(addr), buffer.length);
+
         if (TEMP_FAILURE_RETRY(ioctl(mV4l2Fd.get(), VIDIOC_QBUF, &buffer)) < 0) {
             ALOGE("%s: QBUF %d failed: %s", __FUNCTION__, i, strerror(errno));
             return -errno;
@@ -1262,9 +1347,11 @@ std::unique_ptr<V4L2Frame> ExternalCameraDeviceSession::dequeueV4l2FrameLocked(n
         mNumDequeuedV4l2Buffers++;
     }
 
+    uint8_t* preMappedData =
+            buffer.index < mV4l2Mappings.size() ? mV4l2Mappings[buffer.index].first : nullptr;
     return std::make_unique<V4L2Frame>(mV4l2StreamingFmt.width, mV4l2StreamingFmt.height,
                                        mV4l2StreamingFmt.fourcc, buffer.index, mV4l2Fd.get(),
-                                       buffer.bytesused, buffer.m.offset);
+                                       buffer.bytesused, buffer.m.offset, preMappedData);
 }
 
 void ExternalCameraDeviceSession::enqueueV4l2Frame(const std::shared_ptr<V4L2Frame>& frame) {
@@ -1465,6 +1552,15 @@ int ExternalCameraDeviceSession::v4l2StreamOffLocked() {
     }
     mV4L2BufferCount = 0;
 
+    // All inflight buffers have been returned at this point, so the persistent
+    // mappings can be released before the driver reclaims the buffers.
+    for (const auto& mapping : mV4l2Mappings) {
+        if (munmap(mapping.first, mapping.second) != 0) {
+            ALOGE("%s: munmap of V4L2 buffer failed: %s", __FUNCTION__, strerror(errno));
+        }
+    }
+    mV4l2Mappings.clear();
+
     // VIDIOC_STREAMOFF
     v4l2_buf_type capture_type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
     if (TEMP_FAILURE_RETRY(ioctl(mV4l2Fd.get(), VIDIOC_STREAMOFF, &capture_type)) < 0) {
@@ -1836,6 +1932,7 @@ Status ExternalCameraDeviceSession::processCaptureResult(std::shared_ptr<HalRequ
     const camera_metadata_t* rawResult = req->setting.getAndLock();
     convertToAidl(rawResult, &result.result);
     req->setting.unlock(rawResult);
+    recycleResultMetadata(req->setting);
 
     // update inflight records
     {
@@ -2136,9 +2233,57 @@ ExternalCameraDeviceSession::OutputThread::OutputThread(
     : mParent(parent),
       mCroppingType(ct),
       mCameraCharacteristics(chars),
-      mBufferRequestThread(bufReqThread) {}
+      mBufferRequestThread(bufReqThread) {
+    const int numWorkers = kMaxProcessedStream + kMaxStallStream;
+    mConvertWorkers.reserve(numWorkers);
+    for (int i = 0; i < numWorkers; i++) {
+        mConvertWorkers.emplace_back([this]() { convertWorkerLoop(); });
+    }
+}
+
+ExternalCameraDeviceSession::OutputThread::~OutputThread() {
+    {
+        std::lock_guard<std::mutex> lk(mTaskLock);
+        mConvertWorkersExiting = true;
+    }
+    mTaskCond.notify_all();
+    for (auto& worker : mConvertWorkers) {
+        worker.join();
+    }
+}
+
+void ExternalCameraDeviceSession::OutputThread::submitConvertTask(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lk(mTaskLock);
+        mTaskQueue.push_back(std::move(task));
+        mTasksInFlight++;
+    }
+    mTaskCond.notify_one();
+}
 
-ExternalCameraDeviceSession::OutputThread::~OutputThread() {}
+void ExternalCameraDeviceSession::OutputThread::waitForConvertTasksDone() {
+    std::unique_lock<std::mutex> lk(mTaskLock);
+    mTaskDoneCond.wait(lk, [this]() { return mTasksInFlight == 0; });
+}
+
+void ExternalCameraDeviceSession::OutputThread::convertWorkerLoop() {
+    std::unique_lock<std::mutex> lk(mTaskLock);
+    while (true) {
+        mTaskCond.wait(lk, [this]() { return mConvertWorkersExiting || !mTaskQueue.empty(); });
+        if (mTaskQueue.empty()) {
+            // mConvertWorkersExiting must be set; drain remaining tasks first
+            return;
+        }
+        std::function<void()> task = std::move(mTaskQueue.front());
+        mTaskQueue.pop_front();
+        lk.unlock();
+        task();
+        lk.lock();
+        if (--mTasksInFlight == 0) {
+            mTaskDoneCond.notify_all();
+        }
+    }
+}
 
 Status ExternalCameraDeviceSession::OutputThread::allocateIntermediateBuffers(
         const Size& v4lSize, const Size& thumbSize, const std::vector<Stream>& streams,
@@ -2391,6 +2536,10 @@ int ExternalCameraDeviceSession::OutputThread::cropAndScaleLocked(
         return 0;
     }
 
+    // Conversion tasks of the same frame may request the same intermediate
+    // size; serialize the cache lookup and the scale so the second requester
+    // sees a fully scaled buffer instead of racing the first one.
+    std::lock_guard<std::mutex> scaledLock(mScaledFramesLock);
     auto it = mScaledYu12Frames.find(outSz);
     std::shared_ptr<AllocatedFrame> scaledYu12Buf;
     if (it != mScaledYu12Frames.end()) {
@@ -2625,8 +2774,11 @@ int ExternalCameraDeviceSession::OutputThread::createJpegLocked(
 
     /* Hold actual thumbnail and main image code sizes */
     size_t thumbCodeSize = 0, jpegCodeSize = 0;
-    /* Temporary thumbnail code buffer */
-    std::vector<uint8_t> thumbCode(outputThumbnail ? maxThumbCodeSize : 0);
+    /* Temporary thumbnail code buffer. Thread-local so it can be reused
+     * across captures without synchronization between conversion workers
+     * encoding different BLOB buffers. */
+    static thread_local std::vector<uint8_t> thumbCode;
+    thumbCode.resize(outputThumbnail ? maxThumbCodeSize : 0);
 
     YCbCrLayout yu12Thumb;
     if (outputThumbnail) {
@@ -2841,89 +2993,109 @@ bool ExternalCameraDeviceSession::OutputThread::threadLoop() {
 
     ALOGV("%s processing new request", __FUNCTION__);
     const int kSyncWaitTimeoutMs = 500;
-    for (auto& halBuf : req->buffers) {
-        if (*(halBuf.bufPtr) == nullptr) {
-            ALOGW("%s: buffer for stream %d missing", __FUNCTION__, halBuf.streamId);
-            halBuf.fenceTimeout = true;
-        } else if (halBuf.acquireFence >= 0) {
-            int ret = sync_wait(halBuf.acquireFence, kSyncWaitTimeoutMs);
-            if (ret) {
+    // Run the conversions for all output buffers of this frame in parallel
+    // on the worker pool; each buffer only writes its own gralloc output,
+    // and the shared scaled frame cache is serialized inside
+    // cropAndScaleLocked. mBufferLock stays held here so the intermediate
+    // buffers cannot be reallocated underneath the workers.
+    std::vector<int> convertRes(req->buffers.size(), 0);
+    for (size_t i = 0; i < req->buffers.size(); i++) {
+        submitConvertTask([&, i]() {
+            auto& halBuf = req->buffers[i];
+            if (*(halBuf.bufPtr) == nullptr) {
+                ALOGW("%s: buffer for stream %d missing", __FUNCTION__, halBuf.streamId);
                 halBuf.fenceTimeout = true;
-            } else {
-                ::close(halBuf.acquireFence);
-                halBuf.acquireFence = -1;
+            } else if (halBuf.acquireFence >= 0) {
+                int ret = sync_wait(halBuf.acquireFence, kSyncWaitTimeoutMs);
+                if (ret) {
+                    halBuf.fenceTimeout = true;
+                } else {
+                    ::close(halBuf.acquireFence);
+                    halBuf.acquireFence = -1;
+                }
             }
-        }
 
-        if (halBuf.fenceTimeout) {
-            continue;
-        }
+            if (halBuf.fenceTimeout) {
+                return;
+            }
 
-        // Gralloc lockYCbCr the buffer
-        switch (halBuf.format) {
-            case PixelFormat::BLOB: {
-                int ret = createJpegLocked(halBuf, req->setting);
+            // Gralloc lockYCbCr the buffer
+            switch (halBuf.format) {
+                case PixelFormat::BLOB: {
+                    int ret = createJpegLocked(halBuf, req->setting);
 
-                if (ret != 0) {
-                    lk.unlock();
-                    return onDeviceError("%s: createJpegLocked failed with %d", __FUNCTION__, ret);
-                }
-            } break;
-            case PixelFormat::Y16: {
-                void* outLayout = sHandleImporter.lock(
-                        *(halBuf.bufPtr), static_cast<uint64_t>(halBuf.usage), inDataSize);
+                    if (ret != 0) {
+                        ALOGE("%s: createJpegLocked failed with %d", __FUNCTION__, ret);
+                        convertRes[i] = ret;
+                    }
+                } break;
+                case PixelFormat::Y16: {
+                    void* outLayout = sHandleImporter.lock(
+                            *(halBuf.bufPtr), static_cast<uint64_t>(halBuf.usage), inDataSize);
 
-                std::memcpy(outLayout, inData, inDataSize);
+                    std::memcpy(outLayout, inData, inDataSize);
 
-                int relFence = sHandleImporter.unlock(*(halBuf.bufPtr));
-                if (relFence >= 0) {
-                    halBuf.acquireFence = relFence;
-                }
-            } break;
-            case PixelFormat::YCBCR_420_888:
-            case PixelFormat::YV12: {
-                IMapper::Rect outRect{0, 0, static_cast<int32_t>(halBuf.width),
-                                      static_cast<int32_t>(halBuf.height)};
-                YCbCrLayout outLayout = sHandleImporter.lockYCbCr(
-                        *(halBuf.bufPtr), static_cast<uint64_t>(halBuf.usage), outRect);
-                ALOGV("%s: outLayout y %p cb %p cr %p y_str %d c_str %d c_step %d", __FUNCTION__,
-                      outLayout.y, outLayout.cb, outLayout.cr, outLayout.yStride, outLayout.cStride,
-                      outLayout.chromaStep);
-
-                // Convert to output buffer size/format
-                uint32_t outputFourcc = getFourCcFromLayout(outLayout);
-                ALOGV("%s: converting to format %c%c%c%c", __FUNCTION__, outputFourcc & 0xFF,
-                      (outputFourcc >> 8) & 0xFF, (outputFourcc >> 16) & 0xFF,
-                      (outputFourcc >> 24) & 0xFF);
-
-                YCbCrLayout cropAndScaled;
-                ATRACE_BEGIN("cropAndScaleLocked");
-                int ret = cropAndScaleLocked(mYu12Frame, Size{halBuf.width, halBuf.height},
-                                             &cropAndScaled);
-                ATRACE_END();
-                if (ret != 0) {
-                    lk.unlock();
-                    return onDeviceError("%s: crop and scale failed!", __FUNCTION__);
-                }
+                    int relFence = sHandleImporter.unlock(*(halBuf.bufPtr));
+                    if (relFence >= 0) {
+                        halBuf.acquireFence = relFence;
+                    }
+                } break;
+                case PixelFormat::YCBCR_420_888:
+                case PixelFormat::YV12: {
+                    IMapper::Rect outRect{0, 0, static_cast<int32_t>(halBuf.width),
+                                          static_cast<int32_t>(halBuf.height)};
+                    YCbCrLayout outLayout = sHandleImporter.lockYCbCr(
+                            *(halBuf.bufPtr), static_cast<uint64_t>(halBuf.usage), outRect);
+                    ALOGV("%s: outLayout y %p cb %p cr %p y_str %d c_str %d c_step %d",
+                          __FUNCTION__, outLayout.y, outLayout.cb, outLayout.cr, outLayout.yStride,
+                          outLayout.cStride, outLayout.chromaStep);
+
+                    // Convert to output buffer size/format
+                    uint32_t outputFourcc = getFourCcFromLayout(outLayout);
+                    ALOGV("%s: converting to format %c%c%c%c", __FUNCTION__, outputFourcc & 0xFF,
+                          (outputFourcc >> 8) & 0xFF, (outputFourcc >> 16) & 0xFF,
+                          (outputFourcc >> 24) & 0xFF);
+
+                    YCbCrLayout cropAndScaled;
+                    ATRACE_BEGIN("cropAndScaleLocked");
+                    int ret = cropAndScaleLocked(mYu12Frame, Size{halBuf.width, halBuf.height},
+                                                 &cropAndScaled);
+                    ATRACE_END();
+                    if (ret != 0) {
+                        ALOGE("%s: crop and scale failed!", __FUNCTION__);
+                        convertRes[i] = ret;
+                        return;
+                    }
 
-                Size sz{halBuf.width, halBuf.height};
-                ATRACE_BEGIN("formatConvert");
-                ret = formatConvert(cropAndScaled, outLayout, sz, outputFourcc);
-                ATRACE_END();
-                if (ret != 0) {
-                    lk.unlock();
-                    return onDeviceError("%s: format conversion failed!", __FUNCTION__);
-                }
-                int relFence = sHandleImporter.unlock(*(halBuf.bufPtr));
-                if (relFence >= 0) {
-                    halBuf.acquireFence = relFence;
-                }
-            } break;
-            default:
-                lk.unlock();
-                return onDeviceError("%s: unknown output format %x", __FUNCTION__, halBuf.format);
-        }
+                    Size sz{halBuf.width, halBuf.height};
+                    ATRACE_BEGIN("formatConvert");
+                    ret = formatConvert(cropAndScaled, outLayout, sz, outputFourcc);
+                    ATRACE_END();
+                    if (ret != 0) {
+                        ALOGE("%s: format conversion failed!", __FUNCTION__);
+                        convertRes[i] = ret;
+                        return;
+                    }
+                    int relFence = sHandleImporter.unlock(*(halBuf.bufPtr));
+                    if (relFence >= 0) {
+                        halBuf.acquireFence = relFence;
+                    }
+                } break;
+                default:
+                    ALOGE("%s: unknown output format %x", __FUNCTION__, halBuf.format);
+                    convertRes[i] = -1;
+            }
+        });
     }  // for each buffer
+    waitForConvertTasksDone();
+
+    for (size_t i = 0; i < req->buffers.size(); i++) {
+        if (convertRes[i] != 0) {
+            lk.unlock();
+            return onDeviceError("%s: conversion for stream %d failed: %d", __FUNCTION__,
+                                 req->buffers[i].streamId, convertRes[i]);
+        }
+    }
     mScaledYu12Frames.clear();
 
     // Don't hold the lock while calling back to parent
@@ -27,7 +27,9 @@
 #include <fmq/AidlMessageQueue.h>
 #include <utils/Thread.h>
 #include <deque>
+#include <functional>
 #include <list>
+#include <thread>
 
 namespace android {
 namespace hardware {
@@ -201,6 +203,15 @@ class ExternalCameraDeviceSession : public BnCameraDeviceSession, public OutputT
 
         void clearIntermediateBuffers();
 
+        // Methods to run the per-stream conversions of one frame on the
+        // conversion worker pool. Tasks submitted between submitConvertTask
+        // and waitForConvertTasksDone run concurrently; the caller must hold
+        // mBufferLock so the intermediate buffers cannot be reallocated
+        // underneath the workers.
+        void submitConvertTask(std::function<void()> task);
+        void waitForConvertTasksDone();
+        void convertWorkerLoop();
+
         const std::weak_ptr<OutputThreadInterface> mParent;
         const CroppingType mCroppingType;
         const common::V1_0::helper::CameraMetadata mCameraCharacteristics;
@@ -232,6 +243,21 @@ class ExternalCameraDeviceSession : public BnCameraDeviceSession, public OutputT
         std::string mExifMake;
         std::string mExifModel;
 
+        // Worker pool processing the per-stream conversions of a single frame
+        // in parallel. One task per output buffer; sized so a fully populated
+        // request (processed streams + stall stream) does not serialize.
+        std::vector<std::thread> mConvertWorkers;
+        std::mutex mTaskLock;                     // Protect access to mTaskQueue/mTasksInFlight
+        std::condition_variable mTaskCond;        // signaled when a task is enqueued
+        std::condition_variable mTaskDoneCond;    // signaled when a task finishes
+        std::deque<std::function<void()>> mTaskQueue;
+        size_t mTasksInFlight = 0;
+        bool mConvertWorkersExiting = false;
+
+        // Protect the scaled frame cache when conversion tasks of the same
+        // frame request overlapping intermediate sizes.
+        std::mutex mScaledFramesLock;
+
         const std::shared_ptr<BufferRequestThread> mBufferRequestThread;
     };
 
@@ -343,6 +369,9 @@ class ExternalCameraDeviceSession : public BnCameraDeviceSession, public OutputT
     std::condition_variable mV4L2BufferReturned;
     size_t mNumDequeuedV4l2Buffers = 0;
     uint32_t mMaxV4L2BufferSize = 0;
+    // Persistent mappings of the V4L2 MMAP buffers, indexed by the V4L2 buffer index.
+    // Created when the stream is configured, released on stream off.
+    std::vector<std::pair<uint8_t*, size_t>> mV4l2Mappings;
 
     // Not protected by mLock (but might be used when mLock is locked)
     std::shared_ptr<OutputThread> mOutputThread;
@@ -361,6 +390,19 @@ class ExternalCameraDeviceSession : public BnCameraDeviceSession, public OutputT
     std::mutex mAfTriggerLock;  // protect mAfTrigger
     bool mAfTrigger = false;
 
+    // Recycled result metadata buffers. Each request clones the latest
+    // settings and then fillCaptureResult appends a handful of result tags,
+    // which used to grow-and-copy the freshly cloned blob several times per
+    // frame. Buffers are handed out with headroom for the result tags and
+    // returned here after the capture result has been sent.
+    common::V1_0::helper::CameraMetadata acquireResultMetadata();
+    void recycleResultMetadata(common::V1_0::helper::CameraMetadata& md);
+    static const size_t kResultEntryHeadroom = 16;
+    static const size_t kResultDataHeadroom = 256;  // bytes
+    static const size_t kResultMetadataPoolDepth = 8;
+    std::mutex mResultMetadataPoolLock;  // protect mResultMetadataPool
+    std::vector<camera_metadata_t*> mResultMetadataPool;
+
     uint32_t mBlobBufferSize = 0;
 
     static HandleImporter sHandleImporter;
@@ -305,12 +305,17 @@ void ExternalCameraOfflineSession::initOutputThread() {
             /*parent=*/thiz, mCallback);
     mBufferRequestThread->run();
 
+    Size inputSize = {mOfflineReqs[0]->frameIn->mWidth, mOfflineReqs[0]->frameIn->mHeight};
+
+    // The output thread is the sole consumer of the backlog. Hand it over
+    // rather than copying so each request (and the input frame it pins) is
+    // freed as soon as its result has been delivered, instead of staying
+    // alive in this session until close().
     mOutputThread = std::make_shared<OutputThread>(/*parent=*/thiz, mCroppingType, mChars,
-                                                   mBufferRequestThread, mOfflineReqs);
+                                                   mBufferRequestThread, std::move(mOfflineReqs));
 
     mOutputThread->setExifMakeModel(mExifMake, mExifModel);
 
-    Size inputSize = {mOfflineReqs[0]->frameIn->mWidth, mOfflineReqs[0]->frameIn->mHeight};
     Size maxThumbSize = getMaxThumbnailResolution(mChars);
     mOutputThread->allocateIntermediateBuffers(inputSize, maxThumbSize, mOfflineStreams,
                                                mBlobBufferSize);
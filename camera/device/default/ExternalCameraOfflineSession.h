@@ -81,10 +81,10 @@ class ExternalCameraOfflineSession final : public BnCameraOfflineSession,
         OutputThread(std::weak_ptr<OutputThreadInterface> parent, CroppingType ct,
                      const common::V1_0::helper::CameraMetadata& chars,
                      std::shared_ptr<ExternalCameraDeviceSession::BufferRequestThread> bufReqThread,
-                     std::deque<std::shared_ptr<HalRequest>>& offlineReqs)
+                     std::deque<std::shared_ptr<HalRequest>> offlineReqs)
             : ExternalCameraDeviceSession::OutputThread(std::move(parent), ct, chars,
                                                         std::move(bufReqThread)),
-              mOfflineReqs(offlineReqs) {}
+              mOfflineReqs(std::move(offlineReqs)) {}
 
         bool threadLoop() override;
 
@@ -243,8 +243,13 @@ Frame::Frame(uint32_t width, uint32_t height, uint32_t fourcc)
 Frame::~Frame() {}
 
 V4L2Frame::V4L2Frame(uint32_t w, uint32_t h, uint32_t fourcc, int bufIdx, int fd, uint32_t dataSize,
-                     uint64_t offset)
-    : Frame(w, h, fourcc), mBufferIndex(bufIdx), mFd(fd), mDataSize(dataSize), mOffset(offset) {}
+                     uint64_t offset, uint8_t* preMappedData)
+    : Frame(w, h, fourcc),
+      mBufferIndex(bufIdx),
+      mFd(fd),
+      mDataSize(dataSize),
+      mOffset(offset),
+      mPreMappedData(preMappedData) {}
 
 V4L2Frame::~V4L2Frame() {
     unmap();
@@ -263,12 +268,16 @@ int V4L2Frame::map(uint8_t** data, size_t* dataSize) {
 
     std::lock_guard<std::mutex> lk(mLock);
     if (!mMapped) {
-        void* addr = mmap(nullptr, mDataSize, PROT_READ, MAP_SHARED, mFd, mOffset);
-        if (addr == MAP_FAILED) {
-            ALOGE("%s: V4L2 buffer map failed: %s", __FUNCTION__, strerror(errno));
-            return -EINVAL;
+        if (mPreMappedData != nullptr) {
+            mData = mPreMappedData;
+        } else {
+            void* addr = mmap(nullptr, mDataSize, PROT_READ, MAP_SHARED, mFd, mOffset);
+            if (addr == MAP_FAILED) {
+                ALOGE("%s: V4L2 buffer map failed: %s", __FUNCTION__, strerror(errno));
+                return -EINVAL;
+            }
+            mData = static_cast<uint8_t*>(addr);
         }
-        mData = static_cast<uint8_t*>(addr);
         mMapped = true;
     }
     *data = mData;
@@ -281,7 +290,7 @@ int V4L2Frame::unmap() {
     std::lock_guard<std::mutex> lk(mLock);
     if (mMapped) {
         ALOGV("%s: V4L unmap data %p size %zu", __FUNCTION__, mData, mDataSize);
-        if (munmap(mData, mDataSize) != 0) {
+        if (mPreMappedData == nullptr && munmap(mData, mDataSize) != 0) {
             ALOGE("%s: V4L2 buffer unmap failed: %s", __FUNCTION__, strerror(errno));
             return -EINVAL;
         }
@@ -145,8 +145,11 @@ struct Frame : public std::enable_shared_from_this<Frame> {
 // Also contains necessary information to enqueue the buffer back to V4L2 buffer queue
 class V4L2Frame : public Frame {
   public:
+    // 'preMappedData', when provided, is a persistent mapping of the V4L2 buffer
+    // owned by the session; the frame then uses it directly instead of doing an
+    // mmap/munmap pair per frame.
     V4L2Frame(uint32_t w, uint32_t h, uint32_t fourcc, int bufIdx, int fd, uint32_t dataSize,
-              uint64_t offset);
+              uint64_t offset, uint8_t* preMappedData = nullptr);
     virtual ~V4L2Frame();
 
     virtual int getData(uint8_t** outData, size_t* dataSize) override;
@@ -159,7 +162,8 @@ class V4L2Frame : public Frame {
     std::mutex mLock;
     const int mFd;  // used for mmap but doesn't claim ownership
     const size_t mDataSize;
-    const uint64_t mOffset;  // used for mmap
+    const uint64_t mOffset;           // used for mmap
+    uint8_t* const mPreMappedData;    // owned by the session, may be null
     uint8_t* mData = nullptr;
     bool mMapped = false;
 };
@@ -158,6 +158,9 @@ void LegacyCameraProviderImpl_2_4::sCameraDeviceStatusChange(
     char cameraId[kMaxCameraIdLen];
     snprintf(cameraId, sizeof(cameraId), "%d", camera_id);
     std::string cameraIdStr(cameraId);
+    auto statusIt = cp->mCameraStatusMap.find(cameraIdStr);
+    const bool statusChanged = statusIt == cp->mCameraStatusMap.end() ||
+                               statusIt->second != (camera_device_status_t)new_status;
     cp->mCameraStatusMap[cameraIdStr] = (camera_device_status_t) new_status;
 
     if (cp->mCallbacks == nullptr) {
@@ -166,6 +169,13 @@ void LegacyCameraProviderImpl_2_4::sCameraDeviceStatusChange(
         return;
     }
 
+    if (!statusChanged) {
+        // Some modules re-broadcast the current status of every camera, e.g.
+        // when camera service reconnects. The device list is already
+        // consistent, so don't wake the client for a no-op update.
+        return;
+    }
+
     bool found = false;
     CameraDeviceStatus status = (CameraDeviceStatus)new_status;
     for (auto const& deviceNamePair : cp->mCameraDeviceNames) {
@@ -202,8 +212,12 @@ void LegacyCameraProviderImpl_2_4::sTorchModeStatusChange(
     }
 
     Mutex::Autolock _l(cp->mCbLock);
-    if (cp->mCallbacks != nullptr) {
-        std::string cameraIdStr(camera_id);
+    std::string cameraIdStr(camera_id);
+    auto statusIt = cp->mTorchStatusMap.find(cameraIdStr);
+    const bool statusChanged = statusIt == cp->mTorchStatusMap.end() ||
+                               statusIt->second != (torch_mode_status_t)new_status;
+    cp->mTorchStatusMap[cameraIdStr] = (torch_mode_status_t) new_status;
+    if (cp->mCallbacks != nullptr && statusChanged) {
         TorchModeStatus status = (TorchModeStatus) new_status;
         for (auto const& deviceNamePair : cp->mCameraDeviceNames) {
             if (cameraIdStr.compare(deviceNamePair.first) == 0) {
@@ -83,6 +83,7 @@ protected:
 
     int mNumberOfLegacyCameras;
     std::map<std::string, camera_device_status_t> mCameraStatusMap; // camera id -> status
+    std::map<std::string, torch_mode_status_t> mTorchStatusMap; // camera id -> torch status
     std::map<std::string, bool> mOpenLegacySupported; // camera id -> open_legacy HAL1.0 supported
     SortedVector<std::string> mCameraIds; // the "0"/"1" legacy camera Ids
     // (cameraId string, hidl device name) pairs
@@ -48,6 +48,15 @@ constexpr char kPrefix[] = "video";
 constexpr int kPrefixLen = sizeof(kPrefix) - 1;
 constexpr int kDevicePrefixLen = sizeof(kDevicePath) + kPrefixLen - 1;
 
+// Verifying a candidate node costs an open/QUERYCAP plus a trial
+// characteristics init, so probes run on a small pool off the hotplug thread.
+constexpr int kNumProbeThreads = 2;
+// Quiet period after the last status change before a batch is delivered; a
+// USB hub attaching typically enumerates all its nodes well within this.
+constexpr int kHotplugQuietMs = 50;
+// Upper bound on how long a status change may be held back by new arrivals.
+constexpr int kHotplugMaxBatchMs = 500;
+
 bool matchDeviceName(int cameraIdOffset, const std::string& deviceName, std::string* deviceVersion,
                      std::string* cameraDevicePath) {
     std::smatch sm;
@@ -65,12 +74,33 @@ bool matchDeviceName(int cameraIdOffset, const std::string& deviceName, std::str
 }  // namespace
 
 ExternalCameraProvider::ExternalCameraProvider() : mCfg(ExternalCameraConfig::loadFromCfg()) {
+    mLastStatusChange = std::chrono::steady_clock::now();
+    mProbeThreads.reserve(kNumProbeThreads);
+    for (int i = 0; i < kNumProbeThreads; i++) {
+        mProbeThreads.emplace_back([this]() { probeWorkerLoop(); });
+    }
+    mBatchNotifyThread = std::thread([this]() { batchNotifyLoop(); });
     mHotPlugThread = std::make_shared<HotplugThread>(this);
     mHotPlugThread->run();
 }
 
 ExternalCameraProvider::~ExternalCameraProvider() {
+    // Stop the event source first so no new probes get enqueued
     mHotPlugThread->requestExitAndWait();
+    {
+        std::lock_guard<std::mutex> lk(mProbeLock);
+        mProbeThreadsExiting = true;
+    }
+    mProbeCond.notify_all();
+    for (auto& probeThread : mProbeThreads) {
+        probeThread.join();
+    }
+    {
+        std::lock_guard<std::mutex> lk(mNotifyLock);
+        mBatchNotifyExiting = true;
+    }
+    mNotifyCond.notify_all();
+    mBatchNotifyThread.join();
 }
 
 ndk::ScopedAStatus ExternalCameraProvider::setCallback(
@@ -174,19 +204,31 @@ ndk::ScopedAStatus ExternalCameraProvider::isConcurrentStreamCombinationSupporte
 
 void ExternalCameraProvider::addExternalCamera(const char* devName) {
     ALOGV("%s: ExtCam: adding %s to External Camera HAL!", __FUNCTION__, devName);
-    Mutex::Autolock _l(mLock);
     std::string deviceName;
     std::string cameraId =
             std::to_string(mCfg.cameraIdOffset + std::atoi(devName + kDevicePrefixLen));
     deviceName =
             std::string("device@") + ExternalCameraDevice::kDeviceVersion + "/external/" + cameraId;
-    mCameraStatusMap[deviceName] = CameraDeviceStatus::PRESENT;
-    if (mCallback != nullptr) {
-        mCallback->cameraDeviceStatusChange(deviceName, CameraDeviceStatus::PRESENT);
+    {
+        Mutex::Autolock _l(mLock);
+        mCameraStatusMap[deviceName] = CameraDeviceStatus::PRESENT;
     }
+    queueStatusChange(deviceName, CameraDeviceStatus::PRESENT);
 }
 
 void ExternalCameraProvider::deviceAdded(const char* devName) {
+    // Probing a device involves blocking ioctls and a trial characteristics
+    // init; hand it to the probe pool so the hotplug thread keeps draining
+    // inotify events while a burst of nodes is being verified.
+    {
+        std::lock_guard<std::mutex> lk(mProbeLock);
+        mProbeQueue.emplace_back(devName);
+    }
+    mProbeCond.notify_one();
+}
+
+void ExternalCameraProvider::probeDeviceAdded(const std::string& devicePath) {
+    const char* devName = devicePath.c_str();
     {
         base::unique_fd fd(::open(devName, O_RDWR));
         if (fd.get() < 0) {
@@ -219,7 +261,6 @@ void ExternalCameraProvider::deviceAdded(const char* devName) {
 }
 
 void ExternalCameraProvider::deviceRemoved(const char* devName) {
-    Mutex::Autolock _l(mLock);
     std::string deviceName;
     std::string cameraId =
             std::to_string(mCfg.cameraIdOffset + std::atoi(devName + kDevicePrefixLen));
@@ -227,14 +268,87 @@ void ExternalCameraProvider::deviceRemoved(const char* devName) {
     deviceName =
             std::string("device@") + ExternalCameraDevice::kDeviceVersion + "/external/" + cameraId;
 
-    if (mCameraStatusMap.erase(deviceName) == 0) {
-        // Unknown device, do not fire callback
-        ALOGE("%s: cannot find camera device to remove %s", __FUNCTION__, devName);
-        return;
+    {
+        Mutex::Autolock _l(mLock);
+        if (mCameraStatusMap.erase(deviceName) == 0) {
+            // Unknown device, do not fire callback
+            ALOGE("%s: cannot find camera device to remove %s", __FUNCTION__, devName);
+            return;
+        }
     }
 
-    if (mCallback != nullptr) {
-        mCallback->cameraDeviceStatusChange(deviceName, CameraDeviceStatus::NOT_PRESENT);
+    queueStatusChange(deviceName, CameraDeviceStatus::NOT_PRESENT);
+}
+
+void ExternalCameraProvider::queueStatusChange(const std::string& deviceName,
+                                               CameraDeviceStatus status) {
+    std::lock_guard<std::mutex> lk(mNotifyLock);
+    // Latest status wins; a node that came and went within one batch window
+    // collapses to its final state
+    mPendingStatusChanges[deviceName] = status;
+    mLastStatusChange = std::chrono::steady_clock::now();
+    mNotifyCond.notify_all();
+}
+
+void ExternalCameraProvider::probeWorkerLoop() {
+    std::unique_lock<std::mutex> lk(mProbeLock);
+    while (true) {
+        mProbeCond.wait(lk, [this]() { return mProbeThreadsExiting || !mProbeQueue.empty(); });
+        if (mProbeThreadsExiting) {
+            return;
+        }
+        std::string devicePath = std::move(mProbeQueue.front());
+        mProbeQueue.pop_front();
+        lk.unlock();
+        probeDeviceAdded(devicePath);
+        lk.lock();
+    }
+}
+
+void ExternalCameraProvider::batchNotifyLoop() {
+    std::unique_lock<std::mutex> lk(mNotifyLock);
+    while (!mBatchNotifyExiting) {
+        mNotifyCond.wait(lk, [this]() {
+            return mBatchNotifyExiting || !mPendingStatusChanges.empty();
+        });
+        if (mBatchNotifyExiting) {
+            return;
+        }
+
+        // Debounce: hold the batch until no new change arrived for the quiet
+        // interval, so one physical attach that surfaces several /dev/video
+        // nodes is announced in a single sweep. The cap bounds how long a
+        // steady stream of changes can delay delivery.
+        const auto batchStart = std::chrono::steady_clock::now();
+        while (!mBatchNotifyExiting) {
+            mNotifyCond.wait_for(lk, std::chrono::milliseconds(kHotplugQuietMs));
+            const auto now = std::chrono::steady_clock::now();
+            if (now - mLastStatusChange >= std::chrono::milliseconds(kHotplugQuietMs) ||
+                now - batchStart >= std::chrono::milliseconds(kHotplugMaxBatchMs)) {
+                break;
+            }
+        }
+        if (mBatchNotifyExiting) {
+            return;
+        }
+
+        auto changes = std::move(mPendingStatusChanges);
+        mPendingStatusChanges.clear();
+        lk.unlock();
+
+        std::shared_ptr<ICameraProviderCallback> callback;
+        {
+            Mutex::Autolock _l(mLock);
+            callback = mCallback;
+        }
+        if (callback != nullptr) {
+            for (const auto& [deviceName, status] : changes) {
+                ALOGV("%s: notifying %s -> %d", __FUNCTION__, deviceName.c_str(),
+                      static_cast<int>(status));
+                callback->cameraDeviceStatusChange(deviceName, status);
+            }
+        }
+        lk.lock();
     }
 }
 
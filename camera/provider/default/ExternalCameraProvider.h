@@ -29,6 +29,11 @@
 #include <poll.h>
 #include <utils/Mutex.h>
 #include <utils/Thread.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
@@ -73,6 +78,17 @@ class ExternalCameraProvider : public BnCameraProvider {
     void deviceRemoved(const char* devName);
     void updateAttachedCameras();
 
+    // Async hotplug probe pipeline. HotplugThread only enqueues candidate
+    // device paths; a small worker pool verifies them (V4L2 open/QUERYCAP and
+    // a trial characteristics init), and the resulting status changes are
+    // coalesced by the batch notify thread so a USB hub enumerating several
+    // /dev/video nodes at once produces one batch of callbacks instead of
+    // serializing a probe per uevent.
+    void probeWorkerLoop();
+    void probeDeviceAdded(const std::string& devicePath);
+    void batchNotifyLoop();
+    void queueStatusChange(const std::string& deviceName, CameraDeviceStatus status);
+
     // A separate thread to monitor '/dev' directory for '/dev/video*' entries
     // This thread calls back into ExternalCameraProvider when an actionable change is detected.
     class HotplugThread : public SimpleThread {
@@ -106,6 +122,19 @@ class ExternalCameraProvider : public BnCameraProvider {
     std::unordered_map<std::string, CameraDeviceStatus> mCameraStatusMap;  // camera id -> status
     const ExternalCameraConfig mCfg;
     std::shared_ptr<HotplugThread> mHotPlugThread;
+
+    std::vector<std::thread> mProbeThreads;
+    std::mutex mProbeLock;               // Protect access to mProbeQueue
+    std::condition_variable mProbeCond;  // signaled when a candidate path is enqueued
+    std::deque<std::string> mProbeQueue;
+    bool mProbeThreadsExiting = false;
+
+    std::thread mBatchNotifyThread;
+    std::mutex mNotifyLock;               // Protect access to mPendingStatusChanges
+    std::condition_variable mNotifyCond;  // signaled when a status change is queued
+    std::map<std::string, CameraDeviceStatus> mPendingStatusChanges;  // device name -> status
+    std::chrono::steady_clock::time_point mLastStatusChange;
+    bool mBatchNotifyExiting = false;
 };
 
 }  // namespace implementation
@@ -48,6 +48,21 @@ native_handle_t* dupFromAidl(const NativeHandle& handle) {
     return fromAidl(handle, true /* doDup */);
 }
 
+native_handle_t* moveFromAidl(NativeHandle&& handle) {
+    native_handle_t* to = native_handle_create(handle.fds.size(), handle.ints.size());
+    if (!to) return nullptr;
+
+    for (size_t i = 0; i < handle.fds.size(); i++) {
+        // Transfer ownership without a dup; the source descriptor is released
+        // rather than closed.
+        to->data[i] = handle.fds[i].release();
+    }
+    memcpy(to->data + handle.fds.size(), handle.ints.data(), handle.ints.size() * sizeof(int));
+    handle.fds.clear();
+    handle.ints.clear();
+    return to;
+}
+
 static NativeHandle toAidl(const native_handle_t* handle, bool doDup) {
     NativeHandle to;
 
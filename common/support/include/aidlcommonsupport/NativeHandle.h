@@ -40,6 +40,14 @@ native_handle_t* makeFromAidl(const aidl::android::hardware::common::NativeHandl
  */
 native_handle_t* dupFromAidl(const aidl::android::hardware::common::NativeHandle& handle);
 
+/**
+ * Creates a libcutils native handle from an AIDL native handle, consuming it.
+ * The FDs are moved out of the AIDL handle without a dup, and the result owns
+ * them, so it should be cleaned up with native_handle_close and
+ * native_handle_delete. The AIDL handle is left empty.
+ */
+native_handle_t* moveFromAidl(aidl::android::hardware::common::NativeHandle&& handle);
+
 /**
  * Creates an AIDL native handle from a libcutils native handle, but does not
  * dup internally, so the result will contain the same FDs as the handle itself.
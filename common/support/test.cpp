@@ -94,6 +94,35 @@ TEST(ConvertNativeHandle, DupFromAidl) {
     EXPECT_EQ(0, native_handle_delete(to));
 }
 
+TEST(ConvertNativeHandle, MoveFromAidlEmpty) {
+    NativeHandle handle;
+    native_handle_t* to = moveFromAidl(std::move(handle));
+    ASSERT_NE(to, nullptr);
+    EXPECT_EQ(0, to->numFds);
+    EXPECT_EQ(0, to->numInts);
+    EXPECT_EQ(0, native_handle_close(to));
+    EXPECT_EQ(0, native_handle_delete(to));
+}
+
+TEST(ConvertNativeHandle, MoveFromAidl) {
+    NativeHandle handle = makeTestAidlHandle();
+    int fd0 = handle.fds.at(0).get();
+    int fd1 = handle.fds.at(1).get();
+    native_handle_t* to = moveFromAidl(std::move(handle));
+    ASSERT_NE(to, nullptr);
+    // The same fds moved over without a dup, and the source gave them up.
+    ASSERT_EQ(2, to->numFds);
+    EXPECT_EQ(fd0, to->data[0]);
+    EXPECT_EQ(fd1, to->data[1]);
+    ASSERT_EQ(4, to->numInts);
+    for (size_t i = 0; i < 4; i++) {
+        EXPECT_EQ(static_cast<int>(i) + 1, to->data[to->numFds + i]);
+    }
+    EXPECT_TRUE(isAidlNativeHandleEmpty(handle));
+    EXPECT_EQ(0, native_handle_close(to));
+    EXPECT_EQ(0, native_handle_delete(to));
+}
+
 static native_handle_t* makeTestLibcutilsHandle() {
     native_handle_t* handle = native_handle_create(2, 4);
     handle->data[0] = dup(0);
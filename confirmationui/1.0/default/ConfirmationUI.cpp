@@ -24,8 +24,12 @@
 
 #include <android/hardware/confirmationui/1.0/generic/GenericOperation.h>
 
+#include <inttypes.h>
+#include <stdio.h>
 #include <time.h>
 
+#include <algorithm>
+
 namespace android {
 namespace hardware {
 namespace confirmationui {
@@ -37,16 +41,33 @@ using ::android::hardware::keymaster::V4_0::HardwareAuthToken;
 
 uint8_t hmacKey[32];
 
+namespace {
+int64_t nowUs() {
+    timespec ts;
+    clock_gettime(CLOCK_BOOTTIME, &ts);
+    return ts.tv_sec * INT64_C(1000000) + ts.tv_nsec / 1000;
+}
+}  // namespace
+
 // Methods from ::android::hardware::confirmationui::V1_0::IConfirmationUI follow.
 Return<ResponseCode> ConfirmationUI::promptUserConfirmation(
     const sp<IConfirmationResultCallback>& resultCB, const hidl_string& promptText,
     const hidl_vec<uint8_t>& extraData, const hidl_string& locale,
     const hidl_vec<UIOption>& uiOptions) {
     auto& operation = MyOperation::get();
+    int64_t promptedUs = nowUs();
     auto result = operation.init(resultCB, promptText, extraData, locale, uiOptions);
+    int64_t formattedUs = nowUs();
     if (result == ResponseCode::OK) {
         // This is where implementation start the UI and then call setPending on success.
         operation.setPending();
+        int64_t pendingUs = nowUs();
+        std::lock_guard<std::mutex> lock(stats_lock_);
+        stats_.count++;
+        stats_.lastFormatUs = formattedUs - promptedUs;
+        stats_.lastStartUs = pendingUs - formattedUs;
+        stats_.maxFormatUs = std::max(stats_.maxFormatUs, stats_.lastFormatUs);
+        stats_.maxStartUs = std::max(stats_.maxStartUs, stats_.lastStartUs);
     }
     return result;
 }
@@ -64,6 +85,24 @@ Return<void> ConfirmationUI::abort() {
     return Void();
 }
 
+Return<void> ConfirmationUI::debug(const hidl_handle& fd, const hidl_vec<hidl_string>& /* args */) {
+    if (fd.getNativeHandle() == nullptr || fd->numFds < 1) {
+        return Void();
+    }
+    PromptStats stats;
+    {
+        std::lock_guard<std::mutex> lock(stats_lock_);
+        stats = stats_;
+    }
+    dprintf(fd->data[0], "ConfirmationUI prompt latency:\n");
+    dprintf(fd->data[0], "  prompts: %" PRIu32 "\n", stats.count);
+    dprintf(fd->data[0], "  message formatting (us): last %" PRId64 " max %" PRId64 "\n",
+            stats.lastFormatUs, stats.maxFormatUs);
+    dprintf(fd->data[0], "  UI start (us): last %" PRId64 " max %" PRId64 "\n", stats.lastStartUs,
+            stats.maxStartUs);
+    return Void();
+}
+
 }  // namespace implementation
 }  // namespace V1_0
 }  // namespace confirmationui
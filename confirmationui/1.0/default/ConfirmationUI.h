@@ -22,6 +22,8 @@
 #include <hidl/MQDescriptor.h>
 #include <hidl/Status.h>
 
+#include <mutex>
+
 namespace android {
 namespace hardware {
 namespace confirmationui {
@@ -29,6 +31,7 @@ namespace V1_0 {
 namespace implementation {
 
 using ::android::hardware::hidl_array;
+using ::android::hardware::hidl_handle;
 using ::android::hardware::hidl_memory;
 using ::android::hardware::hidl_string;
 using ::android::hardware::hidl_vec;
@@ -46,6 +49,24 @@ struct ConfirmationUI : public IConfirmationUI {
     Return<ResponseCode> deliverSecureInputEvent(
         const ::android::hardware::keymaster::V4_0::HardwareAuthToken& secureInputToken) override;
     Return<void> abort() override;
+
+    // Dumps the prompt latency breakdown (message formatting vs. UI start)
+    // recorded by promptUserConfirmation, e.g. via dumpsys.
+    Return<void> debug(const hidl_handle& fd, const hidl_vec<hidl_string>& args) override;
+
+   private:
+    // Frame-budget instrumentation: time spent formatting the confirmation
+    // message and time from formatting done to the operation being pending
+    // (where a real implementation has its first secure frame up).
+    struct PromptStats {
+        uint32_t count = 0;
+        int64_t lastFormatUs = 0;
+        int64_t lastStartUs = 0;
+        int64_t maxFormatUs = 0;
+        int64_t maxStartUs = 0;
+    };
+    std::mutex stats_lock_;
+    PromptStats stats_;
 };
 
 }  // namespace implementation
@@ -27,8 +27,14 @@ namespace drm {
 namespace V1_0 {
 namespace implementation {
 
+    static PluginLoader<android::CryptoFactory>& getLoader() {
+        static PluginLoader<android::CryptoFactory> sLoader(getDrmPluginPath(),
+                "createCryptoFactory");
+        return sLoader;
+    }
+
     CryptoFactory::CryptoFactory() :
-        loader(getDrmPluginPath(), "createCryptoFactory") {
+        loader(getLoader()) {
     }
 
     // Methods from ::android::hardware::drm::V1_0::ICryptoFactory follow.
@@ -51,7 +51,9 @@ struct CryptoFactory : public ICryptoFactory {
             override;
 
 private:
-    PluginLoader<android::CryptoFactory> loader;
+    // Process-wide loader shared by all fetched factory instances; scanning
+    // the plugin directory and dlopen'ing every vendor library is done once.
+    PluginLoader<android::CryptoFactory>& loader;
 
     CryptoFactory(const CryptoFactory &) = delete;
     void operator=(const CryptoFactory &) = delete;
@@ -23,6 +23,8 @@
 #include <log/log.h>
 #include <media/stagefright/foundation/AString.h>
 
+#include <vector>
+
 using android::hardware::hidl_memory;
 using android::hidl::memory::V1_0::IMemory;
 
@@ -100,8 +102,10 @@ namespace implementation {
         legacyPattern.mEncryptBlocks = pattern.encryptBlocks;
         legacyPattern.mSkipBlocks = pattern.skipBlocks;
 
-        std::unique_ptr<android::CryptoPlugin::SubSample[]> legacySubSamples =
-                std::make_unique<android::CryptoPlugin::SubSample[]>(subSamples.size());
+        // Reused across calls on the same binder thread, so steady-state
+        // playback doesn't allocate a fresh subsample array per access unit.
+        thread_local std::vector<android::CryptoPlugin::SubSample> legacySubSamples;
+        legacySubSamples.resize(subSamples.size());
 
         size_t destSize = 0;
         for (size_t i = 0; i < subSamples.size(); i++) {
@@ -180,7 +184,7 @@ namespace implementation {
         shared_buffer_lock.unlock();
 
         ssize_t result = mLegacyPlugin->decrypt(secure, keyId.data(), iv.data(),
-                legacyMode, legacyPattern, srcPtr, legacySubSamples.get(),
+                legacyMode, legacyPattern, srcPtr, legacySubSamples.data(),
                 subSamples.size(), destPtr, &detailMessage);
 
         uint32_t status;
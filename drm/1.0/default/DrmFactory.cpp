@@ -27,8 +27,14 @@ namespace drm {
 namespace V1_0 {
 namespace implementation {
 
+    static PluginLoader<android::DrmFactory>& getLoader() {
+        static PluginLoader<android::DrmFactory> sLoader(getDrmPluginPath(),
+                "createDrmFactory");
+        return sLoader;
+    }
+
     DrmFactory::DrmFactory() :
-        loader(getDrmPluginPath(), "createDrmFactory") {
+        loader(getLoader()) {
     }
 
     // Methods from ::android::hardware::drm::V1_0::IDrmFactory follow.
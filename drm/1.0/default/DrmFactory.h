@@ -53,7 +53,9 @@ struct DrmFactory : public IDrmFactory {
             const hidl_string& appPackageName, createPlugin_cb _hidl_cb) override;
 
 private:
-    PluginLoader<android::DrmFactory> loader;
+    // Process-wide loader shared by all fetched factory instances; scanning
+    // the plugin directory and dlopen'ing every vendor library is done once.
+    PluginLoader<android::DrmFactory>& loader;
 
     DrmFactory(const DrmFactory &) = delete;
     void operator=(const DrmFactory &) = delete;
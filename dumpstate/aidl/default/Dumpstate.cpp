@@ -14,10 +14,25 @@
  * limitations under the License.
  */
 
+#include <android-base/file.h>
 #include <android-base/properties.h>
+#include <android-base/unique_fd.h>
 #include <log/log.h>
 #include "DumpstateUtil.h"
 
+#include <inttypes.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include "Dumpstate.h"
 
 using android::os::dumpstate::DumpFileToFd;
@@ -29,11 +44,40 @@ namespace dumpstate {
 
 const char kVerboseLoggingProperty[] = "persist.dumpstate.verbose_logging.enabled";
 
+namespace {
+
+// Budget used when the caller does not pass a usable timeout.
+constexpr int64_t kDefaultTimeoutMillis = 10'000;
+
+// State shared with a detached section thread. The buffer outlives a section
+// that overruns its budget, so whatever the section managed to write can still
+// be copied into the report.
+struct SectionState {
+    std::mutex lock;
+    std::condition_variable cv;
+    bool done = false;
+    ::android::base::unique_fd buf;
+};
+
+// Copies the section buffer with pread() so the writer's file offset is left
+// alone, in case a timed-out section thread is still appending to it.
+void copySectionToFd(int bufFd, int outFd) {
+    char buffer[4096];
+    off_t offset = 0;
+    ssize_t n;
+    while ((n = TEMP_FAILURE_RETRY(pread(bufFd, buffer, sizeof(buffer), offset))) > 0) {
+        if (!::android::base::WriteFully(outFd, buffer, n)) {
+            break;
+        }
+        offset += n;
+    }
+}
+
+}  // namespace
+
 ndk::ScopedAStatus Dumpstate::dumpstateBoard(const std::vector<::ndk::ScopedFileDescriptor>& in_fds,
                                              IDumpstateDevice::DumpstateMode in_mode,
                                              int64_t in_timeoutMillis) {
-    (void)in_timeoutMillis;
-
     if (in_fds.size() < 1) {
         return ndk::ScopedAStatus::fromExceptionCodeWithMessage(EX_ILLEGAL_ARGUMENT,
                                                                 "No file descriptor");
@@ -47,10 +91,10 @@ ndk::ScopedAStatus Dumpstate::dumpstateBoard(const std::vector<::ndk::ScopedFile
 
     switch (in_mode) {
         case IDumpstateDevice::DumpstateMode::FULL:
-            return dumpstateBoardImpl(fd, true);
+            return dumpstateBoardImpl(fd, true, in_timeoutMillis);
 
         case IDumpstateDevice::DumpstateMode::DEFAULT:
-            return dumpstateBoardImpl(fd, false);
+            return dumpstateBoardImpl(fd, false, in_timeoutMillis);
 
         case IDumpstateDevice::DumpstateMode::INTERACTIVE:
         case IDumpstateDevice::DumpstateMode::REMOTE:
@@ -83,14 +127,75 @@ bool Dumpstate::getVerboseLoggingEnabledImpl() {
     return ::android::base::GetBoolProperty(kVerboseLoggingProperty, false);
 }
 
-ndk::ScopedAStatus Dumpstate::dumpstateBoardImpl(const int fd, const bool full) {
+ndk::ScopedAStatus Dumpstate::dumpstateBoardImpl(const int fd, const bool full,
+                                                 const int64_t timeoutMillis) {
     ALOGD("DumpstateDevice::dumpstateBoard() FD: %d\n", fd);
 
     dprintf(fd, "verbose logging: %s\n", getVerboseLoggingEnabledImpl() ? "enabled" : "disabled");
-    dprintf(fd, "[%s] %s\n", (full ? "full" : "default"), "Hello, world!");
 
-    // Shows an example on how to use the libdumpstateutil API.
-    DumpFileToFd(fd, "cmdline", "/proc/self/cmdline");
+    // Each section is independent of the others, so they are collected in
+    // parallel and the total time is bounded by the slowest section instead of
+    // the sum. A real implementation only needs to append entries here.
+    using Section = std::pair<const char*, std::function<void(int)>>;
+    const std::vector<Section> sections = {
+            {"greeting",
+             [full](int outFd) {
+                 dprintf(outFd, "[%s] %s\n", (full ? "full" : "default"), "Hello, world!");
+             }},
+            // Shows an example on how to use the libdumpstateutil API.
+            {"cmdline",
+             [](int outFd) { DumpFileToFd(outFd, "cmdline", "/proc/self/cmdline"); }},
+    };
+
+    // Sections run concurrently, so each one gets the whole budget.
+    const int64_t budgetMillis = timeoutMillis > 0 ? timeoutMillis : kDefaultTimeoutMillis;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budgetMillis);
+
+    std::vector<std::shared_ptr<SectionState>> states;
+    states.reserve(sections.size());
+    for (const auto& [name, dumper] : sections) {
+        auto state = std::make_shared<SectionState>();
+        state->buf.reset(memfd_create(name, 0));
+        if (state->buf.get() < 0) {
+            // No buffer to collect into; run the section inline instead.
+            ALOGW("memfd_create failed for section %s, dumping it serially", name);
+            dumper(fd);
+            {
+                std::lock_guard<std::mutex> lock(state->lock);
+                state->done = true;
+            }
+            states.push_back(std::move(state));
+            continue;
+        }
+        std::thread([state, dumper = dumper] {
+            dumper(state->buf.get());
+            {
+                std::lock_guard<std::mutex> lock(state->lock);
+                state->done = true;
+            }
+            state->cv.notify_all();
+        }).detach();
+        states.push_back(std::move(state));
+    }
+
+    // Stream each section's buffer out as soon as it is ready. A section that
+    // overruns the deadline is left behind with its partial output dumped, so
+    // one hung section cannot take the whole board dump down with it.
+    for (size_t i = 0; i < sections.size(); i++) {
+        auto& state = *states[i];
+        bool done;
+        {
+            std::unique_lock<std::mutex> lock(state.lock);
+            done = state.cv.wait_until(lock, deadline, [&state] { return state.done; });
+        }
+        if (state.buf.get() >= 0) {
+            copySectionToFd(state.buf.get(), fd);
+        }
+        if (!done) {
+            dprintf(fd, "------ section %s timed out after %" PRId64 " ms ------\n",
+                    sections[i].first, budgetMillis);
+        }
+    }
 
     return ndk::ScopedAStatus::ok();
 }
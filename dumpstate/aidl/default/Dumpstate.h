@@ -28,7 +28,8 @@ namespace dumpstate {
 class Dumpstate : public BnDumpstateDevice {
   private:
     bool getVerboseLoggingEnabledImpl();
-    ::ndk::ScopedAStatus dumpstateBoardImpl(const int fd, const bool full);
+    ::ndk::ScopedAStatus dumpstateBoardImpl(const int fd, const bool full,
+                                            const int64_t timeoutMillis);
 
   public:
     ::ndk::ScopedAStatus dumpstateBoard(const std::vector<::ndk::ScopedFileDescriptor>& in_fds,
@@ -30,6 +30,7 @@ extern "C" {
 
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace gatekeeper {
@@ -100,6 +101,7 @@ class SoftGateKeeper : public GateKeeper {
 
     virtual bool GetFailureRecord(uint32_t uid, secure_id_t user_id, failure_record_t* record,
                                   bool /* secure */) {
+        std::lock_guard<std::mutex> lock(records_lock_);
         failure_record_t* stored = &failure_map_[uid];
         if (user_id != stored->secure_user_id) {
             stored->secure_user_id = user_id;
@@ -111,6 +113,7 @@ class SoftGateKeeper : public GateKeeper {
     }
 
     virtual bool ClearFailureRecord(uint32_t uid, secure_id_t user_id, bool /* secure */) {
+        std::lock_guard<std::mutex> lock(records_lock_);
         failure_record_t* stored = &failure_map_[uid];
         stored->secure_user_id = user_id;
         stored->last_checked_timestamp = 0;
@@ -119,6 +122,7 @@ class SoftGateKeeper : public GateKeeper {
     }
 
     virtual bool WriteFailureRecord(uint32_t uid, failure_record_t* record, bool /* secure */) {
+        std::lock_guard<std::mutex> lock(records_lock_);
         failure_map_[uid] = *record;
         return true;
     }
@@ -143,17 +147,27 @@ class SoftGateKeeper : public GateKeeper {
 
     bool DoVerify(const password_handle_t* expected_handle, const SizedBuffer& password) {
         uint64_t user_id = android::base::get_unaligned<secure_id_t>(&expected_handle->user_id);
-        FastHashMap::const_iterator it = fast_hash_map_.find(user_id);
-        if (it != fast_hash_map_.end() && VerifyFast(it->second, password)) {
-            return true;
-        } else {
-            if (GateKeeper::DoVerify(expected_handle, password)) {
-                uint64_t salt;
-                GetRandom(&salt, sizeof(salt));
-                fast_hash_map_[user_id] = ComputeFastHash(password, salt);
-                return true;
+        fast_hash_t fast_hash;
+        bool have_fast_hash = false;
+        {
+            std::lock_guard<std::mutex> lock(records_lock_);
+            FastHashMap::const_iterator it = fast_hash_map_.find(user_id);
+            if (it != fast_hash_map_.end()) {
+                fast_hash = it->second;
+                have_fast_hash = true;
             }
         }
+        if (have_fast_hash && VerifyFast(fast_hash, password)) {
+            return true;
+        }
+        if (GateKeeper::DoVerify(expected_handle, password)) {
+            uint64_t salt;
+            GetRandom(&salt, sizeof(salt));
+            fast_hash_t computed = ComputeFastHash(password, salt);
+            std::lock_guard<std::mutex> lock(records_lock_);
+            fast_hash_map_[user_id] = computed;
+            return true;
+        }
 
         return false;
     }
@@ -163,6 +177,10 @@ class SoftGateKeeper : public GateKeeper {
     typedef std::unordered_map<uint64_t, fast_hash_t> FastHashMap;
 
     std::unique_ptr<uint8_t[]> key_;
+    // Protects failure_map_ and fast_hash_map_ so concurrent enroll/verify
+    // calls from different binder threads only serialize on the record
+    // bookkeeping, not on the scrypt computation.
+    std::mutex records_lock_;
     FailureRecordMap failure_map_;
     FastHashMap fast_hash_map_;
 };
@@ -15,7 +15,10 @@
  */
 
 #include <arpa/inet.h>
+#include <atomic>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <hardware/hw_auth_token.h>
@@ -166,6 +169,40 @@ TEST(GateKeeperTest, UntrustedReEnroll) {
     ASSERT_NE(secure_id, response.auth_token.Data<hw_auth_token_t>()->user_id);
 }
 
+TEST(GateKeeperTest, ConcurrentVerifyDistinctUsers) {
+    constexpr const uint32_t user_count = 4;
+    constexpr const int verify_rounds = 3;
+    SoftGateKeeper gatekeeper;
+
+    std::vector<EnrollResponse> enroll_responses(user_count);
+    for (uint32_t uid = 0; uid < user_count; uid++) {
+        EnrollRequest request(uid, {}, makePasswordBuffer(uid), {});
+        gatekeeper.Enroll(request, &enroll_responses[uid]);
+        ASSERT_EQ(::gatekeeper::gatekeeper_error_t::ERROR_NONE, enroll_responses[uid].error);
+    }
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (uint32_t uid = 0; uid < user_count; uid++) {
+        threads.emplace_back([&, uid] {
+            for (int round = 0; round < verify_rounds; round++) {
+                VerifyRequest request(
+                        uid, 1, copySizedBuffer(enroll_responses[uid].enrolled_password_handle),
+                        makePasswordBuffer(uid));
+                VerifyResponse response;
+                gatekeeper.Verify(request, &response);
+                if (response.error != ::gatekeeper::gatekeeper_error_t::ERROR_NONE) {
+                    failures++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(0, failures.load());
+}
+
 TEST(GateKeeperTest, VerifyBogusData) {
     SoftGateKeeper gatekeeper;
     VerifyResponse response;
@@ -34,7 +34,10 @@ std::shared_ptr<IGnssBatchingCallback> GnssBatching::sCallback = nullptr;
 GnssBatching::GnssBatching()
     : mMinIntervalMs(1000),
       mWakeUpOnFifoFull(false),
-      mBatchedLocations(std::vector<GnssLocation>()) {}
+      mBatchedLocations(BATCH_SIZE),
+      mBatchWriteIdx(0),
+      mBatchedCount(0),
+      mNumDroppedOnWrap(0) {}
 GnssBatching::~GnssBatching() {
     cleanup();
 }
@@ -80,7 +83,15 @@ ndk::ScopedAStatus GnssBatching::start(const Options& options) {
 
 ndk::ScopedAStatus GnssBatching::flush() {
     ALOGD("flush");
-    std::vector<GnssLocation> copy = std::vector<GnssLocation>(mBatchedLocations);
+    // Assemble the batch oldest-first from the ring in a single pass.
+    std::vector<GnssLocation> copy;
+    copy.reserve(mBatchedCount);
+    const size_t capacity = mBatchedLocations.size();
+    size_t readIdx = (mBatchWriteIdx + capacity - mBatchedCount) % capacity;
+    for (size_t i = 0; i < mBatchedCount; i++) {
+        copy.push_back(mBatchedLocations[readIdx]);
+        readIdx = (readIdx + 1) % capacity;
+    }
     ndk::ScopedAStatus status;
     if (sCallback != nullptr) {
         sCallback->gnssLocationBatchCb(copy);
@@ -89,7 +100,12 @@ ndk::ScopedAStatus GnssBatching::flush() {
         ALOGE("GnssBatchingCallback is null. flush() failed.");
         status = ndk::ScopedAStatus::fromServiceSpecificError(IGnss::ERROR_GENERIC);
     }
-    mBatchedLocations.clear();
+    if (mNumDroppedOnWrap > 0) {
+        ALOGW("flush: %" PRIu64 " location(s) overwritten before they could be flushed",
+              mNumDroppedOnWrap);
+        mNumDroppedOnWrap = 0;
+    }
+    mBatchedCount = 0;
     return status;
 }
 
@@ -116,11 +132,14 @@ ndk::ScopedAStatus GnssBatching::cleanup() {
 }
 
 void GnssBatching::batchLocation(const GnssLocation& location) {
-    if (mBatchedLocations.size() > BATCH_SIZE) {
-        mBatchedLocations.erase(mBatchedLocations.begin());
+    mBatchedLocations[mBatchWriteIdx] = location;
+    mBatchWriteIdx = (mBatchWriteIdx + 1) % mBatchedLocations.size();
+    if (mBatchedCount < mBatchedLocations.size()) {
+        mBatchedCount++;
+    } else {
+        mNumDroppedOnWrap++;
     }
-    mBatchedLocations.push_back(location);
-    if (mWakeUpOnFifoFull && mBatchedLocations.size() == BATCH_SIZE) {
+    if (mWakeUpOnFifoFull && mBatchedCount == mBatchedLocations.size()) {
         flush();
     }
 }
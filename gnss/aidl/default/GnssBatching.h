@@ -48,7 +48,13 @@ struct GnssBatching : public BnGnssBatching {
     // Synchronization lock for sCallback
     mutable std::mutex mMutex;
 
+    // Preallocated circular buffer holding the most recent locations,
+    // modeled after a batching hardware FIFO. Once full, the oldest entry
+    // is overwritten and counted as dropped until the next flush.
     std::vector<GnssLocation> mBatchedLocations;
+    size_t mBatchWriteIdx;
+    size_t mBatchedCount;
+    uint64_t mNumDroppedOnWrap;
 };
 
 }  // namespace aidl::android::hardware::gnss
@@ -116,7 +116,9 @@ void GnssMeasurementInterface::start(const bool enableCorrVecOutputs,
                 ReplayUtils::isGnssRawMeasurement(
                         rawMeasurementStr =
                                 DeviceFileReader::Instance().getGnssRawMeasurementData())) {
-                ALOGD("rawMeasurementStr(size: %zu) from device file: %s", rawMeasurementStr.size(),
+                // Per-epoch log; the full payload is only worth printing on
+                // verbose builds, it can be several KB at up to 10Hz.
+                ALOGV("rawMeasurementStr(size: %zu) from device file: %s", rawMeasurementStr.size(),
                       rawMeasurementStr.c_str());
                 auto measurement =
                         GnssRawMeasurementParser::getMeasurementFromStrs(rawMeasurementStr);
@@ -147,7 +149,7 @@ void GnssMeasurementInterface::stop() {
 }
 
 void GnssMeasurementInterface::reportMeasurement(const GnssData& data) {
-    ALOGD("reportMeasurement()");
+    ALOGV("reportMeasurement()");
     std::shared_ptr<IGnssMeasurementCallback> callbackCopy;
     {
         std::unique_lock<std::mutex> lock(mMutex);
@@ -35,10 +35,17 @@ ndk::ScopedAStatus GnssPsds::injectPsdsData(PsdsType psdsType,
                                             const std::vector<uint8_t>& psdsData) {
     ALOGD("injectPsdsData. psdsType: %d, psdsData: %d bytes", static_cast<int>(psdsType),
           static_cast<int>(psdsData.size()));
-    if (psdsData.size() > 0) {
-        return ndk::ScopedAStatus::ok();
-    } else {
+    if (psdsData.size() == 0) {
         return ndk::ScopedAStatus::fromServiceSpecificError(IGnss::ERROR_INVALID_ARGUMENT);
     }
+    std::unique_lock<std::mutex> lock(mMutex);
+    std::vector<uint8_t>& storedData = mPsdsDataByType[static_cast<int32_t>(psdsType)];
+    if (storedData == psdsData) {
+        // Unchanged since the last injection; nothing to hand to the engine.
+        ALOGD("injectPsdsData. psdsType: %d unchanged, skipping", static_cast<int>(psdsType));
+        return ndk::ScopedAStatus::ok();
+    }
+    storedData = psdsData;
+    return ndk::ScopedAStatus::ok();
 }
 }  // namespace aidl::android::hardware::gnss
@@ -18,6 +18,9 @@
 
 #include <aidl/android/hardware/gnss/BnGnssPsds.h>
 
+#include <unordered_map>
+#include <vector>
+
 namespace aidl::android::hardware::gnss {
 
 struct GnssPsds : public BnGnssPsds {
@@ -30,7 +33,12 @@ struct GnssPsds : public BnGnssPsds {
     // Guarded by mMutex
     static std::shared_ptr<IGnssPsdsCallback> sCallback;
 
-    // Synchronization lock for sCallback
+    // Last accepted payload per PSDS type, guarded by mMutex. The framework
+    // re-injects the full payload on every session start; keeping the previous
+    // one lets unchanged re-injections be acknowledged without re-processing.
+    std::unordered_map<int32_t, std::vector<uint8_t>> mPsdsDataByType;
+
+    // Synchronization lock for sCallback and mPsdsDataByType
     mutable std::mutex mMutex;
 };
 
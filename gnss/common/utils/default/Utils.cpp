@@ -18,8 +18,12 @@
 #include <MockLocation.h>
 #include <Utils.h>
 #include <aidl/android/hardware/gnss/BnGnss.h>
+#include <cutils/properties.h>
 #include <utils/SystemClock.h>
 
+#include <algorithm>
+#include <iterator>
+
 namespace android {
 namespace hardware {
 namespace gnss {
@@ -147,6 +151,48 @@ GnssDataV2_0 Utils::getMockMeasurementV2_0() {
     return gnssData;
 }
 
+namespace {
+
+// Number of measurements synthesized per mock epoch. The default of 1 keeps
+// the historical single-measurement epoch; hardware-in-the-loop harnesses
+// raise it to exercise large multi-constellation epochs at high report rates.
+constexpr char kMockSvCountProp[] = "debug.location.gnss.mock_sv_count";
+constexpr int kMaxMockSvCount = 64;
+
+// Derives an additional per-SV measurement from the base mock measurement,
+// cycling svid, constellation and carrier frequency across the same signals
+// getMockSvInfoList() reports.
+GnssMeasurement deriveMockMeasurement(const GnssMeasurement& base, int index) {
+    static constexpr struct {
+        GnssConstellationType constellation;
+        float carrierFrequencyHz;
+    } kSignals[] = {
+            {GnssConstellationType::GPS, kGpsL1FreqHz},
+            {GnssConstellationType::GPS, kGpsL5FreqHz},
+            {GnssConstellationType::GLONASS, kGloG1FreqHz},
+            {GnssConstellationType::IRNSS, kIrnssL5FreqHz},
+    };
+    const auto& signal = kSignals[index % std::size(kSignals)];
+
+    GnssMeasurement measurement = base;
+    measurement.svid = 1 + (base.svid + index * 7) % 32;
+    measurement.signalType.constellation = signal.constellation;
+    measurement.signalType.carrierFrequencyHz = signal.carrierFrequencyHz;
+    measurement.receivedSvTimeInNs += index * 31;
+    measurement.antennaCN0DbHz -= (index % 10) * 0.5;
+    measurement.basebandCN0DbHz -= (index % 10) * 0.5;
+    measurement.pseudorangeRateMps += index * 0.3;
+    // Repeating the base PVT and correlation vectors for every SV would just
+    // pad the parcel with identical blocks; derived SVs report without them.
+    measurement.flags &= ~(GnssMeasurement::HAS_SATELLITE_PVT |
+                           GnssMeasurement::HAS_CORRELATION_VECTOR);
+    measurement.satellitePvt = {};
+    measurement.correlationVectors = {};
+    return measurement;
+}
+
+}  // anonymous namespace
+
 GnssData Utils::getMockMeasurement(const bool enableCorrVecOutputs, const bool enableFullTracking) {
     aidl::android::hardware::gnss::GnssSignalType signalType = {
             .constellation = GnssConstellationType::GLONASS,
@@ -243,6 +289,14 @@ GnssData Utils::getMockMeasurement(const bool enableCorrVecOutputs, const bool e
         measurement.flags |= GnssMeasurement::HAS_CORRELATION_VECTOR;
     }
 
+    std::vector<GnssMeasurement> measurements = {measurement};
+    const int svCount =
+            std::clamp(property_get_int32(kMockSvCountProp, 1), 1, kMaxMockSvCount);
+    measurements.reserve(svCount);
+    for (int i = 1; i < svCount; i++) {
+        measurements.push_back(deriveMockMeasurement(measurement, i));
+    }
+
     GnssAgc gnssAgc1 = {
             .agcLevelDb = 3.5,
             .constellation = GnssConstellationType::GLONASS,
@@ -255,7 +309,7 @@ GnssData Utils::getMockMeasurement(const bool enableCorrVecOutputs, const bool e
             .carrierFrequencyHz = (int64_t)kGpsL1FreqHz,
     };
 
-    GnssData gnssData = {.measurements = {measurement},
+    GnssData gnssData = {.measurements = measurements,
                          .clock = clock,
                          .elapsedRealtime = timestamp,
                          .gnssAgcs = std::vector({gnssAgc1, gnssAgc2}),
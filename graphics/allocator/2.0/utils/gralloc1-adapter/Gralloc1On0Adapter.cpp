@@ -23,6 +23,7 @@
 
 #include <grallocusage/GrallocUsageConversion.h>
 
+#include <cutils/properties.h>
 #include <hardware/gralloc.h>
 
 #include <log/log.h>
@@ -66,12 +67,22 @@ Gralloc1On0Adapter::Gralloc1On0Adapter(const hw_module_t* module)
         ALOGE("Failed to open gralloc0 module: %d", error);
     }
     ALOGV("Opened gralloc0 device %p", mDevice);
+
+    mPoolEnabled = property_get_bool("debug.gralloc.enable_buffer_pool", false);
+    if (mPoolEnabled) {
+        ALOGV("Buffer pool enabled");
+    }
 }
 
 Gralloc1On0Adapter::~Gralloc1On0Adapter()
 {
     ALOGV("Destructing");
     if (mDevice) {
+        {
+            std::lock_guard<std::mutex> lock(mPoolMutex);
+            evictExpiredPooledBuffersLocked(
+                    std::chrono::steady_clock::time_point::max());
+        }
         ALOGV("Closing gralloc0 device %p", mDevice);
         ::gralloc_close(mDevice);
     }
@@ -247,6 +258,16 @@ gralloc1_error_t Gralloc1On0Adapter::allocate(
     // pointer, which only occurs when mDevice has been loaded successfully and
     // we are permitted to allocate
 
+    if (auto buffer = recycleFromPool(descriptor)) {
+        buffer_handle_t handle = buffer->getHandle();
+        ALOGV("Recycled pooled buffer %p", handle);
+
+        *outBufferHandle = handle;
+        std::lock_guard<std::mutex> lock(mBufferMutex);
+        mBuffers.emplace(handle, std::move(buffer));
+        return GRALLOC1_ERROR_NONE;
+    }
+
     int usage = android_convertGralloc1To0Usage(
             descriptor->producerUsage, descriptor->consumerUsage);
     buffer_handle_t handle = nullptr;
@@ -346,10 +367,12 @@ gralloc1_error_t Gralloc1On0Adapter::release(
 
     buffer_handle_t handle = buffer->getHandle();
     if (buffer->wasAllocated()) {
-        ALOGV("Calling free(%p)", handle);
-        int result = mDevice->free(mDevice, handle);
-        if (result != 0) {
-            ALOGE("gralloc0 free failed: %d", result);
+        if (!returnToPool(*buffer)) {
+            ALOGV("Calling free(%p)", handle);
+            int result = mDevice->free(mDevice, handle);
+            if (result != 0) {
+                ALOGE("gralloc0 free failed: %d", result);
+            }
         }
     } else {
         ALOGV("Calling unregisterBuffer(%p)", handle);
@@ -538,6 +561,87 @@ gralloc1_error_t Gralloc1On0Adapter::unlock(
     return GRALLOC1_ERROR_NONE;
 }
 
+std::shared_ptr<Gralloc1On0Adapter::Buffer> Gralloc1On0Adapter::recycleFromPool(
+        const std::shared_ptr<Descriptor>& descriptor)
+{
+    if (!mPoolEnabled) {
+        return nullptr;
+    }
+
+    PoolKey key = {descriptor->width, descriptor->height, descriptor->format,
+            descriptor->layerCount,
+            static_cast<uint64_t>(descriptor->producerUsage),
+            static_cast<uint64_t>(descriptor->consumerUsage)};
+
+    std::lock_guard<std::mutex> lock(mPoolMutex);
+    evictExpiredPooledBuffersLocked(std::chrono::steady_clock::now());
+
+    auto it = mBufferPool.find(key);
+    if (it == mBufferPool.end()) {
+        return nullptr;
+    }
+
+    const PooledBuffer& entry = it->second;
+    auto buffer = std::make_shared<Buffer>(entry.handle, entry.store,
+            *descriptor, entry.stride, entry.numFlexPlanes, true);
+    mBufferPool.erase(it);
+    return buffer;
+}
+
+bool Gralloc1On0Adapter::returnToPool(const Buffer& buffer)
+{
+    if (!mPoolEnabled) {
+        return false;
+    }
+
+    PoolKey key = {};
+    auto producerUsage = GRALLOC1_PRODUCER_USAGE_NONE;
+    auto consumerUsage = GRALLOC1_CONSUMER_USAGE_NONE;
+    buffer.getDimensions(&key.width, &key.height);
+    buffer.getFormat(&key.format);
+    buffer.getLayerCount(&key.layerCount);
+    buffer.getProducerUsage(&producerUsage);
+    buffer.getConsumerUsage(&consumerUsage);
+    key.producerUsage = static_cast<uint64_t>(producerUsage);
+    key.consumerUsage = static_cast<uint64_t>(consumerUsage);
+
+    PooledBuffer entry = {};
+    entry.handle = buffer.getHandle();
+    buffer.getBackingStore(&entry.store);
+    buffer.getStride(&entry.stride);
+    buffer.getNumFlexPlanes(&entry.numFlexPlanes);
+
+    auto now = std::chrono::steady_clock::now();
+    entry.expiry = now + kPooledBufferTtl;
+
+    std::lock_guard<std::mutex> lock(mPoolMutex);
+    evictExpiredPooledBuffersLocked(now);
+    if (mBufferPool.size() >= kMaxPooledBuffers) {
+        return false;
+    }
+
+    ALOGV("Pooling buffer %p", entry.handle);
+    mBufferPool.emplace(key, entry);
+    return true;
+}
+
+void Gralloc1On0Adapter::evictExpiredPooledBuffersLocked(
+        std::chrono::steady_clock::time_point now)
+{
+    for (auto it = mBufferPool.begin(); it != mBufferPool.end();) {
+        if (it->second.expiry <= now) {
+            ALOGV("Evicting pooled buffer %p", it->second.handle);
+            int result = mDevice->free(mDevice, it->second.handle);
+            if (result != 0) {
+                ALOGE("gralloc0 free failed: %d", result);
+            }
+            it = mBufferPool.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 std::shared_ptr<Gralloc1On0Adapter::Descriptor>
 Gralloc1On0Adapter::getDescriptor(gralloc1_buffer_descriptor_t descriptorId)
 {
@@ -21,6 +21,7 @@
 #include <log/log.h>
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -450,6 +451,71 @@ private:
             std::shared_ptr<Descriptor>> mDescriptors;
     std::mutex mBufferMutex;
     std::unordered_map<buffer_handle_t, std::shared_ptr<Buffer>> mBuffers;
+
+    // Buffer pool
+    //
+    // When enabled (debug.gralloc.enable_buffer_pool), buffers that were
+    // allocated by this adapter are not freed on their last release but
+    // parked in free lists keyed by the allocation shape, and recycled by
+    // later allocate() calls with an identical descriptor. Buffers that were
+    // merely registered here are always unregistered immediately, since the
+    // backing allocation belongs to another process. Pooled entries expire
+    // after a TTL so an idle pipeline does not pin its working set forever.
+
+    struct PoolKey {
+        uint32_t width;
+        uint32_t height;
+        int32_t format;
+        uint32_t layerCount;
+        uint64_t producerUsage;
+        uint64_t consumerUsage;
+
+        bool operator==(const PoolKey& rhs) const {
+            return width == rhs.width && height == rhs.height &&
+                    format == rhs.format && layerCount == rhs.layerCount &&
+                    producerUsage == rhs.producerUsage &&
+                    consumerUsage == rhs.consumerUsage;
+        }
+    };
+
+    struct PoolKeyHash {
+        size_t operator()(const PoolKey& key) const {
+            size_t hash = std::hash<uint32_t>()(key.width);
+            hash = hash * 31 + std::hash<uint32_t>()(key.height);
+            hash = hash * 31 + std::hash<int32_t>()(key.format);
+            hash = hash * 31 + std::hash<uint32_t>()(key.layerCount);
+            hash = hash * 31 + std::hash<uint64_t>()(key.producerUsage);
+            hash = hash * 31 + std::hash<uint64_t>()(key.consumerUsage);
+            return hash;
+        }
+    };
+
+    struct PooledBuffer {
+        buffer_handle_t handle;
+        gralloc1_backing_store_t store;
+        uint32_t stride;
+        uint32_t numFlexPlanes;
+        std::chrono::steady_clock::time_point expiry;
+    };
+
+    static constexpr size_t kMaxPooledBuffers = 16;
+    static constexpr std::chrono::seconds kPooledBufferTtl{1};
+
+    // Takes a pooled buffer matching the descriptor, or returns nullptr
+    std::shared_ptr<Buffer> recycleFromPool(
+            const std::shared_ptr<Descriptor>& descriptor);
+
+    // Parks the buffer in the pool instead of freeing it; returns false if
+    // the pool is disabled or full and the buffer must be freed
+    bool returnToPool(const Buffer& buffer);
+
+    // Frees pooled buffers whose TTL has lapsed; called with mPoolMutex held
+    void evictExpiredPooledBuffersLocked(
+            std::chrono::steady_clock::time_point now);
+
+    bool mPoolEnabled = false;
+    std::mutex mPoolMutex;
+    std::unordered_multimap<PoolKey, PooledBuffer, PoolKeyHash> mBufferPool;
 };
 
 } // namespace hardware
@@ -29,8 +29,10 @@
 #include <memory>
 #include <vector>
 
+#include <errno.h>
 #include <inttypes.h>
 #include <string.h>
+#include <sys/mman.h>
 
 #include <android/hardware/graphics/composer/2.1/IComposer.h>
 #include <fmq/MessageQueue.h>
@@ -55,11 +57,24 @@ using CommandQueueType = MessageQueue<uint32_t, kSynchronizedReadWrite>;
 class CommandWriterBase {
    public:
     CommandWriterBase(uint32_t initialMaxSize) : mDataMaxSize(initialMaxSize) {
-        mData = std::make_unique<uint32_t[]>(mDataMaxSize);
+        // Reserve address space for the worst case up front instead of growing the
+        // buffer with copies as commands accumulate.  The mapping is anonymous and
+        // MAP_NORESERVE: pages past the high-water mark are never faulted in, so the
+        // reservation costs virtual address space only, and growData() can extend
+        // mDataMaxSize without relocating commands that were already written.
+        mDataReservedSize = std::max(initialMaxSize, kDefaultReservedSize);
+        void* data = mmap(nullptr, sizeof(uint32_t) * mDataReservedSize, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        LOG_ALWAYS_FATAL_IF(data == MAP_FAILED, "failed to map command buffer: %s",
+                            strerror(errno));
+        mData = static_cast<uint32_t*>(data);
         reset();
     }
 
-    virtual ~CommandWriterBase() { reset(); }
+    virtual ~CommandWriterBase() {
+        reset();
+        munmap(mData, sizeof(uint32_t) * mDataReservedSize);
+    }
 
     void reset() {
         mDataWritten = 0;
@@ -110,7 +125,7 @@ class CommandWriterBase {
 
         // write data to queue, optionally resizing it
         if (mQueue && (mDataMaxSize <= mQueue->getQuantumCount())) {
-            if (!mQueue->write(mData.get(), mDataWritten)) {
+            if (!mQueue->write(mData, mDataWritten)) {
                 ALOGE("failed to write commands to message queue");
                 return false;
             }
@@ -118,7 +133,7 @@ class CommandWriterBase {
             *outQueueChanged = false;
         } else {
             auto newQueue = std::make_unique<CommandQueueType>(mDataMaxSize);
-            if (!newQueue->isValid() || !newQueue->write(mData.get(), mDataWritten)) {
+            if (!newQueue->isValid() || !newQueue->write(mData, mDataWritten)) {
                 ALOGE("failed to prepare a new message queue ");
                 return false;
             }
@@ -539,13 +554,18 @@ class CommandWriterBase {
 
     static constexpr uint16_t kMaxLength = std::numeric_limits<uint16_t>::max();
 
-    std::unique_ptr<uint32_t[]> mData;
+    uint32_t* mData = nullptr;
     uint32_t mDataWritten;
 
    private:
+    // 4M command words of address space.  Pages are only ever faulted in up to the
+    // high-water mark of a frame, so the typical cost is a few dozen KB of resident
+    // memory while even pathological layer-churn frames stay within the reservation.
+    static constexpr uint32_t kDefaultReservedSize = (16 << 20) / sizeof(uint32_t);
+
     void growData(uint32_t grow) {
         uint32_t newWritten = mDataWritten + grow;
-        if (newWritten < mDataWritten) {
+        if (newWritten < mDataWritten || newWritten > mDataReservedSize) {
             LOG_ALWAYS_FATAL("buffer overflowed; data written %" PRIu32 ", growing by %" PRIu32,
                              mDataWritten, grow);
         }
@@ -554,18 +574,18 @@ class CommandWriterBase {
             return;
         }
 
+        // The pages are already mapped; growing is just a matter of raising the
+        // limit that writeQueue() sizes the message queue from.  Keep the doubling
+        // policy so the queue is not re-created on every small increment.
         uint32_t newMaxSize = mDataMaxSize << 1;
         if (newMaxSize < newWritten) {
             newMaxSize = newWritten;
         }
-
-        auto newData = std::make_unique<uint32_t[]>(newMaxSize);
-        std::copy_n(mData.get(), mDataWritten, newData.get());
-        mDataMaxSize = newMaxSize;
-        mData = std::move(newData);
+        mDataMaxSize = std::min(newMaxSize, mDataReservedSize);
     }
 
     uint32_t mDataMaxSize;
+    uint32_t mDataReservedSize;
     // end offset of the current command
     uint32_t mCommandEnd;
 
@@ -20,6 +20,7 @@
 #warning "ComposerCommandEngine.h included without LOG_TAG"
 #endif
 
+#include <array>
 #include <vector>
 
 #include <composer-command-buffer/2.1/ComposerCommandBuffer.h>
@@ -89,57 +90,86 @@ class ComposerCommandEngine : protected CommandReaderBase {
     }
 
    protected:
+    using CommandHandler = bool (ComposerCommandEngine::*)(uint16_t);
+
+    //! One past the highest 2.1 opcode once the length bits are shifted out.
+    static constexpr size_t kCommandDispatchTableSize =
+            (static_cast<uint32_t>(IComposerClient::Command::SET_LAYER_Z_ORDER) >>
+             static_cast<uint32_t>(IComposerClient::Command::OPCODE_SHIFT)) +
+            1;
+
+    /**
+     * The 2.1 opcode space is dense once the length bits are shifted out, so commands are
+     * dispatched through an opcode-indexed table instead of a switch. readQueue() already
+     * snapshots the whole queued command region in a single fmq read; the table keeps the pass
+     * over that snapshot free of per-command branch chains. Later composer versions dispatch
+     * their own opcodes first and fall back to this table via executeCommand.
+     */
+    static const std::array<CommandHandler, kCommandDispatchTableSize>& getCommandDispatchTable() {
+        static const std::array<CommandHandler, kCommandDispatchTableSize> table = [] {
+            std::array<CommandHandler, kCommandDispatchTableSize> entries{};
+            auto set = [&entries](IComposerClient::Command command, CommandHandler handler) {
+                entries[static_cast<uint32_t>(command) >>
+                        static_cast<uint32_t>(IComposerClient::Command::OPCODE_SHIFT)] = handler;
+            };
+            set(IComposerClient::Command::SELECT_DISPLAY,
+                &ComposerCommandEngine::executeSelectDisplay);
+            set(IComposerClient::Command::SELECT_LAYER, &ComposerCommandEngine::executeSelectLayer);
+            set(IComposerClient::Command::SET_COLOR_TRANSFORM,
+                &ComposerCommandEngine::executeSetColorTransform);
+            set(IComposerClient::Command::SET_CLIENT_TARGET,
+                &ComposerCommandEngine::executeSetClientTarget);
+            set(IComposerClient::Command::SET_OUTPUT_BUFFER,
+                &ComposerCommandEngine::executeSetOutputBuffer);
+            set(IComposerClient::Command::VALIDATE_DISPLAY,
+                &ComposerCommandEngine::executeValidateDisplay);
+            set(IComposerClient::Command::PRESENT_OR_VALIDATE_DISPLAY,
+                &ComposerCommandEngine::executePresentOrValidateDisplay);
+            set(IComposerClient::Command::ACCEPT_DISPLAY_CHANGES,
+                &ComposerCommandEngine::executeAcceptDisplayChanges);
+            set(IComposerClient::Command::PRESENT_DISPLAY,
+                &ComposerCommandEngine::executePresentDisplay);
+            set(IComposerClient::Command::SET_LAYER_CURSOR_POSITION,
+                &ComposerCommandEngine::executeSetLayerCursorPosition);
+            set(IComposerClient::Command::SET_LAYER_BUFFER,
+                &ComposerCommandEngine::executeSetLayerBuffer);
+            set(IComposerClient::Command::SET_LAYER_SURFACE_DAMAGE,
+                &ComposerCommandEngine::executeSetLayerSurfaceDamage);
+            set(IComposerClient::Command::SET_LAYER_BLEND_MODE,
+                &ComposerCommandEngine::executeSetLayerBlendMode);
+            set(IComposerClient::Command::SET_LAYER_COLOR,
+                &ComposerCommandEngine::executeSetLayerColor);
+            set(IComposerClient::Command::SET_LAYER_COMPOSITION_TYPE,
+                &ComposerCommandEngine::executeSetLayerCompositionType);
+            set(IComposerClient::Command::SET_LAYER_DATASPACE,
+                &ComposerCommandEngine::executeSetLayerDataspace);
+            set(IComposerClient::Command::SET_LAYER_DISPLAY_FRAME,
+                &ComposerCommandEngine::executeSetLayerDisplayFrame);
+            set(IComposerClient::Command::SET_LAYER_PLANE_ALPHA,
+                &ComposerCommandEngine::executeSetLayerPlaneAlpha);
+            set(IComposerClient::Command::SET_LAYER_SIDEBAND_STREAM,
+                &ComposerCommandEngine::executeSetLayerSidebandStream);
+            set(IComposerClient::Command::SET_LAYER_SOURCE_CROP,
+                &ComposerCommandEngine::executeSetLayerSourceCrop);
+            set(IComposerClient::Command::SET_LAYER_TRANSFORM,
+                &ComposerCommandEngine::executeSetLayerTransform);
+            set(IComposerClient::Command::SET_LAYER_VISIBLE_REGION,
+                &ComposerCommandEngine::executeSetLayerVisibleRegion);
+            set(IComposerClient::Command::SET_LAYER_Z_ORDER,
+                &ComposerCommandEngine::executeSetLayerZOrder);
+            return entries;
+        }();
+        return table;
+    }
+
     virtual bool executeCommand(IComposerClient::Command command, uint16_t length) {
-        switch (command) {
-            case IComposerClient::Command::SELECT_DISPLAY:
-                return executeSelectDisplay(length);
-            case IComposerClient::Command::SELECT_LAYER:
-                return executeSelectLayer(length);
-            case IComposerClient::Command::SET_COLOR_TRANSFORM:
-                return executeSetColorTransform(length);
-            case IComposerClient::Command::SET_CLIENT_TARGET:
-                return executeSetClientTarget(length);
-            case IComposerClient::Command::SET_OUTPUT_BUFFER:
-                return executeSetOutputBuffer(length);
-            case IComposerClient::Command::VALIDATE_DISPLAY:
-                return executeValidateDisplay(length);
-            case IComposerClient::Command::PRESENT_OR_VALIDATE_DISPLAY:
-                return executePresentOrValidateDisplay(length);
-            case IComposerClient::Command::ACCEPT_DISPLAY_CHANGES:
-                return executeAcceptDisplayChanges(length);
-            case IComposerClient::Command::PRESENT_DISPLAY:
-                return executePresentDisplay(length);
-            case IComposerClient::Command::SET_LAYER_CURSOR_POSITION:
-                return executeSetLayerCursorPosition(length);
-            case IComposerClient::Command::SET_LAYER_BUFFER:
-                return executeSetLayerBuffer(length);
-            case IComposerClient::Command::SET_LAYER_SURFACE_DAMAGE:
-                return executeSetLayerSurfaceDamage(length);
-            case IComposerClient::Command::SET_LAYER_BLEND_MODE:
-                return executeSetLayerBlendMode(length);
-            case IComposerClient::Command::SET_LAYER_COLOR:
-                return executeSetLayerColor(length);
-            case IComposerClient::Command::SET_LAYER_COMPOSITION_TYPE:
-                return executeSetLayerCompositionType(length);
-            case IComposerClient::Command::SET_LAYER_DATASPACE:
-                return executeSetLayerDataspace(length);
-            case IComposerClient::Command::SET_LAYER_DISPLAY_FRAME:
-                return executeSetLayerDisplayFrame(length);
-            case IComposerClient::Command::SET_LAYER_PLANE_ALPHA:
-                return executeSetLayerPlaneAlpha(length);
-            case IComposerClient::Command::SET_LAYER_SIDEBAND_STREAM:
-                return executeSetLayerSidebandStream(length);
-            case IComposerClient::Command::SET_LAYER_SOURCE_CROP:
-                return executeSetLayerSourceCrop(length);
-            case IComposerClient::Command::SET_LAYER_TRANSFORM:
-                return executeSetLayerTransform(length);
-            case IComposerClient::Command::SET_LAYER_VISIBLE_REGION:
-                return executeSetLayerVisibleRegion(length);
-            case IComposerClient::Command::SET_LAYER_Z_ORDER:
-                return executeSetLayerZOrder(length);
-            default:
-                return false;
+        uint32_t opcode = static_cast<uint32_t>(command) >>
+                          static_cast<uint32_t>(IComposerClient::Command::OPCODE_SHIFT);
+        if (opcode >= kCommandDispatchTableSize) {
+            return false;
         }
+        CommandHandler handler = getCommandDispatchTable()[opcode];
+        return handler != nullptr && (this->*handler)(length);
     }
 
     virtual std::unique_ptr<CommandWriterBase> createCommandWriter(size_t writerInitialSize) {
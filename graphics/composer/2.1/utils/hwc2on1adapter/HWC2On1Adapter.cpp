@@ -329,7 +329,10 @@ Error HWC2On1Adapter::createVirtualDisplay(uint32_t width,
     const auto displayId = mHwc1VirtualDisplay->getId();
     mHwc1DisplayMap[HWC_DISPLAY_VIRTUAL] = displayId;
     mHwc1VirtualDisplay->setHwc1Id(HWC_DISPLAY_VIRTUAL);
-    mDisplays.emplace(displayId, mHwc1VirtualDisplay);
+    {
+        std::unique_lock<std::mutex> displaysLock(mDisplaysMutex);
+        mDisplays.emplace(displayId, mHwc1VirtualDisplay);
+    }
     *outDisplay = displayId;
 
     return Error::None;
@@ -344,7 +347,10 @@ Error HWC2On1Adapter::destroyVirtualDisplay(hwc2_display_t displayId) {
 
     mHwc1VirtualDisplay.reset();
     mHwc1DisplayMap.erase(HWC_DISPLAY_VIRTUAL);
-    mDisplays.erase(displayId);
+    {
+        std::unique_lock<std::mutex> displaysLock(mDisplaysMutex);
+        mDisplays.erase(displayId);
+    }
 
     return Error::None;
 }
@@ -379,9 +385,12 @@ void HWC2On1Adapter::dump(uint32_t* outSize, char* outBuffer) {
     }
 
     output << "Displays:\n";
-    for (const auto& element : mDisplays) {
-        const auto& display = element.second;
-        output << display->dump();
+    {
+        std::unique_lock<std::mutex> displaysLock(mDisplaysMutex);
+        for (const auto& element : mDisplays) {
+            const auto& display = element.second;
+            output << display->dump();
+        }
     }
     output << '\n';
 
@@ -1307,7 +1316,7 @@ Error HWC2On1Adapter::Display::set(hwc_display_contents_1& hwcContents) {
 
 void HWC2On1Adapter::Display::addRetireFence(int fenceFd) {
     std::unique_lock<std::recursive_mutex> lock(mStateMutex);
-    mRetireFence.add(fenceFd);
+    mDevice.deferFenceClose(mRetireFence.add(fenceFd));
 }
 
 void HWC2On1Adapter::Display::addReleaseFences(
@@ -2038,7 +2047,7 @@ Error HWC2On1Adapter::Layer::setZ(uint32_t z) {
 
 void HWC2On1Adapter::Layer::addReleaseFence(int fenceFd) {
     ALOGV("addReleaseFence %d to layer %" PRIu64, fenceFd, mId);
-    mReleaseFence.add(fenceFd);
+    mDisplay.getDevice().deferFenceClose(mReleaseFence.add(fenceFd));
 }
 
 const sp<MiniFence>& HWC2On1Adapter::Layer::getReleaseFence() const {
@@ -2272,7 +2281,7 @@ void HWC2On1Adapter::populateCapabilities() {
 }
 
 HWC2On1Adapter::Display* HWC2On1Adapter::getDisplay(hwc2_display_t id) {
-    std::unique_lock<std::recursive_timed_mutex> lock(mStateMutex);
+    std::unique_lock<std::mutex> lock(mDisplaysMutex);
 
     auto display = mDisplays.find(id);
     if (display == mDisplays.end()) {
@@ -2308,6 +2317,7 @@ void HWC2On1Adapter::populatePrimary() {
     mHwc1DisplayMap[HWC_DISPLAY_PRIMARY] = display->getId();
     display->setHwc1Id(HWC_DISPLAY_PRIMARY);
     display->populateConfigs();
+    std::unique_lock<std::mutex> displaysLock(mDisplaysMutex);
     mDisplays.emplace(display->getId(), std::move(display));
 }
 
@@ -2523,9 +2533,32 @@ Error HWC2On1Adapter::setAllDisplays() {
         display->addReleaseFences(*mHwc1Contents[hwc1Id]);
     }
 
+    // Close the fences that just aged out of the deferred queues with the
+    // state lock dropped, so the close syscalls do not extend the critical
+    // section other displays may be waiting on.
+    lock.unlock();
+    closeRetiredFences();
+
     return Error::None;
 }
 
+void HWC2On1Adapter::deferFenceClose(sp<MiniFence> fence) {
+    if (fence == nullptr || fence == MiniFence::NO_FENCE) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mRetiredFencesMutex);
+    mRetiredFences.emplace_back(std::move(fence));
+}
+
+void HWC2On1Adapter::closeRetiredFences() {
+    std::vector<sp<MiniFence>> retired;
+    {
+        std::unique_lock<std::mutex> lock(mRetiredFencesMutex);
+        retired.swap(mRetiredFences);
+    }
+    // Dropping the last references here closes the fence fds.
+}
+
 void HWC2On1Adapter::hwc1Invalidate() {
     ALOGV("Received hwc1Invalidate");
 
@@ -2604,7 +2637,10 @@ void HWC2On1Adapter::hwc1Hotplug(int hwc1DisplayId, int connected) {
         display->populateConfigs();
         displayId = display->getId();
         mHwc1DisplayMap[HWC_DISPLAY_EXTERNAL] = displayId;
-        mDisplays.emplace(displayId, std::move(display));
+        {
+            std::unique_lock<std::mutex> displaysLock(mDisplaysMutex);
+            mDisplays.emplace(displayId, std::move(display));
+        }
     } else {
         if (connected != 0) {
             ALOGW("hwc1Hotplug: Received connect for previously connected "
@@ -2615,7 +2651,10 @@ void HWC2On1Adapter::hwc1Hotplug(int hwc1DisplayId, int connected) {
         // Disconnect an existing display
         displayId = mHwc1DisplayMap[hwc1DisplayId];
         mHwc1DisplayMap.erase(HWC_DISPLAY_EXTERNAL);
-        mDisplays.erase(displayId);
+        {
+            std::unique_lock<std::mutex> displaysLock(mDisplaysMutex);
+            mDisplays.erase(displayId);
+        }
     }
 
     // If the HWC2-side callback hasn't been registered yet, buffer this until
@@ -157,9 +157,13 @@ private:
             DeferredFence()
               : mFences({MiniFence::NO_FENCE, MiniFence::NO_FENCE}) {}
 
-            void add(int32_t fenceFd) {
+            // Returns the fence that aged out of the queue so the caller can
+            // defer closing it until the adapter locks are no longer held.
+            sp<MiniFence> add(int32_t fenceFd) {
                 mFences.emplace(new MiniFence(fenceFd));
+                sp<MiniFence> retired = std::move(mFences.front());
                 mFences.pop();
+                return retired;
             }
 
             const sp<MiniFence>& get() const {
@@ -679,6 +683,11 @@ private:
     std::vector<struct hwc_display_contents_1*> mHwc1Contents;
     HWC2::Error setAllDisplays();
 
+    // Queues a fence that aged out of a deferred fence queue so its close
+    // happens in closeRetiredFences() rather than under the state locks.
+    void deferFenceClose(sp<MiniFence> fence);
+    void closeRetiredFences();
+
     // Callbacks
     void hwc1Invalidate();
     void hwc1Vsync(int hwc1DisplayId, int64_t timestamp);
@@ -725,9 +734,21 @@ private:
     std::vector<std::pair<int, int64_t>> mPendingVsyncs;
     std::vector<std::pair<int, int>> mPendingHotplugs;
 
-    // Mapping between HWC1 display id and Display objects.
+    // Mapping between HWC1 display id and Display objects. Guarded by
+    // mDisplaysMutex rather than mStateMutex so per-display entry points can
+    // resolve their Display object while another display holds mStateMutex
+    // across a whole HWC1 prepare or set call; the per-display state itself is
+    // protected by each Display's own mutex. When both locks are needed,
+    // mStateMutex is acquired first.
+    mutable std::mutex mDisplaysMutex;
     std::map<hwc2_display_t, std::shared_ptr<Display>> mDisplays;
 
+    // Fences that aged out of the deferred fence queues during set. They are
+    // drained by closeRetiredFences() once the state lock has been dropped so
+    // the close syscalls do not lengthen the critical section.
+    std::mutex mRetiredFencesMutex;
+    std::vector<sp<MiniFence>> mRetiredFences;
+
     // Map HWC1 display type (HWC_DISPLAY_PRIMARY, HWC_DISPLAY_EXTERNAL,
     // HWC_DISPLAY_VIRTUAL) to Display IDs generated by HWC2on1Adapter objects.
     std::unordered_map<int, hwc2_display_t> mHwc1DisplayMap;
@@ -18,6 +18,8 @@
 
 #include "composer-resources/2.1/ComposerResources.h"
 
+#include <atomic>
+
 namespace android {
 namespace hardware {
 namespace graphics {
@@ -297,6 +299,7 @@ bool ComposerResources::init() {
 
 void ComposerResources::clear(RemoveDisplay removeDisplay) {
     std::lock_guard<std::mutex> lock(mDisplayResourcesMutex);
+    bumpResourceGenerationLocked();
     for (const auto& displayKey : mDisplayResources) {
         Display display = displayKey.first;
         const ComposerDisplayResource& displayResource = *displayKey.second;
@@ -328,6 +331,7 @@ Error ComposerResources::addVirtualDisplay(Display display, uint32_t outputBuffe
 
 Error ComposerResources::removeDisplay(Display display) {
     std::lock_guard<std::mutex> lock(mDisplayResourcesMutex);
+    bumpResourceGenerationLocked();
     return mDisplayResources.erase(display) > 0 ? Error::NONE : Error::BAD_DISPLAY;
 }
 
@@ -378,6 +382,7 @@ Error ComposerResources::addLayer(Display display, Layer layer, uint32_t bufferC
 
 Error ComposerResources::removeLayer(Display display, Layer layer) {
     std::lock_guard<std::mutex> lock(mDisplayResourcesMutex);
+    bumpResourceGenerationLocked();
     ComposerDisplayResource* displayResource = findDisplayResourceLocked(display);
     if (!displayResource) {
         return Error::BAD_DISPLAY;
@@ -459,6 +464,33 @@ Error ComposerResources::getHandle(Display display, Layer layer, uint32_t slot,
                                    ReplacedHandle* outReplacedHandle) {
     Error error;
 
+    // Fast path: a layer re-presenting a cached buffer slot. When the memo for the layer still
+    // carries the current generation the cached handle cannot have been freed or replaced, so
+    // the lookup skips mDisplayResourcesMutex entirely.
+    if (cache == Cache::LAYER_BUFFER && fromCache) {
+        LayerLookupMemo& memo = layerLookupMemoFor(display, layer);
+        // Seqlock read: an odd sequence means a rewrite is in flight, and a sequence that
+        // changed across the field reads means the snapshot may be torn or belong to another
+        // (display, layer) that hashed to the same entry. Either way fall through to the
+        // locked path. The fence orders the field reads before the sequence re-load.
+        uint64_t sequence = memo.sequence.load(std::memory_order_acquire);
+        if ((sequence & 1) == 0) {
+            uint64_t memoGeneration = memo.generation;
+            Display memoDisplay = memo.display;
+            Layer memoLayer = memo.layer;
+            uint32_t memoSlot = memo.slot;
+            const native_handle_t* handle = memo.handle;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (memo.sequence.load(std::memory_order_relaxed) == sequence &&
+                memoDisplay == display && memoLayer == layer && memoSlot == slot &&
+                memoGeneration == mResourceGeneration.load(std::memory_order_acquire)) {
+                *outHandle = handle;
+                outReplacedHandle->reset(&mImporter, nullptr);
+                return Error::NONE;
+            }
+        }
+    }
+
     // import the raw handle (or ignore raw handle when fromCache is true)
     const native_handle_t* importedHandle = nullptr;
     if (!fromCache) {
@@ -526,6 +558,22 @@ Error ComposerResources::getHandle(Display display, Layer layer, uint32_t slot,
         return error;
     }
 
+    if (cache == Cache::LAYER_BUFFER) {
+        // Seqlock write, serialized by mDisplayResourcesMutex: make the sequence odd before
+        // touching the fields and land on the next even value after, so any overlapping
+        // lock-free reader sees the sequence change and retries through the locked path.
+        LayerLookupMemo& memo = layerLookupMemoFor(display, layer);
+        uint64_t sequence = memo.sequence.load(std::memory_order_relaxed);
+        memo.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        memo.generation = mResourceGeneration.load(std::memory_order_relaxed);
+        memo.display = display;
+        memo.layer = layer;
+        memo.slot = slot;
+        memo.handle = *outHandle;
+        memo.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
     outReplacedHandle->reset(&mImporter, replacedHandle);
 
     return Error::NONE;
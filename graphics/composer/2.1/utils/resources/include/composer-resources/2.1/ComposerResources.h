@@ -20,6 +20,8 @@
 #warning "ComposerResources.h included without LOG_TAG"
 #endif
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -253,6 +255,41 @@ class ComposerResources {
         LAYER_SIDEBAND_STREAM,
     };
 
+    /**
+     * Memo of the last layer buffer handle resolved for a layer. A layer re-presenting the same
+     * cache slot reads the handle from here without taking mDisplayResourcesMutex, as long as
+     * the stamped generation still matches mResourceGeneration. Each entry is a seqlock:
+     * writers (always under the mutex) make the sequence odd before touching the other fields
+     * and bump it to the next even value afterwards, so every rewrite changes the sequence. A
+     * reader that sees an odd sequence, or a sequence that changed across its field reads,
+     * falls back to the locked path.
+     */
+    struct LayerLookupMemo {
+        std::atomic<uint64_t> sequence{0};
+        uint64_t generation = 0;
+        Display display = 0;
+        Layer layer = 0;
+        uint32_t slot = 0;
+        const native_handle_t* handle = nullptr;
+    };
+
+    static constexpr size_t kNumLayerLookupMemos = 64;
+
+    //! Bumped (under the mutex) whenever cached handles may have been freed, invalidating all
+    //! memo entries at once.
+    std::atomic<uint64_t> mResourceGeneration{1};
+
+    //! Direct-mapped by layer; a hash collision only costs a trip through the locked path.
+    std::array<LayerLookupMemo, kNumLayerLookupMemos> mLayerLookupMemos;
+
+    LayerLookupMemo& layerLookupMemoFor(Display display, Layer layer) {
+        return mLayerLookupMemos[(display * 31 + layer) % kNumLayerLookupMemos];
+    }
+
+    void bumpResourceGenerationLocked() {
+        mResourceGeneration.fetch_add(1, std::memory_order_release);
+    }
+
     Error getHandle(Display display, Layer layer, uint32_t slot, Cache cache, bool fromCache,
                     const native_handle_t* rawHandle, const native_handle_t** outHandle,
                     ReplacedHandle* outReplacedHandle);
@@ -0,0 +1,300 @@
+/**
+ * Copyright (c) 2023, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <aidl/Vintf.h>
+#include <android-base/properties.h>
+#include <android/binder_process.h>
+#include <android/hardware/graphics/composer3/ComposerClientReader.h>
+#include <android/hardware/graphics/composer3/ComposerClientWriter.h>
+#include <benchmark/benchmark.h>
+#include <binder/ProcessState.h>
+#include <ui/GraphicBuffer.h>
+#include <ui/PixelFormat.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "VtsComposerClient.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VtsHalGraphicsComposer3_Benchmark"
+
+namespace aidl::android::hardware::graphics::composer3::vts {
+namespace {
+
+using namespace std::chrono_literals;
+
+using ::android::GraphicBuffer;
+using ::android::sp;
+
+constexpr uint32_t kBufferSlotCount = 64;
+// Pace the present loop at 120Hz regardless of the panel's refresh rate so results are
+// comparable across devices: what is measured is how much of the cycle the composer spends
+// in validate/present, not the panel timing.
+constexpr auto kFramePeriod = std::chrono::nanoseconds(8'333'333);
+
+int64_t percentileUs(std::vector<int64_t>& samplesNs, double percentile) {
+    if (samplesNs.empty()) {
+        return 0;
+    }
+    const size_t index = std::min(samplesNs.size() - 1,
+                                  static_cast<size_t>(percentile * samplesNs.size()));
+    std::nth_element(samplesNs.begin(), samplesNs.begin() + index, samplesNs.end());
+    return samplesNs[index] / 1000;
+}
+
+/**
+ * Drives a synthetic multi-layer present loop against one composer instance: full-screen
+ * DEVICE layers with per-frame buffer and damage updates, validate/accept/present every
+ * cycle. The loop owns a writer/reader pair like SurfaceFlinger does and drains present
+ * fences each frame so the benchmark does not accumulate fds.
+ */
+class ComposerPresentLoop {
+  public:
+    ComposerPresentLoop(const std::string& instance, size_t layerCount)
+        : mInstance(instance), mLayerCount(layerCount) {}
+
+    ~ComposerPresentLoop() {
+        if (mClient == nullptr) {
+            return;
+        }
+        for (const int64_t layer : mLayers) {
+            mClient->destroyLayer(mDisplay.getDisplayId(), layer);
+        }
+        mClient->tearDown();
+    }
+
+    bool setUp(std::string* outSkipReason) {
+        mClient = std::make_unique<VtsComposerClient>(mInstance);
+        if (!mClient->createClient().isOk()) {
+            *outSkipReason = "failed to create composer client";
+            return false;
+        }
+
+        const auto& [status, displays] = mClient->getDisplays();
+        if (!status.isOk() || displays.empty()) {
+            *outSkipReason = "no displays";
+            return false;
+        }
+        mDisplay = displays[0];
+
+        if (!mClient->setPowerMode(mDisplay.getDisplayId(), PowerMode::ON).isOk()) {
+            *outSkipReason = "failed to power on display";
+            return false;
+        }
+        mClient->setVsync(mDisplay.getDisplayId(), false);
+        mClient->setVsyncAllowed(false);
+
+        mWriter = std::make_unique<ComposerClientWriter>(mDisplay.getDisplayId());
+
+        for (size_t i = 0; i < 2; i++) {
+            mBuffers[i] = sp<GraphicBuffer>::make(
+                    static_cast<uint32_t>(mDisplay.getDisplayWidth()),
+                    static_cast<uint32_t>(mDisplay.getDisplayHeight()),
+                    ::android::PIXEL_FORMAT_RGBA_8888, /*layerCount*/ 1U,
+                    static_cast<uint64_t>(common::BufferUsage::CPU_WRITE_OFTEN) |
+                            static_cast<uint64_t>(common::BufferUsage::CPU_READ_OFTEN) |
+                            static_cast<uint64_t>(common::BufferUsage::COMPOSER_OVERLAY),
+                    LOG_TAG);
+            if (mBuffers[i]->initCheck() != ::android::OK || mBuffers[i]->handle == nullptr) {
+                *outSkipReason = "failed to allocate layer buffers";
+                return false;
+            }
+        }
+
+        for (size_t i = 0; i < mLayerCount; i++) {
+            const auto& [layerStatus, layer] =
+                    mClient->createLayer(mDisplay.getDisplayId(), kBufferSlotCount);
+            if (!layerStatus.isOk()) {
+                *outSkipReason = "failed to create layers";
+                return false;
+            }
+            mLayers.push_back(layer);
+            configureLayer(layer, static_cast<uint32_t>(i));
+        }
+        if (!execute()) {
+            *outSkipReason = "failed to configure layers";
+            return false;
+        }
+        return true;
+    }
+
+    // Runs one validate/accept/present cycle and reports the time spent in each phase,
+    // including the executeCommands round trip to the service.
+    bool presentFrame(int64_t* outValidateNs, int64_t* outPresentNs) {
+        const int64_t displayId = mDisplay.getDisplayId();
+        for (size_t i = 0; i < mLayers.size(); i++) {
+            mWriter->setLayerBuffer(displayId, mLayers[i], /*slot*/ mFrameIndex % 2,
+                                    mBuffers[mFrameIndex % 2]->handle, /*acquireFence*/ -1);
+            mWriter->setLayerSurfaceDamage(displayId, mLayers[i],
+                                           std::vector<Rect>(1, {0, 0, 10, 10}));
+        }
+
+        const auto validateStart = std::chrono::steady_clock::now();
+        mWriter->validateDisplay(displayId, ComposerClientWriter::kNoTimestamp);
+        if (!execute()) {
+            return false;
+        }
+        *outValidateNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now() - validateStart)
+                                 .count();
+
+        if (!mReader.takeChangedCompositionTypes(displayId).empty()) {
+            mWriter->acceptDisplayChanges(displayId);
+        }
+
+        const auto presentStart = std::chrono::steady_clock::now();
+        mWriter->presentDisplay(displayId);
+        if (!execute()) {
+            return false;
+        }
+        *outPresentNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - presentStart)
+                                .count();
+
+        // Drop the present fence; layer buffers are never rewritten by the CPU, so there is
+        // no need to wait for it.
+        mReader.takePresentFence(displayId);
+        mFrameIndex++;
+        return true;
+    }
+
+  private:
+    void configureLayer(int64_t layer, uint32_t zOrder) {
+        const int64_t displayId = mDisplay.getDisplayId();
+        const Rect displayFrame = mDisplay.getFrameRect();
+        mWriter->setLayerCompositionType(displayId, layer, Composition::DEVICE);
+        mWriter->setLayerDisplayFrame(displayId, layer, displayFrame);
+        mWriter->setLayerPlaneAlpha(displayId, layer, /*alpha*/ 1);
+        mWriter->setLayerSourceCrop(displayId, layer, mDisplay.getCrop());
+        mWriter->setLayerTransform(displayId, layer, static_cast<common::Transform>(0));
+        mWriter->setLayerVisibleRegion(displayId, layer, std::vector<Rect>(1, displayFrame));
+        mWriter->setLayerZOrder(displayId, layer, zOrder);
+        mWriter->setLayerBlendMode(displayId, layer, common::BlendMode::NONE);
+        mWriter->setLayerDataspace(displayId, layer, common::Dataspace::UNKNOWN);
+    }
+
+    bool execute() {
+        auto commands = mWriter->takePendingCommands();
+        if (commands.empty()) {
+            return true;
+        }
+        auto [status, results] = mClient->executeCommands(commands);
+        if (!status.isOk()) {
+            return false;
+        }
+        mReader.parse(std::move(results));
+        return mReader.takeErrors().empty();
+    }
+
+    const std::string mInstance;
+    const size_t mLayerCount;
+    std::unique_ptr<VtsComposerClient> mClient;
+    VtsDisplay mDisplay{-1};
+    std::unique_ptr<ComposerClientWriter> mWriter;
+    ComposerClientReader mReader;
+    std::vector<int64_t> mLayers;
+    sp<GraphicBuffer> mBuffers[2];
+    uint32_t mFrameIndex = 0;
+};
+
+/**
+ * Present loop paced at 120Hz. Manual time is the full validate-to-present span of each
+ * cycle; per-phase percentiles and the number of cycles that blew the 8.33ms frame budget
+ * are reported as counters so a regression gate can key on the tail, not the average.
+ */
+void BM_ValidatePresentCycle(benchmark::State& state, const std::string& instance) {
+    const size_t layerCount = static_cast<size_t>(state.range(0));
+    ComposerPresentLoop loop(instance, layerCount);
+
+    std::string skipReason;
+    if (!loop.setUp(&skipReason)) {
+        state.SkipWithError(skipReason.c_str());
+        return;
+    }
+
+    std::vector<int64_t> validateNs;
+    std::vector<int64_t> presentNs;
+    int64_t missedFrames = 0;
+
+    auto nextFrameTime = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        nextFrameTime += kFramePeriod;
+        std::this_thread::sleep_until(nextFrameTime);
+
+        int64_t validate = 0;
+        int64_t present = 0;
+        if (!loop.presentFrame(&validate, &present)) {
+            state.SkipWithError("present cycle failed");
+            return;
+        }
+        validateNs.push_back(validate);
+        presentNs.push_back(present);
+        if (validate + present > kFramePeriod.count()) {
+            missedFrames++;
+            // Do not let one missed frame turn every following cycle into a back-to-back
+            // present: realign the pacing to now.
+            nextFrameTime = std::chrono::steady_clock::now();
+        }
+        state.SetIterationTime(static_cast<double>(validate + present) / 1e9);
+    }
+
+    state.counters["validate_p50_us"] = static_cast<double>(percentileUs(validateNs, 0.50));
+    state.counters["validate_p90_us"] = static_cast<double>(percentileUs(validateNs, 0.90));
+    state.counters["validate_p99_us"] = static_cast<double>(percentileUs(validateNs, 0.99));
+    state.counters["present_p50_us"] = static_cast<double>(percentileUs(presentNs, 0.50));
+    state.counters["present_p90_us"] = static_cast<double>(percentileUs(presentNs, 0.90));
+    state.counters["present_p99_us"] = static_cast<double>(percentileUs(presentNs, 0.99));
+    state.counters["missed_frames"] = static_cast<double>(missedFrames);
+}
+
+}  // namespace
+}  // namespace aidl::android::hardware::graphics::composer3::vts
+
+int main(int argc, char** argv) {
+    using aidl::android::hardware::graphics::composer3::IComposer;
+    using aidl::android::hardware::graphics::composer3::vts::BM_ValidatePresentCycle;
+
+    benchmark::Initialize(&argc, argv);
+
+    using namespace std::chrono_literals;
+    if (!android::base::WaitForProperty("init.svc.surfaceflinger", "stopped", 10s)) {
+        ALOGE("Failed to stop init.svc.surfaceflinger");
+        return -1;
+    }
+
+    android::ProcessState::self()->setThreadPoolMaxThreadCount(4);
+    android::ProcessState::self()->startThreadPool();
+
+    for (const std::string& instance :
+         android::getAidlHalInstanceNames(IComposer::descriptor)) {
+        for (const int64_t layerCount : {1, 2, 4, 8}) {
+            benchmark::RegisterBenchmark(
+                    ("BM_ValidatePresentCycle/" + instance + "/layers:" +
+                     std::to_string(layerCount))
+                            .c_str(),
+                    BM_ValidatePresentCycle, instance)
+                    ->Arg(layerCount)
+                    ->UseManualTime();
+        }
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
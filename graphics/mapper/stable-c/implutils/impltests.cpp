@@ -16,11 +16,16 @@
 
 #include <gtest/gtest.h>
 
+#include <android/hardware/graphics/mapper/utils/IMapperLockPipeline.h>
 #include <android/hardware/graphics/mapper/utils/IMapperMetadataTypes.h>
 #include <android/hardware/graphics/mapper/utils/IMapperProvider.h>
 #include <drm/drm_fourcc.h>
 #include <gralloctypes/Gralloc4.h>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <span>
+#include <utility>
 #include <vector>
 
 using namespace ::android;
@@ -343,6 +348,127 @@ TEST(MetadataProvider, outOfBounds) {
             << "100 (out of range) should have resulted in UNSUPPORTED";
 }
 
+struct BulkRecord {
+    int64_t type;
+    int64_t size;
+    const uint8_t* payload;
+};
+
+static std::vector<BulkRecord> parseBulkRecords(const std::vector<uint8_t>& buffer) {
+    constexpr size_t recordHeaderSize = 2 * sizeof(int64_t);
+    std::vector<BulkRecord> records;
+    size_t offset = 0;
+    while (offset + recordHeaderSize <= buffer.size()) {
+        BulkRecord record;
+        memcpy(&record.type, buffer.data() + offset, sizeof(int64_t));
+        memcpy(&record.size, buffer.data() + offset + sizeof(int64_t), sizeof(int64_t));
+        record.payload = buffer.data() + offset + recordHeaderSize;
+        records.push_back(record);
+        offset += recordHeaderSize + std::max<int64_t>(record.size, 0);
+    }
+    return records;
+}
+
+TEST(MetadataProvider, bulkProvide) {
+    using Width = StandardMetadata<StandardMetadataType::WIDTH>::value;
+    using DataspaceValue = StandardMetadata<StandardMetadataType::DATASPACE>::value;
+
+    const uint64_t mask = standardMetadataTypeMask(StandardMetadataType::WIDTH) |
+                          standardMetadataTypeMask(StandardMetadataType::DATASPACE);
+    auto provider = []<StandardMetadataType T>(auto&& provide) -> int32_t {
+        if constexpr (T == StandardMetadataType::WIDTH) {
+            return provide(128);
+        }
+        if constexpr (T == StandardMetadataType::DATASPACE) {
+            return provide(Dataspace::BT2020);
+        }
+        return -AIMAPPER_ERROR_UNSUPPORTED;
+    };
+
+    int32_t desiredSize = provideStandardMetadataBulk(mask, nullptr, 0, nullptr, provider);
+    ASSERT_GT(desiredSize, 0);
+    std::vector<uint8_t> buffer(desiredSize);
+    EXPECT_EQ(desiredSize,
+              provideStandardMetadataBulk(mask, buffer.data(), buffer.size(), nullptr, provider));
+
+    auto records = parseBulkRecords(buffer);
+    ASSERT_EQ(2, records.size());
+    EXPECT_EQ(static_cast<int64_t>(StandardMetadataType::WIDTH), records[0].type);
+    EXPECT_EQ(128, Width::decode(records[0].payload, records[0].size).value_or(0));
+    EXPECT_EQ(static_cast<int64_t>(StandardMetadataType::DATASPACE), records[1].type);
+    auto dataspace = DataspaceValue::decode(records[1].payload, records[1].size);
+    ASSERT_TRUE(dataspace.has_value());
+    EXPECT_EQ(Dataspace::BT2020, *dataspace);
+}
+
+TEST(MetadataProvider, bulkUnsupportedTypeRecordedInline) {
+    using Width = StandardMetadata<StandardMetadataType::WIDTH>::value;
+
+    const uint64_t mask = standardMetadataTypeMask(StandardMetadataType::WIDTH) |
+                          standardMetadataTypeMask(StandardMetadataType::PIXEL_FORMAT_FOURCC);
+    auto provider = []<StandardMetadataType T>(auto&& provide) -> int32_t {
+        if constexpr (T == StandardMetadataType::WIDTH) {
+            return provide(64);
+        }
+        return -AIMAPPER_ERROR_UNSUPPORTED;
+    };
+
+    int32_t desiredSize = provideStandardMetadataBulk(mask, nullptr, 0, nullptr, provider);
+    ASSERT_GT(desiredSize, 0);
+    std::vector<uint8_t> buffer(desiredSize);
+    EXPECT_EQ(desiredSize,
+              provideStandardMetadataBulk(mask, buffer.data(), buffer.size(), nullptr, provider));
+
+    auto records = parseBulkRecords(buffer);
+    ASSERT_EQ(2, records.size());
+    EXPECT_EQ(64, Width::decode(records[0].payload, records[0].size).value_or(0));
+    EXPECT_EQ(static_cast<int64_t>(StandardMetadataType::PIXEL_FORMAT_FOURCC), records[1].type);
+    EXPECT_EQ(-AIMAPPER_ERROR_UNSUPPORTED, records[1].size)
+            << "unsupported type should be recorded inline, not fail the batch";
+}
+
+TEST(MetadataProvider, bulkImmutableFieldsCached) {
+    using Width = StandardMetadata<StandardMetadataType::WIDTH>::value;
+    using DataspaceValue = StandardMetadata<StandardMetadataType::DATASPACE>::value;
+
+    const uint64_t mask = standardMetadataTypeMask(StandardMetadataType::WIDTH) |
+                          standardMetadataTypeMask(StandardMetadataType::DATASPACE);
+    int widthQueries = 0;
+    int dataspaceQueries = 0;
+    auto provider = [&]<StandardMetadataType T>(auto&& provide) -> int32_t {
+        if constexpr (T == StandardMetadataType::WIDTH) {
+            widthQueries++;
+            return provide(256);
+        }
+        if constexpr (T == StandardMetadataType::DATASPACE) {
+            return provide(dataspaceQueries++ == 0 ? Dataspace::SRGB : Dataspace::BT2020);
+        }
+        return -AIMAPPER_ERROR_UNSUPPORTED;
+    };
+
+    StandardMetadataCache cache;
+    int32_t desiredSize = provideStandardMetadataBulk(mask, nullptr, 0, &cache, provider);
+    ASSERT_GT(desiredSize, 0);
+    EXPECT_EQ(1, widthQueries) << "sizing pass cannot fill the cache, nothing was written";
+    std::vector<uint8_t> buffer(desiredSize);
+    EXPECT_EQ(desiredSize,
+              provideStandardMetadataBulk(mask, buffer.data(), buffer.size(), &cache, provider));
+    EXPECT_EQ(2, widthQueries);
+    EXPECT_EQ(2, dataspaceQueries);
+
+    EXPECT_EQ(desiredSize,
+              provideStandardMetadataBulk(mask, buffer.data(), buffer.size(), &cache, provider));
+    EXPECT_EQ(2, widthQueries) << "immutable field should be served from the cache";
+    EXPECT_EQ(3, dataspaceQueries) << "mutable field must be re-queried every batch";
+
+    auto records = parseBulkRecords(buffer);
+    ASSERT_EQ(2, records.size());
+    EXPECT_EQ(256, Width::decode(records[0].payload, records[0].size).value_or(0));
+    auto dataspace = DataspaceValue::decode(records[1].payload, records[1].size);
+    ASSERT_TRUE(dataspace.has_value());
+    EXPECT_EQ(Dataspace::BT2020, *dataspace);
+}
+
 template <StandardMetadataType T>
 std::vector<uint8_t> encode(const typename StandardMetadata<T>::value_type& value) {
     using Value = typename StandardMetadata<T>::value;
@@ -532,3 +658,83 @@ TEST(MetadataGralloc4Interop, Smpte2094_40) {
     ASSERT_EQ(NO_ERROR, gralloc4::encodeSmpte2094_40(hdrdata, &g4buf));
     EXPECT_EQ(g4buf, mpbuf);
 }
+
+TEST(LockPipeline, mapOverlapsFenceWait) {
+    vendor::mapper::FenceAwareLockPipeline pipeline;
+
+    int pipeFds[2];
+    ASSERT_EQ(0, pipe(pipeFds));
+    base::unique_fd readEnd(pipeFds[0]);
+    base::unique_fd writeEnd(pipeFds[1]);
+
+    int fakeMapping = 0;
+    std::atomic<bool> mapRan{false};
+    std::promise<std::pair<AIMapper_Error, void*>> resultPromise;
+    auto resultFuture = resultPromise.get_future();
+
+    pipeline.lockAsync(
+            std::move(readEnd),
+            [&](void** outData) {
+                mapRan = true;
+                *outData = &fakeMapping;
+                return AIMAPPER_ERROR_NONE;
+            },
+            [&](AIMapper_Error error, void* data) {
+                resultPromise.set_value(std::make_pair(error, data));
+            });
+
+    // The mapping work ran inline, but the continuation must not fire until the
+    // "fence" (the pipe's read end) becomes readable.
+    EXPECT_TRUE(mapRan);
+    EXPECT_EQ(std::future_status::timeout, resultFuture.wait_for(std::chrono::milliseconds(50)));
+
+    char signal = 1;
+    ASSERT_EQ(1, write(writeEnd.get(), &signal, 1));
+
+    auto [error, data] = resultFuture.get();
+    EXPECT_EQ(AIMAPPER_ERROR_NONE, error);
+    EXPECT_EQ(&fakeMapping, data);
+}
+
+TEST(LockPipeline, noFenceCompletesInline) {
+    vendor::mapper::FenceAwareLockPipeline pipeline;
+
+    int fakeMapping = 0;
+    AIMapper_Error reportedError = AIMAPPER_ERROR_NO_RESOURCES;
+    void* reportedData = nullptr;
+
+    pipeline.lockAsync(
+            base::unique_fd{},
+            [&](void** outData) {
+                *outData = &fakeMapping;
+                return AIMAPPER_ERROR_NONE;
+            },
+            [&](AIMapper_Error error, void* data) {
+                reportedError = error;
+                reportedData = data;
+            });
+
+    // Without a fence the continuation runs before lockAsync() returns.
+    EXPECT_EQ(AIMAPPER_ERROR_NONE, reportedError);
+    EXPECT_EQ(&fakeMapping, reportedData);
+}
+
+TEST(LockPipeline, mapErrorReportedAfterFence) {
+    vendor::mapper::FenceAwareLockPipeline pipeline;
+
+    int pipeFds[2];
+    ASSERT_EQ(0, pipe(pipeFds));
+    base::unique_fd readEnd(pipeFds[0]);
+    base::unique_fd writeEnd(pipeFds[1]);
+
+    std::promise<AIMapper_Error> resultPromise;
+    auto resultFuture = resultPromise.get_future();
+
+    pipeline.lockAsync(
+            std::move(readEnd), [&](void**) { return AIMAPPER_ERROR_BAD_BUFFER; },
+            [&](AIMapper_Error error, void*) { resultPromise.set_value(error); });
+
+    char signal = 1;
+    ASSERT_EQ(1, write(writeEnd.get(), &signal, 1));
+    EXPECT_EQ(AIMAPPER_ERROR_BAD_BUFFER, resultFuture.get());
+}
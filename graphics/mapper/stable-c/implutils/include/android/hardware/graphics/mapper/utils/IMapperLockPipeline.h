@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <android-base/unique_fd.h>
+#include <android/hardware/graphics/mapper/IMapper.h>
+#include <log/log.h>
+
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * Helper for implementing lock() without serializing the mapping work behind the
+ * acquire fence.
+ */
+
+namespace vendor::mapper {
+
+/**
+ * Overlaps buffer mapping work with an acquire-fence wait.
+ *
+ * AIMapper's lock() contract is synchronous, but nothing about the mapping work itself
+ * depends on the fence having signaled: the pages can be mapped while the producer is
+ * still writing, as long as the CPU does not read them before the fence fires. This
+ * pipeline runs the caller-supplied mapping work immediately on the calling thread while
+ * an epoll-based completion thread waits for the acquire fence, and invokes the
+ * continuation once both have finished. For codec consumers that map on every frame,
+ * this hides the mapping cost behind GPU completion instead of adding to it.
+ *
+ * The continuation runs on the completion thread when the fence signals last, and on the
+ * calling thread when the fence had already signaled (or was not provided) by the time
+ * the mapping work finished. The pipeline must not be destroyed while a lockAsync() call
+ * is still executing; fence waits that are still outstanding at destruction are drained
+ * synchronously so continuations are never dropped.
+ */
+class FenceAwareLockPipeline {
+  public:
+    using MapWork = std::function<AIMapper_Error(void* _Nullable* _Nonnull outData)>;
+    using Continuation = std::function<void(AIMapper_Error, void* _Nullable data)>;
+
+    FenceAwareLockPipeline() {
+        mEpollFd.reset(epoll_create1(EPOLL_CLOEXEC));
+        mWakeFd.reset(eventfd(0, EFD_CLOEXEC));
+        LOG_ALWAYS_FATAL_IF(!mEpollFd.ok() || !mWakeFd.ok(),
+                            "failed to create lock pipeline fds: %s", strerror(errno));
+        epoll_event wakeEvent{.events = EPOLLIN, .data = {.ptr = nullptr}};
+        epoll_ctl(mEpollFd.get(), EPOLL_CTL_ADD, mWakeFd.get(), &wakeEvent);
+        mThread = std::thread([this] { completionLoop(); });
+    }
+
+    ~FenceAwareLockPipeline() {
+        mStop = true;
+        uint64_t wake = 1;
+        TEMP_FAILURE_RETRY(write(mWakeFd.get(), &wake, sizeof(wake)));
+        mThread.join();
+
+        // Anything left in flight is a finished mapping whose fence has not signaled yet;
+        // wait for it inline so its continuation is never dropped.
+        std::unordered_map<LockRequest*, std::unique_ptr<LockRequest>> inFlight;
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            inFlight.swap(mInFlight);
+        }
+        for (auto& [_, request] : inFlight) {
+            pollfd pfd{.fd = request->fence.get(), .events = POLLIN, .revents = 0};
+            TEMP_FAILURE_RETRY(poll(&pfd, 1, -1));
+            request->continuation(request->mapError, request->data);
+        }
+    }
+
+    FenceAwareLockPipeline(const FenceAwareLockPipeline&) = delete;
+    FenceAwareLockPipeline& operator=(const FenceAwareLockPipeline&) = delete;
+
+    /**
+     * Runs 'mapWork' on the calling thread, concurrently with a wait on 'acquireFence',
+     * and invokes 'continuation' with the result of the mapping work once both are done.
+     * Takes ownership of the fence; an invalid fd means the acquire has already completed
+     * and the continuation is invoked before lockAsync() returns.
+     */
+    void lockAsync(::android::base::unique_fd acquireFence, const MapWork& mapWork,
+                   Continuation continuation) {
+        auto request = std::make_unique<LockRequest>();
+        request->continuation = std::move(continuation);
+        LockRequest* rawRequest = request.get();
+
+        bool waitInline = false;
+        if (acquireFence.ok()) {
+            request->fence = std::move(acquireFence);
+            request->pendingParts = 2;
+            std::lock_guard<std::mutex> lock(mLock);
+            epoll_event event{.events = EPOLLIN, .data = {.ptr = rawRequest}};
+            if (epoll_ctl(mEpollFd.get(), EPOLL_CTL_ADD, request->fence.get(), &event) == 0) {
+                mInFlight[rawRequest] = std::move(request);
+            } else {
+                // Registration failed (e.g. the fd does not support epoll); fall back to
+                // waiting on the calling thread after the mapping work.
+                ALOGW("failed to register acquire fence with epoll: %s", strerror(errno));
+                rawRequest->pendingParts = 1;
+                waitInline = true;
+            }
+        } else {
+            request->pendingParts = 1;
+        }
+
+        // The mapping work proceeds while the fence is still pending.
+        rawRequest->mapError = mapWork(&rawRequest->data);
+
+        if (waitInline) {
+            pollfd pfd{.fd = rawRequest->fence.get(), .events = POLLIN, .revents = 0};
+            TEMP_FAILURE_RETRY(poll(&pfd, 1, -1));
+        }
+        completePart(rawRequest);
+        // 'request' may still be owned by mInFlight here; if so the completion thread
+        // finishes it once the fence signals.
+    }
+
+  private:
+    struct LockRequest {
+        ::android::base::unique_fd fence;
+        Continuation continuation;
+        AIMapper_Error mapError = AIMAPPER_ERROR_NONE;
+        void* _Nullable data = nullptr;
+        std::atomic<int> pendingParts{0};
+    };
+
+    void completionLoop() {
+        epoll_event events[16];
+        while (true) {
+            int eventCount = epoll_wait(mEpollFd.get(), events, 16, -1);
+            if (eventCount < 0) {
+                if (errno == EINTR) continue;
+                ALOGE("lock pipeline epoll_wait failed: %s", strerror(errno));
+                return;
+            }
+            for (int i = 0; i < eventCount; i++) {
+                auto* request = static_cast<LockRequest*>(events[i].data.ptr);
+                if (request == nullptr) {
+                    if (mStop) {
+                        return;
+                    }
+                    uint64_t wake;
+                    TEMP_FAILURE_RETRY(read(mWakeFd.get(), &wake, sizeof(wake)));
+                    continue;
+                }
+                // An error on the fence fd is treated as signaled; the continuation still
+                // receives the mapping result, matching the sync wait-then-map behavior.
+                epoll_ctl(mEpollFd.get(), EPOLL_CTL_DEL, request->fence.get(), nullptr);
+                completePart(request);
+            }
+        }
+    }
+
+    // Called once by each of the two halves (mapping work, fence wait); whichever finishes
+    // last invokes the continuation.
+    void completePart(LockRequest* _Nonnull request) {
+        if (request->pendingParts.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        std::unique_ptr<LockRequest> owned;
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            auto it = mInFlight.find(request);
+            if (it != mInFlight.end()) {
+                owned = std::move(it->second);
+                mInFlight.erase(it);
+            }
+        }
+        request->continuation(request->mapError, request->data);
+    }
+
+    ::android::base::unique_fd mEpollFd;
+    ::android::base::unique_fd mWakeFd;
+    std::atomic<bool> mStop{false};
+    std::mutex mLock;
+    // Requests whose fence is registered with the epoll instance, keyed by themselves so
+    // the completion thread can look up ownership from the epoll event pointer.
+    std::unordered_map<LockRequest*, std::unique_ptr<LockRequest>> mInFlight;
+    std::thread mThread;
+};
+
+}  // namespace vendor::mapper
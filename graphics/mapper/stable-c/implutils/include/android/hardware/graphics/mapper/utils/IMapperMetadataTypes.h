@@ -623,6 +623,152 @@ AIMapper_Error applyStandardMetadata(StandardMetadataType type, const void* _Non
     return retVal;
 }
 
+constexpr uint64_t standardMetadataTypeMask(StandardMetadataType type) {
+    return UINT64_C(1) << static_cast<uint64_t>(type);
+}
+
+constexpr bool isStandardMetadataImmutable(StandardMetadataType type) {
+    switch (type) {
+        case StandardMetadataType::DATASPACE:
+        case StandardMetadataType::BLEND_MODE:
+        case StandardMetadataType::CROP:
+        case StandardMetadataType::SMPTE2086:
+        case StandardMetadataType::CTA861_3:
+        case StandardMetadataType::SMPTE2094_10:
+        case StandardMetadataType::SMPTE2094_40:
+            return false;
+        default:
+            return true;
+    }
+}
+
+/**
+ * Per-buffer cache of encoded immutable standard metadata. Implementations keep one of
+ * these alongside each imported buffer and pass it to provideStandardMetadataBulk so that
+ * repeat lookups of fields that cannot change after allocation reuse the cached encoding
+ * instead of re-deriving the value from the handle. Not internally synchronized; callers
+ * must serialize access the same way they serialize metadata getters on the buffer.
+ */
+class StandardMetadataCache {
+  private:
+    static constexpr size_t kNumTypes = ndk::internal::enum_values<StandardMetadataType>.size();
+
+    uint64_t mValidMask = 0;
+    std::array<std::vector<uint8_t>, kNumTypes> mEncoded;
+
+  public:
+    [[nodiscard]] const std::vector<uint8_t>* _Nullable find(StandardMetadataType type) const {
+        const auto index = static_cast<size_t>(type);
+        if (index >= kNumTypes || !(mValidMask & standardMetadataTypeMask(type))) {
+            return nullptr;
+        }
+        return &mEncoded[index];
+    }
+
+    void store(StandardMetadataType type, const void* _Nonnull encoded, size_t size) {
+        const auto index = static_cast<size_t>(type);
+        if (index >= kNumTypes || !isStandardMetadataImmutable(type)) {
+            return;
+        }
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(encoded);
+        mEncoded[index].assign(src, src + size);
+        mValidMask |= standardMetadataTypeMask(type);
+    }
+};
+
+/**
+ * Resolves every StandardMetadataType whose bit is set in `typeMask` in a single pass,
+ * packing the replies into `destBuffer`. Bit N of the mask requests the type with value N
+ * (see standardMetadataTypeMask); bits beyond the known types are ignored. For each
+ * requested type, in ascending order, a record of
+ *
+ *     [int64_t type][int64_t size][size bytes of encoded metadata]
+ *
+ * is appended, where `size` has the same semantics as a getStandardMetadata return value.
+ * An unsupported type is recorded with its negative error and no payload instead of
+ * failing the whole batch. Returns the total size required to hold every record, which
+ * may be larger than destBufferSize, in which case the caller should retry with a larger
+ * buffer just as with the single-type getter.
+ *
+ * If `cache` is non-null, immutable fields are served from it when present and newly
+ * resolved ones are added to it, so repeat batches against the same buffer never invoke
+ * `f` for a field that cannot change after allocation.
+ */
+template <typename F>
+int32_t provideStandardMetadataBulk(uint64_t typeMask, void* _Nullable destBuffer,
+                                    size_t destBufferSize, StandardMetadataCache* _Nullable cache,
+                                    F&& f) {
+    constexpr size_t kRecordHeaderSize = 2 * sizeof(int64_t);
+    uint8_t* _Nullable dest = reinterpret_cast<uint8_t*>(destBuffer);
+    size_t sizeRemaining = destBuffer ? destBufferSize : 0;
+    int32_t desiredSize = 0;
+    bool sizeOverflowed = false;
+
+    auto accumulate = [&](int32_t size) {
+        if (__builtin_add_overflow(desiredSize, size, &desiredSize)) {
+            sizeOverflowed = true;
+        }
+    };
+    auto writeRecordHeader = [&](StandardMetadataType type, int64_t size) {
+        const int64_t typeAsInt = static_cast<int64_t>(type);
+        memcpy(dest, &typeAsInt, sizeof(int64_t));
+        memcpy(dest + sizeof(int64_t), &size, sizeof(int64_t));
+    };
+
+    for (const auto type : ndk::internal::enum_values<StandardMetadataType>) {
+        if (!(typeMask & standardMetadataTypeMask(type))) {
+            continue;
+        }
+        accumulate(kRecordHeaderSize);
+
+        const std::vector<uint8_t>* cached = cache ? cache->find(type) : nullptr;
+        if (cached) {
+            accumulate(static_cast<int32_t>(cached->size()));
+            if (sizeRemaining >= kRecordHeaderSize + cached->size()) {
+                writeRecordHeader(type, cached->size());
+                memcpy(dest + kRecordHeaderSize, cached->data(), cached->size());
+                dest += kRecordHeaderSize + cached->size();
+                sizeRemaining -= kRecordHeaderSize + cached->size();
+            } else {
+                sizeRemaining = 0;
+            }
+            continue;
+        }
+
+        if (sizeRemaining < kRecordHeaderSize) {
+            // No room for even the record header; keep sizing the batch without writing.
+            sizeRemaining = 0;
+            const int32_t size = provideStandardMetadata(type, nullptr, 0, f);
+            if (size > 0) {
+                accumulate(size);
+            }
+            continue;
+        }
+
+        const int32_t size = provideStandardMetadata(type, dest + kRecordHeaderSize,
+                                                     sizeRemaining - kRecordHeaderSize, f);
+        if (size > 0) {
+            accumulate(size);
+        }
+        if (size >= 0 && static_cast<size_t>(size) <= sizeRemaining - kRecordHeaderSize) {
+            if (cache) {
+                cache->store(type, dest + kRecordHeaderSize, size);
+            }
+            writeRecordHeader(type, size);
+            dest += kRecordHeaderSize + size;
+            sizeRemaining -= kRecordHeaderSize + size;
+        } else if (size < 0) {
+            writeRecordHeader(type, size);
+            dest += kRecordHeaderSize;
+            sizeRemaining -= kRecordHeaderSize;
+        } else {
+            // The payload did not fit; stop writing but keep sizing the rest of the batch.
+            sizeRemaining = 0;
+        }
+    }
+    return sizeOverflowed ? -AIMAPPER_ERROR_BAD_VALUE : desiredSize;
+}
+
 #endif
 
 }  // namespace android::hardware::graphics::mapper
\ No newline at end of file
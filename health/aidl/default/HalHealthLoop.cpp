@@ -56,7 +56,7 @@ int HalHealthLoop::PrepareToWait() {
 void HalHealthLoop::OnHealthInfoChanged(const HealthInfo& health_info) {
     callback_->OnHealthInfoChanged(health_info);
     set_charger_online(health_info);
-    AdjustWakealarmPeriods(charger_online());
+    AdjustWakealarmPeriods(charger_online(), update_battery_stable(health_info));
 }
 
 void HalHealthLoop::set_charger_online(const HealthInfo& health_info) {
@@ -64,4 +64,19 @@ void HalHealthLoop::set_charger_online(const HealthInfo& health_info) {
                       health_info.chargerWirelessOnline || health_info.chargerDockOnline;
 }
 
+bool HalHealthLoop::update_battery_stable(const HealthInfo& health_info) {
+    bool unchanged = last_health_info_.has_value() &&
+                     last_health_info_->batteryLevel == health_info.batteryLevel &&
+                     last_health_info_->batteryStatus == health_info.batteryStatus &&
+                     last_health_info_->batteryHealth == health_info.batteryHealth &&
+                     last_health_info_->batteryPresent == health_info.batteryPresent;
+    if (unchanged) {
+        if (stable_update_count_ < kStableUpdatesThreshold) stable_update_count_++;
+    } else {
+        stable_update_count_ = 0;
+        last_health_info_ = health_info;
+    }
+    return stable_update_count_ >= kStableUpdatesThreshold;
+}
+
 }  // namespace aidl::android::hardware::health
@@ -63,8 +63,17 @@ class HalHealthLoop final : public ::android::hardware::health::HealthLoop {
     std::shared_ptr<HalHealthLoopCallback> callback_;
     bool charger_online_ = false;
 
+    // Adaptive polling. After this many consecutive updates where the
+    // stability-relevant battery readings did not change, polling is
+    // stretched beyond the slow interval. Noisy instantaneous values
+    // (e.g. batteryCurrentMicroamps) are deliberately not compared.
+    static constexpr int kStableUpdatesThreshold = 3;
+    std::optional<HealthInfo> last_health_info_;
+    int stable_update_count_ = 0;
+
     // Helpers of OnHealthInfoChanged.
     void set_charger_online(const HealthInfo& health_info);
+    bool update_battery_stable(const HealthInfo& health_info);
 
     // HealthLoop periodically calls ScheduleBatteryUpdate, which calls
     // OnHealthInfoChanged callback. A subclass of the callback can override
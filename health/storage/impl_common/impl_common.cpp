@@ -15,6 +15,8 @@
  */
 #include <health-storage-impl/common.h>
 
+#include <stdio.h>
+
 #include <android-base/chrono_utils.h>
 #include <android-base/file.h>
 #include <android-base/logging.h>
@@ -45,6 +47,27 @@ static std::string GetGarbageCollectPath() {
     return "";
 }
 
+static constexpr const char* kIoPressurePath = "/proc/pressure/io";
+// Defer the next GC round while tasks were I/O-stalled for more than this
+// percentage of wall time over the last 10 seconds, so Dev GC yields to
+// foreground I/O bursts instead of competing with them.
+static constexpr double kIoPressureDeferPercent = 10.0;
+
+static bool IsIoPressureHigh() {
+    std::string psi;
+    if (!ReadFileToString(kIoPressurePath, &psi)) {
+        // Kernel without PSI support; never defer.
+        return false;
+    }
+    for (const auto& line : ::android::base::Split(psi, "\n")) {
+        double avg10;
+        if (sscanf(line.c_str(), "some avg10=%lf", &avg10) == 1) {
+            return avg10 >= kIoPressureDeferPercent;
+        }
+    }
+    return false;
+}
+
 static std::string GetWriteBoosterPath() {
     Fstab fstab;
     ReadDefaultFstab(&fstab);
@@ -94,6 +117,18 @@ Result GarbageCollect(uint64_t timeout_seconds) {
             LOG(DEBUG) << "No more to do Dev GC";
             break;
         }
+        if (IsIoPressureHigh()) {
+            // The device checkpoints its own GC progress, so skipping a round
+            // just resumes where it left off once the burst is over.
+            LOG(DEBUG) << "Defer Dev GC round on " << gc_path << ": I/O pressure is high";
+            if (timer.duration() >= std::chrono::seconds(timeout_seconds)) {
+                LOG(WARNING) << "Dev GC timeout";
+                // Timeout is not treated as an error. Try next time.
+                break;
+            }
+            sleep(2);
+            continue;
+        }
         LOG(DEBUG) << "Trigger Dev GC on " << gc_path << " having " << require_gc << ", WB on "
                    << wb_path << " having " << wb_avail;
         if (!WriteStringToFile("1", gc_path)) {
@@ -96,12 +96,26 @@ void HealthLoop::WakeAlarmSetInterval(int interval) {
         KLOG_ERROR(LOG_TAG, "wakealarm_set_interval: timerfd_settime failed\n");
 }
 
+// Multiplier applied to the slow interval once battery readings have been
+// reported stable.
+static constexpr int kStableIntervalStretchFactor = 2;
+
 void HealthLoop::AdjustWakealarmPeriods(bool charger_online) {
+    AdjustWakealarmPeriods(charger_online, false /* battery_stable */);
+}
+
+void HealthLoop::AdjustWakealarmPeriods(bool charger_online, bool battery_stable) {
     // Fast wake interval when on charger (watch for overheat);
-    // slow wake interval when on battery (watch for drained battery).
+    // slow wake interval when on battery (watch for drained battery);
+    // stretched wake interval on battery while readings are stable.
 
     int new_wake_interval = charger_online ? healthd_config_.periodic_chores_interval_fast
                                            : healthd_config_.periodic_chores_interval_slow;
+    if (!charger_online && battery_stable &&
+        healthd_config_.periodic_chores_interval_slow > 0) {
+        new_wake_interval =
+                healthd_config_.periodic_chores_interval_slow * kStableIntervalStretchFactor;
+    }
 
     if (new_wake_interval != wakealarm_wake_interval_) WakeAlarmSetInterval(new_wake_interval);
 
@@ -78,6 +78,12 @@ class HealthLoop {
     // then reset wake alarm interval by calling AdjustWakealarmPeriods.
     void AdjustWakealarmPeriods(bool charger_online);
 
+    // Like the above, but additionally lets the caller report that recent
+    // battery readings have been stable. On battery with stable readings the
+    // wake alarm is stretched beyond the slow interval to reduce steady-state
+    // wakeups; any uevent still triggers an immediate update.
+    void AdjustWakealarmPeriods(bool charger_online, bool battery_stable);
+
   private:
     struct EventHandler {
         HealthLoop* object = nullptr;
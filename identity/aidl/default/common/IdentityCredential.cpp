@@ -873,6 +873,9 @@ ndk::ScopedAStatus IdentityCredential::startRetrieveEntryValue(
     currentAccessControlProfileIds_ = accessControlProfileIds;
     entryRemainingBytes_ = entrySize;
     entryValue_.resize(0);
+    // The entry size is known up front; reserve it now so appending the
+    // decrypted chunks in retrieveEntryValue() doesn't reallocate.
+    entryValue_.reserve(entrySize);
 
     return ndk::ScopedAStatus::ok();
 }
@@ -598,7 +598,12 @@ optional<vector<uint8_t>> encryptAes128Gcm(const vector<uint8_t>& key, const vec
 }
 
 vector<uint8_t> certificateChainJoin(const vector<vector<uint8_t>>& certificateChain) {
+    size_t totalSize = 0;
+    for (const vector<uint8_t>& certificate : certificateChain) {
+        totalSize += certificate.size();
+    }
     vector<uint8_t> ret;
+    ret.reserve(totalSize);
     for (const vector<uint8_t>& certificate : certificateChain) {
         ret.insert(ret.end(), certificate.begin(), certificate.end());
     }
@@ -2271,6 +2276,7 @@ vector<vector<uint8_t>> chunkVector(const vector<uint8_t>& content, size_t maxCh
     }
 
     size_t numChunks = (contentSize + maxChunkSize - 1) / maxChunkSize;
+    ret.reserve(numChunks);
 
     size_t pos = 0;
     for (size_t n = 0; n < numChunks; n++) {
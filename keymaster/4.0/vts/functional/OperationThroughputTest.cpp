@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "KeymasterHidlTest.h"
+
+namespace android {
+namespace hardware {
+namespace keymaster {
+namespace V4_0 {
+namespace test {
+
+/*
+ * Measures sustained begin/update/finish throughput while several worker
+ * threads keep concurrent operation slots busy. This is not a correctness
+ * check beyond "operations complete without errors"; the numbers it reports
+ * exist to compare TEE scheduler configurations across builds. Workers call
+ * the HIDL interface directly instead of using the fixture helpers, as the
+ * helpers share per-fixture operation state and gtest expectations are not
+ * thread safe.
+ */
+class OperationThroughputTest : public KeymasterHidlTest {
+   protected:
+    static constexpr std::chrono::milliseconds kRunDuration{500};
+    static constexpr uint32_t kThreadCounts[] = {1, 2, 4, 8};
+
+    struct WorkerTotals {
+        uint64_t completedOps = 0;
+        uint64_t backpressure = 0;
+        uint64_t failures = 0;
+    };
+
+    // Runs begin/update/finish cycles on 'threadCount' workers for
+    // kRunDuration. TOO_MANY_OPERATIONS from begin() means the concurrent
+    // slots are saturated and is counted as back-pressure, not failure.
+    WorkerTotals runWorkers(uint32_t threadCount, KeyPurpose purpose,
+                            const AuthorizationSet& begin_params, const string& message) {
+        std::atomic<bool> stop(false);
+        std::atomic<uint64_t> completedOps(0);
+        std::atomic<uint64_t> backpressure(0);
+        std::atomic<uint64_t> failures(0);
+        std::vector<std::thread> workers;
+        for (uint32_t i = 0; i < threadCount; ++i) {
+            workers.emplace_back([&] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    ErrorCode error = ErrorCode::UNKNOWN_ERROR;
+                    OperationHandle op_handle = kOpHandleSentinel;
+                    auto rc = keymaster().begin(
+                            purpose, key_blob_, begin_params.hidl_data(), HardwareAuthToken(),
+                            [&](ErrorCode hidl_error, const hidl_vec<KeyParameter>&,
+                                uint64_t hidl_op_handle) {
+                                error = hidl_error;
+                                op_handle = hidl_op_handle;
+                            });
+                    if (!rc.isOk()) {
+                        failures++;
+                        return;
+                    }
+                    if (error == ErrorCode::TOO_MANY_OPERATIONS) {
+                        backpressure++;
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    if (error != ErrorCode::OK) {
+                        failures++;
+                        return;
+                    }
+                    rc = keymaster().update(op_handle, hidl_vec<KeyParameter>(), HidlBuf(message),
+                                            HardwareAuthToken(), VerificationToken(),
+                                            [&](ErrorCode hidl_error, uint32_t,
+                                                const hidl_vec<KeyParameter>&,
+                                                const HidlBuf&) { error = hidl_error; });
+                    if (rc.isOk() && error == ErrorCode::OK) {
+                        rc = keymaster().finish(op_handle, hidl_vec<KeyParameter>(), HidlBuf(),
+                                                HidlBuf(), HardwareAuthToken(),
+                                                VerificationToken(),
+                                                [&](ErrorCode hidl_error,
+                                                    const hidl_vec<KeyParameter>&,
+                                                    const HidlBuf&) { error = hidl_error; });
+                    }
+                    if (!rc.isOk() || error != ErrorCode::OK) {
+                        failures++;
+                        keymaster().abort(op_handle);
+                        return;
+                    }
+                    completedOps++;
+                }
+            });
+        }
+        std::this_thread::sleep_for(kRunDuration);
+        stop = true;
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        return {completedOps.load(), backpressure.load(), failures.load()};
+    }
+
+    // Ramps the worker count and reports the best sustained rate. The key must
+    // have been generated into key_blob_ before calling.
+    void runSaturationSuite(const char* label, KeyPurpose purpose,
+                            const AuthorizationSet& begin_params, const string& message) {
+        double maxOpsPerSec = 0;
+        uint32_t bestThreadCount = 0;
+        for (uint32_t threadCount : kThreadCounts) {
+            WorkerTotals totals = runWorkers(threadCount, purpose, begin_params, message);
+            ASSERT_EQ(0U, totals.failures)
+                    << label << ": operations failed with " << threadCount << " threads";
+            const double opsPerSec =
+                    totals.completedOps * 1000.0 /
+                    std::chrono::duration_cast<std::chrono::milliseconds>(kRunDuration).count();
+            std::cout << label << ": threads=" << threadCount << " ops=" << totals.completedOps
+                      << " backpressure=" << totals.backpressure << " rate=" << opsPerSec
+                      << " ops/sec" << std::endl;
+            if (opsPerSec > maxOpsPerSec) {
+                maxOpsPerSec = opsPerSec;
+                bestThreadCount = threadCount;
+            }
+        }
+        std::cout << label << ": max sustained rate=" << maxOpsPerSec << " ops/sec at "
+                  << bestThreadCount << " threads" << std::endl;
+        RecordProperty(string(label) + "_max_ops_per_sec", std::to_string(maxOpsPerSec));
+        RecordProperty(string(label) + "_best_thread_count", std::to_string(bestThreadCount));
+    }
+};
+
+constexpr std::chrono::milliseconds OperationThroughputTest::kRunDuration;
+constexpr uint32_t OperationThroughputTest::kThreadCounts[];
+
+/*
+ * OperationThroughputTest.AesCtrEncrypt
+ *
+ * Symmetric cipher pipeline rate with 1KiB payloads.
+ */
+TEST_P(OperationThroughputTest, AesCtrEncrypt) {
+    ASSERT_EQ(ErrorCode::OK, GenerateKey(AuthorizationSetBuilder()
+                                                 .Authorization(TAG_NO_AUTH_REQUIRED)
+                                                 .AesEncryptionKey(256)
+                                                 .BlockMode(BlockMode::CTR)
+                                                 .Padding(PaddingMode::NONE)));
+    runSaturationSuite("aes_ctr_encrypt", KeyPurpose::ENCRYPT,
+                       AuthorizationSetBuilder()
+                               .BlockMode(BlockMode::CTR)
+                               .Padding(PaddingMode::NONE),
+                       string(1024, 'x'));
+}
+
+/*
+ * OperationThroughputTest.HmacSha256Sign
+ *
+ * MAC pipeline rate with 1KiB payloads.
+ */
+TEST_P(OperationThroughputTest, HmacSha256Sign) {
+    ASSERT_EQ(ErrorCode::OK, GenerateKey(AuthorizationSetBuilder()
+                                                 .Authorization(TAG_NO_AUTH_REQUIRED)
+                                                 .HmacKey(256)
+                                                 .Digest(Digest::SHA_2_256)
+                                                 .Authorization(TAG_MIN_MAC_LENGTH, 256)));
+    runSaturationSuite("hmac_sha256_sign", KeyPurpose::SIGN,
+                       AuthorizationSetBuilder()
+                               .Digest(Digest::SHA_2_256)
+                               .Authorization(TAG_MAC_LENGTH, 256),
+                       string(1024, 'x'));
+}
+
+/*
+ * OperationThroughputTest.EcdsaP256Sign
+ *
+ * Asymmetric signing rate; payloads are small since the digest dominates.
+ */
+TEST_P(OperationThroughputTest, EcdsaP256Sign) {
+    ASSERT_EQ(ErrorCode::OK, GenerateKey(AuthorizationSetBuilder()
+                                                 .Authorization(TAG_NO_AUTH_REQUIRED)
+                                                 .EcdsaSigningKey(EcCurve::P_256)
+                                                 .Digest(Digest::SHA_2_256)));
+    runSaturationSuite("ecdsa_p256_sign", KeyPurpose::SIGN,
+                       AuthorizationSetBuilder().Digest(Digest::SHA_2_256), string(128, 'x'));
+}
+
+INSTANTIATE_KEYMASTER_HIDL_TEST(OperationThroughputTest);
+
+}  // namespace test
+}  // namespace V4_0
+}  // namespace keymaster
+}  // namespace hardware
+}  // namespace android
@@ -26,12 +26,20 @@ namespace light {
 static constexpr int kNumDefaultLights = 3;
 
 ndk::ScopedAStatus Lights::setLightState(int id, const HwLightState& state) {
-    LOG(INFO) << "Lights setting state for id=" << id << " to color " << std::hex << state.color;
     if (id <= 0 || id > kNumDefaultLights) {
         return ndk::ScopedAStatus::fromExceptionCode(EX_UNSUPPORTED_OPERATION);
-    } else {
-        return ndk::ScopedAStatus::ok();
     }
+    {
+        std::lock_guard<std::mutex> lock(mStateLock);
+        auto it = mLastState.find(id);
+        if (it != mLastState.end() && it->second == state) {
+            // The light is already in this state; nothing to write.
+            return ndk::ScopedAStatus::ok();
+        }
+        mLastState[id] = state;
+    }
+    LOG(INFO) << "Lights setting state for id=" << id << " to color " << std::hex << state.color;
+    return ndk::ScopedAStatus::ok();
 }
 
 ndk::ScopedAStatus Lights::getLights(std::vector<HwLight>* lights) {
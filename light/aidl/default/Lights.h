@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
+
 #include <aidl/android/hardware/light/BnLights.h>
 
 namespace aidl {
@@ -27,6 +30,11 @@ namespace light {
 class Lights : public BnLights {
     ndk::ScopedAStatus setLightState(int id, const HwLightState& state) override;
     ndk::ScopedAStatus getLights(std::vector<HwLight>* lights) override;
+
+    // Last state applied per light, so repeated sets with an unchanged state
+    // (e.g. animations updating several channels per frame) skip the apply.
+    std::mutex mStateLock;
+    std::unordered_map<int, HwLightState> mLastState;
 };
 
 }  // namespace light
@@ -32,6 +32,10 @@ namespace aidl::android::hardware::media::bufferpool2::implementation {
 namespace {
     static constexpr nsecs_t kEvictGranularityNs = 1000000000; // 1 sec
     static constexpr nsecs_t kEvictDurationNs = 5000000000; // 5 secs
+
+    // Prefetch hints are clamped so a pool cannot be filled past the point
+    // where periodic cleanup would immediately evict the prefetched buffers.
+    static constexpr uint32_t kMaxPrefetchCount = 32;
 }
 
 #ifdef __ANDROID_VNDK__
@@ -207,6 +211,48 @@ BufferPoolStatus Accessor::allocate(
     return status;
 }
 
+BufferPoolStatus Accessor::prefetch(
+        const std::vector<uint8_t> &params, uint32_t count) {
+    if (count == 0) {
+        return ResultStatus::OK;
+    }
+    if (!isValid() || !sPrefetcher) {
+        return ResultStatus::CRITICAL_ERROR;
+    }
+    if (count > kMaxPrefetchCount) {
+        count = kMaxPrefetchCount;
+    }
+    sPrefetcher->addRequest(ref<Accessor>(), params, count);
+    return ResultStatus::OK;
+}
+
+void Accessor::doPrefetch(const std::vector<uint8_t> &params, uint32_t count) {
+    uint32_t needed = 0;
+    {
+        std::lock_guard<std::mutex> lock(mBufferPool.mMutex);
+        mBufferPool.processStatusMessages();
+        size_t cached = mBufferPool.mFreeBuffers.countFor(params);
+        if (cached < count) {
+            needed = count - cached;
+        }
+    }
+    uint32_t added = 0;
+    for (uint32_t i = 0; i < needed; ++i) {
+        std::shared_ptr<BufferPoolAllocation> alloc;
+        size_t allocSize;
+        BufferPoolStatus status = mAllocator->allocate(params, &alloc, &allocSize);
+        if (status != ResultStatus::OK) {
+            break;
+        }
+        std::lock_guard<std::mutex> lock(mBufferPool.mMutex);
+        if (mBufferPool.addFreeBuffer(alloc, allocSize, params) != ResultStatus::OK) {
+            break;
+        }
+        ++added;
+    }
+    ALOGV("prefetched %u/%u buffers", added, count);
+}
+
 BufferPoolStatus Accessor::fetch(
         ConnectionId connectionId, TransactionId transactionId,
         BufferId bufferId, const native_handle_t** handle) {
@@ -497,6 +543,54 @@ void Accessor::createEvictor() {
     }
 }
 
+void Accessor::prefetcherThread(
+        std::list<AccessorPrefetcher::Request> &requests,
+        std::mutex &mutex,
+        std::condition_variable &cv) {
+    while (true) {
+        AccessorPrefetcher::Request request;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (requests.empty()) {
+                cv.wait(lock);
+            }
+            request = requests.front();
+            requests.pop_front();
+        }
+        // Allocation happens outside any pool lock; allocate# callers at most
+        // contend for the brief free list insertions.
+        const std::shared_ptr<Accessor> accessor = request.mAccessor.lock();
+        if (accessor) {
+            accessor->doPrefetch(request.mParams, request.mCount);
+        }
+    }
+}
+
+Accessor::AccessorPrefetcher::AccessorPrefetcher() {
+    std::thread prefetcher(
+            prefetcherThread,
+            std::ref(mRequests),
+            std::ref(mMutex),
+            std::ref(mCv));
+    prefetcher.detach();
+}
+
+void Accessor::AccessorPrefetcher::addRequest(
+        const std::weak_ptr<Accessor> &accessor,
+        const std::vector<uint8_t> &params, uint32_t count) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRequests.push_back(Request{accessor, params, count});
+    mCv.notify_one();
+}
+
+std::unique_ptr<Accessor::AccessorPrefetcher> Accessor::sPrefetcher;
+
+void Accessor::createPrefetcher() {
+    if (!sPrefetcher) {
+        sPrefetcher = std::make_unique<Accessor::AccessorPrefetcher>();
+    }
+}
+
 void Accessor::scheduleEvictIfNeeded() {
     nsecs_t now = systemTime();
 
@@ -21,6 +21,7 @@
 #include <bufferpool2/BufferPoolTypes.h>
 
 #include <memory>
+#include <list>
 #include <map>
 #include <set>
 #include <condition_variable>
@@ -107,6 +108,22 @@ struct Accessor : public BnAccessor {
             BufferId *bufferId,
             const native_handle_t** handle);
 
+    /**
+     * Hints the buffer pool about upcoming allocation demand. {@code count}
+     * buffers matching {@code params} are allocated asynchronously on the
+     * prefetcher thread and placed on the free list, so subsequent allocate#
+     * calls with compatible parameters recycle them instead of paying
+     * allocation latency. Buffers already free with the same config count
+     * against the hint.
+     *
+     * @param params    the allocation parameters of the expected buffers.
+     * @param count     the expected number of buffers.
+     *
+     * @return OK when the hint is queued to the prefetcher thread.
+     *         CRITICAL_ERROR otherwise.
+     */
+    BufferPoolStatus prefetch(const std::vector<uint8_t>& params, uint32_t count);
+
     /**
      * Fetches a buffer for the specified transaction.
      *
@@ -186,6 +203,8 @@ struct Accessor : public BnAccessor {
 
     static void createEvictor();
 
+    static void createPrefetcher();
+
 private:
     // ConnectionId = pid : (timestamp_created + seqId)
     // in order to guarantee uniqueness for each connection
@@ -232,6 +251,30 @@ private:
 
     void scheduleEvictIfNeeded();
 
+    struct AccessorPrefetcher {
+        struct Request {
+            std::weak_ptr<Accessor> mAccessor;
+            std::vector<uint8_t> mParams;
+            uint32_t mCount;
+        };
+        std::list<Request> mRequests;
+        std::mutex mMutex;
+        std::condition_variable mCv;
+
+        AccessorPrefetcher();
+        void addRequest(const std::weak_ptr<Accessor> &accessor,
+                        const std::vector<uint8_t> &params, uint32_t count);
+    };
+
+    static std::unique_ptr<AccessorPrefetcher> sPrefetcher;
+
+    static void prefetcherThread(
+        std::list<AccessorPrefetcher::Request> &requests,
+        std::mutex &mutex,
+        std::condition_variable &cv);
+
+    void doPrefetch(const std::vector<uint8_t> &params, uint32_t count);
+
     friend struct BufferPool;
 };
 
@@ -198,7 +198,7 @@ bool BufferPool::handleReleaseBuffer(
                 iter->second->mTransactionCount == 0) {
             if (!iter->second->mInvalidated) {
                 mStats.onBufferUnused(iter->second->mAllocSize);
-                mFreeBuffers.insert(bufferId);
+                mFreeBuffers.insert(bufferId, iter->second->mConfig);
             } else {
                 mStats.onBufferUnused(iter->second->mAllocSize);
                 mStats.onBufferEvicted(iter->second->mAllocSize);
@@ -287,7 +287,7 @@ bool BufferPool::handleTransferResult(const BufferStatusMessage &message) {
                 && bufferIter->second->mTransactionCount == 0) {
                 if (!bufferIter->second->mInvalidated) {
                     mStats.onBufferUnused(bufferIter->second->mAllocSize);
-                    mFreeBuffers.insert(message.bufferId);
+                    mFreeBuffers.insert(message.bufferId, bufferIter->second->mConfig);
                 } else {
                     mStats.onBufferUnused(bufferIter->second->mAllocSize);
                     mStats.onBufferEvicted(bufferIter->second->mAllocSize);
@@ -366,7 +366,7 @@ bool BufferPool::handleClose(ConnectionId connectionId) {
                     // TODO: handle freebuffer insert fail
                     if (!bufferIter->second->mInvalidated) {
                         mStats.onBufferUnused(bufferIter->second->mAllocSize);
-                        mFreeBuffers.insert(bufferId);
+                        mFreeBuffers.insert(bufferId, bufferIter->second->mConfig);
                     } else {
                         mStats.onBufferUnused(bufferIter->second->mAllocSize);
                         mStats.onBufferEvicted(bufferIter->second->mAllocSize);
@@ -396,7 +396,7 @@ bool BufferPool::handleClose(ConnectionId connectionId) {
                     // TODO: handle freebuffer insert fail
                     if (!bufferIter->second->mInvalidated) {
                         mStats.onBufferUnused(bufferIter->second->mAllocSize);
-                        mFreeBuffers.insert(bufferId);
+                        mFreeBuffers.insert(bufferId, bufferIter->second->mConfig);
                     } else {
                         mStats.onBufferUnused(bufferIter->second->mAllocSize);
                         mStats.onBufferEvicted(bufferIter->second->mAllocSize);
@@ -416,16 +416,12 @@ bool BufferPool::getFreeBuffer(
         const std::shared_ptr<BufferPoolAllocator> &allocator,
         const std::vector<uint8_t> &params, BufferId *pId,
         const native_handle_t** handle) {
-    auto bufferIt = mFreeBuffers.begin();
-    for (;bufferIt != mFreeBuffers.end(); ++bufferIt) {
-        BufferId bufferId = *bufferIt;
-        if (allocator->compatible(params, mBuffers[bufferId]->mConfig)) {
-            break;
-        }
-    }
-    if (bufferIt != mFreeBuffers.end()) {
-        BufferId id = *bufferIt;
-        mFreeBuffers.erase(bufferIt);
+    BufferId id;
+    size_t scanned;
+    bool found = mFreeBuffers.pick(allocator, params, &id, &scanned);
+    mStats.onRecycleScan(scanned);
+    if (found) {
+        mFreeBuffers.erase(id);
         mStats.onBufferRecycled(mBuffers[id]->mAllocSize);
         *handle = mBuffers[id]->handle();
         *pId = id;
@@ -462,6 +458,32 @@ BufferPoolStatus BufferPool::addNewBuffer(
     return ResultStatus::NO_MEMORY;
 }
 
+BufferPoolStatus BufferPool::addFreeBuffer(
+        const std::shared_ptr<BufferPoolAllocation> &alloc,
+        const size_t allocSize,
+        const std::vector<uint8_t> &params) {
+
+    BufferId bufferId = mSeq++;
+    if (mSeq == Connection::SYNC_BUFFERID) {
+        mSeq = 0;
+    }
+    std::unique_ptr<InternalBuffer> buffer =
+            std::make_unique<InternalBuffer>(
+                    bufferId, alloc, allocSize, params);
+    if (buffer) {
+        auto res = mBuffers.insert(std::make_pair(
+                bufferId, std::move(buffer)));
+        if (res.second) {
+            mStats.onBufferAllocated(allocSize);
+            mStats.onBufferUnused(allocSize);
+            mFreeBuffers.insert(bufferId, params);
+            ALOGV("prefetch a buffer %u", bufferId);
+            return ResultStatus::OK;
+        }
+    }
+    return ResultStatus::NO_MEMORY;
+}
+
 void BufferPool::cleanUp(bool clearCache) {
     if (clearCache || mTimestampMs > mLastCleanUpMs + kCleanUpDurationMs ||
             mStats.buffersNotInUse() > kMaxUnusedBufferCount) {
@@ -471,26 +493,30 @@ void BufferPool::cleanUp(bool clearCache) {
             mLastLogMs = mTimestampMs;
             ALOGD("bufferpool2 %p : %zu(%zu size) total buffers - "
                   "%zu(%zu size) used buffers - %zu/%zu (recycle/alloc) - "
-                  "%zu/%zu (fetch/transfer)",
+                  "%zu/%zu (fetch/transfer) - %zu/%zu (scan/max-scan)",
                   this, mStats.mBuffersCached, mStats.mSizeCached,
                   mStats.mBuffersInUse, mStats.mSizeInUse,
                   mStats.mTotalRecycles, mStats.mTotalAllocations,
-                  mStats.mTotalFetches, mStats.mTotalTransfers);
+                  mStats.mTotalFetches, mStats.mTotalTransfers,
+                  mStats.mTotalRecycleScans, mStats.mMaxRecycleScan);
         }
-        for (auto freeIt = mFreeBuffers.begin(); freeIt != mFreeBuffers.end();) {
+        // Evict least recently freed buffers first.
+        auto freeIt = mFreeBuffers.mLru.begin();
+        while (freeIt != mFreeBuffers.mLru.end()) {
             if (!clearCache && mStats.buffersNotInUse() <= kUnusedBufferCountTarget &&
                     (mStats.mSizeCached < kMinAllocBytesForEviction ||
                      mBuffers.size() < kMinBufferCountForEviction)) {
                 break;
             }
-            auto it = mBuffers.find(*freeIt);
+            BufferId bufferId = *freeIt;
+            ++freeIt;
+            auto it = mBuffers.find(bufferId);
             if (it != mBuffers.end() &&
                     it->second->mOwnerCount == 0 && it->second->mTransactionCount == 0) {
                 mStats.onBufferEvicted(it->second->mAllocSize);
                 mBuffers.erase(it);
-                freeIt = mFreeBuffers.erase(freeIt);
+                mFreeBuffers.erase(bufferId);
             } else {
-                ++freeIt;
                 ALOGW("bufferpool2 inconsistent!");
             }
         }
@@ -500,20 +526,21 @@ void BufferPool::cleanUp(bool clearCache) {
 void BufferPool::invalidate(
         bool needsAck, BufferId from, BufferId to,
         const std::shared_ptr<Accessor> &impl) {
-    for (auto freeIt = mFreeBuffers.begin(); freeIt != mFreeBuffers.end();) {
-        if (isBufferInRange(from, to, *freeIt)) {
-            auto it = mBuffers.find(*freeIt);
+    auto freeIt = mFreeBuffers.mLru.begin();
+    while (freeIt != mFreeBuffers.mLru.end()) {
+        BufferId bufferId = *freeIt;
+        ++freeIt;
+        if (isBufferInRange(from, to, bufferId)) {
+            auto it = mBuffers.find(bufferId);
             if (it != mBuffers.end() &&
                 it->second->mOwnerCount == 0 && it->second->mTransactionCount == 0) {
                 mStats.onBufferEvicted(it->second->mAllocSize);
                 mBuffers.erase(it);
-                freeIt = mFreeBuffers.erase(freeIt);
-                continue;
+                mFreeBuffers.erase(bufferId);
             } else {
                 ALOGW("bufferpool2 inconsistent!");
             }
         }
-        ++freeIt;
     }
 
     size_t left = 0;
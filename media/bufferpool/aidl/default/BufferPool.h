@@ -24,6 +24,7 @@
 #include <utils/Timers.h>
 
 #include "BufferStatus.h"
+#include "DataHelper.h"
 
 namespace aidl::android::hardware::media::bufferpool2::implementation {
 
@@ -65,7 +66,7 @@ private:
             mTransactions;
 
     std::map<BufferId, std::unique_ptr<InternalBuffer>> mBuffers;
-    std::set<BufferId> mFreeBuffers;
+    FreeBufferTracker mFreeBuffers;
     std::set<ConnectionId> mConnectionIds;
 
     struct Invalidation {
@@ -140,9 +141,15 @@ private:
         /// # of transfers that had to be fetched.
         size_t mTotalFetches;
 
+        /// # of free buffer configs probed over all recycle attempts.
+        size_t mTotalRecycleScans;
+        /// longest config probe sequence seen on a single recycle attempt.
+        size_t mMaxRecycleScan;
+
         Stats()
             : mSizeCached(0), mBuffersCached(0), mSizeInUse(0), mBuffersInUse(0),
-              mTotalAllocations(0), mTotalRecycles(0), mTotalTransfers(0), mTotalFetches(0) {}
+              mTotalAllocations(0), mTotalRecycles(0), mTotalTransfers(0), mTotalFetches(0),
+              mTotalRecycleScans(0), mMaxRecycleScan(0) {}
 
         /// # of currently unused buffers
         size_t buffersNotInUse() const {
@@ -191,6 +198,14 @@ private:
         void onBufferFetched() {
             mTotalFetches++;
         }
+
+        /// A recycle attempt probed {@code scanned} free buffer configs.
+        void onRecycleScan(size_t scanned) {
+            mTotalRecycleScans += scanned;
+            if (scanned > mMaxRecycleScan) {
+                mMaxRecycleScan = scanned;
+            }
+        }
     } mStats;
 
     bool isValid() {
@@ -315,6 +330,23 @@ public:
             BufferId *pId,
             const native_handle_t **handle);
 
+    /**
+     * Adds a newly allocated buffer to bufferpool as a free buffer, so that
+     * a subsequent allocation request with a compatible config recycles it
+     * instead of paying allocation latency. Used by allocation prefetch.
+     *
+     * @param alloc     the newly allocated buffer.
+     * @param allocSize the size of the newly allocated buffer.
+     * @param params    the allocation parameters.
+     *
+     * @return OK when the buffer is successfully added to the free list.
+     *         NO_MEMORY when there is no memory.
+     */
+    BufferPoolStatus addFreeBuffer(
+            const std::shared_ptr<BufferPoolAllocation> &alloc,
+            const size_t allocSize,
+            const std::vector<uint8_t> &params);
+
     /**
      * Processes pending buffer status messages and performs periodic cache
      * cleaning.
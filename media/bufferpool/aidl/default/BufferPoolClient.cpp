@@ -72,6 +72,9 @@ public:
                           native_handle_t **handle,
                           std::shared_ptr<BufferPoolData> *buffer);
 
+    BufferPoolStatus prefetch(const std::vector<uint8_t> &params,
+                          uint32_t count);
+
     BufferPoolStatus receive(
             TransactionId transactionId, BufferId bufferId,
             int64_t timestampMs,
@@ -393,6 +396,14 @@ BufferPoolStatus BufferPoolClient::Impl::allocate(
     return status;
 }
 
+BufferPoolStatus BufferPoolClient::Impl::prefetch(
+        const std::vector<uint8_t> &params, uint32_t count) {
+    if (!mLocal || !mLocalConnection || !mValid) {
+        return ResultStatus::CRITICAL_ERROR;
+    }
+    return mLocalConnection->prefetch(params, count);
+}
+
 BufferPoolStatus BufferPoolClient::Impl::receive(
         TransactionId transactionId, BufferId bufferId, int64_t timestampMs,
         native_handle_t **pHandle,
@@ -833,6 +844,14 @@ BufferPoolStatus BufferPoolClient::allocate(
     return ResultStatus::CRITICAL_ERROR;
 }
 
+BufferPoolStatus BufferPoolClient::prefetch(
+        const std::vector<uint8_t> &params, uint32_t count) {
+    if (isValid()) {
+        return mImpl->prefetch(params, count);
+    }
+    return ResultStatus::CRITICAL_ERROR;
+}
+
 BufferPoolStatus BufferPoolClient::receive(
         TransactionId transactionId, BufferId bufferId, int64_t timestampMs,
         native_handle_t **handle, std::shared_ptr<BufferPoolData> *buffer) {
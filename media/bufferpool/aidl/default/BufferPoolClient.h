@@ -73,6 +73,9 @@ private:
                           native_handle_t **handle,
                           std::shared_ptr<BufferPoolData> *buffer);
 
+    BufferPoolStatus prefetch(const std::vector<uint8_t> &params,
+                          uint32_t count);
+
     BufferPoolStatus receive(TransactionId transactionId,
                          BufferId bufferId,
                          int64_t timestampMs,
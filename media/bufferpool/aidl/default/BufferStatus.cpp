@@ -19,6 +19,7 @@
 
 #include <thread>
 #include <time.h>
+#include <vector>
 #include <aidl/android/hardware/media/bufferpool2/BufferStatus.h>
 #include "BufferStatus.h"
 
@@ -70,19 +71,22 @@ BufferPoolStatus BufferStatusObserver::close(ConnectionId id) {
 
 void BufferStatusObserver::getBufferStatusChanges(std::vector<BufferStatusMessage> &messages) {
     for (auto it = mBufferStatusQueues.begin(); it != mBufferStatusQueues.end(); ++it) {
-        BufferStatusMessage message;
         size_t avail = it->second->availableToRead();
-        while (avail > 0) {
-            if (!it->second->read(&message, 1)) {
-                // Since available # of reads are already confirmed,
-                // this should not happen.
-                // TODO: error handling (spurious client?)
-                ALOGW("FMQ message cannot be read from %lld", (long long)it->first);
-                return;
-            }
+        if (avail == 0) {
+            continue;
+        }
+        std::vector<BufferStatusMessage> temp(avail);
+        if (!it->second->read(temp.data(), avail)) {
+            // Since available # of reads are already confirmed,
+            // this should not happen.
+            // TODO: error handling (spurious client?)
+            ALOGW("FMQ messages cannot be read from %lld", (long long)it->first);
+            return;
+        }
+        messages.reserve(messages.size() + avail);
+        for (auto &message : temp) {
             message.connectionId = it->first;
             messages.push_back(message);
-            --avail;
         }
     }
 }
@@ -116,21 +120,26 @@ void BufferStatusChannel::postBufferRelease(
     if (mValid && pending.size() > 0) {
         size_t avail = mBufferStatusQueue->availableToWrite();
         avail = std::min(avail, pending.size());
-        BufferStatusMessage message;
+        if (avail == 0) {
+            return;
+        }
+        std::vector<BufferStatusMessage> messages(avail);
+        auto it = pending.begin();
+        for (size_t i = 0 ; i < avail; ++i, ++it) {
+            messages[i].status = BufferStatus::NOT_USED;
+            messages[i].bufferId = *it;
+            messages[i].connectionId = connectionId;
+        }
+        if (!mBufferStatusQueue->write(messages.data(), avail)) {
+            // Since available # of writes are already confirmed,
+            // this should not happen.
+            // TODO: error handing?
+            ALOGW("FMQ messages cannot be sent from %lld", (long long)connectionId);
+            return;
+        }
         for (size_t i = 0 ; i < avail; ++i) {
-            BufferId id = pending.front();
-            message.status = BufferStatus::NOT_USED;
-            message.bufferId = id;
-            message.connectionId = connectionId;
-            if (!mBufferStatusQueue->write(&message, 1)) {
-                // Since available # of writes are already confirmed,
-                // this should not happen.
-                // TODO: error handing?
-                ALOGW("FMQ message cannot be sent from %lld", (long long)connectionId);
-                return;
-            }
+            posted.push_back(pending.front());
             pending.pop_front();
-            posted.push_back(id);
         }
     }
 }
@@ -166,22 +175,17 @@ bool BufferStatusChannel::postBufferStatusMessage(
         size_t avail = mBufferStatusQueue->availableToWrite();
         size_t numPending = pending.size();
         if (avail >= numPending + 1) {
-            BufferStatusMessage release, message;
-            for (size_t i = 0; i < numPending; ++i) {
-                BufferId id = pending.front();
-                release.status = BufferStatus::NOT_USED;
-                release.bufferId = id;
-                release.connectionId = connectionId;
-                if (!mBufferStatusQueue->write(&release, 1)) {
-                    // Since available # of writes are already confirmed,
-                    // this should not happen.
-                    // TODO: error handling?
-                    ALOGW("FMQ message cannot be sent from %lld", (long long)connectionId);
-                    return false;
-                }
-                pending.pop_front();
-                posted.push_back(id);
+            // Coalesce the pending releases and the transfer message into a
+            // single FMQ write, so a transfer costs one queue transaction
+            // regardless of how many buffers were released since the last one.
+            std::vector<BufferStatusMessage> messages(numPending + 1);
+            auto it = pending.begin();
+            for (size_t i = 0; i < numPending; ++i, ++it) {
+                messages[i].status = BufferStatus::NOT_USED;
+                messages[i].bufferId = *it;
+                messages[i].connectionId = connectionId;
             }
+            BufferStatusMessage &message = messages[numPending];
             message.transactionId = transactionId;
             message.bufferId = bufferId;
             message.status = status;
@@ -189,12 +193,16 @@ bool BufferStatusChannel::postBufferStatusMessage(
             message.targetConnectionId = targetId;
             // TODO : timesatamp
             message.timestampUs = 0;
-            if (!mBufferStatusQueue->write(&message, 1)) {
+            if (!mBufferStatusQueue->write(messages.data(), numPending + 1)) {
                 // Since available # of writes are already confirmed,
                 // this should not happen.
-                ALOGW("FMQ message cannot be sent from %lld", (long long)connectionId);
+                ALOGW("FMQ messages cannot be sent from %lld", (long long)connectionId);
                 return false;
             }
+            for (size_t i = 0; i < numPending; ++i) {
+                posted.push_back(pending.front());
+                pending.pop_front();
+            }
             return true;
         }
     }
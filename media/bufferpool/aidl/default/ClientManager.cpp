@@ -67,6 +67,10 @@ public:
                           native_handle_t **handle,
                           std::shared_ptr<BufferPoolData> *buffer);
 
+    BufferPoolStatus prefetch(ConnectionId connectionId,
+                          const std::vector<uint8_t> &params,
+                          uint32_t count);
+
     BufferPoolStatus receive(ConnectionId connectionId,
                          TransactionId transactionId,
                          BufferId bufferId,
@@ -316,6 +320,21 @@ BufferPoolStatus ClientManager::Impl::allocate(
 #endif
 }
 
+BufferPoolStatus ClientManager::Impl::prefetch(
+        ConnectionId connectionId, const std::vector<uint8_t> &params,
+        uint32_t count) {
+    std::shared_ptr<BufferPoolClient> client;
+    {
+        std::lock_guard<std::mutex> lock(mActive.mMutex);
+        auto it = mActive.mClients.find(connectionId);
+        if (it == mActive.mClients.end()) {
+            return ResultStatus::NOT_FOUND;
+        }
+        client = it->second;
+    }
+    return client->prefetch(params, count);
+}
+
 BufferPoolStatus ClientManager::Impl::receive(
         ConnectionId connectionId, TransactionId transactionId,
         BufferId bufferId, int64_t timestampMs,
@@ -435,6 +454,7 @@ std::shared_ptr<ClientManager> ClientManager::getInstance() {
     }
     Accessor::createInvalidator();
     Accessor::createEvictor();
+    Accessor::createPrefetcher();
     return sInstance;
 }
 
@@ -486,6 +506,15 @@ BufferPoolStatus ClientManager::allocate(
     return ResultStatus::CRITICAL_ERROR;
 }
 
+BufferPoolStatus ClientManager::prefetch(
+        ConnectionId connectionId, const std::vector<uint8_t> &params,
+        uint32_t count) {
+    if (mImpl) {
+        return mImpl->prefetch(connectionId, params, count);
+    }
+    return ResultStatus::CRITICAL_ERROR;
+}
+
 BufferPoolStatus ClientManager::receive(
         ConnectionId connectionId, TransactionId transactionId,
         BufferId bufferId, int64_t timestampMs,
@@ -105,6 +105,14 @@ BufferPoolStatus Connection::allocate(
     return ResultStatus::CRITICAL_ERROR;
 }
 
+BufferPoolStatus Connection::prefetch(
+        const std::vector<uint8_t> &params, uint32_t count) {
+    if (mInitialized && mAccessor) {
+        return mAccessor->prefetch(params, count);
+    }
+    return ResultStatus::CRITICAL_ERROR;
+}
+
 void Connection::cleanUp(bool clearCache) {
     if (mInitialized && mAccessor) {
         mAccessor->cleanUp(clearCache);
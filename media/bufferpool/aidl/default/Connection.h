@@ -53,6 +53,21 @@ struct Connection : public BnConnection {
     BufferPoolStatus allocate(const std::vector<uint8_t> &params,
                           BufferId *bufferId, const native_handle_t **handle);
 
+    /**
+     * Hints the buffer pool to pre-populate its free list with {@code count}
+     * buffers matching {@code params}. Allocation happens asynchronously on
+     * the pool's prefetcher thread, so subsequent allocate() calls with
+     * compatible parameters recycle the prefetched buffers instead of paying
+     * allocation latency.
+     *
+     * @param params    allocation parameters of the expected buffers.
+     * @param count     expected number of buffers.
+     *
+     * @return OK when the hint is queued to the buffer pool.
+     *         CRITICAL_ERROR otherwise.
+     */
+    BufferPoolStatus prefetch(const std::vector<uint8_t> &params, uint32_t count);
+
     /**
      * Processes pending buffer status messages and performs periodic cache cleaning
      * from bufferpool.
@@ -19,6 +19,7 @@
 #include <aidl/android/hardware/media/bufferpool2/BufferStatusMessage.h>
 #include <bufferpool2/BufferPoolTypes.h>
 
+#include <list>
 #include <map>
 #include <set>
 
@@ -94,6 +95,89 @@ struct InternalBuffer {
     }
 };
 
+// Free buffer bookkeeping data structure for internal BufferPool use.
+// Free buffers are kept in LRU order for eviction and are also grouped by
+// allocation config, so a recycle request probes at most one buffer per
+// distinct config instead of every free buffer.
+struct FreeBufferTracker {
+    // Least recently freed buffers first. Eviction proceeds from the front.
+    std::list<BufferId> mLru;
+    // Free buffers grouped by allocation config, most recently freed last.
+    std::map<std::vector<uint8_t>, std::list<BufferId>> mBuckets;
+
+    struct Entry {
+        std::list<BufferId>::iterator mLruIt;
+        std::map<std::vector<uint8_t>, std::list<BufferId>>::iterator mBucketIt;
+        std::list<BufferId>::iterator mBucketPosIt;
+    };
+    std::map<BufferId, Entry> mEntries;
+
+    size_t size() const {
+        return mEntries.size();
+    }
+
+    void insert(BufferId bufferId, const std::vector<uint8_t> &config) {
+        auto lruIt = mLru.insert(mLru.end(), bufferId);
+        auto bucketIt = mBuckets.emplace(config, std::list<BufferId>()).first;
+        auto bucketPosIt = bucketIt->second.insert(bucketIt->second.end(), bufferId);
+        mEntries.emplace(bufferId, Entry{lruIt, bucketIt, bucketPosIt});
+    }
+
+    bool erase(BufferId bufferId) {
+        auto iter = mEntries.find(bufferId);
+        if (iter == mEntries.end()) {
+            return false;
+        }
+        mLru.erase(iter->second.mLruIt);
+        iter->second.mBucketIt->second.erase(iter->second.mBucketPosIt);
+        if (iter->second.mBucketIt->second.empty()) {
+            mBuckets.erase(iter->second.mBucketIt);
+        }
+        mEntries.erase(iter);
+        return true;
+    }
+
+    /** # of free buffers whose allocation config matches exactly. */
+    size_t countFor(const std::vector<uint8_t> &config) const {
+        auto iter = mBuckets.find(config);
+        return iter == mBuckets.end() ? 0 : iter->second.size();
+    }
+
+    /**
+     * Finds a free buffer compatible with the allocation parameters. The
+     * bucket matching the parameters exactly is probed first; other buckets
+     * are probed once each, since buffers in a bucket share their config.
+     * The matched buffer stays in the tracker. {@code *scanned} is set to
+     * the number of configs probed.
+     *
+     * @return {@code true} when a compatible free buffer is found,
+     *         {@code false} otherwise.
+     */
+    bool pick(const std::shared_ptr<BufferPoolAllocator> &allocator,
+              const std::vector<uint8_t> &params, BufferId *pId, size_t *scanned) {
+        *scanned = 0;
+        auto exactIt = mBuckets.find(params);
+        if (exactIt != mBuckets.end()) {
+            ++*scanned;
+            if (allocator->compatible(params, exactIt->first)) {
+                *pId = exactIt->second.back();
+                return true;
+            }
+        }
+        for (auto bucketIt = mBuckets.begin(); bucketIt != mBuckets.end(); ++bucketIt) {
+            if (bucketIt == exactIt) {
+                continue;
+            }
+            ++*scanned;
+            if (allocator->compatible(params, bucketIt->first)) {
+                *pId = bucketIt->second.back();
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
 // Buffer transacion status/message data structure for internal BufferPool use.
 struct TransactionStatus {
     TransactionId mId;
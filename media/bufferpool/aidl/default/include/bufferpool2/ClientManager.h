@@ -115,6 +115,26 @@ struct ClientManager : public BnClientManager {
                           native_handle_t **handle,
                           std::shared_ptr<BufferPoolData> *buffer);
 
+    /**
+     * Hints the specified connection's buffer pool about upcoming allocation
+     * demand. The pool pre-populates its free list asynchronously with
+     * {@code count} buffers matching {@code params}, so a codec component
+     * expecting an allocation burst (e.g. the next GOP) can hide allocation
+     * latency by hinting the expected buffer size/count ahead of time. Only
+     * supported on local connections.
+     *
+     * @param connectionId  The id of the connection.
+     * @param params        The allocation parameters of the expected buffers.
+     * @param count         The expected number of buffers.
+     *
+     * @return OK when the hint was queued to the buffer pool.
+     *         NOT_FOUND when the specified connection was not found.
+     *         CRITICAL_ERROR otherwise.
+     */
+    BufferPoolStatus prefetch(ConnectionId connectionId,
+                          const std::vector<uint8_t> &params,
+                          uint32_t count);
+
     /**
      * Receives a buffer for the transaction. The output parameter handle is
      * cloned from the internal handle. So it is safe to use directly, and it
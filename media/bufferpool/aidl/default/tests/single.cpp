@@ -136,6 +136,30 @@ TEST_F(BufferpoolSingleTest, RecycleBuffer) {
   EXPECT_TRUE(kNumRecycleTest > 1);
 }
 
+// Buffer prefetch test.
+// Check whether an allocation prefetch hint is accepted on a local
+// connection and rejected for an unknown connection, and that allocation
+// keeps working while the free list is being pre-populated.
+TEST_F(BufferpoolSingleTest, PrefetchBuffer) {
+  BufferPoolStatus status;
+  std::vector<uint8_t> vecParams;
+  getTestAllocatorParams(&vecParams);
+
+  status = mManager->prefetch(mConnectionId, vecParams, kNumAllocationTest);
+  ASSERT_TRUE(status == ResultStatus::OK);
+  status = mManager->prefetch(mConnectionId + 1, vecParams, kNumAllocationTest);
+  ASSERT_TRUE(status == ResultStatus::NOT_FOUND);
+
+  std::shared_ptr<BufferPoolData> buffer;
+  native_handle_t *allocHandle = nullptr;
+  status = mManager->allocate(mConnectionId, vecParams, &allocHandle, &buffer);
+  ASSERT_TRUE(status == ResultStatus::OK);
+  if (allocHandle) {
+    native_handle_close(allocHandle);
+    native_handle_delete(allocHandle);
+  }
+}
+
 // Buffer transfer test.
 // Check whether buffer is transferred to another client successfully.
 TEST_F(BufferpoolSingleTest, TransferBuffer) {
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "media_omx_hidl_replay_harness"
+#ifdef __LP64__
+#define OMX_ANDROID_COMPILE_AS_32BIT_ON_64BIT_PLATFORMS
+#endif
+
+#include <android-base/logging.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include <media_replay_harness.h>
+
+ReplayStream::~ReplayStream() {
+    if (mMappedData != nullptr) {
+        munmap(const_cast<char*>(mMappedData), mMappedSize);
+    }
+}
+
+bool ReplayStream::open(const char* url, const char* info) {
+    std::ifstream eleInfo;
+    eleInfo.open(info);
+    if (!eleInfo.is_open()) return false;
+    int bytesCount = 0;
+    uint32_t flags = 0;
+    uint32_t timestamp = 0;
+    size_t totalBytes = 0;
+    while (1) {
+        if (!(eleInfo >> bytesCount)) break;
+        eleInfo >> flags;
+        eleInfo >> timestamp;
+        mInfo.push_back({bytesCount, flags, timestamp});
+        mFrameOffsets.push_back(totalBytes);
+        totalBytes += bytesCount;
+        if (mMaxFrameBytes < bytesCount) mMaxFrameBytes = bytesCount;
+    }
+    eleInfo.close();
+    if (mInfo.size() == 0) return false;
+
+    int fd = ::open(url, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 ||
+        static_cast<size_t>(fileStat.st_size) < totalBytes) {
+        close(fd);
+        return false;
+    }
+    mMappedSize = fileStat.st_size;
+    void* mapped = mmap(nullptr, mMappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        mMappedSize = 0;
+        return false;
+    }
+    mMappedData = static_cast<const char*>(mapped);
+    return true;
+}
+
+const char* ReplayStream::frameData(size_t frameID) const {
+    return mMappedData + mFrameOffsets[frameID];
+}
+
+void DecodeLatencyRecorder::onInputDispatched(uint64_t timestampUs) {
+    mInFlightUs[timestampUs] = android::ALooper::GetNowUs();
+}
+
+void DecodeLatencyRecorder::onOutputReceived(uint64_t timestampUs) {
+    std::map<uint64_t, int64_t>::iterator it = mInFlightUs.find(timestampUs);
+    // Outputs the harness did not dispatch itself (or duplicates) are ignored.
+    if (it == mInFlightUs.end()) return;
+    mLatenciesUs.push_back(android::ALooper::GetNowUs() - it->second);
+    mInFlightUs.erase(it);
+}
+
+int64_t DecodeLatencyRecorder::percentileUs(int percentile) const {
+    if (mLatenciesUs.empty()) return 0;
+    std::vector<int64_t> sorted = mLatenciesUs;
+    std::sort(sorted.begin(), sorted.end());
+    size_t rank = (percentile * sorted.size() + 99) / 100;
+    if (rank == 0) rank = 1;
+    return sorted[rank - 1];
+}
+
+void DecodeLatencyRecorder::reset() {
+    mInFlightUs.clear();
+    mLatenciesUs.clear();
+}
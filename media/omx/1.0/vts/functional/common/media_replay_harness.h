@@ -0,0 +1,86 @@
+/*
+ * Copyright 2017, The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MEDIA_REPLAY_HARNESS_H
+#define MEDIA_REPLAY_HARNESS_H
+
+#include <media_hidl_test_common.h>
+
+#include <map>
+#include <vector>
+
+/*
+ * Replay support for the codec tests. ReplayStream maps an elementary stream
+ * into memory once, so injecting a frame into a component buffer is a single
+ * copy from the mapping into the component's shared memory grant instead of a
+ * file read per buffer. DecodeLatencyRecorder pairs input dispatch with output
+ * delivery by presentation timestamp and reports latency percentiles, letting
+ * the functional tests double as a codec performance regression suite.
+ */
+
+class ReplayStream {
+   public:
+    ReplayStream() = default;
+    ~ReplayStream();
+
+    // Maps the elementary stream at url and parses the companion info file
+    // (bytesCount, flags, timestamp per frame). Returns false if either file
+    // cannot be read or the info file describes more data than the stream
+    // holds.
+    bool open(const char* url, const char* info);
+
+    size_t frameCount() const { return mInfo.size(); }
+    const FrameData& frame(size_t frameID) const { return mInfo[frameID]; }
+    const android::Vector<FrameData>& frameInfo() const { return mInfo; }
+    int maxFrameBytes() const { return mMaxFrameBytes; }
+
+    // Pointer to the frame's payload inside the mapping; valid for the
+    // lifetime of this object.
+    const char* frameData(size_t frameID) const;
+
+   private:
+    android::Vector<FrameData> mInfo;
+    std::vector<size_t> mFrameOffsets;
+    const char* mMappedData = nullptr;
+    size_t mMappedSize = 0;
+    int mMaxFrameBytes = 0;
+};
+
+class DecodeLatencyRecorder {
+   public:
+    // Call just before an input buffer with the given presentation timestamp
+    // is dispatched to the component. Codec config buffers produce no output
+    // and must not be recorded.
+    void onInputDispatched(uint64_t timestampUs);
+
+    // Call when output with the given presentation timestamp is delivered;
+    // records the dispatch-to-delivery latency of that frame.
+    void onOutputReceived(uint64_t timestampUs);
+
+    size_t framesMeasured() const { return mLatenciesUs.size(); }
+
+    // Nearest-rank percentile over the measured frames, percentile in
+    // (0, 100]. Returns 0 when nothing has been measured.
+    int64_t percentileUs(int percentile) const;
+
+    void reset();
+
+   private:
+    std::map<uint64_t, int64_t> mInFlightUs;
+    std::vector<int64_t> mLatenciesUs;
+};
+
+#endif  // MEDIA_REPLAY_HARNESS_H
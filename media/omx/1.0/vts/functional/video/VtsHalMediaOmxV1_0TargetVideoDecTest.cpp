@@ -48,6 +48,7 @@ using ::android::sp;
 
 #include <getopt.h>
 #include <media/hardware/HardwareAPI.h>
+#include <media_replay_harness.h>
 #include <media_video_hidl_test_common.h>
 #include <fstream>
 
@@ -144,6 +145,7 @@ class VideoDecHidlTest
         timestampDevTest = false;
         isSecure = false;
         portSettingsChange = false;
+        latencyRecorder = nullptr;
         size_t suffixLen = strlen(".secure");
         if (component_.rfind(".secure") == component_.length() - suffixLen) {
             isSecure = true;
@@ -183,6 +185,9 @@ class VideoDecHidlTest
             }
             if (msg.data.extendedBufferData.rangeLength != 0) {
                 framesReceived += 1;
+                if (latencyRecorder)
+                    latencyRecorder->onOutputReceived(
+                        msg.data.extendedBufferData.timestampUs);
                 // For decoder components current timestamp always exceeds
                 // previous timestamp
                 EXPECT_GE(msg.data.extendedBufferData.timestampUs, timestampUs);
@@ -268,6 +273,7 @@ class VideoDecHidlTest
     bool timestampDevTest;
     bool isSecure;
     bool portSettingsChange;
+    DecodeLatencyRecorder* latencyRecorder;
 
    protected:
     static void description(const std::string& description) {
@@ -606,6 +612,85 @@ void decodeNFrames(sp<IOmxNode> omxNode, sp<CodecObserver> observer,
     }
 }
 
+// Decode N Frames from a mapped replay stream, recording per-frame decode
+// latency. Mirrors decodeNFrames(), but each input payload is copied straight
+// from the stream mapping into the component's shared memory grant instead of
+// being read from a file per buffer.
+void replayNFrames(sp<IOmxNode> omxNode, sp<CodecObserver> observer,
+                   android::Vector<BufferInfo>* iBuffer,
+                   android::Vector<BufferInfo>* oBuffer,
+                   OMX_U32 kPortIndexInput, OMX_U32 kPortIndexOutput,
+                   ReplayStream& replayStream, DecodeLatencyRecorder* recorder,
+                   int offset, int range, PortMode oPortMode,
+                   bool signalEOS = true) {
+    android::hardware::media::omx::V1_0::Status status;
+    Message msg;
+    size_t index;
+    uint32_t flags = 0;
+    int frameID = offset;
+    int timeOut = TIMEOUT_COUNTER_Q;
+    bool iQueued, oQueued;
+
+    while (1) {
+        iQueued = oQueued = false;
+        status =
+            observer->dequeueMessage(&msg, DEFAULT_TIMEOUT_Q, iBuffer, oBuffer);
+        // Port Reconfiguration
+        if (status == android::hardware::media::omx::V1_0::Status::OK &&
+            msg.type == Message::Type::EVENT) {
+            ASSERT_NO_FATAL_FAILURE(portReconfiguration(
+                omxNode, observer, iBuffer, oBuffer, kPortIndexInput,
+                kPortIndexOutput, msg, oPortMode, nullptr));
+        }
+
+        if (frameID == (int)replayStream.frameCount() ||
+            frameID == (offset + range))
+            break;
+
+        // Dispatch input buffer
+        if ((index = getEmptyBufferID(iBuffer)) < iBuffer->size()) {
+            const FrameData& frame = replayStream.frame(frameID);
+            char* ipBuffer = static_cast<char*>(
+                static_cast<void*>((*iBuffer)[index].mMemory->getPointer()));
+            ASSERT_LE(frame.bytesCount,
+                      static_cast<int>((*iBuffer)[index].mMemory->getSize()));
+            memcpy(ipBuffer, replayStream.frameData(frameID),
+                   frame.bytesCount);
+            flags = frame.flags;
+            // Indicate to omx core that the buffer contains a full frame worth
+            // of data
+            flags |= OMX_BUFFERFLAG_ENDOFFRAME;
+            // Indicate the omx core that this is the last buffer it needs to
+            // process
+            if (signalEOS && ((frameID == (int)replayStream.frameCount() - 1) ||
+                              (frameID == (offset + range - 1))))
+                flags |= OMX_BUFFERFLAG_EOS;
+            // Codec config buffers produce no output; do not time them
+            if (recorder && !(frame.flags & OMX_BUFFERFLAG_CODECCONFIG))
+                recorder->onInputDispatched(frame.timestamp);
+            ASSERT_NO_FATAL_FAILURE(dispatchInputBuffer(
+                omxNode, iBuffer, index, frame.bytesCount, flags,
+                frame.timestamp));
+            frameID++;
+            iQueued = true;
+        }
+        // Dispatch output buffer
+        if ((index = getEmptyBufferID(oBuffer)) < oBuffer->size()) {
+            ASSERT_NO_FATAL_FAILURE(
+                dispatchOutputBuffer(omxNode, oBuffer, index, oPortMode));
+            oQueued = true;
+        }
+        // Reset Counters when either input or output buffer is dispatched
+        if (iQueued || oQueued)
+            timeOut = TIMEOUT_COUNTER_Q;
+        else
+            timeOut--;
+        if (timeOut == 0) {
+            ASSERT_TRUE(false) << "Wait on Input/Output is found indefinite";
+        }
+    }
+}
+
 // DescribeColorFormatParams Copy Constructor (Borrowed from OMXUtils.cpp)
 android::DescribeColorFormatParams::DescribeColorFormatParams(
     const android::DescribeColorFormat2Params& params) {
@@ -859,6 +944,109 @@ TEST_P(VideoDecHidlTest, DecodeTest) {
                                                     true));
 }
 
+// decode elementary stream from a memory mapping and report per-frame decode
+// latency percentiles
+TEST_P(VideoDecHidlTest, DecodeLatencyTest) {
+    description("Tests decode latency percentiles over a mapped replay stream");
+    if (disableTest) return;
+    android::hardware::media::omx::V1_0::Status status;
+    uint32_t kPortIndexInput = 0, kPortIndexOutput = 1;
+    status = setRole(omxNode, role_);
+    ASSERT_EQ(status, ::android::hardware::media::omx::V1_0::Status::OK);
+    OMX_PORT_PARAM_TYPE params;
+    status = getParam(omxNode, OMX_IndexParamVideoInit, &params);
+    if (status == ::android::hardware::media::omx::V1_0::Status::OK) {
+        ASSERT_EQ(params.nPorts, 2U);
+        kPortIndexInput = params.nStartPortNumber;
+        kPortIndexOutput = kPortIndexInput + 1;
+    }
+    char mURL[512], info[512];
+    strcpy(mURL, sResourceDir.c_str());
+    strcpy(info, sResourceDir.c_str());
+    GetURLForComponent(compName, mURL, info);
+
+    ReplayStream replayStream;
+    ASSERT_EQ(replayStream.open(mURL, info), true);
+
+    // As the frame sizes are known ahead, use it to configure i/p buffer size
+    int maxBytesCount =
+        ALIGN_POWER_OF_TWO(replayStream.maxFrameBytes(), 10);
+    status = setPortBufferSize(omxNode, kPortIndexInput, maxBytesCount);
+    ASSERT_EQ(status, ::android::hardware::media::omx::V1_0::Status::OK);
+
+    // set port mode
+    portMode[0] = PortMode::PRESET_BYTE_BUFFER;
+    portMode[1] = PortMode::DYNAMIC_ANW_BUFFER;
+    status = omxNode->setPortMode(kPortIndexInput, portMode[0]);
+    ASSERT_EQ(status, ::android::hardware::media::omx::V1_0::Status::OK);
+    status = omxNode->setPortMode(kPortIndexOutput, portMode[1]);
+    if (status != ::android::hardware::media::omx::V1_0::Status::OK) {
+        portMode[1] = PortMode::PRESET_BYTE_BUFFER;
+        status = omxNode->setPortMode(kPortIndexOutput, portMode[1]);
+        ASSERT_EQ(status, ::android::hardware::media::omx::V1_0::Status::OK);
+    }
+
+    // set Port Params
+    uint32_t nFrameWidth, nFrameHeight, xFramerate;
+    getInputChannelInfo(omxNode, kPortIndexInput, &nFrameWidth, &nFrameHeight,
+                        &xFramerate);
+    // get default color format
+    OMX_COLOR_FORMATTYPE eColorFormat = OMX_COLOR_FormatUnused;
+    getDefaultColorFormat(omxNode, kPortIndexOutput, portMode[1],
+                          &eColorFormat);
+    ASSERT_NE(eColorFormat, OMX_COLOR_FormatUnused);
+    status =
+        setVideoPortFormat(omxNode, kPortIndexOutput, OMX_VIDEO_CodingUnused,
+                           eColorFormat, xFramerate);
+    EXPECT_EQ(status, ::android::hardware::media::omx::V1_0::Status::OK);
+    setDefaultPortParam(omxNode, kPortIndexOutput, OMX_VIDEO_CodingUnused,
+                        eColorFormat, nFrameWidth, nFrameHeight, 0, xFramerate);
+
+    android::Vector<BufferInfo> iBuffer, oBuffer;
+
+    DecodeLatencyRecorder recorder;
+    latencyRecorder = &recorder;
+
+    // set state to idle
+    ASSERT_NO_FATAL_FAILURE(changeStateLoadedtoIdle(
+        omxNode, observer, &iBuffer, &oBuffer, kPortIndexInput,
+        kPortIndexOutput, portMode, true));
+    // set state to executing
+    ASSERT_NO_FATAL_FAILURE(changeStateIdletoExecute(omxNode, observer));
+
+    ASSERT_NO_FATAL_FAILURE(replayNFrames(
+        omxNode, observer, &iBuffer, &oBuffer, kPortIndexInput,
+        kPortIndexOutput, replayStream, &recorder, 0,
+        (int)replayStream.frameCount(), portMode[1]));
+    ASSERT_NO_FATAL_FAILURE(
+        waitOnInputConsumption(omxNode, observer, &iBuffer, &oBuffer,
+                               kPortIndexInput, kPortIndexOutput, portMode[1]));
+    ASSERT_NO_FATAL_FAILURE(testEOS(
+        omxNode, observer, &iBuffer, &oBuffer, false, eosFlag, portMode,
+        portReconfiguration, kPortIndexInput, kPortIndexOutput, nullptr));
+    latencyRecorder = nullptr;
+
+    EXPECT_NE(recorder.framesMeasured(), 0U);
+    int64_t p50 = recorder.percentileUs(50);
+    int64_t p90 = recorder.percentileUs(90);
+    int64_t p99 = recorder.percentileUs(99);
+    std::cout << "[   INFO   ] decode latency over "
+              << recorder.framesMeasured() << " frames: p50 " << p50
+              << " us, p90 " << p90 << " us, p99 " << p99 << " us \n";
+    RecordProperty("decode_latency_frames", (int)recorder.framesMeasured());
+    RecordProperty("decode_latency_p50_us", (int)p50);
+    RecordProperty("decode_latency_p90_us", (int)p90);
+    RecordProperty("decode_latency_p99_us", (int)p99);
+
+    // set state to idle
+    ASSERT_NO_FATAL_FAILURE(
+        changeStateExecutetoIdle(omxNode, observer, &iBuffer, &oBuffer));
+    // set state to executing
+    ASSERT_NO_FATAL_FAILURE(changeStateIdletoLoaded(omxNode, observer, &iBuffer, &oBuffer,
+                                                    kPortIndexInput, kPortIndexOutput, portMode,
+                                                    true));
+}
+
 // Test for adaptive playback support
 TEST_P(VideoDecHidlTest, AdaptivePlaybackTest) {
     description("Tests for Adaptive Playback support");
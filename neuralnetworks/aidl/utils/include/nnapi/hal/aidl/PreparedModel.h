@@ -19,12 +19,14 @@
 
 #include <aidl/android/hardware/neuralnetworks/IPreparedModel.h>
 #include <aidl/android/hardware/neuralnetworks/Request.h>
+#include <android-base/thread_annotations.h>
 #include <nnapi/IPreparedModel.h>
 #include <nnapi/Result.h>
 #include <nnapi/Types.h>
 #include <nnapi/hal/CommonUtils.h>
 
 #include <memory>
+#include <mutex>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -88,8 +90,25 @@ class PreparedModel final : public nn::IPreparedModel,
                           const hal::utils::RequestRelocation& relocation) const;
 
   private:
+    // A pointer-based request converted for IPC once and reused while the caller keeps issuing
+    // the same request: the shared-memory arena, its relocation trackers, and the converted
+    // AIDL request. The entry is checked out of the cache for the duration of one execution so
+    // concurrent identical requests never share an arena.
+    struct CachedRequest {
+        nn::Request requestKey;
+        Request aidlRequest;
+        hal::utils::RequestRelocation relocation;
+    };
+
+    // Takes exclusive ownership of the cached entry if it matches `request`, or returns
+    // nullptr on a miss (or when another execution currently holds the entry).
+    std::shared_ptr<CachedRequest> acquireCachedRequest(const nn::Request& request) const;
+    void cacheRequest(std::shared_ptr<CachedRequest> entry) const;
+
     const std::shared_ptr<aidl_hal::IPreparedModel> kPreparedModel;
     const nn::Version kFeatureLevel;
+    mutable std::mutex mMutex;
+    mutable std::shared_ptr<CachedRequest> mCachedRequest GUARDED_BY(mMutex);
 };
 
 }  // namespace aidl::android::hardware::neuralnetworks::utils
@@ -25,6 +25,7 @@
 #include <nnapi/TypeUtils.h>
 #include <nnapi/Types.h>
 #include <nnapi/Validation.h>
+#include <nnapi/hal/CommonUtils.h>
 
 #include <type_traits>
 
@@ -76,6 +77,17 @@ nn::Result<void> compliantVersion(const Type& canonical) {
     return {};
 }
 
+// Overload for whole models: routes through the memoizing validator so a model this process
+// has already validated costs a structural hash instead of a full graph walk.
+inline nn::Result<void> compliantVersion(const nn::Model& canonical) {
+    const auto version =
+            NN_TRY(::android::hardware::neuralnetworks::utils::validateModelMemoized(canonical));
+    if (!nn::isCompliantVersion(version, kVersion)) {
+        return NN_ERROR() << "Insufficient version: " << version << " vs required " << kVersion;
+    }
+    return {};
+}
+
 template <typename Type>
 auto convertFromNonCanonical(const Type& nonCanonicalObject)
         -> decltype(convert(nn::convert(nonCanonicalObject).value())) {
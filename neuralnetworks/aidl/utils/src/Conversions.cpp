@@ -807,9 +807,10 @@ nn::GeneralResult<UnvalidatedConvertOutput<Type>> validatedConvert(const Type& c
 template <typename Type>
 nn::GeneralResult<std::vector<UnvalidatedConvertOutput<Type>>> validatedConvert(
         const std::vector<Type>& arguments) {
-    std::vector<UnvalidatedConvertOutput<Type>> halObject(arguments.size());
-    for (size_t i = 0; i < arguments.size(); ++i) {
-        halObject[i] = NN_TRY(validatedConvert(arguments[i]));
+    std::vector<UnvalidatedConvertOutput<Type>> halObject;
+    halObject.reserve(arguments.size());
+    for (const auto& argument : arguments) {
+        halObject.push_back(NN_TRY(validatedConvert(argument)));
     }
     return halObject;
 }
@@ -900,6 +901,10 @@ nn::GeneralResult<OperandType> unvalidatedConvert(const nn::OperandType& operand
 
 nn::GeneralResult<OperandLifeTime> unvalidatedConvert(
         const nn::Operand::LifeTime& operandLifeTime) {
+    if (operandLifeTime == nn::Operand::LifeTime::POINTER) {
+        return NN_ERROR(nn::ErrorStatus::INVALID_ARGUMENT)
+               << "Model cannot be unvalidatedConverted because it contains pointer-based memory";
+    }
     return static_cast<OperandLifeTime>(operandLifeTime);
 }
 
@@ -1011,11 +1016,9 @@ nn::GeneralResult<ExtensionNameAndPrefix> unvalidatedConvert(
 }
 
 nn::GeneralResult<Model> unvalidatedConvert(const nn::Model& model) {
-    if (!hal::utils::hasNoPointerData(model)) {
-        return NN_ERROR(nn::ErrorStatus::INVALID_ARGUMENT)
-               << "Model cannot be unvalidatedConverted because it contains pointer-based memory";
-    }
-
+    // Pointer-based memory is detected while the operands themselves are converted (see the
+    // nn::Operand::LifeTime conversion above) rather than through an extra
+    // hal::utils::hasNoPointerData traversal of every subgraph up front.
     auto main = NN_TRY(unvalidatedConvert(model.main));
     auto referenced = NN_TRY(unvalidatedConvert(model.referenced));
     auto operandValues = NN_TRY(unvalidatedConvert(model.operandValues));
@@ -1036,11 +1039,8 @@ nn::GeneralResult<Priority> unvalidatedConvert(const nn::Priority& priority) {
 }
 
 nn::GeneralResult<Request> unvalidatedConvert(const nn::Request& request) {
-    if (!hal::utils::hasNoPointerData(request)) {
-        return NN_ERROR(nn::ErrorStatus::INVALID_ARGUMENT)
-               << "Request cannot be unvalidatedConverted because it contains pointer-based memory";
-    }
-
+    // Pointer-based arguments are rejected by the nn::Request::Argument conversion below, so
+    // no extra hal::utils::hasNoPointerData pass over the request is needed here.
     auto inputs = NN_TRY(unvalidatedConvert(request.inputs));
     auto outputs = NN_TRY(unvalidatedConvert(request.outputs));
     auto pools = NN_TRY(unvalidatedConvert(request.pools));
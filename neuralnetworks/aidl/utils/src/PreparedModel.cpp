@@ -42,6 +42,35 @@
 namespace aidl::android::hardware::neuralnetworks::utils {
 namespace {
 
+// The canonical request types do not define equality operators, so the cache key comparison
+// is spelled out field by field. Two requests compare equal when every argument (lifetime,
+// location including the raw pointer, and dimensions) and every memory pool match; equal keys
+// guarantee the cached arena's relocation trackers still read from and write to the right
+// caller buffers.
+bool sameDataLocation(const nn::DataLocation& a, const nn::DataLocation& b) {
+    return a.pointer == b.pointer && a.poolIndex == b.poolIndex && a.offset == b.offset &&
+           a.length == b.length && a.padding == b.padding;
+}
+
+bool sameArguments(const std::vector<nn::Request::Argument>& a,
+                   const std::vector<nn::Request::Argument>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].lifetime != b[i].lifetime || !sameDataLocation(a[i].location, b[i].location) ||
+            a[i].dimensions != b[i].dimensions) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameRequest(const nn::Request& a, const nn::Request& b) {
+    return sameArguments(a.inputs, b.inputs) && sameArguments(a.outputs, b.outputs) &&
+           a.pools == b.pools;
+}
+
 nn::GeneralResult<std::pair<std::vector<nn::OutputShape>, nn::Timing>> convertExecutionResults(
         const std::vector<OutputShape>& outputShapes, const Timing& timing) {
     return std::make_pair(NN_TRY(nn::convert(outputShapes)), NN_TRY(nn::convert(timing)));
@@ -131,6 +160,21 @@ nn::ExecutionResult<std::pair<std::vector<nn::OutputShape>, nn::Timing>> Prepare
         const nn::OptionalTimePoint& deadline, const nn::OptionalDuration& loopTimeoutDuration,
         const std::vector<nn::TokenValuePair>& hints,
         const std::vector<nn::ExtensionNameAndPrefix>& extensionNameToPrefix) const {
+    const auto aidlMeasure = NN_TRY(convert(measure));
+    const auto aidlDeadline = NN_TRY(convert(deadline));
+    const auto aidlLoopTimeoutDuration = NN_TRY(convert(loopTimeoutDuration));
+
+    // Reuse the shared-memory arena prepared for the previous execution when the caller
+    // issues the same pointer-based request again; executeInternal then only re-flushes the
+    // argument bytes instead of allocating, mapping, and converting a fresh region.
+    if (auto cached = acquireCachedRequest(request)) {
+        auto result = executeInternal(cached->aidlRequest, aidlMeasure, aidlDeadline,
+                                      aidlLoopTimeoutDuration, hints, extensionNameToPrefix,
+                                      cached->relocation);
+        cacheRequest(std::move(cached));
+        return result;
+    }
+
     // Ensure that request is ready for IPC.
     std::optional<nn::Request> maybeRequestInShared;
     hal::utils::RequestRelocation relocation;
@@ -138,12 +182,30 @@ nn::ExecutionResult<std::pair<std::vector<nn::OutputShape>, nn::Timing>> Prepare
             &request, nn::kDefaultRequestMemoryAlignment, nn::kDefaultRequestMemoryPadding,
             &maybeRequestInShared, &relocation));
 
-    const auto aidlRequest = NN_TRY(convert(requestInShared));
-    const auto aidlMeasure = NN_TRY(convert(measure));
-    const auto aidlDeadline = NN_TRY(convert(deadline));
-    const auto aidlLoopTimeoutDuration = NN_TRY(convert(loopTimeoutDuration));
-    return executeInternal(aidlRequest, aidlMeasure, aidlDeadline, aidlLoopTimeoutDuration, hints,
-                           extensionNameToPrefix, relocation);
+    auto aidlRequest = NN_TRY(convert(requestInShared));
+    auto result = executeInternal(aidlRequest, aidlMeasure, aidlDeadline, aidlLoopTimeoutDuration,
+                                  hints, extensionNameToPrefix, relocation);
+    if (maybeRequestInShared.has_value()) {
+        // The request had pointer-based arguments; remember the arena for the next execution.
+        cacheRequest(std::make_shared<CachedRequest>(
+                CachedRequest{request, std::move(aidlRequest), std::move(relocation)}));
+    }
+    return result;
+}
+
+std::shared_ptr<PreparedModel::CachedRequest> PreparedModel::acquireCachedRequest(
+        const nn::Request& request) const {
+    std::lock_guard guard(mMutex);
+    if (mCachedRequest == nullptr || !sameRequest(mCachedRequest->requestKey, request)) {
+        return nullptr;
+    }
+    // Check the entry out of the cache so no concurrent execution can share the arena.
+    return std::move(mCachedRequest);
+}
+
+void PreparedModel::cacheRequest(std::shared_ptr<CachedRequest> entry) const {
+    std::lock_guard guard(mMutex);
+    mCachedRequest = std::move(entry);
 }
 
 nn::ExecutionResult<std::pair<std::vector<nn::OutputShape>, nn::Timing>>
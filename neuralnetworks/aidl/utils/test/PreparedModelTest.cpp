@@ -120,6 +120,42 @@ TEST_P(PreparedModelTest, executeSync) {
             << "Failed with " << result.error().code << ": " << result.error().message;
 }
 
+TEST_P(PreparedModelTest, executeSyncReusesPointerArena) {
+    if (kVersion.level >= nn::Version::Level::FEATURE_LEVEL_8) return;
+
+    // setup call
+    const auto mockPreparedModel = MockPreparedModel::create();
+    const auto preparedModel = PreparedModel::create(mockPreparedModel, kVersion).value();
+    const auto mockExecutionResult = ExecutionResult{
+            .outputSufficientSize = true,
+            .outputShapes = {},
+            .timing = kNoTiming,
+    };
+    EXPECT_CALL(*mockPreparedModel, executeSynchronously(_, _, _, _, _))
+            .Times(2)
+            .WillRepeatedly(
+                    DoAll(SetArgPointee<4>(mockExecutionResult), InvokeWithoutArgs(makeStatusOk)));
+
+    const float inputData = 0.0f;
+    nn::Request request = {};
+    request.inputs.push_back(nn::Request::Argument{
+            .lifetime = nn::Request::Argument::LifeTime::POINTER,
+            .location = {.pointer = static_cast<const void*>(&inputData),
+                         .length = sizeof(inputData)},
+            .dimensions = {1}});
+
+    // run test -- the second execution passes the identical pointer-based request, which is
+    // served from the cached shared-memory arena rather than a fresh conversion.
+    const auto result1 = preparedModel->execute(request, {}, {}, {}, {}, {});
+    const auto result2 = preparedModel->execute(request, {}, {}, {}, {}, {});
+
+    // verify result
+    EXPECT_TRUE(result1.has_value())
+            << "Failed with " << result1.error().code << ": " << result1.error().message;
+    EXPECT_TRUE(result2.has_value())
+            << "Failed with " << result2.error().code << ": " << result2.error().message;
+}
+
 TEST_P(PreparedModelTest, executeSyncError) {
     if (kVersion.level >= nn::Version::Level::FEATURE_LEVEL_8) return;
 
@@ -27,6 +27,8 @@
 #include <iostream>
 #include <iterator>
 #include <numeric>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <android/binder_status.h>
@@ -55,6 +57,24 @@ namespace {
 
 enum class OutputType { FULLY_SPECIFIED, UNSPECIFIED, INSUFFICIENT, MISSED_DEADLINE };
 
+// Logs the wall-clock duration of one generated test on destruction, so a full suite run
+// doubles as a coarse per-model driver latency log (grep the logs for "NN VTS perf").
+class TestLatencyLogger {
+  public:
+    explicit TestLatencyLogger(std::string name) : kName(std::move(name)) {}
+    ~TestLatencyLogger() {
+        const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - kStartTime);
+        LOG(INFO) << "NN VTS perf: " << kName << " took " << duration.count() << " ms";
+        std::cout << "[          ] NN VTS perf: " << kName << " took " << duration.count() << " ms"
+                  << std::endl;
+    }
+
+  private:
+    const std::string kName;
+    const std::chrono::steady_clock::time_point kStartTime = std::chrono::steady_clock::now();
+};
+
 struct TestConfig {
     Executor executor;
     bool measureTiming;
@@ -984,6 +1004,9 @@ void EvaluatePreparedCoupledModels(const std::shared_ptr<IDevice>& device,
 
 void Execute(const std::shared_ptr<IDevice>& device, const TestModel& testModel,
              TestKind testKind) {
+    const auto* const testInfo = testing::UnitTest::GetInstance()->current_test_info();
+    const TestLatencyLogger latencyLogger(testInfo != nullptr ? testInfo->name() : "unknown");
+
     Model model = createModel(testModel);
     if (testKind == TestKind::DYNAMIC_SHAPE) {
         makeOutputDimensionsUnspecified(&model);
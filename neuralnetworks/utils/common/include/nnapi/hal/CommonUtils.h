@@ -48,6 +48,15 @@ nn::Capabilities::OperandPerformanceTable makeQuantized8PerformanceConsistentWit
         const nn::Capabilities::PerformanceInfo& float32Performance,
         const nn::Capabilities::PerformanceInfo& quantized8Performance);
 
+// Validates a canonical model and returns the minimum version required to support it, like
+// nn::validate, but memoizes successful results keyed by a structural hash over the operand
+// and operation tables, constant operand values, pool sizes and memory kinds, and
+// extensions. Re-validating a
+// model this process has already validated costs a hash of the model data instead of a full
+// graph walk. The cache is deliberately process-local: a validation verdict persisted outside
+// the process could be forged by whoever wrote it, which would defeat validating at all.
+nn::Result<nn::Version> validateModelMemoized(const nn::Model& model);
+
 using nn::convertRequestFromPointerToShared;
 using nn::flushDataFromPointerToShared;
 using nn::hasNoPointerData;
@@ -27,6 +27,7 @@
 #include <mutex>
 #include <optional>
 #include <utility>
+#include <vector>
 
 namespace android::hardware::neuralnetworks::utils {
 
@@ -46,6 +47,12 @@ class ResilientBurst final : public nn::IBurst,
 
     OptionalCacheHold cacheMemory(const nn::SharedMemory& memory) const override;
 
+    // Pins a memory to the burst's cache for the lifetime of this object. Unlike the hold
+    // returned by cacheMemory, the pin survives recovery of a dead burst: the pinned set is
+    // re-registered with the replacement burst on first use, rather than synchronously inside
+    // recover(). Pinning the same memory again is a no-op.
+    void preRegisterMemory(const nn::SharedMemory& memory) const;
+
     nn::ExecutionResult<std::pair<std::vector<nn::OutputShape>, nn::Timing>> execute(
             const nn::Request& request, nn::MeasureTiming measure,
             const nn::OptionalTimePoint& deadline, const nn::OptionalDuration& loopTimeoutDuration,
@@ -69,6 +76,10 @@ class ResilientBurst final : public nn::IBurst,
     const Factory kMakeBurst;
     mutable std::mutex mMutex;
     mutable nn::SharedBurst mBurst GUARDED_BY(mMutex);
+    mutable std::vector<nn::SharedMemory> mPinnedMemories GUARDED_BY(mMutex);
+    mutable std::vector<OptionalCacheHold> mPinnedCacheHolds GUARDED_BY(mMutex);
+    // Set when recovery replaced mBurst and the pinned set has not been re-registered yet.
+    mutable bool mPinnedHoldsStale GUARDED_BY(mMutex) = false;
 };
 
 }  // namespace android::hardware::neuralnetworks::utils
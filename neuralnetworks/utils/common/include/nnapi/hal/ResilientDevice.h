@@ -43,7 +43,10 @@ class ResilientDevice final : public nn::IDevice,
 
     explicit ResilientDevice(PrivateConstructorTag tag, Factory makeDevice, std::string name,
                              std::string versionString, std::vector<nn::Extension> extensions,
-                             nn::Capabilities capabilities, nn::SharedDevice device);
+                             nn::Capabilities capabilities, nn::Version featureLevel,
+                             nn::DeviceType type,
+                             std::pair<uint32_t, uint32_t> numberOfCacheFilesNeeded,
+                             nn::SharedDevice device);
 
     nn::SharedDevice getDevice() const EXCLUDES(mMutex);
     nn::GeneralResult<nn::SharedDevice> recover(const nn::IDevice* failingDevice,
@@ -96,10 +99,16 @@ class ResilientDevice final : public nn::IDevice,
             const std::vector<nn::BufferRole>& outputRoles) const;
 
     const Factory kMakeDevice;
+    // Immutable device facts, captured once at creation so crash recovery and steady-state
+    // queries never go back to the driver; recover() validates the recovered device against
+    // them and invalidates this object on mismatch.
     const std::string kName;
     const std::string kVersionString;
     const std::vector<nn::Extension> kExtensions;
     const nn::Capabilities kCapabilities;
+    const nn::Version kFeatureLevel;
+    const nn::DeviceType kType;
+    const std::pair<uint32_t, uint32_t> kNumberOfCacheFilesNeeded;
     mutable std::mutex mMutex;
     mutable nn::SharedDevice mDevice GUARDED_BY(mMutex);
     mutable bool mIsValid GUARDED_BY(mMutex) = true;
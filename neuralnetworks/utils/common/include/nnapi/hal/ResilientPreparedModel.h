@@ -71,7 +71,32 @@ class ResilientPreparedModel final : public nn::IPreparedModel,
 
     std::any getUnderlyingResource() const override;
 
+    // Number of execute() calls that were not served by a cached reusable execution.
+    size_t getExecutionFallbackCount() const EXCLUDES(mMutex);
+
   private:
+    // Snapshot of one execute() signature. `execution` is null while the signature has been
+    // seen only once; the second identical call promotes it to a reusable execution bound to
+    // the current delegate, and later identical calls reduce to a single compute().
+    struct CachedExecution {
+        nn::Request request;
+        nn::MeasureTiming measure;
+        nn::OptionalDuration loopTimeoutDuration;
+        std::vector<nn::TokenValuePair> hints;
+        std::vector<nn::ExtensionNameAndPrefix> extensionNameToPrefix;
+        nn::SharedExecution execution;
+    };
+
+    // Returns a checked-out (or freshly promoted) cached execution matching the signature, or
+    // nullptr when the call must go through the per-call path.
+    std::shared_ptr<CachedExecution> acquireOrCreateCachedExecution(
+            const nn::Request& request, nn::MeasureTiming measure,
+            const nn::OptionalDuration& loopTimeoutDuration,
+            const std::vector<nn::TokenValuePair>& hints,
+            const std::vector<nn::ExtensionNameAndPrefix>& extensionNameToPrefix) const
+            EXCLUDES(mMutex);
+    void releaseCachedExecution(std::shared_ptr<CachedExecution> entry) const EXCLUDES(mMutex);
+
     bool isValidInternal() const EXCLUDES(mMutex);
     nn::GeneralResult<nn::SharedExecution> createReusableExecutionInternal(
             const nn::Request& request, nn::MeasureTiming measure,
@@ -83,6 +108,8 @@ class ResilientPreparedModel final : public nn::IPreparedModel,
     const Factory kMakePreparedModel;
     mutable std::mutex mMutex;
     mutable nn::SharedPreparedModel mPreparedModel GUARDED_BY(mMutex);
+    mutable std::shared_ptr<CachedExecution> mCachedExecution GUARDED_BY(mMutex);
+    mutable size_t mExecutionFallbackCount GUARDED_BY(mMutex) = 0;
 };
 
 }  // namespace android::hardware::neuralnetworks::utils
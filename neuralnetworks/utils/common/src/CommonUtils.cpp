@@ -25,13 +25,138 @@
 
 #include <algorithm>
 #include <any>
+#include <cstdint>
 #include <functional>
+#include <mutex>
 #include <optional>
+#include <type_traits>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
 namespace android::hardware::neuralnetworks::utils {
 
+namespace {
+
+// 64-bit FNV-1a, folded over every field that can influence a validation verdict.
+constexpr uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+constexpr uint64_t kFnvPrime = 0x100000001b3ULL;
+
+void hashBytes(uint64_t* state, const void* data, size_t length) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; i++) {
+        *state = (*state ^ bytes[i]) * kFnvPrime;
+    }
+}
+
+template <typename Type>
+void hashScalar(uint64_t* state, Type value) {
+    static_assert(std::is_trivially_copyable_v<Type>);
+    hashBytes(state, &value, sizeof(value));
+}
+
+template <typename Type>
+void hashVector(uint64_t* state, const std::vector<Type>& values) {
+    static_assert(std::is_trivially_copyable_v<Type>);
+    hashScalar(state, values.size());
+    hashBytes(state, values.data(), values.size() * sizeof(Type));
+}
+
+void hashOperand(uint64_t* state, const nn::Operand& operand) {
+    hashScalar(state, operand.type);
+    hashVector(state, operand.dimensions);
+    hashScalar(state, operand.scale);
+    hashScalar(state, operand.zeroPoint);
+    hashScalar(state, operand.lifetime);
+    hashScalar(state, operand.location.poolIndex);
+    hashScalar(state, operand.location.offset);
+    hashScalar(state, operand.location.length);
+    hashScalar(state, operand.location.padding);
+    hashScalar(state, operand.extraParams.index());
+    if (const auto* channelQuant =
+                std::get_if<nn::Operand::SymmPerChannelQuantParams>(&operand.extraParams)) {
+        hashVector(state, channelQuant->scales);
+        hashScalar(state, channelQuant->channelDim);
+    } else if (const auto* extension =
+                       std::get_if<nn::Operand::ExtensionParams>(&operand.extraParams)) {
+        hashVector(state, *extension);
+    }
+}
+
+void hashSubgraph(uint64_t* state, const nn::Model::Subgraph& subgraph) {
+    hashScalar(state, subgraph.operands.size());
+    for (const auto& operand : subgraph.operands) {
+        hashOperand(state, operand);
+    }
+    hashScalar(state, subgraph.operations.size());
+    for (const auto& operation : subgraph.operations) {
+        hashScalar(state, operation.type);
+        hashVector(state, operation.inputs);
+        hashVector(state, operation.outputs);
+    }
+    hashVector(state, subgraph.inputIndexes);
+    hashVector(state, subgraph.outputIndexes);
+}
+
+// The cache key. Gross structural counts are kept alongside the hash so that the unlikely
+// 64-bit collision additionally requires models of identical shape to go undetected.
+struct ModelFingerprint {
+    uint64_t hash;
+    size_t operandCount;
+    size_t operationCount;
+    size_t operandValuesSize;
+
+    bool operator==(const ModelFingerprint& other) const {
+        return hash == other.hash && operandCount == other.operandCount &&
+               operationCount == other.operationCount &&
+               operandValuesSize == other.operandValuesSize;
+    }
+};
+
+struct ModelFingerprintHasher {
+    size_t operator()(const ModelFingerprint& fingerprint) const { return fingerprint.hash; }
+};
+
+ModelFingerprint fingerprintModel(const nn::Model& model) {
+    uint64_t state = kFnvOffsetBasis;
+    size_t operandCount = model.main.operands.size();
+    size_t operationCount = model.main.operations.size();
+
+    hashSubgraph(&state, model.main);
+    hashScalar(&state, model.referenced.size());
+    for (const auto& subgraph : model.referenced) {
+        hashSubgraph(&state, subgraph);
+        operandCount += subgraph.operands.size();
+        operationCount += subgraph.operations.size();
+    }
+    hashScalar(&state, model.operandValues.size());
+    hashBytes(&state, model.operandValues.data(), model.operandValues.size());
+    hashScalar(&state, model.pools.size());
+    for (const auto& pool : model.pools) {
+        hashScalar(&state, nn::getSize(pool));
+        // The verdict depends on how a pool is backed, not just its size: ashmem and fd pools
+        // validate as ANDROID_OC_MR1 while AHardwareBuffer and unknown pools require
+        // ANDROID_Q, so the memory kind must keep differently-backed models apart.
+        hashScalar(&state, pool->handle.index());
+    }
+    hashScalar(&state, model.relaxComputationFloat32toFloat16);
+    hashScalar(&state, model.extensionNameToPrefix.size());
+    for (const auto& extension : model.extensionNameToPrefix) {
+        hashScalar(&state, extension.name.size());
+        hashBytes(&state, extension.name.data(), extension.name.size());
+        hashScalar(&state, extension.prefix);
+    }
+
+    return {
+            .hash = state,
+            .operandCount = operandCount,
+            .operationCount = operationCount,
+            .operandValuesSize = model.operandValues.size(),
+    };
+}
+
+}  // namespace
+
 nn::Capabilities::OperandPerformanceTable makeQuantized8PerformanceConsistentWithP(
         const nn::Capabilities::PerformanceInfo& float32Performance,
         const nn::Capabilities::PerformanceInfo& quantized8Performance) {
@@ -51,4 +176,31 @@ nn::Capabilities::OperandPerformanceTable makeQuantized8PerformanceConsistentWit
             .value();
 }
 
+nn::Result<nn::Version> validateModelMemoized(const nn::Model& model) {
+    static std::mutex mutex;
+    static std::unordered_map<ModelFingerprint, nn::Version, ModelFingerprintHasher> cache;
+    // Bounds the memory held for validation verdicts. When the limit is hit the cache is
+    // dropped wholesale and refills with whatever models are actually in use.
+    constexpr size_t kMaxCacheEntries = 100;
+
+    const auto fingerprint = fingerprintModel(model);
+    {
+        std::lock_guard guard(mutex);
+        if (const auto it = cache.find(fingerprint); it != cache.end()) {
+            return it->second;
+        }
+    }
+
+    // Only successful validations are memoized; a rejected model returns through the full
+    // error path every time so the caller gets the complete diagnostic message.
+    const auto version = NN_TRY(nn::validate(model));
+
+    std::lock_guard guard(mutex);
+    if (cache.size() >= kMaxCacheEntries) {
+        cache.clear();
+    }
+    cache.emplace(fingerprint, version);
+    return version;
+}
+
 }  // namespace android::hardware::neuralnetworks::utils
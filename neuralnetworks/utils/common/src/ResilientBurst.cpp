@@ -24,6 +24,7 @@
 #include <nnapi/TypeUtils.h>
 #include <nnapi/Types.h>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -83,6 +84,16 @@ ResilientBurst::ResilientBurst(PrivateConstructorTag /*tag*/, Factory makeBurst,
 
 nn::SharedBurst ResilientBurst::getBurst() const {
     std::lock_guard guard(mMutex);
+    if (mPinnedHoldsStale) {
+        // Re-register the pinned working set with the burst that replaced the dead one.
+        // Doing it here, on the first use after recovery, keeps recover() itself from
+        // blocking on re-mapping every pinned memory.
+        mPinnedCacheHolds.reserve(mPinnedMemories.size());
+        for (const auto& memory : mPinnedMemories) {
+            mPinnedCacheHolds.push_back(mBurst->cacheMemory(memory));
+        }
+        mPinnedHoldsStale = false;
+    }
     return mBurst;
 }
 
@@ -95,6 +106,12 @@ nn::GeneralResult<nn::SharedBurst> ResilientBurst::recover(const nn::IBurst* fai
     }
 
     mBurst = NN_TRY(kMakeBurst());
+
+    // Any holds taken on the failing burst are worthless now. Drop them and leave the
+    // pinned memories to be re-registered lazily by getBurst().
+    mPinnedCacheHolds.clear();
+    mPinnedHoldsStale = !mPinnedMemories.empty();
+
     return mBurst;
 }
 
@@ -103,6 +120,18 @@ ResilientBurst::OptionalCacheHold ResilientBurst::cacheMemory(
     return getBurst()->cacheMemory(memory);
 }
 
+void ResilientBurst::preRegisterMemory(const nn::SharedMemory& memory) const {
+    std::lock_guard guard(mMutex);
+    if (std::find(mPinnedMemories.begin(), mPinnedMemories.end(), memory) !=
+        mPinnedMemories.end()) {
+        return;
+    }
+    mPinnedMemories.push_back(memory);
+    if (!mPinnedHoldsStale) {
+        mPinnedCacheHolds.push_back(mBurst->cacheMemory(memory));
+    }
+}
+
 nn::ExecutionResult<std::pair<std::vector<nn::OutputShape>, nn::Timing>> ResilientBurst::execute(
         const nn::Request& request, nn::MeasureTiming measure,
         const nn::OptionalTimePoint& deadline, const nn::OptionalDuration& loopTimeoutDuration,
@@ -78,22 +78,32 @@ nn::GeneralResult<std::shared_ptr<const ResilientDevice>> ResilientDevice::creat
     auto versionString = device->getVersionString();
     auto extensions = device->getSupportedExtensions();
     auto capabilities = device->getCapabilities();
+    auto featureLevel = device->getFeatureLevel();
+    auto type = device->getType();
+    auto numberOfCacheFilesNeeded = device->getNumberOfCacheFilesNeeded();
 
     return std::make_shared<ResilientDevice>(PrivateConstructorTag{}, std::move(makeDevice),
                                              std::move(name), std::move(versionString),
                                              std::move(extensions), std::move(capabilities),
+                                             featureLevel, type, numberOfCacheFilesNeeded,
                                              std::move(device));
 }
 
 ResilientDevice::ResilientDevice(PrivateConstructorTag /*tag*/, Factory makeDevice,
                                  std::string name, std::string versionString,
                                  std::vector<nn::Extension> extensions,
-                                 nn::Capabilities capabilities, nn::SharedDevice device)
+                                 nn::Capabilities capabilities, nn::Version featureLevel,
+                                 nn::DeviceType type,
+                                 std::pair<uint32_t, uint32_t> numberOfCacheFilesNeeded,
+                                 nn::SharedDevice device)
     : kMakeDevice(std::move(makeDevice)),
       kName(std::move(name)),
       kVersionString(std::move(versionString)),
       kExtensions(std::move(extensions)),
       kCapabilities(std::move(capabilities)),
+      kFeatureLevel(featureLevel),
+      kType(type),
+      kNumberOfCacheFilesNeeded(numberOfCacheFilesNeeded),
       mDevice(std::move(device)) {
     CHECK(kMakeDevice != nullptr);
     CHECK(mDevice != nullptr);
@@ -122,12 +132,13 @@ nn::GeneralResult<nn::SharedDevice> ResilientDevice::recover(const nn::IDevice*
     };
     if (compare(&IDevice::getName) || compare(&IDevice::getVersionString) ||
         compare(&IDevice::getFeatureLevel) || compare(&IDevice::getType) ||
-        compare(&IDevice::getSupportedExtensions) || compare(&IDevice::getCapabilities)) {
+        compare(&IDevice::getSupportedExtensions) || compare(&IDevice::getCapabilities) ||
+        compare(&IDevice::getNumberOfCacheFilesNeeded)) {
         LOG(ERROR) << "Recovered device has different metadata than what is cached. Marking "
                       "IDevice object as invalid.";
-        device = std::make_shared<const InvalidDevice>(
-                kName, kVersionString, mDevice->getFeatureLevel(), mDevice->getType(), kExtensions,
-                kCapabilities, mDevice->getNumberOfCacheFilesNeeded());
+        device = std::make_shared<const InvalidDevice>(kName, kVersionString, kFeatureLevel, kType,
+                                                       kExtensions, kCapabilities,
+                                                       kNumberOfCacheFilesNeeded);
         mIsValid = false;
     }
 
@@ -144,11 +155,11 @@ const std::string& ResilientDevice::getVersionString() const {
 }
 
 nn::Version ResilientDevice::getFeatureLevel() const {
-    return getDevice()->getFeatureLevel();
+    return kFeatureLevel;
 }
 
 nn::DeviceType ResilientDevice::getType() const {
-    return getDevice()->getType();
+    return kType;
 }
 
 const std::vector<nn::Extension>& ResilientDevice::getSupportedExtensions() const {
@@ -160,7 +171,7 @@ const nn::Capabilities& ResilientDevice::getCapabilities() const {
 }
 
 std::pair<uint32_t, uint32_t> ResilientDevice::getNumberOfCacheFilesNeeded() const {
-    return getDevice()->getNumberOfCacheFilesNeeded();
+    return kNumberOfCacheFilesNeeded;
 }
 
 nn::GeneralResult<void> ResilientDevice::wait() const {
@@ -63,6 +63,59 @@ auto protect(const ResilientPreparedModel& resilientPreparedModel, const FnType&
     return fn(*preparedModel);
 }
 
+// The canonical request and execution-hint types do not define equality operators, so the
+// cached-execution signature comparison is spelled out field by field, including the raw
+// argument pointers -- a match guarantees the reusable execution is still bound to the
+// caller's buffers.
+bool sameDataLocation(const nn::DataLocation& a, const nn::DataLocation& b) {
+    return a.pointer == b.pointer && a.poolIndex == b.poolIndex && a.offset == b.offset &&
+           a.length == b.length && a.padding == b.padding;
+}
+
+bool sameArguments(const std::vector<nn::Request::Argument>& a,
+                   const std::vector<nn::Request::Argument>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].lifetime != b[i].lifetime || !sameDataLocation(a[i].location, b[i].location) ||
+            a[i].dimensions != b[i].dimensions) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameRequest(const nn::Request& a, const nn::Request& b) {
+    return sameArguments(a.inputs, b.inputs) && sameArguments(a.outputs, b.outputs) &&
+           a.pools == b.pools;
+}
+
+bool sameHints(const std::vector<nn::TokenValuePair>& a, const std::vector<nn::TokenValuePair>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].token != b[i].token || a[i].value != b[i].value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameExtensionNameToPrefix(const std::vector<nn::ExtensionNameAndPrefix>& a,
+                               const std::vector<nn::ExtensionNameAndPrefix>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].name != b[i].name || a[i].prefix != b[i].prefix) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }  // namespace
 
 nn::GeneralResult<std::shared_ptr<const ResilientPreparedModel>> ResilientPreparedModel::create(
@@ -109,6 +162,22 @@ ResilientPreparedModel::execute(
         const nn::OptionalTimePoint& deadline, const nn::OptionalDuration& loopTimeoutDuration,
         const std::vector<nn::TokenValuePair>& hints,
         const std::vector<nn::ExtensionNameAndPrefix>& extensionNameToPrefix) const {
+    // Serve repeated identical requests from a reusable execution snapshotted from the
+    // delegate, so steady-state callers pay one compute() instead of a full per-call
+    // request binding.
+    if (auto cached = acquireOrCreateCachedExecution(request, measure, loopTimeoutDuration, hints,
+                                                     extensionNameToPrefix)) {
+        auto result = cached->execution->compute(deadline);
+        if (result.has_value() || result.error().code != nn::ErrorStatus::DEAD_OBJECT) {
+            releaseCachedExecution(std::move(cached));
+            return result;
+        }
+        // The service died under the cached execution. Discard it and fall back to the
+        // protected per-call path below, which recovers the prepared model.
+        std::lock_guard guard(mMutex);
+        ++mExecutionFallbackCount;
+    }
+
     const auto fn = [&request, measure, &deadline, &loopTimeoutDuration, &hints,
                      &extensionNameToPrefix](const nn::IPreparedModel& preparedModel) {
         return preparedModel.execute(request, measure, deadline, loopTimeoutDuration, hints,
@@ -117,6 +186,66 @@ ResilientPreparedModel::execute(
     return protect(*this, fn);
 }
 
+std::shared_ptr<ResilientPreparedModel::CachedExecution>
+ResilientPreparedModel::acquireOrCreateCachedExecution(
+        const nn::Request& request, nn::MeasureTiming measure,
+        const nn::OptionalDuration& loopTimeoutDuration,
+        const std::vector<nn::TokenValuePair>& hints,
+        const std::vector<nn::ExtensionNameAndPrefix>& extensionNameToPrefix) const {
+    bool promote = false;
+    {
+        std::lock_guard guard(mMutex);
+        const bool matches =
+                mCachedExecution != nullptr && mCachedExecution->measure == measure &&
+                mCachedExecution->loopTimeoutDuration == loopTimeoutDuration &&
+                sameRequest(mCachedExecution->request, request) &&
+                sameHints(mCachedExecution->hints, hints) &&
+                sameExtensionNameToPrefix(mCachedExecution->extensionNameToPrefix,
+                                          extensionNameToPrefix);
+        if (matches && mCachedExecution->execution != nullptr) {
+            // Check the entry out of the cache so concurrent executions never share it.
+            return std::move(mCachedExecution);
+        }
+        if (matches) {
+            // Second occurrence of this signature; promote it below, outside the lock.
+            promote = true;
+        } else {
+            // New signature: remember it so the next identical call can promote it, and
+            // serve this call through the per-call path.
+            mCachedExecution = std::make_shared<CachedExecution>(
+                    CachedExecution{request, measure, loopTimeoutDuration, hints,
+                                    extensionNameToPrefix, nullptr});
+            ++mExecutionFallbackCount;
+            return nullptr;
+        }
+    }
+
+    CHECK(promote);
+    auto maybeExecution = createReusableExecutionInternal(request, measure, loopTimeoutDuration,
+                                                          hints, extensionNameToPrefix);
+    std::lock_guard guard(mMutex);
+    if (!maybeExecution.has_value()) {
+        // Creation failed; drop the marker so the failure is not retried on every call, and
+        // serve this call through the per-call path.
+        mCachedExecution = nullptr;
+        ++mExecutionFallbackCount;
+        return nullptr;
+    }
+    return std::make_shared<CachedExecution>(CachedExecution{request, measure, loopTimeoutDuration,
+                                                             hints, extensionNameToPrefix,
+                                                             std::move(maybeExecution).value()});
+}
+
+void ResilientPreparedModel::releaseCachedExecution(std::shared_ptr<CachedExecution> entry) const {
+    std::lock_guard guard(mMutex);
+    mCachedExecution = std::move(entry);
+}
+
+size_t ResilientPreparedModel::getExecutionFallbackCount() const {
+    std::lock_guard guard(mMutex);
+    return mExecutionFallbackCount;
+}
+
 nn::GeneralResult<std::pair<nn::SyncFence, nn::ExecuteFencedInfoCallback>>
 ResilientPreparedModel::executeFenced(
         const nn::Request& request, const std::vector<nn::SyncFence>& waitFor,
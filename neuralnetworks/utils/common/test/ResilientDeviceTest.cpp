@@ -142,7 +142,8 @@ TEST(ResilientDeviceTest, getFeatureLevel) {
     // setup call
     const auto [mockDevice, mockDeviceFactory, device] = setup();
     constexpr auto kFeatureLevel = nn::kVersionFeatureLevel1;
-    EXPECT_CALL(*mockDevice, getFeatureLevel()).Times(1).WillOnce(Return(kFeatureLevel));
+    // The value is captured at creation; the device must not be queried again.
+    EXPECT_CALL(*mockDevice, getFeatureLevel()).Times(0);
 
     // run test
     const auto featureLevel = device->getFeatureLevel();
@@ -155,7 +156,8 @@ TEST(ResilientDeviceTest, getType) {
     // setup call
     const auto [mockDevice, mockDeviceFactory, device] = setup();
     constexpr auto kDeviceType = nn::DeviceType::ACCELERATOR;
-    EXPECT_CALL(*mockDevice, getType()).Times(1).WillOnce(Return(kDeviceType));
+    // The value is captured at creation; the device must not be queried again.
+    EXPECT_CALL(*mockDevice, getType()).Times(0);
 
     // run test
     const auto type = device->getType();
@@ -167,9 +169,8 @@ TEST(ResilientDeviceTest, getType) {
 TEST(ResilientDeviceTest, getNumberOfCacheFilesNeeded) {
     // setup call
     const auto [mockDevice, mockDeviceFactory, device] = setup();
-    EXPECT_CALL(*mockDevice, getNumberOfCacheFilesNeeded())
-            .Times(1)
-            .WillOnce(Return(kNumberOfCacheFilesNeeded));
+    // The value is captured at creation; the device must not be queried again.
+    EXPECT_CALL(*mockDevice, getNumberOfCacheFilesNeeded()).Times(0);
 
     // run test
     const auto numberOfCacheFilesNeeded = device->getNumberOfCacheFilesNeeded();
@@ -670,6 +671,26 @@ TEST(ResilientDeviceTest, recoverCacheMismatchGetCapabilities) {
     EXPECT_TRUE(result.value() != recoveredMockDevice);
 }
 
+TEST(ResilientDeviceTest, recoverCacheMismatchGetNumberOfCacheFilesNeeded) {
+    // setup call
+    const auto [mockDevice, mockDeviceFactory, device] = setup();
+    const auto recoveredMockDevice = createConfiguredMockDevice();
+    EXPECT_CALL(*recoveredMockDevice, getNumberOfCacheFilesNeeded())
+            .Times(1)
+            .WillOnce(Return(std::pair<uint32_t, uint32_t>(2, 2)));
+    EXPECT_CALL(*mockDeviceFactory, Call(false)).Times(1).WillOnce(Return(recoveredMockDevice));
+
+    // run test
+    const auto result = device->recover(mockDevice.get(), /*blocking=*/false);
+
+    // verify result
+    ASSERT_TRUE(result.has_value())
+            << "Failed with " << result.error().code << ": " << result.error().message;
+    EXPECT_TRUE(result.value() != nullptr);
+    EXPECT_TRUE(result.value() != mockDevice);
+    EXPECT_TRUE(result.value() != recoveredMockDevice);
+}
+
 TEST(ResilientDeviceTest, recoverCacheMismatchInvalidPrepareModel) {
     // setup call
     const auto [mockDevice, mockDeviceFactory, device] = setup();
@@ -19,6 +19,7 @@
 #include <nnapi/Types.h>
 #include <nnapi/hal/ResilientPreparedModel.h>
 #include <utility>
+#include "MockExecution.h"
 #include "MockPreparedModel.h"
 
 namespace android::hardware::neuralnetworks::utils {
@@ -116,6 +117,34 @@ TEST(ResilientPreparedModelTest, execute) {
             << "Failed with " << result.error().code << ": " << result.error().message;
 }
 
+TEST(ResilientPreparedModelTest, executePromotedToReusableExecution) {
+    // setup call
+    const auto [mockPreparedModel, mockPreparedModelFactory, preparedModel] = setup();
+    const auto mockExecution = std::make_shared<const nn::MockExecution>();
+    EXPECT_CALL(*mockPreparedModel, execute(_, _, _, _, _, _))
+            .Times(1)
+            .WillOnce(Return(kNoExecutionError));
+    EXPECT_CALL(*mockPreparedModel, createReusableExecution(_, _, _, _, _))
+            .Times(1)
+            .WillOnce(Return(nn::GeneralResult<nn::SharedExecution>(mockExecution)));
+    EXPECT_CALL(*mockExecution, compute(_)).Times(2).WillRepeatedly(Return(kNoExecutionError));
+
+    // run test -- the first call goes through the delegate's execute, the second promotes
+    // the signature to a reusable execution, and the third is served from the cache
+    const auto result1 = preparedModel->execute({}, {}, {}, {}, {}, {});
+    const auto result2 = preparedModel->execute({}, {}, {}, {}, {}, {});
+    const auto result3 = preparedModel->execute({}, {}, {}, {}, {}, {});
+
+    // verify result
+    ASSERT_TRUE(result1.has_value())
+            << "Failed with " << result1.error().code << ": " << result1.error().message;
+    ASSERT_TRUE(result2.has_value())
+            << "Failed with " << result2.error().code << ": " << result2.error().message;
+    ASSERT_TRUE(result3.has_value())
+            << "Failed with " << result3.error().code << ": " << result3.error().message;
+    EXPECT_EQ(preparedModel->getExecutionFallbackCount(), 1u);
+}
+
 TEST(ResilientPreparedModelTest, executeError) {
     // setup call
     const auto [mockPreparedModel, mockPreparedModelFactory, preparedModel] = setup();
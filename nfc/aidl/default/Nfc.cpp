@@ -134,7 +134,8 @@ void OnDeath(void* cookie) {
 }
 
 ::ndk::ScopedAStatus Nfc::write(const std::vector<uint8_t>& data, int32_t* _aidl_return) {
-    LOG(INFO) << "write";
+    // write() is called per NCI packet; don't log it at INFO during transfers.
+    LOG(VERBOSE) << "write";
     if (Nfc::mCallback == nullptr) {
         LOG(ERROR) << __func__ << "mCallback null";
         return ndk::ScopedAStatus::fromServiceSpecificError(
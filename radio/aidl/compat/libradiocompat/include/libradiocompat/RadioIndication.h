@@ -27,6 +27,9 @@
 #include <aidl/android/hardware/radio/voice/IRadioVoiceIndication.h>
 #include <android/hardware/radio/1.6/IRadioIndication.h>
 
+#include <mutex>
+#include <optional>
+
 namespace android::hardware::radio::compat {
 
 class RadioIndication : public V1_6::IRadioIndication {
@@ -61,6 +64,13 @@ class RadioIndication : public V1_6::IRadioIndication {
             ::aidl::android::hardware::radio::ims::IRadioImsIndicationDefault, true>
             mImsCb;
 
+    // Last signal strength delivered to the framework. The modem may repeat
+    // an unchanged report many times per second; identical consecutive
+    // reports are dropped before the AIDL outcall.
+    std::mutex mLastSignalStrengthGuard;
+    std::optional<::aidl::android::hardware::radio::network::SignalStrength> mLastSignalStrength
+            GUARDED_BY(mLastSignalStrengthGuard);
+
     // IRadioIndication @ 1.0
     Return<void> radioStateChanged(V1_0::RadioIndicationType type,
                                    V1_0::RadioState radioState) override;
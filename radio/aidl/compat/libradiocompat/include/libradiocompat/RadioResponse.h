@@ -28,6 +28,8 @@
 #include <aidl/android/hardware/radio/voice/IRadioVoiceResponse.h>
 #include <android/hardware/radio/1.6/IRadioResponse.h>
 
+#include <mutex>
+
 namespace android::hardware::radio::compat {
 
 class RadioResponse : public V1_6::IRadioResponse {
@@ -55,6 +57,19 @@ class RadioResponse : public V1_6::IRadioResponse {
                        ::aidl::android::hardware::radio::ims::IRadioImsResponseDefault>
             mImsCb;
 
+    // Cache of the last translated getCellInfoList response. The framework
+    // polls every couple of seconds and the neighbor list is often unchanged
+    // between polls; reusing the translated vector skips re-converting tens
+    // of entries each time. The frozen AIDL response always carries the full
+    // list, so only the translation cost can be saved, not the transfer.
+    std::mutex mCellInfoCacheGuard;
+    hidl_vec<V1_5::CellInfo> mLastCellInfoHidl_1_5 GUARDED_BY(mCellInfoCacheGuard);
+    std::vector<::aidl::android::hardware::radio::network::CellInfo> mLastCellInfoAidl_1_5
+            GUARDED_BY(mCellInfoCacheGuard);
+    hidl_vec<V1_6::CellInfo> mLastCellInfoHidl_1_6 GUARDED_BY(mCellInfoCacheGuard);
+    std::vector<::aidl::android::hardware::radio::network::CellInfo> mLastCellInfoAidl_1_6
+            GUARDED_BY(mCellInfoCacheGuard);
+
     // IRadioResponse @ 1.0
     Return<void> getIccCardStatusResponse(const V1_0::RadioResponseInfo& info,
                                           const V1_0::CardStatus& cardStatus) override;
@@ -75,6 +75,8 @@ Return<void> RadioIndication::cellInfoList_1_4(V1_0::RadioIndicationType type,
 Return<void> RadioIndication::cellInfoList_1_5(V1_0::RadioIndicationType type,
                                                const hidl_vec<V1_5::CellInfo>& records) {
     LOG_CALL << type;
+    // High-rate indication - don't translate the list if nobody listens.
+    if (!mNetworkCb) return {};
     networkCb()->cellInfoList(toAidl(type), toAidl(records));
     return {};
 }
@@ -82,6 +84,8 @@ Return<void> RadioIndication::cellInfoList_1_5(V1_0::RadioIndicationType type,
 Return<void> RadioIndication::cellInfoList_1_6(V1_0::RadioIndicationType type,
                                                const hidl_vec<V1_6::CellInfo>& records) {
     LOG_CALL << type;
+    // High-rate indication - don't translate the list if nobody listens.
+    if (!mNetworkCb) return {};
     networkCb()->cellInfoList(toAidl(type), toAidl(records));
     return {};
 }
@@ -138,14 +142,28 @@ Return<void> RadioIndication::currentSignalStrength_1_2(V1_0::RadioIndicationTyp
 Return<void> RadioIndication::currentSignalStrength_1_4(
         V1_0::RadioIndicationType type, const V1_4::SignalStrength& signalStrength) {
     LOG_CALL << type;
-    networkCb()->currentSignalStrength(toAidl(type), toAidl(signalStrength));
+    if (!mNetworkCb) return {};
+    auto aidlStrength = toAidl(signalStrength);
+    {
+        const std::lock_guard<std::mutex> lock(mLastSignalStrengthGuard);
+        if (mLastSignalStrength == aidlStrength) return {};
+        mLastSignalStrength = aidlStrength;
+    }
+    networkCb()->currentSignalStrength(toAidl(type), aidlStrength);
     return {};
 }
 
 Return<void> RadioIndication::currentSignalStrength_1_6(
         V1_0::RadioIndicationType type, const V1_6::SignalStrength& signalStrength) {
     LOG_CALL << type;
-    networkCb()->currentSignalStrength(toAidl(type), toAidl(signalStrength));
+    if (!mNetworkCb) return {};
+    auto aidlStrength = toAidl(signalStrength);
+    {
+        const std::lock_guard<std::mutex> lock(mLastSignalStrengthGuard);
+        if (mLastSignalStrength == aidlStrength) return {};
+        mLastSignalStrength = aidlStrength;
+    }
+    networkCb()->currentSignalStrength(toAidl(type), aidlStrength);
     return {};
 }
 
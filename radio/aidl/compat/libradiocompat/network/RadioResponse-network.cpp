@@ -114,14 +114,28 @@ Return<void> RadioResponse::getCellInfoListResponse_1_4(const V1_0::RadioRespons
 Return<void> RadioResponse::getCellInfoListResponse_1_5(const V1_0::RadioResponseInfo& info,
                                                         const hidl_vec<V1_5::CellInfo>& cellInfo) {
     LOG_CALL << info.serial;
-    networkCb()->getCellInfoListResponse(toAidl(info), toAidl(cellInfo));
+    std::unique_lock<std::mutex> lock(mCellInfoCacheGuard);
+    if (mLastCellInfoHidl_1_5 != cellInfo) {
+        mLastCellInfoAidl_1_5 = toAidl(cellInfo);
+        mLastCellInfoHidl_1_5 = cellInfo;
+    }
+    auto aidlCellInfo = mLastCellInfoAidl_1_5;
+    lock.unlock();
+    networkCb()->getCellInfoListResponse(toAidl(info), aidlCellInfo);
     return {};
 }
 
 Return<void> RadioResponse::getCellInfoListResponse_1_6(const V1_6::RadioResponseInfo& info,
                                                         const hidl_vec<V1_6::CellInfo>& cellInfo) {
     LOG_CALL << info.serial;
-    networkCb()->getCellInfoListResponse(toAidl(info), toAidl(cellInfo));
+    std::unique_lock<std::mutex> lock(mCellInfoCacheGuard);
+    if (mLastCellInfoHidl_1_6 != cellInfo) {
+        mLastCellInfoAidl_1_6 = toAidl(cellInfo);
+        mLastCellInfoHidl_1_6 = cellInfo;
+    }
+    auto aidlCellInfo = mLastCellInfoAidl_1_6;
+    lock.unlock();
+    networkCb()->getCellInfoListResponse(toAidl(info), aidlCellInfo);
     return {};
 }
 
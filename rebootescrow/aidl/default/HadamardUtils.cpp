@@ -117,9 +117,11 @@ static void CopyWinner(CodewordWinner* dest, const CodewordWinner& src) {
 
 // Decode a single codeword. Because of the way codewords are striped together
 // this takes the entire input, plus an offset telling it which word to decode.
-static uint16_t DecodeWord(size_t word, const std::vector<uint8_t>& encoded) {
-    std::vector<int32_t> scores;
-    scores.reserve(ENCODE_LENGTH);
+// The caller provides the ENCODE_LENGTH-sized scores scratch buffer so it can
+// be reused across all codewords instead of reallocated per word.
+static uint16_t DecodeWord(size_t word, const std::vector<uint8_t>& encoded,
+                           std::vector<int32_t>& scores) {
+    scores.clear();
     // Convert x -> -1^x in the encoded bits. e.g [1, 0, 0, 1] -> [-1, 1, 1, -1]
     for (uint32_t i = 0; i < ENCODE_LENGTH; i++) {
         scores.push_back(1 - 2 * read_bit(encoded, i * KEY_CODEWORDS + word));
@@ -166,8 +168,10 @@ std::vector<uint8_t> DecodeKey(const std::vector<uint8_t>& shuffled) {
         rng_state %= RNG_MODULUS;
     }
     std::vector<uint8_t> result(KEY_SIZE_IN_BYTES, 0);
+    std::vector<int32_t> scores;
+    scores.reserve(ENCODE_LENGTH);
     for (size_t i = 0; i < KEY_CODEWORDS; i++) {
-        uint16_t val = DecodeWord(i, encoded);
+        uint16_t val = DecodeWord(i, encoded, scores);
         result[i * CODEWORD_BYTES] = val & 0xffu;
         result[i * CODEWORD_BYTES + 1] = val >> 8u;
     }
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <chrono>
+
 #include <android-base/file.h>
 #include <android-base/logging.h>
 #include <android-base/unique_fd.h>
@@ -29,6 +31,7 @@ namespace rebootescrow {
 using ::android::base::unique_fd;
 
 ndk::ScopedAStatus RebootEscrow::storeKey(const std::vector<uint8_t>& ukek) {
+    auto begin = std::chrono::steady_clock::now();
     int rawFd = TEMP_FAILURE_RETRY(::open(devicePath_.c_str(), O_WRONLY | O_NOFOLLOW | O_CLOEXEC));
     unique_fd fd(rawFd);
     if (fd.get() < 0) {
@@ -43,10 +46,15 @@ ndk::ScopedAStatus RebootEscrow::storeKey(const std::vector<uint8_t>& ukek) {
         return ndk::ScopedAStatus(AStatus_fromExceptionCode(EX_UNSUPPORTED_OPERATION));
     }
 
+    // This runs on the OTA reboot critical path; keep a latency record.
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    LOG(INFO) << "Stored reboot escrow key in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << "ms";
     return ndk::ScopedAStatus::ok();
 }
 
 ndk::ScopedAStatus RebootEscrow::retrieveKey(std::vector<uint8_t>* _aidl_return) {
+    auto begin = std::chrono::steady_clock::now();
     int rawFd = TEMP_FAILURE_RETRY(::open(devicePath_.c_str(), O_RDONLY | O_NOFOLLOW | O_CLOEXEC));
     unique_fd fd(rawFd);
     if (fd.get() < 0) {
@@ -63,6 +71,10 @@ ndk::ScopedAStatus RebootEscrow::retrieveKey(std::vector<uint8_t>* _aidl_return)
     auto keyBytes = hadamard::DecodeKey(encodedBytes);
 
     *_aidl_return = keyBytes;
+    // This runs on the resume-on-reboot critical path; keep a latency record.
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    LOG(INFO) << "Retrieved reboot escrow key in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << "ms";
     return ndk::ScopedAStatus::ok();
 }
 
@@ -20,7 +20,10 @@
 #include <android/binder_manager.h>
 #include <android/binder_process.h>
 
+#include <inttypes.h>
+
 #include <algorithm>
+#include <chrono>
 
 using aidl::android::hardware::secure_element::BnSecureElement;
 using aidl::android::hardware::secure_element::ISecureElementCallback;
@@ -606,6 +609,7 @@ class EmulatedSecureElement : public BnSecureElement {
             return ScopedAStatus::fromExceptionCode(EX_ILLEGAL_STATE);
         }
 
+        auto transmit_start = std::chrono::steady_clock::now();
         se::Apdu apdu(data);
         uint8_t channel_number = apdu.get_channel_number();
         std::vector<uint8_t> response_apdu;
@@ -651,9 +655,30 @@ class EmulatedSecureElement : public BnSecureElement {
         LOG(INFO) << __func__
                   << " response: " << HexString(aidl_return->data(), aidl_return->size()) << " ("
                   << aidl_return->size() << ")";
+        RecordTransmitLatency(channel_number,
+                              std::chrono::duration_cast<std::chrono::microseconds>(
+                                      std::chrono::steady_clock::now() - transmit_start)
+                                      .count());
         return ScopedAStatus::ok();
     }
 
+    binder_status_t dump(int fd, const char** /*args*/, uint32_t /*numArgs*/) override {
+        dprintf(fd, "EmulatedSecureElement transmit latency per channel\n");
+        dprintf(fd, "buckets: <1us <10us <100us <1ms <10ms <100ms >=100ms\n");
+        for (size_t i = 0; i < channel_stats_.size(); i++) {
+            const TransmitStats& stats = channel_stats_[i];
+            if (stats.count == 0) {
+                continue;
+            }
+            dprintf(fd, "channel %zu: %" PRIu64 " APDUs:", i, stats.count);
+            for (auto bucket : stats.buckets) {
+                dprintf(fd, " %" PRIu64, bucket);
+            }
+            dprintf(fd, "\n");
+        }
+        return STATUS_OK;
+    }
+
   private:
     struct Channel {
       public:
@@ -675,6 +700,26 @@ class EmulatedSecureElement : public BnSecureElement {
     std::array<Channel, 20> channels_{};
     std::shared_ptr<ISecureElementCallback> client_callback_{nullptr};
 
+    // Histogram of transmit() processing latency per channel, printed by the
+    // debug dump. Buckets are decades from <1us up to >=100ms.
+    struct TransmitStats {
+        uint64_t count{0};
+        std::array<uint64_t, 7> buckets{};
+    };
+    std::array<TransmitStats, 20> channel_stats_{};
+
+    void RecordTransmitLatency(uint8_t channel_number, int64_t latency_us) {
+        TransmitStats& stats = channel_stats_[channel_number];
+        stats.count++;
+        size_t bucket = 0;
+        int64_t threshold = 1;
+        while (bucket + 1 < stats.buckets.size() && latency_us >= threshold) {
+            bucket++;
+            threshold *= 10;
+        }
+        stats.buckets[bucket]++;
+    }
+
     // Secure element abstraction.
 
     static const uint8_t MANAGE_CHANNEL_INS = 0x70;
@@ -16,7 +16,9 @@
 
 #define LOG_TAG "keymint_benchmark"
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
 
 #include <base/command_line.h>
 #include <benchmark/benchmark.h>
@@ -507,8 +509,30 @@ class KeyMintBenchmarkTest {
 
 KeyMintBenchmarkTest* keymintTest;
 
+// Service name the benchmark was pointed at; used by the parallel benchmarks
+// to open additional per-thread connections.
+std::string serviceName;
+
+// Linear-interpolated percentile of |values|, with |p| in [0, 1].
+static double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    const double idx = p * (values.size() - 1);
+    const size_t lo = static_cast<size_t>(idx);
+    const size_t hi = std::min(lo + 1, values.size() - 1);
+    return values[lo] + (values[hi] - values[lo]) * (idx - lo);
+}
+
 static void settings(benchmark::internal::Benchmark* benchmark) {
     benchmark->Unit(benchmark::kMillisecond);
+    // Tail percentiles across repetitions; emitted alongside the library's
+    // mean/median/stddev aggregates when --benchmark_repetitions=N is passed.
+    benchmark->ComputeStatistics("p50",
+                                 [](const std::vector<double>& v) { return percentile(v, 0.50); });
+    benchmark->ComputeStatistics("p95",
+                                 [](const std::vector<double>& v) { return percentile(v, 0.95); });
+    benchmark->ComputeStatistics("p99",
+                                 [](const std::vector<double>& v) { return percentile(v, 0.99); });
 }
 
 static void addDefaultLabel(benchmark::State& state) {
@@ -782,6 +806,69 @@ BENCHMARK_KM_SIGNATURE_ALL_RSA_KEYS(SHA512withRSA/PSS);
 
 // clang-format on
 
+/*
+ * ============= PARALLEL SIGNATURE TESTS ==================
+ *
+ * Same shape as sign(), but every benchmark thread drives its own KeyMint
+ * connection, key and operation stream, so N-thread runs measure how the TEE
+ * schedules concurrent begin/update/finish streams rather than serializing
+ * on a shared operation.
+ */
+static void signParallel(benchmark::State& state, string transform, int keySize, int msgSize) {
+    thread_local std::unique_ptr<KeyMintBenchmarkTest> test(
+            KeyMintBenchmarkTest::newInstance(serviceName.c_str()));
+    if (!test) {
+        state.SkipWithError("Unable to connect to KeyMint");
+        return;
+    }
+    if (test->securityLevel_ == SecurityLevel::STRONGBOX && !isValidSBKeySize(transform, keySize)) {
+        state.SkipWithError(("Skipped for STRONGBOX: Keysize: " + std::to_string(keySize) +
+                             " is not supported in StrongBox for algorithm: " +
+                             test->getAlgorithmString(transform))
+                                    .c_str());
+        return;
+    }
+    addDefaultLabel(state);
+    if (!test->GenerateKey(transform, keySize, true)) {
+        state.SkipWithError(
+                ("Key generation error, " + std::to_string(test->getError())).c_str());
+        return;
+    }
+
+    auto in_params = test->getOperationParams(transform, true);
+    AuthorizationSet out_params;
+    string message = test->GenerateMessage(msgSize);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        ErrorCode error = test->Begin(KeyPurpose::SIGN, in_params, &out_params);
+        if (error != ErrorCode::OK) {
+            state.SkipWithError(
+                    ("Error beginning sign, " + std::to_string(test->getError())).c_str());
+            return;
+        }
+        out_params.Clear();
+        state.ResumeTiming();
+        if (!test->Process(message)) {
+            state.SkipWithError(("Sign error, " + std::to_string(test->getError())).c_str());
+            break;
+        }
+    }
+    test->DeleteKey();
+}
+
+// clang-format off
+#define BENCHMARK_KM_PARALLEL_SIGNATURE(transform, keySize, msgSize)                      \
+    BENCHMARK_CAPTURE(signParallel, transform/keySize/msgSize,                            \
+                      #transform "/" #keySize "/" #msgSize, keySize, msgSize)             \
+            ->Apply(settings)                                                             \
+            ->ThreadRange(1, 4);
+
+BENCHMARK_KM_PARALLEL_SIGNATURE(SHA256withECDSA, 256, SMALL_MESSAGE_SIZE)
+BENCHMARK_KM_PARALLEL_SIGNATURE(SHA256withRSA, 2048, SMALL_MESSAGE_SIZE)
+BENCHMARK_KM_PARALLEL_SIGNATURE(HmacSHA256, 256, SMALL_MESSAGE_SIZE)
+// clang-format on
+
 /*
  * ============= CIPHER TESTS ==================
  */
@@ -928,6 +1015,7 @@ int main(int argc, char** argv) {
                 "/default";
     }
     std::cerr << service_name << std::endl;
+    aidl::android::hardware::security::keymint::test::serviceName = service_name;
     aidl::android::hardware::security::keymint::test::keymintTest =
             aidl::android::hardware::security::keymint::test::KeyMintBenchmarkTest::newInstance(
                     service_name.c_str());
@@ -344,7 +344,12 @@ JsonOutput jsonEncodeCsrWithBuild(const std::string instance_name, const cppbor:
         return JsonOutput::Error("Unable to read build fingerprint");
     }
 
-    bytevec csrCbor = csr.encode();
+    // Encode straight into a right-sized buffer; with large keysToSign batches
+    // this skips the byte-at-a-time back-inserter path of Item::encode().
+    bytevec csrCbor(csr.encodedSize());
+    if (csr.encode(csrCbor.data(), csrCbor.data() + csrCbor.size()) == nullptr) {
+        return JsonOutput::Error("Error encoding CSR as CBOR.");
+    }
     size_t base64Length;
     int rc = EVP_EncodedLength(&base64Length, csrCbor.size());
     if (!rc) {
@@ -877,7 +882,8 @@ ErrMsgOr<std::unique_ptr<cppbor::Array>> parseAndValidateCsrPayload(
         return result.message();
     }
 
-    if (signedKeys->encode() != keysToSign.encode()) {
+    // Structural comparison avoids re-encoding both key arrays per CSR.
+    if (*signedKeys != keysToSign) {
         return "Signed keys do not match.";
     }
 
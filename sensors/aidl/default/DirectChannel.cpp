@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sensors-impl/DirectChannel.h"
+
+#include <cutils/ashmem.h>
+#include <log/log.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <utils/SystemClock.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace sensors {
+
+using ::aidl::android::hardware::sensors::ISensors;
+using ::android::base::unique_fd;
+
+namespace {
+
+constexpr size_t kEventLength =
+        static_cast<size_t>(ISensors::DIRECT_REPORT_SENSOR_EVENT_TOTAL_LENGTH);
+
+// Nominal report interval for each RateLevel: 50Hz, 200Hz and 800Hz respectively.
+int64_t intervalForRateLevel(DirectChannel::RateLevel rate) {
+    switch (rate) {
+        case DirectChannel::RateLevel::NORMAL:
+            return 20'000'000;
+        case DirectChannel::RateLevel::FAST:
+            return 5'000'000;
+        case DirectChannel::RateLevel::VERY_FAST:
+            return 1'250'000;
+        default:
+            return 0;
+    }
+}
+
+}  // namespace
+
+std::unique_ptr<DirectChannel> DirectChannel::create(const SharedMemInfo& mem) {
+    if (mem.size < static_cast<int32_t>(kEventLength) || mem.memoryHandle.fds.empty()) {
+        return nullptr;
+    }
+
+    unique_fd fd(dup(mem.memoryHandle.fds[0].get()));
+    if (!fd.ok() || !ashmem_valid(fd.get()) ||
+        ashmem_get_size_region(fd.get()) < static_cast<int>(mem.size)) {
+        return nullptr;
+    }
+
+    void* buffer =
+            mmap(nullptr, mem.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd.get(), 0 /* offset */);
+    if (buffer == MAP_FAILED) {
+        ALOGE("Failed to map direct channel memory: %s", strerror(errno));
+        return nullptr;
+    }
+
+    // The HAL is responsible for resetting the memory content to its initial state on
+    // registration. A zeroed atomic counter marks every slot as not yet written.
+    memset(buffer, 0, mem.size);
+
+    return std::unique_ptr<DirectChannel>(
+            new DirectChannel(std::move(fd), static_cast<uint8_t*>(buffer), mem.size));
+}
+
+DirectChannel::DirectChannel(unique_fd fd, uint8_t* buffer, size_t size)
+    : mFd(std::move(fd)), mBuffer(buffer), mSize(size), mCapacity(size / kEventLength) {
+    mRunThread = std::thread(startThread, this);
+}
+
+DirectChannel::~DirectChannel() {
+    {
+        std::unique_lock<std::mutex> lock(mRunMutex);
+        mStopThread = true;
+        mWaitCV.notify_all();
+    }
+    mRunThread.join();
+    munmap(mBuffer, mSize);
+}
+
+int32_t DirectChannel::configure(const SensorInfo& sensorInfo, RateLevel rate) {
+    std::unique_lock<std::mutex> lock(mRunMutex);
+    // The sensor handle doubles as the report token: it is positive and unique within the
+    // channel, which is all the framework requires of the token.
+    mConfigs[sensorInfo.sensorHandle] = {
+            .reportToken = sensorInfo.sensorHandle,
+            .type = sensorInfo.type,
+            .intervalNs = intervalForRateLevel(rate),
+            .nextEventNs = ::android::elapsedRealtimeNano(),
+    };
+    mWaitCV.notify_all();
+    return sensorInfo.sensorHandle;
+}
+
+bool DirectChannel::stop(int32_t sensorHandle) {
+    std::unique_lock<std::mutex> lock(mRunMutex);
+    return mConfigs.erase(sensorHandle) != 0;
+}
+
+void DirectChannel::stopAll() {
+    std::unique_lock<std::mutex> lock(mRunMutex);
+    mConfigs.clear();
+}
+
+void DirectChannel::startThread(DirectChannel* channel) {
+    channel->run();
+}
+
+void DirectChannel::run() {
+    std::unique_lock<std::mutex> runLock(mRunMutex);
+
+    while (!mStopThread) {
+        if (mConfigs.empty()) {
+            mWaitCV.wait(runLock, [&] { return !mConfigs.empty() || mStopThread; });
+            continue;
+        }
+
+        int64_t now = ::android::elapsedRealtimeNano();
+        int64_t nextWakeTime = INT64_MAX;
+        for (auto& [sensorHandle, config] : mConfigs) {
+            if (now >= config.nextEventNs) {
+                writeEventLocked(config, now);
+                // Advance the deadline by the nominal interval so a late wakeup is paid back
+                // on the next cycle, but never bank more than one interval of credit: the
+                // channel may briefly run at up to twice the nominal rate to catch up, which
+                // stays inside the (55%, 220%] window RateLevel allows.
+                config.nextEventNs += config.intervalNs;
+                if (config.nextEventNs < now - config.intervalNs) {
+                    config.nextEventNs = now - config.intervalNs;
+                }
+            }
+            nextWakeTime = std::min(nextWakeTime, config.nextEventNs);
+        }
+
+        now = ::android::elapsedRealtimeNano();
+        if (nextWakeTime > now) {
+            mWaitCV.wait_for(runLock, std::chrono::nanoseconds(nextWakeTime - now));
+        }
+    }
+}
+
+void DirectChannel::writeEventLocked(const ReportConfig& config, int64_t timestampNs) {
+    // Assemble the full record in a cache-line-aligned staging buffer so the shared memory,
+    // which may be mapped uncached by the reader, is touched with a single sequential copy
+    // instead of field-sized stores.
+    alignas(64) uint8_t record[kEventLength] = {};
+
+    const int32_t size = static_cast<int32_t>(kEventLength);
+    const int32_t type = static_cast<int32_t>(config.type);
+    memcpy(&record[ISensors::DIRECT_REPORT_SENSOR_EVENT_OFFSET_SIZE_FIELD], &size, sizeof(size));
+    memcpy(&record[ISensors::DIRECT_REPORT_SENSOR_EVENT_OFFSET_SIZE_REPORT_TOKEN],
+           &config.reportToken, sizeof(config.reportToken));
+    memcpy(&record[ISensors::DIRECT_REPORT_SENSOR_EVENT_OFFSET_SIZE_SENSOR_TYPE], &type,
+           sizeof(type));
+    memcpy(&record[ISensors::DIRECT_REPORT_SENSOR_EVENT_OFFSET_SIZE_TIMESTAMP], &timestampNs,
+           sizeof(timestampNs));
+
+    // Canned samples matching what the polling path reports for these sensors.
+    float data[3] = {0.0f, 0.0f, 0.0f};
+    if (config.type == SensorType::ACCELEROMETER) {
+        data[2] = 9.8f;
+    }
+    memcpy(&record[ISensors::DIRECT_REPORT_SENSOR_EVENT_OFFSET_SIZE_DATA], data, sizeof(data));
+
+    // The counter field in the staging buffer stays 0 (never written). Copy the record into
+    // its slot first, then publish the atomic counter last with release semantics so a reader
+    // that observes the counter is guaranteed to observe the rest of the record.
+    uint8_t* slot = mBuffer + ((mEventCounter - 1) % mCapacity) * kEventLength;
+    memcpy(slot, record, kEventLength);
+    __atomic_store_n(reinterpret_cast<uint32_t*>(
+                             slot + ISensors::DIRECT_REPORT_SENSOR_EVENT_OFFSET_SIZE_ATOMIC_COUNTER),
+                     mEventCounter, __ATOMIC_RELEASE);
+
+    mEventCounter = (mEventCounter == UINT32_MAX) ? 1 : mEventCounter + 1;
+}
+
+}  // namespace sensors
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
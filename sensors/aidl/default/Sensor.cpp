@@ -29,12 +29,19 @@ namespace sensors {
 
 static constexpr int32_t kDefaultMaxDelayUs = 10 * 1000 * 1000;
 
+// Batched events are flushed once this many have accumulated even if the report latency
+// deadline has not passed yet.
+static constexpr size_t kMaxBatchedEvents = 128;
+
 Sensor::Sensor(ISensorsEventCallback* callback)
     : mIsEnabled(false),
       mSamplingPeriodNs(0),
+      mMaxReportLatencyNs(0),
       mLastSampleTimeNs(0),
+      mNextFlushTimeNs(0),
       mCallback(callback),
       mMode(OperationMode::NORMAL) {
+    mBatchedEvents.reserve(kMaxBatchedEvents);
     mRunThread = std::thread(startThread, this);
 }
 
@@ -51,15 +58,20 @@ const SensorInfo& Sensor::getSensorInfo() const {
     return mSensorInfo;
 }
 
-void Sensor::batch(int64_t samplingPeriodNs) {
+void Sensor::batch(int64_t samplingPeriodNs, int64_t maxReportLatencyNs) {
     if (samplingPeriodNs < mSensorInfo.minDelayUs * 1000LL) {
         samplingPeriodNs = mSensorInfo.minDelayUs * 1000LL;
     } else if (samplingPeriodNs > mSensorInfo.maxDelayUs * 1000LL) {
         samplingPeriodNs = mSensorInfo.maxDelayUs * 1000LL;
     }
+    if (maxReportLatencyNs < 0) {
+        maxReportLatencyNs = 0;
+    }
 
-    if (mSamplingPeriodNs != samplingPeriodNs) {
+    if (mSamplingPeriodNs != samplingPeriodNs || mMaxReportLatencyNs != maxReportLatencyNs) {
+        std::unique_lock<std::mutex> lock(mRunMutex);
         mSamplingPeriodNs = samplingPeriodNs;
+        mMaxReportLatencyNs = maxReportLatencyNs;
         // Wake up the 'run' thread to check if a new event should be generated now
         mWaitCV.notify_all();
     }
@@ -68,6 +80,10 @@ void Sensor::batch(int64_t samplingPeriodNs) {
 void Sensor::activate(bool enable) {
     if (mIsEnabled != enable) {
         std::unique_lock<std::mutex> lock(mRunMutex);
+        if (!enable) {
+            // Deliver whatever has been batched before the sensor stops reporting.
+            flushBatchedEventsLocked();
+        }
         mIsEnabled = enable;
         mWaitCV.notify_all();
     }
@@ -82,8 +98,13 @@ ScopedAStatus Sensor::flush() {
                 static_cast<int32_t>(BnSensors::ERROR_BAD_VALUE));
     }
 
-    // Note: If a sensor supports batching, write all of the currently batched events for the sensor
-    // to the Event FMQ prior to writing the flush complete event.
+    // Write all of the currently batched events for the sensor to the Event FMQ prior to writing
+    // the flush complete event.
+    {
+        std::unique_lock<std::mutex> lock(mRunMutex);
+        flushBatchedEventsLocked();
+    }
+
     Event ev;
     ev.sensorHandle = mSensorInfo.sensorHandle;
     ev.sensorType = SensorType::META_DATA;
@@ -119,14 +140,44 @@ void Sensor::run() {
             if (now >= nextSampleTime) {
                 mLastSampleTimeNs = now;
                 nextSampleTime = mLastSampleTimeNs + mSamplingPeriodNs;
-                mCallback->postEvents(readEvents(), isWakeUpSensor());
+                std::vector<Event> events = readEvents();
+                if (!events.empty()) {
+                    if (mMaxReportLatencyNs == 0) {
+                        mCallback->postEvents(events, isWakeUpSensor());
+                    } else {
+                        if (mBatchedEvents.empty()) {
+                            mNextFlushTimeNs = now + mMaxReportLatencyNs;
+                        }
+                        mBatchedEvents.insert(mBatchedEvents.end(), events.begin(), events.end());
+                        if (mBatchedEvents.size() >= kMaxBatchedEvents) {
+                            flushBatchedEventsLocked();
+                        }
+                    }
+                }
             }
 
-            mWaitCV.wait_for(runLock, std::chrono::nanoseconds(nextSampleTime - now));
+            if (!mBatchedEvents.empty() && now >= mNextFlushTimeNs) {
+                flushBatchedEventsLocked();
+            }
+
+            // Sleep until the next sample is due, or earlier if batched events must be
+            // delivered before then.
+            int64_t nextWakeTime = nextSampleTime;
+            if (!mBatchedEvents.empty() && mNextFlushTimeNs < nextWakeTime) {
+                nextWakeTime = mNextFlushTimeNs;
+            }
+            mWaitCV.wait_for(runLock, std::chrono::nanoseconds(nextWakeTime - now));
         }
     }
 }
 
+void Sensor::flushBatchedEventsLocked() {
+    if (!mBatchedEvents.empty()) {
+        mCallback->postEvents(mBatchedEvents, isWakeUpSensor());
+        mBatchedEvents.clear();
+    }
+}
+
 bool Sensor::isWakeUpSensor() {
     return mSensorInfo.flags & static_cast<uint32_t>(SensorInfo::SENSOR_FLAG_BITS_WAKE_UP);
 }
@@ -216,7 +267,12 @@ AccelSensor::AccelSensor(int32_t sensorHandle, ISensorsEventCallback* callback)
     mSensorInfo.fifoReservedEventCount = 0;
     mSensorInfo.fifoMaxEventCount = 0;
     mSensorInfo.requiredPermission = "";
-    mSensorInfo.flags = static_cast<uint32_t>(SensorInfo::SENSOR_FLAG_BITS_DATA_INJECTION);
+    // Supports ashmem direct report channels up to RateLevel::VERY_FAST (800Hz).
+    mSensorInfo.flags = static_cast<uint32_t>(
+            SensorInfo::SENSOR_FLAG_BITS_DATA_INJECTION |
+            SensorInfo::SENSOR_FLAG_BITS_DIRECT_CHANNEL_ASHMEM |
+            (static_cast<int32_t>(ISensors::RateLevel::VERY_FAST)
+             << SensorInfo::SENSOR_FLAG_SHIFT_DIRECT_REPORT));
 };
 
 void AccelSensor::readEventPayload(EventPayload& payload) {
@@ -343,7 +399,11 @@ GyroSensor::GyroSensor(int32_t sensorHandle, ISensorsEventCallback* callback) :
     mSensorInfo.fifoReservedEventCount = 0;
     mSensorInfo.fifoMaxEventCount = 0;
     mSensorInfo.requiredPermission = "";
-    mSensorInfo.flags = 0;
+    // Supports ashmem direct report channels up to RateLevel::VERY_FAST (800Hz).
+    mSensorInfo.flags = static_cast<uint32_t>(
+            SensorInfo::SENSOR_FLAG_BITS_DIRECT_CHANNEL_ASHMEM |
+            (static_cast<int32_t>(ISensors::RateLevel::VERY_FAST)
+             << SensorInfo::SENSOR_FLAG_SHIFT_DIRECT_REPORT));
 };
 
 void GyroSensor::readEventPayload(EventPayload& payload) {
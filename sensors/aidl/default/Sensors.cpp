@@ -42,23 +42,55 @@ ScopedAStatus Sensors::activate(int32_t in_sensorHandle, bool in_enabled) {
 }
 
 ScopedAStatus Sensors::batch(int32_t in_sensorHandle, int64_t in_samplingPeriodNs,
-                             int64_t /* in_maxReportLatencyNs */) {
+                             int64_t in_maxReportLatencyNs) {
     auto sensor = mSensors.find(in_sensorHandle);
     if (sensor != mSensors.end()) {
-        sensor->second->batch(in_samplingPeriodNs);
+        sensor->second->batch(in_samplingPeriodNs, in_maxReportLatencyNs);
         return ScopedAStatus::ok();
     }
 
     return ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
 }
 
-ScopedAStatus Sensors::configDirectReport(int32_t /* in_sensorHandle */,
-                                          int32_t /* in_channelHandle */,
-                                          ISensors::RateLevel /* in_rate */,
-                                          int32_t* _aidl_return) {
-    *_aidl_return = EX_UNSUPPORTED_OPERATION;
+ScopedAStatus Sensors::configDirectReport(int32_t in_sensorHandle, int32_t in_channelHandle,
+                                          ISensors::RateLevel in_rate, int32_t* _aidl_return) {
+    std::lock_guard<std::mutex> lock(mChannelLock);
+    auto channel = mDirectChannels.find(in_channelHandle);
+    if (channel == mDirectChannels.end()) {
+        return ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
+    }
+
+    if (in_rate == ISensors::RateLevel::STOP) {
+        // A sensor handle of -1 denotes all active sensors in the channel.
+        if (in_sensorHandle == -1) {
+            channel->second->stopAll();
+            return ScopedAStatus::ok();
+        }
+        if (!channel->second->stop(in_sensorHandle)) {
+            return ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
+        }
+        return ScopedAStatus::ok();
+    }
+
+    auto sensor = mSensors.find(in_sensorHandle);
+    if (sensor == mSensors.end()) {
+        return ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
+    }
+
+    // The sensor must advertise direct channel support at the requested rate level.
+    const SensorInfo& sensorInfo = sensor->second->getSensorInfo();
+    const uint32_t maxRateLevel =
+            (sensorInfo.flags &
+             static_cast<uint32_t>(SensorInfo::SENSOR_FLAG_BITS_MASK_DIRECT_REPORT)) >>
+            SensorInfo::SENSOR_FLAG_SHIFT_DIRECT_REPORT;
+    if (!(sensorInfo.flags &
+          static_cast<uint32_t>(SensorInfo::SENSOR_FLAG_BITS_DIRECT_CHANNEL_ASHMEM)) ||
+        static_cast<uint32_t>(in_rate) > maxRateLevel) {
+        return ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
+    }
 
-    return ScopedAStatus::fromExceptionCode(EX_UNSUPPORTED_OPERATION);
+    *_aidl_return = channel->second->configure(sensorInfo, in_rate);
+    return ScopedAStatus::ok();
 }
 
 ScopedAStatus Sensors::flush(int32_t in_sensorHandle) {
@@ -133,11 +165,26 @@ ScopedAStatus Sensors::injectSensorData(const Event& in_event) {
     return ScopedAStatus::fromServiceSpecificError(static_cast<int32_t>(ERROR_BAD_VALUE));
 }
 
-ScopedAStatus Sensors::registerDirectChannel(const ISensors::SharedMemInfo& /* in_mem */,
+ScopedAStatus Sensors::registerDirectChannel(const ISensors::SharedMemInfo& in_mem,
                                              int32_t* _aidl_return) {
-    *_aidl_return = EX_UNSUPPORTED_OPERATION;
+    if (in_mem.type != ISensors::SharedMemInfo::SharedMemType::ASHMEM) {
+        // Gralloc-backed channels are not supported by the default implementation.
+        return ScopedAStatus::fromExceptionCode(EX_UNSUPPORTED_OPERATION);
+    }
+    if (in_mem.format != ISensors::SharedMemInfo::SharedMemFormat::SENSORS_EVENT) {
+        return ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
+    }
 
-    return ScopedAStatus::fromExceptionCode(EX_UNSUPPORTED_OPERATION);
+    std::unique_ptr<DirectChannel> channel = DirectChannel::create(in_mem);
+    if (channel == nullptr) {
+        return ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
+    }
+
+    std::lock_guard<std::mutex> lock(mChannelLock);
+    int32_t channelHandle = mNextChannelHandle++;
+    mDirectChannels[channelHandle] = std::move(channel);
+    *_aidl_return = channelHandle;
+    return ScopedAStatus::ok();
 }
 
 ScopedAStatus Sensors::setOperationMode(OperationMode in_mode) {
@@ -147,8 +194,10 @@ ScopedAStatus Sensors::setOperationMode(OperationMode in_mode) {
     return ScopedAStatus::ok();
 }
 
-ScopedAStatus Sensors::unregisterDirectChannel(int32_t /* in_channelHandle */) {
-    return ScopedAStatus::fromExceptionCode(EX_UNSUPPORTED_OPERATION);
+ScopedAStatus Sensors::unregisterDirectChannel(int32_t in_channelHandle) {
+    std::lock_guard<std::mutex> lock(mChannelLock);
+    mDirectChannels.erase(in_channelHandle);
+    return ScopedAStatus::ok();
 }
 
 }  // namespace sensors
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <aidl/android/hardware/sensors/BnSensors.h>
+#include <android-base/unique_fd.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace sensors {
+
+/**
+ * A registered direct report channel backed by an ashmem region shared with the framework.
+ *
+ * The channel owns a writer thread that generates events for every configured sensor at the
+ * nominal rate of its configured RateLevel and writes them into the shared memory in the
+ * DIRECT_REPORT_SENSOR_EVENT format (see ISensors.aidl). Each configured sensor is scheduled
+ * against an absolute deadline that advances by the nominal report interval, so the channel
+ * never accumulates more than one interval of credit and the delivered rate stays within the
+ * (55%, 220%] window that RateLevel requires even after a late wakeup.
+ */
+class DirectChannel {
+  public:
+    using RateLevel = ::aidl::android::hardware::sensors::ISensors::RateLevel;
+    using SensorInfo = ::aidl::android::hardware::sensors::SensorInfo;
+    using SensorType = ::aidl::android::hardware::sensors::SensorType;
+    using SharedMemInfo = ::aidl::android::hardware::sensors::ISensors::SharedMemInfo;
+
+    /**
+     * Maps the shared memory region described by 'mem' and clears it to its initial state.
+     * Returns nullptr if the memory handle is invalid or is smaller than advertised.
+     */
+    static std::unique_ptr<DirectChannel> create(const SharedMemInfo& mem);
+
+    ~DirectChannel();
+
+    // Starts reporting 'sensorInfo' at the given rate, or updates the rate if the sensor is
+    // already configured in this channel. Returns the report token for the sensor.
+    int32_t configure(const SensorInfo& sensorInfo, RateLevel rate);
+
+    // Stops reporting of a single sensor. Returns false if the sensor was not configured in
+    // this channel.
+    bool stop(int32_t sensorHandle);
+
+    // Stops reporting of all sensors configured in this channel.
+    void stopAll();
+
+  private:
+    struct ReportConfig {
+        int32_t reportToken;
+        SensorType type;
+        // Nominal report interval for the configured RateLevel.
+        int64_t intervalNs;
+        // Absolute boottime deadline for the next event of this sensor.
+        int64_t nextEventNs;
+    };
+
+    DirectChannel(::android::base::unique_fd fd, uint8_t* buffer, size_t size);
+
+    static void startThread(DirectChannel* channel);
+    void run();
+    void writeEventLocked(const ReportConfig& config, int64_t timestampNs);
+
+    // The mapped shared memory region and the file descriptor that keeps it alive.
+    ::android::base::unique_fd mFd;
+    uint8_t* const mBuffer;
+    const size_t mSize;
+    // Number of DIRECT_REPORT_SENSOR_EVENT_TOTAL_LENGTH slots in the region.
+    const size_t mCapacity;
+
+    // Monotonically increasing event counter. Starts at 1 and wraps back to 1, skipping 0
+    // since a zero counter marks a slot that has never been written.
+    uint32_t mEventCounter = 1;
+
+    // Sensors currently configured in this channel, keyed by sensor handle.
+    std::map<int32_t, ReportConfig> mConfigs;
+
+    std::atomic_bool mStopThread{false};
+    std::condition_variable mWaitCV;
+    std::mutex mRunMutex;
+    std::thread mRunThread;
+};
+
+}  // namespace sensors
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
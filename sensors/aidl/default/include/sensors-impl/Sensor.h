@@ -45,7 +45,7 @@ class Sensor {
     virtual ~Sensor();
 
     const SensorInfo& getSensorInfo() const;
-    void batch(int64_t samplingPeriodNs);
+    void batch(int64_t samplingPeriodNs, int64_t maxReportLatencyNs);
     virtual void activate(bool enable);
     ndk::ScopedAStatus flush();
 
@@ -61,9 +61,18 @@ class Sensor {
 
     bool isWakeUpSensor();
 
+    // Posts any accumulated batched events. mRunMutex must be held.
+    void flushBatchedEventsLocked();
+
     bool mIsEnabled;
     int64_t mSamplingPeriodNs;
+    int64_t mMaxReportLatencyNs;
     int64_t mLastSampleTimeNs;
+    // Boottime at which the oldest batched event must be delivered at the latest.
+    int64_t mNextFlushTimeNs;
+    // Events accumulated until mNextFlushTimeNs passes or the buffer fills. The buffer is
+    // preallocated and clear() keeps its capacity, so the steady state does not allocate.
+    std::vector<Event> mBatchedEvents;
     SensorInfo mSensorInfo;
 
     std::atomic_bool mStopThread;
@@ -21,6 +21,7 @@
 #include <fmq/AidlMessageQueue.h>
 #include <hardware_legacy/power.h>
 #include <map>
+#include "DirectChannel.h"
 #include "Sensor.h"
 
 namespace aidl {
@@ -41,6 +42,7 @@ class Sensors : public BnSensors, public ISensorsEventCallback {
     Sensors()
         : mEventQueueFlag(nullptr),
           mNextHandle(1),
+          mNextChannelHandle(1),
           mOutstandingWakeUpEvents(0),
           mReadWakeLockQueueRun(false),
           mAutoReleaseWakeLockTime(0),
@@ -194,6 +196,12 @@ class Sensors : public BnSensors, public ISensorsEventCallback {
     std::map<int32_t, std::shared_ptr<Sensor>> mSensors;
     // The next available sensor handle.
     int32_t mNextHandle;
+    // A map of the registered direct report channels.
+    std::map<int32_t, std::unique_ptr<DirectChannel>> mDirectChannels;
+    // The next available direct channel handle.
+    int32_t mNextChannelHandle;
+    // Lock to protect the direct channel map.
+    std::mutex mChannelLock;
     // Lock to protect writes to the FMQs.
     std::mutex mWriteLock;
     // Lock to protect acquiring and releasing the wake lock
@@ -356,6 +356,100 @@ void convertToAidlEvent(const V2_1Event& hidlEvent, AidlEvent* aidlEvent) {
     }
 }
 
+void convertToHidlEvents(const AidlEvent* aidlEvents, V2_1Event* hidlEvents, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        convertToHidlEvent(aidlEvents[i], &hidlEvents[i]);
+    }
+}
+
+void convertToAidlEvents(const V2_1Event* hidlEvents, AidlEvent* aidlEvents, size_t count) {
+    size_t i = 0;
+    while (i < count) {
+        const V2_1SensorType type = hidlEvents[i].sensorType;
+        // Find the run of consecutive events sharing this sensor type so the payload dispatch
+        // below runs once per run rather than once per event.
+        size_t runEnd = i + 1;
+        while (runEnd < count && hidlEvents[runEnd].sensorType == type) {
+            ++runEnd;
+        }
+        switch (type) {
+            case V2_1SensorType::ACCELEROMETER:
+            case V2_1SensorType::MAGNETIC_FIELD:
+            case V2_1SensorType::ORIENTATION:
+            case V2_1SensorType::GYROSCOPE:
+            case V2_1SensorType::GRAVITY:
+            case V2_1SensorType::LINEAR_ACCELERATION:
+                for (; i < runEnd; ++i) {
+                    const V2_1Event& hidlEvent = hidlEvents[i];
+                    AidlEvent& aidlEvent = aidlEvents[i];
+                    aidlEvent.timestamp = hidlEvent.timestamp;
+                    aidlEvent.sensorHandle = hidlEvent.sensorHandle;
+                    aidlEvent.sensorType = (AidlSensorType)type;
+                    AidlEvent::EventPayload::Vec3 vec3;
+                    vec3.x = hidlEvent.u.vec3.x;
+                    vec3.y = hidlEvent.u.vec3.y;
+                    vec3.z = hidlEvent.u.vec3.z;
+                    vec3.status = (AidlSensorStatus)hidlEvent.u.vec3.status;
+                    aidlEvent.payload.set<Event::EventPayload::vec3>(vec3);
+                }
+                break;
+            case V2_1SensorType::MAGNETIC_FIELD_UNCALIBRATED:
+            case V2_1SensorType::GYROSCOPE_UNCALIBRATED:
+            case V2_1SensorType::ACCELEROMETER_UNCALIBRATED:
+                for (; i < runEnd; ++i) {
+                    const V2_1Event& hidlEvent = hidlEvents[i];
+                    AidlEvent& aidlEvent = aidlEvents[i];
+                    aidlEvent.timestamp = hidlEvent.timestamp;
+                    aidlEvent.sensorHandle = hidlEvent.sensorHandle;
+                    aidlEvent.sensorType = (AidlSensorType)type;
+                    AidlEvent::EventPayload::Uncal uncal;
+                    uncal.x = hidlEvent.u.uncal.x;
+                    uncal.y = hidlEvent.u.uncal.y;
+                    uncal.z = hidlEvent.u.uncal.z;
+                    uncal.xBias = hidlEvent.u.uncal.x_bias;
+                    uncal.yBias = hidlEvent.u.uncal.y_bias;
+                    uncal.zBias = hidlEvent.u.uncal.z_bias;
+                    aidlEvent.payload.set<Event::EventPayload::uncal>(uncal);
+                }
+                break;
+            case V2_1SensorType::DEVICE_ORIENTATION:
+            case V2_1SensorType::LIGHT:
+            case V2_1SensorType::PRESSURE:
+            case V2_1SensorType::PROXIMITY:
+            case V2_1SensorType::RELATIVE_HUMIDITY:
+            case V2_1SensorType::AMBIENT_TEMPERATURE:
+            case V2_1SensorType::SIGNIFICANT_MOTION:
+            case V2_1SensorType::STEP_DETECTOR:
+            case V2_1SensorType::TILT_DETECTOR:
+            case V2_1SensorType::WAKE_GESTURE:
+            case V2_1SensorType::GLANCE_GESTURE:
+            case V2_1SensorType::PICK_UP_GESTURE:
+            case V2_1SensorType::WRIST_TILT_GESTURE:
+            case V2_1SensorType::STATIONARY_DETECT:
+            case V2_1SensorType::MOTION_DETECT:
+            case V2_1SensorType::HEART_BEAT:
+            case V2_1SensorType::LOW_LATENCY_OFFBODY_DETECT:
+            case V2_1SensorType::HINGE_ANGLE:
+                for (; i < runEnd; ++i) {
+                    const V2_1Event& hidlEvent = hidlEvents[i];
+                    AidlEvent& aidlEvent = aidlEvents[i];
+                    aidlEvent.timestamp = hidlEvent.timestamp;
+                    aidlEvent.sensorHandle = hidlEvent.sensorHandle;
+                    aidlEvent.sensorType = (AidlSensorType)type;
+                    aidlEvent.payload.set<Event::EventPayload::scalar>(hidlEvent.u.scalar);
+                }
+                break;
+            default:
+                // The remaining payload types never appear in high rate streams; convert them
+                // through the single event path.
+                for (; i < runEnd; ++i) {
+                    convertToAidlEvent(hidlEvents[i], &aidlEvents[i]);
+                }
+                break;
+        }
+    }
+}
+
 }  // namespace implementation
 }  // namespace sensors
 }  // namespace hardware
@@ -43,6 +43,20 @@ void convertToHidlEvent(const ::aidl::android::hardware::sensors::Event& aidlEve
 void convertToAidlEvent(const ::android::hardware::sensors::V2_1::Event& hidlEvent,
                         ::aidl::android::hardware::sensors::Event* aidlEvent);
 
+/**
+ * Bulk version of convertToHidlEvent. Converts count events from aidlEvents into hidlEvents.
+ */
+void convertToHidlEvents(const ::aidl::android::hardware::sensors::Event* aidlEvents,
+                         ::android::hardware::sensors::V2_1::Event* hidlEvents, size_t count);
+
+/**
+ * Bulk version of convertToAidlEvent. Converts count events from hidlEvents into aidlEvents.
+ * Runs of events with the same sensor type, the common shape of batched IMU streams, are
+ * converted through tight per-type loops instead of re-entering the type dispatch per event.
+ */
+void convertToAidlEvents(const ::android::hardware::sensors::V2_1::Event* hidlEvents,
+                         ::aidl::android::hardware::sensors::Event* aidlEvents, size_t count);
+
 }  // namespace implementation
 }  // namespace sensors
 }  // namespace hardware
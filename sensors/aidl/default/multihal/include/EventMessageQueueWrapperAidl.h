@@ -48,34 +48,26 @@ class EventMessageQueueWrapperAidl
     virtual bool read(::android::hardware::sensors::V2_1::Event* events,
                       size_t numToRead) override {
         bool success = mQueue->read(mIntermediateEventBuffer.data(), numToRead);
-        for (int i = 0; i < numToRead; ++i) {
-            convertToHidlEvent(mIntermediateEventBuffer[i], &events[i]);
-        }
+        convertToHidlEvents(mIntermediateEventBuffer.data(), events, numToRead);
         return success;
     }
 
     bool write(const ::android::hardware::sensors::V2_1::Event* events,
                size_t numToWrite) override {
-        for (int i = 0; i < numToWrite; ++i) {
-            convertToAidlEvent(events[i], &mIntermediateEventBuffer[i]);
-        }
+        convertToAidlEvents(events, mIntermediateEventBuffer.data(), numToWrite);
         return mQueue->write(mIntermediateEventBuffer.data(), numToWrite);
     }
 
     virtual bool write(
             const std::vector<::android::hardware::sensors::V2_1::Event>& events) override {
-        for (int i = 0; i < events.size(); ++i) {
-            convertToAidlEvent(events[i], &mIntermediateEventBuffer[i]);
-        }
+        convertToAidlEvents(events.data(), mIntermediateEventBuffer.data(), events.size());
         return mQueue->write(mIntermediateEventBuffer.data(), events.size());
     }
 
     bool writeBlocking(const ::android::hardware::sensors::V2_1::Event* events, size_t count,
                        uint32_t readNotification, uint32_t writeNotification, int64_t timeOutNanos,
                        ::android::hardware::EventFlag* evFlag) override {
-        for (int i = 0; i < count; ++i) {
-            convertToAidlEvent(events[i], &mIntermediateEventBuffer[i]);
-        }
+        convertToAidlEvents(events, mIntermediateEventBuffer.data(), count);
         return mQueue->writeBlocking(mIntermediateEventBuffer.data(), count, readNotification,
                                      writeNotification, timeOutNanos, evFlag);
     }
@@ -29,9 +29,15 @@
 #include "SensorsAidlTestSharedMemory.h"
 #include "sensors-vts-utils/SensorsVtsEnvironmentBase.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <cmath>
+#include <cstdlib>
 #include <condition_variable>
+#include <iostream>
 #include <map>
+#include <numeric>
+#include <sstream>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -321,6 +327,8 @@ class SensorsAidlTest : public testing::TestWithParam<std::string> {
 
     void verifyDirectChannel(ISensors::SharedMemInfo::SharedMemType memType);
 
+    void runDirectChannelBenchmark(ISensors::SharedMemInfo::SharedMemType memType);
+
     void verifyRegisterDirectChannel(
             std::shared_ptr<SensorsAidlTestSharedMemory<SensorType, Event>> mem,
             int32_t* directChannelHandle, bool supportsSharedMemType,
@@ -933,6 +941,101 @@ TEST_P(SensorsAidlTest, NoStaleEvents) {
     }
 }
 
+static int64_t percentile(const std::vector<int64_t>& sortedValues, double fraction) {
+    const size_t index = std::min(sortedValues.size() - 1,
+                                  static_cast<size_t>(fraction * (sortedValues.size() - 1) + 0.5));
+    return sortedValues[index];
+}
+
+/*
+ * Activates each continuous sensor at its fastest rate, collects events for a
+ * fixed window, and reports inter-event jitter percentiles per sensor along
+ * with the mean delivered period. The numbers are emitted both on stdout and
+ * as test properties so integration tooling can track vendor timing
+ * regressions across builds. The mean period is checked against the requested
+ * ODR with generous slack; jitter percentiles are informational only, since
+ * acceptable jitter depends on the use case.
+ */
+TEST_P(SensorsAidlTest, EventRateJitter) {
+    constexpr std::chrono::milliseconds kCollectionDuration(2000);
+    // Need a reasonable population of deltas before percentiles mean anything.
+    constexpr size_t kMinEventsForStats = 20;
+    // The CDD requires continuous sensors to deliver within 10% of the
+    // requested frequency; allow extra slack for scheduling noise in the test.
+    constexpr double kMaxMeanPeriodDeviation = 0.2;
+
+    EventCallback callback;
+    getEnvironment()->registerCallback(&callback);
+
+    const std::vector<SensorInfo> sensors = getNonOneShotAndNonOnChangeAndNonSpecialSensors();
+    for (const SensorInfo& sensor : sensors) {
+        checkIsOk(batch(sensor.sensorHandle, static_cast<int64_t>(sensor.minDelayUs) * 1000,
+                        0 /* maxReportLatencyNs */));
+        checkIsOk(activate(sensor.sensorHandle, true));
+    }
+
+    std::this_thread::sleep_for(kCollectionDuration);
+
+    for (const SensorInfo& sensor : sensors) {
+        activate(sensor.sensorHandle, false);
+    }
+    getEnvironment()->unregisterCallback();
+
+    for (const SensorInfo& sensor : sensors) {
+        SCOPED_TRACE(::testing::Message()
+                     << " handle=0x" << std::hex << std::setw(8) << std::setfill('0')
+                     << sensor.sensorHandle << std::dec << " type=" << static_cast<int>(sensor.type)
+                     << " name=" << sensor.name);
+
+        const int64_t requestedPeriodNs = static_cast<int64_t>(sensor.minDelayUs) * 1000;
+        std::vector<int64_t> deltas;
+        int64_t previousTimestamp = 0;
+        for (const Event& event : callback.getEvents(sensor.sensorHandle)) {
+            // Skip non-sample events (e.g. additional info frames) that share
+            // the sensor handle.
+            if (event.sensorType != sensor.type) {
+                continue;
+            }
+            if (previousTimestamp != 0) {
+                deltas.push_back(event.timestamp - previousTimestamp);
+            }
+            previousTimestamp = event.timestamp;
+        }
+
+        if (deltas.size() < kMinEventsForStats) {
+            std::cout << "sensor_rate: name=\"" << sensor.name
+                      << "\" requested_period_ns=" << requestedPeriodNs
+                      << " deltas=" << deltas.size() << " result=insufficient_events" << std::endl;
+            continue;
+        }
+
+        std::sort(deltas.begin(), deltas.end());
+        const int64_t p50 = percentile(deltas, 0.50);
+        const int64_t p95 = percentile(deltas, 0.95);
+        const int64_t p99 = percentile(deltas, 0.99);
+        const double meanPeriodNs =
+                std::accumulate(deltas.begin(), deltas.end(), int64_t(0)) /
+                static_cast<double>(deltas.size());
+        const double deviation =
+                std::abs(meanPeriodNs - requestedPeriodNs) / static_cast<double>(requestedPeriodNs);
+
+        std::ostringstream result;
+        result << "requested_period_ns=" << requestedPeriodNs << " deltas=" << deltas.size()
+               << " mean_period_ns=" << static_cast<int64_t>(meanPeriodNs) << " p50_ns=" << p50
+               << " p95_ns=" << p95 << " p99_ns=" << p99 << " deviation=" << deviation;
+        std::cout << "sensor_rate: name=\"" << sensor.name << "\" " << result.str() << std::endl;
+        std::ostringstream propertyName;
+        propertyName << "sensor_rate_0x" << std::hex << std::setw(8) << std::setfill('0')
+                     << sensor.sensorHandle;
+        RecordProperty(propertyName.str(), result.str());
+
+        EXPECT_LE(deviation, kMaxMeanPeriodDeviation)
+                << "mean delivered period " << meanPeriodNs << "ns deviates from requested "
+                << requestedPeriodNs << "ns by more than "
+                << (kMaxMeanPeriodDeviation * 100) << "%";
+    }
+}
+
 void SensorsAidlTest::checkRateLevel(const SensorInfo& sensor, int32_t directChannelHandle,
                                      ISensors::RateLevel rateLevel, int32_t* reportToken) {
     ndk::ScopedAStatus status =
@@ -1066,6 +1169,117 @@ void SensorsAidlTest::verifyConfigure(const SensorInfo& sensor,
     }
 }
 
+void SensorsAidlTest::runDirectChannelBenchmark(ISensors::SharedMemInfo::SharedMemType memType) {
+    constexpr size_t kNumEvents = 1024;
+    constexpr size_t kMemSize = kNumEvents * kEventSize;
+    constexpr size_t kCounterOffset =
+            static_cast<size_t>(ISensors::DIRECT_REPORT_SENSOR_EVENT_OFFSET_SIZE_ATOMIC_COUNTER);
+    constexpr size_t kTimestampOffset =
+            static_cast<size_t>(ISensors::DIRECT_REPORT_SENSOR_EVENT_OFFSET_SIZE_TIMESTAMP);
+
+    // Per-sensor measurement window. Can be raised for soak runs without recompiling,
+    // e.g. SENSORS_VTS_DIRECT_BENCH_MS=60000.
+    std::chrono::milliseconds benchDuration(2000);
+    if (const char* env = std::getenv("SENSORS_VTS_DIRECT_BENCH_MS"); env != nullptr) {
+        benchDuration = std::chrono::milliseconds(std::max(atoi(env), 100));
+    }
+
+    bool supportsSharedMemType;
+    bool supportsAnyDirectChannel;
+    queryDirectChannelSupport(memType, &supportsSharedMemType, &supportsAnyDirectChannel);
+    if (!supportsSharedMemType) {
+        GTEST_SKIP() << "Direct channel memory type not supported by any sensor";
+    }
+
+    const std::string memTypeName =
+            memType == ISensors::SharedMemInfo::SharedMemType::ASHMEM ? "ashmem" : "gralloc";
+
+    for (const SensorInfo& sensor : getSensorsList()) {
+        if (!isDirectChannelTypeSupported(sensor, memType) ||
+            !isDirectReportRateSupported(sensor, ISensors::RateLevel::VERY_FAST)) {
+            continue;
+        }
+
+        // A fresh channel per sensor: registration zeroes the memory, so every non-zero
+        // atomic counter afterwards belongs to this run.
+        std::shared_ptr<SensorsAidlTestSharedMemory<SensorType, Event>> mem(
+                SensorsAidlTestSharedMemory<SensorType, Event>::create(memType, kMemSize));
+        ASSERT_NE(mem, nullptr);
+
+        int32_t channelHandle = 0;
+        ASSERT_TRUE(registerDirectChannel(mem->getSharedMemInfo(), &channelHandle).isOk());
+        ASSERT_GT(channelHandle, 0);
+
+        int32_t reportToken = 0;
+        auto startTime = std::chrono::steady_clock::now();
+        ASSERT_TRUE(configDirectReport(sensor.sensorHandle, channelHandle,
+                                       ISensors::RateLevel::VERY_FAST, &reportToken)
+                            .isOk());
+        ASSERT_GT(reportToken, 0);
+
+        std::this_thread::sleep_for(benchDuration);
+
+        int32_t stopToken = 0;
+        ASSERT_TRUE(configDirectReport(sensor.sensorHandle, channelHandle,
+                                       ISensors::RateLevel::STOP, &stopToken)
+                            .isOk());
+        int64_t elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now() - startTime)
+                                    .count();
+
+        // Snapshot the ring. The atomic counter is global for the channel and starts at 1,
+        // so the highest counter present is the total number of samples written.
+        char* buffer = mem->getBuffer();
+        std::vector<std::pair<int64_t, int64_t>> samples;  // (counter, timestamp)
+        for (size_t offset = 0; offset + kEventSize <= kMemSize; offset += kEventSize) {
+            int64_t counter = *reinterpret_cast<uint32_t*>(buffer + offset + kCounterOffset);
+            if (counter > 0) {
+                samples.emplace_back(counter, *reinterpret_cast<int64_t*>(buffer + offset +
+                                                                          kTimestampOffset));
+            }
+        }
+        ASSERT_TRUE(unregisterDirectChannel(&channelHandle).isOk());
+
+        EXPECT_FALSE(samples.empty()) << "No samples written over " << memTypeName
+                                      << " direct channel by sensor " << sensor.name;
+        if (samples.empty()) {
+            continue;
+        }
+
+        std::sort(samples.begin(), samples.end());
+        const int64_t totalSamples = samples.back().first;
+        const double rateHz = totalSamples * 1e9 / elapsedNs;
+        const double bandwidthBytesPerSec = rateHz * kEventSize;
+
+        // Write jitter over what is still in the ring; only adjacent counters form a
+        // valid inter-sample delta.
+        std::vector<int64_t> deltas;
+        for (size_t i = 1; i < samples.size(); i++) {
+            if (samples[i].first == samples[i - 1].first + 1) {
+                deltas.push_back(samples[i].second - samples[i - 1].second);
+            }
+        }
+        std::sort(deltas.begin(), deltas.end());
+        const int64_t p50 = deltas.empty() ? 0 : percentile(deltas, 0.50);
+        const int64_t p95 = deltas.empty() ? 0 : percentile(deltas, 0.95);
+        const int64_t p99 = deltas.empty() ? 0 : percentile(deltas, 0.99);
+
+        std::ostringstream line;
+        line << "direct_channel_rate: mem=" << memTypeName << " sensor=\"" << sensor.name
+             << "\" handle=0x" << std::hex << std::setw(8) << std::setfill('0')
+             << sensor.sensorHandle << std::dec << " duration_ns=" << elapsedNs
+             << " samples=" << totalSamples << " rate_hz=" << rateHz << " p50_ns=" << p50
+             << " p95_ns=" << p95 << " p99_ns=" << p99
+             << " bandwidth_bytes_per_sec=" << bandwidthBytesPerSec;
+        std::cout << line.str() << std::endl;
+
+        std::ostringstream key;
+        key << "direct_" << memTypeName << "_rate_hz_0x" << std::hex << std::setw(8)
+            << std::setfill('0') << sensor.sensorHandle;
+        RecordProperty(key.str(), std::to_string(rateHz));
+    }
+}
+
 TEST_P(SensorsAidlTest, DirectChannelAshmem) {
     verifyDirectChannel(ISensors::SharedMemInfo::SharedMemType::ASHMEM);
 }
@@ -1074,6 +1288,14 @@ TEST_P(SensorsAidlTest, DirectChannelGralloc) {
     verifyDirectChannel(ISensors::SharedMemInfo::SharedMemType::GRALLOC);
 }
 
+TEST_P(SensorsAidlTest, DirectChannelAshmemThroughput) {
+    runDirectChannelBenchmark(ISensors::SharedMemInfo::SharedMemType::ASHMEM);
+}
+
+TEST_P(SensorsAidlTest, DirectChannelGrallocThroughput) {
+    runDirectChannelBenchmark(ISensors::SharedMemInfo::SharedMemType::GRALLOC);
+}
+
 GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(SensorsAidlTest);
 INSTANTIATE_TEST_SUITE_P(Sensors, SensorsAidlTest,
                          testing::ValuesIn(android::getAidlHalInstanceNames(ISensors::descriptor)),
@@ -23,6 +23,8 @@
 
 #include <dlfcn.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cinttypes>
 #include <cmath>
 #include <fstream>
@@ -255,10 +257,20 @@ Return<Result> HalProxy::initializeCommon(
         result = Result::BAD_VALUE;
     }
 
+    // (Re)create the per-subHAL ingestion rings; stopThreads() above has joined the previous
+    // merge thread so nobody is reading them.
+    mEventRings.clear();
+    mPostLatencyHistograms.clear();
+    for (size_t i = 0; i < mSubHalList.size(); i++) {
+        mEventRings.push_back(std::make_unique<SubHalEventRing>());
+        mPostLatencyHistograms.push_back(std::make_unique<PostLatencyHistogram>());
+    }
+
     mThreadsRun.store(true);
 
     mPendingWritesThread = std::thread(startPendingWritesThread, this);
     mWakelockThread = std::thread(startWakelockThread, this);
+    mEventMergeThread = std::thread(startEventMergeThread, this);
 
     for (size_t i = 0; i < mSubHalList.size(); i++) {
         Result currRes = mSubHalList[i]->initialize(this, this, i);
@@ -374,15 +386,49 @@ Return<void> HalProxy::debug(const hidl_handle& fd, const hidl_vec<hidl_string>&
            << std::endl;
     stream << " Most events seen on pending write events queue: "
            << mMostEventsObservedPendingWriteEventsQueue << std::endl;
-    if (!mPendingWriteEventsQueue.empty()) {
-        stream << "  Size of events list on front of pending writes queue: "
-               << mPendingWriteEventsQueue.front().first.size() << std::endl;
+    stream << "  Most events seen in the event fmq at write time: " << mEventQueueHighWater.load()
+           << " of " << (mEventQueue != nullptr ? mEventQueue->getQuantumCount() : 0) << std::endl;
+    stream << "  # of blocked writes to the event fmq: " << mWriteBlockedCount.load() << std::endl;
+    stream << "  Time spent blocked writing the event fmq: " << msFromNs(mWriteBlockedTimeNs.load())
+           << " ms" << std::endl;
+    stream << "  # of events dropped: " << mTotalDroppedEvents.load() << std::endl;
+    {
+        // Snapshot the map so the formatting below never runs while a drop path is waiting on
+        // the lock.
+        std::vector<std::pair<int32_t, size_t>> droppedSnapshot;
+        {
+            std::lock_guard<std::mutex> droppedLock(mDroppedEventsLock);
+            droppedSnapshot.assign(mDroppedEventsBySensor.begin(), mDroppedEventsBySensor.end());
+        }
+        for (const auto& droppedEntry : droppedSnapshot) {
+            stream << "    Sensor handle 0x" << std::hex << droppedEntry.first << std::dec << ": "
+                   << droppedEntry.second << " dropped" << std::endl;
+        }
+    }
+    {
+        // A bugreport must never stall event delivery; skip the queue details when the write
+        // mutex is busy instead of waiting for it.
+        std::unique_lock<std::mutex> writeLock(mEventQueueWriteMutex, std::try_to_lock);
+        if (writeLock.owns_lock() && !mPendingWriteEventsQueue.empty()) {
+            stream << "  Size of events list on front of pending writes queue: "
+                   << mPendingWriteEventsQueue.front().first.size() << std::endl;
+        }
     }
     stream << "  # of non-dynamic sensors across all subhals: " << mSensors.size() << std::endl;
     stream << "  # of dynamic sensors across all subhals: " << mDynamicSensors.size() << std::endl;
     stream << "SubHals (" << mSubHalList.size() << "):" << std::endl;
-    for (auto& subHal : mSubHalList) {
+    for (size_t i = 0; i < mSubHalList.size(); i++) {
+        auto& subHal = mSubHalList[i];
         stream << "  Name: " << subHal->getName() << std::endl;
+        if (i < mPostLatencyHistograms.size()) {
+            stream << "  Post latency (<10us, <100us, <1ms, <10ms, <100ms, >=100ms):";
+            for (size_t bucket = 0; bucket < kNumPostLatencyBuckets; bucket++) {
+                stream << " "
+                       << mPostLatencyHistograms[i]->buckets[bucket].load(
+                                  std::memory_order_relaxed);
+            }
+            stream << std::endl;
+        }
         stream << "  Debug dump: " << std::endl;
         android::base::WriteStringToFd(stream.str(), writeFd);
         subHal->debug(fd, args);
@@ -545,12 +591,19 @@ void HalProxy::stopThreads() {
     }
     mWakelockCV.notify_one();
     mEventQueueWriteCV.notify_one();
+    {
+        std::lock_guard<std::mutex> lock(mEventMergeMutex);
+    }
+    mEventMergeCV.notify_one();
     if (mPendingWritesThread.joinable()) {
         mPendingWritesThread.join();
     }
     if (mWakelockThread.joinable()) {
         mWakelockThread.join();
     }
+    if (mEventMergeThread.joinable()) {
+        mEventMergeThread.join();
+    }
 }
 
 void HalProxy::disableAllSensors() {
@@ -582,12 +635,17 @@ void HalProxy::handlePendingWrites() {
             size_t eventQueueSize = mEventQueue->getQuantumCount();
             size_t numToWrite = std::min(pendingWriteEvents.size(), eventQueueSize);
             lock.unlock();
-            if (!mEventQueue->writeBlocking(
-                        pendingWriteEvents.data(), numToWrite,
-                        static_cast<uint32_t>(EventQueueFlagBits::EVENTS_READ),
-                        static_cast<uint32_t>(EventQueueFlagBits::READ_AND_PROCESS),
-                        kPendingWriteTimeoutNs, mEventQueueFlag)) {
+            int64_t writeStartTime = getTimeNow();
+            bool success = mEventQueue->writeBlocking(
+                    pendingWriteEvents.data(), numToWrite,
+                    static_cast<uint32_t>(EventQueueFlagBits::EVENTS_READ),
+                    static_cast<uint32_t>(EventQueueFlagBits::READ_AND_PROCESS),
+                    kPendingWriteTimeoutNs, mEventQueueFlag);
+            mWriteBlockedCount.fetch_add(1, std::memory_order_relaxed);
+            mWriteBlockedTimeNs.fetch_add(getTimeNow() - writeStartTime, std::memory_order_relaxed);
+            if (!success) {
                 ALOGE("Dropping %zu events after blockingWrite failed.", numToWrite);
+                noteDroppedEvents(pendingWriteEvents, 0, numToWrite);
                 if (numWakeupEvents > 0) {
                     if (pendingWriteEvents.size() > eventQueueSize) {
                         decrementRefCountAndMaybeReleaseWakelock(
@@ -618,8 +676,24 @@ void HalProxy::startWakelockThread(HalProxy* halProxy) {
 void HalProxy::handleWakelocks() {
     std::unique_lock<std::recursive_mutex> lock(mWakelockMutex);
     while (mThreadsRun.load()) {
-        mWakelockCV.wait(lock, [&] { return mWakelockRefCount > 0 || !mThreadsRun.load(); });
+        mWakelockCV.wait(lock, [&] {
+            return mWakelockRefCount > 0 || mWakelockReleasePending || !mThreadsRun.load();
+        });
         if (mThreadsRun.load()) {
+            if (mWakelockRefCount == 0) {
+                // The refcount reached zero but the kernel wakelock is kept through a short
+                // hysteresis window so a burst of wakeup events does not toggle the suspend
+                // blocker once per event group.
+                int64_t elapsed = getTimeNow() - mWakelockReleaseStartTime;
+                if (elapsed >= kWakelockReleaseHysteresisNs) {
+                    mWakelockReleasePending = false;
+                    release_wake_lock(kWakelockName);
+                } else {
+                    mWakelockCV.wait_for(
+                            lock, std::chrono::nanoseconds(kWakelockReleaseHysteresisNs - elapsed));
+                }
+                continue;
+            }
             int64_t timeLeft;
             if (sharedWakelockDidTimeout(&timeLeft)) {
                 resetSharedWakelock();
@@ -638,6 +712,10 @@ void HalProxy::handleWakelocks() {
         }
     }
     resetSharedWakelock();
+    if (mWakelockReleasePending) {
+        mWakelockReleasePending = false;
+        release_wake_lock(kWakelockName);
+    }
 }
 
 bool HalProxy::sharedWakelockDidTimeout(int64_t* timeLeft) {
@@ -660,11 +738,75 @@ void HalProxy::resetSharedWakelock() {
 
 void HalProxy::postEventsToMessageQueue(const std::vector<Event>& events, size_t numWakeupEvents,
                                         V2_0::implementation::ScopedWakelock wakelock) {
-    size_t numToWrite = 0;
-    std::lock_guard<std::mutex> lock(mEventQueueWriteMutex);
+    if (events.empty()) {
+        return;
+    }
+    int64_t postStartTime = getTimeNow();
+    // The wakeup events must be accounted for while the subHAL's wakelock is still held, so the
+    // ref count is taken synchronously even when the events themselves get parked in the ring.
     if (wakelock.isLocked()) {
         incrementRefCountAndMaybeAcquireWakelock(numWakeupEvents);
     }
+
+    size_t subHalIndex = extractSubHalIndex(events[0].sensorHandle);
+    SubHalEventRing* ring =
+            subHalIndex < mEventRings.size() ? mEventRings[subHalIndex].get() : nullptr;
+    if (ring == nullptr) {
+        std::lock_guard<std::mutex> lock(mEventQueueWriteMutex);
+        writeEventsToMessageQueueLocked(events);
+        recordPostLatency(subHalIndex, getTimeNow() - postStartTime);
+        return;
+    }
+
+    // Fast path: when this subHAL has nothing parked in its ring and the write mutex is
+    // uncontended, write directly like before. Otherwise park the events in the subHAL's ring --
+    // one subHAL's write then never blocks another subHAL's post -- and let the merge thread
+    // drain the rings in timestamp order. The empty-ring check keeps events of one subHAL in
+    // posting order: the ring is only ever drained with the write mutex held, so a non-empty
+    // ring means earlier events have not been written yet.
+    if (ring->readPos.load(std::memory_order_relaxed) ==
+        ring->writePos.load(std::memory_order_relaxed)) {
+        std::unique_lock<std::mutex> lock(mEventQueueWriteMutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            writeEventsToMessageQueueLocked(events);
+            lock.unlock();
+            recordPostLatency(subHalIndex, getTimeNow() - postStartTime);
+            return;
+        }
+    }
+
+    const size_t capacity = ring->buffer.size();
+    size_t writePos = ring->writePos.load(std::memory_order_relaxed);
+    size_t readPos = ring->readPos.load(std::memory_order_acquire);
+    size_t numToEnqueue = std::min(events.size(), capacity - (writePos - readPos));
+    for (size_t i = 0; i < numToEnqueue; i++) {
+        ring->buffer[(writePos + i) & (capacity - 1)] = events[i];
+    }
+    ring->writePos.store(writePos + numToEnqueue, std::memory_order_release);
+    if (numToEnqueue < events.size()) {
+        ALOGE("Dropping %zu events of subhal %zu, ingestion ring is full.",
+              events.size() - numToEnqueue, subHalIndex);
+        noteDroppedEvents(events, numToEnqueue, events.size() - numToEnqueue);
+        size_t numWakeupEventsDropped = 0;
+        for (size_t i = numToEnqueue; i < events.size(); i++) {
+            if (mSensors[events[i].sensorHandle].flags &
+                static_cast<uint32_t>(V1_0::SensorFlagBits::WAKE_UP)) {
+                numWakeupEventsDropped++;
+            }
+        }
+        if (numWakeupEventsDropped > 0) {
+            decrementRefCountAndMaybeReleaseWakelock(numWakeupEventsDropped);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(mEventMergeMutex);
+    }
+    mEventMergeCV.notify_one();
+    recordPostLatency(subHalIndex, getTimeNow() - postStartTime);
+}
+
+void HalProxy::writeEventsToMessageQueueLocked(const std::vector<Event>& events) {
+    size_t numToWrite = 0;
     if (mPendingWriteEventsQueue.empty()) {
         numToWrite = std::min(events.size(), mEventQueue->availableToWrite());
         if (numToWrite > 0) {
@@ -677,16 +819,99 @@ void HalProxy::postEventsToMessageQueue(const std::vector<Event>& events, size_t
             }
         }
     }
+    updateEventQueueHighWater(mEventQueue->getQuantumCount() - mEventQueue->availableToWrite());
     size_t numLeft = events.size() - numToWrite;
-    if (numToWrite < events.size() &&
-        mSizePendingWriteEventsQueue + numLeft <= kMaxSizePendingWriteEventsQueue) {
-        std::vector<Event> eventsLeft(events.begin() + numToWrite, events.end());
-        mPendingWriteEventsQueue.push({eventsLeft, numWakeupEvents});
-        mSizePendingWriteEventsQueue += numLeft;
-        mMostEventsObservedPendingWriteEventsQueue =
-                std::max(mMostEventsObservedPendingWriteEventsQueue, mSizePendingWriteEventsQueue);
-        mEventQueueWriteCV.notify_one();
+    if (numToWrite < events.size()) {
+        if (mSizePendingWriteEventsQueue + numLeft <= kMaxSizePendingWriteEventsQueue) {
+            std::vector<Event> eventsLeft(events.begin() + numToWrite, events.end());
+            size_t numWakeupEventsLeft = countNumWakeupEvents(eventsLeft, eventsLeft.size());
+            mPendingWriteEventsQueue.push({eventsLeft, numWakeupEventsLeft});
+            mSizePendingWriteEventsQueue += numLeft;
+            mMostEventsObservedPendingWriteEventsQueue = std::max(
+                    mMostEventsObservedPendingWriteEventsQueue, mSizePendingWriteEventsQueue);
+            mEventQueueWriteCV.notify_one();
+        } else {
+            ALOGE("Dropping %zu events, pending write events queue is full.", numLeft);
+            noteDroppedEvents(events, numToWrite, numLeft);
+        }
+    }
+}
+
+void HalProxy::noteDroppedEvents(const std::vector<Event>& events, size_t offset,
+                                 size_t numDropped) {
+    mTotalDroppedEvents.fetch_add(numDropped, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mDroppedEventsLock);
+    for (size_t i = offset; i < offset + numDropped; i++) {
+        mDroppedEventsBySensor[events[i].sensorHandle]++;
+    }
+}
+
+void HalProxy::recordPostLatency(size_t subHalIndex, int64_t latencyNs) {
+    if (subHalIndex >= mPostLatencyHistograms.size()) {
+        return;
+    }
+    size_t bucket = 0;
+    while (bucket < kNumPostLatencyBuckets - 1 && latencyNs >= kPostLatencyBucketLimitsNs[bucket]) {
+        bucket++;
+    }
+    mPostLatencyHistograms[subHalIndex]->buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void HalProxy::updateEventQueueHighWater(size_t depth) {
+    size_t highWater = mEventQueueHighWater.load(std::memory_order_relaxed);
+    while (depth > highWater &&
+           !mEventQueueHighWater.compare_exchange_weak(highWater, depth,
+                                                       std::memory_order_relaxed)) {
+    }
+}
+
+void HalProxy::startEventMergeThread(HalProxy* halProxy) {
+    halProxy->handleEventMerges();
+}
+
+void HalProxy::handleEventMerges() {
+    std::vector<Event> batch;
+    std::unique_lock<std::mutex> lock(mEventMergeMutex);
+    while (mThreadsRun.load()) {
+        mEventMergeCV.wait(lock, [&] { return anyEventRingNonEmpty() || !mThreadsRun.load(); });
+        if (!mThreadsRun.load()) break;
+        lock.unlock();
+        batch.clear();
+        {
+            std::lock_guard<std::mutex> writeLock(mEventQueueWriteMutex);
+            for (auto& ringPtr : mEventRings) {
+                SubHalEventRing& ring = *ringPtr;
+                const size_t capacity = ring.buffer.size();
+                size_t readPos = ring.readPos.load(std::memory_order_relaxed);
+                size_t writePos = ring.writePos.load(std::memory_order_acquire);
+                const size_t mergeStart = batch.size();
+                for (size_t i = readPos; i != writePos; i++) {
+                    batch.push_back(ring.buffer[i & (capacity - 1)]);
+                }
+                ring.readPos.store(writePos, std::memory_order_release);
+                // Each ring is already in timestamp order; merge it into the sorted batch
+                // built from the previous rings.
+                std::inplace_merge(batch.begin(), batch.begin() + mergeStart, batch.end(),
+                                   [](const Event& lhs, const Event& rhs) {
+                                       return lhs.timestamp < rhs.timestamp;
+                                   });
+            }
+            if (!batch.empty()) {
+                writeEventsToMessageQueueLocked(batch);
+            }
+        }
+        lock.lock();
+    }
+}
+
+bool HalProxy::anyEventRingNonEmpty() {
+    for (auto& ring : mEventRings) {
+        if (ring->readPos.load(std::memory_order_relaxed) !=
+            ring->writePos.load(std::memory_order_acquire)) {
+            return true;
+        }
     }
+    return false;
 }
 
 bool HalProxy::incrementRefCountAndMaybeAcquireWakelock(size_t delta,
@@ -694,7 +919,13 @@ bool HalProxy::incrementRefCountAndMaybeAcquireWakelock(size_t delta,
     if (!mThreadsRun.load()) return false;
     std::lock_guard<std::recursive_mutex> lockGuard(mWakelockMutex);
     if (mWakelockRefCount == 0) {
-        acquire_wake_lock(PARTIAL_WAKE_LOCK, kWakelockName);
+        if (mWakelockReleasePending) {
+            // The kernel wakelock is still held from the hysteresis window; reuse it instead
+            // of issuing another acquire syscall.
+            mWakelockReleasePending = false;
+        } else {
+            acquire_wake_lock(PARTIAL_WAKE_LOCK, kWakelockName);
+        }
         mWakelockCV.notify_one();
     }
     mWakelockTimeoutStartTime = getTimeNow();
@@ -717,7 +948,11 @@ void HalProxy::decrementRefCountAndMaybeReleaseWakelock(size_t delta,
     if (mWakelockRefCount == 0 || timeoutStart < mWakelockTimeoutResetTime) return;
     mWakelockRefCount -= std::min(mWakelockRefCount, delta);
     if (mWakelockRefCount == 0) {
-        release_wake_lock(kWakelockName);
+        // Defer the kernel release to the wakelock thread, which drops it after the hysteresis
+        // window unless a new reference arrives first.
+        mWakelockReleasePending = true;
+        mWakelockReleaseStartTime = getTimeNow();
+        mWakelockCV.notify_one();
     }
 }
 
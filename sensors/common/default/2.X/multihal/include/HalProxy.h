@@ -216,6 +216,45 @@ class HalProxy : public V2_0::implementation::IScopedWakelockRefCounter,
     //! The number of events in the pending write events queue
     size_t mSizePendingWriteEventsQueue = 0;
 
+    // Event queue instrumentation below. The counters are atomics that the post path updates
+    // without any extra locking so debug() can read them while events are flowing.
+
+    //! The most events ever observed in the event fmq at write time.
+    std::atomic<size_t> mEventQueueHighWater{0};
+
+    //! The total number of events dropped on any path.
+    std::atomic<size_t> mTotalDroppedEvents{0};
+
+    //! The number of times a pending write blocked on the event fmq.
+    std::atomic<size_t> mWriteBlockedCount{0};
+
+    //! Cumulative nanoseconds pending writes have spent blocked on the event fmq.
+    std::atomic<int64_t> mWriteBlockedTimeNs{0};
+
+    //! Per-sensor dropped event counts. Only the (already exceptional) drop paths and debug()
+    //! take this lock.
+    std::mutex mDroppedEventsLock;
+    std::map<int32_t, size_t> mDroppedEventsBySensor;
+
+    //! Upper bounds (exclusive, in ns) of the post latency histogram buckets; the final bucket
+    //! counts everything at or above the last bound.
+    static constexpr int64_t kPostLatencyBucketLimitsNs[] = {10000, 100000, 1000000, 10000000,
+                                                             100000000};
+    static constexpr size_t kNumPostLatencyBuckets =
+            sizeof(kPostLatencyBucketLimitsNs) / sizeof(kPostLatencyBucketLimitsNs[0]) + 1;
+
+    /**
+     * Histogram of time one subHAL's threads spend in postEventsToMessageQueue(). The buckets
+     * are bumped with relaxed atomics so recording never takes a lock and debug() can read them
+     * while events are flowing.
+     */
+    struct PostLatencyHistogram {
+        std::atomic<uint64_t> buckets[kNumPostLatencyBuckets] = {};
+    };
+
+    //! Per-subHAL post latency histograms, indexed by subHAL index.
+    std::vector<std::unique_ptr<PostLatencyHistogram>> mPostLatencyHistograms;
+
     //! The mutex protecting writing to the fmq and the pending events queue
     std::mutex mEventQueueWriteMutex;
 
@@ -225,6 +264,33 @@ class HalProxy : public V2_0::implementation::IScopedWakelockRefCounter,
     //! The thread object ptr that handles pending writes
     std::thread mPendingWritesThread;
 
+    //! The capacity of each subHAL's event ingestion ring; must be a power of two.
+    static constexpr size_t kSubHalRingCapacity = 1024;
+
+    /**
+     * Single-producer single-consumer ring of events posted by one subHAL. The subHAL's posting
+     * thread is the producer and the event merge thread is the consumer; the positions are
+     * synchronized with acquire/release so neither side takes a lock. A post that finds the
+     * event queue write mutex contended parks its events here instead of blocking behind
+     * another subHAL's write.
+     */
+    struct SubHalEventRing {
+        SubHalEventRing() : buffer(kSubHalRingCapacity) {}
+        std::vector<Event> buffer;
+        std::atomic<size_t> writePos{0};
+        std::atomic<size_t> readPos{0};
+    };
+
+    //! Per-subHAL event ingestion rings, indexed by subHAL index.
+    std::vector<std::unique_ptr<SubHalEventRing>> mEventRings;
+
+    //! The mutex and condition variable waking the event merge thread
+    std::mutex mEventMergeMutex;
+    std::condition_variable mEventMergeCV;
+
+    //! The thread that drains the ingestion rings into the event fmq in timestamp order
+    std::thread mEventMergeThread;
+
     //! The thread object that handles wakelocks
     std::thread mWakelockThread;
 
@@ -251,6 +317,17 @@ class HalProxy : public V2_0::implementation::IScopedWakelockRefCounter,
 
     const char* kWakelockName = "SensorsHAL_WAKEUP";
 
+    //! How long the kernel wakelock is kept after the refcount drops to zero. Bursty wakeup
+    //! streams re-reference the still-held wakelock instead of toggling the suspend blocker
+    //! once per event group.
+    static constexpr int64_t kWakelockReleaseHysteresisNs = 100 * 1000000;  // 100 ms
+
+    //! Whether the refcount has reached zero but the kernel wakelock release is still deferred
+    bool mWakelockReleasePending = false;
+
+    //! Time at which the refcount reached zero and the hysteresis window started
+    int64_t mWakelockReleaseStartTime = 0;
+
     /**
      * Initialize the list of SubHal objects in mSubHalList by reading from dynamic libraries
      * listed in a config file.
@@ -303,6 +380,39 @@ class HalProxy : public V2_0::implementation::IScopedWakelockRefCounter,
     //! Handles the pending writes on events to eventqueue.
     void handlePendingWrites();
 
+    /**
+     * Starts the thread that merges the subHAL ingestion rings into the event fmq.
+     *
+     * @param halProxy The HalProxy object pointer.
+     */
+    static void startEventMergeThread(HalProxy* halProxy);
+
+    //! Drains the ingestion rings into the event fmq in timestamp order.
+    void handleEventMerges();
+
+    //! Returns true if any subHAL ingestion ring has events waiting to be merged.
+    bool anyEventRingNonEmpty();
+
+    /**
+     * Writes events to the event fmq if there is room, otherwise pushes the remainder onto the
+     * pending write events queue. mEventQueueWriteMutex must be held.
+     *
+     * @param events The events to write, with the subHAL index already set in the handles.
+     */
+    void writeEventsToMessageQueueLocked(const std::vector<Event>& events);
+
+    /**
+     * Accounts for numDropped events starting at offset in events being dropped, updating the
+     * total and per-sensor drop counters.
+     */
+    void noteDroppedEvents(const std::vector<Event>& events, size_t offset, size_t numDropped);
+
+    //! Raises the event fmq high-water mark to depth if it is larger than the current mark.
+    void updateEventQueueHighWater(size_t depth);
+
+    //! Adds one sample to subHalIndex's post latency histogram.
+    void recordPostLatency(size_t subHalIndex, int64_t latencyNs);
+
     /**
      * Starts the thread that handles decrementing the ref count on wakeup events processed by the
      * framework and timing out wakelocks.
@@ -0,0 +1,216 @@
+//
+// Copyright (C) 2023 The Android Open Source Project
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <android/hardware/sensors/1.0/types.h>
+#include <android/hardware/sensors/2.0/types.h>
+#include <android/hardware/sensors/2.1/types.h>
+#include <fmq/MessageQueue.h>
+
+#include "HalProxy.h"
+#include "SensorsSubHal.h"
+#include "convertV2_1.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using ::android::hardware::EventFlag;
+using ::android::hardware::hidl_vec;
+using ::android::hardware::MessageQueue;
+using ::android::hardware::Return;
+using ::android::hardware::sensors::V1_0::EventPayload;
+using ::android::hardware::sensors::V1_0::SensorInfo;
+using ::android::hardware::sensors::V1_0::SensorType;
+using ::android::hardware::sensors::V2_0::EventQueueFlagBits;
+using ::android::hardware::sensors::V2_0::WakeLockQueueFlagBits;
+using ::android::hardware::sensors::V2_1::implementation::convertToNewEvents;
+using ::android::hardware::sensors::V2_1::implementation::HalProxy;
+using ::android::hardware::sensors::V2_1::subhal::implementation::AllSensorsSubHal;
+using ::android::hardware::sensors::V2_1::subhal::implementation::SensorsSubHalV2_0;
+
+using ISensorsCallbackV2_0 = ::android::hardware::sensors::V2_0::ISensorsCallback;
+using EventV1_0 = ::android::hardware::sensors::V1_0::Event;
+using EventV2_1 = ::android::hardware::sensors::V2_1::Event;
+using EventMessageQueueV2_0 = MessageQueue<EventV1_0, ::android::hardware::kSynchronizedReadWrite>;
+using WakeupMessageQueue = MessageQueue<uint32_t, ::android::hardware::kSynchronizedReadWrite>;
+
+constexpr size_t kQueueSize = 1024;
+
+class NoOpSensorsCallback : public ISensorsCallbackV2_0 {
+  public:
+    Return<void> onDynamicSensorsConnected(
+            const hidl_vec<SensorInfo>& /*dynamicSensorsAdded*/) override {
+        return Return<void>();
+    }
+
+    Return<void> onDynamicSensorsDisconnected(
+            const hidl_vec<int32_t>& /*dynamicSensorHandlesRemoved*/) override {
+        return Return<void>();
+    }
+};
+
+EventV1_0 makeAccelerometerEvent() {
+    EventV1_0 event;
+    event.timestamp = 0xFF00FF00;
+    // Non-wakeup sensor handle for the AllSensorsSubHal sensor list.
+    event.sensorHandle = 0x00000001;
+    event.sensorType = SensorType::ACCELEROMETER;
+    event.u = EventPayload();
+    return event;
+}
+
+EventV1_0 makeProximityEvent() {
+    EventV1_0 event;
+    event.timestamp = 0xFF00FF00;
+    // Proximity is a wakeup sensor in the AllSensorsSubHal sensor list.
+    event.sensorHandle = 0x00000008;
+    event.sensorType = SensorType::PROXIMITY;
+    event.u = EventPayload();
+    return event;
+}
+
+/**
+ * Stands up a HalProxy over a configurable number of fake subHALs together
+ * with a drain thread that plays the framework's role: it empties the event
+ * FMQ and, for wakeup storms, acks the drained events on the wake lock FMQ so
+ * the proxy can release its wake lock. Event posting itself is driven from
+ * the benchmark loop.
+ */
+class HalProxyBenchmarkEnv {
+  public:
+    HalProxyBenchmarkEnv(size_t numSubHals, bool wakeup) : mWakeup(wakeup) {
+        for (size_t i = 0; i < numSubHals; i++) {
+            mSubHals.push_back(std::make_unique<AllSensorsSubHal<SensorsSubHalV2_0>>());
+            mSubHalPtrs.push_back(mSubHals.back().get());
+        }
+        mProxy = std::make_unique<HalProxy>(mSubHalPtrs);
+        mEventQueue = std::make_unique<EventMessageQueueV2_0>(kQueueSize, true);
+        mWakeLockQueue = std::make_unique<WakeupMessageQueue>(kQueueSize, true);
+        EventFlag::createEventFlag(mEventQueue->getEventFlagWord(), &mEventQueueFlag);
+        EventFlag::createEventFlag(mWakeLockQueue->getEventFlagWord(), &mWakeLockQueueFlag);
+        mProxy->initialize(*mEventQueue->getDesc(), *mWakeLockQueue->getDesc(),
+                           new NoOpSensorsCallback());
+        mDrainThread = std::thread([this] { drainLoop(); });
+    }
+
+    ~HalProxyBenchmarkEnv() {
+        mStop = true;
+        if (mDrainThread.joinable()) {
+            mDrainThread.join();
+        }
+        mProxy.reset();
+        EventFlag::deleteEventFlag(&mEventQueueFlag);
+        EventFlag::deleteEventFlag(&mWakeLockQueueFlag);
+    }
+
+    AllSensorsSubHal<SensorsSubHalV2_0>& subHal(size_t index) { return *mSubHals[index]; }
+
+  private:
+    void drainLoop() {
+        constexpr int64_t kReadBlockingTimeout = INT64_C(50000000);  // 50 ms
+        std::vector<EventV1_0> events(kQueueSize);
+        while (!mStop) {
+            size_t available = mEventQueue->availableToRead();
+            size_t toRead = available != 0 ? std::min(available, events.size()) : 1;
+            if (mEventQueue->readBlocking(events.data(), toRead,
+                                          static_cast<uint32_t>(EventQueueFlagBits::EVENTS_READ),
+                                          static_cast<uint32_t>(
+                                                  EventQueueFlagBits::READ_AND_PROCESS),
+                                          kReadBlockingTimeout, mEventQueueFlag) &&
+                mWakeup) {
+                uint32_t numAcked = static_cast<uint32_t>(toRead);
+                mWakeLockQueue->write(&numAcked);
+                mWakeLockQueueFlag->wake(
+                        static_cast<uint32_t>(WakeLockQueueFlagBits::DATA_WRITTEN));
+            }
+        }
+    }
+
+    const bool mWakeup;
+    std::vector<std::unique_ptr<AllSensorsSubHal<SensorsSubHalV2_0>>> mSubHals;
+    std::vector<ISensorsSubHal*> mSubHalPtrs;
+    std::unique_ptr<HalProxy> mProxy;
+    std::unique_ptr<EventMessageQueueV2_0> mEventQueue;
+    std::unique_ptr<WakeupMessageQueue> mWakeLockQueue;
+    EventFlag* mEventQueueFlag = nullptr;
+    EventFlag* mWakeLockQueueFlag = nullptr;
+    std::atomic<bool> mStop{false};
+    std::thread mDrainThread;
+};
+
+/**
+ * Measures the non-wakeup ingestion path: time per postEvents() call and
+ * events/second through the proxy into the event FMQ, for a configurable
+ * subHAL count and batch size. Posts rotate across the subHALs so each
+ * callback wrapper is exercised.
+ */
+void BM_PostNonWakeupEvents(benchmark::State& state) {
+    const size_t numSubHals = static_cast<size_t>(state.range(0));
+    const size_t eventsPerPost = static_cast<size_t>(state.range(1));
+    HalProxyBenchmarkEnv env(numSubHals, false /* wakeup */);
+    const std::vector<EventV2_1> events =
+            convertToNewEvents(std::vector<EventV1_0>(eventsPerPost, makeAccelerometerEvent()));
+
+    size_t subHalIndex = 0;
+    for (auto _ : state) {
+        env.subHal(subHalIndex).postEvents(events, false /* wakeup */);
+        subHalIndex = (subHalIndex + 1) % numSubHals;
+    }
+    state.SetItemsProcessed(state.iterations() * eventsPerPost);
+}
+
+/**
+ * Same as above for the wakeup path, which additionally pays for the proxy's
+ * wake lock bookkeeping and the ack round trip on the wake lock FMQ.
+ */
+void BM_PostWakeupEvents(benchmark::State& state) {
+    const size_t numSubHals = static_cast<size_t>(state.range(0));
+    const size_t eventsPerPost = static_cast<size_t>(state.range(1));
+    HalProxyBenchmarkEnv env(numSubHals, true /* wakeup */);
+    const std::vector<EventV2_1> events =
+            convertToNewEvents(std::vector<EventV1_0>(eventsPerPost, makeProximityEvent()));
+
+    size_t subHalIndex = 0;
+    for (auto _ : state) {
+        env.subHal(subHalIndex).postEvents(events, true /* wakeup */);
+        subHalIndex = (subHalIndex + 1) % numSubHals;
+    }
+    state.SetItemsProcessed(state.iterations() * eventsPerPost);
+}
+
+BENCHMARK(BM_PostNonWakeupEvents)
+        ->ArgNames({"subHals", "eventsPerPost"})
+        ->Args({1, 1})
+        ->Args({1, 64})
+        ->Args({2, 64})
+        ->Args({4, 64})
+        ->Args({5, 64})
+        ->Args({5, 256});
+
+BENCHMARK(BM_PostWakeupEvents)
+        ->ArgNames({"subHals", "eventsPerPost"})
+        ->Args({1, 1})
+        ->Args({1, 64})
+        ->Args({5, 64});
+
+}  // namespace
+
+BENCHMARK_MAIN();
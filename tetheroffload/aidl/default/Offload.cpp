@@ -49,8 +49,11 @@ ndk::ScopedAStatus Offload::getForwardedStats(const std::string& in_upstream,
                                               ForwardedStats* _aidl_return) {
     LOG(VERBOSE) << __func__ << " Upstream: " << in_upstream;
     ForwardedStats stats;
-    stats.rxBytes = 0;
-    stats.txBytes = 0;
+    std::shared_ptr<UpstreamStats> upstreamStats = getUpstreamStats(in_upstream);
+    // Drain the delta counters; the contract requires them to read as zero
+    // until more traffic is forwarded.
+    stats.rxBytes = upstreamStats->rxBytes.exchange(0);
+    stats.txBytes = upstreamStats->txBytes.exchange(0);
     *_aidl_return = std::move(stats);
     return ndk::ScopedAStatus::ok();
 }
@@ -111,6 +114,9 @@ ndk::ScopedAStatus Offload::setDataWarningAndLimit(const std::string& in_upstrea
         return ndk::ScopedAStatus::fromExceptionCodeWithMessage(EX_ILLEGAL_ARGUMENT,
                                                                 "Threshold must be non-negative");
     }
+    std::shared_ptr<UpstreamStats> upstreamStats = getUpstreamStats(in_upstream);
+    upstreamStats->warningBytes = in_warningBytes;
+    upstreamStats->limitBytes = in_limitBytes;
     return ndk::ScopedAStatus::ok();
 }
 
@@ -173,6 +179,8 @@ ndk::ScopedAStatus Offload::stopOffload() {
                 EX_ILLEGAL_STATE, "Tetheroffload HAL not initialized");
     }
     mInitialized = false;
+    std::lock_guard<std::mutex> lock(mStatsLock);
+    mUpstreamStats.clear();
     return ndk::ScopedAStatus::ok();
 };
 
@@ -180,6 +188,15 @@ bool Offload::isInitialized() {
     return (mInitialized == true);
 }
 
+std::shared_ptr<Offload::UpstreamStats> Offload::getUpstreamStats(const std::string& upstream) {
+    std::lock_guard<std::mutex> lock(mStatsLock);
+    std::shared_ptr<UpstreamStats>& upstreamStats = mUpstreamStats[upstream];
+    if (upstreamStats == nullptr) {
+        upstreamStats = std::make_shared<UpstreamStats>();
+    }
+    return upstreamStats;
+}
+
 bool Offload::isValidInterface(const std::string& iface) {
     return !iface.empty() && iface != "invalid";
 }
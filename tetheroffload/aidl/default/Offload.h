@@ -16,6 +16,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include <aidl/android/hardware/tetheroffload/BnOffload.h>
 
 namespace aidl {
@@ -61,9 +66,24 @@ class Offload : public BnOffload {
     bool validateIpAddressOrPrefix(const std::string& repr, const int expectedFamily,
                                    const bool isPrefix);
 
+    // Per-upstream delta counters. An offload datapath bumps rxBytes/txBytes
+    // as it forwards traffic; getForwardedStats drains them with exchange(0),
+    // matching the reset-after-query contract, without taking mStatsLock on
+    // the counter accesses themselves.
+    struct UpstreamStats {
+        std::atomic<uint64_t> rxBytes{0};
+        std::atomic<uint64_t> txBytes{0};
+        std::atomic<int64_t> warningBytes{-1};
+        std::atomic<int64_t> limitBytes{-1};
+    };
+    std::shared_ptr<UpstreamStats> getUpstreamStats(const std::string& upstream);
+
     bool mInitialized = false;
     ndk::ScopedFileDescriptor mFd1;
     ndk::ScopedFileDescriptor mFd2;
+    // Guards insertion into mUpstreamStats only; the entries are stable.
+    std::mutex mStatsLock;
+    std::unordered_map<std::string, std::shared_ptr<UpstreamStats>> mUpstreamStats;
 };
 
 }  // namespace example
@@ -81,13 +81,13 @@ ScopedAStatus Thermal::registerThermalChangedCallback(
     {
         std::lock_guard<std::mutex> _lock(thermal_callback_mutex_);
         if (std::any_of(thermal_callbacks_.begin(), thermal_callbacks_.end(),
-                        [&](const std::shared_ptr<IThermalChangedCallback>& c) {
-                            return interfacesEqual(c, in_callback);
+                        [&](const CallbackSetting& c) {
+                            return interfacesEqual(c.callback, in_callback);
                         })) {
             return ndk::ScopedAStatus::fromExceptionCodeWithMessage(EX_ILLEGAL_ARGUMENT,
                                                                     "Callback already registered");
         }
-        thermal_callbacks_.push_back(in_callback);
+        thermal_callbacks_.emplace_back(in_callback, false, TemperatureType::UNKNOWN);
     }
     return ScopedAStatus::ok();
 }
@@ -103,13 +103,13 @@ ScopedAStatus Thermal::registerThermalChangedCallbackWithType(
     {
         std::lock_guard<std::mutex> _lock(thermal_callback_mutex_);
         if (std::any_of(thermal_callbacks_.begin(), thermal_callbacks_.end(),
-                        [&](const std::shared_ptr<IThermalChangedCallback>& c) {
-                            return interfacesEqual(c, in_callback);
+                        [&](const CallbackSetting& c) {
+                            return interfacesEqual(c.callback, in_callback);
                         })) {
             return ndk::ScopedAStatus::fromExceptionCodeWithMessage(EX_ILLEGAL_ARGUMENT,
                                                                     "Callback already registered");
         }
-        thermal_callbacks_.push_back(in_callback);
+        thermal_callbacks_.emplace_back(in_callback, true, in_type);
     }
     return ScopedAStatus::ok();
 }
@@ -126,8 +126,8 @@ ScopedAStatus Thermal::unregisterThermalChangedCallback(
         bool removed = false;
         thermal_callbacks_.erase(
                 std::remove_if(thermal_callbacks_.begin(), thermal_callbacks_.end(),
-                               [&](const std::shared_ptr<IThermalChangedCallback>& c) {
-                                   if (interfacesEqual(c, in_callback)) {
+                               [&](const CallbackSetting& c) {
+                                   if (interfacesEqual(c.callback, in_callback)) {
                                        removed = true;
                                        return true;
                                    }
@@ -54,8 +54,19 @@ class Thermal : public BnThermal {
             const std::shared_ptr<IThermalChangedCallback>& in_callback) override;
 
   private:
+    // Registration record; callbacks registered with a type only want
+    // notifications for sensors of that type.
+    struct CallbackSetting {
+        CallbackSetting(std::shared_ptr<IThermalChangedCallback> callback, bool is_filter_type,
+                        TemperatureType type)
+            : callback(std::move(callback)), is_filter_type(is_filter_type), type(type) {}
+        std::shared_ptr<IThermalChangedCallback> callback;
+        bool is_filter_type;
+        TemperatureType type;
+    };
+
     std::mutex thermal_callback_mutex_;
-    std::vector<std::shared_ptr<IThermalChangedCallback>> thermal_callbacks_;
+    std::vector<CallbackSetting> thermal_callbacks_;
 };
 
 }  // namespace example
@@ -58,6 +58,8 @@ static_assert(TV_INPUT_EVENT_STREAM_CONFIGURATIONS_CHANGED == static_cast<int>(
         "TvInputEventType::STREAM_CONFIGURATIONS_CHANGED must match legacy value.");
 
 sp<ITvInputCallback> TvInput::mCallback = nullptr;
+std::mutex TvInput::mLock;
+std::map<int32_t, hidl_vec<TvStreamConfig>> TvInput::mStreamConfigCache;
 
 TvInput::TvInput(tv_input_device_t* device) : mDevice(device) {
     mCallbackOps.notify = &TvInput::notify;
@@ -73,12 +75,26 @@ TvInput::~TvInput() {
 Return<void> TvInput::setCallback(const sp<ITvInputCallback>& callback)  {
     mCallback = callback;
     if (mCallback != nullptr) {
+        {
+            // The device re-enumerates on initialize(); cached configurations
+            // from a previous client may be stale.
+            std::lock_guard<std::mutex> lock(mLock);
+            mStreamConfigCache.clear();
+        }
         mDevice->initialize(mDevice, &mCallbackOps, nullptr);
     }
     return Void();
 }
 
 Return<void> TvInput::getStreamConfigurations(int32_t deviceId, getStreamConfigurations_cb cb)  {
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        auto cached = mStreamConfigCache.find(deviceId);
+        if (cached != mStreamConfigCache.end()) {
+            cb(Result::OK, cached->second);
+            return Void();
+        }
+    }
     int32_t configCount = 0;
     const tv_stream_config_t* configs = nullptr;
     int ret = mDevice->get_stream_configurations(mDevice, deviceId, &configCount, &configs);
@@ -96,6 +112,8 @@ Return<void> TvInput::getStreamConfigurations(int32_t deviceId, getStreamConfigu
                 ++pos;
             }
         }
+        std::lock_guard<std::mutex> lock(mLock);
+        mStreamConfigCache[deviceId] = tvStreamConfigs;
     } else if (ret == -EINVAL) {
         res = Result::INVALID_ARGUMENTS;
     }
@@ -143,6 +161,14 @@ Return<Result> TvInput::closeStream(int32_t deviceId, int32_t streamId)  {
 // static
 void TvInput::notify(struct tv_input_device* __unused, tv_input_event_t* event,
                      void* optionalStatus) {
+    if (event != nullptr && (event->type == TV_INPUT_EVENT_DEVICE_AVAILABLE ||
+                             event->type == TV_INPUT_EVENT_DEVICE_UNAVAILABLE ||
+                             event->type == TV_INPUT_EVENT_STREAM_CONFIGURATIONS_CHANGED)) {
+        // Invalidate before forwarding so a client re-querying from its event
+        // handler never sees pre-hotplug configurations.
+        std::lock_guard<std::mutex> lock(mLock);
+        mStreamConfigCache.erase(event->device_info.device_id);
+    }
     if (mCallback != nullptr && event != nullptr) {
         // Capturing is no longer supported.
         if (event->type >= TV_INPUT_EVENT_CAPTURE_SUCCEEDED) {
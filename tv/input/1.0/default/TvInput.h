@@ -22,6 +22,9 @@
 
 #include <hidl/MQDescriptor.h>
 
+#include <map>
+#include <mutex>
+
 namespace android {
 namespace hardware {
 namespace tv {
@@ -59,6 +62,11 @@ struct TvInput : public ITvInput {
 
     private:
     static sp<ITvInputCallback> mCallback;
+    static std::mutex mLock;
+    // Stream configurations converted on the first getStreamConfigurations() call for
+    // a device, keyed by device id. Entries are dropped when a hotplug event signals
+    // that the device's configurations may have changed.
+    static std::map<int32_t, hidl_vec<TvStreamConfig>> mStreamConfigCache;
     tv_input_callback_ops_t mCallbackOps;
     tv_input_device_t* mDevice;
 };
@@ -275,15 +275,30 @@ Demux::~Demux() {
     return ::ndk::ScopedAStatus::ok();
 }
 
-void Demux::startBroadcastTsFilter(vector<int8_t> data) {
+void Demux::startBroadcastTsFilter(const vector<int8_t>& data) {
     set<int64_t>::iterator it;
-    uint16_t pid = ((data[1] & 0x1f) << 8) | ((data[2] & 0xff));
-    if (DEBUG_DEMUX) {
-        ALOGW("[Demux] start ts filter pid: %d", pid);
+    // Parse the pid of each 188-byte packet in the block once, then hand the
+    // matching packets to each filter in a single batch so the filter output
+    // lock is taken once per block instead of once per packet.
+    size_t numPackets = data.size() / 188;
+    vector<uint16_t> pids(numPackets);
+    for (size_t i = 0; i < numPackets; i++) {
+        pids[i] = ((data[i * 188 + 1] & 0x1f) << 8) | (data[i * 188 + 2] & 0xff);
+        if (DEBUG_DEMUX) {
+            ALOGW("[Demux] start ts filter pid: %d", pids[i]);
+        }
     }
     for (it = mPlaybackFilterIds.begin(); it != mPlaybackFilterIds.end(); it++) {
-        if (pid == mFilters[*it]->getTpid()) {
-            mFilters[*it]->updateFilterOutput(data);
+        uint16_t tpid = mFilters[*it]->getTpid();
+        vector<int8_t> matched;
+        for (size_t i = 0; i < numPackets; i++) {
+            if (pids[i] == tpid) {
+                matched.insert(matched.end(), data.begin() + i * 188,
+                               data.begin() + (i + 1) * 188);
+            }
+        }
+        if (!matched.empty()) {
+            mFilters[*it]->updateFilterOutput(matched);
         }
     }
 }
@@ -293,8 +308,11 @@ void Demux::sendFrontendInputToRecord(vector<int8_t> data) {
     if (DEBUG_DEMUX) {
         ALOGW("[Demux] update record filter output");
     }
+    // The input block is written once into a shared buffer; the attached
+    // record filters only keep a reference until the record FMQ write.
+    auto block = std::make_shared<const vector<int8_t>>(std::move(data));
     for (it = mRecordFilterIds.begin(); it != mRecordFilterIds.end(); it++) {
-        mFilters[*it]->updateRecordOutput(data);
+        mFilters[*it]->updateRecordOutput(block);
     }
 }
 
@@ -92,7 +92,7 @@ class Demux : public BnDemux {
      * Note that recording filters are not included.
      */
     bool startBroadcastFilterDispatcher();
-    void startBroadcastTsFilter(vector<int8_t> data);
+    void startBroadcastTsFilter(const vector<int8_t>& data);
 
     void sendFrontendInputToRecord(vector<int8_t> data);
     void sendFrontendInputToRecord(vector<int8_t> data, uint16_t pid, uint64_t pts);
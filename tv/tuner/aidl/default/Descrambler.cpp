@@ -47,31 +47,67 @@ Descrambler::~Descrambler() {}
     return ::ndk::ScopedAStatus::ok();
 }
 
-::ndk::ScopedAStatus Descrambler::setKeyToken(const std::vector<uint8_t>& /* in_keyToken */) {
+::ndk::ScopedAStatus Descrambler::setKeyToken(const std::vector<uint8_t>& in_keyToken) {
     ALOGV("%s", __FUNCTION__);
+    lock_guard<mutex> lock(mPidLock);
+    mKeyToken = in_keyToken;
 
     return ::ndk::ScopedAStatus::ok();
 }
 
 ::ndk::ScopedAStatus Descrambler::addPid(
-        const DemuxPid& /* in_pid */,
-        const std::shared_ptr<IFilter>& /* in_optionalSourceFilter */) {
+        const DemuxPid& in_pid, const std::shared_ptr<IFilter>& /* in_optionalSourceFilter */) {
     ALOGV("%s", __FUNCTION__);
+    lock_guard<mutex> lock(mPidLock);
+    auto current = std::atomic_load(&mDescramblePids);
+    auto updated = current ? std::make_shared<unordered_set<int32_t>>(*current)
+                           : std::make_shared<unordered_set<int32_t>>();
+    updated->insert(getPidValue(in_pid));
+    std::atomic_store(&mDescramblePids,
+                      std::shared_ptr<const unordered_set<int32_t>>(std::move(updated)));
 
     return ::ndk::ScopedAStatus::ok();
 }
 
 ::ndk::ScopedAStatus Descrambler::removePid(
-        const DemuxPid& /* in_pid */,
-        const std::shared_ptr<IFilter>& /* in_optionalSourceFilter */) {
+        const DemuxPid& in_pid, const std::shared_ptr<IFilter>& /* in_optionalSourceFilter */) {
     ALOGV("%s", __FUNCTION__);
+    lock_guard<mutex> lock(mPidLock);
+    auto current = std::atomic_load(&mDescramblePids);
+    if (current && current->count(getPidValue(in_pid))) {
+        auto updated = std::make_shared<unordered_set<int32_t>>(*current);
+        updated->erase(getPidValue(in_pid));
+        std::atomic_store(&mDescramblePids,
+                          std::shared_ptr<const unordered_set<int32_t>>(std::move(updated)));
+    }
 
     return ::ndk::ScopedAStatus::ok();
 }
 
+bool Descrambler::isPidDescrambled(int32_t pid) {
+    // Wait-free on the packet loop: grab the published snapshot; a
+    // concurrent addPid/removePid publishes a new table and this one stays
+    // valid until the reference is dropped.
+    auto pids = std::atomic_load(&mDescramblePids);
+    return pids && pids->count(pid);
+}
+
+int32_t Descrambler::getPidValue(const DemuxPid& pid) {
+    switch (pid.getTag()) {
+        case DemuxPid::Tag::tPid:
+            return pid.get<DemuxPid::Tag::tPid>();
+        case DemuxPid::Tag::mmtpPid:
+            return pid.get<DemuxPid::Tag::mmtpPid>();
+    }
+    return -1;
+}
+
 ::ndk::ScopedAStatus Descrambler::close() {
     ALOGV("%s", __FUNCTION__);
     mDemuxSet = false;
+    lock_guard<mutex> lock(mPidLock);
+    std::atomic_store(&mDescramblePids, std::shared_ptr<const unordered_set<int32_t>>());
+    mKeyToken.clear();
 
     return ::ndk::ScopedAStatus::ok();
 }
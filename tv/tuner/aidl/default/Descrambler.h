@@ -19,6 +19,9 @@
 #include <aidl/android/hardware/tv/tuner/BnDescrambler.h>
 #include <aidl/android/hardware/tv/tuner/ITuner.h>
 #include <inttypes.h>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
 
 using namespace std;
 
@@ -41,10 +44,24 @@ class Descrambler : public BnDescrambler {
             const std::shared_ptr<IFilter>& in_optionalSourceFilter) override;
     ::ndk::ScopedAStatus close() override;
 
+    // Called by the demux per TS packet; reads the current PID table
+    // snapshot without taking mPidLock.
+    bool isPidDescrambled(int32_t pid);
+
   private:
     virtual ~Descrambler();
+    static int32_t getPidValue(const DemuxPid& pid);
+
     int32_t mSourceDemuxId;
     bool mDemuxSet = false;
+
+    // PID-to-key-token associations. Mutations under mPidLock build a new
+    // table and publish it atomically; the packet loop reads the published
+    // snapshot wait-free. A replaced table is reclaimed only once the last
+    // in-flight reader drops its reference.
+    std::mutex mPidLock;
+    std::shared_ptr<const std::unordered_set<int32_t>> mDescramblePids;
+    std::vector<uint8_t> mKeyToken;
 };
 
 }  // namespace tuner
@@ -21,6 +21,9 @@
 #include <aidl/android/hardware/tv/tuner/Result.h>
 
 #include <utils/Log.h>
+
+#include <algorithm>
+
 #include "Dvr.h"
 
 namespace aidl {
@@ -31,6 +34,9 @@ namespace tuner {
 
 #define WAIT_TIMEOUT 3000000000
 
+// Number of playback packets moved per FMQ read and filter dispatch round.
+static constexpr size_t kPacketsPerBlock = 64;
+
 Dvr::Dvr(DvrType type, uint32_t bufferSize, const std::shared_ptr<IDvrCallback>& cb,
          std::shared_ptr<Demux> demux) {
     mType = type;
@@ -269,22 +275,33 @@ bool Dvr::readPlaybackFMQ(bool isVirtualFrontend, bool isRecording) {
     // Read playback data from the input FMQ
     size_t size = mDvrMQ->availableToRead();
     int64_t playbackPacketSize = mDvrSettings.get<DvrSettings::Tag::playback>().packetSize;
-    vector<int8_t> dataOutputBuffer;
-    dataOutputBuffer.resize(playbackPacketSize);
-    // Dispatch the packet to the PID matching filter output buffer
-    for (int i = 0; i < size / playbackPacketSize; i++) {
-        if (!mDvrMQ->read(dataOutputBuffer.data(), playbackPacketSize)) {
-            return false;
-        }
-        if (isVirtualFrontend) {
-            if (isRecording) {
-                mDemux->sendFrontendInputToRecord(dataOutputBuffer);
-            } else {
-                mDemux->startBroadcastTsFilter(dataOutputBuffer);
+    // Read and dispatch the input in multi-packet blocks, so each FMQ read
+    // transaction and each filter output append covers a block of packets
+    // instead of a single one. The broadcast/tpid paths reuse the
+    // preallocated block buffer; the record path hands ownership of each
+    // block to the record filters, so it reads into a fresh buffer.
+    size_t packetsLeft = size / playbackPacketSize;
+    while (packetsLeft > 0) {
+        size_t packetsInBlock = std::min(packetsLeft, kPacketsPerBlock);
+        size_t blockSize = packetsInBlock * playbackPacketSize;
+        if (isVirtualFrontend && isRecording) {
+            vector<int8_t> block(blockSize);
+            if (!mDvrMQ->read(block.data(), blockSize)) {
+                return false;
             }
+            mDemux->sendFrontendInputToRecord(std::move(block));
         } else {
-            startTpidFilter(dataOutputBuffer);
+            mPlaybackBlockBuffer.resize(blockSize);
+            if (!mDvrMQ->read(mPlaybackBlockBuffer.data(), blockSize)) {
+                return false;
+            }
+            if (isVirtualFrontend) {
+                mDemux->startBroadcastTsFilter(mPlaybackBlockBuffer);
+            } else {
+                startTpidFilter(mPlaybackBlockBuffer);
+            }
         }
+        packetsLeft -= packetsInBlock;
     }
 
     return true;
@@ -295,7 +312,7 @@ bool Dvr::processEsDataOnPlayback(bool isVirtualFrontend, bool isRecording) {
     // Note that currently we only provides ES with metaData in a specific format to be parsed.
     // The ES size should be smaller than the Playback FMQ size to avoid reading truncated data.
     int size = mDvrMQ->availableToRead();
-    vector<int8_t> dataOutputBuffer;
+    vector<int8_t>& dataOutputBuffer = mPlaybackBlockBuffer;
     dataOutputBuffer.resize(size);
     if (!mDvrMQ->read(dataOutputBuffer.data(), size)) {
         return false;
@@ -410,15 +427,29 @@ void Dvr::getMetaDataValue(int& index, int8_t* dataOutputBuffer, int& value) {
     }
 }
 
-void Dvr::startTpidFilter(vector<int8_t> data) {
+void Dvr::startTpidFilter(const vector<int8_t>& data) {
     map<int64_t, std::shared_ptr<IFilter>>::iterator it;
-    for (it = mFilters.begin(); it != mFilters.end(); it++) {
-        uint16_t pid = ((data[1] & 0x1f) << 8) | ((data[2] & 0xff));
+    // Parse the pid of each 188-byte packet in the block once, then hand the
+    // matching packets to each filter in a single batch.
+    size_t numPackets = data.size() / 188;
+    vector<uint16_t> pids(numPackets);
+    for (size_t i = 0; i < numPackets; i++) {
+        pids[i] = ((data[i * 188 + 1] & 0x1f) << 8) | (data[i * 188 + 2] & 0xff);
         if (DEBUG_DVR) {
-            ALOGW("[Dvr] start ts filter pid: %d", pid);
+            ALOGW("[Dvr] start ts filter pid: %d", pids[i]);
+        }
+    }
+    for (it = mFilters.begin(); it != mFilters.end(); it++) {
+        uint16_t tpid = mDemux->getFilterTpid(it->first);
+        vector<int8_t> matched;
+        for (size_t i = 0; i < numPackets; i++) {
+            if (pids[i] == tpid) {
+                matched.insert(matched.end(), data.begin() + i * 188,
+                               data.begin() + (i + 1) * 188);
+            }
         }
-        if (pid == mDemux->getFilterTpid(it->first)) {
-            mDemux->updateFilterOutput(it->first, data);
+        if (!matched.empty()) {
+            mDemux->updateFilterOutput(it->first, std::move(matched));
         }
     }
 }
@@ -111,7 +111,7 @@ class Dvr : public BnDvr {
      * A dispatcher to read and dispatch input data to all the started filters.
      * Each filter handler handles the data filtering/output writing/filterEvent updating.
      */
-    void startTpidFilter(vector<int8_t> data);
+    void startTpidFilter(const vector<int8_t>& data);
     void playbackThreadLoop();
 
     unique_ptr<DvrMQ> mDvrMQ;
@@ -128,6 +128,11 @@ class Dvr : public BnDvr {
     // FMQ status local records
     PlaybackStatus mPlaybackStatus;
     RecordStatus mRecordStatus;
+
+    // Preallocated input block reused across playback FMQ reads, so servicing
+    // the queue does not allocate per iteration once it has grown to the
+    // block size.
+    vector<int8_t> mPlaybackBlockBuffer;
     /**
      * If a specific filter's writing loop is still running
      */
@@ -714,9 +714,9 @@ void Filter::updatePts(uint64_t pts) {
     mPts = pts;
 }
 
-void Filter::updateRecordOutput(vector<int8_t>& data) {
+void Filter::updateRecordOutput(const std::shared_ptr<const vector<int8_t>>& data) {
     std::lock_guard<std::mutex> lock(mRecordFilterOutputLock);
-    mRecordFilterOutput.insert(mRecordFilterOutput.end(), data.begin(), data.end());
+    mRecordFilterOutput.push_back(data);
 }
 
 ::ndk::ScopedAStatus Filter::startFilterHandler() {
@@ -961,15 +961,23 @@ void Filter::updateRecordOutput(vector<int8_t>& data) {
         return ::ndk::ScopedAStatus::ok();
     }
 
-    if (mDvr == nullptr || !mDvr->writeRecordFMQ(mRecordFilterOutput)) {
-        ALOGD("[Filter] dvr fails to write into record FMQ.");
-        return ::ndk::ScopedAStatus::fromServiceSpecificError(
-                static_cast<int32_t>(Result::UNKNOWN_ERROR));
+    // The shared input blocks are materialized here, on the final record FMQ
+    // write, instead of being copied into every attached filter beforehand.
+    int64_t byteNumber = 0;
+    while (!mRecordFilterOutput.empty()) {
+        const std::shared_ptr<const vector<int8_t>>& block = mRecordFilterOutput.front();
+        if (mDvr == nullptr || !mDvr->writeRecordFMQ(*block)) {
+            ALOGD("[Filter] dvr fails to write into record FMQ.");
+            return ::ndk::ScopedAStatus::fromServiceSpecificError(
+                    static_cast<int32_t>(Result::UNKNOWN_ERROR));
+        }
+        byteNumber += static_cast<int64_t>(block->size());
+        mRecordFilterOutput.erase(mRecordFilterOutput.begin());
     }
 
     DemuxFilterTsRecordEvent recordEvent;
     recordEvent = {
-            .byteNumber = static_cast<int64_t>(mRecordFilterOutput.size()),
+            .byteNumber = byteNumber,
             .pts = (mPts == 0) ? static_cast<int64_t>(time(NULL)) * 900000 : mPts,
             .firstMbInSlice = 0,  // random address
     };
@@ -980,7 +988,6 @@ void Filter::updateRecordOutput(vector<int8_t>& data) {
                 DemuxFilterEvent::make<DemuxFilterEvent::Tag::tsRecord>(recordEvent));
     }
 
-    mRecordFilterOutput.clear();
     return ::ndk::ScopedAStatus::ok();
 }
 
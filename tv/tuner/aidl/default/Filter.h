@@ -137,7 +137,7 @@ class Filter : public BnFilter {
     bool createFilterMQ();
     uint16_t getTpid();
     void updateFilterOutput(vector<int8_t>& data);
-    void updateRecordOutput(vector<int8_t>& data);
+    void updateRecordOutput(const std::shared_ptr<const vector<int8_t>>& data);
     void updatePts(uint64_t pts);
     ::ndk::ScopedAStatus startFilterHandler();
     ::ndk::ScopedAStatus startRecordFilterHandler();
@@ -169,7 +169,10 @@ class Filter : public BnFilter {
     std::shared_ptr<IFilter> mDataSource;
     bool mIsDataSourceDemux = true;
     vector<int8_t> mFilterOutput;
-    vector<int8_t> mRecordFilterOutput;
+    // Input blocks pending record output. The blocks are shared with the demux
+    // and the other attached record filters; the data is copied only on the
+    // record FMQ write.
+    vector<std::shared_ptr<const vector<int8_t>>> mRecordFilterOutput;
     int64_t mPts = 0;
     unique_ptr<FilterMQ> mFilterMQ;
     bool mIsUsingFMQ = false;
@@ -28,6 +28,15 @@ namespace hardware {
 namespace tv {
 namespace tuner {
 
+namespace {
+// Emulated blind scan engine geometry. The frequency plan is striped across
+// kNumScanWorkers worker threads, modeling a multi-tuner frontend where each
+// demod probes a share of the band in parallel.
+constexpr size_t kNumScanWorkers = 4;
+constexpr size_t kBlindScanFrequencyCount = 8;
+constexpr int64_t kBlindScanRasterHz = 100 * 1000;
+}  // namespace
+
 Frontend::Frontend(FrontendType type, int32_t id) {
     mType = type;
     mId = id;
@@ -245,9 +254,12 @@ Frontend::~Frontend() {
 
     // If it's in middle of scanning, stop it first.
     if (mScanThread.joinable()) {
+        mScanAborted = true;
+        mScanResultCv.notify_all();
         mScanThread.join();
     }
 
+    mScanAborted = false;
     mFrontendSettings = in_settings;
     mFrontendScanType = in_type;
     mScanThread = std::thread(&Frontend::scanThreadLoop, this);
@@ -301,20 +313,24 @@ void Frontend::scanThreadLoop() {
     }
 
     if (mFrontendScanType == FrontendScanType::SCAN_BLIND) {
-        frequency += 100 * 1000;
-    }
-
-    {
-        FrontendScanMessage msg;
-        vector<int64_t> frequencies = {frequency};
-        msg.set<FrontendScanMessage::Tag::frequencies>(frequencies);
-        mCallback->onScanMessage(FrontendScanMessageType::FREQUENCY, msg);
-    }
+        if (!blindScan(frequency)) {
+            // Aborted by stopScan(). The checkpoint keeps the resume position
+            // for the next blind scan with the same start frequency.
+            return;
+        }
+    } else {
+        {
+            FrontendScanMessage msg;
+            vector<int64_t> frequencies = {frequency};
+            msg.set<FrontendScanMessage::Tag::frequencies>(frequencies);
+            mCallback->onScanMessage(FrontendScanMessageType::FREQUENCY, msg);
+        }
 
-    {
-        FrontendScanMessage msg;
-        msg.set<FrontendScanMessage::Tag::progressPercent>(20);
-        mCallback->onScanMessage(FrontendScanMessageType::PROGRESS_PERCENT, msg);
+        {
+            FrontendScanMessage msg;
+            msg.set<FrontendScanMessage::Tag::progressPercent>(20);
+            mCallback->onScanMessage(FrontendScanMessageType::PROGRESS_PERCENT, msg);
+        }
     }
 
     {
@@ -432,13 +448,101 @@ void Frontend::scanThreadLoop() {
     }
 }
 
+bool Frontend::blindScan(int64_t startFrequency) {
+    // Build the emulated frequency plan: kBlindScanFrequencyCount channels
+    // upward from the requested start, on the hardware raster. The first
+    // entry matches the single frequency the blind scan used to report.
+    vector<int64_t> plan;
+    for (size_t i = 1; i <= kBlindScanFrequencyCount; i++) {
+        plan.push_back(startFrequency + static_cast<int64_t>(i) * kBlindScanRasterHz);
+    }
+
+    size_t next;
+    {
+        lock_guard<mutex> lock(mScanLock);
+        if (mScanPlanStartFrequency != startFrequency || mScanCheckpoint >= plan.size()) {
+            // Different plan or nothing left to resume; start over.
+            mScanPlanStartFrequency = startFrequency;
+            mScanCheckpoint = 0;
+        }
+        mScanResultReady.assign(plan.size(), false);
+        next = mScanCheckpoint;
+    }
+
+    // Each worker probes a stripe of the plan; completion order across
+    // workers is arbitrary.
+    vector<thread> workers;
+    for (size_t w = 0; w < kNumScanWorkers; w++) {
+        workers.emplace_back(&Frontend::blindScanWorker, this, plan, w);
+    }
+
+    // Deliver incremental results strictly in ascending frequency order.
+    bool completed = true;
+    for (; next < plan.size(); next++) {
+        {
+            unique_lock<mutex> lock(mScanLock);
+            mScanResultCv.wait(lock, [this, next] {
+                return mScanResultReady[next] || mScanAborted;
+            });
+            if (mScanAborted) {
+                completed = false;
+                break;
+            }
+            mScanCheckpoint = next + 1;
+        }
+
+        {
+            FrontendScanMessage msg;
+            vector<int64_t> frequencies = {plan[next]};
+            msg.set<FrontendScanMessage::Tag::frequencies>(frequencies);
+            mCallback->onScanMessage(FrontendScanMessageType::FREQUENCY, msg);
+        }
+
+        {
+            FrontendScanMessage msg;
+            msg.set<FrontendScanMessage::Tag::progressPercent>(
+                    static_cast<int32_t>((next + 1) * 100 / plan.size()));
+            mCallback->onScanMessage(FrontendScanMessageType::PROGRESS_PERCENT, msg);
+        }
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (completed) {
+        lock_guard<mutex> lock(mScanLock);
+        mScanPlanStartFrequency = -1;
+        mScanCheckpoint = 0;
+    }
+    return completed;
+}
+
+void Frontend::blindScanWorker(vector<int64_t> plan, size_t workerIndex) {
+    for (size_t i = workerIndex; i < plan.size(); i += kNumScanWorkers) {
+        if (mScanAborted) {
+            break;
+        }
+        // A real tuner would attempt a lock on plan[i] here; the emulated
+        // probe succeeds immediately.
+        {
+            lock_guard<mutex> lock(mScanLock);
+            mScanResultReady[i] = true;
+        }
+        mScanResultCv.notify_all();
+    }
+}
+
 ::ndk::ScopedAStatus Frontend::stopScan() {
     ALOGV("%s", __FUNCTION__);
 
     if (mScanThread.joinable()) {
+        mScanAborted = true;
+        mScanResultCv.notify_all();
         mScanThread.join();
     }
 
+    mScanAborted = false;
     mIsLocked = false;
     return ::ndk::ScopedAStatus::ok();
 }
@@ -17,8 +17,11 @@
 #pragma once
 
 #include <aidl/android/hardware/tv/tuner/BnFrontend.h>
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <thread>
 #include "Tuner.h"
 
@@ -68,6 +71,8 @@ class Frontend : public BnFrontend {
     virtual ~Frontend();
     bool supportsSatellite();
     void scanThreadLoop();
+    bool blindScan(int64_t startFrequency);
+    void blindScanWorker(std::vector<int64_t> plan, size_t workerIndex);
 
     std::shared_ptr<IFrontendCallback> mCallback;
     std::shared_ptr<Tuner> mTuner;
@@ -81,6 +86,18 @@ class Frontend : public BnFrontend {
     std::ifstream mFrontendData;
     FrontendCapabilities mFrontendCaps;
     vector<FrontendStatusType> mFrontendStatusCaps;
+
+    // Parallel blind scan engine state, modeling multi-tuner hardware. The
+    // frequency plan is striped across worker threads; results are delivered
+    // in frequency order. mScanCheckpoint is the next plan index to deliver
+    // and survives stopScan(), so a repeated blind scan with the same start
+    // frequency resumes where it was stopped instead of rescanning.
+    std::mutex mScanLock;
+    std::condition_variable mScanResultCv;
+    std::vector<bool> mScanResultReady;
+    std::atomic<bool> mScanAborted = false;
+    size_t mScanCheckpoint = 0;
+    int64_t mScanPlanStartFrequency = -1;
 };
 
 }  // namespace tuner
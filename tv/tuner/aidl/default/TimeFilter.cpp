@@ -42,28 +42,30 @@ TimeFilter::~TimeFilter() {}
         return ::ndk::ScopedAStatus::fromServiceSpecificError(
                 static_cast<int32_t>(Result::INVALID_ARGUMENT));
     }
-    mTimeStamp = in_timeStamp;
-    mBeginTime = time(NULL);
+    publishClock(in_timeStamp, time(NULL));
 
     return ::ndk::ScopedAStatus::ok();
 }
 
 ::ndk::ScopedAStatus TimeFilter::clearTimeStamp() {
     ALOGV("%s", __FUNCTION__);
-    mTimeStamp = INVALID_TIME_STAMP;
+    publishClock(INVALID_TIME_STAMP, 0);
 
     return ::ndk::ScopedAStatus::ok();
 }
 
 ::ndk::ScopedAStatus TimeFilter::getTimeStamp(int64_t* _aidl_return) {
     ALOGV("%s", __FUNCTION__);
-    if (mTimeStamp == INVALID_TIME_STAMP) {
-        *_aidl_return = mTimeStamp;
+    uint64_t timeStamp;
+    time_t beginTime;
+    readClock(&timeStamp, &beginTime);
+    if (timeStamp == INVALID_TIME_STAMP) {
+        *_aidl_return = timeStamp;
         return ::ndk::ScopedAStatus::fromServiceSpecificError(
                 static_cast<int32_t>(Result::INVALID_ARGUMENT));
     }
 
-    uint64_t currentTimeStamp = mTimeStamp + difftime(time(NULL), mBeginTime) * 900000;
+    uint64_t currentTimeStamp = timeStamp + difftime(time(NULL), beginTime) * 900000;
     *_aidl_return = currentTimeStamp;
 
     return ::ndk::ScopedAStatus::ok();
@@ -78,14 +80,37 @@ TimeFilter::~TimeFilter() {}
 
 ::ndk::ScopedAStatus TimeFilter::close() {
     ALOGV("%s", __FUNCTION__);
-    mTimeStamp = INVALID_TIME_STAMP;
+    publishClock(INVALID_TIME_STAMP, 0);
 
     return ::ndk::ScopedAStatus::ok();
 }
 
+void TimeFilter::publishClock(uint64_t timeStamp, time_t beginTime) {
+    // Odd sequence count marks a write in flight. Only the demux input
+    // thread publishes, so the two increments need not be atomic with the
+    // stores in between.
+    mClockSeq.fetch_add(1, std::memory_order_acquire);
+    mTimeStamp.store(timeStamp, std::memory_order_relaxed);
+    mBeginTime.store(beginTime, std::memory_order_relaxed);
+    mClockSeq.fetch_add(1, std::memory_order_release);
+}
+
+void TimeFilter::readClock(uint64_t* timeStamp, time_t* beginTime) const {
+    uint32_t seq;
+    do {
+        seq = mClockSeq.load(std::memory_order_acquire);
+        *timeStamp = mTimeStamp.load(std::memory_order_relaxed);
+        *beginTime = mBeginTime.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((seq & 1) != 0 || mClockSeq.load(std::memory_order_relaxed) != seq);
+}
+
 binder_status_t TimeFilter::dump(int fd, const char** /* args */, uint32_t /* numArgs */) {
+    uint64_t timeStamp;
+    time_t beginTime;
+    readClock(&timeStamp, &beginTime);
     dprintf(fd, "    TimeFilter:\n");
-    dprintf(fd, "      mTimeStamp: %" PRIu64 "\n", mTimeStamp);
+    dprintf(fd, "      mTimeStamp: %" PRIu64 "\n", timeStamp);
     return STATUS_OK;
 }
 
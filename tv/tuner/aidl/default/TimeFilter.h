@@ -17,6 +17,7 @@
 #pragma once
 
 #include <aidl/android/hardware/tv/tuner/BnTimeFilter.h>
+#include <atomic>
 #include "Demux.h"
 #include "time.h"
 
@@ -47,9 +48,17 @@ class TimeFilter : public BnTimeFilter {
     binder_status_t dump(int fd, const char** args, uint32_t numArgs) override;
 
   private:
+    // The clock cache (timestamp and its capture time) is published through
+    // a seqlock: the PCR update path bumps mClockSeq to an odd value, writes
+    // both fields, then bumps it back to even. Timestamp queries read a
+    // consistent snapshot and interpolate without ever blocking the writer.
+    void publishClock(uint64_t timeStamp, time_t beginTime);
+    void readClock(uint64_t* timeStamp, time_t* beginTime) const;
+
     ::std::shared_ptr<Demux> mDemux;
-    uint64_t mTimeStamp = INVALID_TIME_STAMP;
-    time_t mBeginTime;
+    std::atomic<uint32_t> mClockSeq = 0;
+    std::atomic<uint64_t> mTimeStamp = INVALID_TIME_STAMP;
+    std::atomic<time_t> mBeginTime = 0;
 };
 
 }  // namespace tuner
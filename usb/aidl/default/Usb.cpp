@@ -254,7 +254,9 @@ Usb::Usb()
     : mLock(PTHREAD_MUTEX_INITIALIZER),
       mRoleSwitchLock(PTHREAD_MUTEX_INITIALIZER),
       mPartnerLock(PTHREAD_MUTEX_INITIALIZER),
-      mPartnerUp(false)
+      mPartnerUp(false),
+      mPortStatusCacheLock(PTHREAD_MUTEX_INITIALIZER),
+      mPortStatusCacheValid(false)
 {
     pthread_condattr_t attr;
     if (pthread_condattr_init(&attr)) {
@@ -537,6 +539,11 @@ void queryVersionHelper(android::hardware::usb::Usb *usb,
     status = getPortStatusHelper(currentPortStatus);
     queryMoistureDetectionStatus(currentPortStatus);
     queryNonCompliantChargerStatus(currentPortStatus);
+    pthread_mutex_lock(&usb->mPortStatusCacheLock);
+    usb->mCachedPortStatusResult = status;
+    usb->mCachedPortStatus = *currentPortStatus;
+    usb->mPortStatusCacheValid = true;
+    pthread_mutex_unlock(&usb->mPortStatusCacheLock);
     if (usb->mCallback != NULL) {
         ScopedAStatus ret = usb->mCallback->notifyPortStatusChange(*currentPortStatus,
             status);
@@ -550,8 +557,32 @@ void queryVersionHelper(android::hardware::usb::Usb *usb,
 
 ScopedAStatus Usb::queryPortStatus(int64_t in_transactionId) {
     std::vector<PortStatus> currentPortStatus;
-
-    queryVersionHelper(this, &currentPortStatus);
+    Status status = Status::ERROR;
+    bool cached = false;
+
+    pthread_mutex_lock(&mPortStatusCacheLock);
+    if (mPortStatusCacheValid) {
+        status = mCachedPortStatusResult;
+        currentPortStatus = mCachedPortStatus;
+        cached = true;
+    }
+    pthread_mutex_unlock(&mPortStatusCacheLock);
+
+    if (cached) {
+        // The uevent thread keeps the cache current; answer from memory
+        // instead of re-reading every port's sysfs nodes.
+        pthread_mutex_lock(&mLock);
+        if (mCallback != NULL) {
+            ScopedAStatus ret = mCallback->notifyPortStatusChange(currentPortStatus, status);
+            if (!ret.isOk())
+                ALOGE("queryPortStatus error %s", ret.getDescription().c_str());
+        } else {
+            ALOGI("Notifying userspace skipped. Callback is NULL");
+        }
+        pthread_mutex_unlock(&mLock);
+    } else {
+        queryVersionHelper(this, &currentPortStatus);
+    }
     pthread_mutex_lock(&mLock);
     if (mCallback != NULL) {
         ScopedAStatus ret = mCallback->notifyQueryPortStatus(
@@ -727,6 +758,10 @@ ScopedAStatus Usb::setCallback(
             pthread_join(mPoll, NULL);
             ALOGI("pthread destroyed");
         }
+        // Without the uevent thread the cache no longer tracks sysfs.
+        pthread_mutex_lock(&mPortStatusCacheLock);
+        mPortStatusCacheValid = false;
+        pthread_mutex_unlock(&mPortStatusCacheLock);
         pthread_mutex_unlock(&mLock);
         return ScopedAStatus::ok();
     }
@@ -741,6 +776,9 @@ ScopedAStatus Usb::setCallback(
     if (pthread_create(&mPoll, NULL, work, this)) {
         ALOGE("pthread creation failed %d", errno);
         mCallback = NULL;
+        pthread_mutex_lock(&mPortStatusCacheLock);
+        mPortStatusCacheValid = false;
+        pthread_mutex_unlock(&mPortStatusCacheLock);
     }
 
     pthread_mutex_unlock(&mLock);
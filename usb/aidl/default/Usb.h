@@ -21,6 +21,8 @@
 #include <aidl/android/hardware/usb/BnUsbCallback.h>
 #include <utils/Log.h>
 
+#include <vector>
+
 #define UEVENT_MSG_LEN     2048
 #define UEVENT_MAX_EVENTS  64
 // The type-c stack waits for 4.5 - 5.5 secs before declaring a port non-pd.
@@ -72,6 +74,16 @@ struct Usb : public BnUsb {
     pthread_mutex_t mPartnerLock;
     // Variable to signal partner coming back online after type switch
     bool mPartnerUp;
+    // Protects the port status cache below
+    pthread_mutex_t mPortStatusCacheLock;
+    // True while the uevent thread keeps the cache current; cleared when the
+    // thread is torn down so queries fall back to reading sysfs.
+    bool mPortStatusCacheValid;
+    // Result and statuses from the last port status collection. Refreshed on
+    // every type-c uevent so queryPortStatus can answer from memory instead of
+    // re-walking /sys/class/typec per call.
+    Status mCachedPortStatusResult;
+    std::vector<PortStatus> mCachedPortStatus;
   private:
     pthread_t mPoll;
 };
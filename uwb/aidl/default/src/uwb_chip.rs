@@ -84,10 +84,15 @@ impl IUwbChipAsyncServer for UwbChip {
             let mut tasks = tokio::task::JoinSet::new();
 
             tasks.spawn(async move {
-                loop {
-                    const UWB_HEADER_SIZE: usize = 4;
+                const UWB_HEADER_SIZE: usize = 4;
+
+                // Reuse one buffer across packets; once it has grown to the
+                // largest packet seen, ranging notifications are forwarded
+                // without any further allocation.
+                let mut buffer = vec![0; UWB_HEADER_SIZE];
 
-                    let mut buffer = vec![0; UWB_HEADER_SIZE];
+                loop {
+                    buffer.resize(UWB_HEADER_SIZE, 0);
                     read.read_exact(&mut buffer[0..UWB_HEADER_SIZE])
                         .await
                         .unwrap();
@@ -158,39 +158,61 @@ ndk::ScopedAStatus Vibrator::getPrimitiveDuration(CompositePrimitive primitive,
 
 ndk::ScopedAStatus Vibrator::compose(const std::vector<CompositeEffect>& composite,
                                      const std::shared_ptr<IVibratorCallback>& callback) {
-    if (composite.size() > COMPOSE_SIZE_MAX) {
-        return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
+    std::shared_ptr<const ComposeTimeline> timeline;
+    {
+        std::lock_guard<std::mutex> lock(mComposeCacheMutex);
+        auto it = mComposeCache.find(composite);
+        if (it != mComposeCache.end()) {
+            timeline = it->second;
+        }
     }
 
-    std::vector<CompositePrimitive> supported;
-    getSupportedPrimitives(&supported);
-
-    for (auto& e : composite) {
-        if (e.delayMs > COMPOSE_DELAY_MAX_MS) {
+    if (timeline == nullptr) {
+        if (composite.size() > COMPOSE_SIZE_MAX) {
             return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
         }
-        if (e.scale < 0.0f || e.scale > 1.0f) {
-            return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
+
+        std::vector<CompositePrimitive> supported;
+        getSupportedPrimitives(&supported);
+
+        auto compiled = std::make_shared<ComposeTimeline>();
+        compiled->steps.reserve(composite.size());
+
+        for (auto& e : composite) {
+            if (e.delayMs > COMPOSE_DELAY_MAX_MS) {
+                return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
+            }
+            if (e.scale < 0.0f || e.scale > 1.0f) {
+                return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
+            }
+            if (std::find(supported.begin(), supported.end(), e.primitive) == supported.end()) {
+                return ndk::ScopedAStatus::fromExceptionCode(EX_UNSUPPORTED_OPERATION);
+            }
+            int32_t durationMs = 0;
+            getPrimitiveDuration(e.primitive, &durationMs);
+            compiled->steps.push_back({e.delayMs, e.primitive, e.scale, durationMs});
         }
-        if (std::find(supported.begin(), supported.end(), e.primitive) == supported.end()) {
-            return ndk::ScopedAStatus::fromExceptionCode(EX_UNSUPPORTED_OPERATION);
+
+        timeline = compiled;
+        std::lock_guard<std::mutex> lock(mComposeCacheMutex);
+        if (mComposeCache.size() >= COMPOSE_CACHE_MAX_ENTRIES) {
+            mComposeCache.clear();
         }
+        mComposeCache.emplace(composite, timeline);
     }
 
-    // The thread may theoretically outlive the vibrator, so take a proper reference to it.
-    std::thread([sharedThis = this->ref<Vibrator>(), composite, callback] {
+    // The timeline is self-contained, so the playback thread needs no reference to "this".
+    std::thread([timeline, callback] {
         LOG(VERBOSE) << "Starting compose on another thread";
 
-        for (auto& e : composite) {
-            if (e.delayMs) {
-                usleep(e.delayMs * 1000);
+        for (auto& step : timeline->steps) {
+            if (step.delayMs) {
+                usleep(step.delayMs * 1000);
             }
-            LOG(VERBOSE) << "triggering primitive " << static_cast<int>(e.primitive) << " @ scale "
-                         << e.scale;
+            LOG(VERBOSE) << "triggering primitive " << static_cast<int>(step.primitive)
+                         << " @ scale " << step.scale;
 
-            int32_t durationMs;
-            sharedThis->getPrimitiveDuration(e.primitive, &durationMs);
-            usleep(durationMs * 1000);
+            usleep(step.durationMs * 1000);
         }
 
         if (callback != nullptr) {
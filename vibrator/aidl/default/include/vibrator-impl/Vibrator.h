@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <mutex>
+
 #include <aidl/android/hardware/vibrator/BnVibrator.h>
 
 namespace aidl {
@@ -55,6 +59,22 @@ class Vibrator : public BnVibrator {
     ndk::ScopedAStatus composePwle(const std::vector<PrimitivePwle> &composite,
                                    const std::shared_ptr<IVibratorCallback> &callback) override;
 
+  private:
+    // A composition validated and flattened into per-step timings, cached so
+    // repeated patterns (e.g. typing haptics) skip validation and timeline
+    // construction on subsequent compose() calls.
+    struct ComposeTimeline {
+        struct Step {
+            int32_t delayMs;
+            CompositePrimitive primitive;
+            float scale;
+            int32_t durationMs;
+        };
+        std::vector<Step> steps;
+    };
+    static constexpr size_t COMPOSE_CACHE_MAX_ENTRIES = 64;
+    std::mutex mComposeCacheMutex;
+    std::map<std::vector<CompositeEffect>, std::shared_ptr<const ComposeTimeline>> mComposeCache;
 };
 
 }  // namespace vibrator
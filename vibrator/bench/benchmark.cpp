@@ -21,6 +21,12 @@
 #include <android/hardware/vibrator/IVibrator.h>
 #include <binder/IServiceManager.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 using ::android::enum_range;
 using ::android::sp;
 using ::android::hardware::hidl_enum_range;
@@ -574,4 +580,162 @@ BENCHMARK_WRAPPER(VibratorPrimitivesBench_Aidl, compose, {
     }
 });
 
+// Callback that can be waited on, for dispatch-to-completion measurements.
+class CompletionCallback : public Aidl::BnVibratorCallback {
+  public:
+    android::binder::Status onComplete() override {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mComplete = true;
+        }
+        mCv.notify_all();
+        return android::binder::Status::ok();
+    }
+
+    bool waitForComplete(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        return mCv.wait_for(lock, timeout, [this] { return mComplete; });
+    }
+
+  private:
+    std::mutex mMutex;
+    std::condition_variable mCv;
+    bool mComplete = false;
+};
+
+static constexpr std::chrono::milliseconds kCompletionTimeout{1000};
+static constexpr int32_t kCompletionOnMs = 20;
+
+// Runs the benchmarked calls while spinner threads keep the CPUs busy and an
+// extra thread keeps binder calls in flight against the HAL, so completion
+// latency is measured under contention rather than on an idle system.
+class VibratorLoadedBench_Aidl : public VibratorBench_Aidl {
+  public:
+    void SetUp(State& state) override {
+        VibratorBench_Aidl::SetUp(state);
+        if (!this->mVibrator) {
+            return;
+        }
+        mStop = false;
+        for (size_t i = 0; i < kCpuLoadThreads; i++) {
+            mLoadThreads.emplace_back([this] {
+                while (!mStop) {
+                    // busy spin
+                }
+            });
+        }
+        mLoadThreads.emplace_back([this] {
+            int32_t capabilities = 0;
+            while (!mStop) {
+                this->mVibrator->getCapabilities(&capabilities);
+            }
+        });
+    }
+
+    void TearDown(State& state) override {
+        mStop = true;
+        for (auto& thread : mLoadThreads) {
+            thread.join();
+        }
+        mLoadThreads.clear();
+        VibratorBench_Aidl::TearDown(state);
+    }
+
+  private:
+    static constexpr size_t kCpuLoadThreads = 2;
+    std::atomic<bool> mStop{false};
+    std::vector<std::thread> mLoadThreads;
+};
+
+BENCHMARK_WRAPPER(VibratorBench_Aidl, onDispatchToCompletion, {
+    int32_t capabilities = 0;
+    mVibrator->getCapabilities(&capabilities);
+    if ((capabilities & Aidl::IVibrator::CAP_ON_CALLBACK) == 0) {
+        return;
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        mVibrator->off();
+        sp<CompletionCallback> cb = new CompletionCallback();
+        state.ResumeTiming();
+        mVibrator->on(kCompletionOnMs, cb);
+        cb->waitForComplete(kCompletionTimeout);
+    }
+});
+
+BENCHMARK_WRAPPER(VibratorLoadedBench_Aidl, onDispatchToCompletion, {
+    int32_t capabilities = 0;
+    mVibrator->getCapabilities(&capabilities);
+    if ((capabilities & Aidl::IVibrator::CAP_ON_CALLBACK) == 0) {
+        return;
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        mVibrator->off();
+        sp<CompletionCallback> cb = new CompletionCallback();
+        state.ResumeTiming();
+        mVibrator->on(kCompletionOnMs, cb);
+        cb->waitForComplete(kCompletionTimeout);
+    }
+});
+
+BENCHMARK_WRAPPER(VibratorLoadedBench_Aidl, performDispatchToCompletion, {
+    int32_t capabilities = 0;
+    mVibrator->getCapabilities(&capabilities);
+    if ((capabilities & Aidl::IVibrator::CAP_PERFORM_CALLBACK) == 0) {
+        return;
+    }
+
+    auto effect = Aidl::Effect::CLICK;
+    std::vector<Aidl::Effect> supported;
+    mVibrator->getSupportedEffects(&supported);
+    if (std::find(supported.begin(), supported.end(), effect) == supported.end()) {
+        return;
+    }
+
+    int32_t lengthMs = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        mVibrator->off();
+        sp<CompletionCallback> cb = new CompletionCallback();
+        state.ResumeTiming();
+        mVibrator->perform(effect, Aidl::EffectStrength::MEDIUM, cb, &lengthMs);
+        cb->waitForComplete(kCompletionTimeout);
+    }
+});
+
+BENCHMARK_WRAPPER(VibratorLoadedBench_Aidl, composeDispatchToCompletion, {
+    int32_t capabilities = 0;
+    mVibrator->getCapabilities(&capabilities);
+    if ((capabilities & Aidl::IVibrator::CAP_COMPOSE_EFFECTS) == 0) {
+        return;
+    }
+
+    Aidl::CompositeEffect effect;
+    effect.primitive = Aidl::CompositePrimitive::CLICK;
+    effect.scale = 1.0f;
+    effect.delayMs = 0;
+
+    std::vector<Aidl::CompositePrimitive> supported;
+    mVibrator->getSupportedPrimitives(&supported);
+    if (std::find(supported.begin(), supported.end(), effect.primitive) == supported.end()) {
+        return;
+    }
+
+    std::vector<Aidl::CompositeEffect> effects;
+    effects.push_back(effect);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        mVibrator->off();
+        sp<CompletionCallback> cb = new CompletionCallback();
+        state.ResumeTiming();
+        mVibrator->compose(effects, cb);
+        cb->waitForComplete(kCompletionTimeout);
+    }
+});
+
 BENCHMARK_MAIN();
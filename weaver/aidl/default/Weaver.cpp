@@ -15,6 +15,7 @@
  */
 
 #include "Weaver.h"
+#include <inttypes.h>
 #include <array>
 
 namespace aidl {
@@ -39,16 +40,21 @@ std::array<struct Slotinfo, 16> slot_array;
 ::ndk::ScopedAStatus Weaver::read(int32_t in_slotId, const std::vector<uint8_t>& in_key, WeaverReadResponse* out_response) {
     using ::aidl::android::hardware::weaver::WeaverReadStatus;
 
+    std::lock_guard<std::mutex> lock(mLock);
+
     if (in_slotId > 15 || in_key.size() > 16) {
+        mReadFailedCount++;
         *out_response = {0, {}, WeaverReadStatus::FAILED};
         return ndk::ScopedAStatus::ok();
     }
 
     if (slot_array[in_slotId].key != in_key) {
+        mReadIncorrectKeyCount++;
         *out_response = {0, {}, WeaverReadStatus::INCORRECT_KEY};
         return ndk::ScopedAStatus::ok();
     }
 
+    mReadOkCount++;
     *out_response = {0, slot_array[in_slotId].value, WeaverReadStatus::OK};
 
     return ::ndk::ScopedAStatus::ok();
@@ -59,12 +65,24 @@ std::array<struct Slotinfo, 16> slot_array;
     if (in_slotId > 15 || in_key.size() > 16 || in_value.size() > 16)
         return ::ndk::ScopedAStatus::fromStatus(STATUS_FAILED_TRANSACTION);
 
+    std::lock_guard<std::mutex> lock(mLock);
     slot_array[in_slotId].key = in_key;
     slot_array[in_slotId].value = in_value;
+    mWriteCount++;
 
     return ::ndk::ScopedAStatus::ok();
 }
 
+binder_status_t Weaver::dump(int fd, const char** /*args*/, uint32_t /*numArgs*/) {
+    std::lock_guard<std::mutex> lock(mLock);
+    dprintf(fd, "Weaver slot operation stats:\n");
+    dprintf(fd, "  reads ok: %" PRIu64 "\n", mReadOkCount);
+    dprintf(fd, "  reads incorrect key: %" PRIu64 "\n", mReadIncorrectKeyCount);
+    dprintf(fd, "  reads failed: %" PRIu64 "\n", mReadFailedCount);
+    dprintf(fd, "  writes: %" PRIu64 "\n", mWriteCount);
+    return STATUS_OK;
+}
+
 } //namespace weaver
 } //namespace hardware
 } //namespace android
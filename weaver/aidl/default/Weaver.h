@@ -18,6 +18,9 @@
 
 #include <aidl/android/hardware/weaver/BnWeaver.h>
 
+#include <cstdint>
+#include <mutex>
+
 namespace aidl {
 namespace android {
 namespace hardware {
@@ -34,6 +37,17 @@ public:
     ::ndk::ScopedAStatus getConfig(WeaverConfig* _aidl_return) override;
     ::ndk::ScopedAStatus read(int32_t in_slotId, const std::vector<uint8_t>& in_key, WeaverReadResponse* _aidl_return) override;
     ::ndk::ScopedAStatus write(int32_t in_slotId, const std::vector<uint8_t>& in_key, const std::vector<uint8_t>& in_value) override;
+    binder_status_t dump(int fd, const char** args, uint32_t numArgs) override;
+
+private:
+    // Guards the slot storage and the counters below against concurrent
+    // binder threads.
+    std::mutex mLock;
+    // Read/write outcome counters, shown in dumpsys.
+    uint64_t mReadOkCount = 0;
+    uint64_t mReadIncorrectKeyCount = 0;
+    uint64_t mReadFailedCount = 0;
+    uint64_t mWriteCount = 0;
 };
 
 }  // namespace weaver
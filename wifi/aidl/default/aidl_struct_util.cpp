@@ -608,6 +608,19 @@ bool convertLegacyIeBlobToAidl(const uint8_t* ie_blob, uint32_t ie_blob_len,
     const uint8_t* next_ie = ies_begin;
     using wifi_ie = legacy_hal::wifi_information_element;
     constexpr size_t kIeHeaderLen = sizeof(wifi_ie);
+    // Pre-count the IEs in the blob so the output vector can be sized
+    // exactly, avoiding reallocations while converting.
+    size_t num_ies = 0;
+    while (next_ie + kIeHeaderLen <= ies_end) {
+        uint32_t curr_ie_len = kIeHeaderLen + (*reinterpret_cast<const wifi_ie*>(next_ie)).len;
+        if (next_ie + curr_ie_len > ies_end) {
+            break;
+        }
+        num_ies++;
+        next_ie += curr_ie_len;
+    }
+    aidl_ies->reserve(num_ies);
+    next_ie = ies_begin;
     // Each IE should at least have the header (i.e |id| & |len| fields).
     while (next_ie + kIeHeaderLen <= ies_end) {
         const wifi_ie& legacy_ie = (*reinterpret_cast<const wifi_ie*>(next_ie));
@@ -682,13 +695,14 @@ bool convertLegacyCachedGscanResultsToAidl(
     CHECK(legacy_cached_scan_result.num_results >= 0 &&
           legacy_cached_scan_result.num_results <= MAX_AP_CACHE_PER_SCAN);
     std::vector<StaScanResult> aidl_scan_results;
+    aidl_scan_results.reserve(legacy_cached_scan_result.num_results);
     for (int32_t result_idx = 0; result_idx < legacy_cached_scan_result.num_results; result_idx++) {
         StaScanResult aidl_scan_result;
         if (!convertLegacyGscanResultToAidl(legacy_cached_scan_result.results[result_idx], false,
                                             &aidl_scan_result)) {
             return false;
         }
-        aidl_scan_results.push_back(aidl_scan_result);
+        aidl_scan_results.push_back(std::move(aidl_scan_result));
     }
     aidl_scan_data->results = std::move(aidl_scan_results);
     return true;
@@ -701,12 +715,13 @@ bool convertLegacyVectorOfCachedGscanResultsToAidl(
         return false;
     }
     *aidl_scan_datas = {};
+    aidl_scan_datas->reserve(legacy_cached_scan_results.size());
     for (const auto& legacy_cached_scan_result : legacy_cached_scan_results) {
         StaScanData aidl_scan_data;
         if (!convertLegacyCachedGscanResultsToAidl(legacy_cached_scan_result, &aidl_scan_data)) {
             return false;
         }
-        aidl_scan_datas->push_back(aidl_scan_data);
+        aidl_scan_datas->push_back(std::move(aidl_scan_data));
     }
     return true;
 }
@@ -16,8 +16,36 @@
 
 #include "aidl_sync_util.h"
 
+#include <android-base/logging.h>
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
 namespace {
 std::recursive_mutex g_mutex;
+
+// Bounded queue of callbacks awaiting delivery on the event dispatch
+// thread. The bound keeps a wedged client binder from growing the queue
+// without limit; events posted past the bound are dropped.
+constexpr size_t kMaxPendingEventCallbacks = 256;
+std::mutex g_event_queue_mutex;
+std::condition_variable g_event_queue_cv;
+std::deque<std::function<void()>> g_event_queue;
+bool g_event_thread_started = false;
+
+void eventDispatchLoop() {
+    while (true) {
+        std::function<void()> callback;
+        {
+            std::unique_lock<std::mutex> lock(g_event_queue_mutex);
+            g_event_queue_cv.wait(lock, [] { return !g_event_queue.empty(); });
+            callback = std::move(g_event_queue.front());
+            g_event_queue.pop_front();
+        }
+        callback();
+    }
+}
 }  // namespace
 
 namespace aidl {
@@ -30,6 +58,22 @@ std::unique_lock<std::recursive_mutex> acquireGlobalLock() {
     return std::unique_lock<std::recursive_mutex>{g_mutex};
 }
 
+bool postToEventDispatchThread(std::function<void()> callback) {
+    std::unique_lock<std::mutex> lock(g_event_queue_mutex);
+    if (g_event_queue.size() >= kMaxPendingEventCallbacks) {
+        LOG(ERROR) << "Event dispatch queue is full, dropping event callback";
+        return false;
+    }
+    if (!g_event_thread_started) {
+        std::thread(eventDispatchLoop).detach();
+        g_event_thread_started = true;
+    }
+    g_event_queue.push_back(std::move(callback));
+    lock.unlock();
+    g_event_queue_cv.notify_one();
+    return true;
+}
+
 }  // namespace aidl_sync_util
 }  // namespace wifi
 }  // namespace hardware
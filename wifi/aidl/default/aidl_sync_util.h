@@ -17,6 +17,7 @@
 #ifndef AIDL_SYNC_UTIL_H_
 #define AIDL_SYNC_UTIL_H_
 
+#include <functional>
 #include <mutex>
 
 // Utility that provides a global lock to synchronize access between
@@ -27,6 +28,15 @@ namespace hardware {
 namespace wifi {
 namespace aidl_sync_util {
 std::unique_lock<std::recursive_mutex> acquireGlobalLock();
+
+// Queues |callback| for invocation on a dedicated event dispatch thread,
+// outside the global lock. Callbacks are invoked one at a time in the
+// order they were posted. Intended for client binder outcalls triggered
+// by legacy HAL events (e.g. scan results), so that a slow client can't
+// hold the global lock and block concurrent AIDL calls. The posted
+// callback must own all the state it needs (captured by value).
+// Returns false if the pending queue is full and the callback was dropped.
+bool postToEventDispatchThread(std::function<void()> callback);
 }  // namespace aidl_sync_util
 }  // namespace wifi
 }  // namespace hardware
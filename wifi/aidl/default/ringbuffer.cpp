@@ -25,7 +25,7 @@ namespace wifi {
 
 Ringbuffer::Ringbuffer(size_t maxSize) : size_(0), maxSize_(maxSize) {}
 
-enum Ringbuffer::AppendStatus Ringbuffer::append(const std::vector<uint8_t>& input) {
+enum Ringbuffer::AppendStatus Ringbuffer::append(std::vector<uint8_t> input) {
     if (input.size() == 0) {
         return AppendStatus::FAIL_IP_BUFFER_ZERO;
     }
@@ -33,8 +33,8 @@ enum Ringbuffer::AppendStatus Ringbuffer::append(const std::vector<uint8_t>& inp
         LOG(INFO) << "Oversized message of " << input.size() << " bytes is dropped";
         return AppendStatus::FAIL_IP_BUFFER_EXCEEDED_MAXSIZE;
     }
-    data_.push_back(input);
     size_ += input.size() * sizeof(input[0]);
+    data_.push_back(std::move(input));
     while (size_ > maxSize_) {
         if (data_.front().size() <= 0 || data_.front().size() > maxSize_) {
             LOG(ERROR) << "First buffer in the ring buffer is Invalid. Size: "
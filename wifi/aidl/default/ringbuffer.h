@@ -42,7 +42,7 @@ class Ringbuffer {
 
     // Appends the data buffer and deletes from the front until buffer is
     // within |maxSize_|.
-    enum AppendStatus append(const std::vector<uint8_t>& input);
+    enum AppendStatus append(std::vector<uint8_t> input);
     const std::list<std::vector<uint8_t>>& getData() const;
     void clear();
 
@@ -374,6 +374,7 @@ WifiChip::WifiChip(int32_t chip_id, bool is_primary,
       iface_util_(iface_util),
       is_valid_(true),
       current_mode_id_(feature_flags::chip_mode_ids::kInvalid),
+      expanded_combinations_mode_id_(feature_flags::chip_mode_ids::kInvalid),
       modes_(feature_flags.lock()->getChipModes(is_primary)),
       debug_ring_buffer_cb_registered_(false),
       using_dynamic_iface_combination_(using_dynamic_iface_combination),
@@ -406,6 +407,9 @@ void WifiChip::retrieveDynamicIfaceCombination() {
     aidl_chip_mode.id = feature_flags::chip_mode_ids::kV3;
     modes_.clear();
     modes_.push_back(aidl_chip_mode);
+    // The combination matrix changed; the expanded-combination cache must be
+    // rebuilt on next use.
+    expanded_combinations_mode_id_ = feature_flags::chip_mode_ids::kInvalid;
     using_dynamic_iface_combination_ = true;
 }
 
@@ -1561,26 +1565,23 @@ ndk::ScopedAStatus WifiChip::registerDebugRingBufferCallback() {
 
     std::weak_ptr<WifiChip> weak_ptr_this = weak_ptr_this_;
     const auto& on_ring_buffer_data_callback =
-            [weak_ptr_this](const std::string& name, const std::vector<uint8_t>& data,
-                            const legacy_hal::wifi_ring_buffer_status& status) {
+            [weak_ptr_this](const std::string& name, std::vector<uint8_t> data,
+                            const legacy_hal::wifi_ring_buffer_status& /* status */) {
                 const auto shared_ptr_this = weak_ptr_this.lock();
                 if (!shared_ptr_this.get() || !shared_ptr_this->isValid()) {
                     LOG(ERROR) << "Callback invoked on an invalid object";
                     return;
                 }
-                WifiDebugRingBufferStatus aidl_status;
+                // The legacy status is not consumed on this path, so it is
+                // deliberately not converted here; verbose firmware logging
+                // invokes this callback for every entry.
                 Ringbuffer::AppendStatus appendstatus;
-                if (!aidl_struct_util::convertLegacyDebugRingBufferStatusToAidl(status,
-                                                                                &aidl_status)) {
-                    LOG(ERROR) << "Error converting ring buffer status";
-                    return;
-                }
                 {
                     std::unique_lock<std::mutex> lk(shared_ptr_this->lock_t);
                     const auto& target = shared_ptr_this->ringbuffer_map_.find(name);
                     if (target != shared_ptr_this->ringbuffer_map_.end()) {
                         Ringbuffer& cur_buffer = target->second;
-                        appendstatus = cur_buffer.append(data);
+                        appendstatus = cur_buffer.append(std::move(data));
                     } else {
                         LOG(ERROR) << "Ringname " << name << " not found";
                         return;
@@ -1704,6 +1705,24 @@ std::vector<std::map<IfaceConcurrencyType, size_t>> WifiChip::expandConcurrencyC
     return expanded_combos;
 }
 
+// Returns the expanded concurrency combinations of the current mode, built on
+// first use after each (re)configuration. The expansion only depends on the
+// mode's combination matrix, so feasibility checks can share one copy instead
+// of re-expanding it on every call.
+const std::vector<std::map<IfaceConcurrencyType, size_t>>&
+WifiChip::getCurrentModeExpandedCombinations() {
+    if (expanded_combinations_mode_id_ != current_mode_id_) {
+        expanded_combinations_cache_.clear();
+        for (const auto& combination : getCurrentModeConcurrencyCombinations()) {
+            const auto expanded_combos = expandConcurrencyCombinations(combination);
+            expanded_combinations_cache_.insert(expanded_combinations_cache_.end(),
+                                                expanded_combos.begin(), expanded_combos.end());
+        }
+        expanded_combinations_mode_id_ = current_mode_id_;
+    }
+    return expanded_combinations_cache_;
+}
+
 bool WifiChip::canExpandedConcurrencyComboSupportConcurrencyTypeWithCurrentTypes(
         const std::map<IfaceConcurrencyType, size_t>& expanded_combo,
         IfaceConcurrencyType requested_type) {
@@ -1736,14 +1755,10 @@ bool WifiChip::canCurrentModeSupportConcurrencyTypeWithCurrentTypes(
         LOG(ERROR) << "Chip not configured in a mode yet";
         return false;
     }
-    const auto combinations = getCurrentModeConcurrencyCombinations();
-    for (const auto& combination : combinations) {
-        const auto expanded_combos = expandConcurrencyCombinations(combination);
-        for (const auto& expanded_combo : expanded_combos) {
-            if (canExpandedConcurrencyComboSupportConcurrencyTypeWithCurrentTypes(expanded_combo,
-                                                                                  requested_type)) {
-                return true;
-            }
+    for (const auto& expanded_combo : getCurrentModeExpandedCombinations()) {
+        if (canExpandedConcurrencyComboSupportConcurrencyTypeWithCurrentTypes(expanded_combo,
+                                                                              requested_type)) {
+            return true;
         }
     }
     return false;
@@ -1783,13 +1798,9 @@ bool WifiChip::canCurrentModeSupportConcurrencyCombo(
         LOG(ERROR) << "Chip not configured in a mode yet";
         return false;
     }
-    const auto combinations = getCurrentModeConcurrencyCombinations();
-    for (const auto& combination : combinations) {
-        const auto expanded_combos = expandConcurrencyCombinations(combination);
-        for (const auto& expanded_combo : expanded_combos) {
-            if (canExpandedConcurrencyComboSupportConcurrencyCombo(expanded_combo, req_combo)) {
-                return true;
-            }
+    for (const auto& expanded_combo : getCurrentModeExpandedCombinations()) {
+        if (canExpandedConcurrencyComboSupportConcurrencyCombo(expanded_combo, req_combo)) {
+            return true;
         }
     }
     return false;
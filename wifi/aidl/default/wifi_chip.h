@@ -232,6 +232,8 @@ class WifiChip : public BnWifiChip {
     std::map<IfaceConcurrencyType, size_t> getCurrentConcurrencyCombination();
     std::vector<std::map<IfaceConcurrencyType, size_t>> expandConcurrencyCombinations(
             const ChipConcurrencyCombination& combination);
+    const std::vector<std::map<IfaceConcurrencyType, size_t>>&
+    getCurrentModeExpandedCombinations();
     bool canExpandedConcurrencyComboSupportConcurrencyTypeWithCurrentTypes(
             const std::map<IfaceConcurrencyType, size_t>& expanded_combo,
             IfaceConcurrencyType requested_type);
@@ -278,6 +280,14 @@ class WifiChip : public BnWifiChip {
     bool is_valid_;
     // Members pertaining to chip configuration.
     int32_t current_mode_id_;
+    // Mode id the expanded-combination cache below was built for;
+    // chip_mode_ids::kInvalid when the cache needs a rebuild.
+    int32_t expanded_combinations_mode_id_;
+    // Expanded concurrency combinations of the current mode, flattened across
+    // all of its ChipConcurrencyCombinations. The expansion is pure in the
+    // mode's combination matrix, so it is computed once per (re)configuration
+    // instead of on every feasibility check.
+    std::vector<std::map<IfaceConcurrencyType, size_t>> expanded_combinations_cache_;
     std::mutex lock_t;
     std::vector<IWifiChip::ChipMode> modes_;
     // The legacy ring buffer callback API has only a global callback
@@ -1124,7 +1124,7 @@ wifi_error WifiLegacyHal::registerRingBufferCallbackHandler(
         if (status && buffer) {
             std::vector<uint8_t> buffer_vector(reinterpret_cast<uint8_t*>(buffer),
                                                reinterpret_cast<uint8_t*>(buffer) + buffer_size);
-            on_user_data_callback(ring_name, buffer_vector, *status);
+            on_user_data_callback(ring_name, std::move(buffer_vector), *status);
         }
     };
     wifi_error status = global_func_table_.wifi_set_log_handler(0, getIfaceHandle(iface_name),
@@ -486,9 +486,10 @@ using on_rtt_results_callback =
 using on_rtt_results_callback_v2 =
         std::function<void(wifi_request_id, const std::vector<const wifi_rtt_result_v2*>&)>;
 
-// Callback for ring buffer data.
+// Callback for ring buffer data. The data is passed by value so the entry
+// can be moved into the consumer's ring without another copy.
 using on_ring_buffer_data_callback = std::function<void(
-        const std::string&, const std::vector<uint8_t>&, const wifi_ring_buffer_status&)>;
+        const std::string&, std::vector<uint8_t>, const wifi_ring_buffer_status&)>;
 
 // Callback for alerts.
 using on_error_alert_callback = std::function<void(int32_t, const std::vector<uint8_t>&)>;
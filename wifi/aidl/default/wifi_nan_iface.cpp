@@ -17,6 +17,7 @@
 #include "wifi_nan_iface.h"
 
 #include <android-base/logging.h>
+#include <utils/SystemClock.h>
 
 #include "aidl_return_util.h"
 #include "aidl_struct_util.h"
@@ -330,6 +331,7 @@ void WifiNanIface::registerCallbackHandlers() {
                 NanStatus status;
                 aidl_struct_util::convertToNanStatus(msg.reason, msg.nan_reason,
                                                      sizeof(msg.nan_reason), &status);
+                shared_ptr_this->onDiscoverySessionTerminated(msg.publish_id);
 
                 for (const auto& callback : shared_ptr_this->getEventCallbacks()) {
                     if (!callback->eventPublishTerminated(msg.publish_id, status).isOk()) {
@@ -348,6 +350,7 @@ void WifiNanIface::registerCallbackHandlers() {
                 NanStatus status;
                 aidl_struct_util::convertToNanStatus(msg.reason, msg.nan_reason,
                                                      sizeof(msg.nan_reason), &status);
+                shared_ptr_this->onDiscoverySessionTerminated(msg.subscribe_id);
 
                 for (const auto& callback : shared_ptr_this->getEventCallbacks()) {
                     if (!callback->eventSubscribeTerminated(msg.subscribe_id, status).isOk()) {
@@ -367,6 +370,9 @@ void WifiNanIface::registerCallbackHandlers() {
             LOG(ERROR) << "Failed to convert nan capabilities response";
             return;
         }
+        if (!shared_ptr_this->shouldDeliverMatch(aidl_struct)) {
+            return;
+        }
 
         for (const auto& callback : shared_ptr_this->getEventCallbacks()) {
             if (!callback->eventMatch(aidl_struct).isOk()) {
@@ -382,6 +388,7 @@ void WifiNanIface::registerCallbackHandlers() {
             LOG(ERROR) << "Callback invoked on an invalid object";
             return;
         }
+        shared_ptr_this->onMatchExpired(msg.publish_subscribe_id, msg.requestor_instance_id);
         for (const auto& callback : shared_ptr_this->getEventCallbacks()) {
             if (!callback->eventMatchExpired(msg.publish_subscribe_id, msg.requestor_instance_id)
                          .isOk()) {
@@ -657,6 +664,8 @@ void WifiNanIface::invalidate() {
     iface_util_.lock()->unregisterIfaceEventHandlers(ifname_);
     legacy_hal_.reset();
     event_cb_handler_.invalidate();
+    nan_match_history_.clear();
+    nan_match_session_stats_.clear();
     is_valid_ = false;
     if (is_dedicated_iface_) {
         // If using a dedicated iface, set the iface down.
@@ -677,6 +686,47 @@ std::set<std::shared_ptr<IWifiNanIfaceEventCallback>> WifiNanIface::getEventCall
     return event_cb_handler_.getCallbacks();
 }
 
+bool WifiNanIface::shouldDeliverMatch(const NanMatchInd& match) {
+    int64_t now_ms = ::android::uptimeMillis();
+    auto key = std::make_pair(match.discoverySessionId, match.peerId);
+    NanMatchSessionStats& stats = nan_match_session_stats_[match.discoverySessionId];
+    const auto it = nan_match_history_.find(key);
+    if (it != nan_match_history_.end() &&
+        now_ms - it->second.last_delivery_time_ms < kMatchCoalescingWindowMs &&
+        it->second.service_specific_info == match.serviceSpecificInfo &&
+        it->second.match_filter == match.matchFilter) {
+        stats.num_coalesced++;
+        return false;
+    }
+    NanMatchHistoryEntry& entry = nan_match_history_[key];
+    entry.last_delivery_time_ms = now_ms;
+    entry.service_specific_info = match.serviceSpecificInfo;
+    entry.match_filter = match.matchFilter;
+    stats.num_delivered++;
+    return true;
+}
+
+void WifiNanIface::onMatchExpired(int8_t session_id, int32_t peer_id) {
+    nan_match_history_.erase(std::make_pair(session_id, peer_id));
+}
+
+void WifiNanIface::onDiscoverySessionTerminated(int8_t session_id) {
+    const auto stats = nan_match_session_stats_.find(session_id);
+    if (stats != nan_match_session_stats_.end()) {
+        LOG(INFO) << "Session " << static_cast<int>(session_id) << " delivered "
+                  << stats->second.num_delivered << " matches, coalesced "
+                  << stats->second.num_coalesced;
+        nan_match_session_stats_.erase(stats);
+    }
+    for (auto it = nan_match_history_.begin(); it != nan_match_history_.end();) {
+        if (it->first.first == session_id) {
+            it = nan_match_history_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 ndk::ScopedAStatus WifiNanIface::getName(std::string* _aidl_return) {
     return validateAndCall(this, WifiStatusCode::ERROR_WIFI_IFACE_INVALID,
                            &WifiNanIface::getNameInternal, _aidl_return);
@@ -21,6 +21,8 @@
 #include <aidl/android/hardware/wifi/IWifiNanIfaceEventCallback.h>
 #include <android-base/macros.h>
 
+#include <map>
+
 #include "aidl_callback_util.h"
 #include "wifi_iface_util.h"
 #include "wifi_legacy_hal.h"
@@ -137,6 +139,16 @@ class WifiNanIface : public BnWifiNanIface {
     // Overridden in the gTest suite.
     virtual std::set<std::shared_ptr<IWifiNanIfaceEventCallback>> getEventCallbacks();
 
+    // Returns true if |match| should be delivered to the registered
+    // callbacks, updating the coalescing state. A match for the same
+    // discovery session / peer with an unchanged payload arriving within
+    // |kMatchCoalescingWindowMs| of the last delivered one is dropped.
+    bool shouldDeliverMatch(const NanMatchInd& match);
+    // Drops the coalescing state of a peer whose match has expired.
+    void onMatchExpired(int8_t session_id, int32_t peer_id);
+    // Logs and drops the match counters of a terminated discovery session.
+    void onDiscoverySessionTerminated(int8_t session_id);
+
     std::string ifname_;
     bool is_dedicated_iface_;
     std::weak_ptr<legacy_hal::WifiLegacyHal> legacy_hal_;
@@ -145,6 +157,22 @@ class WifiNanIface : public BnWifiNanIface {
     std::weak_ptr<WifiNanIface> weak_ptr_this_;
     aidl_callback_util::AidlCallbackHandler<IWifiNanIfaceEventCallback> event_cb_handler_;
 
+    // Window within which a redundant match indication for the same peer
+    // is coalesced into the previously delivered one.
+    static constexpr int64_t kMatchCoalescingWindowMs = 500;
+    struct NanMatchHistoryEntry {
+        int64_t last_delivery_time_ms;
+        std::vector<uint8_t> service_specific_info;
+        std::vector<uint8_t> match_filter;
+    };
+    struct NanMatchSessionStats {
+        uint32_t num_delivered = 0;
+        uint32_t num_coalesced = 0;
+    };
+    // Last delivered match, keyed by (discovery session id, peer id).
+    std::map<std::pair<int8_t, int32_t>, NanMatchHistoryEntry> nan_match_history_;
+    std::map<int8_t, NanMatchSessionStats> nan_match_session_stats_;
+
     DISALLOW_COPY_AND_ASSIGN(WifiNanIface);
 };
 
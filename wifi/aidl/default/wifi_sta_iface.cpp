@@ -20,6 +20,7 @@
 
 #include "aidl_return_util.h"
 #include "aidl_struct_util.h"
+#include "aidl_sync_util.h"
 #include "wifi_status_util.h"
 
 namespace aidl {
@@ -324,11 +325,19 @@ ndk::ScopedAStatus WifiStaIface::startBackgroundScanInternal(
                     LOG(ERROR) << "Failed to convert scan results to AIDL structs";
                     return;
                 }
-                for (const auto& callback : shared_ptr_this->getEventCallbacks()) {
-                    if (!callback->onBackgroundScanResults(id, aidl_scan_datas).isOk()) {
-                        LOG(ERROR) << "Failed to invoke onBackgroundScanResults callback";
-                    }
-                }
+                // Deliver the results outside the global lock, so that a burst
+                // of scan results can't block concurrent AIDL calls.
+                aidl_sync_util::postToEventDispatchThread(
+                        [id, aidl_scan_datas = std::move(aidl_scan_datas),
+                         callbacks = shared_ptr_this->getEventCallbacks()]() {
+                            for (const auto& callback : callbacks) {
+                                if (!callback->onBackgroundScanResults(id, aidl_scan_datas)
+                                             .isOk()) {
+                                    LOG(ERROR)
+                                            << "Failed to invoke onBackgroundScanResults callback";
+                                }
+                            }
+                        });
             };
     const auto& on_full_result_callback = [weak_ptr_this](
                                                   legacy_hal::wifi_request_id id,
@@ -344,12 +353,17 @@ ndk::ScopedAStatus WifiStaIface::startBackgroundScanInternal(
             LOG(ERROR) << "Failed to convert full scan results to AIDL structs";
             return;
         }
-        for (const auto& callback : shared_ptr_this->getEventCallbacks()) {
-            if (!callback->onBackgroundFullScanResult(id, buckets_scanned, aidl_scan_result)
-                         .isOk()) {
-                LOG(ERROR) << "Failed to invoke onBackgroundFullScanResult callback";
-            }
-        }
+        aidl_sync_util::postToEventDispatchThread(
+                [id, buckets_scanned, aidl_scan_result = std::move(aidl_scan_result),
+                 callbacks = shared_ptr_this->getEventCallbacks()]() {
+                    for (const auto& callback : callbacks) {
+                        if (!callback->onBackgroundFullScanResult(id, buckets_scanned,
+                                                                  aidl_scan_result)
+                                     .isOk()) {
+                            LOG(ERROR) << "Failed to invoke onBackgroundFullScanResult callback";
+                        }
+                    }
+                });
     };
     legacy_hal::wifi_error legacy_status =
             legacy_hal_.lock()->startGscan(ifname_, cmd_id, legacy_params, on_failure_callback,